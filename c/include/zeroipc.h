@@ -21,9 +21,18 @@ typedef enum {
     ZEROIPC_ERROR_INVALID_MAGIC = -7,
     ZEROIPC_ERROR_VERSION_MISMATCH = -8,
     ZEROIPC_ERROR_ALREADY_EXISTS = -9,
-    ZEROIPC_ERROR_TIMEOUT = -10  /* bounded spin exhausted (crashed peer or pathological contention) */
+    ZEROIPC_ERROR_TIMEOUT = -10, /* bounded spin exhausted (crashed peer or pathological contention) */
+    ZEROIPC_ERROR_ALIGNMENT = -11 /* alignment not a power of two, or above ZEROIPC_MAX_ALLOC_ALIGN */
 } zeroipc_error_t;
 
+/* Alignment. Every structure lays out its sections (header, data, atomic
+ * side-arrays) on its section alignment, recorded in its table entry (0 in
+ * an entry means ZEROIPC_MIN_SECTION_ALIGN). Structure bases are additionally
+ * placed on their own cache line so neighbouring headers never false-share. */
+#define ZEROIPC_MIN_SECTION_ALIGN 8
+#define ZEROIPC_MAX_ALLOC_ALIGN   4096
+#define ZEROIPC_CACHE_LINE_SIZE   64
+
 /* Forward declarations */
 typedef struct zeroipc_memory zeroipc_memory_t;
 typedef struct zeroipc_array zeroipc_array_t;
@@ -39,7 +48,11 @@ int zeroipc_memory_error(zeroipc_memory_t* mem);
 
 /* Table operations */
 int zeroipc_table_add(zeroipc_memory_t* mem, const char* name, size_t size, size_t* offset);
+int zeroipc_table_add_aligned(zeroipc_memory_t* mem, const char* name, size_t size,
+                              size_t alignment, size_t* offset);
 int zeroipc_table_find(zeroipc_memory_t* mem, const char* name, size_t* offset, size_t* size);
+int zeroipc_table_find_aligned(zeroipc_memory_t* mem, const char* name, size_t* offset,
+                               size_t* size, size_t* alignment);
 int zeroipc_table_remove(zeroipc_memory_t* mem, const char* name);
 size_t zeroipc_table_count(zeroipc_memory_t* mem);
 
@@ -13,6 +13,8 @@
  *  -1 = full (push) or empty (pop/top)
  *  -2 = elem_size mismatch
  *  -3 = invalid header (capacity/elem_size is 0)
+ *  -4 = name already exists (table add)
+ *  -5 = out of segment space (table allocate_entry)
  */
 
 #include <stdint.h>
@@ -22,26 +24,89 @@
 extern "C" {
 #endif
 
+/* align is the section alignment from the structure's table entry
+ * (0 = the default 8); it determines where the data and side-arrays start. */
+
 /* Queue (Vyukov bounded MPMC) */
 int zeroipc_raw_queue_push(void* base, size_t offset,
-                           const void* value, uint32_t elem_size);
+                           const void* value, uint32_t elem_size, uint32_t align);
 int zeroipc_raw_queue_pop(void* base, size_t offset,
-                          void* value_out, uint32_t elem_size);
+                          void* value_out, uint32_t elem_size, uint32_t align);
 uint32_t zeroipc_raw_queue_size(void* base, size_t offset);
 int zeroipc_raw_queue_empty(void* base, size_t offset);
 int zeroipc_raw_queue_full(void* base, size_t offset);
 
 /* Stack (4-state CAS) */
 int zeroipc_raw_stack_push(void* base, size_t offset,
-                           const void* value, uint32_t elem_size);
+                           const void* value, uint32_t elem_size, uint32_t align);
 int zeroipc_raw_stack_pop(void* base, size_t offset,
-                          void* value_out, uint32_t elem_size);
+                          void* value_out, uint32_t elem_size, uint32_t align);
+/* Batched variants: one CAS on top moves up to count elements; return the
+ * number moved (0 = full/empty) or a negative error. pop_n copies out most
+ * recent first; push_n pushes values in order (the last pops first). */
+int zeroipc_raw_stack_push_n(void* base, size_t offset, const void* values,
+                             uint32_t count, uint32_t elem_size, uint32_t align);
+int zeroipc_raw_stack_pop_n(void* base, size_t offset, void* values_out,
+                            uint32_t count, uint32_t elem_size, uint32_t align);
 int zeroipc_raw_stack_top(void* base, size_t offset,
-                          void* value_out, uint32_t elem_size);
+                          void* value_out, uint32_t elem_size, uint32_t align);
 uint32_t zeroipc_raw_stack_size(void* base, size_t offset);
 int zeroipc_raw_stack_empty(void* base, size_t offset);
 int zeroipc_raw_stack_full(void* base, size_t offset);
 
+/* SeqLock (optimistic reads). read returns -1 if no clean copy was possible
+ * (a writer died mid-write). write_begin/write_end bracket an in-place
+ * read-modify-write of the value; write is begin + copy + end, and wakes
+ * waiters. wait: block until a write completes after the one that produced
+ * the sequence `seen`; 0 = changed, -1 = timed out. */
+int zeroipc_raw_seqlock_read(void* base, size_t offset,
+                             void* value_out, uint32_t elem_size, uint32_t align);
+int zeroipc_raw_seqlock_write(void* base, size_t offset,
+                              const void* value, uint32_t elem_size, uint32_t align);
+void zeroipc_raw_seqlock_write_begin(void* base, size_t offset);
+void zeroipc_raw_seqlock_write_end(void* base, size_t offset);
+uint64_t zeroipc_raw_seqlock_sequence(void* base, size_t offset);
+int zeroipc_raw_seqlock_wait(void* base, size_t offset, uint64_t seen, int64_t timeout_ns);
+
+/* Semaphore: add permits (within max_count) and wake waiters.
+ * 0 = released, -1 = would exceed max_count, -3 = permits not positive. */
+int zeroipc_raw_semaphore_release(void* base, size_t offset, int32_t permits);
+
+/* RWLock (same word protocol as C++ RWLock). try_*: 0 = acquired,
+ * -1 = busy. read_lock/write_lock block up to timeout_ns (negative waits
+ * forever): 0 = acquired, -1 = timed out. */
+int zeroipc_raw_rwlock_try_read_lock(void* base, size_t offset);
+int zeroipc_raw_rwlock_read_lock(void* base, size_t offset, int64_t timeout_ns);
+void zeroipc_raw_rwlock_read_unlock(void* base, size_t offset);
+int zeroipc_raw_rwlock_try_write_lock(void* base, size_t offset);
+int zeroipc_raw_rwlock_write_lock(void* base, size_t offset, int64_t timeout_ns);
+void zeroipc_raw_rwlock_write_unlock(void* base, size_t offset);
+
+/* Monitor (same protocol as C++ Monitor). try_lock: 0 = acquired,
+ * -1 = busy. lock blocks up to timeout_ns (negative waits forever):
+ * 0 = acquired, -1 = timed out. wait must be called holding the lock and
+ * returns holding it again: 0 = notified, -1 = timed out. */
+int zeroipc_raw_monitor_try_lock(void* base, size_t offset);
+int zeroipc_raw_monitor_lock(void* base, size_t offset, int64_t timeout_ns);
+void zeroipc_raw_monitor_unlock(void* base, size_t offset);
+int zeroipc_raw_monitor_wait(void* base, size_t offset, int64_t timeout_ns);
+void zeroipc_raw_monitor_notify_one(void* base, size_t offset);
+void zeroipc_raw_monitor_notify_all(void* base, size_t offset);
+
+/* Table (lock-free registration; base is the segment start)
+ * allocate:       -1 = out of memory, -3 = alignment not a power of two <= 4096
+ * add:            -1 = table full, -3 = name too long or bad align,
+ *                 -4 = name already exists. align is recorded in the entry.
+ * allocate_entry: claims name, then allocates size bytes on
+ *                 max(align, 64) and publishes; codes as add, plus
+ *                 -5 = out of memory. A failed call takes no space. */
+int zeroipc_raw_table_allocate(void* base, uint64_t size, uint64_t alignment,
+                               uint64_t* offset_out);
+int zeroipc_raw_table_add(void* base, uint32_t max_entries, const char* name,
+                          uint64_t offset, uint64_t size, uint32_t align);
+int zeroipc_raw_table_allocate_entry(void* base, uint32_t max_entries, const char* name,
+                                     uint64_t size, uint32_t align, uint64_t* offset_out);
+
 #ifdef __cplusplus
 }
 #endif
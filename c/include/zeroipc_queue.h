@@ -11,9 +11,30 @@ extern "C" {
 /* Queue structure */
 typedef struct zeroipc_queue zeroipc_queue_t;
 
+/* Slot layouts, recorded in the high byte of the header's elem_size field.
+ * SPLIT keeps the data and sequence arrays apart; INTERLEAVED stores each
+ * slot as {element, seq} so an operation touches one cache line;
+ * INTERLEAVED_PADDED also pads every slot to whole cache lines.
+ * PADDED_HEADER can be or-ed into any of them: head and tail then live on
+ * cache lines of their own (offsets 64 and 128) and the slots start after
+ * them, so producers and consumers stop false-sharing the counters. */
+#define ZEROIPC_QUEUE_SPLIT              0x00000000u
+#define ZEROIPC_QUEUE_INTERLEAVED        0x01000000u
+#define ZEROIPC_QUEUE_INTERLEAVED_PADDED 0x03000000u
+#define ZEROIPC_QUEUE_LAYOUT_PADDED      0x02000000u
+#define ZEROIPC_QUEUE_PADDED_HEADER      0x04000000u
+#define ZEROIPC_QUEUE_ELEM_SIZE_MASK     0x00FFFFFFu
+
+#define ZEROIPC_QUEUE_PADDED_HEAD_OFFSET 64
+#define ZEROIPC_QUEUE_PADDED_TAIL_OFFSET 128
+#define ZEROIPC_QUEUE_PADDED_HEADER_SIZE 192
+
 /* Queue operations */
 zeroipc_queue_t* zeroipc_queue_create(zeroipc_memory_t* mem, const char* name,
                                        size_t elem_size, size_t capacity);
+zeroipc_queue_t* zeroipc_queue_create_layout(zeroipc_memory_t* mem, const char* name,
+                                              size_t elem_size, size_t capacity,
+                                              uint32_t layout);
 zeroipc_queue_t* zeroipc_queue_open(zeroipc_memory_t* mem, const char* name);
 void zeroipc_queue_close(zeroipc_queue_t* queue);
 
@@ -0,0 +1,86 @@
+/**
+ * ZeroIPC SeqLock - Sequence lock for single-writer, many-reader values
+ */
+
+#ifndef ZEROIPC_SEQLOCK_H
+#define ZEROIPC_SEQLOCK_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Forward declarations */
+typedef struct zeroipc_memory zeroipc_memory_t;
+typedef struct zeroipc_seqlock zeroipc_seqlock_t;
+
+/**
+ * Create a new seqlock in shared memory
+ *
+ * @param mem       Memory instance
+ * @param name      SeqLock identifier (max 31 chars)
+ * @param elem_size Size of the value in bytes (must be > 0)
+ * @param initial   Initial value (elem_size bytes), or NULL for zeroes
+ * @return          SeqLock handle or NULL on failure
+ */
+zeroipc_seqlock_t* zeroipc_seqlock_create(zeroipc_memory_t* mem, const char* name,
+                                          size_t elem_size, const void* initial);
+
+/**
+ * Open existing seqlock in shared memory
+ *
+ * @param mem       Memory instance
+ * @param name      SeqLock identifier
+ * @param elem_size Expected size of the value in bytes
+ * @return          SeqLock handle or NULL on failure (not found or size mismatch)
+ */
+zeroipc_seqlock_t* zeroipc_seqlock_open(zeroipc_memory_t* mem, const char* name,
+                                        size_t elem_size);
+
+/**
+ * Close seqlock handle (seqlock remains in shared memory)
+ *
+ * @param lock SeqLock handle
+ */
+void zeroipc_seqlock_close(zeroipc_seqlock_t* lock);
+
+/**
+ * Copy out the value as of the last completed write
+ *
+ * Never blocks writers and never writes shared memory; retries while a
+ * write overlaps the copy.
+ *
+ * @param lock SeqLock handle
+ * @param out  Buffer of elem_size bytes
+ * @return     ZEROIPC_OK, or ZEROIPC_ERROR_TIMEOUT if no clean copy was
+ *             possible (a writer died mid-write)
+ */
+int zeroipc_seqlock_read(zeroipc_seqlock_t* lock, void* out);
+
+/**
+ * Replace the value
+ *
+ * Concurrent writers are serialized, but one writer at a time is intended.
+ *
+ * @param lock  SeqLock handle
+ * @param value elem_size bytes
+ */
+void zeroipc_seqlock_write(zeroipc_seqlock_t* lock, const void* value);
+
+/**
+ * Get the sequence number: twice the number of completed writes, odd while
+ * a write is in progress
+ *
+ * @param lock SeqLock handle
+ * @return     Sequence number, or 0 on error
+ */
+uint64_t zeroipc_seqlock_sequence(zeroipc_seqlock_t* lock);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEROIPC_SEQLOCK_H */
@@ -11,9 +11,24 @@ extern "C" {
 /* Stack structure */
 typedef struct zeroipc_stack zeroipc_stack_t;
 
+/* Header layouts, recorded in the high byte of the header's elem_size field.
+ * COMPACT keeps top in the 16-byte header. PADDED_TOP moves top to offset 64
+ * so it has a cache line of its own, away from the read-mostly capacity and
+ * elem_size, and starts the data after a 128-byte header. C++ creates
+ * PADDED_TOP stacks by default. */
+#define ZEROIPC_STACK_COMPACT            0x00000000u
+#define ZEROIPC_STACK_PADDED_TOP         0x04000000u
+#define ZEROIPC_STACK_ELEM_SIZE_MASK     0x00FFFFFFu
+
+#define ZEROIPC_STACK_PADDED_TOP_OFFSET  64
+#define ZEROIPC_STACK_PADDED_HEADER_SIZE 128
+
 /* Stack operations */
 zeroipc_stack_t* zeroipc_stack_create(zeroipc_memory_t* mem, const char* name,
                                        size_t elem_size, size_t capacity);
+zeroipc_stack_t* zeroipc_stack_create_layout(zeroipc_memory_t* mem, const char* name,
+                                              size_t elem_size, size_t capacity,
+                                              uint32_t layout);
 zeroipc_stack_t* zeroipc_stack_open(zeroipc_memory_t* mem, const char* name);
 void zeroipc_stack_close(zeroipc_stack_t* stack);
 
@@ -69,8 +69,8 @@ zeroipc_array_t* zeroipc_array_open(zeroipc_memory_t* mem, const char* name) {
     }
     
     /* Find in table */
-    size_t offset, size;
-    int result = zeroipc_table_find(mem, name, &offset, &size);
+    size_t offset, size, align;
+    int result = zeroipc_table_find_aligned(mem, name, &offset, &size, &align);
     if (result != ZEROIPC_OK) {
         return NULL;
     }
@@ -85,13 +85,15 @@ zeroipc_array_t* zeroipc_array_open(zeroipc_memory_t* mem, const char* name) {
     strncpy(array->name, name, sizeof(array->name) - 1);
     
     /* Get header and data pointer */
+    /* Data starts on the section alignment recorded in the table entry */
+    size_t data_off = (sizeof(array_header_t) + align - 1) & ~(align - 1);
     array_header_t* header = (array_header_t*)((char*)zeroipc_memory_base(mem) + offset);
     if (header->capacity == 0 || header->elem_size == 0 ||
-        sizeof(array_header_t) + header->capacity * header->elem_size > size) {
+        data_off + header->capacity * header->elem_size > size) {
         free(array);
         return NULL;
     }
-    array->data = (char*)header + sizeof(array_header_t);
+    array->data = (char*)header + data_off;
     array->capacity = (size_t)header->capacity;
     array->elem_size = (size_t)header->elem_size;
     
@@ -23,6 +23,10 @@ const char* zeroipc_error_string(zeroipc_error_t error) {
             return "Version mismatch";
         case ZEROIPC_ERROR_ALREADY_EXISTS:
             return "Entry already exists";
+        case ZEROIPC_ERROR_TIMEOUT:
+            return "Timed out waiting for a peer";
+        case ZEROIPC_ERROR_ALIGNMENT:
+            return "Invalid alignment";
         default:
             return "Unknown error";
     }
@@ -2,16 +2,25 @@
  * ZeroIPC Raw FFI — stateless functions for Python ctypes integration.
  *
  * Each function takes (base, offset) and reinterprets the memory at
- * (base + offset) as a queue/stack header. All atomic operations use
+ * (base + offset) as a queue/stack/seqlock header. All atomic operations use
  * C11 stdatomic.h, giving Python true cross-process MPMC safety.
  *
  * Struct layouts match SPECIFICATION.md and the C++/Go/Python binary format.
  */
 
+#define _GNU_SOURCE
 #include "zeroipc_ffi.h"
+#include "table_layout.h"
+#include <limits.h>
 #include <sched.h>
 #include <stdatomic.h>
 #include <string.h>
+#include <time.h>
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 /* Return codes */
 #define FFI_OK       0
@@ -19,20 +28,37 @@
 #define FFI_FULL    -1
 #define FFI_MISMATCH -2
 #define FFI_INVALID  -3
+#define FFI_EXISTS   -4
+#define FFI_NOSPACE  -5
 
-/* Round n up to the next multiple of 8 (8-byte section alignment, format v2).
- * The atomic side-arrays (queue sequence, stack state) are placed on 8-byte
- * boundaries so their atomics are always naturally aligned. */
-#define ZIPC_ALIGN8(n) (((n) + 7u) & ~(size_t)7u)
+/* Round n up to the next multiple of the section alignment a (a power of
+ * two; 0 means the default 8). Every section (data array, atomic side-array)
+ * starts on the section alignment recorded in the structure's table entry,
+ * so the atomics are always naturally aligned. */
+static inline size_t zipc_align_up(size_t n, uint32_t a) {
+    if (a == 0) a = 8;
+    return (n + a - 1) & ~((size_t)a - 1);
+}
 
 /* ============================================================================
- * Queue layout (Vyukov bounded MPMC), format v2
+ * Queue layout (Vyukov bounded MPMC)
  * Header: [head:u32][tail:u32][capacity:u32][elem_size:u32] = 16 bytes
+ * Pad:    to the section alignment (none for the default 8)
  * Data:   capacity * elem_size bytes
- * Pad:    to next 8-byte boundary
- * Seqs:   capacity * 4 bytes (per-slot sequence numbers, 8-aligned)
+ * Pad:    to the section alignment
+ * Seqs:   capacity * 4 bytes (per-slot sequence numbers)
+ *
+ * Interleaved layouts (flags in the high byte of elem_size) store slot i as
+ * [data][pad to 4][seq:u32][pad to slot alignment] instead; see queue.c.
+ * The padded-header flag moves head/tail to offsets 64/128 and starts the
+ * slots at 192.
  * ============================================================================ */
 
+#define FFI_QUEUE_ELEM_SIZE_MASK 0x00FFFFFFu
+#define FFI_QUEUE_INTERLEAVED    0x01000000u
+#define FFI_QUEUE_PADDED         0x02000000u
+#define FFI_QUEUE_PADDED_HEADER  0x04000000u
+
 typedef struct {
     _Atomic uint32_t head;
     _Atomic uint32_t tail;
@@ -43,12 +69,15 @@ typedef struct {
 _Static_assert(sizeof(ffi_queue_header_t) == 16, "Queue header must be 16 bytes");
 
 static inline int q_validate(ffi_queue_header_t* h, uint32_t elem_size) {
-    if (h->capacity == 0 || h->elem_size == 0) return FFI_INVALID;
+    uint32_t layout = h->elem_size & ~(FFI_QUEUE_ELEM_SIZE_MASK | FFI_QUEUE_PADDED_HEADER);
+    if (h->capacity == 0 || (h->elem_size & FFI_QUEUE_ELEM_SIZE_MASK) == 0) return FFI_INVALID;
+    if (layout != 0 && layout != FFI_QUEUE_INTERLEAVED &&
+        layout != (FFI_QUEUE_INTERLEAVED | FFI_QUEUE_PADDED)) return FFI_INVALID;
     /* Wrap-safety requires a power-of-two capacity: the slot mapping
      * (counter % capacity) is only correct across the 2^32 counter
      * wraparound when capacity divides 2^32. */
     if ((h->capacity & (h->capacity - 1)) != 0) return FFI_INVALID;
-    if (h->elem_size != elem_size) return FFI_MISMATCH;
+    if ((h->elem_size & FFI_QUEUE_ELEM_SIZE_MASK) != elem_size) return FFI_MISMATCH;
     return FFI_OK;
 }
 
@@ -56,36 +85,71 @@ static inline ffi_queue_header_t* q_header(void* base, size_t offset) {
     return (ffi_queue_header_t*)((char*)base + offset);
 }
 
-static inline void* q_data(ffi_queue_header_t* h) {
-    return (char*)h + sizeof(ffi_queue_header_t);
+static inline _Atomic uint32_t* q_head(ffi_queue_header_t* h) {
+    if (h->elem_size & FFI_QUEUE_PADDED_HEADER) return (_Atomic uint32_t*)((char*)h + 64);
+    return &h->head;
 }
 
-static inline _Atomic uint32_t* q_seqs(ffi_queue_header_t* h) {
-    return (_Atomic uint32_t*)((char*)q_data(h)
-                              + ZIPC_ALIGN8((size_t)h->capacity * h->elem_size));
+static inline _Atomic uint32_t* q_tail(ffi_queue_header_t* h) {
+    if (h->elem_size & FFI_QUEUE_PADDED_HEADER) return (_Atomic uint32_t*)((char*)h + 128);
+    return &h->tail;
+}
+
+/* Where slot i lives: element at data + i * data_stride, sequence number
+ * at seq + i * seq_stride */
+typedef struct {
+    char* data;
+    char* seq;
+    size_t data_stride;
+    size_t seq_stride;
+} ffi_queue_slots_t;
+
+static inline ffi_queue_slots_t q_slots(ffi_queue_header_t* h, uint32_t align) {
+    ffi_queue_slots_t s;
+    size_t elem_size = h->elem_size & FFI_QUEUE_ELEM_SIZE_MASK;
+    size_t header_size = (h->elem_size & FFI_QUEUE_PADDED_HEADER)
+        ? 192 : sizeof(ffi_queue_header_t);
+    if (!(h->elem_size & FFI_QUEUE_INTERLEAVED)) {
+        s.data = (char*)h + zipc_align_up(header_size, align);
+        s.seq = s.data + zipc_align_up((size_t)h->capacity * elem_size, align);
+        s.data_stride = elem_size;
+        s.seq_stride = sizeof(uint32_t);
+    } else {
+        if (align == 0) align = 8;
+        uint32_t slot_align = ((h->elem_size & FFI_QUEUE_PADDED) && align < 64) ? 64 : align;
+        size_t seq_in_slot = zipc_align_up(elem_size, sizeof(uint32_t));
+        s.data = (char*)h + zipc_align_up(header_size, slot_align);
+        s.seq = s.data + seq_in_slot;
+        s.data_stride = zipc_align_up(seq_in_slot + sizeof(uint32_t), slot_align);
+        s.seq_stride = s.data_stride;
+    }
+    return s;
+}
+
+static inline _Atomic uint32_t* q_seq(const ffi_queue_slots_t* s, uint32_t slot) {
+    return (_Atomic uint32_t*)(s->seq + slot * s->seq_stride);
 }
 
 int zeroipc_raw_queue_push(void* base, size_t offset,
-                           const void* value, uint32_t elem_size) {
+                           const void* value, uint32_t elem_size, uint32_t align) {
     ffi_queue_header_t* h = q_header(base, offset);
     int rc = q_validate(h, elem_size);
     if (rc != FFI_OK) return rc;
 
-    _Atomic uint32_t* seq = q_seqs(h);
-    void* data = q_data(h);
+    ffi_queue_slots_t slots = q_slots(h, align);
     uint32_t cap = h->capacity;
     uint32_t tail, slot;
     int32_t diff;
 
     for (;;) {
-        tail = atomic_load_explicit(&h->tail, memory_order_relaxed);
+        tail = atomic_load_explicit(q_tail(h), memory_order_relaxed);
         slot = tail % cap;
-        uint32_t s = atomic_load_explicit(&seq[slot], memory_order_acquire);
+        uint32_t s = atomic_load_explicit(q_seq(&slots, slot), memory_order_acquire);
         diff = (int32_t)(s - tail);
 
         if (diff == 0) {
             if (atomic_compare_exchange_weak_explicit(
-                    &h->tail, &tail, tail + 1,
+                    q_tail(h), &tail, tail + 1,
                     memory_order_relaxed, memory_order_relaxed))
                 break;
         } else if (diff < 0) {
@@ -95,32 +159,31 @@ int zeroipc_raw_queue_push(void* base, size_t offset,
     }
 
     /* Write data, then publish */
-    memcpy((char*)data + slot * elem_size, value, elem_size);
-    atomic_store_explicit(&seq[slot], tail + 1, memory_order_release);
+    memcpy(slots.data + slot * slots.data_stride, value, elem_size);
+    atomic_store_explicit(q_seq(&slots, slot), tail + 1, memory_order_release);
     return FFI_OK;
 }
 
 int zeroipc_raw_queue_pop(void* base, size_t offset,
-                          void* value_out, uint32_t elem_size) {
+                          void* value_out, uint32_t elem_size, uint32_t align) {
     ffi_queue_header_t* h = q_header(base, offset);
     int rc = q_validate(h, elem_size);
     if (rc != FFI_OK) return rc;
 
-    _Atomic uint32_t* seq = q_seqs(h);
-    void* data = q_data(h);
+    ffi_queue_slots_t slots = q_slots(h, align);
     uint32_t cap = h->capacity;
     uint32_t head, slot;
     int32_t diff;
 
     for (;;) {
-        head = atomic_load_explicit(&h->head, memory_order_relaxed);
+        head = atomic_load_explicit(q_head(h), memory_order_relaxed);
         slot = head % cap;
-        uint32_t s = atomic_load_explicit(&seq[slot], memory_order_acquire);
+        uint32_t s = atomic_load_explicit(q_seq(&slots, slot), memory_order_acquire);
         diff = (int32_t)(s - (head + 1));
 
         if (diff == 0) {
             if (atomic_compare_exchange_weak_explicit(
-                    &h->head, &head, head + 1,
+                    q_head(h), &head, head + 1,
                     memory_order_relaxed, memory_order_relaxed))
                 break;
         } else if (diff < 0) {
@@ -129,15 +192,15 @@ int zeroipc_raw_queue_pop(void* base, size_t offset,
     }
 
     /* Read data, then recycle slot */
-    memcpy(value_out, (char*)data + slot * elem_size, elem_size);
-    atomic_store_explicit(&seq[slot], head + cap, memory_order_release);
+    memcpy(value_out, slots.data + slot * slots.data_stride, elem_size);
+    atomic_store_explicit(q_seq(&slots, slot), head + cap, memory_order_release);
     return FFI_OK;
 }
 
 uint32_t zeroipc_raw_queue_size(void* base, size_t offset) {
     ffi_queue_header_t* h = q_header(base, offset);
-    uint32_t tail = atomic_load_explicit(&h->tail, memory_order_relaxed);
-    uint32_t head = atomic_load_explicit(&h->head, memory_order_relaxed);
+    uint32_t tail = atomic_load_explicit(q_tail(h), memory_order_relaxed);
+    uint32_t head = atomic_load_explicit(q_head(h), memory_order_relaxed);
     return tail - head;
 }
 
@@ -147,19 +210,26 @@ int zeroipc_raw_queue_empty(void* base, size_t offset) {
 
 int zeroipc_raw_queue_full(void* base, size_t offset) {
     ffi_queue_header_t* h = q_header(base, offset);
-    uint32_t tail = atomic_load_explicit(&h->tail, memory_order_relaxed);
-    uint32_t head = atomic_load_explicit(&h->head, memory_order_relaxed);
+    uint32_t tail = atomic_load_explicit(q_tail(h), memory_order_relaxed);
+    uint32_t head = atomic_load_explicit(q_head(h), memory_order_relaxed);
     return (tail - head) >= h->capacity;
 }
 
 /* ============================================================================
  * Stack layout (4-state CAS), format v2
  * Header: [top:i32][capacity:u32][elem_size:u32][reserved:u32] = 16 bytes
+ * Pad:    to the section alignment (none for the default 8)
  * Data:   capacity * elem_size bytes
- * Pad:    to next 8-byte boundary
- * State:  capacity * 4 bytes (per-slot state: EMPTY/WRITING/READY/READING, 8-aligned)
+ * Pad:    to the section alignment
+ * State:  capacity * 4 bytes (per-slot state: EMPTY/WRITING/READY/READING)
+ *
+ * The padded-top flag (high byte of elem_size) moves top to offset 64 and
+ * starts the data at 128.
  * ============================================================================ */
 
+#define FFI_STACK_ELEM_SIZE_MASK 0x00FFFFFFu
+#define FFI_STACK_PADDED_TOP     0x04000000u
+
 typedef struct {
     _Atomic int32_t top;
     uint32_t capacity;
@@ -170,8 +240,9 @@ typedef struct {
 _Static_assert(sizeof(ffi_stack_header_t) == 16, "Stack header must be 16 bytes");
 
 static inline int s_validate(ffi_stack_header_t* h, uint32_t elem_size) {
-    if (h->capacity == 0 || h->elem_size == 0) return FFI_INVALID;
-    if (h->elem_size != elem_size) return FFI_MISMATCH;
+    if (h->capacity == 0 || (h->elem_size & FFI_STACK_ELEM_SIZE_MASK) == 0) return FFI_INVALID;
+    if (h->elem_size & ~(FFI_STACK_ELEM_SIZE_MASK | FFI_STACK_PADDED_TOP)) return FFI_INVALID;
+    if ((h->elem_size & FFI_STACK_ELEM_SIZE_MASK) != elem_size) return FFI_MISMATCH;
     return FFI_OK;
 }
 
@@ -192,33 +263,42 @@ static inline ffi_stack_header_t* s_header(void* base, size_t offset) {
     return (ffi_stack_header_t*)((char*)base + offset);
 }
 
-static inline void* s_data(ffi_stack_header_t* h) {
-    return (char*)h + sizeof(ffi_stack_header_t);
+static inline _Atomic int32_t* s_top(ffi_stack_header_t* h) {
+    if (h->elem_size & FFI_STACK_PADDED_TOP) return (_Atomic int32_t*)((char*)h + 64);
+    return &h->top;
+}
+
+static inline void* s_data(ffi_stack_header_t* h, uint32_t align) {
+    size_t header_size = (h->elem_size & FFI_STACK_PADDED_TOP)
+        ? 128 : sizeof(ffi_stack_header_t);
+    return (char*)h + zipc_align_up(header_size, align);
 }
 
-static inline _Atomic uint32_t* s_state(ffi_stack_header_t* h) {
-    return (_Atomic uint32_t*)((char*)s_data(h)
-                              + ZIPC_ALIGN8((size_t)h->capacity * h->elem_size));
+static inline _Atomic uint32_t* s_state(ffi_stack_header_t* h, uint32_t align) {
+    size_t elem_size = h->elem_size & FFI_STACK_ELEM_SIZE_MASK;
+    return (_Atomic uint32_t*)((char*)s_data(h, align)
+                              + zipc_align_up((size_t)h->capacity * elem_size, align));
 }
 
 int zeroipc_raw_stack_push(void* base, size_t offset,
-                           const void* value, uint32_t elem_size) {
+                           const void* value, uint32_t elem_size, uint32_t align) {
     ffi_stack_header_t* h = s_header(base, offset);
     int rc = s_validate(h, elem_size);
     if (rc != FFI_OK) return rc;
 
-    _Atomic uint32_t* state = s_state(h);
-    void* data = s_data(h);
+    _Atomic uint32_t* state = s_state(h, align);
+    void* data = s_data(h, align);
+    _Atomic int32_t* top = s_top(h);
     int32_t current_top, new_top;
 
     /* Step 1: Reserve slot by CAS-incrementing top */
     do {
-        current_top = atomic_load_explicit(&h->top, memory_order_relaxed);
+        current_top = atomic_load_explicit(top, memory_order_relaxed);
         if (current_top >= (int32_t)(h->capacity - 1))
             return FFI_FULL;
         new_top = current_top + 1;
     } while (!atomic_compare_exchange_weak_explicit(
-                &h->top, &current_top, new_top,
+                top, &current_top, new_top,
                 memory_order_acq_rel, memory_order_relaxed));
 
     /* Step 2: CAS slot EMPTY -> WRITING. Bounded spin: a crashed peer can
@@ -239,7 +319,7 @@ int zeroipc_raw_stack_push(void* base, size_t offset,
         /* Best-effort undo of the top reservation. */
         int32_t reserved = new_top;
         atomic_compare_exchange_strong_explicit(
-            &h->top, &reserved, current_top,
+            top, &reserved, current_top,
             memory_order_acq_rel, memory_order_relaxed);
         return FFI_FULL;
     }
@@ -253,23 +333,24 @@ int zeroipc_raw_stack_push(void* base, size_t offset,
 }
 
 int zeroipc_raw_stack_pop(void* base, size_t offset,
-                          void* value_out, uint32_t elem_size) {
+                          void* value_out, uint32_t elem_size, uint32_t align) {
     ffi_stack_header_t* h = s_header(base, offset);
     int rc = s_validate(h, elem_size);
     if (rc != FFI_OK) return rc;
 
-    _Atomic uint32_t* state = s_state(h);
-    void* data = s_data(h);
+    _Atomic uint32_t* state = s_state(h, align);
+    void* data = s_data(h, align);
+    _Atomic int32_t* top = s_top(h);
     int32_t current_top, new_top;
 
     /* Step 1: Reserve slot by CAS-decrementing top */
     do {
-        current_top = atomic_load_explicit(&h->top, memory_order_relaxed);
+        current_top = atomic_load_explicit(top, memory_order_relaxed);
         if (current_top < 0)
             return FFI_EMPTY;
         new_top = current_top - 1;
     } while (!atomic_compare_exchange_weak_explicit(
-                &h->top, &current_top, new_top,
+                top, &current_top, new_top,
                 memory_order_acq_rel, memory_order_relaxed));
 
     /* Step 2: CAS slot READY -> READING. Bounded spin: a pusher that crashed
@@ -291,7 +372,7 @@ int zeroipc_raw_stack_pop(void* base, size_t offset,
          * silently dropped. */
         int32_t reserved = new_top;
         atomic_compare_exchange_strong_explicit(
-            &h->top, &reserved, current_top,
+            top, &reserved, current_top,
             memory_order_acq_rel, memory_order_relaxed);
         return FFI_EMPTY;
     }
@@ -304,18 +385,119 @@ int zeroipc_raw_stack_pop(void* base, size_t offset,
     return FFI_OK;
 }
 
+/* Bounded CAS of one stack slot between states (see stack push/pop) */
+static int s_claim(_Atomic uint32_t* state, uint32_t from, uint32_t to) {
+    for (int spins = 0; spins < FFI_MAX_SPINS; ++spins) {
+        uint32_t expected = from;
+        if (atomic_compare_exchange_weak_explicit(
+                state, &expected, to,
+                memory_order_acq_rel, memory_order_relaxed))
+            return 1;
+        sched_yield();
+    }
+    return 0;
+}
+
+/* Batched push: one CAS reserves up to count slots above top, which are then
+ * filled bottom-up (values[count-1] pops first). Returns the number pushed
+ * (0 when full) or a negative error. */
+int zeroipc_raw_stack_push_n(void* base, size_t offset, const void* values,
+                             uint32_t count, uint32_t elem_size, uint32_t align) {
+    ffi_stack_header_t* h = s_header(base, offset);
+    int rc = s_validate(h, elem_size);
+    if (rc != FFI_OK) return rc;
+
+    _Atomic uint32_t* state = s_state(h, align);
+    char* data = (char*)s_data(h, align);
+    _Atomic int32_t* top = s_top(h);
+    int32_t current_top, new_top;
+
+    do {
+        current_top = atomic_load_explicit(top, memory_order_relaxed);
+        int32_t room = (int32_t)h->capacity - 1 - current_top;
+        if (room <= 0 || count == 0)
+            return 0;
+        new_top = current_top + ((int64_t)count < room ? (int32_t)count : room);
+    } while (!atomic_compare_exchange_weak_explicit(
+                top, &current_top, new_top,
+                memory_order_acq_rel, memory_order_relaxed));
+
+    int pushed = 0;
+    for (int32_t slot = current_top + 1; slot <= new_top; ++slot) {
+        if (!s_claim(&state[slot], SLOT_EMPTY, SLOT_WRITING)) {
+            /* Stuck slot: hand back the unused range if top has not moved,
+             * otherwise skip it as a single push would leave it. */
+            int32_t reserved = new_top;
+            if (atomic_compare_exchange_strong_explicit(
+                    top, &reserved, slot - 1,
+                    memory_order_acq_rel, memory_order_relaxed))
+                return pushed;
+            continue;
+        }
+        memcpy(data + (size_t)slot * elem_size,
+               (const char*)values + (size_t)pushed * elem_size, elem_size);
+        atomic_store_explicit(&state[slot], SLOT_READY, memory_order_release);
+        pushed++;
+    }
+    return pushed;
+}
+
+/* Batched pop: one CAS releases up to count slots below top, copied out most
+ * recent first. Returns the number popped (0 when empty) or a negative
+ * error. */
+int zeroipc_raw_stack_pop_n(void* base, size_t offset, void* values_out,
+                            uint32_t count, uint32_t elem_size, uint32_t align) {
+    ffi_stack_header_t* h = s_header(base, offset);
+    int rc = s_validate(h, elem_size);
+    if (rc != FFI_OK) return rc;
+
+    _Atomic uint32_t* state = s_state(h, align);
+    char* data = (char*)s_data(h, align);
+    _Atomic int32_t* top = s_top(h);
+    int32_t current_top, new_top;
+
+    do {
+        current_top = atomic_load_explicit(top, memory_order_relaxed);
+        if (current_top < 0 || count == 0)
+            return 0;
+        new_top = current_top -
+            ((int64_t)count < (int64_t)current_top + 1 ? (int32_t)count : current_top + 1);
+    } while (!atomic_compare_exchange_weak_explicit(
+                top, &current_top, new_top,
+                memory_order_acq_rel, memory_order_relaxed));
+
+    int popped = 0;
+    for (int32_t slot = current_top; slot > new_top; --slot) {
+        if (!s_claim(&state[slot], SLOT_READY, SLOT_READING)) {
+            /* Stuck slot: put it and the rest back if top has not moved */
+            int32_t reserved = new_top;
+            if (atomic_compare_exchange_strong_explicit(
+                    top, &reserved, slot,
+                    memory_order_acq_rel, memory_order_relaxed))
+                return popped;
+            continue;
+        }
+        memcpy((char*)values_out + (size_t)popped * elem_size,
+               data + (size_t)slot * elem_size, elem_size);
+        atomic_store_explicit(&state[slot], SLOT_EMPTY, memory_order_release);
+        popped++;
+    }
+    return popped;
+}
+
 /* Best-effort peek: must win a CAS on the slot state to read safely, so under
  * heavy contention (or a crashed peer holding the slot) it can return
  * FFI_EMPTY even though the stack is non-empty. Callers should not treat that
  * as an authoritative emptiness check. */
 int zeroipc_raw_stack_top(void* base, size_t offset,
-                          void* value_out, uint32_t elem_size) {
+                          void* value_out, uint32_t elem_size, uint32_t align) {
     ffi_stack_header_t* h = s_header(base, offset);
     int rc = s_validate(h, elem_size);
     if (rc != FFI_OK) return rc;
 
-    _Atomic uint32_t* state = s_state(h);
-    void* data = s_data(h);
+    _Atomic uint32_t* state = s_state(h, align);
+    void* data = s_data(h, align);
+    _Atomic int32_t* top_ptr = s_top(h);
 
     /* A peek cannot passively read the slot: between observing READY and the
      * memcpy, a concurrent pop could recycle the slot and a new push begin
@@ -323,7 +505,7 @@ int zeroipc_raw_stack_top(void* base, size_t offset,
      * the same state machine pop uses (READY -> READING), copy, then restore
      * it to READY. The bounded spin preserves crash-safety. */
     for (int spins = 0; spins < FFI_MAX_SPINS; ++spins) {
-        int32_t top = atomic_load_explicit(&h->top, memory_order_acquire);
+        int32_t top = atomic_load_explicit(top_ptr, memory_order_acquire);
         if (top < 0) return FFI_EMPTY;
 
         uint32_t expected = SLOT_READY;
@@ -341,7 +523,7 @@ int zeroipc_raw_stack_top(void* base, size_t offset,
 
 uint32_t zeroipc_raw_stack_size(void* base, size_t offset) {
     ffi_stack_header_t* h = s_header(base, offset);
-    int32_t top = atomic_load_explicit(&h->top, memory_order_relaxed);
+    int32_t top = atomic_load_explicit(s_top(h), memory_order_relaxed);
     return top < 0 ? 0 : (uint32_t)(top + 1);
 }
 
@@ -351,6 +533,646 @@ int zeroipc_raw_stack_empty(void* base, size_t offset) {
 
 int zeroipc_raw_stack_full(void* base, size_t offset) {
     ffi_stack_header_t* h = s_header(base, offset);
-    int32_t top = atomic_load_explicit(&h->top, memory_order_relaxed);
+    int32_t top = atomic_load_explicit(s_top(h), memory_order_relaxed);
     return top >= (int32_t)(h->capacity - 1);
 }
+
+/* ============================================================================
+ * SeqLock layout
+ * Header: [seq:u64][elem_size:u32][reserved:u32] = 16 bytes
+ * Pad:    to the section alignment (none for the default 8)
+ * Value:  elem_size bytes
+ * seq is even while the value is stable and odd during a write.
+ * ============================================================================ */
+
+#define FFI_SEQLOCK_SPIN_ATTEMPTS 64
+#define FFI_SEQLOCK_READ_ATTEMPTS (1 << 20)
+
+typedef struct {
+    _Atomic uint64_t seq;
+    uint32_t elem_size;
+    _Atomic uint32_t waiters;  /* Threads parked on the low half of seq */
+} ffi_seqlock_header_t;
+
+_Static_assert(sizeof(ffi_seqlock_header_t) == 16, "SeqLock header must be 16 bytes");
+
+static inline ffi_seqlock_header_t* sl_header(void* base, size_t offset) {
+    return (ffi_seqlock_header_t*)((char*)base + offset);
+}
+
+static inline unsigned char* sl_value(ffi_seqlock_header_t* h, uint32_t align) {
+    return (unsigned char*)h + zipc_align_up(sizeof(ffi_seqlock_header_t), align);
+}
+
+int zeroipc_raw_seqlock_read(void* base, size_t offset,
+                             void* value_out, uint32_t elem_size, uint32_t align) {
+    ffi_seqlock_header_t* h = sl_header(base, offset);
+    if (h->elem_size == 0) return FFI_INVALID;
+    if (h->elem_size != elem_size) return FFI_MISMATCH;
+    const unsigned char* value = sl_value(h, align);
+
+    for (int attempt = 0; attempt < FFI_SEQLOCK_READ_ATTEMPTS; attempt++) {
+        uint64_t before = atomic_load_explicit(&h->seq, memory_order_acquire);
+        if ((before & 1) == 0) {
+            memcpy(value_out, value, elem_size);
+            atomic_thread_fence(memory_order_acquire);
+            if (atomic_load_explicit(&h->seq, memory_order_relaxed) == before) {
+                return FFI_OK;
+            }
+        }
+        if (attempt >= FFI_SEQLOCK_SPIN_ATTEMPTS) {
+            sched_yield();
+        }
+    }
+    return FFI_EMPTY;  /* Writer died mid-write */
+}
+
+void zeroipc_raw_seqlock_write_begin(void* base, size_t offset) {
+    ffi_seqlock_header_t* h = sl_header(base, offset);
+    for (int spins = 0;; spins++) {
+        uint64_t seq = atomic_load_explicit(&h->seq, memory_order_relaxed);
+        if ((seq & 1) == 0 &&
+            atomic_compare_exchange_weak_explicit(&h->seq, &seq, seq + 1,
+                                                  memory_order_acquire,
+                                                  memory_order_relaxed)) {
+            break;
+        }
+        if (spins >= FFI_SEQLOCK_SPIN_ATTEMPTS) {
+            sched_yield();
+        }
+    }
+    atomic_thread_fence(memory_order_release);
+}
+
+void zeroipc_raw_seqlock_write_end(void* base, size_t offset) {
+    ffi_seqlock_header_t* h = sl_header(base, offset);
+    atomic_fetch_add_explicit(&h->seq, 1, memory_order_seq_cst);
+#ifdef __linux__
+    if (atomic_load_explicit(&h->waiters, memory_order_seq_cst) != 0) {
+        syscall(SYS_futex, (uint32_t*)&h->seq, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+    }
+#endif
+}
+
+int zeroipc_raw_seqlock_write(void* base, size_t offset,
+                              const void* value, uint32_t elem_size, uint32_t align) {
+    ffi_seqlock_header_t* h = sl_header(base, offset);
+    if (h->elem_size == 0) return FFI_INVALID;
+    if (h->elem_size != elem_size) return FFI_MISMATCH;
+
+    zeroipc_raw_seqlock_write_begin(base, offset);
+    memcpy(sl_value(h, align), value, elem_size);
+    zeroipc_raw_seqlock_write_end(base, offset);
+    return FFI_OK;
+}
+
+uint64_t zeroipc_raw_seqlock_sequence(void* base, size_t offset) {
+    return atomic_load_explicit(&sl_header(base, offset)->seq, memory_order_acquire);
+}
+
+static int64_t ffi_monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/* Longest single sleep, so writers that cannot wake still get noticed */
+#define FFI_SEQLOCK_PARK_SLICE_NS 100000000LL
+
+int zeroipc_raw_seqlock_wait(void* base, size_t offset, uint64_t seen, int64_t timeout_ns) {
+    ffi_seqlock_header_t* h = sl_header(base, offset);
+    int64_t deadline = ffi_monotonic_ns() + timeout_ns;
+
+    for (;;) {
+        uint64_t seq = atomic_load_explicit(&h->seq, memory_order_acquire);
+        if ((seq & ~(uint64_t)1) != (seen & ~(uint64_t)1)) {
+            return FFI_OK;
+        }
+        int64_t left = deadline - ffi_monotonic_ns();
+        if (left <= 0) {
+            return FFI_EMPTY;
+        }
+        if (left > FFI_SEQLOCK_PARK_SLICE_NS) {
+            left = FFI_SEQLOCK_PARK_SLICE_NS;
+        }
+
+        atomic_fetch_add_explicit(&h->waiters, 1, memory_order_seq_cst);
+        if (atomic_load_explicit(&h->seq, memory_order_seq_cst) == seq) {
+#ifdef __linux__
+            struct timespec ts = { left / 1000000000, left % 1000000000 };
+            syscall(SYS_futex, (uint32_t*)&h->seq, FUTEX_WAIT, (uint32_t)seq, &ts, NULL, 0);
+#else
+            sched_yield();
+#endif
+        }
+        atomic_fetch_sub_explicit(&h->waiters, 1, memory_order_relaxed);
+    }
+}
+
+/* ============================================================================
+ * Semaphore release (same protocol as C++ Semaphore::release)
+ * CAS the count up within max_count, then wake the count's futex word if
+ * anyone is waiting: C++ acquirers sleep there.
+ * ============================================================================ */
+
+typedef struct {
+    _Atomic int32_t count;
+    _Atomic int32_t waiting;
+    int32_t max_count;
+    int32_t queue_slots;
+} ffi_semaphore_header_t;
+
+int zeroipc_raw_semaphore_release(void* base, size_t offset, int32_t permits) {
+    ffi_semaphore_header_t* h = (ffi_semaphore_header_t*)((char*)base + offset);
+    if (permits <= 0) return FFI_INVALID;
+
+    int32_t current = atomic_load_explicit(&h->count, memory_order_relaxed);
+    do {
+        if (h->max_count > 0 ? current > h->max_count - permits
+                             : current > INT32_MAX - permits) {
+            return FFI_FULL;
+        }
+    } while (!atomic_compare_exchange_weak_explicit(&h->count, &current, current + permits,
+                                                    memory_order_seq_cst,
+                                                    memory_order_relaxed));
+#ifdef __linux__
+    if (atomic_load_explicit(&h->waiting, memory_order_seq_cst) != 0) {
+        syscall(SYS_futex, (uint32_t*)&h->count, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+    }
+#endif
+    return FFI_OK;
+}
+
+/* ============================================================================
+ * RWLock (same protocol as C++ RWLock)
+ * State: [word:u32][parked:u32] = 8 bytes. word holds the reader count
+ * (bits 0-29), WRITER_WAITING (bit 30) and WRITER (bit 31). Blocked threads
+ * count themselves in parked and futex-wait on word; unlocks wake only when
+ * parked is nonzero.
+ * ============================================================================ */
+
+#define FFI_RWLOCK_WRITER         0x80000000u
+#define FFI_RWLOCK_WRITER_WAITING 0x40000000u
+#define FFI_RWLOCK_READERS_MASK   0x3FFFFFFFu
+#define FFI_RWLOCK_SPIN_LIMIT     128
+#define FFI_PARK_SLICE_NS         100000000LL
+
+typedef struct {
+    _Atomic uint32_t word;
+    _Atomic uint32_t parked;
+} ffi_rwlock_state_t;
+
+_Static_assert(sizeof(ffi_rwlock_state_t) == 8, "RWLock state must be 8 bytes");
+
+static inline ffi_rwlock_state_t* rw_state(void* base, size_t offset) {
+    return (ffi_rwlock_state_t*)((char*)base + offset);
+}
+
+/* Negative timeouts wait forever (deadline -1) */
+static int64_t ffi_deadline(int64_t timeout_ns) {
+    return timeout_ns < 0 ? -1 : ffi_monotonic_ns() + timeout_ns;
+}
+
+/* How long the next sleep may last: one park slice, or what is left before
+ * the deadline. 0 once the deadline has passed. */
+static int64_t ffi_park_slice(int64_t deadline) {
+    int64_t left = FFI_PARK_SLICE_NS;
+    if (deadline >= 0) {
+        int64_t remaining = deadline - ffi_monotonic_ns();
+        if (remaining <= 0) return 0;
+        if (remaining < left) left = remaining;
+    }
+    return left;
+}
+
+/* Futex-wait on word while it still reads `seen`, for at most left_ns */
+static void ffi_futex_wait(_Atomic uint32_t* word, uint32_t seen, int64_t left_ns) {
+#ifdef __linux__
+    struct timespec ts = { left_ns / 1000000000, left_ns % 1000000000 };
+    syscall(SYS_futex, (uint32_t*)word, FUTEX_WAIT, seen, &ts, NULL, 0);
+#else
+    (void)word;
+    (void)seen;
+    (void)left_ns;
+    sched_yield();
+#endif
+}
+
+static void ffi_futex_wake(_Atomic uint32_t* word, int count) {
+#ifdef __linux__
+    syscall(SYS_futex, (uint32_t*)word, FUTEX_WAKE, count, NULL, NULL, 0);
+#else
+    (void)word;
+    (void)count;
+#endif
+}
+
+/* Sleep on word while it still reads `seen`, for at most one park slice or
+ * what is left before the deadline. Returns 0 once the deadline has passed. */
+static int ffi_park(_Atomic uint32_t* word, _Atomic uint32_t* parked,
+                    uint32_t seen, int64_t deadline) {
+    int64_t left = ffi_park_slice(deadline);
+    if (left == 0) return 0;
+    atomic_fetch_add_explicit(parked, 1, memory_order_seq_cst);
+    ffi_futex_wait(word, seen, left);
+    atomic_fetch_sub_explicit(parked, 1, memory_order_relaxed);
+    return 1;
+}
+
+static void rw_wake_parked(ffi_rwlock_state_t* l) {
+    if (atomic_load_explicit(&l->parked, memory_order_seq_cst) != 0) {
+        ffi_futex_wake(&l->word, INT_MAX);
+    }
+}
+
+static void rw_release_reader(ffi_rwlock_state_t* l) {
+    uint32_t prev = atomic_fetch_sub_explicit(&l->word, 1, memory_order_seq_cst);
+    /* Only a writer waiting for the count to drain cares about this */
+    if ((prev & FFI_RWLOCK_READERS_MASK) == 1 && (prev & FFI_RWLOCK_WRITER_WAITING)) {
+        rw_wake_parked(l);
+    }
+}
+
+int zeroipc_raw_rwlock_try_read_lock(void* base, size_t offset) {
+    ffi_rwlock_state_t* l = rw_state(base, offset);
+    uint32_t s = atomic_load_explicit(&l->word, memory_order_relaxed);
+    while ((s & (FFI_RWLOCK_WRITER | FFI_RWLOCK_WRITER_WAITING)) == 0) {
+        if (atomic_compare_exchange_weak_explicit(&l->word, &s, s + 1,
+                                                  memory_order_acquire,
+                                                  memory_order_relaxed)) {
+            return FFI_OK;
+        }
+    }
+    return FFI_EMPTY;
+}
+
+int zeroipc_raw_rwlock_read_lock(void* base, size_t offset, int64_t timeout_ns) {
+    ffi_rwlock_state_t* l = rw_state(base, offset);
+    uint32_t prev = atomic_fetch_add_explicit(&l->word, 1, memory_order_acquire);
+    if ((prev & (FFI_RWLOCK_WRITER | FFI_RWLOCK_WRITER_WAITING)) == 0) {
+        return FFI_OK;
+    }
+    /* A writer holds or wants the lock: back out, then wait our turn */
+    rw_release_reader(l);
+
+    int64_t deadline = ffi_deadline(timeout_ns);
+    for (int spins = 0;; spins++) {
+        uint32_t s = atomic_load_explicit(&l->word, memory_order_relaxed);
+        if ((s & (FFI_RWLOCK_WRITER | FFI_RWLOCK_WRITER_WAITING)) == 0) {
+            if (atomic_compare_exchange_weak_explicit(&l->word, &s, s + 1,
+                                                      memory_order_acquire,
+                                                      memory_order_relaxed)) {
+                return FFI_OK;
+            }
+            continue;
+        }
+        if (spins < FFI_RWLOCK_SPIN_LIMIT) {
+            sched_yield();
+            continue;
+        }
+        if (!ffi_park(&l->word, &l->parked, s, deadline)) {
+            return FFI_EMPTY;
+        }
+    }
+}
+
+void zeroipc_raw_rwlock_read_unlock(void* base, size_t offset) {
+    rw_release_reader(rw_state(base, offset));
+}
+
+int zeroipc_raw_rwlock_try_write_lock(void* base, size_t offset) {
+    ffi_rwlock_state_t* l = rw_state(base, offset);
+    uint32_t s = atomic_load_explicit(&l->word, memory_order_relaxed);
+    while ((s & ~FFI_RWLOCK_WRITER_WAITING) == 0) {
+        if (atomic_compare_exchange_weak_explicit(&l->word, &s, FFI_RWLOCK_WRITER,
+                                                  memory_order_acquire,
+                                                  memory_order_relaxed)) {
+            return FFI_OK;
+        }
+    }
+    return FFI_EMPTY;
+}
+
+int zeroipc_raw_rwlock_write_lock(void* base, size_t offset, int64_t timeout_ns) {
+    ffi_rwlock_state_t* l = rw_state(base, offset);
+    uint32_t expected = 0;
+    if (atomic_compare_exchange_strong_explicit(&l->word, &expected, FFI_RWLOCK_WRITER,
+                                                memory_order_acquire,
+                                                memory_order_relaxed)) {
+        return FFI_OK;
+    }
+
+    /* Take the lock once it is free (whoever set WRITER_WAITING, the new
+     * owner clears it); otherwise announce ourselves so no new readers get
+     * in, and wait */
+    int64_t deadline = ffi_deadline(timeout_ns);
+    int announced = 0;
+    for (int spins = 0;; spins++) {
+        uint32_t s = atomic_load_explicit(&l->word, memory_order_relaxed);
+        if ((s & ~FFI_RWLOCK_WRITER_WAITING) == 0) {
+            if (atomic_compare_exchange_weak_explicit(&l->word, &s, FFI_RWLOCK_WRITER,
+                                                      memory_order_acquire,
+                                                      memory_order_relaxed)) {
+                return FFI_OK;
+            }
+            continue;
+        }
+        if (!(s & FFI_RWLOCK_WRITER_WAITING)) {
+            if (atomic_compare_exchange_weak_explicit(&l->word, &s,
+                                                      s | FFI_RWLOCK_WRITER_WAITING,
+                                                      memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+                announced = 1;
+            }
+            continue;
+        }
+        if (spins < FFI_RWLOCK_SPIN_LIMIT) {
+            sched_yield();
+            continue;
+        }
+        if (!ffi_park(&l->word, &l->parked, s, deadline)) {
+            /* Stop holding readers off. Other writers still waiting see the
+             * bit gone when woken and set it again. */
+            if (announced) {
+                atomic_fetch_and_explicit(&l->word, ~FFI_RWLOCK_WRITER_WAITING,
+                                          memory_order_seq_cst);
+                rw_wake_parked(l);
+            }
+            return FFI_EMPTY;
+        }
+    }
+}
+
+void zeroipc_raw_rwlock_write_unlock(void* base, size_t offset) {
+    ffi_rwlock_state_t* l = rw_state(base, offset);
+    atomic_fetch_and_explicit(&l->word, ~FFI_RWLOCK_WRITER, memory_order_seq_cst);
+    rw_wake_parked(l);
+}
+
+/* ============================================================================
+ * Monitor (same protocol as C++ Monitor)
+ * State: [lock:u32][seq:u32][waiters:u32][reserved:u32] = 16 bytes. lock is
+ * 0 unlocked, 1 locked, 2 locked with sleepers possibly queued on it. wait
+ * sleeps on seq, which every notify bumps; notify_all requeues all but one
+ * waiter onto lock so unlocks hand it to them one at a time.
+ * ============================================================================ */
+
+#define FFI_MONITOR_UNLOCKED   0u
+#define FFI_MONITOR_LOCKED     1u
+#define FFI_MONITOR_CONTENDED  2u
+#define FFI_MONITOR_SPIN_LIMIT 128
+
+typedef struct {
+    _Atomic uint32_t lock;
+    _Atomic uint32_t seq;
+    _Atomic uint32_t waiters;
+    uint32_t reserved;
+} ffi_monitor_state_t;
+
+_Static_assert(sizeof(ffi_monitor_state_t) == 16, "Monitor state must be 16 bytes");
+
+static inline ffi_monitor_state_t* mon_state(void* base, size_t offset) {
+    return (ffi_monitor_state_t*)((char*)base + offset);
+}
+
+/* Sleep on the lock word until we own it. Taking it as CONTENDED (not
+ * LOCKED) keeps others that may be asleep behind us from being forgotten.
+ * Returns 0 if the deadline passes first. */
+static int mon_lock_contended(ffi_monitor_state_t* m, int64_t deadline) {
+    while (atomic_exchange_explicit(&m->lock, FFI_MONITOR_CONTENDED,
+                                    memory_order_acquire) != FFI_MONITOR_UNLOCKED) {
+        int64_t left = ffi_park_slice(deadline);
+        if (left == 0) return 0;
+        ffi_futex_wait(&m->lock, FFI_MONITOR_CONTENDED, left);
+    }
+    return 1;
+}
+
+int zeroipc_raw_monitor_try_lock(void* base, size_t offset) {
+    ffi_monitor_state_t* m = mon_state(base, offset);
+    uint32_t expected = FFI_MONITOR_UNLOCKED;
+    return atomic_compare_exchange_strong_explicit(&m->lock, &expected, FFI_MONITOR_LOCKED,
+                                                   memory_order_acquire,
+                                                   memory_order_relaxed)
+        ? FFI_OK : FFI_EMPTY;
+}
+
+int zeroipc_raw_monitor_lock(void* base, size_t offset, int64_t timeout_ns) {
+    ffi_monitor_state_t* m = mon_state(base, offset);
+    if (zeroipc_raw_monitor_try_lock(base, offset) == FFI_OK) {
+        return FFI_OK;
+    }
+    int64_t deadline = ffi_deadline(timeout_ns);
+    for (int spin = 0; spin < FFI_MONITOR_SPIN_LIMIT; spin++) {
+        sched_yield();
+        if (zeroipc_raw_monitor_try_lock(base, offset) == FFI_OK) {
+            return FFI_OK;
+        }
+    }
+    return mon_lock_contended(m, deadline) ? FFI_OK : FFI_EMPTY;
+}
+
+void zeroipc_raw_monitor_unlock(void* base, size_t offset) {
+    ffi_monitor_state_t* m = mon_state(base, offset);
+    if (atomic_exchange_explicit(&m->lock, FFI_MONITOR_UNLOCKED,
+                                 memory_order_release) == FFI_MONITOR_CONTENDED) {
+        ffi_futex_wake(&m->lock, 1);
+    }
+}
+
+int zeroipc_raw_monitor_wait(void* base, size_t offset, int64_t timeout_ns) {
+    ffi_monitor_state_t* m = mon_state(base, offset);
+    /* Read the sequence before unlocking so a notify in between is seen */
+    uint32_t seen = atomic_load_explicit(&m->seq, memory_order_relaxed);
+    atomic_fetch_add_explicit(&m->waiters, 1, memory_order_seq_cst);
+    zeroipc_raw_monitor_unlock(base, offset);
+
+    int64_t deadline = ffi_deadline(timeout_ns);
+    while (atomic_load_explicit(&m->seq, memory_order_acquire) == seen) {
+        int64_t left = ffi_park_slice(deadline);
+        if (left == 0) break;
+        ffi_futex_wait(&m->seq, seen, left);
+    }
+    int notified = atomic_load_explicit(&m->seq, memory_order_acquire) != seen;
+
+    atomic_fetch_sub_explicit(&m->waiters, 1, memory_order_relaxed);
+    /* We may have been requeued behind other sleepers on the lock word */
+    mon_lock_contended(m, -1);
+    return notified ? FFI_OK : FFI_EMPTY;
+}
+
+void zeroipc_raw_monitor_notify_one(void* base, size_t offset) {
+    ffi_monitor_state_t* m = mon_state(base, offset);
+    atomic_fetch_add_explicit(&m->seq, 1, memory_order_seq_cst);
+    if (atomic_load_explicit(&m->waiters, memory_order_seq_cst) != 0) {
+        ffi_futex_wake(&m->seq, 1);
+    }
+}
+
+void zeroipc_raw_monitor_notify_all(void* base, size_t offset) {
+    ffi_monitor_state_t* m = mon_state(base, offset);
+    uint32_t seq = atomic_fetch_add_explicit(&m->seq, 1, memory_order_seq_cst) + 1;
+    if (atomic_load_explicit(&m->waiters, memory_order_seq_cst) == 0) {
+        return;
+    }
+
+    /* Requeued waiters sleep on the lock word, so unlock must know to wake
+     * them: mark the lock contended, if it is held at all */
+    uint32_t c = atomic_load_explicit(&m->lock, memory_order_relaxed);
+    while (c == FFI_MONITOR_LOCKED &&
+           !atomic_compare_exchange_weak_explicit(&m->lock, &c, FFI_MONITOR_CONTENDED,
+                                                  memory_order_relaxed,
+                                                  memory_order_relaxed)) {
+    }
+#ifdef __linux__
+    if (c == FFI_MONITOR_UNLOCKED ||
+        syscall(SYS_futex, (uint32_t*)&m->seq, FUTEX_CMP_REQUEUE, 1,
+                (void*)(uintptr_t)INT_MAX, (uint32_t*)&m->lock, seq) < 0) {
+        ffi_futex_wake(&m->seq, INT_MAX);
+        return;
+    }
+    /* The holder may have unlocked between marking and requeueing */
+    if (atomic_load_explicit(&m->lock, memory_order_seq_cst) == FFI_MONITOR_UNLOCKED) {
+        ffi_futex_wake(&m->lock, 1);
+    }
+#else
+    (void)seq;
+#endif
+}
+
+/* ============================================================================
+ * Table registration (lock-free), format v3
+ * Same protocol as table.c: CAS entry_count to reserve a slot, then
+ * PENDING -> CLAIMED -> PUBLISHED (or DEAD when a lower slot claimed the
+ * same name first); allocate_entry CASes next_offset only once claimed.
+ * ============================================================================ */
+
+#define FFI_NAME_SIZE 32
+#define FFI_MAX_ALLOC_ALIGN 4096
+#define FFI_CACHE_LINE 64
+
+static inline zipc_table_entry_t* t_entries(void* base) {
+    return (zipc_table_entry_t*)((char*)base + sizeof(zipc_table_header_t));
+}
+
+int zeroipc_raw_table_allocate(void* base, uint64_t size, uint64_t alignment,
+                               uint64_t* offset_out) {
+    zipc_table_header_t* h = (zipc_table_header_t*)base;
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0 ||
+        alignment > FFI_MAX_ALLOC_ALIGN) return FFI_INVALID;
+
+    uint64_t current = atomic_load_explicit(&h->next_offset, memory_order_relaxed);
+    uint64_t aligned;
+    do {
+        aligned = (current + alignment - 1) & ~(alignment - 1);
+        if (aligned > h->memory_size || size > h->memory_size - aligned)
+            return FFI_FULL;
+    } while (!atomic_compare_exchange_weak_explicit(
+                &h->next_offset, &current, aligned + size,
+                memory_order_acq_rel, memory_order_relaxed));
+
+    *offset_out = aligned;
+    return FFI_OK;
+}
+
+/* Reserve a slot and claim name in it; on FFI_OK *entry_out is CLAIMED and
+ * still needs its offset, size and alignment before publishing. A slot
+ * given up on while we stalled is dead, so we start over in a fresh one. */
+static int t_claim(void* base, uint32_t max_entries, const char* name,
+                   zipc_table_entry_t** entry_out) {
+    zipc_table_header_t* h = (zipc_table_header_t*)base;
+    zipc_table_entry_t* entries = t_entries(base);
+    zipc_table_entry_t* e;
+    uint32_t index;
+
+    for (;;) {
+        uint32_t count = atomic_load_explicit(&h->entry_count, memory_order_acquire);
+        if (count > max_entries) count = max_entries;
+        for (uint32_t i = 0; i < count; ++i) {
+            if (atomic_load_explicit(&entries[i].state, memory_order_acquire) ==
+                    ZIPC_ENTRY_PUBLISHED && strcmp(entries[i].name, name) == 0)
+                return FFI_EXISTS;
+        }
+
+        /* Reserve a slot */
+        index = atomic_load_explicit(&h->entry_count, memory_order_relaxed);
+        do {
+            if (index >= max_entries) return FFI_FULL;
+        } while (!atomic_compare_exchange_weak_explicit(
+                    &h->entry_count, &index, index + 1,
+                    memory_order_acq_rel, memory_order_relaxed));
+
+        e = &entries[index];
+        memset(e->name, 0, FFI_NAME_SIZE);
+        memcpy(e->name, name, strlen(name));
+        uint32_t pending = ZIPC_ENTRY_PENDING;
+        if (atomic_compare_exchange_strong_explicit(&e->state, &pending, ZIPC_ENTRY_CLAIMED,
+                                                    memory_order_acq_rel, memory_order_relaxed))
+            break;
+    }
+
+    /* Same-name race: the lowest claimed slot wins. Lower PENDING slots are
+     * waited on (bounded, a crashed registrar never leaves PENDING), then
+     * marked DEAD so a stalled registrar cannot publish later. */
+    for (uint32_t i = 0; i < index; ++i) {
+        uint32_t st = atomic_load_explicit(&entries[i].state, memory_order_acquire);
+        for (int spins = 0; st == ZIPC_ENTRY_PENDING && spins < FFI_MAX_SPINS; ++spins) {
+            sched_yield();
+            st = atomic_load_explicit(&entries[i].state, memory_order_acquire);
+        }
+        if (st == ZIPC_ENTRY_PENDING) {
+            atomic_compare_exchange_strong_explicit(&entries[i].state, &st, ZIPC_ENTRY_DEAD,
+                                                    memory_order_acq_rel, memory_order_acquire);
+        }
+        if ((st == ZIPC_ENTRY_CLAIMED || st == ZIPC_ENTRY_PUBLISHED) &&
+            strcmp(entries[i].name, name) == 0) {
+            atomic_store_explicit(&e->state, ZIPC_ENTRY_DEAD, memory_order_release);
+            return FFI_EXISTS;
+        }
+    }
+
+    *entry_out = e;
+    return FFI_OK;
+}
+
+int zeroipc_raw_table_add(void* base, uint32_t max_entries, const char* name,
+                          uint64_t offset, uint64_t size, uint32_t align) {
+    if (strlen(name) >= FFI_NAME_SIZE) return FFI_INVALID;
+    if ((align & (align - 1)) != 0 || align > FFI_MAX_ALLOC_ALIGN) return FFI_INVALID;
+
+    zipc_table_entry_t* e;
+    int rc = t_claim(base, max_entries, name, &e);
+    if (rc != FFI_OK) return rc;
+
+    e->offset = offset;
+    e->size = size;
+    e->alignment = align;
+    atomic_store_explicit(&e->state, ZIPC_ENTRY_PUBLISHED, memory_order_release);
+    return FFI_OK;
+}
+
+int zeroipc_raw_table_allocate_entry(void* base, uint32_t max_entries, const char* name,
+                                     uint64_t size, uint32_t align, uint64_t* offset_out) {
+    if (strlen(name) >= FFI_NAME_SIZE) return FFI_INVALID;
+    if (align == 0 || (align & (align - 1)) != 0 || align > FFI_MAX_ALLOC_ALIGN)
+        return FFI_INVALID;
+
+    zipc_table_entry_t* e;
+    int rc = t_claim(base, max_entries, name, &e);
+    if (rc != FFI_OK) return rc;
+
+    /* The name is ours; only now take space, base on its own cache line */
+    uint64_t offset;
+    uint64_t base_align = align > FFI_CACHE_LINE ? align : FFI_CACHE_LINE;
+    if (zeroipc_raw_table_allocate(base, size, base_align, &offset) != FFI_OK) {
+        atomic_store_explicit(&e->state, ZIPC_ENTRY_DEAD, memory_order_release);
+        return FFI_NOSPACE;
+    }
+
+    e->offset = offset;
+    e->size = size;
+    e->alignment = align;
+    atomic_store_explicit(&e->state, ZIPC_ENTRY_PUBLISHED, memory_order_release);
+    *offset_out = offset;
+    return FFI_OK;
+}
@@ -10,7 +10,7 @@
 #include <stdio.h>
 
 #define ZEROIPC_MAGIC 0x5A49504D  /* 'ZIPM' */
-#define ZEROIPC_VERSION 2  /* v2: 8-byte section alignment (see SPECIFICATION.md) */
+#define ZEROIPC_VERSION 3  /* v3: per-entry publish state (see SPECIFICATION.md) */
 #define MAX_NAME_SIZE 32
 #define DEFAULT_ENTRIES 64
 
@@ -34,8 +34,7 @@ static zipc_table_header_t* get_header(zeroipc_memory_t* mem) {
     return (zipc_table_header_t*)mem->base;
 }
 
-/* Get table entries - currently unused but kept for future use */
-__attribute__((unused))
+/* Get table entries */
 static zipc_table_entry_t* get_entries(zeroipc_memory_t* mem) {
     return (zipc_table_entry_t*)((char*)mem->base + sizeof(zipc_table_header_t));
 }
@@ -45,10 +44,13 @@ static void init_table(zeroipc_memory_t* mem) {
     zipc_table_header_t* header = get_header(mem);
     header->magic = ZEROIPC_MAGIC;
     header->version = ZEROIPC_VERSION;
-    header->entry_count = 0;
+    atomic_store_explicit(&header->entry_count, 0, memory_order_relaxed);
     header->max_entries = mem->max_entries;
     header->memory_size = mem->size;
-    header->next_offset = calculate_table_size(mem->max_entries);
+    /* Zero the entries: a reused segment may hold stale entry states */
+    memset(get_entries(mem), 0, sizeof(zipc_table_entry_t) * mem->max_entries);
+    atomic_store_explicit(&header->next_offset, calculate_table_size(mem->max_entries),
+                          memory_order_release);
 }
 
 /* Create or open shared memory */
@@ -6,19 +6,31 @@
 #include <stdint.h>
 
 /*
- * Queue binary layout (matches C++/Go/Python, format v2):
+ * Queue binary layout (matches C++/Go/Python):
  *   [head:u32][tail:u32][capacity:u32][elem_size:u32]  (16 bytes)
+ *   [pad to section alignment]  (none for the default 8)
  *   [data[0]][data[1]]...[data[cap-1]]
- *   [pad to 8-byte boundary]
+ *   [pad to section alignment]
  *   [seq[0]:u32][seq[1]:u32]...[seq[cap-1]:u32]
  *
+ * Interleaved layouts (flag bits in the high byte of elem_size) instead
+ * store slot i as [data[i]][pad to 4][seq[i]:u32][pad to slot alignment],
+ * the slots starting on the slot alignment: the section alignment, or at
+ * least a cache line for ZEROIPC_QUEUE_INTERLEAVED_PADDED.
+ *
+ * ZEROIPC_QUEUE_PADDED_HEADER (combinable with any of them) moves head to
+ * offset 64 and tail to offset 128, leaving the header's own head/tail at 0,
+ * and starts the slots after those two lines (offset 192).
+ *
  * Uses Vyukov bounded MPMC queue algorithm with per-slot sequence numbers.
- * The sequence array is placed on an 8-byte boundary so its atomics are
- * always naturally aligned regardless of element size.
+ * The sequence array is placed on the section alignment (at least 8) so its
+ * atomics are always naturally aligned regardless of element size.
  */
 
-/* Round n up to the next multiple of 8 (8-byte section alignment, format v2). */
-#define ZIPC_ALIGN8(n) (((n) + 7u) & ~(size_t)7u)
+/* Round n up to the next multiple of the section alignment a (a power of two).
+ * Created structures use ZEROIPC_MIN_SECTION_ALIGN; opened ones use the
+ * alignment recorded in their table entry. */
+#define ZIPC_ALIGN_UP(n, a) (((n) + (a) - 1) & ~((size_t)(a) - 1))
 
 /* Queue header in shared memory — matches C++ Queue::Header */
 typedef struct {
@@ -32,15 +44,88 @@ typedef struct {
 struct zeroipc_queue {
     zeroipc_memory_t* memory;
     queue_header_t* header;
-    void* data;                  /* pointer to data array */
-    _Atomic uint32_t* seq;       /* pointer to sequence array */
+    _Atomic uint32_t* head;      /* in the header, or on its own line */
+    _Atomic uint32_t* tail;
+    char* data;                  /* slot 0's element */
+    char* seq;                   /* slot 0's sequence number */
+    size_t elem_size;            /* elem_size without the layout flags */
+    size_t data_stride;
+    size_t seq_stride;
     char name[32];
 };
 
+/* Slot geometry for a layout: sets the strides and the data/seq offsets
+ * from the header, and returns the end of the last slot */
+static size_t queue_geometry(zeroipc_queue_t* queue, uint32_t layout,
+                             size_t capacity, size_t align,
+                             size_t* data_off_out, size_t* seq_off_out) {
+    size_t data_off, seq_off, end;
+    size_t header_size = (layout & ZEROIPC_QUEUE_PADDED_HEADER)
+        ? ZEROIPC_QUEUE_PADDED_HEADER_SIZE : sizeof(queue_header_t);
+    if (!(layout & ZEROIPC_QUEUE_INTERLEAVED)) {
+        data_off = ZIPC_ALIGN_UP(header_size, align);
+        seq_off = data_off + ZIPC_ALIGN_UP(queue->elem_size * capacity, align);
+        queue->data_stride = queue->elem_size;
+        queue->seq_stride = sizeof(uint32_t);
+        end = seq_off + sizeof(uint32_t) * capacity;
+    } else {
+        size_t slot_align = align;
+        if ((layout & ZEROIPC_QUEUE_LAYOUT_PADDED) && slot_align < ZEROIPC_CACHE_LINE_SIZE) {
+            slot_align = ZEROIPC_CACHE_LINE_SIZE;
+        }
+        size_t seq_in_slot = ZIPC_ALIGN_UP(queue->elem_size, sizeof(uint32_t));
+        size_t stride = ZIPC_ALIGN_UP(seq_in_slot + sizeof(uint32_t), slot_align);
+        data_off = ZIPC_ALIGN_UP(header_size, slot_align);
+        seq_off = data_off + seq_in_slot;
+        queue->data_stride = stride;
+        queue->seq_stride = stride;
+        end = data_off + stride * capacity;
+    }
+    *data_off_out = data_off;
+    *seq_off_out = seq_off;
+    return end;
+}
+
+/* Known layouts: the slot layout, optionally with the padded header */
+static int queue_layout_valid(uint32_t layout) {
+    layout &= ~ZEROIPC_QUEUE_PADDED_HEADER;
+    return layout == ZEROIPC_QUEUE_SPLIT || layout == ZEROIPC_QUEUE_INTERLEAVED ||
+           layout == ZEROIPC_QUEUE_INTERLEAVED_PADDED;
+}
+
+static void queue_bind(zeroipc_queue_t* queue, uint32_t layout,
+                       size_t data_off, size_t seq_off) {
+    if (layout & ZEROIPC_QUEUE_PADDED_HEADER) {
+        queue->head = (_Atomic uint32_t*)((char*)queue->header + ZEROIPC_QUEUE_PADDED_HEAD_OFFSET);
+        queue->tail = (_Atomic uint32_t*)((char*)queue->header + ZEROIPC_QUEUE_PADDED_TAIL_OFFSET);
+    } else {
+        queue->head = &queue->header->head;
+        queue->tail = &queue->header->tail;
+    }
+    queue->data = (char*)queue->header + data_off;
+    queue->seq = (char*)queue->header + seq_off;
+}
+
+static inline _Atomic uint32_t* queue_seq(zeroipc_queue_t* queue, uint32_t slot) {
+    return (_Atomic uint32_t*)(queue->seq + slot * queue->seq_stride);
+}
+
 /* Create queue */
 zeroipc_queue_t* zeroipc_queue_create(zeroipc_memory_t* mem, const char* name,
                                        size_t elem_size, size_t capacity) {
-    if (!mem || !name || elem_size == 0 || capacity == 0) {
+    return zeroipc_queue_create_layout(mem, name, elem_size, capacity,
+                                       ZEROIPC_QUEUE_SPLIT);
+}
+
+/* Create queue with an explicit slot layout */
+zeroipc_queue_t* zeroipc_queue_create_layout(zeroipc_memory_t* mem, const char* name,
+                                              size_t elem_size, size_t capacity,
+                                              uint32_t layout) {
+    if (!mem || !name || elem_size == 0 || capacity == 0 ||
+        elem_size > ZEROIPC_QUEUE_ELEM_SIZE_MASK) {
+        return NULL;
+    }
+    if (!queue_layout_valid(layout)) {
         return NULL;
     }
 
@@ -48,6 +133,7 @@ zeroipc_queue_t* zeroipc_queue_create(zeroipc_memory_t* mem, const char* name,
     if (!queue) return NULL;
 
     queue->memory = mem;
+    queue->elem_size = elem_size;
     strncpy(queue->name, name, sizeof(queue->name) - 1);
 
     /* The Vyukov slot mapping (counter % capacity on monotonically
@@ -58,14 +144,15 @@ zeroipc_queue_t* zeroipc_queue_create(zeroipc_memory_t* mem, const char* name,
     while (cap_p2 < capacity) cap_p2 <<= 1;
     capacity = cap_p2;
 
-    /* Layout: [header(16)][data: elem_size*capacity][pad][seq: uint32*capacity] */
-    size_t seq_array_size = sizeof(uint32_t) * capacity;
-    if (capacity > (SIZE_MAX - sizeof(queue_header_t) - seq_array_size) / elem_size) {
+    /* A slot is at most elem_size + 4 plus two cache lines of padding */
+    size_t max_slot = elem_size + sizeof(uint32_t) + 2 * ZEROIPC_CACHE_LINE_SIZE;
+    if (capacity > (SIZE_MAX - ZEROIPC_QUEUE_PADDED_HEADER_SIZE - 2 * ZEROIPC_CACHE_LINE_SIZE) / max_slot) {
         free(queue);
         return NULL;
     }
-    size_t seq_off = ZIPC_ALIGN8(elem_size * capacity);
-    size_t total_size = sizeof(queue_header_t) + seq_off + seq_array_size;
+    size_t data_off, seq_off;
+    size_t total_size = queue_geometry(queue, layout, capacity, ZEROIPC_MIN_SECTION_ALIGN,
+                                       &data_off, &seq_off);
 
     size_t offset;
     int result = zeroipc_table_add(mem, name, total_size, &offset);
@@ -75,18 +162,19 @@ zeroipc_queue_t* zeroipc_queue_create(zeroipc_memory_t* mem, const char* name,
     }
 
     queue->header = (queue_header_t*)((char*)zeroipc_memory_base(mem) + offset);
-    queue->data = (char*)queue->header + sizeof(queue_header_t);
-    queue->seq = (_Atomic uint32_t*)((char*)queue->data + seq_off);
+    queue_bind(queue, layout, data_off, seq_off);
 
     /* Initialize header */
     atomic_store(&queue->header->head, 0);
     atomic_store(&queue->header->tail, 0);
+    atomic_store(queue->head, 0);
+    atomic_store(queue->tail, 0);
     queue->header->capacity = capacity;
-    queue->header->elem_size = elem_size;
+    queue->header->elem_size = (uint32_t)elem_size | layout;
 
     /* Initialize per-slot sequence numbers: seq[i] = i */
     for (uint32_t i = 0; i < capacity; ++i) {
-        atomic_store_explicit(&queue->seq[i], i, memory_order_relaxed);
+        atomic_store_explicit(queue_seq(queue, i), i, memory_order_relaxed);
     }
 
     return queue;
@@ -96,8 +184,8 @@ zeroipc_queue_t* zeroipc_queue_create(zeroipc_memory_t* mem, const char* name,
 zeroipc_queue_t* zeroipc_queue_open(zeroipc_memory_t* mem, const char* name) {
     if (!mem || !name) return NULL;
 
-    size_t offset, size;
-    int result = zeroipc_table_find(mem, name, &offset, &size);
+    size_t offset, size, align;
+    int result = zeroipc_table_find_aligned(mem, name, &offset, &size, &align);
     if (result != ZEROIPC_OK) return NULL;
 
     zeroipc_queue_t* queue = calloc(1, sizeof(zeroipc_queue_t));
@@ -107,7 +195,13 @@ zeroipc_queue_t* zeroipc_queue_open(zeroipc_memory_t* mem, const char* name) {
     strncpy(queue->name, name, sizeof(queue->name) - 1);
 
     queue->header = (queue_header_t*)((char*)zeroipc_memory_base(mem) + offset);
-    if (queue->header->capacity == 0 || queue->header->elem_size == 0) {
+    uint32_t layout = queue->header->elem_size & ~ZEROIPC_QUEUE_ELEM_SIZE_MASK;
+    queue->elem_size = queue->header->elem_size & ZEROIPC_QUEUE_ELEM_SIZE_MASK;
+    if (queue->header->capacity == 0 || queue->elem_size == 0) {
+        free(queue);
+        return NULL;
+    }
+    if (!queue_layout_valid(layout)) {
         free(queue);
         return NULL;
     }
@@ -118,9 +212,13 @@ zeroipc_queue_t* zeroipc_queue_open(zeroipc_memory_t* mem, const char* name) {
         return NULL;
     }
 
-    queue->data = (char*)queue->header + sizeof(queue_header_t);
-    queue->seq = (_Atomic uint32_t*)((char*)queue->data + ZIPC_ALIGN8(
-        (size_t)queue->header->elem_size * queue->header->capacity));
+    size_t data_off, seq_off;
+    if (queue_geometry(queue, layout, queue->header->capacity, align,
+                       &data_off, &seq_off) > size) {
+        free(queue);
+        return NULL;
+    }
+    queue_bind(queue, layout, data_off, seq_off);
 
     return queue;
 }
@@ -136,18 +234,17 @@ int zeroipc_queue_push(zeroipc_queue_t* queue, const void* value) {
     uint32_t cap = queue->header->capacity;
 
     for (;;) {
-        uint32_t tail = atomic_load_explicit(&queue->header->tail, memory_order_relaxed);
+        uint32_t tail = atomic_load_explicit(queue->tail, memory_order_relaxed);
         uint32_t slot = tail % cap;
-        uint32_t s = atomic_load_explicit(&queue->seq[slot], memory_order_acquire);
+        uint32_t s = atomic_load_explicit(queue_seq(queue, slot), memory_order_acquire);
         int32_t diff = (int32_t)s - (int32_t)tail;
 
         if (diff == 0) {
             if (atomic_compare_exchange_weak_explicit(
-                    &queue->header->tail, &tail, tail + 1,
+                    queue->tail, &tail, tail + 1,
                     memory_order_relaxed, memory_order_relaxed)) {
-                void* dest = (char*)queue->data + slot * queue->header->elem_size;
-                memcpy(dest, value, queue->header->elem_size);
-                atomic_store_explicit(&queue->seq[slot], tail + 1, memory_order_release);
+                memcpy(queue->data + slot * queue->data_stride, value, queue->elem_size);
+                atomic_store_explicit(queue_seq(queue, slot), tail + 1, memory_order_release);
                 return ZEROIPC_OK;
             }
         } else if (diff < 0) {
@@ -163,18 +260,17 @@ int zeroipc_queue_pop(zeroipc_queue_t* queue, void* value) {
     uint32_t cap = queue->header->capacity;
 
     for (;;) {
-        uint32_t head = atomic_load_explicit(&queue->header->head, memory_order_relaxed);
+        uint32_t head = atomic_load_explicit(queue->head, memory_order_relaxed);
         uint32_t slot = head % cap;
-        uint32_t s = atomic_load_explicit(&queue->seq[slot], memory_order_acquire);
+        uint32_t s = atomic_load_explicit(queue_seq(queue, slot), memory_order_acquire);
         int32_t diff = (int32_t)s - (int32_t)(head + 1);
 
         if (diff == 0) {
             if (atomic_compare_exchange_weak_explicit(
-                    &queue->header->head, &head, head + 1,
+                    queue->head, &head, head + 1,
                     memory_order_relaxed, memory_order_relaxed)) {
-                void* src = (char*)queue->data + slot * queue->header->elem_size;
-                memcpy(value, src, queue->header->elem_size);
-                atomic_store_explicit(&queue->seq[slot], head + cap, memory_order_release);
+                memcpy(value, queue->data + slot * queue->data_stride, queue->elem_size);
+                atomic_store_explicit(queue_seq(queue, slot), head + cap, memory_order_release);
                 return ZEROIPC_OK;
             }
         } else if (diff < 0) {
@@ -185,22 +281,22 @@ int zeroipc_queue_pop(zeroipc_queue_t* queue, void* value) {
 
 int zeroipc_queue_empty(zeroipc_queue_t* queue) {
     if (!queue) return 1;
-    uint32_t head = atomic_load_explicit(&queue->header->head, memory_order_acquire);
-    uint32_t tail = atomic_load_explicit(&queue->header->tail, memory_order_acquire);
+    uint32_t head = atomic_load_explicit(queue->head, memory_order_acquire);
+    uint32_t tail = atomic_load_explicit(queue->tail, memory_order_acquire);
     return head == tail;
 }
 
 int zeroipc_queue_full(zeroipc_queue_t* queue) {
     if (!queue) return 1;
-    uint32_t head = atomic_load_explicit(&queue->header->head, memory_order_acquire);
-    uint32_t tail = atomic_load_explicit(&queue->header->tail, memory_order_acquire);
+    uint32_t head = atomic_load_explicit(queue->head, memory_order_acquire);
+    uint32_t tail = atomic_load_explicit(queue->tail, memory_order_acquire);
     return (tail - head) >= queue->header->capacity;
 }
 
 size_t zeroipc_queue_size(zeroipc_queue_t* queue) {
     if (!queue) return 0;
-    uint32_t head = atomic_load_explicit(&queue->header->head, memory_order_acquire);
-    uint32_t tail = atomic_load_explicit(&queue->header->tail, memory_order_acquire);
+    uint32_t head = atomic_load_explicit(queue->head, memory_order_acquire);
+    uint32_t tail = atomic_load_explicit(queue->tail, memory_order_acquire);
     /* uint32_t subtraction handles wraparound correctly */
     return (size_t)(tail - head);
 }
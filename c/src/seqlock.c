@@ -0,0 +1,172 @@
+#define _GNU_SOURCE
+#include "zeroipc.h"
+#include "zeroipc_seqlock.h"
+#include <limits.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/* SeqLock header in shared memory - matches SPECIFICATION.md */
+typedef struct {
+    _Atomic uint64_t seq;  /* Even: stable, odd: write in progress */
+    uint32_t elem_size;
+    _Atomic uint32_t waiters;  /* Threads parked on the low half of seq */
+} seqlock_header_t;
+
+#define SEQLOCK_SPIN_ATTEMPTS 64
+#define SEQLOCK_READ_ATTEMPTS (1 << 20)
+
+/* SeqLock structure */
+struct zeroipc_seqlock {
+    zeroipc_memory_t* memory;
+    seqlock_header_t* header;
+    unsigned char* value;
+    size_t elem_size;
+    char name[32];
+};
+
+/* The value starts on the section alignment (8 unless the creator asked
+ * for more) */
+static size_t seqlock_value_offset(size_t align) {
+    size_t a = align < ZEROIPC_MIN_SECTION_ALIGN ? ZEROIPC_MIN_SECTION_ALIGN : align;
+    return (sizeof(seqlock_header_t) + a - 1) & ~(a - 1);
+}
+
+static zeroipc_seqlock_t* seqlock_handle(zeroipc_memory_t* mem, const char* name,
+                                         size_t offset, size_t align, size_t elem_size) {
+    zeroipc_seqlock_t* lock = calloc(1, sizeof(zeroipc_seqlock_t));
+    if (!lock) {
+        return NULL;
+    }
+    lock->memory = mem;
+    lock->header = (seqlock_header_t*)((char*)zeroipc_memory_base(mem) + offset);
+    lock->value = (unsigned char*)lock->header + seqlock_value_offset(align);
+    lock->elem_size = elem_size;
+    strncpy(lock->name, name, sizeof(lock->name) - 1);
+    return lock;
+}
+
+/* Create seqlock */
+zeroipc_seqlock_t* zeroipc_seqlock_create(zeroipc_memory_t* mem, const char* name,
+                                          size_t elem_size, const void* initial) {
+    if (!mem || !name || elem_size == 0 || elem_size > UINT32_MAX) {
+        return NULL;
+    }
+
+    size_t offset;
+    size_t total = seqlock_value_offset(ZEROIPC_MIN_SECTION_ALIGN) + elem_size;
+    if (zeroipc_table_add(mem, name, total, &offset) != ZEROIPC_OK) {
+        return NULL;
+    }
+
+    zeroipc_seqlock_t* lock = seqlock_handle(mem, name, offset,
+                                             ZEROIPC_MIN_SECTION_ALIGN, elem_size);
+    if (!lock) {
+        return NULL;
+    }
+
+    atomic_store_explicit(&lock->header->seq, 0, memory_order_relaxed);
+    lock->header->elem_size = (uint32_t)elem_size;
+    atomic_store_explicit(&lock->header->waiters, 0, memory_order_relaxed);
+    if (initial) {
+        memcpy(lock->value, initial, elem_size);
+    } else {
+        memset(lock->value, 0, elem_size);
+    }
+    return lock;
+}
+
+/* Open existing seqlock */
+zeroipc_seqlock_t* zeroipc_seqlock_open(zeroipc_memory_t* mem, const char* name,
+                                        size_t elem_size) {
+    if (!mem || !name || elem_size == 0) {
+        return NULL;
+    }
+
+    size_t offset, size, align;
+    if (zeroipc_table_find_aligned(mem, name, &offset, &size, &align) != ZEROIPC_OK) {
+        return NULL;
+    }
+
+    seqlock_header_t* header =
+        (seqlock_header_t*)((char*)zeroipc_memory_base(mem) + offset);
+    if (header->elem_size != elem_size ||
+        size < seqlock_value_offset(align) + elem_size) {
+        return NULL;
+    }
+
+    return seqlock_handle(mem, name, offset, align, elem_size);
+}
+
+/* Close seqlock */
+void zeroipc_seqlock_close(zeroipc_seqlock_t* lock) {
+    if (lock) {
+        free(lock);
+    }
+}
+
+/* Optimistic read */
+int zeroipc_seqlock_read(zeroipc_seqlock_t* lock, void* out) {
+    if (!lock || !out) {
+        return ZEROIPC_ERROR_SIZE;
+    }
+
+    for (int attempt = 0; attempt < SEQLOCK_READ_ATTEMPTS; attempt++) {
+        uint64_t before = atomic_load_explicit(&lock->header->seq, memory_order_acquire);
+        if ((before & 1) == 0) {
+            memcpy(out, lock->value, lock->elem_size);
+            atomic_thread_fence(memory_order_acquire);
+            if (atomic_load_explicit(&lock->header->seq, memory_order_relaxed) == before) {
+                return ZEROIPC_OK;
+            }
+        }
+        if (attempt >= SEQLOCK_SPIN_ATTEMPTS) {
+            sched_yield();
+        }
+    }
+    return ZEROIPC_ERROR_TIMEOUT;
+}
+
+/* Write: claim an odd sequence, copy, make it even again */
+void zeroipc_seqlock_write(zeroipc_seqlock_t* lock, const void* value) {
+    if (!lock || !value) {
+        return;
+    }
+
+    for (int spins = 0;; spins++) {
+        uint64_t seq = atomic_load_explicit(&lock->header->seq, memory_order_relaxed);
+        if ((seq & 1) == 0 &&
+            atomic_compare_exchange_weak_explicit(&lock->header->seq, &seq, seq + 1,
+                                                  memory_order_acquire,
+                                                  memory_order_relaxed)) {
+            break;
+        }
+        if (spins >= SEQLOCK_SPIN_ATTEMPTS) {
+            sched_yield();
+        }
+    }
+    atomic_thread_fence(memory_order_release);
+    memcpy(lock->value, value, lock->elem_size);
+    atomic_fetch_add_explicit(&lock->header->seq, 1, memory_order_seq_cst);
+
+    /* Wake waiters parked in wait_for_change (C++, FFI) */
+#ifdef __linux__
+    if (atomic_load_explicit(&lock->header->waiters, memory_order_seq_cst) != 0) {
+        syscall(SYS_futex, (uint32_t*)&lock->header->seq, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+    }
+#endif
+}
+
+/* Sequence number */
+uint64_t zeroipc_seqlock_sequence(zeroipc_seqlock_t* lock) {
+    if (!lock) {
+        return 0;
+    }
+    return atomic_load_explicit(&lock->header->seq, memory_order_acquire);
+}
@@ -8,20 +8,26 @@
 #include <stdint.h>
 
 /*
- * Stack binary layout (matches C++/Go/Python, format v2):
+ * Stack binary layout (matches C++/Go/Python):
  *   [top:i32][capacity:u32][elem_size:u32][reserved:u32]  (16 bytes)
+ *   [pad to section alignment]  (none for the default 8)
  *   [data[0]][data[1]]...[data[cap-1]]
- *   [pad to 8-byte boundary]
+ *   [pad to section alignment]
  *   [state[0]:u32][state[1]:u32]...[state[cap-1]:u32]
  *
  * top is signed int32: -1 = empty, otherwise index of top element.
+ * ZEROIPC_STACK_PADDED_TOP (flag bit in the high byte of elem_size) moves
+ * top to offset 64, leaving the header's own top at -1, and starts the data
+ * after a 128-byte header.
  * Per-slot 4-state CAS protocol: EMPTY(0) -> WRITING(1) -> READY(2) -> READING(3) -> EMPTY(0)
- * The 16-byte header makes the data array 8-aligned; the state array is placed
- * on the next 8-byte boundary so its atomics are always naturally aligned.
+ * The data and state arrays start on the section alignment recorded in the
+ * table entry (at least 8), so the state atomics are always naturally aligned.
  */
 
-/* Round n up to the next multiple of 8 (8-byte section alignment, format v2). */
-#define ZIPC_ALIGN8(n) (((n) + 7u) & ~(size_t)7u)
+/* Round n up to the next multiple of the section alignment a (a power of two).
+ * Created structures use ZEROIPC_MIN_SECTION_ALIGN; opened ones use the
+ * alignment recorded in their table entry. */
+#define ZIPC_ALIGN_UP(n, a) (((n) + (a) - 1) & ~((size_t)(a) - 1))
 
 /* Per-slot states */
 #define SLOT_EMPTY   0
@@ -46,15 +52,45 @@ typedef struct {
 struct zeroipc_stack {
     zeroipc_memory_t* memory;
     stack_header_t* header;
+    _Atomic int32_t* top;        /* in the header, or on its own line */
+    size_t elem_size;            /* elem_size without the layout flags */
     void* data;                  /* pointer to data array */
     _Atomic uint32_t* state;     /* pointer to per-slot state array */
     char name[32];
 };
 
+static size_t stack_header_size(uint32_t layout) {
+    return (layout & ZEROIPC_STACK_PADDED_TOP)
+        ? ZEROIPC_STACK_PADDED_HEADER_SIZE : sizeof(stack_header_t);
+}
+
+static void stack_bind(zeroipc_stack_t* stack, uint32_t layout, size_t align) {
+    if (layout & ZEROIPC_STACK_PADDED_TOP) {
+        stack->top = (_Atomic int32_t*)((char*)stack->header + ZEROIPC_STACK_PADDED_TOP_OFFSET);
+    } else {
+        stack->top = &stack->header->top;
+    }
+    stack->data = (char*)stack->header + ZIPC_ALIGN_UP(stack_header_size(layout), align);
+    stack->state = (_Atomic uint32_t*)((char*)stack->data + ZIPC_ALIGN_UP(
+        stack->elem_size * stack->header->capacity, align));
+}
+
 /* Create stack */
 zeroipc_stack_t* zeroipc_stack_create(zeroipc_memory_t* mem, const char* name,
                                        size_t elem_size, size_t capacity) {
-    if (!mem || !name || elem_size == 0 || capacity == 0) {
+    return zeroipc_stack_create_layout(mem, name, elem_size, capacity,
+                                       ZEROIPC_STACK_COMPACT);
+}
+
+/* Create stack with an explicit header layout */
+zeroipc_stack_t* zeroipc_stack_create_layout(zeroipc_memory_t* mem, const char* name,
+                                              size_t elem_size, size_t capacity,
+                                              uint32_t layout) {
+    if (!mem || !name || elem_size == 0 || capacity == 0 ||
+        elem_size > ZEROIPC_STACK_ELEM_SIZE_MASK) {
+        return NULL;
+    }
+    if (layout & ~ZEROIPC_STACK_PADDED_TOP) {
         return NULL;
     }
 
@@ -62,16 +98,18 @@ zeroipc_stack_t* zeroipc_stack_create(zeroipc_memory_t* mem, const char* name,
     if (!stack) return NULL;
 
     stack->memory = mem;
+    stack->elem_size = elem_size;
     strncpy(stack->name, name, sizeof(stack->name) - 1);
 
-    /* Layout: [header(16)][data: elem_size*capacity][pad][state: uint32*capacity] */
+    /* Layout: [header][data: elem_size*capacity][pad][state: uint32*capacity] */
+    size_t data_off = ZIPC_ALIGN_UP(stack_header_size(layout), ZEROIPC_MIN_SECTION_ALIGN);
     size_t state_array_size = sizeof(uint32_t) * capacity;
-    if (capacity > (SIZE_MAX - sizeof(stack_header_t) - state_array_size) / elem_size) {
+    if (capacity > (SIZE_MAX - ZEROIPC_STACK_PADDED_HEADER_SIZE - state_array_size) / elem_size) {
         free(stack);
         return NULL;
     }
-    size_t state_off = ZIPC_ALIGN8(elem_size * capacity);
-    size_t total_size = sizeof(stack_header_t) + state_off + state_array_size;
+    size_t state_off = ZIPC_ALIGN_UP(elem_size * capacity, ZEROIPC_MIN_SECTION_ALIGN);
+    size_t total_size = data_off + state_off + state_array_size;
 
     size_t offset;
     int result = zeroipc_table_add(mem, name, total_size, &offset);
@@ -81,13 +119,13 @@ zeroipc_stack_t* zeroipc_stack_create(zeroipc_memory_t* mem, const char* name,
     }
 
     stack->header = (stack_header_t*)((char*)zeroipc_memory_base(mem) + offset);
-    stack->data = (char*)stack->header + sizeof(stack_header_t);
-    stack->state = (_Atomic uint32_t*)((char*)stack->data + state_off);
+    stack->header->capacity = capacity;
+    stack_bind(stack, layout, ZEROIPC_MIN_SECTION_ALIGN);
 
     /* Initialize header (top = -1 means empty) */
     atomic_store(&stack->header->top, -1);
-    stack->header->capacity = capacity;
-    stack->header->elem_size = elem_size;
+    atomic_store(stack->top, -1);
+    stack->header->elem_size = (uint32_t)elem_size | layout;
     stack->header->reserved = 0;
 
     /* Initialize per-slot states to EMPTY */
@@ -102,8 +140,8 @@ zeroipc_stack_t* zeroipc_stack_create(zeroipc_memory_t* mem, const char* name,
 zeroipc_stack_t* zeroipc_stack_open(zeroipc_memory_t* mem, const char* name) {
     if (!mem || !name) return NULL;
 
-    size_t offset, size;
-    int result = zeroipc_table_find(mem, name, &offset, &size);
+    size_t offset, size, align;
+    int result = zeroipc_table_find_aligned(mem, name, &offset, &size, &align);
     if (result != ZEROIPC_OK) return NULL;
 
     zeroipc_stack_t* stack = calloc(1, sizeof(zeroipc_stack_t));
@@ -113,14 +151,15 @@ zeroipc_stack_t* zeroipc_stack_open(zeroipc_memory_t* mem, const char* name) {
     strncpy(stack->name, name, sizeof(stack->name) - 1);
 
     stack->header = (stack_header_t*)((char*)zeroipc_memory_base(mem) + offset);
-    if (stack->header->capacity == 0 || stack->header->elem_size == 0) {
+    uint32_t layout = stack->header->elem_size & ~ZEROIPC_STACK_ELEM_SIZE_MASK;
+    stack->elem_size = stack->header->elem_size & ZEROIPC_STACK_ELEM_SIZE_MASK;
+    if (stack->header->capacity == 0 || stack->elem_size == 0 ||
+        (layout & ~ZEROIPC_STACK_PADDED_TOP)) {
         free(stack);
         return NULL;
     }
 
-    stack->data = (char*)stack->header + sizeof(stack_header_t);
-    stack->state = (_Atomic uint32_t*)((char*)stack->data + ZIPC_ALIGN8(
-        (size_t)stack->header->elem_size * stack->header->capacity));
+    stack_bind(stack, layout, align);
 
     return stack;
 }
@@ -137,13 +176,13 @@ int zeroipc_stack_push(zeroipc_stack_t* stack, const void* value) {
 
     /* Step 1: Reserve slot by CAS-advancing top */
     do {
-        current_top = atomic_load_explicit(&stack->header->top, memory_order_relaxed);
+        current_top = atomic_load_explicit(stack->top, memory_order_relaxed);
         if (current_top >= (int32_t)(stack->header->capacity - 1)) {
             return ZEROIPC_ERROR_SIZE;  /* full */
         }
         new_top = current_top + 1;
     } while (!atomic_compare_exchange_weak_explicit(
-                &stack->header->top, &current_top, new_top,
+                stack->top, &current_top, new_top,
                 memory_order_acq_rel, memory_order_relaxed));
 
     /* Step 2: CAS slot EMPTY -> WRITING. Bounded spin: a crashed peer can
@@ -165,14 +204,14 @@ int zeroipc_stack_push(zeroipc_stack_t* stack, const void* value) {
          * built on top of ours the CAS fails and the slot stays orphaned. */
         int32_t reserved = new_top;
         atomic_compare_exchange_strong_explicit(
-            &stack->header->top, &reserved, current_top,
+            stack->top, &reserved, current_top,
             memory_order_acq_rel, memory_order_relaxed);
         return ZEROIPC_ERROR_TIMEOUT;
     }
 
     /* Step 3: Write data */
-    void* slot = (char*)stack->data + new_top * stack->header->elem_size;
-    memcpy(slot, value, stack->header->elem_size);
+    void* slot = (char*)stack->data + new_top * stack->elem_size;
+    memcpy(slot, value, stack->elem_size);
 
     /* Step 4: WRITING -> READY */
     atomic_store_explicit(&stack->state[new_top], SLOT_READY, memory_order_release);
@@ -188,13 +227,13 @@ int zeroipc_stack_pop(zeroipc_stack_t* stack, void* value) {
 
     /* Step 1: Reserve slot by CAS-decrementing top */
     do {
-        current_top = atomic_load_explicit(&stack->header->top, memory_order_relaxed);
+        current_top = atomic_load_explicit(stack->top, memory_order_relaxed);
         if (current_top < 0) {
             return ZEROIPC_ERROR_NOT_FOUND;  /* empty */
         }
         new_top = current_top - 1;
     } while (!atomic_compare_exchange_weak_explicit(
-                &stack->header->top, &current_top, new_top,
+                stack->top, &current_top, new_top,
                 memory_order_acq_rel, memory_order_relaxed));
 
     /* Step 2: CAS slot READY -> READING. Bounded spin: normally this only
@@ -217,14 +256,14 @@ int zeroipc_stack_pop(zeroipc_stack_t* stack, void* value) {
          * silently dropped. */
         int32_t reserved = new_top;
         atomic_compare_exchange_strong_explicit(
-            &stack->header->top, &reserved, current_top,
+            stack->top, &reserved, current_top,
             memory_order_acq_rel, memory_order_relaxed);
         return ZEROIPC_ERROR_TIMEOUT;
     }
 
     /* Step 3: Read data */
-    void* slot = (char*)stack->data + current_top * stack->header->elem_size;
-    memcpy(value, slot, stack->header->elem_size);
+    void* slot = (char*)stack->data + current_top * stack->elem_size;
+    memcpy(value, slot, stack->elem_size);
 
     /* Step 4: READING -> EMPTY */
     atomic_store_explicit(&stack->state[current_top], SLOT_EMPTY, memory_order_release);
@@ -247,15 +286,15 @@ int zeroipc_stack_top(zeroipc_stack_t* stack, void* value) {
      * the same state machine pop uses (READY -> READING), copy, then restore
      * it to READY. The bounded spin preserves crash-safety. */
     for (int spins = 0; spins < ZIPC_MAX_SPINS; ++spins) {
-        int32_t top = atomic_load_explicit(&stack->header->top, memory_order_acquire);
+        int32_t top = atomic_load_explicit(stack->top, memory_order_acquire);
         if (top < 0) return ZEROIPC_ERROR_NOT_FOUND;
 
         uint32_t expected = SLOT_READY;
         if (atomic_compare_exchange_strong_explicit(
                 &stack->state[top], &expected, SLOT_READING,
                 memory_order_acq_rel, memory_order_relaxed)) {
-            void* slot = (char*)stack->data + top * stack->header->elem_size;
-            memcpy(value, slot, stack->header->elem_size);
+            void* slot = (char*)stack->data + top * stack->elem_size;
+            memcpy(value, slot, stack->elem_size);
             atomic_store_explicit(&stack->state[top], SLOT_READY, memory_order_release);
             return ZEROIPC_OK;
         }
@@ -266,18 +305,18 @@ int zeroipc_stack_top(zeroipc_stack_t* stack, void* value) {
 
 int zeroipc_stack_empty(zeroipc_stack_t* stack) {
     if (!stack) return 1;
-    return atomic_load_explicit(&stack->header->top, memory_order_acquire) < 0;
+    return atomic_load_explicit(stack->top, memory_order_acquire) < 0;
 }
 
 int zeroipc_stack_full(zeroipc_stack_t* stack) {
     if (!stack) return 1;
-    return atomic_load_explicit(&stack->header->top, memory_order_acquire)
+    return atomic_load_explicit(stack->top, memory_order_acquire)
            >= (int32_t)(stack->header->capacity - 1);
 }
 
 size_t zeroipc_stack_size(zeroipc_stack_t* stack) {
     if (!stack) return 0;
-    int32_t top = atomic_load_explicit(&stack->header->top, memory_order_acquire);
+    int32_t top = atomic_load_explicit(stack->top, memory_order_acquire);
     return top < 0 ? 0 : (size_t)(top + 1);
 }
 
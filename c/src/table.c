@@ -1,5 +1,6 @@
 #include "zeroipc.h"
 #include "table_layout.h"
+#include <sched.h>
 #include <string.h>
 #include <stddef.h>
 
@@ -11,6 +12,12 @@ static size_t align_up(size_t value, size_t alignment) {
 
 #define MAX_NAME_SIZE 32
 
+/* Bound on waiting for a lower slot to leave PENDING. A registrar that
+ * crashed between reserving and claiming its slot leaves it PENDING forever;
+ * after this many spins the slot is marked DEAD, so a registrar that was only
+ * stalled fails its claim instead of publishing the name a second time. */
+#define MAX_SPINS 10000
+
 /* Internal: Get header */
 static zipc_table_header_t* get_header(zeroipc_memory_t* mem) {
     return (zipc_table_header_t*)zeroipc_memory_base(mem);
@@ -22,110 +29,221 @@ static zipc_table_entry_t* get_entries(zeroipc_memory_t* mem) {
     return (zipc_table_entry_t*)(base + sizeof(zipc_table_header_t));
 }
 
-/* Add entry to table */
+/* Internal: Number of reserved slots, clamped to max_entries */
+static uint32_t slot_count(zipc_table_header_t* header) {
+    uint32_t count = atomic_load_explicit(&header->entry_count, memory_order_acquire);
+    return count < header->max_entries ? count : header->max_entries;
+}
+
+/* Internal: Index of the published entry called name, or -1 */
+static int find_published(zeroipc_memory_t* mem, const char* name) {
+    zipc_table_header_t* header = get_header(mem);
+    zipc_table_entry_t* entries = get_entries(mem);
+    uint32_t count = slot_count(header);
+
+    for (uint32_t i = 0; i < count; i++) {
+        if (atomic_load_explicit(&entries[i].state, memory_order_acquire) == ZIPC_ENTRY_PUBLISHED &&
+            strcmp(entries[i].name, name) == 0) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+/* Internal: True if a slot below index holds a live claim on name. Lower
+ * PENDING slots are waited on (bounded) since they may be racing us, then
+ * marked DEAD; if that CAS loses, the slot was just claimed. */
+static int lower_slot_claims(zipc_table_entry_t* entries, const char* name, uint32_t index) {
+    for (uint32_t i = 0; i < index; i++) {
+        uint32_t state = atomic_load_explicit(&entries[i].state, memory_order_acquire);
+        for (int spins = 0; state == ZIPC_ENTRY_PENDING && spins < MAX_SPINS; spins++) {
+            sched_yield();
+            state = atomic_load_explicit(&entries[i].state, memory_order_acquire);
+        }
+        if (state == ZIPC_ENTRY_PENDING) {
+            atomic_compare_exchange_strong_explicit(&entries[i].state, &state, ZIPC_ENTRY_DEAD,
+                                                    memory_order_acq_rel, memory_order_acquire);
+        }
+        if ((state == ZIPC_ENTRY_CLAIMED || state == ZIPC_ENTRY_PUBLISHED) &&
+            strcmp(entries[i].name, name) == 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* Internal: Lock-free bump allocation (CAS on next_offset) */
+static int bump_allocate(zeroipc_memory_t* mem, size_t size, size_t alignment, size_t* offset) {
+    zipc_table_header_t* header = get_header(mem);
+    size_t mem_size = zeroipc_memory_size(mem);
+    uint64_t current = atomic_load_explicit(&header->next_offset, memory_order_relaxed);
+    size_t aligned;
+
+    do {
+        aligned = align_up(current, alignment);
+        if (aligned > mem_size || size > mem_size - aligned) {
+            return ZEROIPC_ERROR_SIZE;
+        }
+    } while (!atomic_compare_exchange_weak_explicit(
+                 &header->next_offset, &current, aligned + size,
+                 memory_order_acq_rel, memory_order_relaxed));
+
+    *offset = aligned;
+    return ZEROIPC_OK;
+}
+
+/* Add entry to table (lock-free, safe across processes) */
 int zeroipc_table_add(zeroipc_memory_t* mem, const char* name, size_t size, size_t* offset) {
+    return zeroipc_table_add_aligned(mem, name, size, ZEROIPC_MIN_SECTION_ALIGN, offset);
+}
+
+/* Add entry with an explicit section alignment. The base is aligned to
+ * max(alignment, ZEROIPC_CACHE_LINE_SIZE); alignment is recorded in the
+ * entry so every reader computes the same section offsets. */
+int zeroipc_table_add_aligned(zeroipc_memory_t* mem, const char* name, size_t size,
+                              size_t alignment, size_t* offset) {
     if (!mem || !name || size == 0) {
         return ZEROIPC_ERROR_SIZE;
     }
 
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0 ||
+        alignment > ZEROIPC_MAX_ALLOC_ALIGN) {
+        return ZEROIPC_ERROR_ALIGNMENT;
+    }
+
     if (strlen(name) >= MAX_NAME_SIZE) {
         return ZEROIPC_ERROR_NAME_TOO_LONG;
     }
 
     zipc_table_header_t* header = get_header(mem);
     zipc_table_entry_t* entries = get_entries(mem);
-    
-    /* Check if name already exists */
-    for (uint32_t i = 0; i < header->entry_count; i++) {
-        if (strcmp(entries[i].name, name) == 0) {
+    zipc_table_entry_t* entry;
+    uint32_t index;
+
+    /* Claim the name before taking any space, so a registrar that loses a
+     * same-name race (or finds the table full) leaves next_offset alone */
+    for (;;) {
+        if (find_published(mem, name) >= 0) {
             return ZEROIPC_ERROR_ALREADY_EXISTS;
         }
+
+        /* Reserve a slot; fails if the table is full */
+        index = atomic_load_explicit(&header->entry_count, memory_order_relaxed);
+        do {
+            if (index >= header->max_entries) {
+                return ZEROIPC_ERROR_TABLE_FULL;
+            }
+        } while (!atomic_compare_exchange_weak_explicit(
+                     &header->entry_count, &index, index + 1,
+                     memory_order_acq_rel, memory_order_relaxed));
+
+        /* Write the name into our slot, then claim it */
+        entry = &entries[index];
+        memset(entry->name, 0, MAX_NAME_SIZE);
+        strncpy(entry->name, name, MAX_NAME_SIZE - 1);
+        uint32_t pending = ZIPC_ENTRY_PENDING;
+        if (atomic_compare_exchange_strong_explicit(&entry->state, &pending, ZIPC_ENTRY_CLAIMED,
+                                                    memory_order_acq_rel, memory_order_relaxed)) {
+            break;
+        }
+        /* We stalled so long that a registrar above gave up on the slot;
+         * it is dead, so start over in a fresh one */
     }
-    
-    /* Check if table is full */
-    if (header->entry_count >= header->max_entries) {
-        return ZEROIPC_ERROR_TABLE_FULL;
+
+    /* Same-name race: the lowest claimed slot wins */
+    if (lower_slot_claims(entries, name, index)) {
+        atomic_store_explicit(&entry->state, ZIPC_ENTRY_DEAD, memory_order_release);
+        return ZEROIPC_ERROR_ALREADY_EXISTS;
     }
-    
-    /* Check if enough space */
-    const size_t alignment = sizeof(uint64_t);
-    size_t aligned_offset = align_up(header->next_offset, alignment);
-    if (aligned_offset > zeroipc_memory_size(mem) || size > zeroipc_memory_size(mem) - aligned_offset) {
+
+    /* The name is ours; reserve space and publish */
+    size_t aligned_offset;
+    size_t base_align = alignment > ZEROIPC_CACHE_LINE_SIZE ? alignment : ZEROIPC_CACHE_LINE_SIZE;
+    if (bump_allocate(mem, size, base_align, &aligned_offset) != ZEROIPC_OK) {
+        atomic_store_explicit(&entry->state, ZIPC_ENTRY_DEAD, memory_order_release);
         return ZEROIPC_ERROR_SIZE;
     }
-    
-    /* Add entry */
-    zipc_table_entry_t* entry = &entries[header->entry_count];
-    strncpy(entry->name, name, MAX_NAME_SIZE - 1);
-    entry->name[MAX_NAME_SIZE - 1] = '\0';
     entry->offset = aligned_offset;
     entry->size = size;
+    entry->alignment = (uint32_t)alignment;
+    atomic_store_explicit(&entry->state, ZIPC_ENTRY_PUBLISHED, memory_order_release);
     
-    /* Update header */
     if (offset) {
         *offset = aligned_offset;
     }
-    header->next_offset = aligned_offset + size;
-    header->entry_count++;
-    
     return ZEROIPC_OK;
 }
 
 /* Find entry in table */
 int zeroipc_table_find(zeroipc_memory_t* mem, const char* name, size_t* offset, size_t* size) {
+    return zeroipc_table_find_aligned(mem, name, offset, size, NULL);
+}
+
+/* Find entry in table, also reporting its section alignment */
+int zeroipc_table_find_aligned(zeroipc_memory_t* mem, const char* name, size_t* offset,
+                               size_t* size, size_t* alignment) {
     if (!mem || !name) {
         return ZEROIPC_ERROR_NOT_FOUND;
     }
 
-    zipc_table_header_t* header = get_header(mem);
+    int i = find_published(mem, name);
+    if (i < 0) {
+        return ZEROIPC_ERROR_NOT_FOUND;
+    }
+
     zipc_table_entry_t* entries = get_entries(mem);
-    
-    /* Search for entry */
-    for (uint32_t i = 0; i < header->entry_count; i++) {
-        if (strcmp(entries[i].name, name) == 0) {
-            if (offset) {
-                *offset = entries[i].offset;
-            }
-            if (size) {
-                *size = entries[i].size;
-            }
-            return ZEROIPC_OK;
-        }
+    if (offset) {
+        *offset = entries[i].offset;
     }
-    
-    return ZEROIPC_ERROR_NOT_FOUND;
+    if (size) {
+        *size = entries[i].size;
+    }
+    if (alignment) {
+        *alignment = entries[i].alignment ? entries[i].alignment : ZEROIPC_MIN_SECTION_ALIGN;
+    }
+    return ZEROIPC_OK;
 }
 
-/* Remove entry from table */
+/* Remove entry from table. The slot is tombstoned (PUBLISHED -> DEAD) rather
+ * than compacted, so concurrent readers and registrars never see entries
+ * move. The structure's space is not reclaimed. */
 int zeroipc_table_remove(zeroipc_memory_t* mem, const char* name) {
     if (!mem || !name) {
         return ZEROIPC_ERROR_NOT_FOUND;
     }
 
-    zipc_table_header_t* header = get_header(mem);
     zipc_table_entry_t* entries = get_entries(mem);
     
-    /* Find entry */
-    for (uint32_t i = 0; i < header->entry_count; i++) {
-        if (strcmp(entries[i].name, name) == 0) {
-            /* Move remaining entries */
-            for (uint32_t j = i; j < header->entry_count - 1; j++) {
-                entries[j] = entries[j + 1];
-            }
-            header->entry_count--;
+    for (;;) {
+        int i = find_published(mem, name);
+        if (i < 0) {
+            return ZEROIPC_ERROR_NOT_FOUND;
+        }
+        uint32_t expected = ZIPC_ENTRY_PUBLISHED;
+        if (atomic_compare_exchange_strong_explicit(
+                &entries[i].state, &expected, ZIPC_ENTRY_DEAD,
+                memory_order_acq_rel, memory_order_relaxed)) {
             return ZEROIPC_OK;
         }
+        /* A concurrent remove won; look again */
     }
-    
-    return ZEROIPC_ERROR_NOT_FOUND;
 }
 
-/* Get entry count */
+/* Get number of published entries */
 size_t zeroipc_table_count(zeroipc_memory_t* mem) {
     if (!mem) {
         return 0;
     }
 
     zipc_table_header_t* header = get_header(mem);
-    return header->entry_count;
+    zipc_table_entry_t* entries = get_entries(mem);
+    uint32_t count = slot_count(header);
+    size_t published = 0;
+
+    for (uint32_t i = 0; i < count; i++) {
+        if (atomic_load_explicit(&entries[i].state, memory_order_acquire) == ZIPC_ENTRY_PUBLISHED) {
+            published++;
+        }
+    }
+    return published;
 }
@@ -5,29 +5,46 @@
  * the C++, Go, and Python implementations exactly.
  *
  * Table Header: 32 bytes
- * Table Entry:  48 bytes
+ * Table Entry:  56 bytes
+ *
+ * entry_count, next_offset and each entry's state are updated atomically so
+ * that processes can register structures concurrently (format v3).
  */
 
 #ifndef ZEROIPC_TABLE_LAYOUT_H
 #define ZEROIPC_TABLE_LAYOUT_H
 
 #include <stdint.h>
+#include <stdatomic.h>
 
 /* Table header - binary compatible with C++, Go, and Python (32 bytes) */
 typedef struct {
     uint32_t magic;         /* 0x00: 0x5A49504D ('ZIPM') */
-    uint32_t version;       /* 0x04: 1 */
-    uint32_t entry_count;   /* 0x08: active entries */
+    uint32_t version;       /* 0x04: 3 */
+    _Atomic uint32_t entry_count; /* 0x08: reserved slots (published or not) */
     uint32_t max_entries;   /* 0x0C: max entries (C extension; C++/Go write 0 here) */
     uint64_t memory_size;   /* 0x10: total memory size */
-    uint64_t next_offset;   /* 0x18: next allocation offset */
+    _Atomic uint64_t next_offset; /* 0x18: next allocation offset */
 } zipc_table_header_t;      /* 32 bytes total */
 
-/* Table entry - binary compatible with C++, Go, and Python (48 bytes) */
+/* Entry states: PENDING -> CLAIMED -> PUBLISHED, or CLAIMED -> DEAD when a
+ * concurrent registrar in a lower slot claimed the same name. Readers only
+ * see PUBLISHED entries. */
+#define ZIPC_ENTRY_PENDING   0u
+#define ZIPC_ENTRY_CLAIMED   1u
+#define ZIPC_ENTRY_PUBLISHED 2u
+#define ZIPC_ENTRY_DEAD      3u
+
+/* Table entry - binary compatible with C++, Go, and Python (56 bytes) */
 typedef struct {
     char     name[32];      /* 0x00: null-terminated name */
     uint64_t offset;        /* 0x20: offset from base */
     uint64_t size;          /* 0x28: allocated size */
-} zipc_table_entry_t;       /* 48 bytes total */
+    _Atomic uint32_t state; /* 0x30: ZIPC_ENTRY_* */
+    uint32_t alignment;     /* 0x34: section alignment in bytes (0 = 8) */
+} zipc_table_entry_t;       /* 56 bytes total */
+
+_Static_assert(sizeof(zipc_table_header_t) == 32, "Table header must be 32 bytes");
+_Static_assert(sizeof(zipc_table_entry_t) == 56, "Table entry must be 56 bytes");
 
 #endif /* ZEROIPC_TABLE_LAYOUT_H */
@@ -5,6 +5,7 @@
 #include <unistd.h>
 #include <sys/wait.h>
 #include "zeroipc.h"
+#include "zeroipc_seqlock.h"
 
 void test_memory_create() {
     printf("Testing memory creation...\n");
@@ -71,6 +72,21 @@ void test_table_operations() {
     /* Try duplicate */
     assert(zeroipc_table_add(mem, "entry1", 50, NULL) == ZEROIPC_ERROR_ALREADY_EXISTS);
     
+    /* Bases are cache-line aligned; explicit alignment is honored and recorded */
+    size_t found_align;
+    assert(offset1 % ZEROIPC_CACHE_LINE_SIZE == 0);
+    assert(offset2 % ZEROIPC_CACHE_LINE_SIZE == 0);
+    assert(zeroipc_table_find_aligned(mem, "entry1", NULL, NULL, &found_align) == ZEROIPC_OK);
+    assert(found_align == ZEROIPC_MIN_SECTION_ALIGN);
+    size_t page_offset;
+    assert(zeroipc_table_add_aligned(mem, "paged", 100, 4096, &page_offset) == ZEROIPC_OK);
+    assert(page_offset % 4096 == 0);
+    assert(zeroipc_table_find_aligned(mem, "paged", NULL, NULL, &found_align) == ZEROIPC_OK);
+    assert(found_align == 4096);
+    assert(zeroipc_table_add_aligned(mem, "bad1", 100, 24, NULL) == ZEROIPC_ERROR_ALIGNMENT);
+    assert(zeroipc_table_add_aligned(mem, "bad2", 100, 8192, NULL) == ZEROIPC_ERROR_ALIGNMENT);
+    assert(zeroipc_table_remove(mem, "paged") == ZEROIPC_OK);
+    
     /* Remove entry */
     assert(zeroipc_table_remove(mem, "entry1") == ZEROIPC_OK);
     assert(zeroipc_table_count(mem) == 1);
@@ -181,6 +197,116 @@ void test_cross_process() {
     printf("  ✓ Cross-process access passed\n");
 }
 
+void test_concurrent_registration() {
+    printf("Testing concurrent registration across processes...\n");
+
+    enum { NPROC = 8, PER_PROC = 12 };
+    zeroipc_memory_t* mem = zeroipc_memory_create("/test_conc_reg", 1024*1024, 128);
+    assert(mem != NULL);
+
+    pid_t pids[NPROC];
+    for (int p = 0; p < NPROC; p++) {
+        pids[p] = fork();
+        if (pids[p] == 0) {
+            zeroipc_memory_t* child = zeroipc_memory_open("/test_conc_reg");
+            if (!child) _exit(1);
+            char name[32];
+            for (int i = 0; i < PER_PROC; i++) {
+                /* Unique names, plus one name every process races for */
+                snprintf(name, sizeof(name), "p%d_e%d", p, i);
+                if (zeroipc_table_add(child, name, 64 + i, NULL) != ZEROIPC_OK) _exit(2);
+            }
+            int rc = zeroipc_table_add(child, "contended", 32, NULL);
+            zeroipc_memory_close(child);
+            _exit(rc == ZEROIPC_OK ? 10 : (rc == ZEROIPC_ERROR_ALREADY_EXISTS ? 11 : 3));
+        }
+    }
+
+    int winners = 0;
+    for (int p = 0; p < NPROC; p++) {
+        int status;
+        waitpid(pids[p], &status, 0);
+        assert(WIFEXITED(status));
+        assert(WEXITSTATUS(status) == 10 || WEXITSTATUS(status) == 11);
+        winners += WEXITSTATUS(status) == 10;
+    }
+    assert(winners == 1);
+    assert(zeroipc_table_count(mem) == NPROC * PER_PROC + 1);
+
+    /* Every entry is findable and no two allocations overlap */
+    size_t offs[NPROC * PER_PROC], sizes[NPROC * PER_PROC];
+    char name[32];
+    for (int p = 0; p < NPROC; p++) {
+        for (int i = 0; i < PER_PROC; i++) {
+            int k = p * PER_PROC + i;
+            snprintf(name, sizeof(name), "p%d_e%d", p, i);
+            assert(zeroipc_table_find(mem, name, &offs[k], &sizes[k]) == ZEROIPC_OK);
+            assert(sizes[k] == (size_t)(64 + i));
+            for (int j = 0; j < k; j++) {
+                assert(offs[k] + sizes[k] <= offs[j] || offs[j] + sizes[j] <= offs[k]);
+            }
+        }
+    }
+
+    zeroipc_memory_close(mem);
+    zeroipc_memory_unlink("/test_conc_reg");
+
+    printf("  ✓ Concurrent registration passed\n");
+}
+
+typedef struct {
+    uint64_t tick;
+    double position[3];
+    uint64_t check; /* tick * 3 */
+} telemetry_t;
+
+void test_seqlock() {
+    printf("Testing seqlock...\n");
+
+    zeroipc_memory_t* mem = zeroipc_memory_create("/test_seqlock", 1024*1024, 64);
+    assert(mem != NULL);
+
+    telemetry_t t = {1, {1.0, 2.0, 3.0}, 3};
+    zeroipc_seqlock_t* lock = zeroipc_seqlock_create(mem, "telemetry", sizeof(t), &t);
+    assert(lock != NULL);
+    assert(zeroipc_seqlock_sequence(lock) == 0);
+
+    /* Wrong size does not open */
+    assert(zeroipc_seqlock_open(mem, "telemetry", 8) == NULL);
+
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid == 0) {
+        /* Child: read until the last tick, checking every copy is whole */
+        zeroipc_memory_t* child_mem = zeroipc_memory_open("/test_seqlock");
+        zeroipc_seqlock_t* child = zeroipc_seqlock_open(child_mem, "telemetry", sizeof(t));
+        if (!child) exit(2);
+        telemetry_t seen = {0};
+        while (seen.tick < 10000) {
+            if (zeroipc_seqlock_read(child, &seen) != ZEROIPC_OK) exit(3);
+            if (seen.check != seen.tick * 3 || seen.position[2] != (double)seen.tick * 3) exit(1);
+        }
+        zeroipc_seqlock_close(child);
+        zeroipc_memory_close(child_mem);
+        exit(0);
+    }
+
+    for (uint64_t i = 1; i <= 10000; i++) {
+        telemetry_t next = {i, {(double)i, (double)i * 2, (double)i * 3}, i * 3};
+        zeroipc_seqlock_write(lock, &next);
+    }
+    int status;
+    waitpid(pid, &status, 0);
+    assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    assert(zeroipc_seqlock_sequence(lock) == 20000);
+
+    zeroipc_seqlock_close(lock);
+    zeroipc_memory_close(mem);
+    zeroipc_memory_unlink("/test_seqlock");
+
+    printf("  ✓ SeqLock passed\n");
+}
+
 int main() {
     printf("=== ZeroIPC C Tests ===\n\n");
     
@@ -189,6 +315,8 @@ int main() {
     test_table_operations();
     test_array_operations();
     test_cross_process();
+    test_concurrent_registration();
+    test_seqlock();
     
     printf("\n✓ All tests passed!\n");
     return 0;
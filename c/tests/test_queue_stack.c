@@ -498,6 +498,130 @@ void test_section_alignment() {
  * counter % capacity is continuous across the wrap. Seed the counters just
  * below UINT32_MAX (with matching per-slot sequence numbers, seq[pos % cap]
  * = pos) and stream elements across the boundary in FIFO order. */
+/* A queue written by another language with 64-byte section alignment (e.g.
+ * C++ Queue<T> with alignas(64) T): data at 64, sequences at 64 + 4*64.
+ * Opening it must honor the alignment recorded in the table entry. */
+void test_over_aligned_open() {
+    printf("Testing over-aligned queue open...\n");
+
+    zeroipc_memory_t* mem = zeroipc_memory_create("/test_qs_aligned", 1024*1024, 64);
+    assert(mem != NULL);
+
+    const size_t align = 64, elem_size = 64, cap = 4;
+    size_t data_off = align;
+    size_t seq_off = data_off + elem_size * cap;
+    size_t offset;
+    assert(zeroipc_table_add_aligned(mem, "q_a64", seq_off + cap * 4, align, &offset) == ZEROIPC_OK);
+    assert(offset % align == 0);
+
+    char* base = (char*)zeroipc_memory_base(mem);
+    uint32_t header[4] = {0, 0, (uint32_t)cap, (uint32_t)elem_size};
+    memcpy(base + offset, header, sizeof(header));
+    for (uint32_t i = 0; i < cap; ++i) {
+        memcpy(base + offset + seq_off + i * 4, &i, 4);
+    }
+
+    zeroipc_queue_t* q = zeroipc_queue_open(mem, "q_a64");
+    assert(q != NULL);
+
+    char in[64], out[64];
+    memset(in, 0x5A, sizeof(in));
+    assert(zeroipc_queue_push(q, in) == ZEROIPC_OK);
+    assert(memcmp(base + offset + data_off, in, elem_size) == 0);
+    uint32_t seq;
+    memcpy(&seq, base + offset + seq_off, 4);
+    assert(seq == 1);  /* published at the spec-computed offset */
+    assert(zeroipc_queue_pop(q, out) == ZEROIPC_OK);
+    assert(memcmp(in, out, elem_size) == 0);
+
+    zeroipc_queue_close(q);
+    zeroipc_memory_close(mem);
+    zeroipc_memory_unlink("/test_qs_aligned");
+
+    printf("  ✓ Over-aligned queue open passed\n");
+}
+
+/* Interleaved layouts put each slot's sequence number beside its element;
+ * the layout is read back from the header's elem_size flags on open. */
+void test_interleaved_layout() {
+    printf("Testing interleaved queue layouts...\n");
+
+    zeroipc_memory_t* mem = zeroipc_memory_create("/test_qs_inter", 1024*1024, 64);
+    assert(mem != NULL);
+
+    /* 12-byte element: seq at +12, padded slot stride is one cache line */
+    zeroipc_queue_t* q = zeroipc_queue_create_layout(mem, "q_pad", 12, 4,
+                                                     ZEROIPC_QUEUE_INTERLEAVED_PADDED);
+    assert(q != NULL);
+    assert(zeroipc_queue_create_layout(mem, "q_bad", 12, 4, 0x08000000u) == NULL);
+
+    size_t offset, size;
+    assert(zeroipc_table_find(mem, "q_pad", &offset, &size) == ZEROIPC_OK);
+    assert(size == 64 + 4 * 64);
+    char* base = (char*)zeroipc_memory_base(mem) + offset;
+    uint32_t stored;
+    memcpy(&stored, base + 12, 4);
+    assert(stored == (12u | ZEROIPC_QUEUE_INTERLEAVED_PADDED));
+
+    char in[12] = "hello world", out[12];
+    assert(zeroipc_queue_push(q, in) == ZEROIPC_OK);
+    assert(memcmp(base + 64, in, 12) == 0);
+    uint32_t seq;
+    memcpy(&seq, base + 64 + 12, 4);
+    assert(seq == 1);
+    memcpy(&seq, base + 64 + 64 + 12, 4);
+    assert(seq == 1);  /* slot 1 untouched: seq[1] = 1 */
+
+    zeroipc_queue_t* q2 = zeroipc_queue_open(mem, "q_pad");
+    assert(q2 != NULL);
+    assert(zeroipc_queue_pop(q2, out) == ZEROIPC_OK);
+    assert(memcmp(in, out, 12) == 0);
+
+    /* Unpadded: 8-byte slot for a 4-byte element */
+    zeroipc_queue_t* q3 = zeroipc_queue_create_layout(mem, "q_int", sizeof(int), 8,
+                                                      ZEROIPC_QUEUE_INTERLEAVED);
+    assert(q3 != NULL);
+    assert(zeroipc_table_find(mem, "q_int", &offset, &size) == ZEROIPC_OK);
+    assert(size == 16 + 8 * 8);
+    for (int i = 0; i < 8; i++) {
+        assert(zeroipc_queue_push(q3, &i) == ZEROIPC_OK);
+    }
+    int v;
+    for (int i = 0; i < 8; i++) {
+        assert(zeroipc_queue_pop(q3, &v) == ZEROIPC_OK && v == i);
+    }
+
+    /* Padded header: head at +64, tail at +128, slots from +192 */
+    zeroipc_queue_t* q4 = zeroipc_queue_create_layout(mem, "q_hdr", sizeof(int), 8,
+                                                      ZEROIPC_QUEUE_SPLIT | ZEROIPC_QUEUE_PADDED_HEADER);
+    assert(q4 != NULL);
+    assert(zeroipc_table_find(mem, "q_hdr", &offset, &size) == ZEROIPC_OK);
+    assert(size == 192 + 8 * sizeof(int) + 8 * 4);
+    base = (char*)zeroipc_memory_base(mem) + offset;
+    v = 42;
+    assert(zeroipc_queue_push(q4, &v) == ZEROIPC_OK);
+    memcpy(&seq, base + 128, 4);
+    assert(seq == 1);  /* tail */
+    memcpy(&seq, base + 4, 4);
+    assert(seq == 0);  /* the header's own tail is unused */
+    assert(memcmp(base + 192, &v, sizeof(int)) == 0);
+    zeroipc_queue_t* q5 = zeroipc_queue_open(mem, "q_hdr");
+    assert(q5 != NULL && zeroipc_queue_size(q5) == 1);
+    assert(zeroipc_queue_pop(q5, &v) == ZEROIPC_OK && v == 42);
+    memcpy(&seq, base + 64, 4);
+    assert(seq == 1);  /* head */
+
+    zeroipc_queue_close(q);
+    zeroipc_queue_close(q2);
+    zeroipc_queue_close(q3);
+    zeroipc_queue_close(q4);
+    zeroipc_queue_close(q5);
+    zeroipc_memory_close(mem);
+    zeroipc_memory_unlink("/test_qs_inter");
+
+    printf("  ✓ Interleaved queue layouts passed\n");
+}
+
 void test_queue_wraparound() {
     printf("Testing queue 2^32 counter wraparound...\n");
 
@@ -551,6 +675,45 @@ void test_queue_wraparound() {
     printf("  ✓ Queue wraparound passed\n");
 }
 
+void test_stack_padded_top() {
+    printf("Testing padded stack top...\n");
+
+    zeroipc_memory_t* mem = zeroipc_memory_create("/test_qs_ptop", 1024*1024, 64);
+    assert(mem != NULL);
+
+    /* Padded top: top at +64, data from +128 (the C++ default) */
+    zeroipc_stack_t* s = zeroipc_stack_create_layout(mem, "s_pad", sizeof(int), 8,
+                                                     ZEROIPC_STACK_PADDED_TOP);
+    assert(s != NULL);
+    assert(zeroipc_stack_create_layout(mem, "s_bad", sizeof(int), 8, 0x01000000u) == NULL);
+
+    size_t offset = 0, size = 0;
+    assert(zeroipc_table_find(mem, "s_pad", &offset, &size) == ZEROIPC_OK);
+    assert(size == 128 + 8 * sizeof(int) + 8 * 4);
+    char* base = (char*)zeroipc_memory_base(mem) + offset;
+
+    int v = 42;
+    assert(zeroipc_stack_push(s, &v) == ZEROIPC_OK);
+    int32_t top;
+    memcpy(&top, base + 64, 4);
+    assert(top == 0);
+    memcpy(&top, base, 4);
+    assert(top == -1);  /* the header's own top is unused */
+    assert(memcmp(base + 128, &v, sizeof(int)) == 0);
+
+    zeroipc_stack_t* s2 = zeroipc_stack_open(mem, "s_pad");
+    assert(s2 != NULL && zeroipc_stack_size(s2) == 1);
+    assert(zeroipc_stack_pop(s2, &v) == ZEROIPC_OK && v == 42);
+    assert(zeroipc_stack_empty(s));
+
+    zeroipc_stack_close(s);
+    zeroipc_stack_close(s2);
+    zeroipc_memory_close(mem);
+    zeroipc_memory_unlink("/test_qs_ptop");
+
+    printf("  ✓ Padded stack top passed\n");
+}
+
 /* Crash-safety: a peer that dies mid-operation leaves its slot state
  * permanently claimed. Simulate the ghost by poking the state array, then
  * assert push/pop fail bounded (ZEROIPC_ERROR_TIMEOUT, no hang), undo their
@@ -611,7 +774,10 @@ int main() {
     test_queue_basic();
     test_stack_basic();
     test_section_alignment();
+    test_over_aligned_open();
+    test_interleaved_layout();
     test_queue_wraparound();
+    test_stack_padded_top();
     test_crashed_peer();
     test_queue_concurrent();
     test_queue_mpmc();
@@ -76,6 +76,14 @@ void test_table_name_collisions() {
     int* retrieved = (int*)zeroipc_array_get(arr1, 0);
     assert(retrieved != NULL && *retrieved == 42);
     
+    // A rejected registration takes no space: the next one lands directly
+    // after the last successful one
+    size_t first, second;
+    assert(zeroipc_table_add(mem, "spaced", 64, &first) == ZEROIPC_OK);
+    assert(zeroipc_table_add(mem, "spaced", 64, &second) == ZEROIPC_ERROR_ALREADY_EXISTS);
+    assert(zeroipc_table_add(mem, "after", 64, &second) == ZEROIPC_OK);
+    assert(second == first + 64);
+    
     zeroipc_array_close(arr1);
     zeroipc_memory_close(mem);
     zeroipc_memory_unlink("/test_table_stress");
@@ -6,6 +6,8 @@
 #include <iomanip>
 #include <algorithm>
 #include <random>
+#include <numeric>
+#include <climits>
 #include <zeroipc/memory.h>
 #include <zeroipc/array.h>
 
@@ -53,6 +55,56 @@ public:
         }
     }
     
+    // Bulk operations over a large float array: std:: serial loops against
+    // Array's vectorized kernels on one thread and on every hardware thread
+    static void benchmark_bulk_operations() {
+        std::cout << "\n=== Array Bulk Operations (" << BULK_SIZE / 1000000 << "M floats) ===" << std::endl;
+
+        Memory::unlink("/bench_array_bulk");
+        Memory mem("/bench_array_bulk", BULK_SIZE * sizeof(float) + 1024*1024);
+        Array<float> array(mem, "bulk", BULK_SIZE);
+        std::vector<float> src(BULK_SIZE, 1.5f);
+        const unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+
+        std::cout << std::setw(10) << "Op"
+                  << std::setw(14) << "std:: (GB/s)"
+                  << std::setw(14) << "1 thread"
+                  << std::setw(10) << hw << " threads" << std::endl;
+
+        float sink = 0;
+        auto row = [&](const char* op, auto serial, auto bulk) {
+            double s = gb_per_sec(serial);
+            double one = gb_per_sec([&] { bulk(1u); });
+            double all = gb_per_sec([&] { bulk(hw); });
+            std::cout << std::setw(10) << op << std::fixed << std::setprecision(2)
+                      << std::setw(14) << s << std::setw(14) << one
+                      << std::setw(18) << all << std::endl;
+        };
+
+        row("fill",
+            [&] { std::fill(array.begin(), array.end(), 2.0f); },
+            [&](unsigned t) { array.fill(2.0f, t); });
+        row("copy",
+            [&] { std::copy(src.begin(), src.end(), array.begin()); },
+            [&](unsigned t) { array.copy_from(src.data(), src.size(), 0, t); });
+        row("transform",
+            [&] { std::transform(array.begin(), array.end(), array.begin(),
+                                 [](float x) { return x * 0.5f + 1.0f; }); },
+            [&](unsigned t) { array.transform([](float x) { return x * 0.5f + 1.0f; }, t); });
+        row("sum",
+            [&] { sink += std::accumulate(array.begin(), array.end(), 0.0f); },
+            [&](unsigned t) { sink += array.sum(t); });
+        row("max",
+            [&] { sink += *std::max_element(array.begin(), array.end()); },
+            [&](unsigned t) { sink += array.max(t); });
+        row("find",
+            [&] { sink += std::find(array.begin(), array.end(), -1.0f) - array.begin(); },
+            [&](unsigned t) { sink += array.find(-1.0f, t).value_or(0); });
+
+        std::cout << "(checksum " << sink << ")" << std::endl;
+        Memory::unlink("/bench_array_bulk");
+    }
+
     static void benchmark_random_access() {
         std::cout << "\n=== Array Random Access ===" << std::endl;
         
@@ -196,6 +248,21 @@ public:
     }
 
 private:
+    static constexpr size_t BULK_SIZE = 32 * 1000 * 1000;
+
+    // Best of 5 runs, counting the bytes of one pass over the array
+    template<typename F>
+    static double gb_per_sec(F&& f) {
+        long best_us = LONG_MAX;
+        for (int rep = 0; rep < 5; rep++) {
+            auto start = high_resolution_clock::now();
+            f();
+            best_us = std::min<long>(best_us,
+                duration_cast<microseconds>(high_resolution_clock::now() - start).count());
+        }
+        return (BULK_SIZE * sizeof(float)) / (std::max(best_us, 1L) * 1000.0);
+    }
+
     static void benchmark_stride(Array<int>& array, size_t stride, 
                                  int iterations, const std::string& name) {
         auto start = high_resolution_clock::now();
@@ -262,6 +329,7 @@ int main() {
     Memory::unlink("/bench_array");
     
     ArrayBenchmark::benchmark_sequential_access();
+    ArrayBenchmark::benchmark_bulk_operations();
     ArrayBenchmark::benchmark_random_access();
     ArrayBenchmark::benchmark_access_patterns();
     ArrayBenchmark::benchmark_concurrent_access();
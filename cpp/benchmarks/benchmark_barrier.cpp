@@ -0,0 +1,113 @@
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <iomanip>
+#include <algorithm>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <zeroipc/memory.h>
+#include <zeroipc/array.h>
+#include <zeroipc/barrier.h>
+
+using namespace zeroipc;
+using namespace std::chrono;
+
+class BarrierBenchmark {
+public:
+    // Every process passes the barrier ROUNDS times in a row; a round trip
+    // is the slowest process's total time divided by ROUNDS
+    static void benchmark_round_trip() {
+        std::cout << "\n=== Barrier Round Trip (" << ROUNDS << " rounds per run) ===" << std::endl;
+        std::cout << std::setw(10) << "Processes"
+                  << std::setw(14) << "Central"
+                  << std::setw(14) << "Tree"
+                  << "   (us/round)" << std::endl;
+
+        for (int processes : {2, 4, 8, 16, 32, 64}) {
+            double central = run(processes, Barrier::Mode::Central);
+            double tree = run(processes, Barrier::Mode::Tree);
+            std::cout << std::setw(10) << processes
+                      << std::fixed << std::setprecision(2)
+                      << std::setw(14) << central
+                      << std::setw(14) << tree << std::endl;
+        }
+    }
+
+    // A single participant passing alone: the cost of the barrier itself
+    static void benchmark_uncontended() {
+        std::cout << "\n=== Uncontended Latency (single participant) ===" << std::endl;
+        Memory::unlink("/bench_barrier");
+        Memory mem("/bench_barrier", 1024*1024);
+        Barrier central(mem, "central", 1, Barrier::Mode::Central);
+        Barrier tree(mem, "tree", 1, Barrier::Mode::Tree);
+
+        const int iterations = 10000000;
+        auto start = high_resolution_clock::now();
+        for (int i = 0; i < iterations; i++) {
+            central.wait();
+        }
+        auto central_ns = duration_cast<nanoseconds>(high_resolution_clock::now() - start).count();
+
+        start = high_resolution_clock::now();
+        for (int i = 0; i < iterations; i++) {
+            tree.wait();
+        }
+        auto tree_ns = duration_cast<nanoseconds>(high_resolution_clock::now() - start).count();
+
+        std::cout << std::fixed << std::setprecision(1)
+                  << "Central wait: " << double(central_ns) / iterations << " ns" << std::endl
+                  << "Tree    wait: " << double(tree_ns) / iterations << " ns" << std::endl;
+        Memory::unlink("/bench_barrier");
+    }
+
+private:
+    static constexpr int ROUNDS = 1000;
+
+    static double run(int processes, Barrier::Mode mode) {
+        Memory::unlink("/bench_barrier");
+        Memory mem("/bench_barrier", 1024*1024);
+        Barrier barrier(mem, "bench_barrier", processes, mode);
+        Array<uint64_t> elapsed(mem, "bench_elapsed", processes);
+
+        std::vector<pid_t> children;
+        for (int p = 0; p < processes; p++) {
+            pid_t pid = fork();
+            if (pid == 0) {
+                Memory child_mem("/bench_barrier");
+                Barrier child_barrier(child_mem, "bench_barrier");
+                Array<uint64_t> child_elapsed(child_mem, "bench_elapsed");
+
+                child_barrier.wait();  // Everyone has started
+                auto start = high_resolution_clock::now();
+                for (int r = 0; r < ROUNDS; r++) {
+                    child_barrier.wait();
+                }
+                child_elapsed[p] = duration_cast<nanoseconds>(
+                    high_resolution_clock::now() - start).count();
+                _exit(0);
+            }
+            children.push_back(pid);
+        }
+        for (pid_t pid : children) waitpid(pid, nullptr, 0);
+
+        uint64_t slowest = 0;
+        for (int p = 0; p < processes; p++) {
+            slowest = std::max(slowest, elapsed[p]);
+        }
+
+        Memory::unlink("/bench_barrier");
+        return slowest / 1000.0 / ROUNDS;
+    }
+};
+
+int main() {
+    std::cout << "=== ZeroIPC Barrier Performance Benchmarks ===" << std::endl;
+    std::cout << "CPU Count: " << std::thread::hardware_concurrency() << std::endl;
+
+    BarrierBenchmark::benchmark_uncontended();
+    BarrierBenchmark::benchmark_round_trip();
+
+    return 0;
+}
@@ -0,0 +1,171 @@
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <iomanip>
+#include <algorithm>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <zeroipc/memory.h>
+#include <zeroipc/array.h>
+#include <zeroipc/mutex.h>
+#include <zeroipc/mcs_mutex.h>
+
+using namespace zeroipc;
+using namespace std::chrono;
+
+// One acquisition counter per process, each on its own cache line
+struct alignas(64) Counter {
+    uint64_t acquisitions;
+};
+
+// Run control flags, shared with the child processes
+enum Flag { READY, GO, MEASURE, STOP, FLAG_COUNT };
+
+class MutexBenchmark {
+public:
+    // Every process locks, bumps a shared counter and unlocks in a loop.
+    // After WARMUP (so no process is still getting started), acquisitions
+    // are counted for WINDOW: throughput is the total, fairness the spread
+    // between the least and the most busy process
+    static void benchmark_contention() {
+        std::cout << "\n=== Contended Lock/Unlock (" << WINDOW.count() << " ms per run) ===" << std::endl;
+        std::cout << std::setw(10) << "Processes"
+                  << std::setw(14) << "Mutex"
+                  << std::setw(14) << "MCSMutex"
+                  << "   (M ops/sec)"
+                  << std::setw(14) << "Mutex"
+                  << std::setw(14) << "MCSMutex"
+                  << "   (min/max share)" << std::endl;
+
+        for (int processes : {2, 4, 8, 16, 32, 64}) {
+            auto mutex = run<Mutex>(processes);
+            auto mcs = run<MCSMutex>(processes);
+            std::cout << std::setw(10) << processes
+                      << std::fixed << std::setprecision(2)
+                      << std::setw(14) << mutex.ops_per_sec / 1e6
+                      << std::setw(14) << mcs.ops_per_sec / 1e6
+                      << "              "
+                      << std::setw(14) << mutex.fairness
+                      << std::setw(14) << mcs.fairness << std::endl;
+        }
+    }
+
+    // Uncontended lock/unlock pair latency
+    static void benchmark_uncontended() {
+        std::cout << "\n=== Uncontended Latency (single thread) ===" << std::endl;
+        Memory::unlink("/bench_mutex");
+        Memory mem("/bench_mutex", 1024*1024);
+        Mutex mutex(mem, "bench_lock");
+        MCSMutex mcs(mem, "bench_mcs");
+
+        const int iterations = 10000000;
+        auto start = high_resolution_clock::now();
+        for (int i = 0; i < iterations; i++) {
+            mutex.lock();
+            mutex.unlock();
+        }
+        auto mutex_ns = duration_cast<nanoseconds>(high_resolution_clock::now() - start).count();
+
+        start = high_resolution_clock::now();
+        for (int i = 0; i < iterations; i++) {
+            mcs.lock();
+            mcs.unlock();
+        }
+        auto mcs_ns = duration_cast<nanoseconds>(high_resolution_clock::now() - start).count();
+
+        std::cout << std::fixed << std::setprecision(1)
+                  << "Mutex    lock+unlock: " << double(mutex_ns) / iterations << " ns" << std::endl
+                  << "MCSMutex lock+unlock: " << double(mcs_ns) / iterations << " ns" << std::endl;
+        Memory::unlink("/bench_mutex");
+    }
+
+private:
+    static constexpr auto WARMUP = milliseconds(50);
+    static constexpr auto WINDOW = milliseconds(200);
+
+    struct Result {
+        double ops_per_sec;
+        double fairness;  // min / max acquisitions per process (1.0 = even)
+    };
+
+    template<typename Lock>
+    static Result run(int processes) {
+        Memory::unlink("/bench_mutex");
+        Memory mem("/bench_mutex", 1024*1024);
+        Array<uint32_t> flags(mem, "bench_flags", FLAG_COUNT);
+        Array<Counter> counters(mem, "bench_counters", processes);
+        Array<uint64_t> shared(mem, "bench_shared", 1);
+        Lock lock(mem, "bench_lock");
+
+        auto flag = [](Array<uint32_t>& f, Flag which) {
+            return std::atomic_ref<uint32_t>(f[which]);
+        };
+
+        std::vector<pid_t> children;
+        for (int p = 0; p < processes; p++) {
+            pid_t pid = fork();
+            if (pid == 0) {
+                Memory child_mem("/bench_mutex");
+                Array<uint32_t> child_flags(child_mem, "bench_flags");
+                Array<Counter> child_counters(child_mem, "bench_counters");
+                Array<uint64_t> child_shared(child_mem, "bench_shared");
+                Lock child_lock(child_mem, "bench_lock");
+
+                flag(child_flags, READY).fetch_add(1);
+                while (!flag(child_flags, GO).load()) std::this_thread::yield();
+
+                uint64_t mine = 0, baseline = 0;
+                bool measuring = false;
+                while (!flag(child_flags, STOP).load(std::memory_order_relaxed)) {
+                    child_lock.lock();
+                    child_shared[0]++;
+                    child_lock.unlock();
+                    mine++;
+                    if (!measuring && flag(child_flags, MEASURE).load(std::memory_order_relaxed)) {
+                        measuring = true;
+                        baseline = mine;
+                    }
+                }
+                child_counters[p].acquisitions = measuring ? mine - baseline : 0;
+                _exit(0);
+            }
+            children.push_back(pid);
+        }
+
+        while (flag(flags, READY).load() < static_cast<uint32_t>(processes)) {
+            std::this_thread::yield();
+        }
+        flag(flags, GO).store(1);
+        std::this_thread::sleep_for(WARMUP);
+        auto start = high_resolution_clock::now();
+        flag(flags, MEASURE).store(1);
+        std::this_thread::sleep_for(WINDOW);
+        flag(flags, STOP).store(1);
+        auto dur_us = duration_cast<microseconds>(high_resolution_clock::now() - start).count();
+        for (pid_t pid : children) waitpid(pid, nullptr, 0);
+
+        uint64_t total = 0, lo = UINT64_MAX, hi = 0;
+        for (int p = 0; p < processes; p++) {
+            uint64_t n = counters[p].acquisitions;
+            total += n;
+            lo = std::min(lo, n);
+            hi = std::max(hi, n);
+        }
+
+        Memory::unlink("/bench_mutex");
+        return {total * 1000000.0 / std::max(dur_us, (long)1),
+                hi ? double(lo) / double(hi) : 0.0};
+    }
+};
+
+int main() {
+    std::cout << "=== ZeroIPC Mutex Performance Benchmarks ===" << std::endl;
+    std::cout << "CPU Count: " << std::thread::hardware_concurrency() << std::endl;
+
+    MutexBenchmark::benchmark_uncontended();
+    MutexBenchmark::benchmark_contention();
+
+    return 0;
+}
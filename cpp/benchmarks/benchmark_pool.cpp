@@ -0,0 +1,130 @@
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <iomanip>
+#include <algorithm>
+#include <zeroipc/memory.h>
+#include <zeroipc/pool.h>
+#include <zeroipc/pool_cache.h>
+
+using namespace zeroipc;
+using namespace std::chrono;
+
+struct Block {
+    char bytes[64];
+};
+
+// Pool<T> directly, behind the same interface as PoolCache
+class DirectPool {
+public:
+    explicit DirectPool(Pool<Block>& pool) : pool_(pool) {}
+    std::optional<Block*> allocate() { return pool_.allocate(); }
+    void deallocate(Block* ptr) { pool_.deallocate(ptr); }
+
+private:
+    Pool<Block>& pool_;
+};
+
+class PoolBenchmark {
+public:
+    // Allocation-heavy churn: every thread keeps a small working set and
+    // replaces one block per op, so nearly every op touches the allocator
+    static void benchmark_thread_scaling() {
+        std::cout << "\n=== Allocate/Free Scaling (working set " << WORKING_SET << ") ===" << std::endl;
+        std::cout << std::setw(8) << "Threads"
+                  << std::setw(16) << "Pool (M/s)"
+                  << std::setw(16) << "Cached (M/s)"
+                  << std::setw(10) << "Speedup" << std::endl;
+
+        for (int threads : {1, 2, 4, 8, 16, 32}) {
+            double direct = run<DirectPool>(threads, false);
+            double cached = run<PoolCache<Block>>(threads, true);
+
+            std::cout << std::setw(8) << threads
+                      << std::fixed << std::setprecision(2)
+                      << std::setw(16) << direct / 1e6
+                      << std::setw(16) << cached / 1e6
+                      << std::setw(9) << cached / direct << "x" << std::endl;
+        }
+    }
+
+    // One allocate_n/deallocate_n per batch against one CAS per block
+    static void benchmark_batch() {
+        std::cout << "\n=== Batched allocate_n/deallocate_n (single thread) ===" << std::endl;
+
+        for (size_t batch : {1, 8, 32, 128}) {
+            Memory::unlink("/bench_pool_batch");
+            Memory mem("/bench_pool_batch", 64*1024*1024);
+            Pool<Block> pool(mem, "pool", CAPACITY);
+            std::vector<Block*> ptrs(batch);
+
+            const int rounds = 2000000 / batch;
+            auto start = high_resolution_clock::now();
+            for (int r = 0; r < rounds; r++) {
+                size_t n = pool.allocate_n(ptrs.data(), batch);
+                pool.deallocate_n(ptrs.data(), n);
+            }
+            auto dur_us = duration_cast<microseconds>(high_resolution_clock::now() - start).count();
+
+            std::cout << "Batch " << std::setw(4) << batch << ": "
+                      << std::fixed << std::setprecision(1)
+                      << (rounds * batch * 2.0) / std::max(dur_us, (long)1) << "M ops/sec" << std::endl;
+            Memory::unlink("/bench_pool_batch");
+        }
+    }
+
+private:
+    static constexpr size_t CAPACITY = 65536;
+    static constexpr size_t WORKING_SET = 16;
+    static constexpr int OPS_PER_THREAD = 500000;
+
+    template<typename Allocator>
+    static double run(int threads, bool track_owners) {
+        Memory::unlink("/bench_pool");
+        Memory mem("/bench_pool", 64*1024*1024);
+        Pool<Block> pool(mem, "pool", CAPACITY, PoolLayout::PaddedHead, track_owners);
+
+        std::atomic<bool> go{false};
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; t++) {
+            workers.emplace_back([&] {
+                Allocator alloc(pool);
+                std::vector<Block*> held;
+                for (size_t i = 0; i < WORKING_SET; i++) {
+                    held.push_back(*alloc.allocate());
+                }
+                while (!go.load(std::memory_order_acquire)) {}
+                for (int i = 0; i < OPS_PER_THREAD; i++) {
+                    size_t slot = i % WORKING_SET;
+                    alloc.deallocate(held[slot]);
+                    held[slot] = *alloc.allocate();
+                    held[slot]->bytes[0] = static_cast<char>(i);
+                }
+                for (Block* ptr : held) {
+                    alloc.deallocate(ptr);
+                }
+            });
+        }
+
+        auto start = high_resolution_clock::now();
+        go.store(true, std::memory_order_release);
+        for (auto& w : workers) w.join();
+        auto dur_us = duration_cast<microseconds>(high_resolution_clock::now() - start).count();
+
+        Memory::unlink("/bench_pool");
+        // Count both allocate + deallocate as ops
+        return (threads * OPS_PER_THREAD * 2.0 * 1000000.0) / std::max(dur_us, (long)1);
+    }
+};
+
+int main() {
+    std::cout << "=== ZeroIPC Pool Performance Benchmarks ===" << std::endl;
+    std::cout << "CPU Count: " << std::thread::hardware_concurrency() << std::endl;
+
+    PoolBenchmark::benchmark_thread_scaling();
+    PoolBenchmark::benchmark_batch();
+
+    return 0;
+}
@@ -0,0 +1,198 @@
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <iomanip>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <zeroipc/memory.h>
+#include <zeroipc/array.h>
+#include <zeroipc/mutex.h>
+#include <zeroipc/priority_queue.h>
+
+using namespace zeroipc;
+using namespace std::chrono;
+
+// Baseline: one binary heap in an Array, guarded by a zeroipc Mutex, with
+// the item count kept in slot 0 of a second Array
+class MutexHeap {
+public:
+    using Item = PriorityQueue<int>::Item;
+
+    MutexHeap(Memory& mem, size_t capacity)
+        : heap_(mem, "heap", capacity), count_(mem, "heap_count", 1), mutex_(mem, "heap_mutex") {
+        count_[0] = 0;
+    }
+
+    bool push(uint64_t key, int value) {
+        std::lock_guard<Mutex> lock(mutex_);
+        uint64_t n = count_[0];
+        if (n >= heap_.capacity()) {
+            return false;
+        }
+        heap_[n] = Item{key, value};
+        std::push_heap(heap_.begin(), heap_.begin() + n + 1, greater);
+        count_[0] = n + 1;
+        return true;
+    }
+
+    bool pop_min(Item& out) {
+        std::lock_guard<Mutex> lock(mutex_);
+        uint64_t n = count_[0];
+        if (n == 0) {
+            return false;
+        }
+        std::pop_heap(heap_.begin(), heap_.begin() + n, greater);
+        out = heap_[n - 1];
+        count_[0] = n - 1;
+        return true;
+    }
+
+private:
+    static bool greater(const Item& a, const Item& b) { return a.key > b.key; }
+
+    Array<Item> heap_;
+    Array<uint64_t> count_;
+    Mutex mutex_;
+};
+
+// PriorityQueue behind the same push/pop_min interface, strict or relaxed
+template<bool Relaxed>
+class ShardedHeap {
+public:
+    using Item = PriorityQueue<int>::Item;
+
+    ShardedHeap(Memory& mem, size_t capacity, size_t shards) : pq_(mem, "pq", capacity, shards) {}
+
+    bool push(uint64_t key, int value) { return pq_.push(key, value); }
+
+    bool pop_min(Item& out) {
+        auto item = Relaxed ? pq_.pop_relaxed() : pq_.pop_min();
+        if (!item) {
+            return false;
+        }
+        out = *item;
+        return true;
+    }
+
+private:
+    PriorityQueue<int> pq_;
+};
+
+class PriorityQueueBenchmark {
+public:
+    // Each thread alternates push and pop on a queue pre-filled to half
+    // capacity (the "hold" model for schedulers)
+    static void benchmark_thread_scaling() {
+        std::cout << "\n=== Push/Pop Scaling (hold model, " << PREFILL << " items) ===" << std::endl;
+        std::cout << std::setw(8) << "Threads"
+                  << std::setw(14) << "Mutex heap"
+                  << std::setw(14) << "Strict"
+                  << std::setw(14) << "Relaxed"
+                  << "   (M ops/sec, " << SHARDS << " shards)" << std::endl;
+
+        for (int threads : {1, 2, 4, 8, 16}) {
+            double baseline = run(threads, [](Memory& mem) {
+                return std::make_unique<MutexHeap>(mem, CAPACITY);
+            });
+            double strict = run(threads, [](Memory& mem) {
+                return std::make_unique<ShardedHeap<false>>(mem, CAPACITY, SHARDS);
+            });
+            double relaxed = run(threads, [](Memory& mem) {
+                return std::make_unique<ShardedHeap<true>>(mem, CAPACITY, SHARDS);
+            });
+
+            std::cout << std::setw(8) << threads
+                      << std::fixed << std::setprecision(2)
+                      << std::setw(14) << baseline / 1e6
+                      << std::setw(14) << strict / 1e6
+                      << std::setw(14) << relaxed / 1e6 << std::endl;
+        }
+    }
+
+    // Consumer draining by batch against one pop_min per item
+    static void benchmark_batch_pop() {
+        std::cout << "\n=== Batch Pop (single thread) ===" << std::endl;
+
+        for (size_t batch : {1, 8, 32, 128}) {
+            Memory::unlink("/bench_pq_batch");
+            Memory mem("/bench_pq_batch", 64*1024*1024);
+            PriorityQueue<int> pq(mem, "pq", CAPACITY, SHARDS);
+            std::vector<PriorityQueue<int>::Item> out(batch);
+
+            const int rounds = 20;
+            size_t popped = 0;
+            uint64_t key = 0;
+            auto start = high_resolution_clock::now();
+            for (int r = 0; r < rounds; r++) {
+                for (size_t i = 0; i < CAPACITY / 2; i++) {
+                    (void)pq.push((key++ * 2654435761u) % 1000003, 0);
+                }
+                size_t n;
+                while ((n = pq.pop_bulk(out.data(), batch)) > 0) {
+                    popped += n;
+                }
+            }
+            auto dur_us = duration_cast<microseconds>(high_resolution_clock::now() - start).count();
+
+            std::cout << "Batch " << std::setw(4) << batch << ": "
+                      << std::fixed << std::setprecision(1)
+                      << (popped * 2.0) / std::max(dur_us, (long)1) << "M ops/sec" << std::endl;
+            Memory::unlink("/bench_pq_batch");
+        }
+    }
+
+private:
+    static constexpr size_t SHARDS = 16;
+    static constexpr size_t CAPACITY = 65536;
+    static constexpr size_t PREFILL = CAPACITY / 2;
+    static constexpr int OPS_PER_THREAD = 200000;
+
+    template<typename Make>
+    static double run(int threads, Make make) {
+        Memory::unlink("/bench_pq");
+        Memory mem("/bench_pq", 64*1024*1024);
+        auto heap = make(mem);
+        using Item = PriorityQueue<int>::Item;
+
+        for (size_t i = 0; i < PREFILL; i++) {
+            (void)heap->push((i * 2654435761u) % 1000003, 0);
+        }
+
+        std::atomic<bool> go{false};
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; t++) {
+            workers.emplace_back([&, t] {
+                uint64_t key = t * 7919;
+                Item item;
+                while (!go.load(std::memory_order_acquire)) {}
+                for (int i = 0; i < OPS_PER_THREAD; i++) {
+                    key = (key * 2654435761u + 1) % 1000003;
+                    (void)heap->push(key, i);
+                    (void)heap->pop_min(item);
+                }
+            });
+        }
+
+        auto start = high_resolution_clock::now();
+        go.store(true, std::memory_order_release);
+        for (auto& w : workers) w.join();
+        auto dur_us = duration_cast<microseconds>(high_resolution_clock::now() - start).count();
+
+        Memory::unlink("/bench_pq");
+        // Count both push + pop as ops
+        return (threads * OPS_PER_THREAD * 2.0 * 1000000.0) / std::max(dur_us, (long)1);
+    }
+};
+
+int main() {
+    std::cout << "=== ZeroIPC PriorityQueue Performance Benchmarks ===" << std::endl;
+    std::cout << "CPU Count: " << std::thread::hardware_concurrency() << std::endl;
+
+    PriorityQueueBenchmark::benchmark_thread_scaling();
+    PriorityQueueBenchmark::benchmark_batch_pop();
+
+    return 0;
+}
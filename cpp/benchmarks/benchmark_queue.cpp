@@ -20,7 +20,7 @@ public:
             return [=](auto dummy) {
                 using T = decltype(dummy);
                 Memory::unlink("/bench_q_st");
-                Memory mem("/bench_q_st", 512*1024*1024);
+                Memory mem("/bench_q_st", 640*1024*1024);  // 4KB x 2^17 slots
                 Queue<T> queue(mem, "q", 100000);
 
                 T value{};
@@ -221,6 +221,54 @@ public:
         }
     }
 
+    // Split vs interleaved slots for small elements: a large queue kept half
+    // full so the slots being touched are cold, 2 producers + 2 consumers.
+    static void benchmark_layouts() {
+        std::cout << "\n=== Queue Slot Layouts (int, 2P/2C) ===" << std::endl;
+
+        auto run = [](const char* label, QueueLayout layout) {
+            Memory::unlink("/bench_q_layout");
+            Memory mem("/bench_q_layout", 256*1024*1024);
+            Queue<int> queue(mem, "q", 1 << 20, layout);
+            for (int i = 0; i < (1 << 19); i++) {
+                (void)queue.push(i);
+            }
+
+            const int ops_per_thread = 1000000;
+            std::atomic<bool> go{false};
+            std::vector<std::thread> threads;
+            for (int t = 0; t < 4; t++) {
+                threads.emplace_back([&, t]() {
+                    while (!go.load(std::memory_order_acquire)) {}
+                    for (int j = 0; j < ops_per_thread; j++) {
+                        if (t % 2 == 0) {
+                            while (!queue.push(j)) std::this_thread::yield();
+                        } else {
+                            while (!queue.pop()) std::this_thread::yield();
+                        }
+                    }
+                });
+            }
+
+            auto start = high_resolution_clock::now();
+            go.store(true, std::memory_order_release);
+            for (auto& t : threads) t.join();
+            auto dur_us = duration_cast<microseconds>(high_resolution_clock::now() - start).count();
+
+            std::cout << std::setw(20) << label << ": " << std::fixed << std::setprecision(1)
+                      << (4.0 * ops_per_thread) / std::max(dur_us, (long)1) << "M ops/sec"
+                      << std::endl;
+            Memory::unlink("/bench_q_layout");
+        };
+
+        run("split", QueueLayout::Split);
+        run("interleaved", QueueLayout::Interleaved);
+        run("interleaved+padded", QueueLayout::InterleavedPadded);
+        run("split+padded header", QueueLayout::Split | QueueLayout::PaddedHeader);
+        run("interleaved+padded+padded header",
+            QueueLayout::InterleavedPadded | QueueLayout::PaddedHeader);
+    }
+
 private:
     static void print_latency_stats(const std::string& op, std::vector<double>& latencies) {
         std::sort(latencies.begin(), latencies.end());
@@ -247,6 +295,7 @@ int main() {
     QueueBenchmark::benchmark_latency();
     QueueBenchmark::benchmark_concurrent_throughput();
     QueueBenchmark::benchmark_contention();
+    QueueBenchmark::benchmark_layouts();
 
     return 0;
 }
@@ -0,0 +1,185 @@
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <iomanip>
+#include <algorithm>
+#include <mutex>
+#include <zeroipc/memory.h>
+#include <zeroipc/array.h>
+#include <zeroipc/mutex.h>
+#include <zeroipc/rwlock.h>
+#include <zeroipc/biased_rwlock.h>
+
+using namespace zeroipc;
+using namespace std::chrono;
+
+// Baseline: readers and writers both take one zeroipc Mutex
+class MutexGuarded {
+public:
+    explicit MutexGuarded(Memory& mem) : mutex_(mem, "bench_mutex") {}
+
+    uint32_t read_lock() { mutex_.lock(); return 0; }
+    void read_unlock(uint32_t) { mutex_.unlock(); }
+    void write_lock() { mutex_.lock(); }
+    void write_unlock() { mutex_.unlock(); }
+
+private:
+    Mutex mutex_;
+};
+
+class RWLockGuarded {
+public:
+    explicit RWLockGuarded(Memory& mem) : rwlock_(mem, "bench_rwlock") {}
+
+    uint32_t read_lock() { rwlock_.reader_lock(); return 0; }
+    void read_unlock(uint32_t) { rwlock_.reader_unlock(); }
+    void write_lock() { rwlock_.writer_lock(); }
+    void write_unlock() { rwlock_.writer_unlock(); }
+
+private:
+    RWLock rwlock_;
+};
+
+class BiasedGuarded {
+public:
+    explicit BiasedGuarded(Memory& mem) : lock_(mem, "bench_biased") {}
+
+    uint32_t read_lock() { return lock_.reader_lock(); }
+    void read_unlock(uint32_t token) { lock_.reader_unlock(token); }
+    void write_lock() { lock_.writer_lock(); }
+    void write_unlock() { lock_.writer_unlock(); }
+
+private:
+    BiasedRWLock lock_;
+};
+
+class RWLockBenchmark {
+public:
+    // Readers only: the lock word is the only shared write (for
+    // BiasedRWLock, each CPU writes only its own slot)
+    static void benchmark_reader_scaling() {
+        std::cout << "\n=== Reader Scaling (no writers) ===" << std::endl;
+        print_header();
+        for (int threads : {1, 2, 4, 8, 16}) {
+            print_row(threads,
+                      run<MutexGuarded>(threads, 0),
+                      run<RWLockGuarded>(threads, 0),
+                      run<BiasedGuarded>(threads, 0));
+        }
+    }
+
+    // One write in every WRITE_EVERY critical sections
+    static void benchmark_read_mostly() {
+        std::cout << "\n=== Read-Mostly (1 write per " << WRITE_EVERY << " ops) ===" << std::endl;
+        print_header();
+        for (int threads : {1, 2, 4, 8, 16}) {
+            print_row(threads,
+                      run<MutexGuarded>(threads, WRITE_EVERY),
+                      run<RWLockGuarded>(threads, WRITE_EVERY),
+                      run<BiasedGuarded>(threads, WRITE_EVERY));
+        }
+    }
+
+    // Uncontended lock/unlock pair latency
+    static void benchmark_uncontended() {
+        std::cout << "\n=== Uncontended Latency (single thread) ===" << std::endl;
+        Memory::unlink("/bench_rwlock");
+        Memory mem("/bench_rwlock", 1024*1024);
+        RWLock rwlock(mem, "bench_rwlock");
+
+        const int iterations = 10000000;
+        auto start = high_resolution_clock::now();
+        for (int i = 0; i < iterations; i++) {
+            rwlock.reader_lock();
+            rwlock.reader_unlock();
+        }
+        auto read_ns = duration_cast<nanoseconds>(high_resolution_clock::now() - start).count();
+
+        start = high_resolution_clock::now();
+        for (int i = 0; i < iterations; i++) {
+            rwlock.writer_lock();
+            rwlock.writer_unlock();
+        }
+        auto write_ns = duration_cast<nanoseconds>(high_resolution_clock::now() - start).count();
+
+        std::cout << std::fixed << std::setprecision(1)
+                  << "reader lock+unlock: " << double(read_ns) / iterations << " ns" << std::endl
+                  << "writer lock+unlock: " << double(write_ns) / iterations << " ns" << std::endl;
+        Memory::unlink("/bench_rwlock");
+    }
+
+private:
+    static constexpr int OPS_PER_THREAD = 500000;
+    static constexpr int WRITE_EVERY = 100;
+    static constexpr size_t DATA_SIZE = 64;
+
+    static void print_header() {
+        std::cout << std::setw(8) << "Threads"
+                  << std::setw(14) << "Mutex"
+                  << std::setw(14) << "RWLock"
+                  << std::setw(14) << "Biased"
+                  << "   (M ops/sec)" << std::endl;
+    }
+
+    static void print_row(int threads, double mutex, double rwlock, double biased) {
+        std::cout << std::setw(8) << threads
+                  << std::fixed << std::setprecision(2)
+                  << std::setw(14) << mutex / 1e6
+                  << std::setw(14) << rwlock / 1e6
+                  << std::setw(14) << biased / 1e6 << std::endl;
+    }
+
+    // Each thread runs OPS_PER_THREAD critical sections that read a small
+    // array; every write_every-th one (if nonzero) is a write instead
+    template<typename Lock>
+    static double run(int threads, int write_every) {
+        Memory::unlink("/bench_rwlock");
+        Memory mem("/bench_rwlock", 1024*1024);
+        Lock lock(mem);
+        Array<uint64_t> data(mem, "bench_data", DATA_SIZE);
+        data.fill(1);
+
+        std::atomic<bool> go{false};
+        std::atomic<uint64_t> checksum{0};
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; t++) {
+            workers.emplace_back([&, t] {
+                uint64_t local = 0;
+                while (!go.load(std::memory_order_acquire)) {}
+                for (int i = 0; i < OPS_PER_THREAD; i++) {
+                    if (write_every && (i + t) % write_every == 0) {
+                        lock.write_lock();
+                        data[i % DATA_SIZE]++;
+                        lock.write_unlock();
+                    } else {
+                        auto token = lock.read_lock();
+                        local += data[i % DATA_SIZE];
+                        lock.read_unlock(token);
+                    }
+                }
+                checksum.fetch_add(local, std::memory_order_relaxed);
+            });
+        }
+
+        auto start = high_resolution_clock::now();
+        go.store(true, std::memory_order_release);
+        for (auto& w : workers) w.join();
+        auto dur_us = duration_cast<microseconds>(high_resolution_clock::now() - start).count();
+
+        Memory::unlink("/bench_rwlock");
+        return (threads * OPS_PER_THREAD * 1000000.0) / std::max(dur_us, (long)1);
+    }
+};
+
+int main() {
+    std::cout << "=== ZeroIPC RWLock Performance Benchmarks ===" << std::endl;
+    std::cout << "CPU Count: " << std::thread::hardware_concurrency() << std::endl;
+
+    RWLockBenchmark::benchmark_uncontended();
+    RWLockBenchmark::benchmark_reader_scaling();
+    RWLockBenchmark::benchmark_read_mostly();
+
+    return 0;
+}
@@ -0,0 +1,228 @@
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <iomanip>
+#include <algorithm>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <zeroipc/array.h>
+#include <zeroipc/memory.h>
+#include <zeroipc/queue.h>
+#include <zeroipc/sharded_queue.h>
+
+using namespace zeroipc;
+using namespace std::chrono;
+
+class ShardedQueueBenchmark {
+public:
+    // Producer scaling, 1 to 64 producers against a fixed consumer pool.
+    // Queue<T> serializes every producer on one tail CAS; ShardedQueue<T>
+    // gives each producer thread its own lane.
+    static void benchmark_producer_scaling() {
+        std::cout << "\n=== Producer Scaling: Queue vs ShardedQueue ===" << std::endl;
+        std::cout << "Consumers: " << CONSUMERS
+                  << ", lanes: " << LANES
+                  << ", items: " << TOTAL_ITEMS << std::endl;
+        std::cout << std::setw(10) << "Producers"
+                  << std::setw(16) << "Queue (M/s)"
+                  << std::setw(16) << "Sharded (M/s)"
+                  << std::setw(10) << "Speedup" << std::endl;
+
+        for (int producers : {1, 2, 4, 8, 16, 32, 64}) {
+            double single = run<Queue<int>>(producers, [](Memory& mem) {
+                return Queue<int>(mem, "q", CAPACITY);
+            });
+            double sharded = run<ShardedQueue<int>>(producers, [](Memory& mem) {
+                return ShardedQueue<int>(mem, "q", CAPACITY, LANES);
+            });
+
+            std::cout << std::setw(10) << producers
+                      << std::setw(16) << std::fixed << std::setprecision(2) << single / 1e6
+                      << std::setw(16) << sharded / 1e6
+                      << std::setw(9) << std::setprecision(2) << sharded / single << "x"
+                      << std::endl;
+        }
+    }
+
+    // The same curve with every producer in its own process: the case
+    // ShardedQueue<T> is for, where each process's first thread needs a
+    // lane of its own
+    static void benchmark_process_scaling() {
+        std::cout << "\n=== Producer Process Scaling: Queue vs ShardedQueue ===" << std::endl;
+        std::cout << "Consumer threads: " << CONSUMERS
+                  << ", lanes: " << LANES
+                  << ", items: " << TOTAL_ITEMS << std::endl;
+        std::cout << std::setw(10) << "Processes"
+                  << std::setw(16) << "Queue (M/s)"
+                  << std::setw(16) << "Sharded (M/s)"
+                  << std::setw(10) << "Speedup" << std::endl;
+
+        for (int processes : {1, 2, 4, 8, 16}) {
+            double single = run_processes<Queue<int>>(processes, [](Memory& mem) {
+                return Queue<int>(mem, "q", CAPACITY);
+            });
+            double sharded = run_processes<ShardedQueue<int>>(processes, [](Memory& mem) {
+                return ShardedQueue<int>(mem, "q", CAPACITY, LANES);
+            });
+
+            std::cout << std::setw(10) << processes
+                      << std::setw(16) << std::fixed << std::setprecision(2) << single / 1e6
+                      << std::setw(16) << sharded / 1e6
+                      << std::setw(9) << std::setprecision(2) << sharded / single << "x"
+                      << std::endl;
+        }
+    }
+
+    // Consumer batch draining against one-at-a-time pops
+    static void benchmark_batch_drain() {
+        std::cout << "\n=== ShardedQueue Batch Drain (single thread) ===" << std::endl;
+
+        for (size_t batch : {1, 8, 32, 128}) {
+            Memory::unlink("/bench_sq_batch");
+            Memory mem("/bench_sq_batch", 64*1024*1024);
+            ShardedQueue<int> queue(mem, "q", CAPACITY, LANES);
+
+            const int rounds = 200;
+            std::vector<int> out(batch);
+            size_t popped = 0;
+
+            auto start = high_resolution_clock::now();
+            for (int r = 0; r < rounds; r++) {
+                for (size_t i = 0; i < CAPACITY; i++) {
+                    (void)queue.push_to(i, static_cast<int>(i));
+                }
+                size_t n;
+                while ((n = queue.pop_bulk(out.data(), batch)) > 0) {
+                    popped += n;
+                }
+            }
+            auto dur_us = duration_cast<microseconds>(high_resolution_clock::now() - start).count();
+
+            std::cout << "Batch " << std::setw(4) << batch << ": "
+                      << std::fixed << std::setprecision(1)
+                      << (popped * 2.0) / std::max(dur_us, (long)1) << "M ops/sec" << std::endl;
+            Memory::unlink("/bench_sq_batch");
+        }
+    }
+
+private:
+    static constexpr int CONSUMERS = 4;
+    static constexpr size_t LANES = 16;
+    static constexpr size_t CAPACITY = 65536;
+    static constexpr int TOTAL_ITEMS = 2000000;
+
+    template<typename Q, typename Make>
+    static double run(int producers, Make make) {
+        Memory::unlink("/bench_sq");
+        Memory mem("/bench_sq", 64*1024*1024);
+        Q queue = make(mem);
+
+        const int per_producer = TOTAL_ITEMS / producers;
+        const int total = per_producer * producers;
+        std::atomic<int> consumed{0};
+        std::atomic<bool> go{false};
+
+        std::vector<std::thread> threads;
+        for (int p = 0; p < producers; p++) {
+            threads.emplace_back([&] {
+                while (!go.load(std::memory_order_acquire)) {}
+                for (int j = 0; j < per_producer; j++) {
+                    while (!queue.push(j)) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        for (int c = 0; c < CONSUMERS; c++) {
+            threads.emplace_back([&] {
+                while (!go.load(std::memory_order_acquire)) {}
+                while (consumed.load(std::memory_order_relaxed) < total) {
+                    if (queue.pop()) {
+                        consumed.fetch_add(1, std::memory_order_relaxed);
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+
+        auto start = high_resolution_clock::now();
+        go.store(true, std::memory_order_release);
+        for (auto& t : threads) t.join();
+        auto dur_us = duration_cast<microseconds>(high_resolution_clock::now() - start).count();
+
+        Memory::unlink("/bench_sq");
+        // Count both push + pop as ops
+        return (total * 2.0 * 1000000.0) / std::max(dur_us, (long)1);
+    }
+
+    // Forked producer processes (each opening the queue by name) against
+    // consumer threads in this process
+    template<typename Q, typename Make>
+    static double run_processes(int processes, Make make) {
+        Memory::unlink("/bench_sq_proc");
+        Memory mem("/bench_sq_proc", 64*1024*1024);
+        Array<uint32_t> go_flag(mem, "go", 1);
+        Q queue = make(mem);
+
+        const int per_producer = TOTAL_ITEMS / processes;
+        const int total = per_producer * processes;
+
+        std::vector<pid_t> children;
+        for (int p = 0; p < processes; p++) {
+            pid_t pid = fork();
+            if (pid == 0) {
+                Memory child_mem("/bench_sq_proc");
+                Array<uint32_t> child_go(child_mem, "go");
+                Q child_queue(child_mem, "q");
+                std::atomic_ref<uint32_t> go(child_go[0]);
+                while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+                for (int j = 0; j < per_producer; j++) {
+                    while (!child_queue.push(j)) {
+                        std::this_thread::yield();
+                    }
+                }
+                _exit(0);
+            }
+            children.push_back(pid);
+        }
+
+        std::atomic<int> consumed{0};
+        std::vector<std::thread> threads;
+        for (int c = 0; c < CONSUMERS; c++) {
+            threads.emplace_back([&] {
+                while (consumed.load(std::memory_order_relaxed) < total) {
+                    if (queue.pop()) {
+                        consumed.fetch_add(1, std::memory_order_relaxed);
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+
+        auto start = high_resolution_clock::now();
+        std::atomic_ref<uint32_t>(go_flag[0]).store(1, std::memory_order_release);
+        for (auto& t : threads) t.join();
+        auto dur_us = duration_cast<microseconds>(high_resolution_clock::now() - start).count();
+        for (pid_t pid : children) {
+            waitpid(pid, nullptr, 0);
+        }
+
+        Memory::unlink("/bench_sq_proc");
+        return (total * 2.0 * 1000000.0) / std::max(dur_us, (long)1);
+    }
+};
+
+int main() {
+    std::cout << "=== ZeroIPC ShardedQueue Performance Benchmarks ===" << std::endl;
+    std::cout << "CPU Count: " << std::thread::hardware_concurrency() << std::endl;
+
+    ShardedQueueBenchmark::benchmark_producer_scaling();
+    ShardedQueueBenchmark::benchmark_process_scaling();
+    ShardedQueueBenchmark::benchmark_batch_drain();
+
+    return 0;
+}
@@ -183,7 +183,67 @@ public:
         Memory::unlink("/bench_s_lifo");
     }
 
+    // Free-buffer recycling: every thread pushes then pops in a tight loop on
+    // a small stack, so all operations collide on top. Lost CASes fall back
+    // to the elimination slots, where a push and a pop pair off directly.
+    // Push-only runs have nobody to pair with, so their offers only cost
+    // time; both are measured against a stack without elimination.
+    static void benchmark_contention() {
+        std::cout << "\n=== Stack Contention ===" << std::endl;
+
+        for (bool push_only : {false, true}) {
+            for (bool elimination : {true, false}) {
+                std::cout << (push_only ? "Push only" : "Symmetric push/pop pairs")
+                         << (elimination ? ", elimination" : ", no elimination") << std::endl;
+                for (int num_threads : {1, 2, 4, 8, 16, 32}) {
+                    run_contention(num_threads, push_only, elimination);
+                }
+            }
+        }
+    }
+
 private:
+    static void run_contention(int num_threads, bool push_only, bool elimination) {
+        const int ops_per_thread = 200000;
+        Memory::unlink("/bench_s_cont");
+        Memory mem("/bench_s_cont", 128*1024*1024);
+        // Push-only threads need room for every value they push
+        size_t capacity = push_only ? size_t(num_threads) * ops_per_thread : 1024;
+        Stack<int> stack(mem, "s", capacity, StackLayout::PaddedTop, elimination);
+
+        std::atomic<long> successful{0};
+        std::atomic<bool> go{false};
+
+        std::vector<std::thread> threads;
+        for (int i = 0; i < num_threads; i++) {
+            threads.emplace_back([&, i]() {
+                long ok = 0;
+                while (!go.load(std::memory_order_acquire)) {}
+                for (int j = 0; j < ops_per_thread; j++) {
+                    ok += stack.push(i * ops_per_thread + j);
+                    if (!push_only) {
+                        ok += stack.pop().has_value();
+                    }
+                }
+                successful.fetch_add(ok, std::memory_order_relaxed);
+            });
+        }
+
+        auto start = high_resolution_clock::now();
+        go.store(true, std::memory_order_release);
+        for (auto& t : threads) t.join();
+        auto dur_us = duration_cast<microseconds>(high_resolution_clock::now() - start).count();
+
+        long succ = successful.load();
+        double attempted = (push_only ? 1.0 : 2.0) * num_threads * ops_per_thread;
+        std::cout << "Threads: " << std::setw(2) << num_threads
+                 << " - " << std::fixed << std::setprecision(1)
+                 << (succ * 1.0) / std::max(dur_us, (long)1) << "M ops/sec"
+                 << " - Success: " << (succ * 100.0) / attempted << "%" << std::endl;
+
+        Memory::unlink("/bench_s_cont");
+    }
+
     static void print_latency_stats(const std::string& op, std::vector<double>& lat) {
         std::sort(lat.begin(), lat.end());
         double sum = 0;
@@ -207,6 +267,7 @@ int main() {
     StackBenchmark::benchmark_latency();
     StackBenchmark::benchmark_concurrent();
     StackBenchmark::benchmark_lifo_pattern();
+    StackBenchmark::benchmark_contention();
 
     return 0;
 }
@@ -1,10 +1,18 @@
 #pragma once
 
 #include <zeroipc/memory.h>
+#include <zeroipc/detail/parallel.h>
+#include <algorithm>
+#include <atomic>
+#include <concepts>
 #include <type_traits>
 #include <stdexcept>
 #include <string_view>
 #include <cstring>
+#include <limits>
+#include <optional>
+#include <thread>
+#include <vector>
 
 namespace zeroipc {
 
@@ -15,26 +23,58 @@ namespace zeroipc {
  * 
  * The array stores only its capacity in the header.
  * No type information is stored - users are responsible for type consistency.
+ *
+ * Bulk operations (fill, copy_from, transform, reduce, sum/min/max,
+ * histogram, find) take a thread count: 1 runs on the caller, 0 uses one
+ * thread per hardware thread, and the array is split into contiguous
+ * chunks on cache-line boundaries. Their inner loops are written so the
+ * compiler can vectorize them for arithmetic T (several independent
+ * accumulators, no early exit inside a block).
+ *
+ * When T is lock-free as a std::atomic_ref and its alignment meets the
+ * atomic requirement, elements can also be accessed atomically in place
+ * (atomic_load, fetch_add, compare_exchange, ...), so shared counters need
+ * no separate lock.
+ *
+ * An array created with a version_block is versioned: every version_block
+ * elements share a seqlock word, stored after the data. write_region updates
+ * a range under the seqlocks of the blocks it covers, and read_region copies
+ * a range that no writer touched while it was being read, retrying
+ * otherwise, so readers see whole multi-element updates without ever
+ * blocking the writer. (operator[] and the other accessors bypass the
+ * seqlocks.) A version_block equal to the capacity gives a single
+ * whole-array generation.
+ *
+ * @layout [Header(8)][pad][T * capacity]
+ *         versioned only: [pad to 64][VersionHeader(16) | pad to 64][u64 seq * blocks]
  */
 template<typename T>
 class Array {
     static_assert(std::is_trivially_copyable_v<T>,
                   "Array elements must be trivially copyable");
     static_assert(alignof(T) <= MAX_ELEM_ALIGN,
-                  "T alignment exceeds the 8-byte guarantee of shared memory layout");
+                  "T alignment exceeds the largest supported allocation alignment");
     
 public:
     struct Header {
         uint64_t capacity;
     };
     
+    // Data starts on the section alignment (8 for ordinary types, so the
+    // layout is [Header(8)][data]).
+    static constexpr size_t ALIGN = section_align<T>();
+    static constexpr size_t DATA_OFFSET = align_up(sizeof(Header), ALIGN);
+    
     /**
      * Create or open an array
      * @param memory Shared memory instance
      * @param name Name of the array
      * @param capacity Number of elements (0 to open existing)
+     * @param version_block Elements per seqlock block, 0 for a plain array
+     *        (when opening, non-zero requires a matching versioned array)
      */
-    Array(Memory& memory, std::string_view name, size_t capacity = 0)
+    Array(Memory& memory, std::string_view name, size_t capacity = 0,
+          size_t version_block = 0)
         : memory_(memory) {
         
         if (name.size() >= 32) {
@@ -45,6 +85,13 @@ public:
         
         if (entry) {
             // Open existing array
+            if (entry->section_align() != ALIGN) {
+                throw std::runtime_error(
+                    "Alignment mismatch: array has " +
+                    std::to_string(entry->section_align()) +
+                    " but type requires " + std::to_string(ALIGN));
+            }
+            
             if (capacity != 0) {
                 // Optionally validate capacity if provided
                 Header* hdr = static_cast<Header*>(memory.at(entry->offset));
@@ -58,34 +105,59 @@ public:
             
             offset_ = entry->offset;
             header_ = static_cast<Header*>(memory.at(offset_));
-            data_ = static_cast<T*>(memory.at(offset_ + sizeof(Header)));
+            data_ = static_cast<T*>(memory.at(offset_ + DATA_OFFSET));
             capacity_ = header_->capacity;
             name_ = name;
+
+            size_t voff = versions_offset(capacity_);
+            if (entry->size >= voff + VERSIONS_SEQ_OFFSET) {
+                bind_versions(voff);
+                if (block_ == 0 || version_blocks() * sizeof(uint64_t) >
+                                   entry->size - voff - VERSIONS_SEQ_OFFSET) {
+                    throw std::runtime_error("Array version header is corrupt");
+                }
+            }
+            if (version_block != 0 && version_block != block_) {
+                throw std::runtime_error("Array version block mismatch");
+            }
         } else {
             // Create new array
             if (capacity == 0) {
                 throw std::invalid_argument("Capacity required to create new array");
             }
             
-            size_t total_size = sizeof(Header) + capacity * sizeof(T);
-            offset_ = memory.table()->allocate(total_size);
-            
-            if (!memory.table()->add(name, offset_, total_size)) {
-                throw std::runtime_error("Failed to add array to table");
+            size_t total_size = DATA_OFFSET + capacity * sizeof(T);
+            if (version_block != 0) {
+                version_block = std::min(version_block, capacity);
+                size_t blocks = (capacity + version_block - 1) / version_block;
+                total_size = versions_offset(capacity) + VERSIONS_SEQ_OFFSET +
+                             blocks * sizeof(uint64_t);
             }
+            offset_ = memory.allocate(name, total_size, ALIGN);
             
             // Initialize header
             header_ = static_cast<Header*>(memory.at(offset_));
             header_->capacity = capacity;
             
             // Get data pointer
-            data_ = static_cast<T*>(memory.at(offset_ + sizeof(Header)));
+            data_ = static_cast<T*>(memory.at(offset_ + DATA_OFFSET));
             
             // Zero-initialize elements
             std::memset(data_, 0, capacity * sizeof(T));
             
             capacity_ = capacity;
             name_ = name;
+
+            if (version_block != 0) {
+                size_t voff = versions_offset(capacity);
+                auto* vh = static_cast<VersionHeader*>(memory.at(offset_ + voff));
+                vh->block = version_block;
+                vh->reserved = 0;
+                bind_versions(voff);
+                for (size_t b = 0; b < version_blocks(); ++b) {
+                    versions_[b].store(0, std::memory_order_relaxed);
+                }
+            }
         }
     }
     
@@ -123,6 +195,157 @@ public:
         return data_[index];
     }
     
+    /**
+     * Whether elements support the atomic operations below
+     */
+    static constexpr bool atomic_elements =
+        std::atomic_ref<T>::is_always_lock_free &&
+        alignof(T) >= std::atomic_ref<T>::required_alignment;
+
+    /**
+     * Atomic access to one element, bounds-checked like at()
+     */
+    [[nodiscard]] T atomic_load(size_t index,
+                                std::memory_order order = std::memory_order_seq_cst) const
+        requires atomic_elements {
+        return std::atomic_ref<T>(data_[checked(index)]).load(order);
+    }
+
+    void atomic_store(size_t index, T value,
+                      std::memory_order order = std::memory_order_seq_cst)
+        requires atomic_elements {
+        std::atomic_ref<T>(data_[checked(index)]).store(value, order);
+    }
+
+    T fetch_add(size_t index, T delta,
+                std::memory_order order = std::memory_order_seq_cst)
+        requires atomic_elements && std::is_arithmetic_v<T> {
+        return std::atomic_ref<T>(data_[checked(index)]).fetch_add(delta, order);
+    }
+
+    T fetch_or(size_t index, T mask,
+               std::memory_order order = std::memory_order_seq_cst)
+        requires atomic_elements && std::is_integral_v<T> {
+        return std::atomic_ref<T>(data_[checked(index)]).fetch_or(mask, order);
+    }
+
+    // Strong CAS; on failure expected receives the current value
+    bool compare_exchange(size_t index, T& expected, T desired,
+                          std::memory_order order = std::memory_order_seq_cst)
+        requires atomic_elements {
+        return std::atomic_ref<T>(data_[checked(index)]).compare_exchange_strong(
+            expected, desired, order);
+    }
+
+    /**
+     * Scatter-add: data[indices[i]] += deltas[i] for i < count, each add
+     * atomic. The updates are sorted by index first, so each cache line is
+     * pulled in once per batch, and deltas to the same element are combined
+     * into one atomic add. All indices are checked before any add is made.
+     */
+    void fetch_add_many(const size_t* indices, const T* deltas, size_t count,
+                        std::memory_order order = std::memory_order_relaxed)
+        requires atomic_elements && std::is_arithmetic_v<T> {
+        std::vector<std::pair<size_t, T>> updates(count);
+        for (size_t i = 0; i < count; ++i) {
+            updates[i] = {checked(indices[i]), deltas[i]};
+        }
+        std::sort(updates.begin(), updates.end(),
+                  [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        for (size_t i = 0; i < count;) {
+            size_t index = updates[i].first;
+            T delta = updates[i].second;
+            while (++i < count && updates[i].first == index) {
+                delta += updates[i].second;
+            }
+            std::atomic_ref<T>(data_[index]).fetch_add(delta, order);
+        }
+    }
+
+    /**
+     * Whether the array was created with seqlock versioning
+     */
+    [[nodiscard]] bool versioned() const { return versions_ != nullptr; }
+    [[nodiscard]] size_t version_block() const { return block_; }
+
+    /**
+     * Copy count elements from src to [first, first + count) as one update:
+     * readers of any overlapping range see all of it or none of it. Writers
+     * of overlapping ranges serialize on the block seqlocks (taken in
+     * ascending order, so they cannot deadlock).
+     */
+    void write_region(size_t first, const T* src, size_t count) {
+        update_region(first, count, [&](T* dst) {
+            std::memcpy(dst, src, count * sizeof(T));
+        });
+    }
+
+    /**
+     * Like write_region, but fn(T* region) edits the range in place
+     */
+    template<typename F>
+    void update_region(size_t first, size_t count, F&& fn) {
+        check_region(first, count);
+        if (count == 0) return;
+        size_t b0 = first / block_, b1 = (first + count - 1) / block_;
+        for (size_t b = b0; b <= b1; ++b) {
+            lock_version(b);
+        }
+        fn(data_ + first);
+        for (size_t b = b0; b <= b1; ++b) {
+            versions_[b].fetch_add(1, std::memory_order_release);  // Even again
+        }
+    }
+
+    /**
+     * Copy [first, first + count) to out as it was between two writes.
+     * Never blocks writers; retries while a write overlaps the copy, and
+     * returns false if no clean copy was possible within READ_ATTEMPTS
+     * (a writer that died mid-update leaves its blocks locked).
+     */
+    [[nodiscard]] bool read_region(size_t first, T* out, size_t count) const {
+        check_region(first, count);
+        if (count == 0) return true;
+        size_t b0 = first / block_, b1 = (first + count - 1) / block_;
+        uint64_t seen[MAX_STACK_BLOCKS];
+        std::vector<uint64_t> seen_heap;
+        uint64_t* before = seen;
+        if (b1 - b0 + 1 > MAX_STACK_BLOCKS) {
+            seen_heap.resize(b1 - b0 + 1);
+            before = seen_heap.data();
+        }
+
+        for (int attempt = 0; attempt < READ_ATTEMPTS; ++attempt) {
+            bool stable = true;
+            for (size_t b = b0; b <= b1 && stable; ++b) {
+                before[b - b0] = versions_[b].load(std::memory_order_acquire);
+                stable = (before[b - b0] & 1) == 0;
+            }
+            if (stable) {
+                std::memcpy(out, data_ + first, count * sizeof(T));
+                std::atomic_thread_fence(std::memory_order_acquire);
+                for (size_t b = b0; b <= b1 && stable; ++b) {
+                    stable = versions_[b].load(std::memory_order_relaxed) == before[b - b0];
+                }
+                if (stable) {
+                    return true;
+                }
+            }
+            if (attempt >= SPIN_ATTEMPTS) {
+                std::this_thread::yield();
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Consistent copy of the whole array
+     */
+    [[nodiscard]] bool snapshot(T* out) const {
+        return read_region(0, out, capacity_);
+    }
+
     /**
      * Get pointer to data
      */
@@ -150,18 +373,246 @@ public:
     /**
      * Fill array with value
      */
-    void fill(const T& value) {
-        for (size_t i = 0; i < capacity_; ++i) {
-            data_[i] = value;
+    void fill(const T& value, unsigned threads = 1) {
+        for_chunks(threads, [&](size_t begin, size_t end, unsigned) {
+            std::fill(data_ + begin, data_ + end, value);
+        });
+    }
+
+    /**
+     * Copy count elements from src into the array starting at offset
+     */
+    void copy_from(const T* src, size_t count, size_t offset = 0, unsigned threads = 1) {
+        if (offset > capacity_ || count > capacity_ - offset) {
+            throw std::out_of_range("copy_from range exceeds array capacity");
         }
+        T* dst = data_ + offset;
+        detail::parallel_chunks(count, resolve(threads, count), GRANULE,
+            [&](size_t begin, size_t end, unsigned) {
+                std::memcpy(dst + begin, src + begin, (end - begin) * sizeof(T));
+            });
+    }
+
+    /**
+     * Replace every element x with f(x). f must be safe to call from
+     * several threads at once when threads != 1.
+     */
+    template<typename F>
+    void transform(F f, unsigned threads = 1) {
+        for_chunks(threads, [&](size_t begin, size_t end, unsigned) {
+            for (size_t i = begin; i < end; ++i) {
+                data_[i] = f(data_[i]);
+            }
+        });
+    }
+
+    /**
+     * Fold all elements with op. init must be an identity of op (0 for +)
+     * since every accumulator starts from it, and op must be associative
+     * and commutative: elements are folded in interleaved lanes and chunks.
+     */
+    template<typename Op>
+    [[nodiscard]] T reduce(T init, Op op, unsigned threads = 1) const {
+        std::vector<T> partial(resolve(threads, capacity_), init);
+        for_chunks(threads, [&](size_t begin, size_t end, unsigned chunk) {
+            partial[chunk] = fold(data_ + begin, end - begin, init, op);
+        });
+        T result = init;
+        for (const T& p : partial) {
+            result = op(result, p);
+        }
+        return result;
+    }
+
+    [[nodiscard]] T sum(unsigned threads = 1) const requires std::is_arithmetic_v<T> {
+        return reduce(T{}, [](T a, T b) { return static_cast<T>(a + b); }, threads);
+    }
+
+    [[nodiscard]] T min(unsigned threads = 1) const requires std::is_arithmetic_v<T> {
+        return reduce(std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity()
+                                                           : std::numeric_limits<T>::max(),
+                      [](T a, T b) { return b < a ? b : a; }, threads);
+    }
+
+    [[nodiscard]] T max(unsigned threads = 1) const requires std::is_arithmetic_v<T> {
+        return reduce(std::numeric_limits<T>::has_infinity ? -std::numeric_limits<T>::infinity()
+                                                           : std::numeric_limits<T>::lowest(),
+                      [](T a, T b) { return a < b ? b : a; }, threads);
+    }
+
+    /**
+     * Count elements into `bins` equal-width bins over [lo, hi); values
+     * outside the range are not counted.
+     */
+    [[nodiscard]] std::vector<size_t> histogram(size_t bins, T lo, T hi,
+                                                unsigned threads = 1) const
+        requires std::is_arithmetic_v<T> {
+        if (bins == 0 || !(lo < hi)) {
+            throw std::invalid_argument("histogram needs bins > 0 and lo < hi");
+        }
+        const double scale = static_cast<double>(bins) /
+                             (static_cast<double>(hi) - static_cast<double>(lo));
+        std::vector<std::vector<size_t>> local(resolve(threads, capacity_),
+                                               std::vector<size_t>(bins, 0));
+        for_chunks(threads, [&](size_t begin, size_t end, unsigned chunk) {
+            size_t* counts = local[chunk].data();
+            for (size_t i = begin; i < end; ++i) {
+                T x = data_[i];
+                if (lo <= x && x < hi) {
+                    auto bin = static_cast<size_t>((static_cast<double>(x) - lo) * scale);
+                    counts[std::min(bin, bins - 1)]++;
+                }
+            }
+        });
+        std::vector<size_t> result(bins, 0);
+        for (const auto& counts : local) {
+            for (size_t b = 0; b < bins; ++b) {
+                result[b] += counts[b];
+            }
+        }
+        return result;
+    }
+
+    /**
+     * Index of the first element equal to value
+     */
+    [[nodiscard]] std::optional<size_t> find(const T& value, unsigned threads = 1) const
+        requires std::equality_comparable<T> {
+        std::atomic<size_t> first{capacity_};
+        const T* data = data_;
+        const T needle = value;
+        for_chunks(threads, [&](size_t begin, size_t end, unsigned) {
+            // Test a block at a time without branching, then locate the hit
+            size_t i = begin;
+            for (; i + FIND_BLOCK <= end; i += FIND_BLOCK) {
+                if (i % (FIND_BLOCK * 16) == 0 && first.load(std::memory_order_relaxed) < i) {
+                    return;  // An earlier chunk already found one
+                }
+                // Counting matches (rather than or-ing bools) is the form
+                // the compiler turns into vector compares
+                unsigned hits = 0;
+                for (size_t j = 0; j < FIND_BLOCK; ++j) {
+                    hits += data[i + j] == needle;
+                }
+                if (hits) break;
+            }
+            for (; i < end; ++i) {
+                if (data[i] == needle) {
+                    size_t current = first.load(std::memory_order_relaxed);
+                    while (i < current && !first.compare_exchange_weak(current, i)) {}
+                    return;
+                }
+            }
+        });
+        size_t index = first.load();
+        return index < capacity_ ? std::optional<size_t>(index) : std::nullopt;
     }
     
 private:
+    // Chunk boundaries fall on whole cache lines of elements
+    static constexpr size_t GRANULE = std::max<size_t>(1, CACHE_LINE_SIZE / sizeof(T));
+    // Below this many elements per thread, extra threads cost more than they save
+    static constexpr size_t MIN_CHUNK = std::max<size_t>(GRANULE, 16384 / sizeof(T));
+    static constexpr size_t FIND_BLOCK = std::max<size_t>(64, GRANULE);
+    static constexpr size_t LANES = 8;
+
+    struct VersionHeader {
+        uint64_t block;     // Elements per seqlock block
+        uint64_t reserved;
+    };
+
+    static constexpr size_t VERSIONS_SEQ_OFFSET = CACHE_LINE_SIZE;
+    static constexpr size_t MAX_STACK_BLOCKS = 64;
+    static constexpr int SPIN_ATTEMPTS = 64;
+    static constexpr int READ_ATTEMPTS = 1 << 20;
+
+    // Relative to the array header; the seqlock block starts on a fresh line
+    static constexpr size_t versions_offset(size_t capacity) {
+        return align_up(DATA_OFFSET + capacity * sizeof(T), CACHE_LINE_SIZE);
+    }
+
+    void bind_versions(size_t voff) {
+        auto* vh = static_cast<VersionHeader*>(memory_.at(offset_ + voff));
+        block_ = vh->block;
+        versions_ = static_cast<std::atomic<uint64_t>*>(
+            memory_.at(offset_ + voff + VERSIONS_SEQ_OFFSET));
+    }
+
+    size_t version_blocks() const { return (capacity_ + block_ - 1) / block_; }
+
+    void check_region(size_t first, size_t count) const {
+        if (!versions_) {
+            throw std::logic_error("Array was not created with version_block");
+        }
+        if (first > capacity_ || count > capacity_ - first) {
+            throw std::out_of_range("Region exceeds array capacity");
+        }
+    }
+
+    // Even -> odd; a writer already in the block makes us wait for it
+    void lock_version(size_t b) {
+        for (int spins = 0;; ++spins) {
+            uint64_t seq = versions_[b].load(std::memory_order_relaxed);
+            if ((seq & 1) == 0 &&
+                versions_[b].compare_exchange_weak(seq, seq + 1,
+                                                   std::memory_order_acquire,
+                                                   std::memory_order_relaxed)) {
+                std::atomic_thread_fence(std::memory_order_release);
+                return;
+            }
+            if (spins >= SPIN_ATTEMPTS) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    size_t checked(size_t index) const {
+        if (index >= capacity_) {
+            throw std::out_of_range("Index out of bounds");
+        }
+        return index;
+    }
+
+    static unsigned resolve(unsigned threads, size_t n) {
+        return detail::resolve_threads(threads, n, MIN_CHUNK);
+    }
+
+    template<typename Fn>
+    void for_chunks(unsigned threads, Fn&& fn) const {
+        detail::parallel_chunks(capacity_, resolve(threads, capacity_), GRANULE, fn);
+    }
+
+    // LANES independent accumulators break the dependency chain so the loop
+    // vectorizes (and keeps floating-point sums from serializing)
+    template<typename Op>
+    static T fold(const T* p, size_t n, T init, Op op) {
+        T acc[LANES];
+        for (size_t l = 0; l < LANES; ++l) {
+            acc[l] = init;
+        }
+        size_t i = 0;
+        for (; i + LANES <= n; i += LANES) {
+            for (size_t l = 0; l < LANES; ++l) {
+                acc[l] = op(acc[l], p[i + l]);
+            }
+        }
+        for (; i < n; ++i) {
+            acc[0] = op(acc[0], p[i]);
+        }
+        T result = acc[0];
+        for (size_t l = 1; l < LANES; ++l) {
+            result = op(result, acc[l]);
+        }
+        return result;
+    }
+
     Memory& memory_;
     Header* header_;
     T* data_;
     size_t capacity_;
     size_t offset_;
+    std::atomic<uint64_t>* versions_ = nullptr;
+    size_t block_ = 0;
     std::string name_;
 };
 
@@ -1,10 +1,15 @@
 #pragma once
 
 #include "memory.h"
+#include "detail/futex.h"
+#include "detail/hash.h"
 #include "detail/spin_wait.h"
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <stdexcept>
+#include <thread>
+#include <unistd.h>
 
 namespace zeroipc {
 
@@ -18,6 +23,24 @@ namespace zeroipc {
  * The generation counter prevents early arrivals for the next cycle from
  * releasing the current cycle, making the barrier reusable.
  *
+ * Two algorithms, picked when the barrier is created:
+ *
+ * - Central: every participant increments one shared counter and spins on
+ *   one shared generation word. Cheap for a handful of participants and
+ *   readable from every language binding.
+ * - Tree (combining tree): participants arrive at leaf nodes of at most
+ *   FAN_IN participants, each node on its own cache line. The last arrival
+ *   at a node carries the arrival up to the parent, so no word sees more
+ *   than FAN_IN increments per cycle. Participants wait on their own leaf,
+ *   spinning briefly and then sleeping on its futex word; whoever completes
+ *   the root resets the tree and wakes the leaves. A leaf is picked by
+ *   thread hash and the next one with room is taken if it is full. The
+ *   tree layout is C++ only; other bindings reject it as a size mismatch.
+ *
+ * Barriers are Central unless asked otherwise, so every binding can open
+ * them. Mode::Tree opts in to the tree; Mode::Auto opts in from
+ * TREE_THRESHOLD participants on.
+ *
  * Thread-safe and process-safe.
  *
  * Example:
@@ -33,38 +56,76 @@ namespace zeroipc {
  */
 class Barrier {
 public:
+    enum class Mode {
+        Auto,     // Tree from TREE_THRESHOLD participants on, else Central
+        Central,  // One shared counter (the cross-language layout)
+        Tree      // Combining tree of per-cache-line nodes
+    };
+
+    static constexpr int32_t FAN_IN = 4;
+    static constexpr int32_t TREE_THRESHOLD = 16;
+
     struct Header {
-        std::atomic<int32_t> arrived;        // Number of processes that have arrived
+        std::atomic<int32_t> arrived;        // Number of processes that have arrived (central)
         std::atomic<int32_t> generation;     // Generation counter (for reusability)
         int32_t num_participants;            // Total number of participants
-        int32_t _padding;                    // Alignment padding
+        int32_t leaves;                      // Leaf nodes of the tree, 0 when central
     };
 
     static_assert(sizeof(Header) == 16, "Header must be 16 bytes");
 
+    // Tree node. state packs the node's cycle (high 16 bits) with the
+    // arrivals so far (low 16 bits) and is the futex word leaf waiters
+    // sleep on.
+    struct alignas(CACHE_LINE_SIZE) Node {
+        std::atomic<uint32_t> state;
+        std::atomic<uint32_t> waiters;  // Participants asleep on this leaf
+        uint32_t capacity;              // Arrivals that complete the node
+        uint32_t parent;                // Parent node + 1, 0 for the root
+    };
+
+    static constexpr size_t NODES_OFFSET = align_up(sizeof(Header), CACHE_LINE_SIZE);
+
     /**
      * Create a new barrier.
      *
      * @param memory Memory instance
      * @param name Unique identifier for this barrier
      * @param num_participants Number of processes that must arrive before releasing
+     * @param mode Algorithm; Central (the cross-language layout) unless
+     *        Tree or Auto is asked for
      */
-    Barrier(Memory& memory, std::string_view name, int32_t num_participants)
+    Barrier(Memory& memory, std::string_view name, int32_t num_participants,
+            Mode mode = Mode::Central)
         : memory_(memory), name_(name) {
 
         if (num_participants <= 0) {
             throw std::invalid_argument("Number of participants must be positive");
         }
 
-        size_t offset = memory.allocate(name, sizeof(Header));
+        if (mode == Mode::Auto) {
+            mode = num_participants >= TREE_THRESHOLD ? Mode::Tree : Mode::Central;
+        }
 
-        header_ = memory.ptr_at<Header>(offset);
+        if (mode == Mode::Central) {
+            size_t offset = memory.allocate(name, sizeof(Header));
+            header_ = memory.ptr_at<Header>(offset);
+        } else {
+            int32_t leaves = (num_participants + FAN_IN - 1) / FAN_IN;
+            size_t offset = memory.allocate(name, tree_size(leaves), CACHE_LINE_SIZE);
+            header_ = memory.ptr_at<Header>(offset);
+            header_->leaves = leaves;
+            bind();
+            build_tree(num_participants);
+        }
 
         // Initialize header
         header_->arrived.store(0, std::memory_order_relaxed);
         header_->generation.store(0, std::memory_order_relaxed);
         header_->num_participants = num_participants;
-        header_->_padding = 0;
+        if (mode == Mode::Central) {
+            header_->leaves = 0;
+        }
     }
 
     /**
@@ -81,11 +142,27 @@ public:
             throw std::runtime_error("Barrier not found: " + std::string(name));
         }
 
-        if (size != sizeof(Header)) {
+        if (size < sizeof(Header)) {
             throw std::runtime_error("Invalid barrier size");
         }
 
         header_ = memory.ptr_at<Header>(offset);
+
+        int32_t leaves = header_->leaves;
+        if (leaves == 0) {
+            if (size != sizeof(Header)) {
+                throw std::runtime_error("Invalid barrier size");
+            }
+        } else {
+            if (leaves < 0 || header_->num_participants <= 0 ||
+                leaves != (header_->num_participants + FAN_IN - 1) / FAN_IN) {
+                throw std::runtime_error("Barrier header is corrupt");
+            }
+            if (size < tree_size(leaves)) {
+                throw std::runtime_error("Invalid barrier size");
+            }
+            bind();
+        }
     }
 
     /**
@@ -95,9 +172,15 @@ public:
      * Once all arrive, all waiters are released simultaneously and the
      * barrier automatically resets for the next cycle.
      *
-     * Uses spin-waiting with exponential backoff to reduce CPU usage.
+     * Central barriers spin with exponential backoff; tree barriers spin
+     * briefly and then sleep on their leaf's futex word.
      */
     void wait() {
+        if (nodes_) {
+            tree_wait(std::chrono::steady_clock::time_point::max());
+            return;
+        }
+
         // Capture current generation before arriving
         int32_t my_generation = header_->generation.load(std::memory_order_acquire);
 
@@ -127,12 +210,18 @@ public:
      *
      * WARNING: If a timeout occurs, the barrier state may be inconsistent.
      * The caller is responsible for coordinating recovery with other processes.
+     * In a tree barrier an arrival can only be withdrawn while its leaf is
+     * still filling; once the leaf is complete wait_for() still returns
+     * false on timeout, but the arrival keeps counting toward the cycle.
      */
     template<typename Rep, typename Period>
     [[nodiscard]] bool wait_for(
             const std::chrono::duration<Rep, Period>& timeout) {
 
         auto start = std::chrono::steady_clock::now();
+        if (nodes_) {
+            return tree_wait(start + std::chrono::ceil<std::chrono::steady_clock::duration>(timeout));
+        }
 
         // Capture current generation before arriving
         int32_t my_generation = header_->generation.load(std::memory_order_acquire);
@@ -170,6 +259,14 @@ public:
      * @return Number of arrived processes
      */
     [[nodiscard]] int32_t arrived() const {
+        if (nodes_) {
+            int32_t total = 0;
+            for (int32_t i = 0; i < header_->leaves; ++i) {
+                total += static_cast<int32_t>(
+                    count_of(nodes_[i].state.load(std::memory_order_acquire)));
+            }
+            return total;
+        }
         return header_->arrived.load(std::memory_order_acquire);
     }
 
@@ -193,6 +290,13 @@ public:
         return header_->num_participants;
     }
 
+    /**
+     * Get the algorithm in use (Central or Tree).
+     */
+    [[nodiscard]] Mode mode() const {
+        return nodes_ ? Mode::Tree : Mode::Central;
+    }
+
     /**
      * Get barrier name.
      */
@@ -201,9 +305,195 @@ public:
     }
 
 private:
+    static constexpr int SPIN_LIMIT = 128;
+    static constexpr uint32_t COUNT_MASK = 0xFFFF;
+
+    // Longest single sleep on a leaf, so a wake-up lost to a process that
+    // died mid-release costs a delay rather than a hang
+    static constexpr auto PARK_SLICE = std::chrono::milliseconds(100);
+
+    struct Arrival {
+        uint32_t leaf;
+        uint32_t cycle;
+        bool completed;  // This arrival filled the leaf
+    };
+
     Memory& memory_;
     std::string name_;
     Header* header_;
+    Node* nodes_ = nullptr;  // Tree mode only
+
+    static uint32_t cycle_of(uint32_t state) { return state >> 16; }
+    static uint32_t count_of(uint32_t state) { return state & COUNT_MASK; }
+
+    // Leaves first, then each level of parents, the root last
+    static size_t node_count(int32_t leaves) {
+        size_t total = 0;
+        for (size_t level = static_cast<size_t>(leaves);; level = (level + FAN_IN - 1) / FAN_IN) {
+            total += level;
+            if (level == 1) {
+                return total;
+            }
+        }
+    }
+
+    static size_t tree_size(int32_t leaves) {
+        return NODES_OFFSET + sizeof(Node) * node_count(leaves);
+    }
+
+    void bind() {
+        nodes_ = reinterpret_cast<Node*>(reinterpret_cast<char*>(header_) + NODES_OFFSET);
+    }
+
+    // Spread participants evenly over the leaves, then group every FAN_IN
+    // nodes of a level under one parent until a single root remains
+    void build_tree(int32_t num_participants) {
+        uint32_t leaves = static_cast<uint32_t>(header_->leaves);
+        size_t count = node_count(header_->leaves);
+        for (size_t i = 0; i < count; ++i) {
+            new (&nodes_[i]) Node{};
+        }
+        for (uint32_t i = 0; i < leaves; ++i) {
+            nodes_[i].capacity = static_cast<uint32_t>(num_participants) / leaves +
+                                 (i < static_cast<uint32_t>(num_participants) % leaves ? 1 : 0);
+        }
+        size_t begin = 0;
+        for (size_t level = leaves; level > 1; ) {
+            size_t next = (level + FAN_IN - 1) / FAN_IN;
+            for (size_t i = 0; i < level; ++i) {
+                size_t parent = begin + level + i / FAN_IN;
+                nodes_[begin + i].parent = static_cast<uint32_t>(parent + 1);
+                nodes_[parent].capacity++;
+            }
+            begin += level;
+            level = next;
+        }
+    }
+
+    bool tree_wait(std::chrono::steady_clock::time_point deadline) {
+        Arrival arrival = arrive_at_leaf();
+        if (arrival.completed && ascend(arrival.leaf)) {
+            return true;  // Completed the root and released everyone
+        }
+        return await_release(arrival, deadline);
+    }
+
+    // Take a place in a leaf with room, starting at this thread's own.
+    // Only leaves already released from the previous cycle have room, so
+    // the cycle read here is the one being waited for.
+    Arrival arrive_at_leaf() {
+        uint32_t leaves = static_cast<uint32_t>(header_->leaves);
+        uint32_t start = preferred_leaf();
+        for (int spins = 0;; ++spins) {
+            for (uint32_t i = 0; i < leaves; ++i) {
+                uint32_t index = (start + i) % leaves;
+                Node& node = nodes_[index];
+                uint32_t state = node.state.load(std::memory_order_relaxed);
+                while (count_of(state) < node.capacity) {
+                    if (node.state.compare_exchange_weak(state, state + 1,
+                                                         std::memory_order_acq_rel,
+                                                         std::memory_order_relaxed)) {
+                        return {index, cycle_of(state), count_of(state) + 1 == node.capacity};
+                    }
+                }
+            }
+            if (spins >= SPIN_LIMIT) {
+                std::this_thread::yield();  // Previous cycle still being released
+            }
+        }
+    }
+
+    // Carry a completed node's arrival up the tree. Returns true if it
+    // completed the root, in which case the whole tree has been released.
+    bool ascend(uint32_t index) {
+        for (;;) {
+            uint32_t parent = nodes_[index].parent;
+            if (parent == 0) {
+                release(cycle_of(nodes_[index].state.load(std::memory_order_relaxed)));
+                return true;
+            }
+            index = parent - 1;
+            uint32_t state = nodes_[index].state.fetch_add(1, std::memory_order_acq_rel);
+            if (count_of(state) + 1 < nodes_[index].capacity) {
+                return false;
+            }
+        }
+    }
+
+    // Reset every node into the next cycle. Inner nodes go first so that
+    // participants released early find them ready when they come back up.
+    void release(uint32_t cycle) {
+        header_->generation.fetch_add(1, std::memory_order_release);
+
+        uint32_t next = ((cycle + 1) & COUNT_MASK) << 16;
+        uint32_t leaves = static_cast<uint32_t>(header_->leaves);
+        size_t count = node_count(header_->leaves);
+        for (size_t i = count; i-- > leaves; ) {
+            nodes_[i].state.store(next, std::memory_order_release);
+        }
+        for (uint32_t i = 0; i < leaves; ++i) {
+            nodes_[i].state.store(next, std::memory_order_seq_cst);
+            if (nodes_[i].waiters.load(std::memory_order_seq_cst) != 0) {
+                detail::futex_wake(&nodes_[i].state);
+            }
+        }
+    }
+
+    // Spin on our leaf, then sleep on it until its cycle moves on
+    bool await_release(const Arrival& arrival, std::chrono::steady_clock::time_point deadline) {
+        Node& node = nodes_[arrival.leaf];
+        for (int spin = 0; spin < SPIN_LIMIT; ++spin) {
+            if (cycle_of(node.state.load(std::memory_order_acquire)) != arrival.cycle) {
+                return true;
+            }
+            std::this_thread::yield();
+        }
+        for (;;) {
+            uint32_t state = node.state.load(std::memory_order_acquire);
+            if (cycle_of(state) != arrival.cycle) {
+                return true;
+            }
+            auto now = std::chrono::steady_clock::now();
+            if (now >= deadline) {
+                return withdraw(arrival);
+            }
+            node.waiters.fetch_add(1, std::memory_order_seq_cst);
+            state = node.state.load(std::memory_order_seq_cst);
+            if (cycle_of(state) == arrival.cycle) {
+                detail::futex_wait(&node.state, state,
+                                   std::min<std::chrono::steady_clock::duration>(deadline - now,
+                                                                                 PARK_SLICE));
+            }
+            node.waiters.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Undo a timed-out arrival if its leaf is still filling. Returns true
+    // if the barrier released after all.
+    bool withdraw(const Arrival& arrival) {
+        Node& node = nodes_[arrival.leaf];
+        uint32_t state = node.state.load(std::memory_order_acquire);
+        for (;;) {
+            if (cycle_of(state) != arrival.cycle) {
+                return true;
+            }
+            if (arrival.completed || count_of(state) >= node.capacity) {
+                return false;  // Already carried up the tree
+            }
+            if (node.state.compare_exchange_weak(state, state - 1,
+                                                 std::memory_order_acq_rel,
+                                                 std::memory_order_acquire)) {
+                return false;
+            }
+        }
+    }
+
+    uint32_t preferred_leaf() const {
+        thread_local const size_t thread_hash = detail::trivial_hash(
+            std::hash<std::thread::id>{}(std::this_thread::get_id()) ^
+            (static_cast<size_t>(::getpid()) << 32)) >> 16;
+        return static_cast<uint32_t>(thread_hash % static_cast<uint32_t>(header_->leaves));
+    }
 };
 
 } // namespace zeroipc
@@ -0,0 +1,291 @@
+#pragma once
+
+#include "memory.h"
+#include "rwlock.h"
+#include "detail/hash.h"
+#include "detail/spin_wait.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <string>
+#include <thread>
+#include <sched.h>
+#include <unistd.h>
+
+namespace zeroipc {
+
+/**
+ * @brief Reader-biased RWLock with per-CPU reader slots (BRAVO)
+ *
+ * Every RWLock::reader_lock writes the one lock word, so on a read-only
+ * workload that cache line still bounces between all reading cores.
+ * BiasedRWLock puts an array of reader slots, one cache line each, in front
+ * of an RWLock. While the lock is reader-biased, a reader increments the
+ * slot for the CPU it runs on and then checks that the bias still holds;
+ * readers on different CPUs touch different lines, so reads scale with
+ * cores, across processes.
+ *
+ * A writer takes the underlying RWLock, clears the bias and waits for every
+ * slot to drain. Readers that find the bias cleared use the RWLock instead.
+ * Because revocation costs a scan, the bias is only restored by a reader
+ * once a period proportional to the last revocation (INHIBIT_FACTOR times
+ * its duration) has passed, which bounds the slowdown of write-heavy phases.
+ *
+ * reader_lock returns a token naming the slot (or the RWLock) that was
+ * used, and reader_unlock needs it back; ReadGuard keeps it for you.
+ *
+ * @layout
+ *   Entry `name`:    [Header(24) | pad to 64][Slot(64) * slots]
+ *   Entry `name_rw`: RWLock (see rwlock.h)
+ */
+class BiasedRWLock {
+public:
+    using ReadToken = uint32_t;
+    static constexpr ReadToken SLOW_PATH = 0xFFFFFFFF;  // Held via the RWLock
+
+    static constexpr uint32_t MAX_SLOTS = 4096;
+    static constexpr int64_t INHIBIT_FACTOR = 9;
+
+    /// Longest name: the `name_rw` entry must still fit a table name
+    static constexpr size_t MAX_NAME = sizeof(Table::Entry::name) - 1 - 3;
+
+    struct Header {
+        std::atomic<uint32_t> bias;            // 1 while readers may use slots
+        uint32_t slots;
+        std::atomic<int64_t> inhibit_until;    // steady_clock ns; bias stays off until then
+        uint64_t reserved;
+    };
+
+    struct alignas(CACHE_LINE_SIZE) Slot {
+        std::atomic<uint32_t> readers;
+    };
+
+    static constexpr size_t SLOTS_OFFSET = align_up(sizeof(Header), CACHE_LINE_SIZE);
+
+    /**
+     * @brief Create or open a BiasedRWLock
+     * @param mem Memory region
+     * @param name Unique name for this lock (at most MAX_NAME characters)
+     * @param slots Reader slots when creating; 0 means one per hardware
+     *        thread. When opening, 0 or the slot count it was created with.
+     * @throws std::invalid_argument if slots exceeds MAX_SLOTS or name is
+     *         longer than MAX_NAME; nothing is registered then
+     * @throws std::runtime_error on a slot count or layout mismatch
+     */
+    BiasedRWLock(Memory& mem, std::string_view name, size_t slots = 0)
+        : lock_(mem, lock_name(name, slots)) {
+
+        auto* entry = mem.table()->find(name);
+        if (entry) {
+            // Open existing
+            header_ = mem.ptr_at<Header>(entry->offset);
+            if (header_->slots == 0 || header_->slots > MAX_SLOTS ||
+                SLOTS_OFFSET + sizeof(Slot) * header_->slots > entry->size) {
+                throw std::runtime_error("BiasedRWLock header is corrupt");
+            }
+            if (slots != 0 && slots != header_->slots) {
+                throw std::runtime_error("BiasedRWLock slot count mismatch");
+            }
+            bind();
+        } else {
+            // Create new
+            if (slots == 0) {
+                slots = std::clamp<size_t>(std::thread::hardware_concurrency(), 1, MAX_SLOTS);
+            }
+            size_t offset = mem.allocate(name, SLOTS_OFFSET + sizeof(Slot) * slots,
+                                         CACHE_LINE_SIZE);
+            header_ = mem.ptr_at<Header>(offset);
+            header_->bias.store(1, std::memory_order_relaxed);
+            header_->slots = static_cast<uint32_t>(slots);
+            header_->inhibit_until.store(0, std::memory_order_relaxed);
+            header_->reserved = 0;
+            bind();
+            for (size_t i = 0; i < slots; ++i) {
+                new (&slots_[i]) Slot{};
+            }
+        }
+    }
+
+    /**
+     * @brief Acquire read lock (shared access)
+     * @return Token to pass to reader_unlock
+     */
+    [[nodiscard]] ReadToken reader_lock() {
+        if (auto token = try_fast_read()) {
+            return *token;
+        }
+        lock_.reader_lock();
+        maybe_restore_bias();
+        return SLOW_PATH;
+    }
+
+    /**
+     * @brief Try to acquire read lock without blocking
+     * @return Token to pass to reader_unlock, or nullopt
+     */
+    [[nodiscard]] std::optional<ReadToken> try_reader_lock() {
+        if (auto token = try_fast_read()) {
+            return token;
+        }
+        if (!lock_.try_reader_lock()) {
+            return std::nullopt;
+        }
+        maybe_restore_bias();
+        return SLOW_PATH;
+    }
+
+    /**
+     * @brief Release read lock taken with the given token
+     */
+    void reader_unlock(ReadToken token) {
+        if (token == SLOW_PATH) {
+            lock_.reader_unlock();
+        } else {
+            slots_[token].readers.fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    /**
+     * @brief Acquire write lock (exclusive access)
+     *
+     * Revokes the reader bias if set and waits for every slot to drain.
+     */
+    void writer_lock() {
+        lock_.writer_lock();
+        if (header_->bias.load(std::memory_order_relaxed) == 0) {
+            return;
+        }
+
+        auto start = now_ns();
+        header_->bias.store(0, std::memory_order_seq_cst);
+        for (uint32_t i = 0; i < header_->slots; ++i) {
+            auto drained = [&] {
+                return slots_[i].readers.load(std::memory_order_seq_cst) == 0;
+            };
+            for (int spin = 0; spin < SPIN_LIMIT && !drained(); ++spin) {
+                std::this_thread::yield();
+            }
+            detail::spin_wait(drained);
+        }
+        auto end = now_ns();
+        header_->inhibit_until.store(end + (end - start) * INHIBIT_FACTOR,
+                                     std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Release write lock
+     */
+    void writer_unlock() {
+        lock_.writer_unlock();
+    }
+
+    // Whether readers currently take the per-slot fast path
+    [[nodiscard]] bool reader_biased() const {
+        return header_->bias.load(std::memory_order_relaxed) != 0;
+    }
+
+    [[nodiscard]] size_t slots() const { return header_->slots; }
+
+    /**
+     * @brief RAII read lock holding its token
+     */
+    class ReadGuard {
+    public:
+        explicit ReadGuard(BiasedRWLock& lock) : lock_(lock), token_(lock.reader_lock()) {}
+        ~ReadGuard() { lock_.reader_unlock(token_); }
+
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+
+    private:
+        BiasedRWLock& lock_;
+        ReadToken token_;
+    };
+
+    /**
+     * @brief RAII write lock
+     */
+    class WriteGuard {
+    public:
+        explicit WriteGuard(BiasedRWLock& lock) : lock_(lock) { lock_.writer_lock(); }
+        ~WriteGuard() { lock_.writer_unlock(); }
+
+        WriteGuard(const WriteGuard&) = delete;
+        WriteGuard& operator=(const WriteGuard&) = delete;
+
+    private:
+        BiasedRWLock& lock_;
+    };
+
+    BiasedRWLock(const BiasedRWLock&) = delete;
+    BiasedRWLock& operator=(const BiasedRWLock&) = delete;
+
+private:
+    static constexpr int SPIN_LIMIT = 128;
+
+    // Validates the arguments before lock_ registers `name_rw`, so a bad
+    // call leaves nothing behind in the table.
+    static std::string lock_name(std::string_view name, size_t slots) {
+        if (slots > MAX_SLOTS) {
+            throw std::invalid_argument("BiasedRWLock slots exceed MAX_SLOTS");
+        }
+        if (name.size() > MAX_NAME) {
+            throw std::invalid_argument("BiasedRWLock name too long (max " +
+                                        std::to_string(MAX_NAME) + " characters)");
+        }
+        return std::string(name) + "_rw";
+    }
+
+    RWLock lock_;
+    Header* header_ = nullptr;
+    Slot* slots_ = nullptr;
+
+    void bind() {
+        slots_ = reinterpret_cast<Slot*>(reinterpret_cast<char*>(header_) + SLOTS_OFFSET);
+    }
+
+    // Announce ourselves in our slot, then re-check the bias. The seq_cst
+    // pair with writer_lock's bias store and slot loads: either the writer
+    // sees our slot count, or we see the bias cleared and back out.
+    std::optional<ReadToken> try_fast_read() {
+        if (header_->bias.load(std::memory_order_relaxed) == 0) {
+            return std::nullopt;
+        }
+        ReadToken slot = slot_index();
+        slots_[slot].readers.fetch_add(1, std::memory_order_seq_cst);
+        if (header_->bias.load(std::memory_order_seq_cst) != 0) [[likely]] {
+            return slot;
+        }
+        slots_[slot].readers.fetch_sub(1, std::memory_order_release);
+        return std::nullopt;
+    }
+
+    // Called holding the read lock, so no writer is scanning
+    void maybe_restore_bias() {
+        if (header_->bias.load(std::memory_order_relaxed) == 0 &&
+            now_ns() >= header_->inhibit_until.load(std::memory_order_relaxed)) {
+            header_->bias.store(1, std::memory_order_relaxed);
+        }
+    }
+
+    // The CPU we are running on, or failing that a per-thread hash. The
+    // slot only needs to be spread out, not exact: unlock uses the token.
+    ReadToken slot_index() const {
+        int cpu = sched_getcpu();
+        if (cpu >= 0) [[likely]] {
+            return static_cast<ReadToken>(cpu) % header_->slots;
+        }
+        thread_local const size_t thread_hash = detail::trivial_hash(
+            std::hash<std::thread::id>{}(std::this_thread::get_id()) ^
+            (static_cast<size_t>(::getpid()) << 32)) >> 16;
+        return static_cast<ReadToken>(thread_hash % header_->slots);
+    }
+
+    static int64_t now_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+};
+
+} // namespace zeroipc
@@ -0,0 +1,336 @@
+#pragma once
+
+#include "memory.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <optional>
+
+namespace zeroipc {
+
+/**
+ * @brief Fixed-size object pool tracked by an atomic bitmap
+ *
+ * Pool<T> threads its free list through the nodes, so after some churn the
+ * allocation order is effectively random and consecutive allocations land on
+ * scattered cache lines and pages. BitmapPool<T> keeps one bit per slot
+ * instead (1 = allocated) and always hands out the lowest free slot, found
+ * 64 slots at a time with a trailing-ones count (tzcnt), so live objects
+ * stay packed at the low end of the pool. A shared low-water hint names the
+ * lowest bitmap word that may hold a free bit, so the scan skips the full
+ * prefix; frees lower it again.
+ *
+ * It also allocates contiguous runs (allocate_run), so a vector of objects
+ * can live in one stretch of memory.
+ *
+ * @layout
+ *   [Header(24)][bitmap: u64 * words][pad to section alignment][T * capacity]
+ *   Bits past capacity in the last word are kept set.
+ *
+ * @tparam T Element type (must be trivially copyable)
+ */
+template<typename T>
+class BitmapPool {
+public:
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "T must be trivially copyable for shared memory");
+    static_assert(alignof(T) <= MAX_ELEM_ALIGN,
+                  "T alignment exceeds the largest supported allocation alignment");
+
+    struct Header {
+        std::atomic<uint32_t> allocated;  // Number of allocated slots
+        uint32_t capacity;
+        uint32_t elem_size;
+        uint32_t words;                   // Bitmap words, ceil(capacity / 64)
+        // Low 32 bits: no word below this one has a free bit. High 32 bits:
+        // bumped by every free, so a scan cannot raise the hint past a word
+        // freed behind it.
+        std::atomic<uint64_t> hint;
+    };
+
+    static constexpr size_t ALIGN = section_align<T>();
+    static constexpr size_t BITMAP_OFFSET = sizeof(Header);
+
+    // Create new pool
+    BitmapPool(Memory& memory, std::string_view name, size_t capacity)
+        : memory_(memory), name_(name) {
+
+        if (capacity == 0) {
+            throw std::invalid_argument("BitmapPool capacity must be greater than 0");
+        }
+        if (capacity > UINT32_MAX / 2 ||
+            capacity > (SIZE_MAX - data_offset(capacity)) / sizeof(T)) {
+            throw std::overflow_error("BitmapPool capacity too large");
+        }
+
+        size_t total_size = data_offset(capacity) + sizeof(T) * capacity;
+        size_t offset = memory.allocate(name, total_size, ALIGN);
+
+        header_ = memory.ptr_at<Header>(offset);
+        header_->allocated.store(0, std::memory_order_relaxed);
+        header_->capacity = static_cast<uint32_t>(capacity);
+        header_->elem_size = sizeof(T);
+        header_->words = static_cast<uint32_t>((capacity + 63) / 64);
+        header_->hint.store(0, std::memory_order_relaxed);
+
+        bind();
+        for (uint32_t w = 0; w < header_->words; ++w) {
+            bitmap_[w].store(0, std::memory_order_relaxed);
+        }
+        if (capacity % 64) {
+            // Slots past the end are permanently "allocated"
+            bitmap_[header_->words - 1].store(~uint64_t(0) << (capacity % 64),
+                                              std::memory_order_relaxed);
+        }
+    }
+
+    // Open existing pool
+    BitmapPool(Memory& memory, std::string_view name)
+        : memory_(memory), name_(name) {
+
+        auto* entry = memory.table()->find(name);
+        if (!entry) {
+            throw std::runtime_error("BitmapPool not found: " + std::string(name));
+        }
+        if (entry->section_align() != ALIGN) {
+            throw std::runtime_error("Alignment mismatch");
+        }
+
+        header_ = memory.ptr_at<Header>(entry->offset);
+
+        if (header_->elem_size != sizeof(T)) {
+            throw std::runtime_error("Type size mismatch");
+        }
+        if (header_->capacity == 0 || header_->words != (header_->capacity + 63) / 64 ||
+            data_offset(header_->capacity) + sizeof(T) * header_->capacity > entry->size) {
+            throw std::runtime_error("BitmapPool header is corrupt");
+        }
+
+        bind();
+    }
+
+    // Allocate the lowest free slot (lock-free)
+    [[nodiscard]] std::optional<T*> allocate() {
+        uint64_t hint = header_->hint.load(std::memory_order_acquire);
+        for (uint32_t w = static_cast<uint32_t>(hint); w < header_->words; ++w) {
+            uint64_t word = bitmap_[w].load(std::memory_order_relaxed);
+            while (word != ~uint64_t(0)) {
+                uint64_t bit = uint64_t(1) << std::countr_one(word);
+                if (bitmap_[w].compare_exchange_weak(
+                        word, word | bit,
+                        std::memory_order_acquire,
+                        std::memory_order_relaxed)) {
+                    header_->allocated.fetch_add(1, std::memory_order_relaxed);
+                    raise_hint(hint, w);
+                    return &data_[size_t(w) * 64 + std::countr_zero(bit)];
+                }
+            }
+        }
+        raise_hint(hint, header_->words);
+        return std::nullopt;  // Pool is full
+    }
+
+    // Allocate n adjacent slots (first fit from the low end). Returns the
+    // first element of the run, or nullopt if no free run is long enough.
+    [[nodiscard]] std::optional<T*> allocate_run(size_t n) {
+        if (n == 0 || n > header_->capacity) {
+            return std::nullopt;
+        }
+
+        // A run starts on a free bit, and there is none below the hint
+        size_t run = 0, start = 0;
+        uint32_t low = static_cast<uint32_t>(header_->hint.load(std::memory_order_acquire));
+        for (uint32_t w = low; w < header_->words; ++w) {
+            uint64_t free = ~bitmap_[w].load(std::memory_order_relaxed);
+            size_t b = 0;
+            while (b < 64) {
+                uint64_t rest = free >> b;
+                if (rest == 0) {
+                    run = 0;  // Rest of the word is allocated
+                    break;
+                }
+                if (size_t used = std::countr_zero(rest)) {
+                    run = 0;
+                    b += used;
+                    continue;
+                }
+                size_t len = std::countr_one(rest);
+                if (run == 0) {
+                    start = size_t(w) * 64 + b;
+                }
+                run += len;
+                b += len;
+                if (run >= n) {
+                    if (claim_run(start, n)) {
+                        header_->allocated.fetch_add(static_cast<uint32_t>(n),
+                                                     std::memory_order_relaxed);
+                        return &data_[start];
+                    }
+                    // Lost a race for part of the run; rescan this word
+                    run = 0;
+                    free = ~bitmap_[w].load(std::memory_order_relaxed);
+                    b = 0;
+                }
+            }
+        }
+        return std::nullopt;
+    }
+
+    // Return one slot to the pool
+    void deallocate(T* ptr) {
+        if (!ptr) return;
+        release(index_of(ptr), 1);
+    }
+
+    // Return a run obtained from allocate_run
+    void deallocate_run(T* first, size_t n) {
+        if (!first || n == 0) return;
+        size_t index = index_of(first);
+        if (n > header_->capacity - index) {
+            throw std::invalid_argument("Invalid run to deallocate");
+        }
+        release(index, n);
+    }
+
+    // Whether the slot holding ptr is currently allocated
+    [[nodiscard]] bool is_allocated(const T* ptr) const {
+        size_t index = index_of(ptr);
+        return (bitmap_[index / 64].load(std::memory_order_acquire) >> (index % 64)) & 1;
+    }
+
+    // Slot number of ptr, and the slot at a number
+    [[nodiscard]] size_t index_of(const T* ptr) const {
+        if (ptr < data_ || ptr >= data_ + header_->capacity) {
+            throw std::invalid_argument("Pointer is not in this BitmapPool");
+        }
+        return static_cast<size_t>(ptr - data_);
+    }
+
+    [[nodiscard]] T* at(size_t index) const { return &data_[index]; }
+
+    [[nodiscard]] size_t allocated() const {
+        return header_->allocated.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] size_t available() const { return header_->capacity - allocated(); }
+    [[nodiscard]] size_t capacity() const { return header_->capacity; }
+    [[nodiscard]] bool empty() const { return allocated() == 0; }
+    [[nodiscard]] bool full() const { return allocated() == header_->capacity; }
+
+private:
+    Memory& memory_;
+    std::string name_;
+    Header* header_ = nullptr;
+    std::atomic<uint64_t>* bitmap_ = nullptr;
+    T* data_ = nullptr;
+
+    static constexpr size_t data_offset(size_t capacity) {
+        return align_up(BITMAP_OFFSET + sizeof(uint64_t) * ((capacity + 63) / 64), ALIGN);
+    }
+
+    void bind() {
+        char* base = reinterpret_cast<char*>(header_);
+        bitmap_ = reinterpret_cast<std::atomic<uint64_t>*>(base + BITMAP_OFFSET);
+        data_ = reinterpret_cast<T*>(base + data_offset(header_->capacity));
+    }
+
+    // Bits of word w covered by [start, start + n)
+    static uint64_t run_mask(size_t w, size_t start, size_t n) {
+        size_t lo = std::max(start, w * 64);
+        size_t hi = std::min(start + n, w * 64 + 64);
+        size_t len = hi - lo;
+        uint64_t bits = len == 64 ? ~uint64_t(0) : (uint64_t(1) << len) - 1;
+        return bits << (lo - w * 64);
+    }
+
+    // Move the hint up to word w, unless a free happened since it was read
+    void raise_hint(uint64_t seen, uint32_t w) {
+        if (static_cast<uint32_t>(seen) < w) {
+            header_->hint.compare_exchange_strong(seen, (seen & ~uint64_t(UINT32_MAX)) | w,
+                                                  std::memory_order_relaxed);
+        }
+    }
+
+    // Word w has a free bit again: lower the hint to it and bump the count
+    void lower_hint(uint32_t w) {
+        uint64_t hint = header_->hint.load(std::memory_order_relaxed);
+        uint64_t next;
+        do {
+            next = ((hint >> 32) + 1) << 32 |
+                   std::min(static_cast<uint32_t>(hint), w);
+        } while (!header_->hint.compare_exchange_weak(
+                    hint, next,
+                    std::memory_order_release,
+                    std::memory_order_relaxed));
+    }
+
+    // Claim [start, start + n) word by word, undoing the words already taken
+    // if a later one turns out to be (partly) allocated
+    bool claim_run(size_t start, size_t n) {
+        size_t first = start / 64, last = (start + n - 1) / 64;
+        for (size_t w = first; w <= last; ++w) {
+            uint64_t mask = run_mask(w, start, n);
+            uint64_t word = bitmap_[w].load(std::memory_order_relaxed);
+            bool claimed = false;
+            while (!(word & mask)) {
+                if (bitmap_[w].compare_exchange_weak(
+                        word, word | mask,
+                        std::memory_order_acquire,
+                        std::memory_order_relaxed)) {
+                    claimed = true;
+                    break;
+                }
+            }
+            if (!claimed) {
+                for (size_t u = first; u < w; ++u) {
+                    bitmap_[u].fetch_and(~run_mask(u, start, n), std::memory_order_release);
+                }
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Free [index, index + n). Every word is checked before any bit is
+    // cleared, so a double free throws without touching the bitmap; each
+    // word is then cleared by a CAS that still requires all its bits set,
+    // and `allocated` drops by exactly the bits this call cleared.
+    void release(size_t index, size_t n) {
+        size_t first = index / 64, last = (index + n - 1) / 64;
+        for (size_t w = first; w <= last; ++w) {
+            uint64_t mask = run_mask(w, index, n);
+            if ((bitmap_[w].load(std::memory_order_acquire) & mask) != mask) {
+                throw std::invalid_argument("Slot is not allocated (double free?)");
+            }
+        }
+        size_t cleared = 0;
+        for (size_t w = first; w <= last; ++w) {
+            uint64_t mask = run_mask(w, index, n);
+            uint64_t word = bitmap_[w].load(std::memory_order_relaxed);
+            bool done = false;
+            while ((word & mask) == mask) {
+                if (bitmap_[w].compare_exchange_weak(
+                        word, word & ~mask,
+                        std::memory_order_release,
+                        std::memory_order_relaxed)) {
+                    done = true;
+                    break;
+                }
+            }
+            if (!done) {
+                // A concurrent release of the same slots got here first
+                if (cleared) {
+                    lower_hint(static_cast<uint32_t>(first));
+                }
+                header_->allocated.fetch_sub(static_cast<uint32_t>(cleared),
+                                             std::memory_order_relaxed);
+                throw std::invalid_argument("Slot is not allocated (double free?)");
+            }
+            cleared += static_cast<size_t>(std::popcount(mask));
+        }
+        lower_hint(static_cast<uint32_t>(first));
+        header_->allocated.fetch_sub(static_cast<uint32_t>(n), std::memory_order_relaxed);
+    }
+};
+
+} // namespace zeroipc
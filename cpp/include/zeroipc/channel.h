@@ -2,13 +2,18 @@
 
 #include "memory.h"
 #include "queue.h"
+#include "detail/watch_list.h"
 #include <bit>
 #include <atomic>
 #include <optional>
 #include <chrono>
+#include <type_traits>
 
 namespace zeroipc {
 
+template<typename T, typename F> class RecvCase;
+template<typename T, typename F> class SendCase;
+
 /**
  * @brief CSP-style channel for synchronous message passing between processes
  * 
@@ -66,8 +71,9 @@ namespace zeroipc {
  *     handle(*msg);
  * }
  * 
- * // Select across multiple channels (Go-style)
- * select(
+ * // Select across multiple channels (Go-style, see wait_set.h)
+ * WaitSet ws(mem, "consumer");
+ * select(ws,
  *     ch1.on_recv([](int x) { handle_int(x); }),
  *     ch2.on_recv([](double y) { handle_double(y); }),
  *     timeout(1s, []() { handle_timeout(); })
@@ -89,6 +95,7 @@ public:
         std::atomic<bool> closed;            // Channel closed
         std::atomic<uint64_t> send_seq;      // Send sequence for ordering
         std::atomic<uint64_t> recv_seq;      // Receive sequence for ordering
+        detail::WatchList watch;             // WaitSets (unbuffered channels)
     };
     
     struct RendezvousSlot {
@@ -130,6 +137,7 @@ public:
         header_->closed.store(false, std::memory_order_relaxed);
         header_->send_seq.store(0, std::memory_order_relaxed);
         header_->recv_seq.store(0, std::memory_order_relaxed);
+        detail::init(header_->watch);
         
         if (capacity > 0) {
             // Buffered channel uses queue (Vyukov queue uses all N slots)
@@ -159,6 +167,9 @@ public:
         if (!memory.find(header_name, offset, size)) {
             throw std::runtime_error("Channel not found: " + std::string(name));
         }
+        if (size != sizeof(Header)) {
+            throw std::runtime_error("Channel header size mismatch");
+        }
         
         header_ = memory.ptr_at<Header>(offset);
 
@@ -218,6 +229,12 @@ public:
      */
     [[nodiscard]] bool send_timeout(const T& value, 
                                     std::chrono::milliseconds timeout) {
+        if (capacity_ > 0 && buffer_) {
+            // Sleeps in the queue until space frees up or close()
+            return !is_closed() && buffer_->push_for(value, timeout,
+                [this] { return is_closed(); });
+        }
+
         auto deadline = std::chrono::steady_clock::now() + timeout;
         
         while (std::chrono::steady_clock::now() < deadline) {
@@ -271,7 +288,13 @@ public:
      */
     [[nodiscard]] std::optional<T> recv_timeout(
         std::chrono::milliseconds timeout) {
-        
+
+        if (capacity_ > 0 && buffer_) {
+            // Sleeps in the queue until a send or close(); buffered values
+            // are still drained after close
+            return buffer_->pop_for(timeout, [this] { return is_closed(); });
+        }
+
         auto deadline = std::chrono::steady_clock::now() + timeout;
         
         while (std::chrono::steady_clock::now() < deadline) {
@@ -294,6 +317,12 @@ public:
     void close() {
         header_->closed.store(true, std::memory_order_release);
         // Wake all waiting senders and receivers
+        if (buffer_) {
+            buffer_->notify_all();
+        } else {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            detail::poke(header_->watch);
+        }
     }
     
     /**
@@ -317,6 +346,64 @@ public:
         return capacity_ > 0;
     }
     
+    /**
+     * @brief Check if a receive would find a value waiting
+     *
+     * Buffered: the buffer is non-empty. Unbuffered: a sender is parked in
+     * the rendezvous slot.
+     */
+    [[nodiscard]] bool has_data() const {
+        if (capacity_ > 0 && buffer_) {
+            return !buffer_->empty();
+        }
+        return slot_->ready.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Check if a send would not block
+     *
+     * Buffered: the buffer has room. Unbuffered: a receiver is waiting.
+     */
+    [[nodiscard]] bool has_space() const {
+        if (capacity_ > 0 && buffer_) {
+            return !buffer_->full();
+        }
+        return header_->receivers.load(std::memory_order_acquire) > 0;
+    }
+
+    /**
+     * @brief Registrations of the WaitSets watching this channel
+     *
+     * The buffer queue's list for buffered channels, the header's for
+     * unbuffered ones.
+     */
+    [[nodiscard]] detail::WatchList* watch_list() {
+        return buffer_ ? buffer_->watch_list() : &header_->watch;
+    }
+
+    /**
+     * @brief A select() case receiving from this channel
+     *
+     * handler gets the value. A handler taking std::optional<T> also fires,
+     * with nullopt, once the channel is closed and drained (Go's
+     * `v, ok := <-ch`); otherwise a closed channel's case never fires.
+     */
+    template<typename F>
+    [[nodiscard]] RecvCase<T, std::decay_t<F>> on_recv(F&& handler) {
+        return RecvCase<T, std::decay_t<F>>(*this, std::forward<F>(handler));
+    }
+
+    /**
+     * @brief A select() case sending value on this channel
+     *
+     * handler() runs once the value is sent; a closed channel's case never
+     * fires.
+     */
+    template<typename F>
+    [[nodiscard]] SendCase<T, std::decay_t<F>> on_send(const T& value, F&& handler) {
+        return SendCase<T, std::decay_t<F>>(*this, value, std::forward<F>(handler));
+    }
+
     /**
      * @brief Iterator support for range-based for loops
      */
@@ -376,6 +463,8 @@ private:
         slot_->data = value;
         slot_->consumed.store(false, std::memory_order_relaxed);
         slot_->ready.store(true, std::memory_order_release);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        detail::poke(header_->watch);
         
         // Wait for receiver to consume
         while (!slot_->consumed.load(std::memory_order_acquire)) {
@@ -391,8 +480,10 @@ private:
     }
     
     std::optional<T> rendezvous_recv() {
-        // Indicate we're a waiting receiver
+        // Indicate we're a waiting receiver; wakes selects with a send case
         header_->receivers.fetch_add(1, std::memory_order_acq_rel);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        detail::poke(header_->watch);
         
         // Wait for data
         while (!slot_->ready.load(std::memory_order_acquire)) {
@@ -413,13 +504,63 @@ private:
         header_->receivers.fetch_sub(1, std::memory_order_acq_rel);
         return value;
     }
-    
-    bool has_data() const {
-        if (capacity_ > 0 && buffer_) {
-            return !buffer_->empty();
+};
+
+/**
+ * @brief select() case: receive from a channel, then run a handler
+ */
+template<typename T, typename F>
+class RecvCase {
+public:
+    RecvCase(Channel<T>& channel, F handler)
+        : channel_(channel), handler_(std::move(handler)) {}
+
+    // Receive without blocking; on success run the handler
+    bool try_fire() {
+        if (auto value = channel_.try_recv()) {
+            handler_(std::move(*value));
+            return true;
         }
-        return slot_->ready.load(std::memory_order_acquire);
+        if constexpr (std::is_invocable_v<F&, std::optional<T>>) {
+            if (channel_.is_closed() && !channel_.has_data()) {
+                handler_(std::optional<T>());
+                return true;
+            }
+        }
+        return false;
+    }
+
+    detail::WatchList* watch_list() { return channel_.watch_list(); }
+
+private:
+    Channel<T>& channel_;
+    F handler_;
+};
+
+/**
+ * @brief select() case: send a value on a channel, then run a handler
+ */
+template<typename T, typename F>
+class SendCase {
+public:
+    SendCase(Channel<T>& channel, const T& value, F handler)
+        : channel_(channel), value_(value), handler_(std::move(handler)) {}
+
+    // Send without blocking; on success run the handler
+    bool try_fire() {
+        if (channel_.try_send(value_)) {
+            handler_();
+            return true;
+        }
+        return false;
     }
+
+    detail::WatchList* watch_list() { return channel_.watch_list(); }
+
+private:
+    Channel<T>& channel_;
+    T value_;
+    F handler_;
 };
 
 } // namespace zeroipc
\ No newline at end of file
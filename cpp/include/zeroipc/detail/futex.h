@@ -0,0 +1,81 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <thread>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <ctime>
+#endif
+
+namespace zeroipc::detail {
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+              "futex words must be plain 32-bit integers");
+
+/// Sleep while *word == expected, for at most timeout. May return early
+/// (spuriously, on a wake, or because the word already differs); callers
+/// re-check their condition. The futex is process-shared (no
+/// FUTEX_PRIVATE_FLAG) so waiters and wakers may live in different
+/// processes mapping the same segment.
+template<typename Rep, typename Period>
+void futex_wait(std::atomic<uint32_t>* word, uint32_t expected,
+                const std::chrono::duration<Rep, Period>& timeout) {
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(timeout).count();
+    if (ns <= 0) {
+        return;
+    }
+#ifdef __linux__
+    struct timespec ts;
+    ts.tv_sec = static_cast<time_t>(ns / 1000000000);
+    ts.tv_nsec = static_cast<long>(ns % 1000000000);
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAIT,
+            expected, &ts, nullptr, 0);
+#else
+    // No futex: poll briefly so waiters still make progress
+    if (word->load(std::memory_order_acquire) == expected) {
+        std::this_thread::sleep_for(
+            std::min(std::chrono::nanoseconds(ns), std::chrono::nanoseconds(100000)));
+    }
+#endif
+}
+
+/// Wake up to count waiters sleeping on word (INT_MAX wakes all).
+inline void futex_wake(std::atomic<uint32_t>* word, int count = INT_MAX) {
+#ifdef __linux__
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAKE,
+            count, nullptr, nullptr, 0);
+#else
+    (void)word;
+    (void)count;
+#endif
+}
+
+/// Wake up to wake_count waiters sleeping on word and move up to
+/// requeue_count of the rest onto target, where they sleep until target is
+/// woken - but only if *word still equals expected. Returns false if the
+/// kernel refused because word had changed (callers then wake instead).
+inline bool futex_cmp_requeue(std::atomic<uint32_t>* word, uint32_t expected,
+                              int wake_count, int requeue_count,
+                              std::atomic<uint32_t>* target) {
+#ifdef __linux__
+    return syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_CMP_REQUEUE,
+                   wake_count, static_cast<uintptr_t>(requeue_count),
+                   reinterpret_cast<uint32_t*>(target), expected) >= 0;
+#else
+    (void)word;
+    (void)expected;
+    (void)wake_count;
+    (void)requeue_count;
+    (void)target;
+    return true;
+#endif
+}
+
+} // namespace zeroipc::detail
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace zeroipc::detail {
+
+/// Number of threads to use for a bulk operation: 0 means one per
+/// hardware thread, and never more threads than chunks of min_chunk.
+inline unsigned resolve_threads(unsigned threads, size_t n, size_t min_chunk) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    size_t max_useful = std::max<size_t>(1, n / std::max<size_t>(1, min_chunk));
+    return static_cast<unsigned>(std::min<size_t>(threads, max_useful));
+}
+
+/// Split [0, n) into one chunk per thread, with chunk boundaries on
+/// multiples of `granule` elements (a cache line's worth) so no two threads
+/// write the same line, and run fn(begin, end, chunk_index) on each. The
+/// calling thread takes the last chunk. Exceptions from workers are
+/// rethrown on the caller.
+template<typename Fn>
+void parallel_chunks(size_t n, unsigned threads, size_t granule, Fn&& fn) {
+    if (threads <= 1 || n == 0) {
+        fn(size_t(0), n, 0u);
+        return;
+    }
+
+    size_t chunk = (n + threads - 1) / threads;
+    chunk = (chunk + granule - 1) / granule * granule;
+
+    std::vector<std::thread> workers;
+    std::vector<std::exception_ptr> errors(threads);
+    unsigned chunks = static_cast<unsigned>((n + chunk - 1) / chunk);
+    workers.reserve(chunks - 1);
+    for (unsigned t = 0; t + 1 < chunks; ++t) {
+        workers.emplace_back([&, t] {
+            try {
+                fn(t * chunk, std::min(n, (t + 1) * chunk), t);
+            } catch (...) {
+                errors[t] = std::current_exception();
+            }
+        });
+    }
+    try {
+        fn((chunks - 1) * chunk, n, chunks - 1);
+    } catch (...) {
+        errors[chunks - 1] = std::current_exception();
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+    for (auto& e : errors) {
+        if (e) std::rethrow_exception(e);
+    }
+}
+
+} // namespace zeroipc::detail
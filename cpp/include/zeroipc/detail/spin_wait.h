@@ -1,10 +1,23 @@
 #pragma once
 
+#include <atomic>
 #include <chrono>
 #include <thread>
 
 namespace zeroipc::detail {
 
+/// CPU hint for a busy-wait iteration: lets the sibling hyperthread run and
+/// avoids the memory-order mis-speculation penalty when the loop exits.
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield" ::: "memory");
+#else
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+}
+
 /// Spin-wait with exponential backoff until predicate returns true.
 /// Predicate may be a pure check or a side-effecting CAS attempt.
 template<typename Pred>
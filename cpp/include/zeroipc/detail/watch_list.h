@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "futex.h"
+
+namespace zeroipc::detail {
+
+/// The futex word a WaitSet sleeps on. Every object it watches bumps seq
+/// on each state change, so one word covers any number of objects.
+struct WaitWord {
+    std::atomic<uint32_t> seq;       // Bumped by every poke
+    std::atomic<uint32_t> sleepers;  // Threads that may be asleep on seq
+};
+
+static_assert(sizeof(WaitWord) == 8, "WaitWord must be 8 bytes");
+
+/// Registrations of the WaitSets watching one object, embedded in the
+/// object's shared state. A slot holds the distance in bytes from the list
+/// to a WaitWord in the same segment - the same in every process's
+/// mapping, unlike a pointer - or 0 when free.
+struct WatchList {
+    static constexpr size_t SLOTS = 7;
+
+    std::atomic<uint32_t> watchers;  // Occupied slots; 0 lets poke() skip the scan
+    uint32_t reserved;
+    std::atomic<int64_t> slots[SLOTS];
+};
+
+static_assert(sizeof(WatchList) == 64, "WatchList must be 64 bytes");
+
+inline void init(WatchList& list) {
+    list.watchers.store(0, std::memory_order_relaxed);
+    list.reserved = 0;
+    for (auto& slot : list.slots) {
+        slot.store(0, std::memory_order_relaxed);
+    }
+}
+
+inline int64_t distance(const WatchList& list, const WaitWord& word) {
+    return reinterpret_cast<const char*>(&word) - reinterpret_cast<const char*>(&list);
+}
+
+/// Register word with list. Returns false if every slot is taken; the
+/// caller then has to poll the object instead.
+inline bool watch(WatchList& list, WaitWord& word) {
+    const int64_t d = distance(list, word);
+    for (auto& slot : list.slots) {
+        int64_t empty = 0;
+        if (slot.load(std::memory_order_relaxed) == 0 &&
+            slot.compare_exchange_strong(empty, d, std::memory_order_acq_rel)) {
+            list.watchers.fetch_add(1, std::memory_order_acq_rel);
+            return true;
+        }
+    }
+    return false;
+}
+
+inline void unwatch(WatchList& list, WaitWord& word) {
+    int64_t d = distance(list, word);
+    for (auto& slot : list.slots) {
+        int64_t expected = d;
+        if (slot.compare_exchange_strong(expected, 0, std::memory_order_acq_rel)) {
+            list.watchers.fetch_sub(1, std::memory_order_acq_rel);
+            return;
+        }
+    }
+}
+
+/// Tell every registered WaitSet the object changed. Call after the change
+/// and a seq_cst fence; the fence pairs with the one a WaitSet issues
+/// between announcing itself asleep and re-checking readiness, so either
+/// the re-check sees the change or we see the sleeper and wake it.
+inline void poke(WatchList& list) {
+    if (list.watchers.load(std::memory_order_acquire) == 0) {
+        return;
+    }
+    for (auto& slot : list.slots) {
+        int64_t d = slot.load(std::memory_order_acquire);
+        if (d == 0) {
+            continue;
+        }
+        auto* word = reinterpret_cast<WaitWord*>(reinterpret_cast<char*>(&list) + d);
+        word->seq.fetch_add(1, std::memory_order_seq_cst);
+        if (word->sleepers.load(std::memory_order_seq_cst) != 0) {
+            detail::futex_wake(&word->seq);
+        }
+    }
+}
+
+} // namespace zeroipc::detail
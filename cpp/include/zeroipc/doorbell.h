@@ -0,0 +1,190 @@
+#pragma once
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
+
+namespace zeroipc {
+
+/**
+ * @brief Pollable notification fd for shared-memory structures
+ *
+ * A Doorbell is a process-local file descriptor that becomes readable when a
+ * producer rings it, so a consumer can multiplex zeroipc queues and streams
+ * with sockets in one epoll/poll/io_uring loop instead of spinning.
+ *
+ * Two transports:
+ * - eventfd (Linux): create() in one process, hand the fd to the others with
+ *   send()/receive() over a Unix domain socket (SCM_RIGHTS).
+ * - named FIFO: fifo(path) in every process; the local stand-in when fd
+ *   passing is not available.
+ *
+ * The fd only carries "something happened". Which structure and whether a
+ * ring is needed is decided by a shared bell word in the structure (see
+ * Queue::attach_doorbell / Stream::attach_doorbell): producers ring only when
+ * the word goes from armed to rung, so a burst of pushes costs one write.
+ *
+ * @example
+ * ```cpp
+ * Doorbell bell = Doorbell::create();
+ * queue.attach_doorbell(&bell);             // in every producer process too
+ * epoll_ctl(ep, EPOLL_CTL_ADD, bell.fd(), &ev);
+ * // on EPOLLIN:
+ * bell.drain();
+ * queue.rearm_doorbell();                   // before draining the queue
+ * while (auto msg = queue.pop()) handle(*msg);
+ * ```
+ */
+class Doorbell {
+public:
+    // New eventfd doorbell (non-blocking, close-on-exec)
+    static Doorbell create() {
+#ifdef __linux__
+        int fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (fd < 0) {
+            throw std::runtime_error("eventfd failed: " + std::string(std::strerror(errno)));
+        }
+        return Doorbell(fd, Kind::EventFd);
+#else
+        throw std::runtime_error("eventfd doorbells require Linux; use Doorbell::fifo");
+#endif
+    }
+
+    // Named FIFO doorbell, created if missing. Opened read-write so the open
+    // never blocks and the fd never reports EOF when the other side closes.
+    static Doorbell fifo(const std::string& path) {
+        if (::mkfifo(path.c_str(), 0600) < 0 && errno != EEXIST) {
+            throw std::runtime_error("mkfifo failed: " + std::string(std::strerror(errno)));
+        }
+        int fd = ::open(path.c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+        if (fd < 0) {
+            throw std::runtime_error("Failed to open FIFO: " + std::string(std::strerror(errno)));
+        }
+        return Doorbell(fd, Kind::Fifo);
+    }
+
+    // Take ownership of an eventfd doorbell received from another process
+    static Doorbell receive(int unix_socket) {
+        char byte;
+        struct iovec iov = {&byte, 1};
+        alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(int))];
+        struct msghdr msg = {};
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+
+#ifdef MSG_CMSG_CLOEXEC
+        int flags = MSG_CMSG_CLOEXEC;
+#else
+        int flags = 0;
+#endif
+        if (::recvmsg(unix_socket, &msg, flags) < 0) {
+            throw std::runtime_error("recvmsg failed: " + std::string(std::strerror(errno)));
+        }
+        struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+        if (!cmsg || cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS) {
+            throw std::runtime_error("No doorbell fd in message");
+        }
+        int fd;
+        std::memcpy(&fd, CMSG_DATA(cmsg), sizeof(fd));
+        return Doorbell(fd, Kind::EventFd);
+    }
+
+    // Pass this doorbell's fd to another process over a Unix domain socket
+    void send(int unix_socket) const {
+        char byte = 0;
+        struct iovec iov = {&byte, 1};
+        alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+        struct msghdr msg = {};
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+
+        struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+        std::memcpy(CMSG_DATA(cmsg), &fd_, sizeof(fd_));
+
+        if (::sendmsg(unix_socket, &msg, 0) < 0) {
+            throw std::runtime_error("sendmsg failed: " + std::string(std::strerror(errno)));
+        }
+    }
+
+    Doorbell(Doorbell&& other) noexcept
+        : fd_(std::exchange(other.fd_, -1)), kind_(other.kind_) {}
+
+    Doorbell& operator=(Doorbell&& other) noexcept {
+        if (this != &other) {
+            close_fd();
+            fd_ = std::exchange(other.fd_, -1);
+            kind_ = other.kind_;
+        }
+        return *this;
+    }
+
+    Doorbell(const Doorbell&) = delete;
+    Doorbell& operator=(const Doorbell&) = delete;
+
+    ~Doorbell() { close_fd(); }
+
+    // The fd to register with epoll/poll (readable after a ring)
+    [[nodiscard]] int fd() const { return fd_; }
+
+    // Make the fd readable. A full eventfd counter or FIFO (EAGAIN) is
+    // already readable, so it is not an error.
+    void ring() const {
+        ssize_t n;
+        if (kind_ == Kind::EventFd) {
+            uint64_t one = 1;
+            n = ::write(fd_, &one, sizeof(one));
+        } else {
+            char one = 1;
+            n = ::write(fd_, &one, 1);
+        }
+        (void)n;
+    }
+
+    // Consume pending rings so the fd stops polling readable
+    void drain() const {
+        if (kind_ == Kind::EventFd) {
+            uint64_t count;
+            ssize_t n = ::read(fd_, &count, sizeof(count));
+            (void)n;
+        } else {
+            char buf[64];
+            while (::read(fd_, buf, sizeof(buf)) > 0) {
+            }
+        }
+    }
+
+private:
+    enum class Kind { EventFd, Fifo };
+
+    Doorbell(int fd, Kind kind) : fd_(fd), kind_(kind) {}
+
+    void close_fd() {
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    int fd_;
+    Kind kind_;
+};
+
+} // namespace zeroipc
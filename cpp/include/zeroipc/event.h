@@ -2,12 +2,14 @@
 
 #include <atomic>
 #include <cstdint>
+#include <string>
 #include <string_view>
 #include <chrono>
 #include <stdexcept>
 #include "memory.h"
 #include "semaphore.h"
 #include "detail/spin_wait.h"
+#include "detail/watch_list.h"
 
 namespace zeroipc {
 
@@ -27,6 +29,8 @@ enum class EventMode : uint32_t {
  * - 4 bytes: mode (AutoReset or ManualReset)
  * - 4 bytes: waiting count
  * - Variable: Semaphore (for blocking)
+ * - 64 bytes: WaitSet watch list at `name_watch` (C++ creators only, and
+ *   only for names of at most Event::MAX_WATCHED_NAME characters)
  */
 struct EventState {
     std::atomic<uint32_t> signaled{0};
@@ -64,14 +68,29 @@ static_assert(std::is_trivially_copyable_v<EventState>,
  */
 class Event {
 public:
+    /// Longest name: the `name_sem` entry must still fit a table name
+    static constexpr size_t MAX_NAME = sizeof(Table::Entry::name) - 1 - 4;
+
+    /// Longest name that also gets a `name_watch` entry. Longer names have
+    /// no watch list, so WaitSets poll them as they do events created by
+    /// other bindings.
+    static constexpr size_t MAX_WATCHED_NAME = sizeof(Table::Entry::name) - 1 - 6;
+
     /**
      * @brief Create or open an Event
      * @param mem Memory region
      * @param name Unique name for this event
      * @param mode Event mode (only used when creating new event)
+     * @throws std::invalid_argument if name is longer than MAX_NAME; nothing
+     *         is registered then
      * @throws std::runtime_error if allocation fails
      */
     Event(Memory& mem, std::string_view name, EventMode mode = EventMode::AutoReset) {
+        if (name.size() > MAX_NAME) {
+            throw std::invalid_argument("Event name too long (max " +
+                                        std::to_string(MAX_NAME) + " characters)");
+        }
+
         auto entry = mem.table()->find(name);
 
         if (entry) {
@@ -81,6 +100,16 @@ public:
             // Find the semaphore
             std::string sem_name = std::string(name) + "_sem";
             sem_ = std::make_unique<Semaphore>(mem, sem_name);
+
+            // Events created by other bindings have no watch list
+            auto watch = name.size() <= MAX_WATCHED_NAME
+                ? mem.table()->find(std::string(name) + "_watch") : nullptr;
+            if (watch) {
+                if (watch->size != sizeof(detail::WatchList)) {
+                    throw std::runtime_error("Event watch list size mismatch");
+                }
+                watch_ = mem.ptr_at<detail::WatchList>(watch->offset);
+            }
         } else {
             // Create new
             size_t total_size = sizeof(EventState);
@@ -94,6 +123,13 @@ public:
             // Create semaphore for blocking (initially locked)
             std::string sem_name = std::string(name) + "_sem";
             sem_ = std::make_unique<Semaphore>(mem, sem_name, 0);
+
+            if (name.size() <= MAX_WATCHED_NAME) {
+                size_t watch_offset = mem.allocate(std::string(name) + "_watch",
+                                                   sizeof(detail::WatchList));
+                watch_ = mem.ptr_at<detail::WatchList>(watch_offset);
+                detail::init(*watch_);
+            }
         }
     }
 
@@ -110,6 +146,11 @@ public:
             // AutoReset: also release semaphore to wake one waiter
             sem_->release();
         }
+
+        if (watch_) {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            detail::poke(*watch_);
+        }
     }
 
     /**
@@ -188,9 +229,17 @@ public:
         return state_->signaled.load(std::memory_order_acquire) == 1;
     }
 
+    /**
+     * @brief Registrations of the WaitSets watching this event
+     * @return nullptr if the event was created by another binding (WaitSets
+     *         then poll it)
+     */
+    [[nodiscard]] detail::WatchList* watch_list() { return watch_; }
+
 private:
     EventState* state_;
     std::unique_ptr<Semaphore> sem_;
+    detail::WatchList* watch_ = nullptr;
 
     bool is_manual_reset() const {
         return state_->mode == static_cast<uint32_t>(EventMode::ManualReset);
@@ -105,7 +105,7 @@ public:
         : memory_(memory), name_(name) {
         
         size_t total_size = sizeof(Header);
-        size_t offset = memory.allocate(name, total_size);
+        size_t offset = memory.allocate(name, total_size, section_align<Header>());
         
         header_ = memory.ptr_at<Header>(offset);
 
@@ -123,7 +123,7 @@ public:
         : memory_(memory), name_(name) {
         
         size_t total_size = sizeof(Header);
-        size_t offset = memory.allocate(name, total_size);
+        size_t offset = memory.allocate(name, total_size, section_align<Header>());
         
         header_ = memory.ptr_at<Header>(offset);
 
@@ -18,7 +18,7 @@ public:
     static_assert(sizeof(V) <= 8,
                   "Value type must be <= 8 bytes for lock-free atomic updates");
     static_assert(alignof(K) <= MAX_ELEM_ALIGN && alignof(V) <= MAX_ELEM_ALIGN,
-                  "Key/Value alignment exceeds the 8-byte guarantee of shared memory layout");
+                  "Key/Value alignment exceeds the largest supported allocation alignment");
 
     struct Entry {
         std::atomic<uint32_t> state;  // 0=empty, 1=occupied, 2=deleted, 3=inserting
@@ -32,6 +32,11 @@ public:
         uint32_t key_size;
         uint32_t value_size;
     };
+
+    // Data starts on the section alignment, recorded in the table entry
+    // (8 for ordinary types).
+    static constexpr size_t ALIGN = section_align<Entry>();
+    static constexpr size_t DATA_OFFSET = align_up(sizeof(Header), ALIGN);
     
     // State values for entries
     static constexpr uint32_t EMPTY = 0;
@@ -52,12 +57,12 @@ public:
         }
         
         // Check for overflow
-        if (capacity > (SIZE_MAX - sizeof(Header)) / sizeof(Entry)) {
+        if (capacity > (SIZE_MAX - DATA_OFFSET) / sizeof(Entry)) {
             throw std::overflow_error("Map capacity too large");
         }
         
-        size_t total_size = sizeof(Header) + sizeof(Entry) * capacity;
-        size_t offset = memory.allocate(name, total_size);
+        size_t total_size = DATA_OFFSET + sizeof(Entry) * capacity;
+        size_t offset = memory.allocate(name, total_size, ALIGN);
         
         header_ = memory.ptr_at<Header>(offset);
 
@@ -68,7 +73,7 @@ public:
         header_->value_size = sizeof(V);
         
         entries_ = reinterpret_cast<Entry*>(
-            reinterpret_cast<char*>(header_) + sizeof(Header));
+            reinterpret_cast<char*>(header_) + DATA_OFFSET);
         
         // Initialize all entries as empty
         for (size_t i = 0; i < capacity; ++i) {
@@ -80,19 +85,22 @@ public:
     Map(Memory& memory, std::string_view name)
         : memory_(memory), name_(name) {
         
-        size_t offset, size;
-        if (!memory.find(name, offset, size)) {
+        auto* entry = memory.table()->find(name);
+        if (!entry) {
             throw std::runtime_error("Map not found: " + std::string(name));
         }
-        
-        header_ = memory.ptr_at<Header>(offset);
+        if (entry->section_align() != ALIGN) {
+            throw std::runtime_error("Alignment mismatch");
+        }
+
+        header_ = memory.ptr_at<Header>(entry->offset);
 
         if (header_->key_size != sizeof(K) || header_->value_size != sizeof(V)) {
             throw std::runtime_error("Type size mismatch");
         }
         
         entries_ = reinterpret_cast<Entry*>(
-            reinterpret_cast<char*>(header_) + sizeof(Header));
+            reinterpret_cast<char*>(header_) + DATA_OFFSET);
     }
     
     // Insert or update (lock-free with linear probing)
@@ -0,0 +1,261 @@
+#pragma once
+
+#include "memory.h"
+#include "detail/futex.h"
+#include "detail/hash.h"
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <unistd.h>
+
+namespace zeroipc {
+
+/**
+ * @brief Fair queue-based (MCS) mutex across processes
+ *
+ * Mutex lets every waiter retry a CAS on one shared count, so under
+ * contention they all hammer the same cache line and whoever happens to
+ * retry first wins. MCSMutex queues waiters instead: a locker takes a node
+ * from a pool in shared memory, swaps its index into the lock's tail and
+ * links itself behind the previous tail. It then waits on its own node,
+ * one cache line each, spinning briefly and then sleeping on the node's
+ * futex word. unlock() hands the lock directly to the next node in line,
+ * so acquisition is FIFO and each hand-off touches only the two nodes
+ * involved.
+ *
+ * Nodes are referred to by index, so the queue works across processes
+ * mapping the segment at different addresses. A thread first tries the
+ * node its thread hash points at, so a thread usually reuses the same,
+ * already cached, node. If more threads try to lock at once than there
+ * are nodes, the surplus wait for a node to come free.
+ *
+ * A queued waiter cannot leave the queue, so there is no try_lock_for;
+ * try_lock only succeeds when nobody holds or waits for the lock. As with
+ * Mutex, a process that dies holding or waiting for the lock blocks it.
+ *
+ * Satisfies Lockable, so std::lock_guard and std::unique_lock work.
+ *
+ * @layout [Header(16) | pad to 64][Node(64) * nodes]
+ */
+class MCSMutex {
+public:
+    static constexpr uint32_t DEFAULT_NODES = 256;
+    static constexpr uint32_t MAX_NODES = 65536;
+
+    struct Header {
+        std::atomic<uint32_t> tail;    // Last queued node + 1, 0 when unlocked
+        uint32_t nodes;
+        std::atomic<uint32_t> holder;  // Node of the current holder
+        uint32_t reserved;
+    };
+
+    struct alignas(CACHE_LINE_SIZE) Node {
+        std::atomic<uint32_t> in_use;  // Claimed by a locker
+        std::atomic<uint32_t> next;    // Successor + 1, 0 while none
+        std::atomic<uint32_t> state;   // WAITING, PARKED or GRANTED (futex word)
+    };
+
+    static constexpr size_t NODES_OFFSET = align_up(sizeof(Header), CACHE_LINE_SIZE);
+
+    /**
+     * @brief Create or open an MCSMutex
+     * @param mem Memory region
+     * @param name Unique name for this mutex
+     * @param nodes Queue nodes when creating (0 means DEFAULT_NODES): the
+     *        most threads that can be queued at once. When opening, 0 or
+     *        the count it was created with.
+     * @throws std::invalid_argument if nodes exceeds MAX_NODES
+     * @throws std::runtime_error on a node count or layout mismatch
+     */
+    MCSMutex(Memory& mem, std::string_view name, size_t nodes = 0) {
+        if (nodes > MAX_NODES) {
+            throw std::invalid_argument("MCSMutex nodes exceed MAX_NODES");
+        }
+
+        auto* entry = mem.table()->find(name);
+        if (entry) {
+            // Open existing
+            header_ = mem.ptr_at<Header>(entry->offset);
+            if (header_->nodes == 0 || header_->nodes > MAX_NODES ||
+                NODES_OFFSET + sizeof(Node) * header_->nodes > entry->size) {
+                throw std::runtime_error("MCSMutex header is corrupt");
+            }
+            if (nodes != 0 && nodes != header_->nodes) {
+                throw std::runtime_error("MCSMutex node count mismatch");
+            }
+            bind();
+        } else {
+            // Create new
+            if (nodes == 0) {
+                nodes = DEFAULT_NODES;
+            }
+            size_t offset = mem.allocate(name, NODES_OFFSET + sizeof(Node) * nodes,
+                                         CACHE_LINE_SIZE);
+            header_ = mem.ptr_at<Header>(offset);
+            header_->tail.store(0, std::memory_order_relaxed);
+            header_->nodes = static_cast<uint32_t>(nodes);
+            header_->holder.store(0, std::memory_order_relaxed);
+            header_->reserved = 0;
+            bind();
+            for (size_t i = 0; i < nodes; ++i) {
+                new (&nodes_[i]) Node{};
+            }
+        }
+    }
+
+    /**
+     * @brief Lock the mutex, queueing behind earlier lockers
+     */
+    void lock() {
+        uint32_t me = claim_node();
+        Node& node = nodes_[me];
+        node.next.store(0, std::memory_order_relaxed);
+        node.state.store(WAITING, std::memory_order_relaxed);
+
+        uint32_t prev = header_->tail.exchange(me + 1, std::memory_order_acq_rel);
+        if (prev != 0) {
+            nodes_[prev - 1].next.store(me + 1, std::memory_order_release);
+            wait_for_grant(node);
+        }
+        header_->holder.store(me, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Lock only if nobody holds or waits for the mutex
+     * @return true if the lock was acquired
+     */
+    [[nodiscard]] bool try_lock() {
+        if (header_->tail.load(std::memory_order_relaxed) != 0) {
+            return false;
+        }
+        uint32_t me = claim_node();
+        nodes_[me].next.store(0, std::memory_order_relaxed);
+        uint32_t expected = 0;
+        if (!header_->tail.compare_exchange_strong(expected, me + 1,
+                                                   std::memory_order_acquire,
+                                                   std::memory_order_relaxed)) {
+            release_node(me);
+            return false;
+        }
+        header_->holder.store(me, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief Unlock the mutex, handing it to the next waiter if any
+     *
+     * Must be called by the thread that locked it.
+     */
+    void unlock() {
+        uint32_t me = header_->holder.load(std::memory_order_relaxed);
+        Node& node = nodes_[me];
+
+        uint32_t next = node.next.load(std::memory_order_acquire);
+        if (next == 0) {
+            uint32_t expected = me + 1;
+            if (header_->tail.compare_exchange_strong(expected, 0,
+                                                      std::memory_order_release,
+                                                      std::memory_order_relaxed)) {
+                release_node(me);
+                return;
+            }
+            // A locker swapped itself into the tail and is linking behind us
+            for (int spins = 0; (next = node.next.load(std::memory_order_acquire)) == 0; ++spins) {
+                if (spins >= SPIN_LIMIT) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        release_node(me);
+        grant(nodes_[next - 1]);
+    }
+
+    // Whether anyone holds (or waits for) the mutex
+    [[nodiscard]] bool is_locked() const {
+        return header_->tail.load(std::memory_order_relaxed) != 0;
+    }
+
+    [[nodiscard]] size_t nodes() const { return header_->nodes; }
+
+    MCSMutex(const MCSMutex&) = delete;
+    MCSMutex& operator=(const MCSMutex&) = delete;
+
+private:
+    static constexpr int SPIN_LIMIT = 128;
+    static constexpr uint32_t WAITING = 0;
+    static constexpr uint32_t PARKED = 1;
+    static constexpr uint32_t GRANTED = 2;
+
+    Header* header_ = nullptr;
+    Node* nodes_ = nullptr;
+
+    void bind() {
+        nodes_ = reinterpret_cast<Node*>(reinterpret_cast<char*>(header_) + NODES_OFFSET);
+    }
+
+    // Claim a free node, starting at this thread's preferred one
+    uint32_t claim_node() {
+        uint32_t count = header_->nodes;
+        uint32_t start = preferred_node();
+        for (int spins = 0;; ++spins) {
+            for (uint32_t i = 0; i < count; ++i) {
+                uint32_t index = (start + i) % count;
+                if (nodes_[index].in_use.load(std::memory_order_relaxed) == 0 &&
+                    nodes_[index].in_use.exchange(1, std::memory_order_acquire) == 0) {
+                    return index;
+                }
+            }
+            if (spins >= SPIN_LIMIT) {
+                std::this_thread::yield();  // More lockers than nodes
+            }
+        }
+    }
+
+    void release_node(uint32_t index) {
+        nodes_[index].in_use.store(0, std::memory_order_release);
+    }
+
+    // Spin on our own node, then sleep on its futex word until granted
+    static void wait_for_grant(Node& node) {
+        for (int spin = 0; spin < SPIN_LIMIT; ++spin) {
+            if (node.state.load(std::memory_order_acquire) == GRANTED) {
+                return;
+            }
+            std::this_thread::yield();
+        }
+        for (;;) {
+            uint32_t state = WAITING;
+            if (!node.state.compare_exchange_strong(state, PARKED,
+                                                    std::memory_order_acquire,
+                                                    std::memory_order_acquire) &&
+                state == GRANTED) {
+                return;
+            }
+            detail::futex_wait(&node.state, PARKED, std::chrono::milliseconds(100));
+            if (node.state.load(std::memory_order_acquire) == GRANTED) {
+                return;
+            }
+        }
+    }
+
+    // Hand the lock to a waiter, waking it only if it went to sleep. The
+    // waiter may reuse its node as soon as it sees GRANTED, so at worst the
+    // wake is spurious for the node's next owner.
+    static void grant(Node& node) {
+        if (node.state.exchange(GRANTED, std::memory_order_release) == PARKED) {
+            detail::futex_wake(&node.state, 1);
+        }
+    }
+
+    uint32_t preferred_node() const {
+        thread_local const size_t thread_hash = detail::trivial_hash(
+            std::hash<std::thread::id>{}(std::this_thread::get_id()) ^
+            (static_cast<size_t>(::getpid()) << 32)) >> 16;
+        return static_cast<uint32_t>(thread_hash % header_->nodes);
+    }
+};
+
+} // namespace zeroipc
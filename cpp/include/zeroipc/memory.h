@@ -8,6 +8,7 @@
 #include <string>
 #include <stdexcept>
 #include <memory>
+#include <algorithm>
 #include <cerrno>
 #include <cstring>
 
@@ -166,20 +167,26 @@ public:
     
     /**
      * Allocate space in shared memory
+     *
+     * The base is always placed on its own cache line (or on `alignment` if
+     * larger), so the header atomics of adjacent structures never share a
+     * line. `alignment` is recorded in the table entry as the structure's
+     * section alignment.
+     *
      * @param name Name for the table entry
      * @param size Size to allocate
+     * @param alignment Section alignment (power of two, at most MAX_ALLOC_ALIGN)
      * @return Offset of allocated space
      */
-    size_t allocate(std::string_view name, size_t size) {
-        // First allocate the space
-        uint64_t offset = table_->allocate(size);
-        
-        // Then add to table
-        if (!table_->add(name, offset, size)) {
+    size_t allocate(std::string_view name, size_t size,
+                    size_t alignment = MIN_SECTION_ALIGN) {
+        // Claim the name first, so a failed registration takes no space
+        auto offset = table_->allocate_entry(name, size, alignment);
+        if (!offset) {
             throw std::runtime_error("Failed to add entry to table");
         }
         
-        return offset;
+        return *offset;
     }
     
     /**
@@ -1,15 +1,36 @@
 #pragma once
 
+#include <atomic>
+#include <climits>
 #include <string_view>
 #include <chrono>
 #include <functional>
 #include <stdexcept>
+#include <thread>
 #include "memory.h"
-#include "mutex.h"
-#include "semaphore.h"
+#include "detail/futex.h"
 
 namespace zeroipc {
 
+/**
+ * @brief Monitor state for shared memory
+ *
+ * Binary layout:
+ * - 4 bytes: lock word (futex): 0 unlocked, 1 locked, 2 locked and
+ *   threads may be sleeping on it
+ * - 4 bytes: condition sequence (futex), bumped by every notify
+ * - 4 bytes: number of threads in wait()
+ * - 4 bytes: reserved
+ */
+struct MonitorState {
+    std::atomic<uint32_t> lock{0};
+    std::atomic<uint32_t> seq{0};
+    std::atomic<uint32_t> waiters{0};
+    uint32_t reserved{0};
+};
+
+static_assert(sizeof(MonitorState) == 16, "MonitorState must be 16 bytes");
+
 /**
  * @brief Monitor for condition variable synchronization across processes
  *
@@ -24,10 +45,16 @@ namespace zeroipc {
  * - notify_all() to wake all waiters
  * - Predicate-based waiting (handles spurious wakeups)
  *
- * Binary layout:
- * - Mutex (via Semaphore)
- * - Semaphore for condition signaling
- * - Atomic counter for waiting threads
+ * Both the lock and the condition are futex words. wait() reads the
+ * condition sequence while still holding the lock and sleeps only while
+ * it is unchanged, so a notify between unlocking and sleeping is never
+ * lost. notify_one() and notify_all() bump the sequence and make a
+ * syscall only when someone is waiting. notify_all() wakes one waiter and
+ * requeues the rest onto the lock word (FUTEX_CMP_REQUEUE), so they are
+ * woken one at a time as the lock is released instead of all at once to
+ * fight over it.
+ *
+ * Binary layout: MonitorState (16 bytes) at `name`
  *
  * Example:
  * @code
@@ -57,38 +84,22 @@ public:
      * @brief Create or open a Monitor
      * @param mem Memory region
      * @param name Unique name for this monitor
-     * @throws std::runtime_error if allocation fails
+     * @throws std::runtime_error if allocation fails or the existing entry
+     *         is not a Monitor of this layout
      */
-    Monitor(Memory& mem, std::string_view name) : mem_(mem) {
-        std::string mutex_name = std::string(name) + "_mtx";
-        std::string cond_name = std::string(name) + "_cond";
-        std::string counter_name = std::string(name) + "_count";
-
-        auto entry = mem.table()->find(name);
+    Monitor(Memory& mem, std::string_view name) {
+        auto* entry = mem.table()->find(name);
 
         if (entry) {
             // Open existing
-            mutex_ = std::make_unique<Mutex>(mem, mutex_name);
-            cond_sem_ = std::make_unique<Semaphore>(mem, cond_name);
-
-            auto counter_entry = mem.table()->find(counter_name);
-            if (!counter_entry) {
-                throw std::runtime_error("Monitor counter not found");
+            if (entry->size != sizeof(MonitorState)) {
+                throw std::runtime_error("Monitor state size mismatch");
             }
-            waiting_count_ = mem.ptr_at<std::atomic<uint32_t>>(counter_entry->offset);
+            state_ = mem.ptr_at<MonitorState>(entry->offset);
         } else {
             // Create new
-            mutex_ = std::make_unique<Mutex>(mem, mutex_name);
-            cond_sem_ = std::make_unique<Semaphore>(mem, cond_name, 0);  // Initially blocked
-
-            // Create waiting counter
-            size_t counter_offset = mem.allocate(counter_name, sizeof(std::atomic<uint32_t>));
-            waiting_count_ = mem.ptr_at<std::atomic<uint32_t>>(counter_offset);
-            new (waiting_count_) std::atomic<uint32_t>(0);
-
-            // Add monitor entry to table (just a marker)
-            size_t marker_offset = mem.allocate(name, 1);
-            (void)marker_offset;
+            size_t offset = mem.allocate(name, sizeof(MonitorState), CACHE_LINE_SIZE);
+            state_ = new (mem.ptr_at<MonitorState>(offset)) MonitorState();
         }
     }
 
@@ -98,14 +109,29 @@ public:
      * Must be called before wait() or accessing shared data.
      */
     void lock() {
-        mutex_->lock();
+        uint32_t c = UNLOCKED;
+        if (state_->lock.compare_exchange_strong(c, LOCKED, std::memory_order_acquire,
+                                                 std::memory_order_relaxed)) {
+            return;
+        }
+        for (int spin = 0; spin < SPIN_LIMIT; ++spin) {
+            std::this_thread::yield();
+            c = UNLOCKED;
+            if (state_->lock.compare_exchange_weak(c, LOCKED, std::memory_order_acquire,
+                                                   std::memory_order_relaxed)) {
+                return;
+            }
+        }
+        lock_contended();
     }
 
     /**
      * @brief Unlock the monitor's mutex
      */
     void unlock() {
-        mutex_->unlock();
+        if (state_->lock.exchange(UNLOCKED, std::memory_order_release) == CONTENDED) {
+            detail::futex_wake(&state_->lock, 1);
+        }
     }
 
     /**
@@ -113,7 +139,9 @@ public:
      * @return true if lock acquired, false otherwise
      */
     [[nodiscard]] bool try_lock() {
-        return mutex_->try_lock();
+        uint32_t c = UNLOCKED;
+        return state_->lock.compare_exchange_strong(c, LOCKED, std::memory_order_acquire,
+                                                    std::memory_order_relaxed);
     }
 
     /**
@@ -126,17 +154,7 @@ public:
      * WARNING: Spurious wakeups can occur - use predicate version for safety.
      */
     void wait() {
-        waiting_count_->fetch_add(1, std::memory_order_release);
-
-        // Release lock and wait
-        mutex_->unlock();
-        cond_sem_->acquire();
-
-        // Reacquire lock
-        mutex_->lock();
-
-        // Decrement AFTER reacquiring lock to avoid race with notify
-        waiting_count_->fetch_sub(1, std::memory_order_release);
+        wait_until_notified(std::chrono::steady_clock::time_point::max());
     }
 
     /**
@@ -177,16 +195,10 @@ public:
         auto deadline = std::chrono::steady_clock::now() + timeout;
 
         while (!pred()) {
-            auto now = std::chrono::steady_clock::now();
-            if (now >= deadline) {
+            if (std::chrono::steady_clock::now() >= deadline) {
                 return false;  // Timeout
             }
-
-            auto remaining = deadline - now;
-            if (!wait_for_impl(remaining)) {
-                // Timeout, but check predicate one last time
-                return pred();
-            }
+            wait_until_notified(deadline);
         }
 
         return true;
@@ -197,52 +209,89 @@ public:
      *
      * If multiple threads are waiting, wakes one arbitrarily.
      * If no threads are waiting, the signal is ignored (not queued).
-     * This prevents permit accumulation that causes CPU spinning.
      */
     void notify_one() {
-        // Only release if someone is actually waiting on the semaphore
-        // This prevents permit accumulation while the predicate loop handles spurious wakeups
-        if (cond_sem_->waiting() > 0 || waiting_count_->load(std::memory_order_acquire) > 0) {
-            cond_sem_->release();
+        state_->seq.fetch_add(1, std::memory_order_seq_cst);
+        if (state_->waiters.load(std::memory_order_seq_cst) != 0) {
+            detail::futex_wake(&state_->seq, 1);
         }
     }
 
     /**
      * @brief Wake all waiting threads/processes
      *
-     * Wakes all currently waiting threads. New waiters are not affected.
+     * Wakes one waiter and moves the others onto the lock, which hands
+     * itself to them one by one. New waiters are not affected. The requeue
+     * only happens while the lock is held (the usual way to call this);
+     * otherwise all waiters are woken directly.
      */
     void notify_all() {
-        uint32_t count = waiting_count_->load(std::memory_order_acquire);
-        for (uint32_t i = 0; i < count; i++) {
-            cond_sem_->release();
+        uint32_t seq = state_->seq.fetch_add(1, std::memory_order_seq_cst) + 1;
+        if (state_->waiters.load(std::memory_order_seq_cst) == 0) {
+            return;
+        }
+
+        // Requeued waiters sleep on the lock word, so unlock() must know to
+        // wake them: mark the lock contended, if it is held at all
+        uint32_t c = state_->lock.load(std::memory_order_relaxed);
+        while (c == LOCKED &&
+               !state_->lock.compare_exchange_weak(c, CONTENDED, std::memory_order_relaxed)) {
+        }
+        if (c == UNLOCKED ||
+            !detail::futex_cmp_requeue(&state_->seq, seq, 1, INT_MAX, &state_->lock)) {
+            detail::futex_wake(&state_->seq);
+            return;
+        }
+        // The holder may have unlocked between marking and requeueing
+        if (state_->lock.load(std::memory_order_seq_cst) == UNLOCKED) {
+            detail::futex_wake(&state_->lock, 1);
         }
     }
 
+    // Prevent copying
+    Monitor(const Monitor&) = delete;
+    Monitor& operator=(const Monitor&) = delete;
+
 private:
-    template<typename Rep, typename Period>
-    bool wait_for_impl(const std::chrono::duration<Rep, Period>& timeout) {
-        waiting_count_->fetch_add(1, std::memory_order_release);
+    static constexpr uint32_t UNLOCKED = 0;
+    static constexpr uint32_t LOCKED = 1;
+    static constexpr uint32_t CONTENDED = 2;  // Locked, sleepers may be queued
+    static constexpr int SPIN_LIMIT = 128;
+
+    // Longest single sleep on the lock word, so a wake-up lost to a process
+    // that died mid-unlock costs a delay rather than a hang
+    static constexpr auto PARK_SLICE = std::chrono::milliseconds(100);
 
-        // Release lock and wait with timeout
-        mutex_->unlock();
+    MonitorState* state_ = nullptr;
 
-        auto timeout_ms = std::chrono::duration_cast<std::chrono::milliseconds>(timeout);
-        bool acquired = cond_sem_->acquire_for(timeout_ms);
+    // Sleep on the lock word; anyone who finds it CONTENDED on unlock
+    // wakes one sleeper. Taking it as CONTENDED (not LOCKED) keeps others
+    // that may be asleep behind us from being forgotten.
+    void lock_contended() {
+        while (state_->lock.exchange(CONTENDED, std::memory_order_acquire) != UNLOCKED) {
+            detail::futex_wait(&state_->lock, CONTENDED, PARK_SLICE);
+        }
+    }
 
-        // Reacquire lock
-        mutex_->lock();
+    // Called holding the lock. Read the sequence before releasing it so a
+    // notify in between makes the futex return at once instead of sleeping.
+    void wait_until_notified(std::chrono::steady_clock::time_point deadline) {
+        uint32_t seq = state_->seq.load(std::memory_order_relaxed);
+        state_->waiters.fetch_add(1, std::memory_order_seq_cst);
+        unlock();
 
-        // Decrement AFTER reacquiring lock
-        waiting_count_->fetch_sub(1, std::memory_order_release);
+        auto now = std::chrono::steady_clock::now();
+        if (now < deadline) {
+            auto left = deadline == std::chrono::steady_clock::time_point::max()
+                ? std::chrono::steady_clock::duration(std::chrono::hours(24))
+                : deadline - now;
+            detail::futex_wait(&state_->seq, seq, left);
+        }
 
-        return acquired;
+        state_->waiters.fetch_sub(1, std::memory_order_relaxed);
+        // We may have been requeued behind other sleepers on the lock word
+        lock_contended();
     }
-
-    Memory& mem_;
-    std::unique_ptr<Mutex> mutex_;
-    std::unique_ptr<Semaphore> cond_sem_;
-    std::atomic<uint32_t>* waiting_count_;
 };
 
 } // namespace zeroipc
@@ -2,17 +2,59 @@
 
 #include "memory.h"
 #include <atomic>
+#include <cerrno>
 #include <optional>
+#include <signal.h>
 
 namespace zeroipc {
 
+template<typename T> class PoolCache;
+
+// Header layout of a Pool, chosen at creation and recorded in the high byte
+// of the header's elem_size field (older readers see a size mismatch and
+// refuse the pool rather than misread it).
+//   Compact:    free_head and allocated live in the 24-byte header
+//   PaddedHead: free_head and allocated live on a cache line of their own,
+//               away from the read-mostly capacity and elem_size. C++
+//               creators use it unless told otherwise.
+enum class PoolLayout : uint32_t {
+    Compact = 0,
+    PaddedHead = 0x04000000,
+};
+
+inline constexpr uint32_t POOL_ELEM_SIZE_MASK = 0x00FFFFFF;
+inline constexpr uint32_t POOL_LAYOUT_PADDED_HEAD = 0x04000000;
+
+// With PaddedHead, free_head and allocated live at these offsets instead of
+// in the header (where they stay zero), and nodes start after them.
+inline constexpr size_t POOL_PADDED_HEAD_OFFSET = CACHE_LINE_SIZE;
+inline constexpr size_t POOL_PADDED_ALLOCATED_OFFSET = CACHE_LINE_SIZE + 8;
+inline constexpr size_t POOL_PADDED_HEADER_SIZE = 2 * CACHE_LINE_SIZE;
+
+/**
+ * @brief Lock-free fixed-size object pool
+ *
+ * A free list threaded through the nodes, headed by a tagged (generation,
+ * index) word so the CAS is ABA-safe.
+ *
+ * @layout
+ *   [Header(24) | head line if PaddedHead][pad to section alignment][Node * capacity]
+ *   [owners: u32 * capacity] -- optional, see track_owners
+ *
+ * The owner block is present iff the entry is large enough to hold it. It
+ * records, per node, the pid of the process whose PoolCache magazine holds
+ * it (0 = not cached), so the magazines of a crashed process can be
+ * returned with reclaim_dead().
+ */
 template<typename T>
 class Pool {
 public:
     static_assert(std::is_trivially_copyable_v<T>,
                   "T must be trivially copyable for shared memory");
     static_assert(alignof(T) <= MAX_ELEM_ALIGN,
-                  "T alignment exceeds the 8-byte guarantee of shared memory layout");
+                  "T alignment exceeds the largest supported allocation alignment");
+    static_assert(sizeof(T) <= POOL_ELEM_SIZE_MASK,
+                  "Pool elements are limited to 16 MB");
 
     struct Node {
         T data;
@@ -24,9 +66,19 @@ public:
         std::atomic<uint32_t> allocated;  // Number of allocated items
         uint32_t padding_;  // Alignment padding (was part of old free_head slot)
         uint32_t capacity;
-        uint32_t elem_size;
+        uint32_t elem_size;  // Bits 0-23: sizeof(T), bits 24-31: PoolLayout
     };
 
+    // Data starts on the section alignment, recorded in the table entry
+    // (8 for ordinary types).
+    static constexpr size_t ALIGN = section_align<Node>();
+    static constexpr size_t DATA_OFFSET = align_up(sizeof(Header), ALIGN);  // Compact
+
+    static constexpr size_t data_offset(uint32_t layout) {
+        return (layout & POOL_LAYOUT_PADDED_HEAD)
+            ? align_up(POOL_PADDED_HEADER_SIZE, ALIGN) : DATA_OFFSET;
+    }
+
     static constexpr uint32_t NULL_INDEX = 0xFFFFFFFF;
 
     // Tagged pointer helpers to prevent ABA problem
@@ -42,21 +94,29 @@ public:
         return static_cast<uint32_t>(tagged >> 32);
     }
 
-    // Create new pool
-    Pool(Memory& memory, std::string_view name, size_t capacity)
+    // Create new pool. track_owners adds the owner records PoolCache uses
+    // to make cached nodes reclaimable after a crash.
+    Pool(Memory& memory, std::string_view name, size_t capacity,
+         PoolLayout layout = PoolLayout::PaddedHead, bool track_owners = false)
         : memory_(memory), name_(name) {
 
         if (capacity == 0) {
             throw std::invalid_argument("Pool capacity must be greater than 0");
         }
 
+        const uint32_t flags = static_cast<uint32_t>(layout);
+        const size_t data_off = data_offset(flags);
+
         // Check for overflow
-        if (capacity > (SIZE_MAX - sizeof(Header)) / sizeof(Node)) {
+        if (capacity > (SIZE_MAX - data_off) / sizeof(Node)) {
             throw std::overflow_error("Pool capacity too large");
         }
 
-        size_t total_size = sizeof(Header) + sizeof(Node) * capacity;
-        size_t offset = memory.allocate(name, total_size);
+        size_t total_size = data_off + sizeof(Node) * capacity;
+        if (track_owners) {
+            total_size = owners_offset(capacity, flags) + sizeof(std::atomic<uint32_t>) * capacity;
+        }
+        size_t offset = memory.allocate(name, total_size, ALIGN);
 
         header_ = memory.ptr_at<Header>(offset);
 
@@ -65,35 +125,58 @@ public:
         header_->allocated.store(0, std::memory_order_relaxed);
         header_->padding_ = 0;
         header_->capacity = capacity;
-        header_->elem_size = sizeof(T);
+        header_->elem_size = sizeof(T) | flags;
+        bind_head(flags);
+        free_head_->store(pack_tagged(0, 0), std::memory_order_relaxed);
+        allocated_->store(0, std::memory_order_relaxed);
 
         nodes_ = reinterpret_cast<Node*>(
-            reinterpret_cast<char*>(header_) + sizeof(Header));
+            reinterpret_cast<char*>(header_) + data_off);
 
         // Initialize free list - all nodes are free
         for (uint32_t i = 0; i < capacity - 1; ++i) {
             nodes_[i].next.store(i + 1, std::memory_order_relaxed);
         }
         nodes_[capacity - 1].next.store(NULL_INDEX, std::memory_order_relaxed);
+
+        if (track_owners) {
+            bind_owners(flags);
+            for (size_t i = 0; i < capacity; ++i) {
+                owners_[i].store(0, std::memory_order_relaxed);
+            }
+        }
     }
 
     // Open existing pool
     Pool(Memory& memory, std::string_view name)
         : memory_(memory), name_(name) {
 
-        size_t offset, size;
-        if (!memory.find(name, offset, size)) {
+        auto* entry = memory.table()->find(name);
+        if (!entry) {
             throw std::runtime_error("Pool not found: " + std::string(name));
         }
+        if (entry->section_align() != ALIGN) {
+            throw std::runtime_error("Alignment mismatch");
+        }
 
-        header_ = memory.ptr_at<Header>(offset);
+        header_ = memory.ptr_at<Header>(entry->offset);
 
-        if (header_->elem_size != sizeof(T)) {
+        const uint32_t flags = header_->elem_size & ~POOL_ELEM_SIZE_MASK;
+        if ((header_->elem_size & POOL_ELEM_SIZE_MASK) != sizeof(T)) {
             throw std::runtime_error("Type size mismatch");
         }
+        if (flags & ~POOL_LAYOUT_PADDED_HEAD) {
+            throw std::runtime_error("Unknown pool layout");
+        }
+        bind_head(flags);
 
         nodes_ = reinterpret_cast<Node*>(
-            reinterpret_cast<char*>(header_) + sizeof(Header));
+            reinterpret_cast<char*>(header_) + data_offset(flags));
+
+        if (entry->size >= owners_offset(header_->capacity, flags) +
+                           sizeof(std::atomic<uint32_t>) * header_->capacity) {
+            bind_owners(flags);
+        }
     }
 
     // Allocate an object from the pool (lock-free, ABA-safe)
@@ -103,7 +186,7 @@ public:
 
         // Try to get a free node using tagged pointer CAS
         do {
-            old_head = header_->free_head.load(std::memory_order_acquire);
+            old_head = free_head_->load(std::memory_order_acquire);
             uint32_t free_index = unpack_index(old_head);
             uint32_t generation = unpack_generation(old_head);
 
@@ -117,12 +200,12 @@ public:
             new_head = pack_tagged(next, generation + 1);
 
             // Try to update the free head (tagged CAS prevents ABA)
-            if (header_->free_head.compare_exchange_weak(
+            if (free_head_->compare_exchange_weak(
                     old_head, new_head,
                     std::memory_order_release,
                     std::memory_order_acquire)) {
                 // Success - we got the node
-                header_->allocated.fetch_add(1, std::memory_order_relaxed);
+                allocated_->fetch_add(1, std::memory_order_relaxed);
                 return &nodes_[free_index].data;
             }
         } while (true);
@@ -132,21 +215,14 @@ public:
     void deallocate(T* ptr) {
         if (!ptr) return;
 
-        // Calculate the node index from the pointer
-        Node* node = reinterpret_cast<Node*>(
-            reinterpret_cast<char*>(ptr) - offsetof(Node, data));
-        uint32_t node_index = node - nodes_;
-
-        // Validate the index
-        if (node_index >= header_->capacity) {
-            throw std::invalid_argument("Invalid pointer to deallocate");
-        }
+        uint32_t node_index = index_of(ptr);
+        Node* node = &nodes_[node_index];
 
         // Add the node back to the free list using tagged CAS
         uint64_t old_head;
         uint64_t new_head;
         do {
-            old_head = header_->free_head.load(std::memory_order_acquire);
+            old_head = free_head_->load(std::memory_order_acquire);
             uint32_t old_index = unpack_index(old_head);
             uint32_t generation = unpack_generation(old_head);
 
@@ -154,14 +230,122 @@ public:
 
             // Pack new head with bumped generation to prevent ABA
             new_head = pack_tagged(node_index, generation + 1);
-        } while (!header_->free_head.compare_exchange_weak(
+        } while (!free_head_->compare_exchange_weak(
                     old_head, new_head,
                     std::memory_order_release,
                     std::memory_order_acquire));
 
-        header_->allocated.fetch_sub(1, std::memory_order_relaxed);
+        allocated_->fetch_sub(1, std::memory_order_relaxed);
     }
     
+    // Allocate up to n objects by unlinking a chain of free nodes with one
+    // tagged CAS. Writes the pointers to out and returns how many were
+    // taken (fewer than n only when the free list runs short).
+    [[nodiscard]] size_t allocate_n(T** out, size_t n) {
+        if (n == 0) return 0;
+
+        uint64_t old_head = free_head_->load(std::memory_order_acquire);
+        for (;;) {
+            uint32_t index = unpack_index(old_head);
+            size_t taken = 0;
+
+            // Walk the first n nodes. The walk may see a list that changes
+            // under it; the CAS below only succeeds if it did not.
+            while (taken < n && index < header_->capacity) {
+                out[taken++] = &nodes_[index].data;
+                index = nodes_[index].next.load(std::memory_order_relaxed);
+            }
+            if (taken == 0) {
+                return 0;  // Pool is full
+            }
+
+            uint64_t new_head = pack_tagged(index, unpack_generation(old_head) + 1);
+            if (free_head_->compare_exchange_weak(
+                    old_head, new_head,
+                    std::memory_order_release,
+                    std::memory_order_acquire)) {
+                allocated_->fetch_add(static_cast<uint32_t>(taken),
+                                             std::memory_order_relaxed);
+                return taken;
+            }
+        }
+    }
+
+    // Return n objects with one tagged CAS: the nodes are linked into a
+    // private chain first, then the chain is spliced onto the free list.
+    void deallocate_n(T* const* ptrs, size_t n) {
+        uint32_t first = NULL_INDEX;
+        Node* last = nullptr;
+        size_t count = 0;
+
+        for (size_t i = 0; i < n; ++i) {
+            if (!ptrs[i]) continue;
+            uint32_t index = index_of(ptrs[i]);
+            if (last) {
+                last->next.store(index, std::memory_order_relaxed);
+            } else {
+                first = index;
+            }
+            last = &nodes_[index];
+            ++count;
+        }
+        if (count == 0) return;
+
+        uint64_t old_head = free_head_->load(std::memory_order_acquire);
+        uint64_t new_head;
+        do {
+            last->next.store(unpack_index(old_head), std::memory_order_relaxed);
+            new_head = pack_tagged(first, unpack_generation(old_head) + 1);
+        } while (!free_head_->compare_exchange_weak(
+                    old_head, new_head,
+                    std::memory_order_release,
+                    std::memory_order_acquire));
+
+        allocated_->fetch_sub(static_cast<uint32_t>(count),
+                                     std::memory_order_relaxed);
+    }
+
+    // Return every node a PoolCache of process pid held (see the owner
+    // records above). Only safe once that process is gone. Returns the
+    // number of nodes put back on the free list.
+    size_t reclaim(uint32_t pid) {
+        if (!owners_ || pid == 0) return 0;
+
+        constexpr size_t BATCH = 64;
+        T* batch[BATCH];
+        size_t n = 0, total = 0;
+        for (uint32_t i = 0; i < header_->capacity; ++i) {
+            uint32_t owner = pid;
+            if (owners_[i].compare_exchange_strong(owner, 0, std::memory_order_acq_rel)) {
+                batch[n++] = &nodes_[i].data;
+                if (n == BATCH) {
+                    deallocate_n(batch, n);
+                    total += n;
+                    n = 0;
+                }
+            }
+        }
+        deallocate_n(batch, n);
+        return total + n;
+    }
+
+    // Reclaim the magazines of every owner process that no longer exists
+    size_t reclaim_dead() {
+        if (!owners_) return 0;
+
+        size_t total = 0;
+        for (uint32_t i = 0; i < header_->capacity; ++i) {
+            uint32_t owner = owners_[i].load(std::memory_order_acquire);
+            if (owner != 0 && ::kill(static_cast<pid_t>(owner), 0) == -1 && errno == ESRCH) {
+                total += reclaim(owner);
+            }
+        }
+        return total;
+    }
+
+    // Whether the pool keeps owner records (created with track_owners)
+    [[nodiscard]] bool tracks_owners() const { return owners_ != nullptr; }
+
     // Construct an object in the pool
     template<typename... Args>
     [[nodiscard]] std::optional<T*> construct(Args&&... args) {
@@ -182,7 +366,7 @@ public:
     
     // Get number of allocated objects
     [[nodiscard]] size_t allocated() const {
-        return header_->allocated.load(std::memory_order_relaxed);
+        return allocated_->load(std::memory_order_relaxed);
     }
     
     // Get number of free objects
@@ -205,11 +389,63 @@ public:
         return allocated() == header_->capacity;
     }
     
+    // Byte offset of node 0 from the start of the pool's segment entry
+    [[nodiscard]] size_t nodes_offset() const {
+        return reinterpret_cast<const char*>(nodes_) -
+               reinterpret_cast<const char*>(header_);
+    }
+    
 private:
     Memory& memory_;
     std::string name_;
     Header* header_ = nullptr;
+    std::atomic<uint64_t>* free_head_ = nullptr;  // In the header, or on its own line
+    std::atomic<uint32_t>* allocated_ = nullptr;
     Node* nodes_ = nullptr;
+    std::atomic<uint32_t>* owners_ = nullptr;
+
+    friend class PoolCache<T>;
+
+    static constexpr size_t owners_offset(size_t capacity, uint32_t flags) {
+        return align_up(data_offset(flags) + sizeof(Node) * capacity,
+                        alignof(std::atomic<uint32_t>));
+    }
+
+    void bind_head(uint32_t flags) {
+        char* base = reinterpret_cast<char*>(header_);
+        if (flags & POOL_LAYOUT_PADDED_HEAD) {
+            free_head_ = reinterpret_cast<std::atomic<uint64_t>*>(base + POOL_PADDED_HEAD_OFFSET);
+            allocated_ = reinterpret_cast<std::atomic<uint32_t>*>(
+                base + POOL_PADDED_ALLOCATED_OFFSET);
+        } else {
+            free_head_ = &header_->free_head;
+            allocated_ = &header_->allocated;
+        }
+    }
+
+    void bind_owners(uint32_t flags) {
+        owners_ = reinterpret_cast<std::atomic<uint32_t>*>(
+            reinterpret_cast<char*>(header_) + owners_offset(header_->capacity, flags));
+    }
+
+    // Record which process's magazine holds a node (0 = none)
+    void set_owner(T* ptr, uint32_t pid) {
+        if (owners_) {
+            owners_[index_of(ptr)].store(pid, std::memory_order_release);
+        }
+    }
+
+    // Node index of a pointer handed out by allocate, validated
+    uint32_t index_of(T* ptr) const {
+        Node* node = reinterpret_cast<Node*>(
+            reinterpret_cast<char*>(ptr) - offsetof(Node, data));
+        uint32_t node_index = node - nodes_;
+
+        if (node_index >= header_->capacity) {
+            throw std::invalid_argument("Invalid pointer to deallocate");
+        }
+        return node_index;
+    }
 };
 
 } // namespace zeroipc
\ No newline at end of file
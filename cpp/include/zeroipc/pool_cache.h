@@ -0,0 +1,104 @@
+#pragma once
+
+#include "pool.h"
+#include <cstring>
+#include <optional>
+#include <vector>
+#include <unistd.h>
+
+namespace zeroipc {
+
+/**
+ * @brief Per-thread magazine in front of a Pool
+ *
+ * Every Pool<T>::allocate/deallocate CASes the shared free_head, so under
+ * allocation-heavy load that one cache line bounces between all cores.
+ * A PoolCache keeps a private magazine of free nodes: allocate and
+ * deallocate hit the magazine, and only an empty magazine refills (half of
+ * it, with one allocate_n) and only a full one flushes (half of it, with one
+ * deallocate_n) against the shared list.
+ *
+ * Create one PoolCache per thread (it is not thread-safe itself); the
+ * destructor flushes the magazine back to the pool. Nodes sitting in a
+ * magazine count as allocated in Pool::allocated().
+ *
+ * If the pool was created with track_owners, each cached node is marked
+ * with this process's pid while it sits in the magazine, so that a process
+ * that dies without flushing can have its nodes returned by
+ * Pool::reclaim_dead(). A crash in the middle of a refill or flush can
+ * still leak that one batch.
+ *
+ * @tparam T Element type of the pool
+ */
+template<typename T>
+class PoolCache {
+public:
+    static constexpr size_t DEFAULT_MAGAZINE = 64;
+
+    explicit PoolCache(Pool<T>& pool, size_t magazine = DEFAULT_MAGAZINE)
+        : pool_(pool), slots_(magazine < 2 ? 2 : magazine),
+          pid_(static_cast<uint32_t>(::getpid())) {}
+
+    ~PoolCache() { flush(); }
+
+    PoolCache(const PoolCache&) = delete;
+    PoolCache& operator=(const PoolCache&) = delete;
+
+    // Take a node from the magazine, refilling it from the pool when empty
+    [[nodiscard]] std::optional<T*> allocate() {
+        if (count_ == 0 && refill(slots_.size() / 2) == 0) {
+            return std::nullopt;  // Pool is full
+        }
+        T* ptr = slots_[--count_];
+        pool_.set_owner(ptr, 0);
+        return ptr;
+    }
+
+    // Put a node in the magazine, flushing half of it when full
+    void deallocate(T* ptr) {
+        if (!ptr) return;
+        if (count_ == slots_.size()) {
+            flush_to(slots_.size() / 2);
+        }
+        pool_.set_owner(ptr, pid_);  // Also validates ptr
+        slots_[count_++] = ptr;
+    }
+
+    // Return every cached node to the pool
+    void flush() { flush_to(0); }
+
+    // Number of nodes currently cached
+    [[nodiscard]] size_t cached() const { return count_; }
+
+    [[nodiscard]] size_t magazine_size() const { return slots_.size(); }
+
+private:
+    Pool<T>& pool_;
+    std::vector<T*> slots_;
+    size_t count_ = 0;
+    uint32_t pid_;
+
+    size_t refill(size_t want) {
+        size_t n = pool_.allocate_n(slots_.data() + count_, want);
+        for (size_t i = 0; i < n; ++i) {
+            pool_.set_owner(slots_[count_ + i], pid_);
+        }
+        count_ += n;
+        return n;
+    }
+
+    // Flush the oldest (coldest) nodes at the bottom of the magazine, keeping
+    // the most recently freed ones on top for reuse
+    void flush_to(size_t keep) {
+        if (count_ <= keep) return;
+        size_t n = count_ - keep;
+        for (size_t i = 0; i < n; ++i) {
+            pool_.set_owner(slots_[i], 0);
+        }
+        pool_.deallocate_n(slots_.data(), n);
+        std::memmove(slots_.data(), slots_.data() + n, keep * sizeof(T*));
+        count_ = keep;
+    }
+};
+
+} // namespace zeroipc
@@ -0,0 +1,419 @@
+#pragma once
+
+#include "memory.h"
+#include "detail/spin_wait.h"
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <optional>
+#include <type_traits>
+
+namespace zeroipc {
+
+/**
+ * @brief Bounded multi-process priority queue (sharded min-heaps)
+ *
+ * PriorityQueue<T, Key> stores (key, value) items in N binary min-heaps
+ * ("shards"), each guarded by its own spinlock on its own cache line. Every
+ * shard publishes its current minimum key and size as atomics, so consumers
+ * pick a shard without taking any lock and contend only on the shard they
+ * actually pop from (a MultiQueue design).
+ *
+ * - push: inserts into a random shard, moving on to the next one when it is
+ *   locked or full. Fails only when every shard is full.
+ * - pop_min: locks the shard whose published minimum is smallest. With one
+ *   shard this is an exact priority queue; with several it is exact whenever
+ *   the queue is quiescent, and under concurrent pushes may return an item
+ *   that was the minimum a moment ago.
+ * - pop_relaxed: compares two random shards only (power of two choices).
+ *   Returns a near-minimum item with no shared hot spot; use it when the
+ *   consumer count is high and strict order is not required.
+ * - pop_bulk: drains the best shard while it stays ahead of all the others,
+ *   one lock acquisition for the batch.
+ *
+ * @layout
+ *   [Header(16)][pad to 64]
+ *   shard[i] at 64 + i * shard_stride:
+ *     [lock:u32][size:u32][min_key:Key][pad to node alignment]
+ *     [Node{key, value} * shard_capacity][pad to 64]
+ *
+ * @tparam T   Value type (must be trivially copyable)
+ * @tparam Key Priority (arithmetic; smaller pops first)
+ */
+template<typename T, typename Key = uint64_t>
+class PriorityQueue {
+public:
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "T must be trivially copyable for shared memory");
+    static_assert(std::is_arithmetic_v<Key>, "Key must be an arithmetic type");
+    static_assert(std::atomic<Key>::is_always_lock_free,
+                  "Key must be lock-free as an atomic");
+
+    struct Item {
+        Key key;
+        T value;
+    };
+
+    static_assert(alignof(Item) <= MAX_ELEM_ALIGN,
+                  "T alignment exceeds the largest supported allocation alignment");
+
+    struct Header {
+        uint32_t shards;          // Number of heaps
+        uint32_t shard_capacity;  // Items per heap
+        uint32_t elem_size;       // sizeof(T)
+        uint32_t key_size;        // sizeof(Key)
+    };
+
+    static constexpr size_t ALIGN = section_align<Item>();
+    static constexpr size_t SHARD_ALIGN = std::max(CACHE_LINE_SIZE, ALIGN);
+    static constexpr size_t SHARDS_OFFSET = align_up(sizeof(Header), SHARD_ALIGN);
+    static constexpr size_t MAX_SHARDS = 1024;
+
+    // Create a queue of `shards` heaps holding at least `capacity` items in
+    // total. One shard gives strict order; a few per consumer thread scale.
+    PriorityQueue(Memory& memory, std::string_view name, size_t capacity, size_t shards = 1)
+        : memory_(memory), name_(name) {
+
+        if (shards == 0 || shards > MAX_SHARDS) {
+            throw std::invalid_argument("PriorityQueue shard count must be in 1..1024");
+        }
+        if (capacity == 0) {
+            throw std::invalid_argument("PriorityQueue capacity must be greater than 0");
+        }
+
+        size_t shard_cap = (capacity + shards - 1) / shards;
+        if (shard_cap > std::numeric_limits<uint32_t>::max() ||
+            shard_cap > (SIZE_MAX / shards - NODES_OFFSET - SHARD_ALIGN) / sizeof(Item)) {
+            throw std::overflow_error("PriorityQueue capacity too large");
+        }
+
+        size_t stride = shard_stride(shard_cap);
+        size_t offset = memory.allocate(name, SHARDS_OFFSET + stride * shards, SHARD_ALIGN);
+        header_ = memory.ptr_at<Header>(offset);
+        header_->shards = static_cast<uint32_t>(shards);
+        header_->shard_capacity = static_cast<uint32_t>(shard_cap);
+        header_->elem_size = sizeof(T);
+        header_->key_size = sizeof(Key);
+
+        bind_shards(stride);
+        for (size_t s = 0; s < shards; s++) {
+            Shard* shard = shard_at(s);
+            shard->lock.store(0, std::memory_order_relaxed);
+            shard->size.store(0, std::memory_order_relaxed);
+            shard->min_key.store(Key{}, std::memory_order_relaxed);
+        }
+    }
+
+    // Open existing queue
+    PriorityQueue(Memory& memory, std::string_view name)
+        : memory_(memory), name_(name) {
+
+        auto* entry = memory.table()->find(name);
+        if (!entry) {
+            throw std::runtime_error("PriorityQueue not found: " + std::string(name));
+        }
+
+        header_ = memory.ptr_at<Header>(entry->offset);
+
+        if (header_->elem_size != sizeof(T) || header_->key_size != sizeof(Key)) {
+            throw std::runtime_error("Type size mismatch");
+        }
+        if (entry->section_align() != SHARD_ALIGN) {
+            throw std::runtime_error("Alignment mismatch");
+        }
+        uint32_t shards = header_->shards;
+        uint32_t shard_cap = header_->shard_capacity;
+        if (shards == 0 || shards > MAX_SHARDS || shard_cap == 0 ||
+            SHARDS_OFFSET + shard_stride(shard_cap) * shards > entry->size) {
+            throw std::runtime_error("PriorityQueue header is corrupt");
+        }
+
+        bind_shards(shard_stride(shard_cap));
+    }
+
+    // Insert an item. Returns false only when every shard is full.
+    [[nodiscard]] bool push(const Key& key, const T& value) {
+        const size_t shards = header_->shards;
+        const size_t start = random_shard();
+
+        // First pass skips shards another thread holds
+        for (size_t i = 0; i < shards; i++) {
+            Shard* shard = shard_at((start + i) % shards);
+            if (!full(shard) && try_lock(shard)) {
+                bool ok = heap_push(shard, key, value);
+                unlock(shard);
+                if (ok) {
+                    return true;
+                }
+            }
+        }
+        // Then wait for each in turn
+        for (size_t i = 0; i < shards; i++) {
+            Shard* shard = shard_at((start + i) % shards);
+            if (full(shard)) {
+                continue;
+            }
+            lock(shard);
+            bool ok = heap_push(shard, key, value);
+            unlock(shard);
+            if (ok) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Remove the item with the smallest key (see the class comment for the
+    // guarantee with several shards). Empty optional if the queue is empty.
+    [[nodiscard]] std::optional<Item> pop_min() {
+        for (;;) {
+            Shard* best = best_shard();
+            if (!best) {
+                return std::nullopt;
+            }
+            if (auto item = pop_from(best)) {
+                return item;
+            }
+            // Emptied under us; look again
+        }
+    }
+
+    // Remove a near-minimum item: the better of two random shards
+    [[nodiscard]] std::optional<Item> pop_relaxed() {
+        const size_t shards = header_->shards;
+        if (shards > 1) {
+            for (int attempt = 0; attempt < 4; attempt++) {
+                Shard* a = shard_at(random_shard());
+                Shard* b = shard_at(random_shard());
+                Shard* pick = better(a, b);
+                if (!pick) {
+                    break;
+                }
+                if (auto item = pop_from(pick)) {
+                    return item;
+                }
+            }
+        }
+        return pop_min();
+    }
+
+    // Pop up to max_count items in key order into out, taking them from the
+    // best shard while its minimum is no larger than every other shard's.
+    // Returns the number popped (0 when empty).
+    [[nodiscard]] size_t pop_bulk(Item* out, size_t max_count) {
+        size_t n = 0;
+        while (n < max_count) {
+            Shard* best = best_shard();
+            if (!best) {
+                break;
+            }
+            Shard* runner_up = best_shard(best);
+
+            lock(best);
+            size_t popped = 0;
+            while (n < max_count && best->size.load(std::memory_order_relaxed) > 0) {
+                if (popped > 0 && runner_up &&
+                    runner_up->size.load(std::memory_order_acquire) > 0 &&
+                    runner_up->min_key.load(std::memory_order_acquire) <
+                        nodes(best)[0].key) {
+                    break;
+                }
+                out[n++] = heap_pop(best);
+                popped++;
+            }
+            unlock(best);
+        }
+        return n;
+    }
+
+    // Smallest published key, without removing anything
+    [[nodiscard]] std::optional<Key> top_key() const {
+        Shard* best = best_shard();
+        if (!best) {
+            return std::nullopt;
+        }
+        return best->min_key.load(std::memory_order_acquire);
+    }
+
+    // Approximate in concurrent context
+    [[nodiscard]] size_t size() const {
+        size_t total = 0;
+        for (size_t s = 0; s < header_->shards; s++) {
+            total += shard_at(s)->size.load(std::memory_order_acquire);
+        }
+        return total;
+    }
+
+    [[nodiscard]] bool empty() const { return size() == 0; }
+
+    [[nodiscard]] size_t shards() const { return header_->shards; }
+    [[nodiscard]] size_t shard_capacity() const { return header_->shard_capacity; }
+    [[nodiscard]] size_t capacity() const {
+        return size_t(header_->shards) * header_->shard_capacity;
+    }
+
+private:
+    // Shard control block; the heap follows at NODES_OFFSET
+    struct Shard {
+        std::atomic<uint32_t> lock;       // 0 = free, 1 = held
+        std::atomic<uint32_t> size;       // Items in the heap
+        std::atomic<Key> min_key;         // Heap root's key, valid when size > 0
+    };
+
+    static constexpr size_t NODES_OFFSET = align_up(sizeof(Shard), ALIGN);
+    static constexpr int SPIN_LIMIT = 128;
+
+    static size_t shard_stride(size_t shard_cap) {
+        return align_up(NODES_OFFSET + sizeof(Item) * shard_cap, SHARD_ALIGN);
+    }
+
+    Memory& memory_;
+    std::string name_;
+    Header* header_;
+    char* shards_base_ = nullptr;
+    size_t stride_ = 0;
+
+    void bind_shards(size_t stride) {
+        shards_base_ = reinterpret_cast<char*>(header_) + SHARDS_OFFSET;
+        stride_ = stride;
+    }
+
+    Shard* shard_at(size_t s) const {
+        return reinterpret_cast<Shard*>(shards_base_ + s * stride_);
+    }
+
+    static Item* nodes(Shard* shard) {
+        return reinterpret_cast<Item*>(reinterpret_cast<char*>(shard) + NODES_OFFSET);
+    }
+
+    bool full(Shard* shard) const {
+        return shard->size.load(std::memory_order_relaxed) >= header_->shard_capacity;
+    }
+
+    // Per-thread xorshift; only spreads load, so quality does not matter
+    size_t random_shard() const {
+        thread_local uint64_t state =
+            0x9E3779B97F4A7C15ull ^ reinterpret_cast<uintptr_t>(&state);
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state % header_->shards;
+    }
+
+    // Non-empty shard with the smallest published key, skipping `except`
+    Shard* best_shard(Shard* except = nullptr) const {
+        Shard* best = nullptr;
+        Key best_key{};
+        for (size_t s = 0; s < header_->shards; s++) {
+            Shard* shard = shard_at(s);
+            if (shard == except || shard->size.load(std::memory_order_acquire) == 0) {
+                continue;
+            }
+            Key key = shard->min_key.load(std::memory_order_acquire);
+            if (!best || key < best_key) {
+                best = shard;
+                best_key = key;
+            }
+        }
+        return best;
+    }
+
+    static Shard* better(Shard* a, Shard* b) {
+        bool a_has = a->size.load(std::memory_order_acquire) > 0;
+        bool b_has = b->size.load(std::memory_order_acquire) > 0;
+        if (!a_has || !b_has) {
+            return a_has ? a : (b_has ? b : nullptr);
+        }
+        return b->min_key.load(std::memory_order_acquire) <
+               a->min_key.load(std::memory_order_acquire) ? b : a;
+    }
+
+    std::optional<Item> pop_from(Shard* shard) {
+        lock(shard);
+        std::optional<Item> item;
+        if (shard->size.load(std::memory_order_relaxed) > 0) {
+            item = heap_pop(shard);
+        }
+        unlock(shard);
+        return item;
+    }
+
+    static bool try_lock(Shard* shard) {
+        uint32_t expected = 0;
+        return shard->lock.load(std::memory_order_relaxed) == 0 &&
+               shard->lock.compare_exchange_strong(expected, 1,
+                                                   std::memory_order_acquire,
+                                                   std::memory_order_relaxed);
+    }
+
+    // Critical sections are a heap sift, so spin briefly before backing off
+    static void lock(Shard* shard) {
+        for (int i = 0; i < SPIN_LIMIT; i++) {
+            if (try_lock(shard)) {
+                return;
+            }
+        }
+        detail::spin_wait([shard] { return try_lock(shard); });
+    }
+
+    static void unlock(Shard* shard) {
+        shard->lock.store(0, std::memory_order_release);
+    }
+
+    // Heap operations; the caller holds the shard lock
+    bool heap_push(Shard* shard, const Key& key, const T& value) {
+        uint32_t n = shard->size.load(std::memory_order_relaxed);
+        if (n >= header_->shard_capacity) {
+            return false;
+        }
+        Item* heap = nodes(shard);
+        uint32_t i = n;
+        while (i > 0) {
+            uint32_t parent = (i - 1) / 2;
+            if (!(key < heap[parent].key)) {
+                break;
+            }
+            heap[i] = heap[parent];
+            i = parent;
+        }
+        heap[i] = Item{key, value};
+        publish(shard, n + 1);
+        return true;
+    }
+
+    Item heap_pop(Shard* shard) {
+        Item* heap = nodes(shard);
+        uint32_t n = shard->size.load(std::memory_order_relaxed) - 1;
+        Item top = heap[0];
+        Item last = heap[n];
+        uint32_t i = 0;
+        for (;;) {
+            uint32_t child = 2 * i + 1;
+            if (child >= n) {
+                break;
+            }
+            if (child + 1 < n && heap[child + 1].key < heap[child].key) {
+                child++;
+            }
+            if (!(heap[child].key < last.key)) {
+                break;
+            }
+            heap[i] = heap[child];
+            i = child;
+        }
+        if (n > 0) {
+            heap[i] = last;
+        }
+        publish(shard, n);
+        return top;
+    }
+
+    static void publish(Shard* shard, uint32_t size) {
+        if (size > 0) {
+            shard->min_key.store(nodes(shard)[0].key, std::memory_order_release);
+        }
+        shard->size.store(size, std::memory_order_release);
+    }
+};
+
+} // namespace zeroipc
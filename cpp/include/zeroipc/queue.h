@@ -1,29 +1,133 @@
 #pragma once
 
 #include "memory.h"
+#include "doorbell.h"
+#include "detail/futex.h"
+#include "detail/watch_list.h"
+#include <algorithm>
 #include <atomic>
 #include <bit>
+#include <chrono>
 #include <optional>
+#include <thread>
 
 namespace zeroipc {
 
+// Slot layout of a Queue, chosen at creation and recorded in the high byte
+// of the header's elem_size field (older readers see a size mismatch and
+// refuse the queue rather than misread it).
+//   Split:       data array, then the sequence array (two lines per op)
+//   Interleaved: slot = {T, seq}, so one op usually touches one line
+//   InterleavedPadded: interleaved, each slot padded to whole cache lines
+//                      so neighbouring slots never false-share
+// Any of them can be combined with PaddedHeader (layout | PaddedHeader),
+// which moves head and tail onto cache lines of their own, so producers
+// and consumers stop invalidating each other's counter on every op. C++
+// creators use Split | PaddedHeader unless told otherwise; pass a layout
+// without PaddedHeader for the compact 16-byte header.
+enum class QueueLayout : uint32_t {
+    Split = 0,
+    Interleaved = 0x01000000,
+    InterleavedPadded = 0x03000000,
+    PaddedHeader = 0x04000000,
+};
+
+constexpr QueueLayout operator|(QueueLayout a, QueueLayout b) {
+    return static_cast<QueueLayout>(static_cast<uint32_t>(a) | static_cast<uint32_t>(b));
+}
+
+inline constexpr uint32_t QUEUE_ELEM_SIZE_MASK = 0x00FFFFFF;
+inline constexpr uint32_t QUEUE_LAYOUT_INTERLEAVED = 0x01000000;
+inline constexpr uint32_t QUEUE_LAYOUT_PADDED = 0x02000000;
+inline constexpr uint32_t QUEUE_LAYOUT_PADDED_HEADER = 0x04000000;
+
+// With PaddedHeader, head and tail live at these offsets instead of in the
+// 16-byte header (where they stay zero), and slots start after them.
+inline constexpr size_t QUEUE_PADDED_HEAD_OFFSET = CACHE_LINE_SIZE;
+inline constexpr size_t QUEUE_PADDED_TAIL_OFFSET = 2 * CACHE_LINE_SIZE;
+inline constexpr size_t QUEUE_PADDED_HEADER_SIZE = 3 * CACHE_LINE_SIZE;
+
+inline constexpr bool valid_queue_layout(uint32_t flags) {
+    flags &= ~QUEUE_LAYOUT_PADDED_HEADER;
+    return flags == static_cast<uint32_t>(QueueLayout::Split) ||
+           flags == static_cast<uint32_t>(QueueLayout::Interleaved) ||
+           flags == static_cast<uint32_t>(QueueLayout::InterleavedPadded);
+}
+
 template<typename T>
 class Queue {
 public:
     static_assert(std::is_trivially_copyable_v<T>,
                   "T must be trivially copyable for shared memory");
     static_assert(alignof(T) <= MAX_ELEM_ALIGN,
-                  "T alignment exceeds the 8-byte guarantee of shared memory layout");
+                  "T alignment exceeds the largest supported allocation alignment");
+    static_assert(sizeof(T) <= QUEUE_ELEM_SIZE_MASK,
+                  "Queue elements are limited to 16 MB");
 
     struct Header {
         std::atomic<uint32_t> head;
         std::atomic<uint32_t> tail;
         uint32_t capacity;
-        uint32_t elem_size;
+        uint32_t elem_size;   // Bits 0-23: sizeof(T), bits 24-31: QueueLayout
+    };
+
+    // Every section starts on the section alignment, recorded in the table
+    // entry (8 for ordinary types: the v2 layout).
+    static constexpr size_t ALIGN = section_align<T>();
+    static constexpr size_t DATA_OFFSET = align_up(sizeof(Header), ALIGN);  // Split, unpadded header
+
+    // Where slot i's element and sequence word live, for either layout:
+    // element at data_off + i * data_stride, sequence word at
+    // seq_off + i * seq_stride (offsets from the header).
+    struct Geometry {
+        size_t data_off;
+        size_t data_stride;
+        size_t seq_off;
+        size_t seq_stride;
+        size_t end;
     };
 
+    static constexpr Geometry geometry(size_t capacity, uint32_t layout) {
+        const size_t header_size = (layout & QUEUE_LAYOUT_PADDED_HEADER)
+            ? QUEUE_PADDED_HEADER_SIZE : sizeof(Header);
+        if (!(layout & QUEUE_LAYOUT_INTERLEAVED)) {
+            size_t data_off = align_up(header_size, ALIGN);
+            size_t seq_off = data_off + align_up(sizeof(T) * capacity, ALIGN);
+            return {data_off, sizeof(T), seq_off, sizeof(uint32_t),
+                    seq_off + sizeof(uint32_t) * capacity};
+        }
+        // Element first (aligned by the slot), then its sequence word
+        size_t slot_align = (layout & QUEUE_LAYOUT_PADDED)
+            ? std::max(ALIGN, CACHE_LINE_SIZE) : ALIGN;
+        size_t seq_in_slot = align_up(sizeof(T), sizeof(uint32_t));
+        size_t stride = align_up(seq_in_slot + sizeof(uint32_t), slot_align);
+        size_t data_off = align_up(header_size, slot_align);
+        return {data_off, stride, data_off + seq_in_slot, stride,
+                data_off + stride * capacity};
+    }
+
+    // Futex words for the blocking calls, the doorbell and WaitSets,
+    // appended by C++ creators after the sequence array. Queues created by
+    // other bindings lack them; their blocking calls then poll instead of
+    // sleeping.
+    struct WaitWords {
+        std::atomic<uint32_t> not_empty;     // Bumped to wake pop waiters
+        std::atomic<uint32_t> pop_waiters;   // Consumers registered to sleep
+        std::atomic<uint32_t> not_full;      // Bumped to wake push waiters
+        std::atomic<uint32_t> push_waiters;  // Producers registered to sleep
+        std::atomic<uint32_t> bell;          // 0 = doorbell armed, 1 = rung
+        uint32_t reserved;
+        detail::WatchList watch;             // WaitSets poked by push and pop
+    };
+
+    // Sleepers re-check at least this often, so a writer that does not
+    // wake them (another binding, or one that crashed) costs one slice of
+    // latency rather than a stranded waiter.
+    static constexpr std::chrono::milliseconds WAIT_SLICE{10};
+
     // Create new queue
-    Queue(Memory& memory, std::string_view name, size_t capacity)
+    Queue(Memory& memory, std::string_view name, size_t capacity,
+          QueueLayout layout = QueueLayout::Split | QueueLayout::PaddedHeader)
         : memory_(memory), name_(name) {
 
         if (capacity == 0) {
@@ -40,16 +144,21 @@ public:
         }
         capacity = std::bit_ceil(capacity);
 
-        // Check for overflow
-        size_t seq_array_size = sizeof(std::atomic<uint32_t>) * capacity;
-        if (capacity > (SIZE_MAX - sizeof(Header) - seq_array_size) / sizeof(T)) {
+        // Check for overflow (a padded slot is at most T + 4 + 2 lines)
+        size_t max_slot = sizeof(T) + sizeof(uint32_t) + 2 * std::max(ALIGN, CACHE_LINE_SIZE);
+        if (capacity > (SIZE_MAX - QUEUE_PADDED_HEADER_SIZE - ALIGN - 2 * CACHE_LINE_SIZE
+                        - sizeof(WaitWords)) / max_slot) {
             throw std::overflow_error("Queue capacity too large");
         }
 
-        // The sequence array is 8-aligned so its atomics are naturally aligned.
-        size_t seq_off = align_up(sizeof(T) * capacity, 8);
-        size_t total_size = sizeof(Header) + seq_off + seq_array_size;
-        size_t offset = memory.allocate(name, total_size);
+        const uint32_t flags = static_cast<uint32_t>(layout);
+        if (!valid_queue_layout(flags)) {
+            throw std::invalid_argument("Unknown queue layout");
+        }
+        const Geometry g = geometry(capacity, flags);
+        size_t wait_off = align_up(g.end, MIN_SECTION_ALIGN);
+        size_t total_size = wait_off + sizeof(WaitWords);
+        size_t offset = memory.allocate(name, total_size, ALIGN);
 
         header_ = memory.ptr_at<Header>(offset);
 
@@ -57,35 +166,49 @@ public:
         header_->head.store(0, std::memory_order_relaxed);
         header_->tail.store(0, std::memory_order_relaxed);
         header_->capacity = capacity;
-        header_->elem_size = sizeof(T);
+        header_->elem_size = sizeof(T) | flags;
 
-        data_ = reinterpret_cast<T*>(
-            reinterpret_cast<char*>(header_) + sizeof(Header));
-
-        // Sequence array lives after the data array (8-aligned)
-        sequence_ = reinterpret_cast<std::atomic<uint32_t>*>(
-            reinterpret_cast<char*>(data_) + seq_off);
+        bind(g, flags);
+        head_->store(0, std::memory_order_relaxed);
+        tail_->store(0, std::memory_order_relaxed);
 
         // Initialize per-slot sequence numbers: sequence[i] = i
         for (size_t i = 0; i < capacity; i++) {
-            sequence_[i].store(static_cast<uint32_t>(i), std::memory_order_relaxed);
+            seq_at(i).store(static_cast<uint32_t>(i), std::memory_order_relaxed);
         }
+
+        wait_ = reinterpret_cast<WaitWords*>(
+            reinterpret_cast<char*>(header_) + wait_off);
+        wait_->not_empty.store(0, std::memory_order_relaxed);
+        wait_->pop_waiters.store(0, std::memory_order_relaxed);
+        wait_->not_full.store(0, std::memory_order_relaxed);
+        wait_->push_waiters.store(0, std::memory_order_relaxed);
+        wait_->bell.store(0, std::memory_order_relaxed);
+        wait_->reserved = 0;
+        detail::init(wait_->watch);
     }
 
     // Open existing queue
     Queue(Memory& memory, std::string_view name)
         : memory_(memory), name_(name) {
 
-        size_t offset, size;
-        if (!memory.find(name, offset, size)) {
+        auto* entry = memory.table()->find(name);
+        if (!entry) {
             throw std::runtime_error("Queue not found: " + std::string(name));
         }
 
-        header_ = memory.ptr_at<Header>(offset);
+        header_ = memory.ptr_at<Header>(entry->offset);
 
-        if (header_->elem_size != sizeof(T)) {
+        if ((header_->elem_size & QUEUE_ELEM_SIZE_MASK) != sizeof(T)) {
             throw std::runtime_error("Type size mismatch");
         }
+        const uint32_t flags = header_->elem_size & ~QUEUE_ELEM_SIZE_MASK;
+        if (!valid_queue_layout(flags)) {
+            throw std::runtime_error("Unknown queue layout");
+        }
+        if (entry->section_align() != ALIGN) {
+            throw std::runtime_error("Alignment mismatch");
+        }
 
         // Wrap-safety requires a power-of-two capacity (see the create
         // constructor). A non-power-of-two value means the segment was
@@ -96,12 +219,17 @@ public:
                 "Queue capacity is not a power of two (created by an old implementation?)");
         }
 
-        data_ = reinterpret_cast<T*>(
-            reinterpret_cast<char*>(header_) + sizeof(Header));
+        const Geometry g = geometry(header_->capacity, flags);
+        if (g.end > entry->size) {
+            throw std::runtime_error("Queue header is corrupt");
+        }
+        bind(g, flags);
 
-        // Sequence array lives after the data array (8-aligned)
-        sequence_ = reinterpret_cast<std::atomic<uint32_t>*>(
-            reinterpret_cast<char*>(data_) + align_up(sizeof(T) * header_->capacity, 8));
+        size_t wait_off = align_up(g.end, MIN_SECTION_ALIGN);
+        if (entry->size >= wait_off + sizeof(WaitWords)) {
+            wait_ = reinterpret_cast<WaitWords*>(
+                reinterpret_cast<char*>(header_) + wait_off);
+        }
     }
 
     // Enqueue (lock-free MPMC, Vyukov-style bounded queue)
@@ -109,21 +237,28 @@ public:
         const uint32_t cap = header_->capacity;
 
         for (;;) {
-            uint32_t tail = header_->tail.load(std::memory_order_relaxed);
+            uint32_t tail = tail_->load(std::memory_order_relaxed);
             uint32_t slot = tail % cap;
-            uint32_t seq = sequence_[slot].load(std::memory_order_acquire);
+            uint32_t seq = seq_at(slot).load(std::memory_order_acquire);
             auto diff = static_cast<int32_t>(seq) - static_cast<int32_t>(tail);
 
             if (diff == 0) {
                 // Slot is ready for writing; try to claim it
-                if (header_->tail.compare_exchange_weak(
+                if (tail_->compare_exchange_weak(
                         tail, tail + 1,
                         std::memory_order_relaxed,
                         std::memory_order_relaxed)) {
                     // We own this slot - write the data
-                    data_[slot] = value;
+                    *data_at(slot) = value;
                     // Publish: set sequence to tail + 1 so consumers can see it
-                    sequence_[slot].store(tail + 1, std::memory_order_release);
+                    seq_at(slot).store(tail + 1, std::memory_order_release);
+                    if (wait_) {
+                        wake(wait_->not_empty, wait_->pop_waiters);
+                        detail::poke(wait_->watch);
+                        if (doorbell_) {
+                            ring_doorbell();
+                        }
+                    }
                     return true;
                 }
                 // CAS failed, another producer got it; retry
@@ -141,22 +276,26 @@ public:
         const uint32_t cap = header_->capacity;
 
         for (;;) {
-            uint32_t head = header_->head.load(std::memory_order_relaxed);
+            uint32_t head = head_->load(std::memory_order_relaxed);
             uint32_t slot = head % cap;
-            uint32_t seq = sequence_[slot].load(std::memory_order_acquire);
+            uint32_t seq = seq_at(slot).load(std::memory_order_acquire);
             auto diff = static_cast<int32_t>(seq) - static_cast<int32_t>(head + 1);
 
             if (diff == 0) {
                 // Slot contains data; try to claim it
-                if (header_->head.compare_exchange_weak(
+                if (head_->compare_exchange_weak(
                         head, head + 1,
                         std::memory_order_relaxed,
                         std::memory_order_relaxed)) {
                     // We own this slot - read the data
-                    T value = data_[slot];
+                    T value = *data_at(slot);
                     // Release: set sequence to head + capacity so producers
                     // can reuse this slot on the next wrap-around
-                    sequence_[slot].store(head + cap, std::memory_order_release);
+                    seq_at(slot).store(head + cap, std::memory_order_release);
+                    if (wait_) {
+                        wake(wait_->not_full, wait_->push_waiters);
+                        detail::poke(wait_->watch);
+                    }
                     return value;
                 }
                 // CAS failed, another consumer got it; retry
@@ -169,24 +308,111 @@ public:
         }
     }
 
+    // Blocking push: sleeps while the queue is full. The fast path is
+    // push(); a syscall is only made when the queue is full, and push()/
+    // pop() only make one when they see a registered sleeper.
+    void push_wait(const T& value) {
+        (void)block([&] { return push(value); },
+                    &WaitWords::not_full, &WaitWords::push_waiters,
+                    Clock::time_point::max(), [] { return false; });
+    }
+
+    // Push, waiting up to timeout for space. Returns false on timeout.
+    template<typename Rep, typename Period>
+    [[nodiscard]] bool push_for(const T& value,
+                                const std::chrono::duration<Rep, Period>& timeout) {
+        return push_for(value, timeout, [] { return false; });
+    }
+
+    // As above, but also gives up once stop() is true. Whoever makes
+    // stop() true calls notify_all() so sleepers notice promptly.
+    template<typename Rep, typename Period, typename Stop>
+    [[nodiscard]] bool push_for(const T& value,
+                                const std::chrono::duration<Rep, Period>& timeout,
+                                Stop&& stop) {
+        return block([&] { return push(value); },
+                     &WaitWords::not_full, &WaitWords::push_waiters,
+                     deadline_after(timeout), stop);
+    }
+
+    // Blocking pop: sleeps while the queue is empty.
+    [[nodiscard]] T pop_wait() {
+        return *block([&] { return pop(); },
+                      &WaitWords::not_empty, &WaitWords::pop_waiters,
+                      Clock::time_point::max(), [] { return false; });
+    }
+
+    // Pop, waiting up to timeout for an element. Returns nullopt on timeout.
+    template<typename Rep, typename Period>
+    [[nodiscard]] std::optional<T> pop_for(const std::chrono::duration<Rep, Period>& timeout) {
+        return pop_for(timeout, [] { return false; });
+    }
+
+    // As above, but also gives up once stop() is true (see push_for).
+    template<typename Rep, typename Period, typename Stop>
+    [[nodiscard]] std::optional<T> pop_for(const std::chrono::duration<Rep, Period>& timeout,
+                                           Stop&& stop) {
+        return block([&] { return pop(); },
+                     &WaitWords::not_empty, &WaitWords::pop_waiters,
+                     deadline_after(timeout), stop);
+    }
+
+    // Wake every blocked push/pop so it re-checks its stop condition.
+    void notify_all() {
+        if (wait_) {
+            wait_->not_empty.fetch_add(1, std::memory_order_release);
+            wait_->not_full.fetch_add(1, std::memory_order_release);
+            detail::futex_wake(&wait_->not_empty);
+            detail::futex_wake(&wait_->not_full);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            detail::poke(wait_->watch);
+        }
+    }
+
+    // Ring bell (a process-local fd) when a push finds the shared bell word
+    // armed. Every producer process attaches its own handle to the same
+    // doorbell; the consumer polls bell->fd(). Pass nullptr to detach.
+    void attach_doorbell(Doorbell* bell) {
+        if (bell && !wait_) {
+            throw std::runtime_error(
+                "Queue has no doorbell word (created by another binding)");
+        }
+        doorbell_ = bell;
+    }
+
+    // Consumer side: re-arm after the doorbell fired and BEFORE draining the
+    // queue. A push that the drain misses then rings again.
+    void rearm_doorbell() {
+        if (wait_) {
+            wait_->bell.store(0, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+    }
+
+    // Registrations of the WaitSets watching this queue, or nullptr if the
+    // queue was created by another binding (WaitSets then poll it).
+    detail::WatchList* watch_list() {
+        return wait_ ? &wait_->watch : nullptr;
+    }
+
     // Check if empty (approximate in concurrent context)
     bool empty() const {
-        uint32_t head = header_->head.load(std::memory_order_acquire);
-        uint32_t tail = header_->tail.load(std::memory_order_acquire);
+        uint32_t head = head_->load(std::memory_order_acquire);
+        uint32_t tail = tail_->load(std::memory_order_acquire);
         return head == tail;
     }
 
     // Check if full (approximate in concurrent context)
     bool full() const {
-        uint32_t head = header_->head.load(std::memory_order_acquire);
-        uint32_t tail = header_->tail.load(std::memory_order_acquire);
+        uint32_t head = head_->load(std::memory_order_acquire);
+        uint32_t tail = tail_->load(std::memory_order_acquire);
         return (tail - head) >= header_->capacity;
     }
 
     // Get current size (approximate in concurrent context)
     size_t size() const {
-        uint32_t head = header_->head.load(std::memory_order_acquire);
-        uint32_t tail = header_->tail.load(std::memory_order_acquire);
+        uint32_t head = head_->load(std::memory_order_acquire);
+        uint32_t tail = tail_->load(std::memory_order_acquire);
         // uint32_t subtraction handles wraparound correctly
         return static_cast<size_t>(tail - head);
     }
@@ -194,11 +420,115 @@ public:
     size_t capacity() const { return header_->capacity; }
 
 private:
+    using Clock = std::chrono::steady_clock;
+
     Memory& memory_;
     std::string name_;
     Header* header_;
-    T* data_;
-    std::atomic<uint32_t>* sequence_;
+    std::atomic<uint32_t>* head_;  // In the header, or on its own line
+    std::atomic<uint32_t>* tail_;
+    char* data_;              // Slot 0's element
+    char* sequence_;          // Slot 0's sequence word
+    size_t data_stride_;
+    size_t seq_stride_;
+    WaitWords* wait_ = nullptr;
+    Doorbell* doorbell_ = nullptr;
+
+    void bind(const Geometry& g, uint32_t flags) {
+        if (flags & QUEUE_LAYOUT_PADDED_HEADER) {
+            head_ = reinterpret_cast<std::atomic<uint32_t>*>(
+                reinterpret_cast<char*>(header_) + QUEUE_PADDED_HEAD_OFFSET);
+            tail_ = reinterpret_cast<std::atomic<uint32_t>*>(
+                reinterpret_cast<char*>(header_) + QUEUE_PADDED_TAIL_OFFSET);
+        } else {
+            head_ = &header_->head;
+            tail_ = &header_->tail;
+        }
+        data_ = reinterpret_cast<char*>(header_) + g.data_off;
+        sequence_ = reinterpret_cast<char*>(header_) + g.seq_off;
+        data_stride_ = g.data_stride;
+        seq_stride_ = g.seq_stride;
+    }
+
+    T* data_at(uint32_t slot) const {
+        return reinterpret_cast<T*>(data_ + slot * data_stride_);
+    }
+
+    std::atomic<uint32_t>& seq_at(uint32_t slot) const {
+        return *reinterpret_cast<std::atomic<uint32_t>*>(sequence_ + slot * seq_stride_);
+    }
+
+    template<typename Rep, typename Period>
+    static Clock::time_point deadline_after(const std::chrono::duration<Rep, Period>& timeout) {
+        auto now = Clock::now();
+        if (timeout >= Clock::time_point::max() - now) {
+            return Clock::time_point::max();
+        }
+        return now + std::chrono::duration_cast<Clock::duration>(timeout);
+    }
+
+    // Called after a successful operation. The fence orders our publish
+    // before the waiter check, pairing with the sleeper's registration in
+    // block(): either the sleeper's re-check sees our operation, or we see
+    // the sleeper and bump its futex word.
+    static void wake(std::atomic<uint32_t>& word, std::atomic<uint32_t>& waiters) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters.load(std::memory_order_relaxed) != 0) {
+            word.fetch_add(1, std::memory_order_release);
+            detail::futex_wake(&word);
+        }
+    }
+
+    // Runs after wake()'s fence, which pairs with the one in
+    // rearm_doorbell(): either the consumer's drain sees our element or we
+    // see the armed bell. Only the armed -> rung transition writes the fd.
+    void ring_doorbell() {
+        if (wait_->bell.load(std::memory_order_relaxed) == 0 &&
+            wait_->bell.exchange(1, std::memory_order_acq_rel) == 0) {
+            doorbell_->ring();
+        }
+    }
+
+    // Retry op until it succeeds, stop() holds, or the deadline passes,
+    // sleeping on the futex word in between.
+    template<typename Op, typename Stop>
+    auto block(Op&& op, std::atomic<uint32_t> WaitWords::* word,
+               std::atomic<uint32_t> WaitWords::* waiters,
+               Clock::time_point deadline, Stop&& stop) -> decltype(op()) {
+        for (;;) {
+            if (auto result = op()) {
+                return result;
+            }
+            if (stop()) {
+                return {};
+            }
+            auto now = Clock::now();
+            if (now >= deadline) {
+                return {};
+            }
+            auto slice = std::min<Clock::duration>(deadline - now, WAIT_SLICE);
+
+            if (!wait_) {
+                std::this_thread::sleep_for(
+                    std::min<Clock::duration>(slice, std::chrono::milliseconds(1)));
+                continue;
+            }
+
+            // Register, then re-check: an operation that lands after the
+            // re-check sees us registered and bumps the word we sleep on.
+            (wait_->*waiters).fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            uint32_t seen = (wait_->*word).load(std::memory_order_acquire);
+            auto result = op();
+            if (!result && !stop()) {
+                detail::futex_wait(&(wait_->*word), seen, slice);
+            }
+            (wait_->*waiters).fetch_sub(1, std::memory_order_relaxed);
+            if (result) {
+                return result;
+            }
+        }
+    }
 };
 
 } // namespace zeroipc
\ No newline at end of file
@@ -0,0 +1,192 @@
+#pragma once
+
+#include "memory.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace zeroipc {
+
+/**
+ * @brief Lock-free token-bucket rate limiter across processes
+ *
+ * Tokens accrue at rate() per second up to burst(); try_acquire(n) takes n
+ * of them if they are there. Nothing refills the bucket in the background:
+ * callers work out the refill from the monotonic clock when they look.
+ *
+ * The whole bucket is one 64-bit word, the theoretical arrival time (GCRA):
+ * the moment the bucket would be full again if nobody took anything more.
+ * Tokens available now are (burst window - (tat - now)) / interval, so
+ * taking n tokens is a single CAS pushing tat forward by n intervals, with
+ * "tokens" and "last refill" never able to disagree. Times are kept in
+ * 1/64 ns ticks since creation, so fractional intervals (3 M/s is 333.33
+ * ns) do not drift, and a limiter lasts about 9 years.
+ *
+ * steady_clock is CLOCK_MONOTONIC, which all processes on a host share.
+ *
+ * @layout Header(32) at `name`
+ *
+ * @example
+ * ```cpp
+ * zeroipc::RateLimiter limiter(mem, "upstream", 1000.0, 50);  // 1000/s, bursts of 50
+ * if (limiter.try_acquire()) {
+ *     call_upstream();
+ * } else {
+ *     std::this_thread::sleep_for(limiter.wait_time());
+ * }
+ * ```
+ */
+class RateLimiter {
+public:
+    struct Header {
+        std::atomic<uint64_t> tat;  // Theoretical arrival time, ticks since epoch
+        uint64_t interval;          // Ticks per token
+        uint64_t burst;             // Bucket capacity in tokens
+        int64_t epoch_ns;           // steady_clock at creation
+    };
+
+    static_assert(sizeof(Header) == 32, "Header must be 32 bytes");
+
+    static constexpr int TICK_BITS = 6;  // Ticks per nanosecond: 1 << TICK_BITS
+
+    /**
+     * @brief Create a new rate limiter, with a full bucket
+     * @param mem Memory region
+     * @param name Unique name for this limiter
+     * @param rate Tokens added per second
+     * @param burst Most tokens the bucket holds (and the most one call can take)
+     * @throws std::invalid_argument if rate or burst is out of range
+     */
+    RateLimiter(Memory& mem, std::string_view name, double rate, uint64_t burst) {
+        if (!(rate > 0) || !std::isfinite(rate)) {
+            throw std::invalid_argument("RateLimiter rate must be positive");
+        }
+        double interval = std::round(1e9 * (1 << TICK_BITS) / rate);
+        if (interval < 1) {
+            throw std::invalid_argument("RateLimiter rate is too high");
+        }
+        if (burst == 0 || interval * static_cast<double>(burst) > MAX_WINDOW) {
+            throw std::invalid_argument("RateLimiter burst must be positive and its window under a year");
+        }
+
+        size_t offset = mem.allocate(name, sizeof(Header), CACHE_LINE_SIZE);
+        header_ = mem.ptr_at<Header>(offset);
+        header_->tat.store(0, std::memory_order_relaxed);
+        header_->interval = static_cast<uint64_t>(interval);
+        header_->burst = burst;
+        header_->epoch_ns = now_ns();
+    }
+
+    /**
+     * @brief Open an existing rate limiter
+     * @throws std::runtime_error if not found or not a RateLimiter
+     */
+    RateLimiter(Memory& mem, std::string_view name) {
+        auto* entry = mem.table()->find(name);
+        if (!entry) {
+            throw std::runtime_error("RateLimiter not found: " + std::string(name));
+        }
+        if (entry->size != sizeof(Header)) {
+            throw std::runtime_error("RateLimiter size mismatch");
+        }
+        header_ = mem.ptr_at<Header>(entry->offset);
+        if (header_->interval == 0 || header_->burst == 0 ||
+            static_cast<double>(header_->interval) * static_cast<double>(header_->burst) > MAX_WINDOW) {
+            throw std::runtime_error("RateLimiter header is corrupt");
+        }
+    }
+
+    /**
+     * @brief Take n tokens if they are available now
+     * @return true if taken; false (taking nothing) if too few are available
+     *         or n exceeds burst()
+     */
+    [[nodiscard]] bool try_acquire(uint64_t n = 1) {
+        if (n == 0) {
+            return true;
+        }
+        if (n > header_->burst) {
+            return false;
+        }
+        uint64_t now = now_ticks();
+        uint64_t cost = n * header_->interval;
+        uint64_t window = header_->burst * header_->interval;
+        uint64_t tat = header_->tat.load(std::memory_order_relaxed);
+        for (;;) {
+            uint64_t next = std::max(tat, now) + cost;
+            if (next - now > window) {
+                return false;
+            }
+            if (header_->tat.compare_exchange_weak(tat, next, std::memory_order_relaxed,
+                                                   std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+    }
+
+    /**
+     * @brief How long until n tokens are available, if nobody else takes any
+     *
+     * A hint: other callers may get there first, so retry try_acquire()
+     * after waiting.
+     *
+     * @return zero if available now; nanoseconds::max() if n exceeds burst()
+     */
+    [[nodiscard]] std::chrono::nanoseconds wait_time(uint64_t n = 1) const {
+        if (n > header_->burst) {
+            return std::chrono::nanoseconds::max();
+        }
+        uint64_t now = now_ticks();
+        uint64_t next = std::max(header_->tat.load(std::memory_order_relaxed), now) +
+                        n * header_->interval;
+        uint64_t window = header_->burst * header_->interval;
+        if (next - now <= window) {
+            return std::chrono::nanoseconds(0);
+        }
+        uint64_t ticks = next - now - window;
+        return std::chrono::nanoseconds((ticks + (1 << TICK_BITS) - 1) >> TICK_BITS);
+    }
+
+    /**
+     * @brief Tokens available now
+     */
+    [[nodiscard]] uint64_t available() const {
+        uint64_t now = now_ticks();
+        uint64_t debt = std::max(header_->tat.load(std::memory_order_relaxed), now) - now;
+        uint64_t window = header_->burst * header_->interval;
+        return debt >= window ? 0 : (window - debt) / header_->interval;
+    }
+
+    // Tokens added per second
+    [[nodiscard]] double rate() const {
+        return 1e9 * (1 << TICK_BITS) / static_cast<double>(header_->interval);
+    }
+
+    [[nodiscard]] uint64_t burst() const { return header_->burst; }
+
+    RateLimiter(const RateLimiter&) = delete;
+    RateLimiter& operator=(const RateLimiter&) = delete;
+
+private:
+    // Longest burst window: a year of ticks keeps tat arithmetic far from
+    // overflow
+    static constexpr double MAX_WINDOW = 365.0 * 86400 * 1e9 * (1 << TICK_BITS);
+
+    Header* header_ = nullptr;
+
+    static int64_t now_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    uint64_t now_ticks() const {
+        return static_cast<uint64_t>(now_ns() - header_->epoch_ns) << TICK_BITS;
+    }
+};
+
+} // namespace zeroipc
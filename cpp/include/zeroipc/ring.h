@@ -19,7 +19,7 @@ public:
     static_assert(std::is_trivially_copyable_v<T>,
                   "T must be trivially copyable for shared memory");
     static_assert(alignof(T) <= MAX_ELEM_ALIGN,
-                  "T alignment exceeds the 8-byte guarantee of shared memory layout");
+                  "T alignment exceeds the largest supported allocation alignment");
 
     struct Header {
         std::atomic<uint64_t> write_pos;   // Total bytes written
@@ -27,6 +27,11 @@ public:
         uint32_t capacity;                  // Ring buffer capacity in bytes
         uint32_t elem_size;
     };
+
+    // Data starts on the section alignment, recorded in the table entry
+    // (8 for ordinary types).
+    static constexpr size_t ALIGN = section_align<T>();
+    static constexpr size_t DATA_OFFSET = align_up(sizeof(Header), ALIGN);
     
     // Create new ring buffer
     Ring(Memory& memory, std::string_view name, size_t capacity)
@@ -43,12 +48,12 @@ public:
         }
         
         // Check for overflow
-        if (capacity > SIZE_MAX - sizeof(Header)) {
+        if (capacity > SIZE_MAX - DATA_OFFSET) {
             throw std::overflow_error("Ring capacity too large");
         }
         
-        size_t total_size = sizeof(Header) + capacity;
-        size_t offset = memory.allocate(name, total_size);
+        size_t total_size = DATA_OFFSET + capacity;
+        size_t offset = memory.allocate(name, total_size, ALIGN);
         
         header_ = memory.ptr_at<Header>(offset);
 
@@ -58,25 +63,28 @@ public:
         header_->capacity = capacity;
         header_->elem_size = sizeof(T);
         
-        buffer_ = reinterpret_cast<char*>(header_) + sizeof(Header);
+        buffer_ = reinterpret_cast<char*>(header_) + DATA_OFFSET;
     }
     
     // Open existing ring buffer
     Ring(Memory& memory, std::string_view name)
         : memory_(memory), name_(name) {
         
-        size_t offset, size;
-        if (!memory.find(name, offset, size)) {
+        auto* entry = memory.table()->find(name);
+        if (!entry) {
             throw std::runtime_error("Ring not found: " + std::string(name));
         }
-        
-        header_ = memory.ptr_at<Header>(offset);
+        if (entry->section_align() != ALIGN) {
+            throw std::runtime_error("Alignment mismatch");
+        }
+
+        header_ = memory.ptr_at<Header>(entry->offset);
 
         if (header_->elem_size != sizeof(T)) {
             throw std::runtime_error("Type size mismatch");
         }
         
-        buffer_ = reinterpret_cast<char*>(header_) + sizeof(Header);
+        buffer_ = reinterpret_cast<char*>(header_) + DATA_OFFSET;
     }
     
     // Write data to ring buffer (lock-free SPSC optimized)
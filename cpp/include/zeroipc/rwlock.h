@@ -2,10 +2,13 @@
 
 #include <atomic>
 #include <cassert>
+#include <chrono>
+#include <optional>
 #include <string_view>
 #include <stdexcept>
+#include <thread>
 #include "memory.h"
-#include "mutex.h"
+#include "detail/futex.h"
 
 namespace zeroipc {
 
@@ -13,20 +16,20 @@ namespace zeroipc {
  * @brief Read-Write Lock state for shared memory
  *
  * Binary layout:
- * - 4 bytes: active readers count
- * - 4 bytes: writer waiting flag
- * - Mutex for reader coordination
- * - Mutex for writer exclusion
+ * - 4 bytes: lock word (futex)
+ *   - bits 0-29: active readers count
+ *   - bit 30:    writer waiting (new readers hold off)
+ *   - bit 31:    writer active
+ * - 4 bytes: number of threads parked on the lock word
  */
 struct RWLockState {
-    std::atomic<int32_t> readers{0};      // Number of active readers
-    std::atomic<int32_t> writer_active{0}; // 1 if writer active, 0 otherwise
+    std::atomic<uint32_t> word{0};    // Readers count | WRITER_WAITING | WRITER
+    std::atomic<uint32_t> parked{0};  // Threads sleeping in futex_wait on word
 
-    RWLockState() : readers(0), writer_active(0) {}
+    RWLockState() : word(0), parked(0) {}
 };
 
-static_assert(std::is_trivially_copyable_v<RWLockState>,
-              "RWLockState must be trivially copyable");
+static_assert(sizeof(RWLockState) == 8, "RWLockState must be 8 bytes");
 
 /**
  * @brief Read-Write Lock for shared memory
@@ -34,13 +37,22 @@ static_assert(std::is_trivially_copyable_v<RWLockState>,
  * Allows multiple concurrent readers OR one exclusive writer.
  * Optimized for read-heavy workloads where reads vastly outnumber writes.
  *
+ * The whole lock is one 32-bit word: an uncontended reader_lock() is a
+ * single fetch_add, and reader_unlock() a single fetch_sub. A writer first
+ * sets WRITER_WAITING, which turns new readers away, so a steady stream of
+ * readers cannot starve it; it then waits for the reader count to drain
+ * and swaps the word to WRITER. Threads that cannot get in spin briefly
+ * and then sleep on the word with a process-shared futex; unlocks only
+ * make the wake syscall when someone is parked.
+ *
  * Features:
  * - Multiple readers can hold lock simultaneously
  * - Writer gets exclusive access (no readers, no other writers)
+ * - Writer preference: a waiting writer blocks new readers
  * - RAII-compatible with SharedLock and UniqueLock
  *
  * Performance characteristics:
- * - reader_lock(): Fast when no writers (just atomic increment)
+ * - reader_lock(): One atomic add when no writer holds or waits
  * - writer_lock(): Waits for all readers to finish
  *
  * Example:
@@ -72,41 +84,31 @@ static_assert(std::is_trivially_copyable_v<RWLockState>,
  */
 class RWLock {
 public:
+    static constexpr uint32_t WRITER = 1u << 31;
+    static constexpr uint32_t WRITER_WAITING = 1u << 30;
+    static constexpr uint32_t READERS_MASK = WRITER_WAITING - 1;
+
     /**
      * @brief Create or open a RWLock
      * @param mem Memory region
      * @param name Unique name for this RWLock
-     * @throws std::runtime_error if allocation fails
+     * @throws std::runtime_error if allocation fails or the entry is not
+     *         a single-word RWLock
      */
     RWLock(Memory& mem, std::string_view name) : mem_(mem) {
-        std::string state_name = std::string(name) + "_state";
-        std::string reader_mtx_name = std::string(name) + "_rmtx";
-        std::string writer_mtx_name = std::string(name) + "_wmtx";
-
         auto entry = mem.table()->find(name);
 
         if (entry) {
             // Open existing
-            auto state_entry = mem.table()->find(state_name);
-            if (!state_entry) {
-                throw std::runtime_error("RWLock state not found");
+            if (entry->size != sizeof(RWLockState)) {
+                throw std::runtime_error("RWLock state size mismatch: " + std::string(name));
             }
-            state_ = mem.ptr_at<RWLockState>(state_entry->offset);
-
-            reader_mutex_ = std::make_unique<Mutex>(mem, reader_mtx_name);
-            writer_mutex_ = std::make_unique<Mutex>(mem, writer_mtx_name);
+            state_ = mem.ptr_at<RWLockState>(entry->offset);
         } else {
             // Create new
-            size_t state_offset = mem.allocate(state_name, sizeof(RWLockState));
-            state_ = mem.ptr_at<RWLockState>(state_offset);
+            size_t offset = mem.allocate(name, sizeof(RWLockState), CACHE_LINE_SIZE);
+            state_ = mem.ptr_at<RWLockState>(offset);
             new (state_) RWLockState();
-
-            reader_mutex_ = std::make_unique<Mutex>(mem, reader_mtx_name);
-            writer_mutex_ = std::make_unique<Mutex>(mem, writer_mtx_name);
-
-            // Add marker entry
-            size_t marker_offset = mem.allocate(name, 1);
-            (void)marker_offset;
         }
     }
 
@@ -114,20 +116,19 @@ public:
      * @brief Acquire read lock (shared access)
      *
      * Multiple threads can hold read locks simultaneously.
-     * Blocks if a writer currently holds the lock.
+     * Blocks while a writer holds the lock or is waiting for it.
      */
     void reader_lock() {
-        reader_mutex_->lock();
-
-        // Wait for any active writer to finish
-        while (state_->writer_active.load(std::memory_order_acquire) != 0) {
-            reader_mutex_->unlock();
-            std::this_thread::yield();
-            reader_mutex_->lock();
+        uint32_t prev = state_->word.fetch_add(1, std::memory_order_acquire);
+        if ((prev & (WRITER | WRITER_WAITING)) == 0) [[likely]] {
+            return;
         }
-
-        state_->readers.fetch_add(1, std::memory_order_release);
-        reader_mutex_->unlock();
+        // A writer holds or wants the lock: back out, then wait our turn
+        release_reader();
+        acquire_slow([](uint32_t s) -> std::optional<uint32_t> {
+            if (s & (WRITER | WRITER_WAITING)) return std::nullopt;
+            return s + 1;
+        });
     }
 
     /**
@@ -135,27 +136,22 @@ public:
      * @return true if lock acquired, false otherwise
      */
     [[nodiscard]] bool try_reader_lock() {
-        if (!reader_mutex_->try_lock()) {
-            return false;
-        }
-
-        if (state_->writer_active.load(std::memory_order_acquire) != 0) {
-            reader_mutex_->unlock();
-            return false;
+        uint32_t s = state_->word.load(std::memory_order_relaxed);
+        while ((s & (WRITER | WRITER_WAITING)) == 0) {
+            if (state_->word.compare_exchange_weak(s, s + 1,
+                                                   std::memory_order_acquire,
+                                                   std::memory_order_relaxed)) {
+                return true;
+            }
         }
-
-        state_->readers.fetch_add(1, std::memory_order_release);
-        reader_mutex_->unlock();
-        return true;
+        return false;
     }
 
     /**
      * @brief Release read lock
      */
     void reader_unlock() {
-        [[maybe_unused]] int32_t prev =
-            state_->readers.fetch_sub(1, std::memory_order_release);
-        assert(prev > 0 && "reader_unlock without a matching reader_lock");
+        release_reader();
     }
 
     /**
@@ -165,21 +161,21 @@ public:
      * release their locks and no other writer holds the lock.
      */
     void writer_lock() {
-        writer_mutex_->lock();
-
-        // Mark writer as active UNDER reader_mutex_. Readers check
-        // writer_active and increment readers while holding reader_mutex_;
-        // setting the flag under the same mutex closes the race where a
-        // reader passes its writer check while the writer simultaneously
-        // passes its readers check, letting both hold the lock at once.
-        reader_mutex_->lock();
-        state_->writer_active.store(1, std::memory_order_release);
-        reader_mutex_->unlock();
-
-        // Wait for all readers to finish
-        while (state_->readers.load(std::memory_order_acquire) > 0) {
-            std::this_thread::yield();
+        uint32_t expected = 0;
+        if (state_->word.compare_exchange_strong(expected, WRITER,
+                                                 std::memory_order_acquire,
+                                                 std::memory_order_relaxed)) [[likely]] {
+            return;
         }
+        // Take the lock once it is free (the waiting bit may be ours or
+        // another writer's; the new owner clears it, and writers still
+        // waiting set it again). Otherwise announce ourselves so no new
+        // readers get in, and wait.
+        acquire_slow([](uint32_t s) -> std::optional<uint32_t> {
+            if ((s & ~WRITER_WAITING) == 0) return WRITER;
+            if (!(s & WRITER_WAITING)) return s | WRITER_WAITING;
+            return std::nullopt;
+        });
     }
 
     /**
@@ -187,35 +183,25 @@ public:
      * @return true if lock acquired, false otherwise
      */
     [[nodiscard]] bool try_writer_lock() {
-        if (!writer_mutex_->try_lock()) {
-            return false;
-        }
-
-        // Readers only transition 0 -> 1 while holding reader_mutex_, so
-        // checking readers and setting writer_active under it is atomic
-        // with respect to new readers (see writer_lock).
-        if (!reader_mutex_->try_lock()) {
-            writer_mutex_->unlock();
-            return false;
-        }
-
-        if (state_->readers.load(std::memory_order_acquire) > 0) {
-            reader_mutex_->unlock();
-            writer_mutex_->unlock();
-            return false;
+        uint32_t s = state_->word.load(std::memory_order_relaxed);
+        while ((s & ~WRITER_WAITING) == 0) {
+            if (state_->word.compare_exchange_weak(s, WRITER,
+                                                   std::memory_order_acquire,
+                                                   std::memory_order_relaxed)) {
+                return true;
+            }
         }
-
-        state_->writer_active.store(1, std::memory_order_release);
-        reader_mutex_->unlock();
-        return true;
+        return false;
     }
 
     /**
      * @brief Release write lock
      */
     void writer_unlock() {
-        state_->writer_active.store(0, std::memory_order_release);
-        writer_mutex_->unlock();
+        [[maybe_unused]] uint32_t prev =
+            state_->word.fetch_and(~WRITER, std::memory_order_seq_cst);
+        assert((prev & WRITER) && "writer_unlock without a matching writer_lock");
+        wake_parked();
     }
 
     // Prevent copying
@@ -227,10 +213,60 @@ public:
     RWLock& operator=(RWLock&&) = default;
 
 private:
+    // Spins before parking; sleeps are bounded so a lost wake (e.g. from a
+    // process that died mid-unlock) costs one slice, not a hang
+    static constexpr int SPIN_LIMIT = 128;
+    static constexpr auto PARK_SLICE = std::chrono::milliseconds(100);
+
     Memory& mem_;
     RWLockState* state_;
-    std::unique_ptr<Mutex> reader_mutex_;
-    std::unique_ptr<Mutex> writer_mutex_;
+
+    void release_reader() {
+        [[maybe_unused]] uint32_t prev =
+            state_->word.fetch_sub(1, std::memory_order_seq_cst);
+        assert((prev & READERS_MASK) > 0 && "reader_unlock without a matching reader_lock");
+        // Only a writer waiting for the count to drain cares about this
+        if ((prev & READERS_MASK) == 1 && (prev & WRITER_WAITING)) {
+            wake_parked();
+        }
+    }
+
+    // Ordered after the caller's seq_cst RMW on the word, pairing with the
+    // sleeper's registration in acquire_slow(): either the sleeper's futex
+    // sees our change to the word, or we see the sleeper.
+    void wake_parked() {
+        if (state_->parked.load(std::memory_order_seq_cst) != 0) {
+            detail::futex_wake(&state_->word);
+        }
+    }
+
+    // CAS the word to next(word) until that makes us an owner: the word
+    // gains the WRITER bit or one more reader. next returns nullopt to wait; any
+    // other transition (a writer setting WRITER_WAITING) is applied and the
+    // loop goes on.
+    template<typename Next>
+    void acquire_slow(Next&& next) {
+        for (int spins = 0;; ++spins) {
+            uint32_t s = state_->word.load(std::memory_order_relaxed);
+            if (auto want = next(s)) {
+                if (state_->word.compare_exchange_weak(s, *want,
+                                                       std::memory_order_acquire,
+                                                       std::memory_order_relaxed)) {
+                    if ((*want & ~s & WRITER) || (*want & READERS_MASK) > (s & READERS_MASK)) {
+                        return;
+                    }
+                }
+                continue;
+            }
+            if (spins < SPIN_LIMIT) {
+                std::this_thread::yield();
+                continue;
+            }
+            state_->parked.fetch_add(1, std::memory_order_seq_cst);
+            detail::futex_wait(&state_->word, s, PARK_SLICE);
+            state_->parked.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
 };
 
 /**
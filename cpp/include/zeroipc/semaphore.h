@@ -1,10 +1,13 @@
 #pragma once
 
 #include "memory.h"
-#include "detail/spin_wait.h"
+#include "detail/futex.h"
+#include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <limits>
 #include <stdexcept>
+#include <thread>
 
 namespace zeroipc {
 
@@ -14,26 +17,65 @@ namespace zeroipc {
  * A semaphore maintains a non-negative integer count representing available
  * resources or permits. Processes can acquire() to decrement the count and
  * release() to increment it. If count is zero, acquire() blocks until
- * another process calls release().
+ * another process calls release(). acquire(n), try_acquire(n) and
+ * release(n) take or return several permits in one step.
  *
  * Supports three modes:
  * - Binary semaphore (max_count=1): Acts as a mutex
  * - Counting semaphore (max_count=N): Resource pool with N permits
  * - Unbounded semaphore (max_count=0): No upper limit on count
  *
+ * Waiters spin briefly and then sleep on the count's futex word; release(n)
+ * wakes up to n of them, and only when the waiting count says someone may
+ * be asleep. A woken waiter that leaves permits behind - because it needed
+ * fewer, more, or timed out - passes the wake-up on to another sleeper.
+ *
+ * By default whoever retries first after a release wins, so a request for
+ * many permits can starve behind a stream of small ones. Order::Fifo
+ * serves acquirers strictly in arrival order instead: each takes a ticket
+ * and waits, on a queue slot of its own cache line, for its turn; only the
+ * head of the queue takes permits, and passes the turn on when done. At
+ * most QUEUE_SLOTS tickets are outstanding, so each slot serves one ticket
+ * at a time; further acquirers wait for room before taking one. A ticket
+ * whose acquire_for() times out is skipped. The FIFO layout is C++ only;
+ * other bindings reject it as a size mismatch.
+ *
  * Thread-safe and process-safe.
  */
 class Semaphore {
 public:
+    enum class Order {
+        Any,   // Whoever retries first (the cross-language layout)
+        Fifo   // Acquirers are served in arrival order
+    };
+
+    static constexpr int32_t QUEUE_SLOTS = 64;
+
     struct Header {
-        std::atomic<int32_t> count;      // Current count
+        std::atomic<int32_t> count;      // Current count (futex word)
         std::atomic<int32_t> waiting;    // Number of waiting processes
         int32_t max_count;               // Maximum count (0 = unbounded)
-        int32_t _padding;                // Alignment padding
+        int32_t queue_slots;             // FIFO queue slots, 0 when unordered
     };
 
     static_assert(sizeof(Header) == 16, "Header must be 16 bytes");
 
+    // FIFO mode: tickets handed out and the ticket whose turn it is
+    struct Queue {
+        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> next_ticket;
+        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> serving;
+    };
+
+    // FIFO mode: waiters for tickets t, t + QUEUE_SLOTS, ... sleep here
+    struct alignas(CACHE_LINE_SIZE) Slot {
+        std::atomic<uint32_t> turn;        // Low bits of the last ticket served here (futex word)
+        std::atomic<uint32_t> waiters;     // Waiters asleep on turn
+        std::atomic<uint64_t> abandoned;   // Timed-out ticket + 1, 0 when none
+    };
+
+    static constexpr size_t QUEUE_OFFSET = align_up(sizeof(Header), CACHE_LINE_SIZE);
+    static constexpr size_t SLOTS_OFFSET = QUEUE_OFFSET + sizeof(Queue);
+
     /**
      * Create a new semaphore.
      *
@@ -41,9 +83,11 @@ public:
      * @param name Unique identifier for this semaphore
      * @param initial_count Initial value for the semaphore count
      * @param max_count Maximum count (0 for unbounded, 1 for binary/mutex)
+     * @param order Order in which blocked acquirers are served
      */
     Semaphore(Memory& memory, std::string_view name,
-              int32_t initial_count, int32_t max_count = 0)
+              int32_t initial_count, int32_t max_count = 0,
+              Order order = Order::Any)
         : memory_(memory), name_(name) {
 
         if (initial_count < 0) {
@@ -58,15 +102,25 @@ public:
             throw std::invalid_argument("Initial count cannot exceed max count");
         }
 
-        size_t offset = memory.allocate(name, sizeof(Header));
-
-        header_ = memory.ptr_at<Header>(offset);
+        if (order == Order::Any) {
+            size_t offset = memory.allocate(name, sizeof(Header));
+            header_ = memory.ptr_at<Header>(offset);
+            header_->queue_slots = 0;
+        } else {
+            size_t offset = memory.allocate(name, fifo_size(), CACHE_LINE_SIZE);
+            header_ = memory.ptr_at<Header>(offset);
+            header_->queue_slots = QUEUE_SLOTS;
+            bind();
+            new (queue_) Queue{};
+            for (int32_t i = 0; i < QUEUE_SLOTS; ++i) {
+                new (&slots_[i]) Slot{};
+            }
+        }
 
         // Initialize header
         header_->count.store(initial_count, std::memory_order_relaxed);
         header_->waiting.store(0, std::memory_order_relaxed);
         header_->max_count = max_count;
-        header_->_padding = 0;
     }
 
     /**
@@ -83,106 +137,117 @@ public:
             throw std::runtime_error("Semaphore not found: " + std::string(name));
         }
 
-        if (size != sizeof(Header)) {
+        if (size < sizeof(Header)) {
             throw std::runtime_error("Invalid semaphore size");
         }
 
         header_ = memory.ptr_at<Header>(offset);
+
+        if (header_->queue_slots == 0) {
+            if (size != sizeof(Header)) {
+                throw std::runtime_error("Invalid semaphore size");
+            }
+        } else {
+            if (header_->queue_slots != QUEUE_SLOTS) {
+                throw std::runtime_error("Semaphore header is corrupt");
+            }
+            if (size < fifo_size()) {
+                throw std::runtime_error("Invalid semaphore size");
+            }
+            bind();
+        }
     }
 
     /**
-     * Acquire one permit from the semaphore.
-     * Blocks until a permit is available.
+     * Acquire permits from the semaphore.
+     * Blocks until enough permits are available (and, in FIFO order, until
+     * every earlier acquirer has been served).
      *
-     * Uses spin-waiting with exponential backoff to reduce CPU usage.
+     * @param permits Number of permits to take at once
+     * @throws std::invalid_argument if permits is not positive or exceeds max_count
      */
-    void acquire() {
-        header_->waiting.fetch_add(1, std::memory_order_relaxed);
-
-        detail::spin_wait([this] {
-            int32_t current = header_->count.load(std::memory_order_acquire);
-            if (current > 0) {
-                return header_->count.compare_exchange_weak(
-                    current, current - 1,
-                    std::memory_order_acquire,
-                    std::memory_order_relaxed);
-            }
-            return false;
-        });
-
-        header_->waiting.fetch_sub(1, std::memory_order_relaxed);
+    void acquire(int32_t permits = 1) {
+        check_permits(permits);
+        acquire_until(permits, std::chrono::steady_clock::time_point::max());
     }
 
     /**
-     * Try to acquire one permit without blocking.
+     * Try to acquire permits without blocking.
      *
-     * @return true if permit was acquired, false if count was 0
+     * In FIFO order this fails while anyone is queued, even if enough
+     * permits are available.
+     *
+     * @param permits Number of permits to take at once
+     * @return true if the permits were acquired, false if too few were available
+     * @throws std::invalid_argument if permits is not positive or exceeds max_count
      */
-    [[nodiscard]] bool try_acquire() {
-        int32_t current = header_->count.load(std::memory_order_acquire);
-
-        while (current > 0) {
-            if (header_->count.compare_exchange_weak(
-                    current, current - 1,
-                    std::memory_order_acquire,
-                    std::memory_order_relaxed)) {
-                return true;
-            }
-            // CAS failed, current was updated, retry
+    [[nodiscard]] bool try_acquire(int32_t permits = 1) {
+        check_permits(permits);
+        if (!queue_) {
+            return try_take(permits);
         }
 
-        return false;
+        // Take a ticket only if it is immediately our turn
+        uint64_t ticket = queue_->serving.load(std::memory_order_acquire);
+        if (!queue_->next_ticket.compare_exchange_strong(ticket, ticket + 1,
+                                                         std::memory_order_acq_rel,
+                                                         std::memory_order_relaxed)) {
+            return false;
+        }
+        bool acquired = try_take(permits);
+        pass_turn(ticket);
+        return acquired;
     }
 
     /**
-     * Try to acquire one permit with a timeout.
+     * Try to acquire permits with a timeout.
      *
      * @param timeout Maximum time to wait
-     * @return true if permit was acquired, false if timed out
+     * @param permits Number of permits to take at once
+     * @return true if the permits were acquired, false if timed out
+     * @throws std::invalid_argument if permits is not positive or exceeds max_count
      */
     template<typename Rep, typename Period>
     [[nodiscard]] bool acquire_for(
-            const std::chrono::duration<Rep, Period>& timeout) {
-
-        header_->waiting.fetch_add(1, std::memory_order_relaxed);
-
-        bool acquired = detail::spin_wait_for([this] {
-            int32_t current = header_->count.load(std::memory_order_acquire);
-            if (current > 0) {
-                return header_->count.compare_exchange_weak(
-                    current, current - 1,
-                    std::memory_order_acquire,
-                    std::memory_order_relaxed);
-            }
-            return false;
-        }, timeout);
+            const std::chrono::duration<Rep, Period>& timeout,
+            int32_t permits = 1) {
 
-        header_->waiting.fetch_sub(1, std::memory_order_relaxed);
-        return acquired;
+        check_permits(permits);
+        return acquire_until(permits, std::chrono::steady_clock::now() +
+            std::chrono::ceil<std::chrono::steady_clock::duration>(timeout));
     }
 
     /**
-     * Release one permit back to the semaphore.
-     * Increments the count, potentially waking a waiting process.
+     * Release permits back to the semaphore.
+     * Increments the count, waking waiting processes if any are asleep.
      *
+     * @param permits Number of permits to return at once
+     * @throws std::invalid_argument if permits is not positive
      * @throws std::overflow_error if max_count would be exceeded
      */
-    void release() {
+    void release(int32_t permits = 1) {
+        if (permits <= 0) {
+            throw std::invalid_argument("Permit count must be positive");
+        }
         int32_t max = header_->max_count;
 
         // Atomically check and increment to prevent TOCTOU race
         while (true) {
             int32_t current = header_->count.load(std::memory_order_relaxed);
-            if (max > 0 && current >= max) {
+            if (max > 0 ? current > max - permits
+                        : current > std::numeric_limits<int32_t>::max() - permits) {
                 throw std::overflow_error("Semaphore count would exceed maximum");
             }
-            if (header_->count.compare_exchange_weak(current, current + 1,
-                                                      std::memory_order_release,
+            if (header_->count.compare_exchange_weak(current, current + permits,
+                                                      std::memory_order_seq_cst,
                                                       std::memory_order_relaxed)) {
                 break;
             }
         }
-        // Waiting processes will see the incremented count and wake up
+
+        if (header_->waiting.load(std::memory_order_seq_cst) != 0) {
+            detail::futex_wake(count_word(), permits);
+        }
     }
 
     /**
@@ -212,6 +277,13 @@ public:
         return header_->max_count;
     }
 
+    /**
+     * Get the order in which blocked acquirers are served.
+     */
+    [[nodiscard]] Order order() const {
+        return queue_ ? Order::Fifo : Order::Any;
+    }
+
     /**
      * Get semaphore name.
      */
@@ -220,9 +292,234 @@ public:
     }
 
 private:
+    static constexpr int SPIN_LIMIT = 128;
+
+    // Longest single sleep, so a wake-up lost to a process that died
+    // mid-release (or to a binding that cannot wake) costs a delay rather
+    // than a hang
+    static constexpr auto PARK_SLICE = std::chrono::milliseconds(100);
+
+    using time_point = std::chrono::steady_clock::time_point;
+
     Memory& memory_;
     std::string name_;
     Header* header_;
+    Queue* queue_ = nullptr;  // FIFO order only
+    Slot* slots_ = nullptr;
+
+    static constexpr size_t fifo_size() {
+        return SLOTS_OFFSET + sizeof(Slot) * QUEUE_SLOTS;
+    }
+
+    void bind() {
+        char* base = reinterpret_cast<char*>(header_);
+        queue_ = reinterpret_cast<Queue*>(base + QUEUE_OFFSET);
+        slots_ = reinterpret_cast<Slot*>(base + SLOTS_OFFSET);
+    }
+
+    void check_permits(int32_t permits) const {
+        if (permits <= 0) {
+            throw std::invalid_argument("Permit count must be positive");
+        }
+        if (header_->max_count > 0 && permits > header_->max_count) {
+            throw std::invalid_argument("Permit count exceeds max count");
+        }
+    }
+
+    std::atomic<uint32_t>* count_word() const {
+        return reinterpret_cast<std::atomic<uint32_t>*>(&header_->count);
+    }
+
+    Slot& slot_for(uint64_t ticket) const {
+        return slots_[ticket % QUEUE_SLOTS];
+    }
+
+    bool try_take(int32_t permits) {
+        int32_t current = header_->count.load(std::memory_order_acquire);
+
+        while (current >= permits) {
+            if (header_->count.compare_exchange_weak(
+                    current, current - permits,
+                    std::memory_order_acquire,
+                    std::memory_order_relaxed)) {
+                return true;
+            }
+            // CAS failed, current was updated, retry
+        }
+
+        return false;
+    }
+
+    bool acquire_until(int32_t permits, time_point deadline) {
+        if (!queue_ && try_take(permits)) {
+            return true;
+        }
+
+        header_->waiting.fetch_add(1, std::memory_order_seq_cst);
+        bool acquired;
+        if (queue_) {
+            uint64_t ticket;
+            acquired = take_ticket(ticket, deadline) && await_turn(ticket, deadline);
+            if (acquired) {
+                acquired = take_until(permits, deadline);
+                pass_turn(ticket);
+            }
+        } else {
+            acquired = take_until(permits, deadline);
+        }
+        header_->waiting.fetch_sub(1, std::memory_order_relaxed);
+        return acquired;
+    }
+
+    // Take permits, sleeping on the count while there are too few. Called
+    // while counted in waiting, so release() knows to wake us.
+    bool take_until(int32_t permits, time_point deadline) {
+        for (int spin = 0; spin < SPIN_LIMIT; ++spin) {
+            if (try_take(permits)) {
+                return true;
+            }
+            std::this_thread::yield();
+        }
+        bool slept = false;
+        int32_t passed_at = -1;  // Count at which we last passed a wake-up on
+        for (;;) {
+            int32_t current = header_->count.load(std::memory_order_seq_cst);
+            if (current >= permits) {
+                if (try_take(permits)) {
+                    if (slept) {
+                        pass_wake();
+                    }
+                    return true;
+                }
+                continue;
+            }
+            auto now = std::chrono::steady_clock::now();
+            if (now >= deadline) {
+                if (slept) {
+                    pass_wake();
+                }
+                return false;
+            }
+            // Woken for permits we cannot use; someone asleep behind us may.
+            // Passing on once per count keeps waiters that all need more
+            // from waking each other in a circle.
+            if (slept && current > 0 && current != passed_at) {
+                passed_at = current;
+                pass_wake();
+            }
+            detail::futex_wait(count_word(), static_cast<uint32_t>(current),
+                               std::min<std::chrono::steady_clock::duration>(deadline - now,
+                                                                             PARK_SLICE));
+            slept = true;
+        }
+    }
+
+    // Wake one more sleeper on the count if permits are left and anyone
+    // besides us is waiting for them
+    void pass_wake() {
+        if (header_->count.load(std::memory_order_seq_cst) > 0 &&
+            header_->waiting.load(std::memory_order_seq_cst) > 1) {
+            detail::futex_wake(count_word(), 1);
+        }
+    }
+
+    // Take the next ticket once fewer than QUEUE_SLOTS are outstanding, so
+    // no two outstanding tickets share a slot. Returns false, holding no
+    // ticket, if the deadline passes first.
+    bool take_ticket(uint64_t& ticket, time_point deadline) {
+        for (int spin = 0;; ++spin) {
+            ticket = queue_->next_ticket.load(std::memory_order_acquire);
+            uint64_t serving = queue_->serving.load(std::memory_order_acquire);
+            if (ticket - serving < QUEUE_SLOTS) {
+                if (queue_->next_ticket.compare_exchange_weak(ticket, ticket + 1,
+                                                              std::memory_order_acq_rel,
+                                                              std::memory_order_relaxed)) {
+                    return true;
+                }
+                continue;
+            }
+            if (spin < SPIN_LIMIT) {
+                std::this_thread::yield();
+                continue;
+            }
+            // Room opens when ticket - QUEUE_SLOTS + 1 is served, which
+            // stores its turn in the slot ticket + 1 maps to
+            Slot& slot = slot_for(ticket + 1);
+            uint32_t turn = slot.turn.load(std::memory_order_seq_cst);
+            auto now = std::chrono::steady_clock::now();
+            if (now >= deadline) {
+                return false;
+            }
+            slot.waiters.fetch_add(1, std::memory_order_seq_cst);
+            if (queue_->serving.load(std::memory_order_seq_cst) == serving) {
+                detail::futex_wait(&slot.turn, turn,
+                                   std::min<std::chrono::steady_clock::duration>(deadline - now,
+                                                                                 PARK_SLICE));
+            }
+            slot.waiters.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Wait until ticket is served, spinning and then sleeping on its slot.
+    // Returns false if it timed out and the ticket was given up.
+    bool await_turn(uint64_t ticket, time_point deadline) {
+        for (int spin = 0; spin < SPIN_LIMIT; ++spin) {
+            if (queue_->serving.load(std::memory_order_acquire) == ticket) {
+                return true;
+            }
+            std::this_thread::yield();
+        }
+        Slot& slot = slot_for(ticket);
+        for (;;) {
+            uint32_t turn = slot.turn.load(std::memory_order_seq_cst);
+            if (queue_->serving.load(std::memory_order_seq_cst) == ticket) {
+                return true;
+            }
+            auto now = std::chrono::steady_clock::now();
+            if (now >= deadline) {
+                abandon(ticket);
+                return false;
+            }
+            slot.waiters.fetch_add(1, std::memory_order_seq_cst);
+            if (queue_->serving.load(std::memory_order_seq_cst) != ticket) {
+                detail::futex_wait(&slot.turn, turn,
+                                   std::min<std::chrono::steady_clock::duration>(deadline - now,
+                                                                                 PARK_SLICE));
+            }
+            slot.waiters.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Mark a timed-out ticket so whoever serves it passes over it. If its
+    // turn came meanwhile, pass the turn on ourselves; the CAS on abandoned
+    // decides which of us does. The slot's mark is ours alone: take_ticket()
+    // hands out its next ticket only after this one has been served.
+    void abandon(uint64_t ticket) {
+        Slot& slot = slot_for(ticket);
+        slot.abandoned.store(ticket + 1, std::memory_order_seq_cst);
+        if (queue_->serving.load(std::memory_order_seq_cst) == ticket) {
+            uint64_t mine = ticket + 1;
+            if (slot.abandoned.compare_exchange_strong(mine, 0, std::memory_order_seq_cst)) {
+                pass_turn(ticket);
+            }
+        }
+    }
+
+    // Hand the turn to the next ticket, skipping tickets given up on
+    void pass_turn(uint64_t ticket) {
+        for (uint64_t next = ticket + 1;; ++next) {
+            queue_->serving.store(next, std::memory_order_seq_cst);
+            Slot& slot = slot_for(next);
+            slot.turn.store(static_cast<uint32_t>(next), std::memory_order_seq_cst);
+            if (slot.waiters.load(std::memory_order_seq_cst) != 0) {
+                detail::futex_wake(&slot.turn);
+            }
+            uint64_t abandoned = next + 1;
+            if (!slot.abandoned.compare_exchange_strong(abandoned, 0, std::memory_order_seq_cst)) {
+                return;
+            }
+        }
+    }
 };
 
 /**
@@ -239,13 +536,14 @@ private:
  */
 class SemaphoreGuard {
 public:
-    explicit SemaphoreGuard(Semaphore& sem) : sem_(sem), acquired_(true) {
-        sem_.acquire();
+    explicit SemaphoreGuard(Semaphore& sem, int32_t permits = 1)
+        : sem_(sem), permits_(permits), acquired_(true) {
+        sem_.acquire(permits_);
     }
 
     ~SemaphoreGuard() {
         if (acquired_) {
-            sem_.release();
+            sem_.release(permits_);
         }
     }
 
@@ -255,7 +553,7 @@ public:
 
     // Movable
     SemaphoreGuard(SemaphoreGuard&& other) noexcept
-        : sem_(other.sem_), acquired_(other.acquired_) {
+        : sem_(other.sem_), permits_(other.permits_), acquired_(other.acquired_) {
         other.acquired_ = false;
     }
 
@@ -264,6 +562,7 @@ public:
 
 private:
     Semaphore& sem_;
+    int32_t permits_;
     bool acquired_;
 };
 
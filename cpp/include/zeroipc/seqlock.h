@@ -0,0 +1,228 @@
+#pragma once
+
+#include "memory.h"
+#include "detail/futex.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+
+namespace zeroipc {
+
+/**
+ * @brief Sequence lock holding one value of T
+ *
+ * Optimistic reads for values that are read far more often than they are
+ * written (status structs, telemetry, configuration). A writer makes the
+ * sequence odd, copies the value in and makes it even again; a reader
+ * copies the value out between two loads of the sequence and retries if
+ * they differ or were odd. Readers never block the writer and never write
+ * shared memory, so any number of them run in parallel without sharing a
+ * cache line in modified state.
+ *
+ * Writers claim the odd sequence with a CAS, so concurrent writers are
+ * serialized rather than corrupting the value, but the structure is meant
+ * for one writer at a time. A writer that dies mid-store leaves the
+ * sequence odd; load() then throws after READ_ATTEMPTS tries.
+ *
+ * wait_for_change() parks on the low 32 bits of the sequence with
+ * FUTEX_WAIT and counts itself in `waiters`; a store wakes everyone parked
+ * only when that count is non-zero, so writers without waiters pay one
+ * extra load and idle waiters cost nothing.
+ *
+ * Signal<T> is built on SeqLock<T>; C, Go and Python implement the same
+ * layout (see SPECIFICATION.md).
+ *
+ * @layout [Header(16)][pad to section alignment][T]
+ *
+ * @tparam T Value type (must be trivially copyable)
+ */
+template<typename T>
+class SeqLock {
+public:
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "SeqLock values must be trivially copyable");
+    static_assert(alignof(T) <= MAX_ELEM_ALIGN,
+                  "T alignment exceeds the largest supported allocation alignment");
+
+    struct Header {
+        std::atomic<uint64_t> seq;  // Even: stable, odd: write in progress
+        uint32_t elem_size;
+        std::atomic<uint32_t> waiters;  // Threads parked in wait_for_change
+    };
+
+    static_assert(std::endian::native == std::endian::little,
+                  "waiters park on the low half of seq, at offset 0");
+
+    static constexpr size_t ALIGN = section_align<T>();
+    static constexpr size_t VALUE_OFFSET = align_up(sizeof(Header), ALIGN);
+    static constexpr size_t TOTAL_SIZE = VALUE_OFFSET + sizeof(T);
+
+    static constexpr int SPIN_ATTEMPTS = 64;
+    static constexpr int READ_ATTEMPTS = 1 << 20;
+
+    // Longest single futex sleep, so writers that cannot wake (e.g. Python
+    // without the FFI library) still get noticed
+    static constexpr auto PARK_SLICE = std::chrono::milliseconds(100);
+
+    // Create a new seqlock holding initial
+    SeqLock(Memory& memory, std::string_view name, const T& initial)
+        : memory_(memory), name_(name) {
+        size_t offset = memory.allocate(name, TOTAL_SIZE, ALIGN);
+        header_ = memory.ptr_at<Header>(offset);
+        header_->seq.store(0, std::memory_order_relaxed);
+        header_->elem_size = sizeof(T);
+        header_->waiters.store(0, std::memory_order_relaxed);
+        bind();
+        std::memcpy(value_, &initial, sizeof(T));
+    }
+
+    // Open an existing seqlock
+    SeqLock(Memory& memory, std::string_view name)
+        : memory_(memory), name_(name) {
+        auto* entry = memory.table()->find(name);
+        if (!entry) {
+            throw std::runtime_error("SeqLock not found: " + std::string(name));
+        }
+        if (entry->section_align() != ALIGN) {
+            throw std::runtime_error("Alignment mismatch");
+        }
+        header_ = memory.ptr_at<Header>(entry->offset);
+        if (header_->elem_size != sizeof(T) || entry->size < TOTAL_SIZE) {
+            throw std::runtime_error("Type size mismatch");
+        }
+        bind();
+    }
+
+    /**
+     * Copy out the value as of the last completed store. Returns false if
+     * no clean copy was possible within READ_ATTEMPTS (a writer died
+     * mid-store, or stores never pause).
+     */
+    [[nodiscard]] bool try_load(T& out) const {
+        for (int attempt = 0; attempt < READ_ATTEMPTS; ++attempt) {
+            uint64_t before = header_->seq.load(std::memory_order_acquire);
+            if ((before & 1) == 0) {
+                std::memcpy(&out, value_, sizeof(T));
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (header_->seq.load(std::memory_order_relaxed) == before) {
+                    return true;
+                }
+            }
+            if (attempt >= SPIN_ATTEMPTS) {
+                std::this_thread::yield();
+            }
+        }
+        return false;
+    }
+
+    // Current value; throws if try_load gives up
+    [[nodiscard]] T load() const {
+        T out;
+        if (!try_load(out)) {
+            throw std::runtime_error("SeqLock value is stuck mid-write: " + name_);
+        }
+        return out;
+    }
+
+    // Replace the value
+    void store(const T& value) {
+        begin_write();
+        std::memcpy(value_, &value, sizeof(T));
+        end_write();
+    }
+
+    // Replace the value with fn(current) and return the new value. The
+    // read-modify-write is atomic with respect to other writers.
+    template<typename F>
+    T update(F&& fn) {
+        begin_write();
+        T current;
+        std::memcpy(&current, value_, sizeof(T));
+        T next = fn(current);
+        std::memcpy(value_, &next, sizeof(T));
+        end_write();
+        return next;
+    }
+
+    // Sequence number: twice the number of completed stores (odd while a
+    // store is in progress)
+    [[nodiscard]] uint64_t sequence() const {
+        return header_->seq.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Block until a store completes after the one that produced `seen` (a
+     * value returned by sequence()), or until timeout expires.
+     * @return true if the value changed, false on timeout
+     */
+    template<typename Rep, typename Period>
+    [[nodiscard]] bool wait_for_change(
+            uint64_t seen, const std::chrono::duration<Rep, Period>& timeout) {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        for (;;) {
+            uint64_t seq = header_->seq.load(std::memory_order_acquire);
+            if ((seq & ~uint64_t(1)) != (seen & ~uint64_t(1))) {
+                return true;
+            }
+            auto now = std::chrono::steady_clock::now();
+            if (now >= deadline) {
+                return false;
+            }
+            // Pairs with end_write: either the writer sees us counted, or
+            // the futex sees its new sequence and does not sleep
+            header_->waiters.fetch_add(1, std::memory_order_seq_cst);
+            if (header_->seq.load(std::memory_order_seq_cst) == seq) {
+                detail::futex_wait(seq_word(), static_cast<uint32_t>(seq),
+                                   std::min<std::chrono::nanoseconds>(deadline - now, PARK_SLICE));
+            }
+            header_->waiters.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    [[nodiscard]] std::string_view name() const { return name_; }
+
+private:
+    Memory& memory_;
+    std::string name_;
+    Header* header_ = nullptr;
+    unsigned char* value_ = nullptr;
+
+    void bind() {
+        value_ = reinterpret_cast<unsigned char*>(header_) + VALUE_OFFSET;
+    }
+
+    void begin_write() {
+        for (int spins = 0;; ++spins) {
+            uint64_t seq = header_->seq.load(std::memory_order_relaxed);
+            if ((seq & 1) == 0 &&
+                header_->seq.compare_exchange_weak(seq, seq + 1,
+                                                   std::memory_order_acquire,
+                                                   std::memory_order_relaxed)) {
+                // Keep the value stores below from moving above the odd seq
+                std::atomic_thread_fence(std::memory_order_release);
+                return;
+            }
+            if (spins >= SPIN_ATTEMPTS) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void end_write() {
+        header_->seq.fetch_add(1, std::memory_order_seq_cst);  // Even again
+        if (header_->waiters.load(std::memory_order_seq_cst) != 0) {
+            detail::futex_wake(seq_word());
+        }
+    }
+
+    std::atomic<uint32_t>* seq_word() const {
+        return reinterpret_cast<std::atomic<uint32_t>*>(&header_->seq);
+    }
+};
+
+} // namespace zeroipc
@@ -13,7 +13,7 @@ public:
     static_assert(std::is_trivially_copyable_v<T>,
                   "T must be trivially copyable for shared memory");
     static_assert(alignof(T) <= MAX_ELEM_ALIGN,
-                  "T alignment exceeds the 8-byte guarantee of shared memory layout");
+                  "T alignment exceeds the largest supported allocation alignment");
 
     struct Entry {
         std::atomic<uint32_t> state;  // 0=empty, 1=occupied, 2=deleted, 3=inserting
@@ -26,6 +26,11 @@ public:
         uint32_t elem_size;
         uint32_t reserved;                 // pads header to 16 bytes so Entry array is 8-aligned
     };
+
+    // Data starts on the section alignment, recorded in the table entry
+    // (8 for ordinary types).
+    static constexpr size_t ALIGN = section_align<Entry>();
+    static constexpr size_t DATA_OFFSET = align_up(sizeof(Header), ALIGN);
     
     // State values for entries
     static constexpr uint32_t EMPTY = 0;
@@ -46,12 +51,12 @@ public:
         }
         
         // Check for overflow
-        if (capacity > (SIZE_MAX - sizeof(Header)) / sizeof(Entry)) {
+        if (capacity > (SIZE_MAX - DATA_OFFSET) / sizeof(Entry)) {
             throw std::overflow_error("Set capacity too large");
         }
         
-        size_t total_size = sizeof(Header) + sizeof(Entry) * capacity;
-        size_t offset = memory.allocate(name, total_size);
+        size_t total_size = DATA_OFFSET + sizeof(Entry) * capacity;
+        size_t offset = memory.allocate(name, total_size, ALIGN);
         
         header_ = memory.ptr_at<Header>(offset);
 
@@ -62,7 +67,7 @@ public:
         header_->reserved = 0;
 
         entries_ = reinterpret_cast<Entry*>(
-            reinterpret_cast<char*>(header_) + sizeof(Header));
+            reinterpret_cast<char*>(header_) + DATA_OFFSET);
         
         // Initialize all entries as empty
         for (size_t i = 0; i < capacity; ++i) {
@@ -74,19 +79,22 @@ public:
     Set(Memory& memory, std::string_view name)
         : memory_(memory), name_(name) {
         
-        size_t offset, size;
-        if (!memory.find(name, offset, size)) {
+        auto* entry = memory.table()->find(name);
+        if (!entry) {
             throw std::runtime_error("Set not found: " + std::string(name));
         }
-        
-        header_ = memory.ptr_at<Header>(offset);
+        if (entry->section_align() != ALIGN) {
+            throw std::runtime_error("Alignment mismatch");
+        }
+
+        header_ = memory.ptr_at<Header>(entry->offset);
 
         if (header_->elem_size != sizeof(T)) {
             throw std::runtime_error("Type size mismatch");
         }
         
         entries_ = reinterpret_cast<Entry*>(
-            reinterpret_cast<char*>(header_) + sizeof(Header));
+            reinterpret_cast<char*>(header_) + DATA_OFFSET);
     }
     
     // Insert element (lock-free with linear probing)
@@ -0,0 +1,313 @@
+#pragma once
+
+#include "memory.h"
+#include "detail/hash.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <optional>
+#include <unistd.h>
+
+namespace zeroipc {
+
+/**
+ * @brief Multi-lane MPMC queue for high producer counts
+ *
+ * ShardedQueue<T> splits one logical queue into N independent Vyukov lanes
+ * stored in a single table entry. Each lane's head and tail live on their
+ * own cache lines, so producers on different lanes never contend on a
+ * shared tail CAS, which is the bottleneck of Queue<T> beyond a handful of
+ * producers.
+ *
+ * Producers stick to a lane per thread (or pick one by key with
+ * push_to); a full lane spills to the next. Consumers start at the lane
+ * they last found data in and sweep the others (work stealing), optionally
+ * draining batches.
+ *
+ * @ordering FIFO holds per lane only. Values one thread (or one push_to
+ * key) pushes come out in order only while its lane never fills: a push
+ * that spills to another lane may be popped before values still queued on
+ * the home lane. Values from different threads interleave arbitrarily.
+ *
+ * @layout
+ *   [Header(16)][pad to lane alignment L = max(64, section alignment)]
+ *   lane[i] at L_OFF + i * lane_stride:
+ *     [head:u32 | pad to 64][tail:u32 | pad to 64]
+ *     [data: T * lane_capacity, section-aligned][seq: u32 * lane_capacity]
+ *     [pad to L]
+ *
+ * @tparam T Element type (must be trivially copyable)
+ */
+template<typename T>
+class ShardedQueue {
+public:
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "T must be trivially copyable for shared memory");
+    static_assert(alignof(T) <= MAX_ELEM_ALIGN,
+                  "T alignment exceeds the largest supported allocation alignment");
+
+    struct Header {
+        uint32_t lanes;           // Number of lanes
+        uint32_t lane_capacity;   // Slots per lane (power of two)
+        uint32_t elem_size;       // sizeof(T)
+        uint32_t reserved;
+    };
+
+    static constexpr size_t ALIGN = section_align<T>();
+    static constexpr size_t LANE_ALIGN = std::max(CACHE_LINE_SIZE, ALIGN);
+    static constexpr size_t LANES_OFFSET = align_up(sizeof(Header), LANE_ALIGN);
+    static constexpr size_t MAX_LANES = 1024;
+
+    // Create a queue of `lanes` lanes holding at least `capacity` elements
+    // in total (each lane rounds up to a power of two for wrap-safety).
+    ShardedQueue(Memory& memory, std::string_view name, size_t capacity, size_t lanes)
+        : memory_(memory), name_(name) {
+
+        if (lanes == 0 || lanes > MAX_LANES) {
+            throw std::invalid_argument("ShardedQueue lane count must be in 1..1024");
+        }
+        if (capacity == 0) {
+            throw std::invalid_argument("ShardedQueue capacity must be greater than 0");
+        }
+
+        size_t lane_cap = (capacity + lanes - 1) / lanes;
+        if (lane_cap > (size_t(1) << 31)) {
+            throw std::overflow_error("ShardedQueue capacity too large");
+        }
+        lane_cap = std::bit_ceil(lane_cap);
+
+        size_t stride = lane_stride(lane_cap);
+        if (stride > (SIZE_MAX - LANES_OFFSET) / lanes) {
+            throw std::overflow_error("ShardedQueue capacity too large");
+        }
+
+        size_t offset = memory.allocate(name, LANES_OFFSET + stride * lanes, LANE_ALIGN);
+        header_ = memory.ptr_at<Header>(offset);
+        header_->lanes = static_cast<uint32_t>(lanes);
+        header_->lane_capacity = static_cast<uint32_t>(lane_cap);
+        header_->elem_size = sizeof(T);
+        header_->reserved = 0;
+
+        bind_lanes(stride);
+        for (size_t l = 0; l < lanes; l++) {
+            Lane lane = lane_at(l);
+            lane.head->store(0, std::memory_order_relaxed);
+            lane.tail->store(0, std::memory_order_relaxed);
+            for (size_t i = 0; i < lane_cap; i++) {
+                lane.seq[i].store(static_cast<uint32_t>(i), std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Open existing queue
+    ShardedQueue(Memory& memory, std::string_view name)
+        : memory_(memory), name_(name) {
+
+        auto* entry = memory.table()->find(name);
+        if (!entry) {
+            throw std::runtime_error("ShardedQueue not found: " + std::string(name));
+        }
+
+        header_ = memory.ptr_at<Header>(entry->offset);
+
+        if (header_->elem_size != sizeof(T)) {
+            throw std::runtime_error("Type size mismatch");
+        }
+        if (entry->section_align() != LANE_ALIGN) {
+            throw std::runtime_error("Alignment mismatch");
+        }
+        uint32_t lanes = header_->lanes;
+        uint32_t lane_cap = header_->lane_capacity;
+        if (lanes == 0 || lanes > MAX_LANES || lane_cap == 0 ||
+            (lane_cap & (lane_cap - 1)) != 0 ||
+            LANES_OFFSET + lane_stride(lane_cap) * lanes > entry->size) {
+            throw std::runtime_error("ShardedQueue header is corrupt");
+        }
+
+        bind_lanes(lane_stride(lane_cap));
+    }
+
+    // Push on the calling thread's lane, spilling to the next lanes when
+    // it is full. Returns false only when every lane is full.
+    [[nodiscard]] bool push(const T& value) {
+        return push_from(home_lane(), value);
+    }
+
+    // Push on the lane chosen by key (e.g. a flow id, to keep one flow's
+    // values in order even across threads), spilling when it is full.
+    [[nodiscard]] bool push_to(size_t key, const T& value) {
+        return push_from(key % header_->lanes, value);
+    }
+
+    // Pop from the lane this thread last found data in, then steal from
+    // the others in order
+    [[nodiscard]] std::optional<T> pop() {
+        const size_t lanes = header_->lanes;
+        size_t& cursor = pop_cursor();
+        for (size_t i = 0; i < lanes; i++) {
+            size_t l = (cursor + i) % lanes;
+            if (auto value = lane_pop(lane_at(l))) {
+                cursor = l;
+                return value;
+            }
+        }
+        return std::nullopt;
+    }
+
+    // Drain up to max_count values, emptying one lane before moving to the
+    // next so consecutive values share cache lines. Returns the count.
+    [[nodiscard]] size_t pop_bulk(T* out, size_t max_count) {
+        const size_t lanes = header_->lanes;
+        size_t& cursor = pop_cursor();
+        size_t n = 0;
+        for (size_t i = 0; i < lanes && n < max_count; i++) {
+            size_t l = (cursor + i) % lanes;
+            Lane lane = lane_at(l);
+            while (n < max_count) {
+                auto value = lane_pop(lane);
+                if (!value) {
+                    break;
+                }
+                out[n++] = *value;
+                cursor = l;
+            }
+        }
+        return n;
+    }
+
+    // Approximate in concurrent context
+    [[nodiscard]] size_t size() const {
+        size_t total = 0;
+        for (size_t l = 0; l < header_->lanes; l++) {
+            Lane lane = lane_at(l);
+            total += static_cast<uint32_t>(lane.tail->load(std::memory_order_acquire) -
+                                           lane.head->load(std::memory_order_acquire));
+        }
+        return total;
+    }
+
+    [[nodiscard]] bool empty() const { return size() == 0; }
+
+    [[nodiscard]] size_t lanes() const { return header_->lanes; }
+    [[nodiscard]] size_t lane_capacity() const { return header_->lane_capacity; }
+    [[nodiscard]] size_t capacity() const {
+        return size_t(header_->lanes) * header_->lane_capacity;
+    }
+
+private:
+    struct Lane {
+        std::atomic<uint32_t>* head;
+        std::atomic<uint32_t>* tail;
+        T* data;
+        std::atomic<uint32_t>* seq;
+    };
+
+    // Within a lane: head on its own line, tail on the next, then data
+    static constexpr size_t TAIL_OFFSET = CACHE_LINE_SIZE;
+    static constexpr size_t DATA_OFFSET = align_up(2 * CACHE_LINE_SIZE, ALIGN);
+
+    static size_t lane_stride(size_t lane_cap) {
+        size_t seq_off = DATA_OFFSET + align_up(sizeof(T) * lane_cap, ALIGN);
+        return align_up(seq_off + sizeof(std::atomic<uint32_t>) * lane_cap, LANE_ALIGN);
+    }
+
+    Memory& memory_;
+    std::string name_;
+    Header* header_;
+    char* lanes_base_ = nullptr;
+    size_t stride_ = 0;
+    size_t seq_offset_ = 0;
+
+    void bind_lanes(size_t stride) {
+        lanes_base_ = reinterpret_cast<char*>(header_) + LANES_OFFSET;
+        stride_ = stride;
+        seq_offset_ = DATA_OFFSET + align_up(sizeof(T) * header_->lane_capacity, ALIGN);
+    }
+
+    Lane lane_at(size_t l) const {
+        char* base = lanes_base_ + l * stride_;
+        return Lane{
+            reinterpret_cast<std::atomic<uint32_t>*>(base),
+            reinterpret_cast<std::atomic<uint32_t>*>(base + TAIL_OFFSET),
+            reinterpret_cast<T*>(base + DATA_OFFSET),
+            reinterpret_cast<std::atomic<uint32_t>*>(base + seq_offset_)};
+    }
+
+    // Threads are numbered on first use, counting up from a hash of the
+    // pid (as in MCSMutex::preferred_node), so each process starts on a
+    // different lane and its own threads then spread one per lane.
+    size_t home_lane() const {
+        static std::atomic<uint32_t> next_thread{0};
+        thread_local const size_t thread_index =
+            (detail::trivial_hash(static_cast<size_t>(::getpid())) >> 16) +
+            next_thread.fetch_add(1, std::memory_order_relaxed);
+        return thread_index % header_->lanes;
+    }
+
+    // Consumers start where they last found data (initially their home
+    // lane), so a steady consumer does not rescan empty lanes on every pop.
+    // Shared by all queues of this T on the thread; it is only a hint.
+    size_t& pop_cursor() const {
+        thread_local size_t cursor = home_lane();
+        return cursor;
+    }
+
+    bool push_from(size_t start, const T& value) {
+        const size_t lanes = header_->lanes;
+        for (size_t i = 0; i < lanes; i++) {
+            if (lane_push(lane_at((start + i) % lanes), value)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Vyukov bounded MPMC push/pop on one lane (see Queue<T>)
+    bool lane_push(const Lane& lane, const T& value) {
+        const uint32_t cap = header_->lane_capacity;
+        for (;;) {
+            uint32_t tail = lane.tail->load(std::memory_order_relaxed);
+            uint32_t slot = tail & (cap - 1);
+            uint32_t seq = lane.seq[slot].load(std::memory_order_acquire);
+            auto diff = static_cast<int32_t>(seq) - static_cast<int32_t>(tail);
+
+            if (diff == 0) {
+                if (lane.tail->compare_exchange_weak(
+                        tail, tail + 1,
+                        std::memory_order_relaxed,
+                        std::memory_order_relaxed)) {
+                    lane.data[slot] = value;
+                    lane.seq[slot].store(tail + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // Lane full
+            }
+        }
+    }
+
+    std::optional<T> lane_pop(const Lane& lane) {
+        const uint32_t cap = header_->lane_capacity;
+        for (;;) {
+            uint32_t head = lane.head->load(std::memory_order_relaxed);
+            uint32_t slot = head & (cap - 1);
+            uint32_t seq = lane.seq[slot].load(std::memory_order_acquire);
+            auto diff = static_cast<int32_t>(seq) - static_cast<int32_t>(head + 1);
+
+            if (diff == 0) {
+                if (lane.head->compare_exchange_weak(
+                        head, head + 1,
+                        std::memory_order_relaxed,
+                        std::memory_order_relaxed)) {
+                    T value = lane.data[slot];
+                    lane.seq[slot].store(head + cap, std::memory_order_release);
+                    return value;
+                }
+            } else if (diff < 0) {
+                return std::nullopt;  // Lane empty
+            }
+        }
+    }
+};
+
+} // namespace zeroipc
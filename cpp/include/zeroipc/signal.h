@@ -7,26 +7,10 @@
 #include <string_view>
 #include <stdexcept>
 #include "memory.h"
-#include "mutex.h"
+#include "seqlock.h"
 
 namespace zeroipc {
 
-/**
- * @brief Signal state for shared memory
- *
- * Binary layout:
- * - 8 bytes: version (increments on each change)
- * - T bytes: value
- */
-template<typename T>
-struct SignalState {
-    std::atomic<uint64_t> version{0};
-    T value;
-
-    SignalState() : version(0), value() {}
-    explicit SignalState(const T& val) : version(0), value(val) {}
-};
-
 /**
  * @brief Reactive signal for fine-grained reactivity across processes
  *
@@ -41,6 +25,11 @@ struct SignalState {
  * - Local callbacks via on_change()
  * - Atomic updates via update()
  *
+ * The value lives in a SeqLock<T> under the signal's name: get() is an
+ * optimistic copy that never blocks or writes shared memory, and the
+ * version is the SeqLock sequence halved (the number of completed sets).
+ * wait_for_change() parks on the same sequence word.
+ *
  * This enables reactive programming patterns across shared memory!
  *
  * Example:
@@ -79,40 +68,7 @@ public:
      */
     Signal(Memory& mem, std::string_view name,
            const T& initial_value, bool create_if_missing)
-        : mem_(mem) {
-
-        std::string state_name = std::string(name) + "_state";
-        std::string mutex_name = std::string(name) + "_mtx";
-
-        auto entry = mem.table()->find(name);
-
-        if (entry) {
-            // Open existing
-            auto state_entry = mem.table()->find(state_name);
-            if (!state_entry) {
-                throw std::runtime_error("Signal state not found");
-            }
-
-            state_ = mem.ptr_at<SignalState<T>>(state_entry->offset);
-
-            mutex_ = std::make_unique<Mutex>(mem, mutex_name);
-        } else {
-            if (!create_if_missing) {
-                throw std::runtime_error("Signal not found: " + std::string(name));
-            }
-
-            // Create new
-            size_t state_offset = mem.allocate(state_name, sizeof(SignalState<T>));
-            state_ = mem.ptr_at<SignalState<T>>(state_offset);
-            new (state_) SignalState<T>(initial_value);
-
-            mutex_ = std::make_unique<Mutex>(mem, mutex_name);
-
-            // Add marker
-            size_t marker_offset = mem.allocate(name, 1);
-            (void)marker_offset;
-        }
-    }
+        : value_(open_or_create(mem, name, initial_value, create_if_missing)) {}
 
     /**
      * @brief Create a new Signal
@@ -135,10 +91,7 @@ public:
      * @return Copy of current value
      */
     [[nodiscard]] T get() const {
-        mutex_->lock();
-        T value = state_->value;
-        mutex_->unlock();
-        return value;
+        return value_.load();
     }
 
     /**
@@ -150,10 +103,7 @@ public:
      * @param new_value New value to set
      */
     void set(const T& new_value) {
-        mutex_->lock();
-        state_->value = new_value;
-        state_->version.fetch_add(1, std::memory_order_release);
-        mutex_->unlock();
+        value_.store(new_value);
 
         // Trigger local callbacks
         for (auto& callback : callbacks_) {
@@ -175,11 +125,7 @@ public:
      */
     template<typename F>
     void update(F&& func) {
-        mutex_->lock();
-        state_->value = func(state_->value);
-        state_->version.fetch_add(1, std::memory_order_release);
-        T new_val = state_->value;
-        mutex_->unlock();
+        T new_val = value_.update(std::forward<F>(func));
 
         // Trigger local callbacks
         for (auto& callback : callbacks_) {
@@ -195,7 +141,7 @@ public:
      * @return Current version number
      */
     [[nodiscard]] uint64_t version() const {
-        return state_->version.load(std::memory_order_acquire);
+        return value_.sequence() / 2;
     }
 
     /**
@@ -211,7 +157,9 @@ public:
     /**
      * @brief Wait for signal to change
      *
-     * Blocks until the signal's version changes from old_version.
+     * Blocks until the signal's version changes from old_version. Waiters
+     * sleep on a futex that set() and update() wake, from any process, so
+     * an idle waiter costs nothing and a change is seen after one wake-up.
      *
      * @param old_version Version to wait for change from
      * @param timeout Maximum time to wait
@@ -222,16 +170,7 @@ public:
             uint64_t old_version,
             const std::chrono::duration<Rep, Period>& timeout) {
 
-        auto deadline = std::chrono::steady_clock::now() + timeout;
-
-        while (std::chrono::steady_clock::now() < deadline) {
-            if (has_changed(old_version)) {
-                return true;
-            }
-            std::this_thread::sleep_for(std::chrono::microseconds(100));
-        }
-
-        return false;
+        return value_.wait_for_change(old_version * 2, timeout);
     }
 
     /**
@@ -255,10 +194,19 @@ public:
     Signal& operator=(Signal&&) = default;
 
 private:
-    Memory& mem_;
-    SignalState<T>* state_;
-    std::unique_ptr<Mutex> mutex_;
+    SeqLock<T> value_;
     std::vector<std::function<void(const T&)>> callbacks_;
+
+    static SeqLock<T> open_or_create(Memory& mem, std::string_view name,
+                                     const T& initial_value, bool create_if_missing) {
+        if (mem.table()->find(name)) {
+            return SeqLock<T>(mem, name);
+        }
+        if (!create_if_missing) {
+            throw std::runtime_error("Signal not found: " + std::string(name));
+        }
+        return SeqLock<T>(mem, name, initial_value);
+    }
 };
 
 } // namespace zeroipc
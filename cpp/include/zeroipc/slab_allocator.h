@@ -0,0 +1,372 @@
+#pragma once
+
+#include "memory.h"
+#include "pool.h"
+#include "detail/spin_wait.h"
+#include <atomic>
+#include <bit>
+#include <cstring>
+
+namespace zeroipc {
+
+/**
+ * @brief Variable-size block allocator built on Pool
+ *
+ * Serves blocks of 64 B to 64 KB in power-of-two size classes. Memory is
+ * carved from 256 KB slabs that live in a Pool<Slab>; a slab belongs to one
+ * size class while it holds live blocks and goes back to the pool as soon as
+ * it empties, so any other class can reuse it.
+ *
+ * Blocks are named by Handle, their offset from the segment base, which is
+ * valid in every process mapping the segment. That lets variable-size
+ * messages sit in the allocator while only handles travel through a
+ * Queue<SlabAllocator::Handle>.
+ *
+ * Each size class has a spinlock guarding its list of partially used slabs;
+ * getting a fresh slab or returning an empty one is a lock-free Pool
+ * operation.
+ *
+ * @layout
+ *   Entry `name`:        [Header(16) | pad to 64][ClassState(64) * CLASSES]
+ *                        [SlabDesc(24) * slabs]
+ *   Entry `name.slabs`:  Pool<Slab> of `slabs` slabs of SLAB_SIZE bytes
+ *   Free blocks in a slab form a list through their first 4 bytes; blocks
+ *   past `carved` have never been handed out.
+ */
+class SlabAllocator {
+public:
+    using Handle = uint64_t;
+    static constexpr Handle NULL_HANDLE = 0;  // Offset 0 is the table header
+
+    static constexpr size_t MIN_BLOCK = 64;
+    static constexpr size_t MAX_BLOCK = 64 * 1024;
+    static constexpr size_t CLASSES = 11;  // 64 B, 128 B, ..., 64 KB
+    static constexpr size_t SLAB_SIZE = 256 * 1024;
+
+    struct alignas(CACHE_LINE_SIZE) Slab {
+        char bytes[SLAB_SIZE];
+    };
+
+    struct Header {
+        uint32_t slab_size;
+        uint32_t classes;
+        uint32_t slabs;
+        uint32_t reserved;
+    };
+
+    // Per-class state, one cache line each
+    struct alignas(CACHE_LINE_SIZE) ClassState {
+        std::atomic<uint32_t> lock;
+        uint32_t partial_head;  // First slab with free blocks, or NONE
+        uint32_t slabs;         // Slabs owned by this class
+        uint32_t used;          // Live blocks in this class
+        uint32_t carved;        // Blocks ever handed out from its slabs
+    };
+
+    // Per-slab bookkeeping, guarded by the owning class's lock
+    struct SlabDesc {
+        uint32_t size_class;  // NONE while the slab is in the pool
+        uint32_t used;
+        uint32_t free_head;   // Block index, or NONE
+        uint32_t carved;      // Blocks ever handed out from this slab
+        uint32_t prev;        // Partial list links
+        uint32_t next;
+    };
+
+    // Occupancy of one size class. fragmentation() is the share of the
+    // class's carved blocks that are free; blocks never carved from a slab
+    // do not count.
+    struct ClassStats {
+        size_t block_size;
+        size_t slabs;
+        size_t blocks;  // slabs * blocks per slab
+        size_t carved;  // Blocks ever handed out from those slabs
+        size_t used;
+
+        [[nodiscard]] double fragmentation() const {
+            return carved ? 1.0 - static_cast<double>(used) / carved : 0.0;
+        }
+    };
+
+    static constexpr uint32_t NONE = 0xFFFFFFFF;
+    static constexpr size_t CLASSES_OFFSET = align_up(sizeof(Header), CACHE_LINE_SIZE);
+    static constexpr size_t DESCS_OFFSET = CLASSES_OFFSET + sizeof(ClassState) * CLASSES;
+
+    // Create an allocator with room for `slabs` slabs of SLAB_SIZE bytes
+    SlabAllocator(Memory& memory, std::string_view name, size_t slabs)
+        : memory_(memory), name_(name),
+          pool_(memory, slab_pool_name(name), checked_slabs(slabs)) {
+
+        size_t offset = memory.allocate(name, DESCS_OFFSET + sizeof(SlabDesc) * slabs,
+                                        CACHE_LINE_SIZE);
+        header_ = memory.ptr_at<Header>(offset);
+        header_->slab_size = SLAB_SIZE;
+        header_->classes = CLASSES;
+        header_->slabs = static_cast<uint32_t>(slabs);
+        header_->reserved = 0;
+
+        bind();
+        for (size_t c = 0; c < CLASSES; ++c) {
+            new (&classes_[c]) ClassState{};
+            classes_[c].partial_head = NONE;
+        }
+        for (size_t s = 0; s < slabs; ++s) {
+            descs_[s] = SlabDesc{NONE, 0, NONE, 0, NONE, NONE};
+        }
+    }
+
+    // Open existing allocator
+    SlabAllocator(Memory& memory, std::string_view name)
+        : memory_(memory), name_(name), pool_(memory, slab_pool_name(name)) {
+
+        auto* entry = memory.table()->find(name);
+        if (!entry) {
+            throw std::runtime_error("SlabAllocator not found: " + std::string(name));
+        }
+
+        header_ = memory.ptr_at<Header>(entry->offset);
+
+        if (header_->slab_size != SLAB_SIZE || header_->classes != CLASSES) {
+            throw std::runtime_error("SlabAllocator geometry mismatch");
+        }
+        if (header_->slabs != pool_.capacity() ||
+            DESCS_OFFSET + sizeof(SlabDesc) * header_->slabs > entry->size) {
+            throw std::runtime_error("SlabAllocator header is corrupt");
+        }
+
+        bind();
+    }
+
+    // Allocate a block of at least size bytes (at most MAX_BLOCK). Returns
+    // NULL_HANDLE when no slab is left for its size class.
+    [[nodiscard]] Handle allocate(size_t size) {
+        size_t c = size_class(size);
+        ClassState& cs = classes_[c];
+        lock(cs);
+
+        uint32_t s = cs.partial_head;
+        if (s == NONE) {
+            s = acquire_slab(cs, c);
+            if (s == NONE) {
+                unlock(cs);
+                return NULL_HANDLE;
+            }
+        }
+
+        SlabDesc& desc = descs_[s];
+        uint32_t block = desc.free_head;
+        if (block != NONE) {
+            std::memcpy(&desc.free_head, block_ptr(s, c, block), sizeof(uint32_t));
+        } else {
+            block = desc.carved++;
+            cs.carved++;
+        }
+        desc.used++;
+        cs.used++;
+        if (desc.used == blocks_per_slab(c)) {
+            unlink(cs, s);  // Full
+        }
+
+        unlock(cs);
+        return slab_handle(s) + static_cast<Handle>(block) * class_size(c);
+    }
+
+    // Free a block; an emptied slab goes back to the shared pool
+    void deallocate(Handle handle) {
+        if (handle == NULL_HANDLE) return;
+
+        uint32_t s = slab_of(handle);
+        size_t c = descs_[s].size_class;  // Stable while the block is live
+        if (c >= CLASSES || (handle - slab_handle(s)) % class_size(c) != 0) {
+            throw std::invalid_argument("Invalid handle to deallocate");
+        }
+        uint32_t block = static_cast<uint32_t>((handle - slab_handle(s)) / class_size(c));
+
+        ClassState& cs = classes_[c];
+        lock(cs);
+
+        SlabDesc& desc = descs_[s];
+        std::memcpy(block_ptr(s, c, block), &desc.free_head, sizeof(uint32_t));
+        desc.free_head = block;
+        if (desc.used-- == blocks_per_slab(c)) {
+            link(cs, s);  // Was full, has room again
+        }
+        cs.used--;
+
+        bool empty = desc.used == 0;
+        if (empty) {
+            unlink(cs, s);
+            cs.carved -= desc.carved;
+            desc = SlabDesc{NONE, 0, NONE, 0, NONE, NONE};
+            cs.slabs--;
+        }
+        unlock(cs);
+
+        if (empty) {
+            pool_.deallocate(slab_at(s));
+        }
+    }
+
+    // Address of a block in this process
+    [[nodiscard]] void* get(Handle handle) const {
+        return static_cast<char*>(memory_.base()) + handle;
+    }
+
+    template<typename U>
+    [[nodiscard]] U* as(Handle handle) const {
+        return static_cast<U*>(get(handle));
+    }
+
+    // Usable size of an allocated block
+    [[nodiscard]] size_t block_size(Handle handle) const {
+        return class_size(descs_[slab_of(handle)].size_class);
+    }
+
+    [[nodiscard]] ClassStats stats(size_t c) const {
+        if (c >= CLASSES) {
+            throw std::out_of_range("Size class out of range");
+        }
+        ClassState& cs = classes_[c];
+        lock(cs);
+        ClassStats st{class_size(c), cs.slabs, size_t(cs.slabs) * blocks_per_slab(c),
+                      cs.carved, cs.used};
+        unlock(cs);
+        return st;
+    }
+
+    // Slabs not owned by any size class
+    [[nodiscard]] size_t free_slabs() const { return pool_.available(); }
+    [[nodiscard]] size_t slabs() const { return header_->slabs; }
+
+    static constexpr size_t class_size(size_t c) { return MIN_BLOCK << c; }
+
+    static size_t size_class(size_t size) {
+        if (size > MAX_BLOCK) {
+            throw std::invalid_argument("SlabAllocator block size exceeds 64 KB");
+        }
+        return size <= MIN_BLOCK ? 0 : std::bit_width(size - 1) - std::bit_width(MIN_BLOCK - 1);
+    }
+
+private:
+    using SlabPool = Pool<Slab>;
+    static constexpr int SPIN_LIMIT = 128;
+
+    Memory& memory_;
+    std::string name_;
+    SlabPool pool_;
+    Header* header_ = nullptr;
+    ClassState* classes_ = nullptr;
+    SlabDesc* descs_ = nullptr;
+    Handle slabs_base_ = 0;  // Handle of slab 0
+
+    static std::string slab_pool_name(std::string_view name) {
+        std::string pool_name = std::string(name) + ".slabs";
+        if (pool_name.size() >= 32) {
+            throw std::invalid_argument("SlabAllocator name too long (max 25 chars)");
+        }
+        return pool_name;
+    }
+
+    static size_t checked_slabs(size_t slabs) {
+        if (slabs == 0 || slabs >= NONE) {
+            throw std::invalid_argument("SlabAllocator slab count out of range");
+        }
+        return slabs;
+    }
+
+    static constexpr uint32_t blocks_per_slab(size_t c) {
+        return static_cast<uint32_t>(SLAB_SIZE / class_size(c));
+    }
+
+    void bind() {
+        char* base = reinterpret_cast<char*>(header_);
+        classes_ = reinterpret_cast<ClassState*>(base + CLASSES_OFFSET);
+        descs_ = reinterpret_cast<SlabDesc*>(base + DESCS_OFFSET);
+
+        size_t offset = 0, size = 0;
+        memory_.find(slab_pool_name(name_), offset, size);
+        slabs_base_ = offset + pool_.nodes_offset() + offsetof(SlabPool::Node, data);
+    }
+
+    Handle slab_handle(uint32_t s) const {
+        return slabs_base_ + static_cast<Handle>(s) * sizeof(SlabPool::Node);
+    }
+
+    Slab* slab_at(uint32_t s) const { return static_cast<Slab*>(get(slab_handle(s))); }
+
+    char* block_ptr(uint32_t s, size_t c, uint32_t block) const {
+        return slab_at(s)->bytes + size_t(block) * class_size(c);
+    }
+
+    uint32_t slab_of(Handle handle) const {
+        if (handle < slabs_base_) {
+            throw std::invalid_argument("Invalid handle");
+        }
+        Handle rel = handle - slabs_base_;
+        uint64_t s = rel / sizeof(SlabPool::Node);
+        if (s >= header_->slabs || rel % sizeof(SlabPool::Node) >= SLAB_SIZE) {
+            throw std::invalid_argument("Invalid handle");
+        }
+        return static_cast<uint32_t>(s);
+    }
+
+    // Take an empty slab from the pool for class c; caller holds its lock
+    uint32_t acquire_slab(ClassState& cs, size_t c) {
+        auto slab = pool_.allocate();
+        if (!slab) {
+            return NONE;
+        }
+        uint32_t s = slab_of(static_cast<Handle>(
+            reinterpret_cast<char*>(*slab) - static_cast<char*>(memory_.base())));
+        descs_[s] = SlabDesc{static_cast<uint32_t>(c), 0, NONE, 0, NONE, NONE};
+        cs.slabs++;
+        link(cs, s);
+        return s;
+    }
+
+    // Partial list; caller holds the class lock
+    void link(ClassState& cs, uint32_t s) {
+        descs_[s].prev = NONE;
+        descs_[s].next = cs.partial_head;
+        if (cs.partial_head != NONE) {
+            descs_[cs.partial_head].prev = s;
+        }
+        cs.partial_head = s;
+    }
+
+    void unlink(ClassState& cs, uint32_t s) {
+        SlabDesc& desc = descs_[s];
+        if (desc.prev != NONE) {
+            descs_[desc.prev].next = desc.next;
+        } else {
+            cs.partial_head = desc.next;
+        }
+        if (desc.next != NONE) {
+            descs_[desc.next].prev = desc.prev;
+        }
+        desc.prev = desc.next = NONE;
+    }
+
+    static bool try_lock(ClassState& cs) {
+        uint32_t expected = 0;
+        return cs.lock.load(std::memory_order_relaxed) == 0 &&
+               cs.lock.compare_exchange_strong(expected, 1,
+                                               std::memory_order_acquire,
+                                               std::memory_order_relaxed);
+    }
+
+    static void lock(ClassState& cs) {
+        for (int i = 0; i < SPIN_LIMIT; i++) {
+            if (try_lock(cs)) {
+                return;
+            }
+        }
+        detail::spin_wait([&cs] { return try_lock(cs); });
+    }
+
+    static void unlock(ClassState& cs) {
+        cs.lock.store(0, std::memory_order_release);
+    }
+};
+
+} // namespace zeroipc
@@ -1,27 +1,62 @@
 #pragma once
 
 #include "memory.h"
+#include "detail/spin_wait.h"
+#include <algorithm>
 #include <atomic>
 #include <optional>
 #include <thread>
 
 namespace zeroipc {
 
+// Header layout of a Stack, chosen at creation and recorded in the high byte
+// of the header's elem_size field (older readers see a size mismatch and
+// refuse the stack rather than misread it).
+//   Compact:   top lives in the 16-byte header
+//   PaddedTop: top lives on a cache line of its own, so pushers and poppers
+//              spinning on it do not invalidate the line holding capacity
+//              and elem_size for every other operation. C++ creators use
+//              it unless told otherwise.
+enum class StackLayout : uint32_t {
+    Compact = 0,
+    PaddedTop = 0x04000000,
+};
+
+inline constexpr uint32_t STACK_ELEM_SIZE_MASK = 0x00FFFFFF;
+inline constexpr uint32_t STACK_LAYOUT_PADDED_TOP = 0x04000000;
+
+// With PaddedTop, top lives at this offset instead of in the 16-byte header
+// (where it stays -1), and data starts after it.
+inline constexpr size_t STACK_PADDED_TOP_OFFSET = CACHE_LINE_SIZE;
+inline constexpr size_t STACK_PADDED_HEADER_SIZE = 2 * CACHE_LINE_SIZE;
+
 template<typename T>
 class Stack {
 public:
     static_assert(std::is_trivially_copyable_v<T>,
                   "T must be trivially copyable for shared memory");
     static_assert(alignof(T) <= MAX_ELEM_ALIGN,
-                  "T alignment exceeds the 8-byte guarantee of shared memory layout");
+                  "T alignment exceeds the largest supported allocation alignment");
+    static_assert(sizeof(T) <= STACK_ELEM_SIZE_MASK,
+                  "Stack elements are limited to 16 MB");
 
     struct Header {
         std::atomic<int32_t> top;  // -1 when empty
         uint32_t capacity;
-        uint32_t elem_size;
+        uint32_t elem_size;  // Bits 0-23: sizeof(T), bits 24-31: StackLayout
         uint32_t reserved;  // pads header to 16 bytes so the data array is 8-aligned
     };
 
+    // Every section starts on the section alignment, recorded in the table
+    // entry (8 for ordinary types: the v2 layout).
+    static constexpr size_t ALIGN = section_align<T>();
+    static constexpr size_t DATA_OFFSET = align_up(sizeof(Header), ALIGN);  // Compact
+
+    static constexpr size_t data_offset(uint32_t layout) {
+        return (layout & STACK_LAYOUT_PADDED_TOP)
+            ? align_up(STACK_PADDED_HEADER_SIZE, ALIGN) : DATA_OFFSET;
+    }
+
     // Per-slot states for the 4-state CAS protocol:
     //   EMPTY(0)  -> WRITING(1) -> READY(2) -> READING(3) -> EMPTY(0)
     // Push: CAS(EMPTY -> WRITING), write data, store(READY)
@@ -39,28 +74,68 @@ public:
     // operation undoes its top reservation when possible and returns failure.
     static constexpr int MAX_SPINS = 10000;
 
-    // Create new stack
-    Stack(Memory& memory, std::string_view name, size_t capacity)
+    // Elimination array (C++ creators only): ELIM_SLOTS exchange slots, each
+    // on its own cache line, at align_up(end of state array, ELIM_ALIGN) and
+    // present exactly when the entry's size covers them. A push whose CAS on
+    // top fails offers its value in a random slot for a moment; a pop whose
+    // CAS fails takes any offered value. The pair completes without touching
+    // top, so symmetric push/pop load stops serializing on one word.
+    // The offer waits ELIM_SPIN_MIN..ELIM_SPIN_MAX pause instructions, a few
+    // hundred ns: each thread doubles its wait when an offer is taken and
+    // halves it when one times out, and once at the minimum it skips the
+    // next ELIM_SKIP offers, so push-only contention just retries on top.
+    //   FREE(0) -> FILLING(1) -> OFFERED(2) -> TAKING(3) -> TAKEN(4) -> FREE(0)
+    // Push: CAS(FREE -> FILLING), write, store(OFFERED), wait for TAKEN and
+    //       store(FREE), or withdraw with CAS(OFFERED -> FREE)
+    // Pop:  CAS(OFFERED -> TAKING), read, store(TAKEN)
+    static constexpr size_t ELIM_SLOTS = 8;
+    static constexpr size_t ELIM_ALIGN = std::max(CACHE_LINE_SIZE, ALIGN);
+    static constexpr int ELIM_SPIN_MIN = 4;
+    static constexpr int ELIM_SPIN_MAX = 64;
+    static constexpr int ELIM_SKIP = 16;
+
+    static constexpr uint32_t ELIM_FREE    = 0;
+    static constexpr uint32_t ELIM_FILLING = 1;
+    static constexpr uint32_t ELIM_OFFERED = 2;
+    static constexpr uint32_t ELIM_TAKING  = 3;
+    static constexpr uint32_t ELIM_TAKEN   = 4;
+
+    struct ElimSlot {
+        std::atomic<uint32_t> state;
+        T value;
+    };
+    static constexpr size_t ELIM_STRIDE = align_up(sizeof(ElimSlot), ELIM_ALIGN);
+
+    // Create new stack. Without elimination the entry has no exchange slots,
+    // and every process opening it pushes and pops on top alone.
+    Stack(Memory& memory, std::string_view name, size_t capacity,
+          StackLayout layout = StackLayout::PaddedTop, bool elimination = true)
         : memory_(memory), name_(name) {
 
-        // Layout: [Header(16)][data: T*capacity][pad][state: atomic<uint32_t>*capacity]
-        // The state array is 8-aligned so its atomics are always naturally aligned.
-        size_t state_off = align_up(sizeof(T) * capacity, 8);
-        size_t total_size = sizeof(Header)
-                          + state_off
-                          + sizeof(std::atomic<uint32_t>) * capacity;
-        size_t offset = memory.allocate(name, total_size);
+        // Layout: [Header(16) | top line if PaddedTop][pad][data: T*capacity][pad]
+        //         [state: atomic<uint32_t>*capacity]
+        // The state array is section-aligned so its atomics are always naturally aligned.
+        const uint32_t flags = static_cast<uint32_t>(layout);
+        const size_t data_off = data_offset(flags);
+        size_t state_off = align_up(sizeof(T) * capacity, ALIGN);
+        size_t elim_off = elimination_offset(capacity, flags);
+        size_t total_size = elimination
+            ? elim_off + ELIM_SLOTS * ELIM_STRIDE
+            : data_off + state_off + sizeof(std::atomic<uint32_t>) * capacity;
+        size_t offset = memory.allocate(name, total_size, ALIGN);
 
         header_ = memory.ptr_at<Header>(offset);
 
         // Initialize header
         header_->top.store(-1, std::memory_order_relaxed);
         header_->capacity = capacity;
-        header_->elem_size = sizeof(T);
+        header_->elem_size = sizeof(T) | flags;
         header_->reserved = 0;
+        bind_top(flags);
+        top_->store(-1, std::memory_order_relaxed);
 
         data_ = reinterpret_cast<T*>(
-            reinterpret_cast<char*>(header_) + sizeof(Header));
+            reinterpret_cast<char*>(header_) + data_off);
 
         state_ = reinterpret_cast<std::atomic<uint32_t>*>(
             reinterpret_cast<char*>(data_) + state_off);
@@ -69,6 +144,13 @@ public:
         for (size_t i = 0; i < capacity; ++i) {
             state_[i].store(SLOT_EMPTY, std::memory_order_relaxed);
         }
+
+        if (elimination) {
+            elim_ = reinterpret_cast<char*>(header_) + elim_off;
+            for (size_t i = 0; i < ELIM_SLOTS; ++i) {
+                elim_slot(i)->state.store(ELIM_FREE, std::memory_order_relaxed);
+            }
+        }
         std::atomic_thread_fence(std::memory_order_release);
     }
 
@@ -76,31 +158,46 @@ public:
     Stack(Memory& memory, std::string_view name)
         : memory_(memory), name_(name) {
 
-        size_t offset, size;
-        if (!memory.find(name, offset, size)) {
+        auto* entry = memory.table()->find(name);
+        if (!entry) {
             throw std::runtime_error("Stack not found: " + std::string(name));
         }
 
-        header_ = memory.ptr_at<Header>(offset);
+        header_ = memory.ptr_at<Header>(entry->offset);
 
-        if (header_->elem_size != sizeof(T)) {
+        const uint32_t flags = header_->elem_size & ~STACK_ELEM_SIZE_MASK;
+        if ((header_->elem_size & STACK_ELEM_SIZE_MASK) != sizeof(T)) {
             throw std::runtime_error("Type size mismatch");
         }
+        if (flags & ~STACK_LAYOUT_PADDED_TOP) {
+            throw std::runtime_error("Unknown stack layout");
+        }
+        if (entry->section_align() != ALIGN) {
+            throw std::runtime_error("Alignment mismatch");
+        }
+        bind_top(flags);
 
         data_ = reinterpret_cast<T*>(
-            reinterpret_cast<char*>(header_) + sizeof(Header));
+            reinterpret_cast<char*>(header_) + data_offset(flags));
 
         state_ = reinterpret_cast<std::atomic<uint32_t>*>(
-            reinterpret_cast<char*>(data_) + align_up(sizeof(T) * header_->capacity, 8));
+            reinterpret_cast<char*>(data_) + align_up(sizeof(T) * header_->capacity, ALIGN));
+
+        // Stacks created by other languages have no elimination array
+        size_t elim_off = elimination_offset(header_->capacity, flags);
+        if (entry->size >= elim_off + ELIM_SLOTS * ELIM_STRIDE) {
+            elim_ = reinterpret_cast<char*>(header_) + elim_off;
+        }
     }
 
     // Push (lock-free with per-slot CAS)
     bool push(const T& value) {
         int32_t current_top, new_top;
 
-        // Step 1: Reserve a slot atomically by CAS-advancing top
-        do {
-            current_top = header_->top.load(std::memory_order_relaxed);
+        // Step 1: Reserve a slot atomically by CAS-advancing top. A lost
+        // CAS means contention: try to hand the value to a pop directly.
+        for (;;) {
+            current_top = top_->load(std::memory_order_relaxed);
 
             // Check if full
             if (current_top >= static_cast<int32_t>(header_->capacity - 1)) {
@@ -108,10 +205,16 @@ public:
             }
 
             new_top = current_top + 1;
-        } while (!header_->top.compare_exchange_weak(
+            if (top_->compare_exchange_weak(
                     current_top, new_top,
                     std::memory_order_acq_rel,
-                    std::memory_order_relaxed));
+                    std::memory_order_relaxed)) {
+                break;
+            }
+            if (elim_ && eliminate_push(value)) {
+                return true;
+            }
+        }
 
         // Step 2: Exclusively claim the slot for writing: CAS(EMPTY -> WRITING).
         // Bounded spin (see MAX_SPINS): a crashed peer can leave the slot
@@ -135,7 +238,7 @@ public:
             // over the stuck slot; operations landing on that slot also
             // fail bounded rather than hang.
             int32_t reserved = new_top;
-            header_->top.compare_exchange_strong(
+            top_->compare_exchange_strong(
                 reserved, current_top,
                 std::memory_order_acq_rel, std::memory_order_relaxed);
             return false;
@@ -154,9 +257,10 @@ public:
     std::optional<T> pop() {
         int32_t current_top, new_top;
 
-        // Step 1: Reserve a slot to read by CAS-decrementing top
-        do {
-            current_top = header_->top.load(std::memory_order_relaxed);
+        // Step 1: Reserve a slot to read by CAS-decrementing top. A lost
+        // CAS means contention: try to take a concurrent push's value.
+        for (;;) {
+            current_top = top_->load(std::memory_order_relaxed);
 
             // Check if empty
             if (current_top < 0) {
@@ -164,10 +268,18 @@ public:
             }
 
             new_top = current_top - 1;
-        } while (!header_->top.compare_exchange_weak(
+            if (top_->compare_exchange_weak(
                     current_top, new_top,
                     std::memory_order_acq_rel,
-                    std::memory_order_relaxed));
+                    std::memory_order_relaxed)) {
+                break;
+            }
+            if (elim_) {
+                if (auto value = eliminate_pop()) {
+                    return value;
+                }
+            }
+        }
 
         // Step 2: Exclusively claim the slot for reading: CAS(READY -> READING).
         // Bounded spin (see MAX_SPINS): normally this only waits for the
@@ -191,7 +303,7 @@ public:
             // silently dropped. If another operation moved top meanwhile,
             // the CAS fails and the stuck slot stays orphaned.
             int32_t reserved = new_top;
-            header_->top.compare_exchange_strong(
+            top_->compare_exchange_strong(
                 reserved, current_top,
                 std::memory_order_acq_rel, std::memory_order_relaxed);
             return std::nullopt;
@@ -206,6 +318,79 @@ public:
         return value;
     }
 
+    // Push up to n values with one CAS on top (values[0] lands lowest, so
+    // values[n-1] pops first). Returns the number pushed: less than n only
+    // when the stack fills up.
+    size_t push_n(const T* values, size_t n) {
+        int32_t current_top, new_top;
+        do {
+            current_top = top_->load(std::memory_order_relaxed);
+            int32_t room = static_cast<int32_t>(header_->capacity) - 1 - current_top;
+            if (room <= 0 || n == 0) {
+                return 0;
+            }
+            new_top = current_top + static_cast<int32_t>(std::min<size_t>(n, room));
+        } while (!top_->compare_exchange_weak(
+                    current_top, new_top,
+                    std::memory_order_acq_rel,
+                    std::memory_order_relaxed));
+
+        // Fill the reserved range bottom-up through the per-slot protocol
+        size_t pushed = 0;
+        for (int32_t slot = current_top + 1; slot <= new_top; ++slot) {
+            if (!claim(slot, SLOT_EMPTY, SLOT_WRITING)) {
+                // Stuck slot (crashed peer). If nothing built on our range,
+                // give back the unused part and report a short push;
+                // otherwise skip the slot, as a single push would leave it.
+                int32_t reserved = new_top;
+                if (top_->compare_exchange_strong(
+                        reserved, slot - 1,
+                        std::memory_order_acq_rel, std::memory_order_relaxed)) {
+                    return pushed;
+                }
+                continue;
+            }
+            data_[slot] = values[pushed++];
+            state_[slot].store(SLOT_READY, std::memory_order_release);
+        }
+        return pushed;
+    }
+
+    // Pop up to n values with one CAS on top, most recent first. Returns
+    // the number popped (0 when empty).
+    size_t pop_n(T* out, size_t n) {
+        int32_t current_top, new_top;
+        do {
+            current_top = top_->load(std::memory_order_relaxed);
+            if (current_top < 0 || n == 0) {
+                return 0;
+            }
+            new_top = current_top - static_cast<int32_t>(
+                std::min<size_t>(n, static_cast<size_t>(current_top) + 1));
+        } while (!top_->compare_exchange_weak(
+                    current_top, new_top,
+                    std::memory_order_acq_rel,
+                    std::memory_order_relaxed));
+
+        size_t popped = 0;
+        for (int32_t slot = current_top; slot > new_top; --slot) {
+            if (!claim(slot, SLOT_READY, SLOT_READING)) {
+                // Stuck slot: put it and everything below it back if top
+                // has not moved, otherwise skip it (see pop)
+                int32_t reserved = new_top;
+                if (top_->compare_exchange_strong(
+                        reserved, slot,
+                        std::memory_order_acq_rel, std::memory_order_relaxed)) {
+                    return popped;
+                }
+                continue;
+            }
+            out[popped++] = data_[slot];
+            state_[slot].store(SLOT_EMPTY, std::memory_order_release);
+        }
+        return popped;
+    }
+
     // Peek at top without removing.
     //
     // A peek cannot passively read the slot: between observing READY and
@@ -218,7 +403,7 @@ public:
     // (slot stuck WRITING/READING) cannot hang the peek indefinitely.
     std::optional<T> top() const {
         for (int spins = 0; spins < MAX_SPINS; ++spins) {
-            int32_t current_top = header_->top.load(std::memory_order_acquire);
+            int32_t current_top = top_->load(std::memory_order_acquire);
             if (current_top < 0) {
                 return std::nullopt;
             }
@@ -242,18 +427,18 @@ public:
 
     // Check if empty
     bool empty() const {
-        return header_->top.load(std::memory_order_acquire) < 0;
+        return top_->load(std::memory_order_acquire) < 0;
     }
 
     // Check if full
     bool full() const {
-        return header_->top.load(std::memory_order_acquire) >=
+        return top_->load(std::memory_order_acquire) >=
                static_cast<int32_t>(header_->capacity - 1);
     }
 
     // Get current size
     size_t size() const {
-        int32_t top = header_->top.load(std::memory_order_acquire);
+        int32_t top = top_->load(std::memory_order_acquire);
         return top < 0 ? 0 : static_cast<size_t>(top + 1);
     }
 
@@ -263,8 +448,128 @@ private:
     Memory& memory_;
     std::string name_;
     Header* header_;
+    std::atomic<int32_t>* top_;  // In the header, or on its own line
     T* data_;
     std::atomic<uint32_t>* state_;
+    char* elim_ = nullptr;
+
+    // Move a slot between states, bounded by MAX_SPINS (see there)
+    bool claim(int32_t slot, uint32_t from, uint32_t to) {
+        for (int spins = 0; spins < MAX_SPINS; ++spins) {
+            uint32_t expected = from;
+            if (state_[slot].compare_exchange_weak(
+                    expected, to,
+                    std::memory_order_acq_rel,
+                    std::memory_order_relaxed)) {
+                return true;
+            }
+            std::this_thread::yield();
+        }
+        return false;
+    }
+
+    void bind_top(uint32_t flags) {
+        top_ = (flags & STACK_LAYOUT_PADDED_TOP)
+            ? reinterpret_cast<std::atomic<int32_t>*>(
+                  reinterpret_cast<char*>(header_) + STACK_PADDED_TOP_OFFSET)
+            : &header_->top;
+    }
+
+    static size_t elimination_offset(size_t capacity, uint32_t flags) {
+        return align_up(data_offset(flags) + align_up(sizeof(T) * capacity, ALIGN)
+                        + sizeof(std::atomic<uint32_t>) * capacity, ELIM_ALIGN);
+    }
+
+    ElimSlot* elim_slot(size_t i) const {
+        return reinterpret_cast<ElimSlot*>(elim_ + i * ELIM_STRIDE);
+    }
+
+    // Threads start at different slots so offers and takes spread out
+    static size_t elim_start() {
+        static std::atomic<uint32_t> next_thread{0};
+        thread_local uint32_t cursor = next_thread.fetch_add(1, std::memory_order_relaxed);
+        return cursor++ % ELIM_SLOTS;
+    }
+
+    // Per-thread offer wait, adapted to how often offers get taken
+    struct ElimBackoff {
+        int spins = ELIM_SPIN_MIN;
+        int skip = 0;
+    };
+
+    static ElimBackoff& elim_backoff() {
+        thread_local ElimBackoff backoff;
+        return backoff;
+    }
+
+    // Offer value to a concurrent pop. True if a pop took it.
+    bool eliminate_push(const T& value) {
+        ElimBackoff& backoff = elim_backoff();
+        if (backoff.skip > 0) {
+            --backoff.skip;  // Recent offers went untaken
+            return false;
+        }
+
+        ElimSlot* slot = elim_slot(elim_start());
+        uint32_t expected = ELIM_FREE;
+        if (!slot->state.compare_exchange_strong(
+                expected, ELIM_FILLING,
+                std::memory_order_acquire, std::memory_order_relaxed)) {
+            return false;
+        }
+        slot->value = value;
+        slot->state.store(ELIM_OFFERED, std::memory_order_release);
+
+        for (int i = 0; i < backoff.spins; ++i) {
+            if (slot->state.load(std::memory_order_acquire) == ELIM_TAKEN) {
+                slot->state.store(ELIM_FREE, std::memory_order_release);
+                backoff.spins = std::min(backoff.spins * 2, ELIM_SPIN_MAX);
+                return true;
+            }
+            detail::cpu_relax();
+        }
+
+        // Withdraw the offer unless a pop is already taking it
+        expected = ELIM_OFFERED;
+        if (slot->state.compare_exchange_strong(
+                expected, ELIM_FREE,
+                std::memory_order_acq_rel, std::memory_order_acquire)) {
+            if (backoff.spins > ELIM_SPIN_MIN) {
+                backoff.spins /= 2;
+            } else {
+                backoff.skip = ELIM_SKIP;
+            }
+            return false;
+        }
+        // Bounded like the slot spins above: a pop that crashed mid-take
+        // retires the slot, and the value counts as delivered.
+        for (int spins = 0; spins < MAX_SPINS; ++spins) {
+            if (slot->state.load(std::memory_order_acquire) == ELIM_TAKEN) {
+                slot->state.store(ELIM_FREE, std::memory_order_release);
+                break;
+            }
+            std::this_thread::yield();
+        }
+        return true;
+    }
+
+    // Take any value a concurrent push is offering
+    std::optional<T> eliminate_pop() {
+        size_t start = elim_start();
+        for (size_t i = 0; i < ELIM_SLOTS; ++i) {
+            ElimSlot* slot = elim_slot((start + i) % ELIM_SLOTS);
+            uint32_t expected = ELIM_OFFERED;
+            if (slot->state.load(std::memory_order_relaxed) == ELIM_OFFERED &&
+                slot->state.compare_exchange_strong(
+                    expected, ELIM_TAKING,
+                    std::memory_order_acquire, std::memory_order_relaxed)) {
+                T value = slot->value;
+                slot->state.store(ELIM_TAKEN, std::memory_order_release);
+                return value;
+            }
+        }
+        return std::nullopt;
+    }
 };
 
 } // namespace zeroipc
@@ -2,6 +2,7 @@
 
 #include "memory.h"
 #include "ring.h"
+#include "doorbell.h"
 #include <atomic>
 #include <functional>
 #include <vector>
@@ -91,6 +92,7 @@ public:
         std::atomic<bool> closed;            // Stream is closed
         uint32_t buffer_capacity;            // Ring buffer capacity
         char transform_name[32];             // Name of transformation if any
+        std::atomic<uint32_t> bell;          // 0 = doorbell armed, 1 = rung
     };
     
     // Create new stream
@@ -109,6 +111,7 @@ public:
         header_->closed.store(false, std::memory_order_relaxed);
         header_->buffer_capacity = buffer_size;
         std::memset(header_->transform_name, 0, sizeof(header_->transform_name));
+        header_->bell.store(0, std::memory_order_relaxed);
         
         // Create ring buffer for data
         std::string buffer_name = std::string(name) + "_buffer";
@@ -144,6 +147,7 @@ public:
         }
         
         uint64_t seq = header_->sequence.fetch_add(1, std::memory_order_acq_rel);
+        ring_doorbell();
         
         // Notify subscribers (in real impl, would wake waiters)
         notify_subscribers(seq, value);
@@ -161,6 +165,7 @@ public:
         if (written > 0) {
             uint64_t seq = header_->sequence.fetch_add(written, 
                                                       std::memory_order_acq_rel);
+            ring_doorbell();
             // Notify for bulk emit
             for (size_t i = 0; i < written; ++i) {
                 notify_subscribers(seq + i, values[i]);
@@ -170,6 +175,16 @@ public:
         return written;
     }
     
+    // Ring bell (a process-local fd) when an emit finds the shared bell
+    // word armed; see Queue::attach_doorbell. Pass nullptr to detach.
+    void attach_doorbell(Doorbell* bell) { doorbell_ = bell; }
+
+    // Consumer side: re-arm after the doorbell fired, before reading
+    void rearm_doorbell() {
+        header_->bell.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
     // Read next value from stream
     [[nodiscard]] std::optional<T> next() {
         return buffer_->read();
@@ -343,6 +358,20 @@ private:
     std::string name_;
     Header* header_ = nullptr;
     std::unique_ptr<Ring<T>> buffer_;
+    Doorbell* doorbell_ = nullptr;
+
+    // The fence pairs with rearm_doorbell(): either the reader sees the
+    // emitted data or we see the armed bell.
+    void ring_doorbell() {
+        if (!doorbell_) {
+            return;
+        }
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (header_->bell.load(std::memory_order_relaxed) == 0 &&
+            header_->bell.exchange(1, std::memory_order_acq_rel) == 0) {
+            doorbell_->ring();
+        }
+    }
     
     void notify_subscribers(uint64_t seq, const T& value) {
         // In real implementation, would wake waiting subscribers
@@ -1,52 +1,116 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <cstring>
+#include <optional>
+#include <string>
 #include <string_view>
 #include <stdexcept>
+#include <thread>
 
 namespace zeroipc {
 
 constexpr uint32_t TABLE_MAGIC = 0x5A49504D; // 'ZIPM'
-constexpr uint32_t TABLE_VERSION = 2;  // v2: 8-byte section alignment (see SPECIFICATION.md)
+constexpr uint32_t TABLE_VERSION = 3;  // v3: per-entry publish state (see SPECIFICATION.md)
 
 /**
  * Round n up to the next multiple of a (a must be a power of two).
  *
- * All structures place their sections (header, data array, atomic side-array)
- * on 8-byte boundaries so that element and atomic accesses are naturally
- * aligned regardless of element size. Every language computes offsets with the
- * same rule, so the layout stays binary-compatible across implementations.
+ * Every structure places its sections (header, data array, atomic side-array)
+ * on boundaries of its section alignment, so that element and atomic accesses
+ * are naturally aligned regardless of element size. Every language computes
+ * offsets with the same rule, so the layout stays binary-compatible across
+ * implementations.
  */
 constexpr size_t align_up(size_t n, size_t a) { return (n + a - 1) & ~(a - 1); }
 
-// The library guarantees 8-byte section alignment only; element types with a
-// stronger requirement cannot be placed correctly (the allocator 8-aligns each
-// structure base and stores no per-type alignment in the minimal metadata).
-constexpr size_t MAX_ELEM_ALIGN = 8;
+// Minimum section alignment; also what a table entry with alignment 0
+// (written before the field existed) means.
+constexpr size_t MIN_SECTION_ALIGN = 8;
+
+// Largest alignment a single allocation may request (one page). The segment
+// itself is mmap'ed, so offsets aligned to this are aligned in memory.
+constexpr size_t MAX_ALLOC_ALIGN = 4096;
+
+// Element types may be over-aligned up to MAX_ALLOC_ALIGN: their structure
+// records the alignment in its table entry and lays out every section on it.
+constexpr size_t MAX_ELEM_ALIGN = MAX_ALLOC_ALIGN;
+
+// Structure bases are placed on their own cache line by Memory::allocate so
+// the hot header atomics of neighbouring structures never false-share.
+constexpr size_t CACHE_LINE_SIZE = 64;
+
+/**
+ * Section alignment used by a structure holding elements of type T:
+ * max(8, alignof(T)). For ordinary types this is 8, the v2 layout.
+ */
+template<typename T>
+constexpr size_t section_align() {
+    return alignof(T) > MIN_SECTION_ALIGN ? alignof(T) : MIN_SECTION_ALIGN;
+}
 
 /**
  * Runtime-configurable table for managing named structures in shared memory.
  * 
  * The table is stored at the beginning of shared memory and tracks
  * all allocated structures by name, offset, and size.
+ *
+ * Registration is lock-free, so any number of processes may create
+ * structures concurrently:
+ *   - allocate() bumps next_offset with a CAS loop.
+ *   - add() reserves a slot by CAS-incrementing entry_count, writes the
+ *     name, marks it CLAIMED, resolves same-name races, fills in the
+ *     offset and size, then marks it PUBLISHED. Readers only ever see
+ *     PUBLISHED entries.
+ *   - allocate_entry() does the same but bump-allocates between claiming
+ *     and publishing, so losing registrars never consume space.
+ * When two processes register the same name concurrently, the lower slot
+ * wins; the loser marks its slot DEAD and reports "Name already exists".
  */
 class Table {
 public:
     struct Header {
         uint32_t magic;
         uint32_t version;
-        uint32_t entry_count;
+        std::atomic<uint32_t> entry_count;  // Reserved slots (published or not)
         uint32_t max_entries;   // Maximum number of table entries
         uint64_t memory_size;   // Total size of the shared memory segment (supports >4GB)
-        uint64_t next_offset;   // Next allocation offset (supports >4GB)
+        std::atomic<uint64_t> next_offset;  // Next allocation offset (supports >4GB)
     };
     
     struct Entry {
         char name[32];
         uint64_t offset;        // Supports offsets >4GB
         uint64_t size;          // Supports sizes >4GB
+        std::atomic<uint32_t> state;  // ENTRY_* publish state
+        uint32_t alignment;     // Section alignment in bytes (0 = MIN_SECTION_ALIGN)
+        
+        size_t section_align() const {
+            return alignment ? alignment : MIN_SECTION_ALIGN;
+        }
     };
+
+    static_assert(sizeof(Header) == 32, "Table header must be 32 bytes");
+    static_assert(sizeof(Entry) == 56, "Table entry must be 56 bytes");
+
+    // Entry states. A slot below entry_count whose state is still PENDING is
+    // being filled in by its registrar.
+    //   PENDING(0) -> CLAIMED(1) -> PUBLISHED(2)
+    //          |                 \-> DEAD(3)   (lost a same-name race)
+    //          \-> DEAD(3)   (given up on by a registrar above it)
+    static constexpr uint32_t ENTRY_PENDING   = 0;
+    static constexpr uint32_t ENTRY_CLAIMED   = 1;
+    static constexpr uint32_t ENTRY_PUBLISHED = 2;
+    static constexpr uint32_t ENTRY_DEAD      = 3;
+
+    // Bound on waiting for a lower slot to leave PENDING. A registrar that
+    // crashed between reserving and claiming its slot leaves it PENDING
+    // forever; after this many spins the slot is marked DEAD, so a
+    // registrar that was only stalled fails its claim and starts over in a
+    // fresh slot instead of publishing the name a second time.
+    static constexpr int MAX_SPINS = 10000;
     
     /**
      * Initialize a table in existing memory
@@ -68,15 +132,16 @@ public:
     }
     
     /**
-     * Find an entry by name
+     * Find a published entry by name
      * @return Pointer to entry or nullptr if not found
      */
     const Entry* find(std::string_view name) const {
-        auto* header = get_header();
         auto* entries = get_entries();
+        uint32_t count = slot_count();
         
-        for (uint32_t i = 0; i < header->entry_count; ++i) {
-            if (name == entries[i].name) {
+        for (uint32_t i = 0; i < count; ++i) {
+            if (entries[i].state.load(std::memory_order_acquire) == ENTRY_PUBLISHED &&
+                name == entries[i].name) {
                 return &entries[i];
             }
         }
@@ -84,58 +149,90 @@ public:
     }
     
     /**
-     * Add a new entry to the table
+     * Add a new entry to the table (lock-free, safe across processes)
+     * @param alignment Section alignment of the structure, recorded so that
+     *                  readers in every language compute the same layout
      * @return true if successful, false if table is full
      */
-    [[nodiscard]] bool add(std::string_view name, uint64_t offset, uint64_t size) {
-        if (name.size() >= 32) {
-            throw std::invalid_argument("Name too long (max 31 characters)");
-        }
+    [[nodiscard]] bool add(std::string_view name, uint64_t offset, uint64_t size,
+                           size_t alignment = MIN_SECTION_ALIGN) {
+        check_entry(name, alignment);
         
-        auto* header = get_header();
-        if (header->entry_count >= max_entries_) {
+        Entry* entry = claim(name);
+        if (!entry) {
             return false;
         }
         
-        if (find(name) != nullptr) {
-            throw std::invalid_argument("Name already exists");
-        }
+        entry->offset = offset;
+        entry->size = size;
+        entry->alignment = static_cast<uint32_t>(alignment);
+        entry->state.store(ENTRY_PUBLISHED, std::memory_order_release);
+        return true;
+    }
+    
+    /**
+     * Claim `name`, then bump-allocate its space and publish the entry.
+     *
+     * Space is only taken once the name is ours, so a registrar that loses
+     * a same-name race (or finds the table full) leaves next_offset alone.
+     * The base is aligned to max(alignment, CACHE_LINE_SIZE).
+     * @param alignment Section alignment, recorded in the entry
+     * @return Offset of the new structure, or nullopt if the table is full
+     */
+    [[nodiscard]] std::optional<uint64_t> allocate_entry(std::string_view name, size_t size,
+                                                         size_t alignment = MIN_SECTION_ALIGN) {
+        check_entry(name, alignment);
         
-        auto* entries = get_entries();
-        auto& entry = entries[header->entry_count++];
+        Entry* entry = claim(name);
+        if (!entry) {
+            return std::nullopt;
+        }
         
-        std::memset(entry.name, 0, sizeof(entry.name));
-        std::memcpy(entry.name, name.data(), name.size());
-        entry.offset = offset;
-        entry.size = size;
+        uint64_t offset;
+        try {
+            offset = allocate(size, std::max(alignment, CACHE_LINE_SIZE));
+        } catch (...) {
+            entry->state.store(ENTRY_DEAD, std::memory_order_release);
+            throw;
+        }
         
-        return true;
+        entry->offset = offset;
+        entry->size = size;
+        entry->alignment = static_cast<uint32_t>(alignment);
+        entry->state.store(ENTRY_PUBLISHED, std::memory_order_release);
+        return offset;
     }
     
     /**
-     * Allocate space for a new structure
+     * Allocate space for a new structure (lock-free bump allocation)
      * @param size Size in bytes to allocate
-     * @param alignment Alignment requirement (default 8)
+     * @param alignment Alignment requirement (power of two, at most MAX_ALLOC_ALIGN)
      * @return Offset of allocated space
      */
-    uint64_t allocate(size_t size, size_t alignment = 8) {
+    uint64_t allocate(size_t size, size_t alignment = MIN_SECTION_ALIGN) {
+        check_alignment(alignment);
         auto* header = get_header();
+        uint64_t current = header->next_offset.load(std::memory_order_relaxed);
+        uint64_t aligned;
         
-        // Align the offset
-        uint64_t aligned = (header->next_offset + alignment - 1) & ~(alignment - 1);
-        uint64_t result = aligned;
-        
-        // Check if allocation would exceed memory bounds
-        if (aligned + size < aligned) {  // Check for overflow
-            throw std::runtime_error("Allocation size overflow");
-        }
-        
-        if (aligned + size > memory_size_) {  // Check against total memory size
-            throw std::runtime_error("Allocation would exceed memory bounds");
-        }
+        do {
+            // Align the offset
+            aligned = (current + alignment - 1) & ~(alignment - 1);
+            
+            // Check if allocation would exceed memory bounds
+            if (aligned + size < aligned) {  // Check for overflow
+                throw std::runtime_error("Allocation size overflow");
+            }
+            
+            if (aligned + size > memory_size_) {  // Check against total memory size
+                throw std::runtime_error("Allocation would exceed memory bounds");
+            }
+        } while (!header->next_offset.compare_exchange_weak(
+                    current, aligned + size,
+                    std::memory_order_acq_rel,
+                    std::memory_order_relaxed));
         
-        header->next_offset = aligned + size;
-        return result;
+        return aligned;
     }
     
     /**
@@ -146,10 +243,19 @@ public:
     }
     
     /**
-     * Get the number of entries currently in the table
+     * Get the number of published entries currently in the table
      */
     size_t entry_count() const {
-        return get_header()->entry_count;
+        auto* entries = get_entries();
+        uint32_t count = slot_count();
+        size_t published = 0;
+        
+        for (uint32_t i = 0; i < count; ++i) {
+            if (entries[i].state.load(std::memory_order_acquire) == ENTRY_PUBLISHED) {
+                ++published;
+            }
+        }
+        return published;
     }
     
     /**
@@ -163,22 +269,83 @@ public:
      * Get the next allocation offset
      */
     uint64_t next_offset() const {
-        return get_header()->next_offset;
+        return get_header()->next_offset.load(std::memory_order_acquire);
     }
     
 private:
+    static void check_alignment(size_t alignment) {
+        if (alignment == 0 || (alignment & (alignment - 1)) != 0 ||
+            alignment > MAX_ALLOC_ALIGN) {
+            throw std::invalid_argument(
+                "Alignment must be a power of two no larger than " +
+                std::to_string(MAX_ALLOC_ALIGN));
+        }
+    }
+    
+    static void check_entry(std::string_view name, size_t alignment) {
+        if (name.size() >= 32) {
+            throw std::invalid_argument("Name too long (max 31 characters)");
+        }
+        check_alignment(alignment);
+    }
+    
+    // Reserve a slot and claim `name` in it. Returns the CLAIMED entry
+    // (offset and size still to be filled in before publishing), nullptr if
+    // the table is full; throws if the name is taken.
+    Entry* claim(std::string_view name) {
+        auto* header = get_header();
+        for (;;) {
+            if (find(name) != nullptr) {
+                throw std::invalid_argument("Name already exists");
+            }
+            
+            // Reserve a slot. CAS (not fetch_add) so entry_count never exceeds
+            // max_entries even when many processes race on a nearly full table.
+            uint32_t index = header->entry_count.load(std::memory_order_relaxed);
+            do {
+                if (index >= max_entries_) {
+                    return nullptr;
+                }
+            } while (!header->entry_count.compare_exchange_weak(
+                        index, index + 1,
+                        std::memory_order_acq_rel,
+                        std::memory_order_relaxed));
+            
+            // The slot is exclusively ours; write the name and claim it.
+            auto& entry = get_entries()[index];
+            std::memset(entry.name, 0, sizeof(entry.name));
+            std::memcpy(entry.name, name.data(), name.size());
+            uint32_t pending = ENTRY_PENDING;
+            if (!entry.state.compare_exchange_strong(pending, ENTRY_CLAIMED,
+                                                     std::memory_order_acq_rel)) {
+                // We stalled so long that a registrar above gave up on the
+                // slot; it is dead, so try again in a fresh one.
+                continue;
+            }
+            
+            // Same-name race: the lowest claimed slot wins.
+            if (lower_slot_claims(name, index)) {
+                entry.state.store(ENTRY_DEAD, std::memory_order_release);
+                throw std::invalid_argument("Name already exists");
+            }
+            return &entry;
+        }
+    }
+    
     void initialize() {
         auto* header = get_header();
         header->magic = TABLE_MAGIC;
         header->version = TABLE_VERSION;
-        header->entry_count = 0;
+        header->entry_count.store(0, std::memory_order_relaxed);
         header->max_entries = static_cast<uint32_t>(max_entries_);
         header->memory_size = memory_size_;
-        header->next_offset = calculate_size(max_entries_);  // Already aligned due to struct sizes
+        header->next_offset.store(calculate_size(max_entries_),  // Already aligned due to struct sizes
+                                  std::memory_order_relaxed);
         
-        // Zero out entries
+        // Zero out entries (every state becomes ENTRY_PENDING)
         auto* entries = get_entries();
-        std::memset(entries, 0, max_entries_ * sizeof(Entry));
+        std::memset(static_cast<void*>(entries), 0, max_entries_ * sizeof(Entry));
+        std::atomic_thread_fence(std::memory_order_release);
     }
     
     void validate() {
@@ -192,7 +359,7 @@ private:
             throw std::runtime_error("Incompatible table version");
         }
         
-        if (header->entry_count > max_entries_) {
+        if (header->entry_count.load(std::memory_order_acquire) > max_entries_) {
             throw std::runtime_error("Table corruption: entry count exceeds maximum");
         }
         
@@ -200,6 +367,38 @@ private:
         memory_size_ = header->memory_size;
     }
     
+    // Number of reserved slots, clamped so a corrupt header cannot walk
+    // readers off the end of the entry array.
+    uint32_t slot_count() const {
+        uint32_t count = get_header()->entry_count.load(std::memory_order_acquire);
+        return count < max_entries_ ? count : static_cast<uint32_t>(max_entries_);
+    }
+    
+    // True if a slot below `index` holds a live claim on `name`. Waits
+    // (bounded, see MAX_SPINS) for lower PENDING slots to be claimed, since
+    // their registrars may be racing us for the same name, then marks any
+    // still PENDING as DEAD. If the CAS loses, the slot was just claimed.
+    bool lower_slot_claims(std::string_view name, uint32_t index) {
+        auto* entries = get_entries();
+        
+        for (uint32_t i = 0; i < index; ++i) {
+            uint32_t state = entries[i].state.load(std::memory_order_acquire);
+            for (int spins = 0; state == ENTRY_PENDING && spins < MAX_SPINS; ++spins) {
+                std::this_thread::yield();
+                state = entries[i].state.load(std::memory_order_acquire);
+            }
+            if (state == ENTRY_PENDING) {
+                entries[i].state.compare_exchange_strong(state, ENTRY_DEAD,
+                                                         std::memory_order_acq_rel);
+            }
+            if ((state == ENTRY_CLAIMED || state == ENTRY_PUBLISHED) &&
+                name == entries[i].name) {
+                return true;
+            }
+        }
+        return false;
+    }
+    
     Header* get_header() {
         return reinterpret_cast<Header*>(memory_);
     }
@@ -221,4 +420,4 @@ private:
     size_t memory_size_;
 };
 
-} // namespace zeroipc
\ No newline at end of file
+} // namespace zeroipc
@@ -0,0 +1,405 @@
+#pragma once
+
+#include "memory.h"
+#include "event.h"
+#include "queue.h"
+#include "channel.h"
+#include "detail/futex.h"
+#include "detail/watch_list.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace zeroipc {
+
+/**
+ * @brief select() case: runs a handler if nothing else fired by a deadline
+ */
+template<typename F>
+class TimeoutCase {
+public:
+    TimeoutCase(std::chrono::steady_clock::time_point deadline, F handler)
+        : deadline_(deadline), handler_(std::move(handler)) {}
+
+    bool try_fire() { return false; }
+    detail::WatchList* watch_list() { return nullptr; }
+    std::chrono::steady_clock::time_point deadline() const { return deadline_; }
+    void expire() { handler_(); }
+
+private:
+    std::chrono::steady_clock::time_point deadline_;
+    F handler_;
+};
+
+/**
+ * @brief A select() case that gives up after duration, running handler
+ */
+template<typename Rep, typename Period, typename F>
+[[nodiscard]] TimeoutCase<std::decay_t<F>> timeout(
+        const std::chrono::duration<Rep, Period>& duration, F&& handler) {
+    auto now = std::chrono::steady_clock::now();
+    auto deadline = duration >= std::chrono::steady_clock::time_point::max() - now
+        ? std::chrono::steady_clock::time_point::max()
+        : now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(duration);
+    return TimeoutCase<std::decay_t<F>>(deadline, std::forward<F>(handler));
+}
+
+/**
+ * @brief Block until any of several Events, Queues or Channels is ready
+ *
+ * The shared-memory analogue of WaitForMultipleObjects. A WaitSet owns one
+ * futex word in the segment; add() registers that word in the object's
+ * watch list, and the object's signal path (Event::signal, Queue push and
+ * pop, Channel send, receive and close) bumps and wakes every registered
+ * word. wait() checks the readiness of each object, then sleeps on the
+ * word until something changes: no polling loop and no syscall on the
+ * signal path while nobody is asleep.
+ *
+ * Readiness is level-triggered and a hint, like poll(2): wait() returns
+ * the lowest-numbered ready object, and the caller then does the
+ * non-blocking operation (pop(), try_recv(), wait_for(0ms)), which can
+ * still lose a race to another consumer.
+ *
+ * Objects must live in the WaitSet's segment. An object with no watch list
+ * (created by another binding) or whose list is full (7 WaitSets) still
+ * works: wait() then re-checks it every millisecond. A WaitSet is used by
+ * one thread at a time; registrations of a crashed process stay behind,
+ * costing the objects a wasted wake-up each.
+ *
+ * select() builds Go's select on the same word: each case is tried once,
+ * and if none can proceed the caller sleeps until one of the channels
+ * changes, then tries again. Cases are tried from a rotating start, so a
+ * busy channel does not starve the others. Unbuffered channel cases pair
+ * only with a plain send() or recv() on the other side.
+ *
+ * @layout WaitWord(8) at `name`; watch lists in each watched object
+ *
+ * @example
+ * ```cpp
+ * zeroipc::WaitSet ws(mem, "dispatcher");
+ * size_t jobs = ws.add_readable(job_queue);
+ * size_t quit = ws.add(shutdown_event);
+ * for (;;) {
+ *     size_t ready = ws.wait();
+ *     if (ready == quit) break;
+ *     while (auto job = job_queue.pop()) run(*job);
+ * }
+ *
+ * // Go-style select over channels
+ * zeroipc::select(ws,
+ *     requests.on_recv([](Request r) { serve(r); }),
+ *     results.on_send(next, [] { advance(); }),
+ *     zeroipc::timeout(1s, [] { heartbeat(); }));
+ * ```
+ */
+class WaitSet {
+public:
+    /**
+     * @brief Create or open a WaitSet's futex word
+     * @param mem Memory region holding the objects to wait on
+     * @param name Unique name for this wait set
+     * @throws std::runtime_error if the existing entry is not a WaitSet
+     */
+    WaitSet(Memory& mem, std::string_view name)
+        : base_(static_cast<char*>(mem.base())), size_(mem.size()) {
+        auto* entry = mem.table()->find(name);
+        if (entry) {
+            if (entry->size != sizeof(detail::WaitWord)) {
+                throw std::runtime_error("WaitSet size mismatch");
+            }
+            word_ = mem.ptr_at<detail::WaitWord>(entry->offset);
+        } else {
+            size_t offset = mem.allocate(name, sizeof(detail::WaitWord), CACHE_LINE_SIZE);
+            word_ = mem.ptr_at<detail::WaitWord>(offset);
+            word_->seq.store(0, std::memory_order_relaxed);
+            word_->sleepers.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    ~WaitSet() { clear(); }
+
+    /**
+     * @brief Watch an event, ready while signaled
+     * @return The index wait() reports for it
+     */
+    size_t add(Event& event) {
+        return add_entry(event.watch_list(), [&event] { return event.is_signaled(); });
+    }
+
+    /**
+     * @brief Watch a queue, ready while it holds an element
+     */
+    template<typename T>
+    size_t add_readable(Queue<T>& queue) {
+        return add_entry(queue.watch_list(), [&queue] { return !queue.empty(); });
+    }
+
+    /**
+     * @brief Watch a queue, ready while it has room
+     */
+    template<typename T>
+    size_t add_writable(Queue<T>& queue) {
+        return add_entry(queue.watch_list(), [&queue] { return !queue.full(); });
+    }
+
+    /**
+     * @brief Watch a channel, ready while a value is waiting or it is closed
+     */
+    template<typename T>
+    size_t add_readable(Channel<T>& channel) {
+        return add_entry(channel.watch_list(),
+                         [&channel] { return channel.has_data() || channel.is_closed(); });
+    }
+
+    /**
+     * @brief Watch a channel, ready while a send would not block or it is
+     *        closed
+     */
+    template<typename T>
+    size_t add_writable(Channel<T>& channel) {
+        return add_entry(channel.watch_list(),
+                         [&channel] { return channel.has_space() || channel.is_closed(); });
+    }
+
+    /**
+     * @brief Stop watching everything
+     */
+    void clear() {
+        for (auto& entry : entries_) {
+            if (entry.watched) {
+                detail::unwatch(*entry.list, *word_);
+            }
+        }
+        entries_.clear();
+        polled_ = 0;
+    }
+
+    [[nodiscard]] size_t size() const { return entries_.size(); }
+
+    /**
+     * @brief Block until an object is ready
+     * @return Index (from add) of the lowest-numbered ready object
+     * @throws std::logic_error if nothing has been added
+     */
+    size_t wait() {
+        if (entries_.empty()) {
+            throw std::logic_error("WaitSet is empty");
+        }
+        return *wait_until(Clock::time_point::max());
+    }
+
+    /**
+     * @brief Block until an object is ready or timeout passes
+     * @return Index of the lowest-numbered ready object, or nullopt on timeout
+     */
+    template<typename Rep, typename Period>
+    [[nodiscard]] std::optional<size_t> wait_for(const std::chrono::duration<Rep, Period>& timeout) {
+        return wait_until(deadline_after(timeout));
+    }
+
+    /**
+     * @brief Go-style select over channel cases
+     *
+     * Runs the handler of the first case that can proceed and returns its
+     * position among cases. With no case ready, sleeps until one of the
+     * channels changes; a timeout() case fires if nothing else has by its
+     * deadline. The channels are watched only for the call, independently
+     * of add().
+     */
+    template<typename... Cases>
+    size_t select(Cases&&... cases) {
+        static_assert(sizeof...(Cases) > 0, "select needs at least one case");
+        constexpr size_t N = sizeof...(Cases);
+        auto all = std::forward_as_tuple(cases...);
+        const size_t start = rotation_++ % N;
+
+        auto fire = [&]() -> std::optional<size_t> {
+            std::optional<size_t> fired;
+            for (size_t k = 0; k < N && !fired; k++) {
+                size_t i = (start + k) % N;
+                visit(all, i, [&](auto& c) {
+                    if (c.try_fire()) {
+                        fired = i;
+                    }
+                });
+            }
+            return fired;
+        };
+
+        if (auto fired = fire()) {
+            return *fired;
+        }
+
+        Clock::time_point deadline = Clock::time_point::max();
+        size_t expiring = N;
+        std::vector<detail::WatchList*> watched;
+        bool polled = false;
+        size_t index = 0;
+        std::apply([&](auto&... c) {
+            ([&] {
+                if constexpr (requires { c.deadline(); }) {
+                    if (c.deadline() < deadline) {
+                        deadline = c.deadline();
+                        expiring = index;
+                    }
+                } else {
+                    detail::WatchList* list = checked(c.watch_list());
+                    if (list && std::find(watched.begin(), watched.end(), list) == watched.end()) {
+                        if (detail::watch(*list, *word_)) {
+                            watched.push_back(list);
+                        } else {
+                            polled = true;
+                        }
+                    } else if (!list) {
+                        polled = true;
+                    }
+                }
+                index++;
+            }(), ...);
+        }, all);
+
+        struct Unwatch {
+            std::vector<detail::WatchList*>& lists;
+            detail::WaitWord& word;
+            ~Unwatch() {
+                for (auto* list : lists) {
+                    detail::unwatch(*list, word);
+                }
+            }
+        } unwatch{watched, *word_};
+
+        auto fired = sleep_until(fire, deadline, polled);
+        if (fired) {
+            return *fired;
+        }
+        visit(all, expiring, [](auto& c) {
+            if constexpr (requires { c.expire(); }) {
+                c.expire();
+            }
+        });
+        return expiring;
+    }
+
+    WaitSet(const WaitSet&) = delete;
+    WaitSet& operator=(const WaitSet&) = delete;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    // Longest sleep on the word: bounds the delay from a writer that does
+    // not poke (another binding, or one that crashed mid-change)
+    static constexpr std::chrono::milliseconds WAIT_SLICE{10};
+
+    // Sleep while an object is polled rather than watched
+    static constexpr std::chrono::milliseconds POLL_SLICE{1};
+
+    struct Entry {
+        std::function<bool()> ready;
+        detail::WatchList* list;
+        bool watched;
+    };
+
+    char* base_;
+    size_t size_;
+    detail::WaitWord* word_ = nullptr;
+    std::vector<Entry> entries_;
+    size_t polled_ = 0;     // Entries without a watch list slot
+    size_t rotation_ = 0;   // Where select() starts trying cases
+
+    // The watch list, after checking it lives in our segment: the word's
+    // distance from it must mean the same thing in every process
+    detail::WatchList* checked(detail::WatchList* list) const {
+        auto* p = reinterpret_cast<char*>(list);
+        if (list && (p < base_ || p >= base_ + size_)) {
+            throw std::invalid_argument("WaitSet objects must be in the WaitSet's memory");
+        }
+        return list;
+    }
+
+    size_t add_entry(detail::WatchList* list, std::function<bool()> ready) {
+        checked(list);
+        bool watched = list && detail::watch(*list, *word_);
+        if (!watched) {
+            polled_++;
+        }
+        entries_.push_back({std::move(ready), list, watched});
+        return entries_.size() - 1;
+    }
+
+    std::optional<size_t> wait_until(Clock::time_point deadline) {
+        auto ready = [this]() -> std::optional<size_t> {
+            for (size_t i = 0; i < entries_.size(); i++) {
+                if (entries_[i].ready()) {
+                    return i;
+                }
+            }
+            return std::nullopt;
+        };
+        if (auto i = ready()) {
+            return i;
+        }
+        return sleep_until(ready, deadline, polled_ != 0);
+    }
+
+    // Run check until it yields, sleeping on the word in between. Announce
+    // the sleep, fence, read the word, then re-check: a change that lands
+    // after the re-check bumps the word (so the futex does not sleep) and
+    // sees us announced (so it wakes us). Pairs with detail::poke().
+    template<typename Check>
+    std::optional<size_t> sleep_until(Check&& check, Clock::time_point deadline, bool polled) {
+        for (;;) {
+            word_->sleepers.fetch_add(1, std::memory_order_seq_cst);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            uint32_t seen = word_->seq.load(std::memory_order_seq_cst);
+            auto result = check();
+            auto now = Clock::now();
+            if (!result && now < deadline) {
+                detail::futex_wait(&word_->seq, seen,
+                                   std::min<Clock::duration>(deadline - now,
+                                                             polled ? POLL_SLICE : WAIT_SLICE));
+            }
+            word_->sleepers.fetch_sub(1, std::memory_order_relaxed);
+            if (result || now >= deadline) {
+                return result;
+            }
+        }
+    }
+
+    // Call f on element i of a tuple
+    template<typename Tuple, typename F>
+    static void visit(Tuple& t, size_t i, F&& f) {
+        size_t index = 0;
+        std::apply([&](auto&... c) {
+            ((index++ == i ? f(c) : void()), ...);
+        }, t);
+    }
+
+    template<typename Rep, typename Period>
+    static Clock::time_point deadline_after(const std::chrono::duration<Rep, Period>& timeout) {
+        auto now = Clock::now();
+        if (timeout >= Clock::time_point::max() - now) {
+            return Clock::time_point::max();
+        }
+        return now + std::chrono::duration_cast<Clock::duration>(timeout);
+    }
+};
+
+/**
+ * @brief Go-style select: ws.select(cases...)
+ */
+template<typename... Cases>
+size_t select(WaitSet& ws, Cases&&... cases) {
+    return ws.select(std::forward<Cases>(cases)...);
+}
+
+} // namespace zeroipc
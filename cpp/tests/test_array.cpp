@@ -2,6 +2,8 @@
 #include <zeroipc/array.h>
 #include <algorithm>
 #include <numeric>
+#include <thread>
+#include <vector>
 
 using namespace zeroipc;
 
@@ -177,6 +179,208 @@ TEST_F(ArrayTest, DataPointer) {
     EXPECT_EQ(arr[5], 555);
 }
 
+TEST_F(ArrayTest, BulkOperationsMatchSerialLoops) {
+    const size_t n = 300007;  // Not a multiple of any chunk or lane count
+    Array<int64_t> arr(*mem, "bulk", n);
+
+    for (unsigned threads : {1u, 4u, 0u}) {
+        arr.fill(7, threads);
+        EXPECT_EQ(arr.sum(threads), int64_t(7 * n));
+
+        arr.transform([](int64_t x) { return x * 3 - 20; }, threads);
+        EXPECT_EQ(arr[n - 1], 1);
+
+        std::vector<int64_t> src(n);
+        std::iota(src.begin(), src.end(), -1000);
+        arr.copy_from(src.data(), n, 0, threads);
+        EXPECT_EQ(arr.sum(threads), std::accumulate(src.begin(), src.end(), int64_t(0)));
+        EXPECT_EQ(arr.min(threads), -1000);
+        EXPECT_EQ(arr.max(threads), int64_t(n) - 1001);
+        EXPECT_EQ(arr.reduce(0, [](int64_t a, int64_t b) { return a ^ b; }, threads),
+                  std::accumulate(src.begin(), src.end(), int64_t(0),
+                                  [](int64_t a, int64_t b) { return a ^ b; }));
+
+        EXPECT_EQ(arr.find(-1000, threads), 0u);
+        EXPECT_EQ(arr.find(250000, threads), 251000u);
+        EXPECT_FALSE(arr.find(-5000, threads).has_value());
+
+        auto bins = arr.histogram(10, int64_t(0), int64_t(100000), threads);
+        ASSERT_EQ(bins.size(), 10u);
+        for (size_t b : bins) {
+            EXPECT_EQ(b, 10000u);
+        }
+    }
+}
+
+TEST_F(ArrayTest, BulkOperationsOnFloats) {
+    Array<float> arr(*mem, "floats", 100000);
+    arr.fill(0.5f, 4);
+    EXPECT_FLOAT_EQ(arr.sum(4), 50000.0f);
+
+    arr[12345] = -3.0f;
+    arr[99999] = 9.0f;
+    EXPECT_FLOAT_EQ(arr.min(), -3.0f);
+    EXPECT_FLOAT_EQ(arr.max(4), 9.0f);
+    EXPECT_EQ(arr.find(-3.0f, 4), 12345u);
+
+    // Duplicates: the first match wins regardless of which thread finds one
+    arr[99000] = -3.0f;
+    EXPECT_EQ(arr.find(-3.0f, 0), 12345u);
+
+    auto bins = arr.histogram(4, -4.0f, 12.0f);
+    EXPECT_EQ(bins[0], 2u);
+    EXPECT_EQ(bins[1], 100000u - 3);
+    EXPECT_EQ(bins[3], 1u);
+
+    float small[3] = {1, 2, 3};
+    EXPECT_THROW(arr.copy_from(small, 3, 99998), std::out_of_range);
+    EXPECT_THROW((void)arr.histogram(0, 0.0f, 1.0f), std::invalid_argument);
+}
+
+TEST_F(ArrayTest, AtomicElementOperations) {
+    static_assert(Array<uint64_t>::atomic_elements);
+    static_assert(Array<double>::atomic_elements);
+    struct Big { char bytes[64]; };
+    static_assert(!Array<Big>::atomic_elements);
+
+    Array<uint32_t> arr(*mem, "atomics", 16);
+    arr.atomic_store(3, 10);
+    EXPECT_EQ(arr.atomic_load(3), 10u);
+    EXPECT_EQ(arr.fetch_add(3, 5), 10u);
+    EXPECT_EQ(arr.fetch_or(3, 0x100), 15u);
+    EXPECT_EQ(arr[3], 0x10Fu);
+
+    uint32_t expected = 1;
+    EXPECT_FALSE(arr.compare_exchange(3, expected, 2));
+    EXPECT_EQ(expected, 0x10Fu);
+    EXPECT_TRUE(arr.compare_exchange(3, expected, 2));
+    EXPECT_EQ(arr.atomic_load(3, std::memory_order_acquire), 2u);
+
+    EXPECT_THROW(arr.fetch_add(16, 1), std::out_of_range);
+
+    Array<double> sums(*mem, "sums", 4);
+    sums.fetch_add(1, 0.25);
+    sums.fetch_add(1, 0.5);
+    EXPECT_DOUBLE_EQ(sums.atomic_load(1), 0.75);
+}
+
+TEST_F(ArrayTest, ConcurrentCountersWithoutLocks) {
+    Array<uint64_t> counters(*mem, "counters", 64);
+
+    const int num_threads = 4;
+    const int per_thread = 20000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; t++) {
+        threads.emplace_back([&, t]() {
+            std::vector<size_t> indices;
+            std::vector<uint64_t> deltas;
+            for (int i = 0; i < per_thread; i++) {
+                counters.fetch_add(i % 8, 1, std::memory_order_relaxed);
+                indices.push_back((i * 7 + t) % 64);
+                deltas.push_back(2);
+                if (indices.size() == 100) {
+                    counters.fetch_add_many(indices.data(), deltas.data(), indices.size());
+                    indices.clear();
+                    deltas.clear();
+                }
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    uint64_t total = counters.sum();
+    EXPECT_EQ(total, uint64_t(num_threads) * per_thread * 3);
+    std::vector<uint64_t> expected(64, 0);
+    for (int t = 0; t < num_threads; t++) {
+        for (int i = 0; i < per_thread; i++) {
+            expected[i % 8] += 1;
+            expected[(i * 7 + t) % 64] += 2;
+        }
+    }
+    for (size_t k = 0; k < 64; k++) {
+        EXPECT_EQ(counters[k], expected[k]) << "counter " << k;
+    }
+
+    // Bad index anywhere in the batch: nothing is applied
+    size_t bad[] = {1, 2, 64};
+    uint64_t one[] = {1, 1, 1};
+    EXPECT_THROW(counters.fetch_add_many(bad, one, 3), std::out_of_range);
+    EXPECT_EQ(counters.sum(), total);
+}
+
+TEST_F(ArrayTest, VersionedRegions) {
+    Array<double> plain(*mem, "plain", 100);
+    EXPECT_FALSE(plain.versioned());
+    double buf[500];
+    EXPECT_THROW((void)plain.read_region(0, buf, 10), std::logic_error);
+
+    Array<double> prices(*mem, "prices", 1000, 64);
+    EXPECT_TRUE(prices.versioned());
+    EXPECT_EQ(prices.version_block(), 64u);
+
+    for (int i = 0; i < 500; i++) buf[i] = i * 0.5;
+    prices.write_region(300, buf, 500);  // Spans blocks 4..12
+    double out[500] = {};
+    ASSERT_TRUE(prices.read_region(300, out, 500));
+    EXPECT_EQ(out[0], 0.0);
+    EXPECT_EQ(out[499], 249.5);
+    EXPECT_EQ(prices[799], 249.5);
+
+    prices.update_region(0, 3, [](double* p) { p[0] = p[1] = p[2] = 7.0; });
+    std::vector<double> all(1000);
+    ASSERT_TRUE(prices.snapshot(all.data()));
+    EXPECT_EQ(all[2], 7.0);
+    EXPECT_THROW(prices.write_region(900, buf, 101), std::out_of_range);
+
+    Array<double> opened(*mem, "prices");
+    EXPECT_TRUE(opened.versioned());
+    EXPECT_EQ(opened.version_block(), 64u);
+    EXPECT_THROW(Array<double>(*mem, "prices", 0, 32), std::runtime_error);
+    EXPECT_THROW(Array<double>(*mem, "plain", 0, 32), std::runtime_error);
+}
+
+TEST_F(ArrayTest, VersionedReadsNeverTorn) {
+    Array<uint64_t> vec(*mem, "vector", 1024, 64);
+
+    std::atomic<bool> done{false};
+    std::atomic<int> torn{0};
+    std::atomic<int> reads{0};
+
+    // Every write sets elements [100, 600) to one generation number
+    std::thread writer([&] {
+        std::vector<uint64_t> region(500);
+        for (uint64_t gen = 1; gen <= 20000; gen++) {
+            std::fill(region.begin(), region.end(), gen);
+            vec.write_region(100, region.data(), region.size());
+        }
+        done = true;
+    });
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 2; r++) {
+        readers.emplace_back([&, r] {
+            std::vector<uint64_t> out(1024);
+            do {
+                // Reader 0 takes the updated range, reader 1 the whole array
+                bool ok = r == 0 ? vec.read_region(100, out.data() + 100, 500)
+                                 : vec.snapshot(out.data());
+                if (!ok) continue;
+                reads++;
+                for (size_t i = 101; i < 600; i++) {
+                    if (out[i] != out[100]) {
+                        torn++;
+                        break;
+                    }
+                }
+            } while (!done);
+        });
+    }
+    writer.join();
+    for (auto& t : readers) t.join();
+
+    EXPECT_EQ(torn.load(), 0);
+    EXPECT_GT(reads.load(), 0);
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
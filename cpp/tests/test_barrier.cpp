@@ -5,7 +5,9 @@
 #include <vector>
 #include <atomic>
 #include <chrono>
+#include <sys/wait.h>
 #include <unistd.h>
+#include <zeroipc/array.h>
 #include "test_config.h"
 
 using namespace zeroipc;
@@ -431,6 +433,139 @@ TEST_F(BarrierTest, LargeNumberOfParticipants) {
     EXPECT_EQ(counter.load(), num_threads);
 }
 
+// ============================================================================
+// Tree Mode Tests
+// ============================================================================
+
+TEST_F(BarrierTest, DefaultModeStaysCentral) {
+    Memory mem(shm_name_, 1024*1024);
+    // Other bindings only open the central layout, however many participate
+    Barrier large(mem, "large", Barrier::TREE_THRESHOLD * 4);
+    EXPECT_EQ(large.mode(), Barrier::Mode::Central);
+    EXPECT_EQ(mem.table()->find("large")->size, sizeof(Barrier::Header));
+}
+
+TEST_F(BarrierTest, AutoModeChosenByParticipantCount) {
+    Memory mem(shm_name_, 1024*1024);
+    Barrier small(mem, "small", Barrier::TREE_THRESHOLD - 1, Barrier::Mode::Auto);
+    Barrier large(mem, "large", Barrier::TREE_THRESHOLD, Barrier::Mode::Auto);
+    Barrier forced(mem, "forced", 3, Barrier::Mode::Tree);
+
+    EXPECT_EQ(small.mode(), Barrier::Mode::Central);
+    EXPECT_EQ(large.mode(), Barrier::Mode::Tree);
+    EXPECT_EQ(forced.mode(), Barrier::Mode::Tree);
+
+    Barrier reopened(mem, "large");
+    EXPECT_EQ(reopened.mode(), Barrier::Mode::Tree);
+    EXPECT_EQ(reopened.num_participants(), Barrier::TREE_THRESHOLD);
+    EXPECT_EQ(reopened.arrived(), 0);
+    EXPECT_EQ(reopened.generation(), 0);
+}
+
+TEST_F(BarrierTest, TreeBarrierReusability) {
+    Memory mem(shm_name_, 1024*1024);
+    // 3 levels: 10 leaves, 3 inner nodes, the root
+    const int num_threads = 40;
+    const int num_iterations = 20;
+    Barrier barrier(mem, "tree", num_threads, Barrier::Mode::Tree);
+
+    std::atomic<int> phase_counter{0};
+
+    auto worker = [&]() {
+        for (int i = 0; i < num_iterations; ++i) {
+            phase_counter.fetch_add(1);
+            barrier.wait();
+            EXPECT_EQ(phase_counter.load(), num_threads * (i + 1));
+            barrier.wait();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_threads; ++i) {
+        threads.emplace_back(worker);
+    }
+
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    EXPECT_EQ(barrier.generation(), num_iterations * 2);
+    EXPECT_EQ(barrier.arrived(), 0);
+}
+
+TEST_F(BarrierTest, TreeWaitForTimeoutWithdraws) {
+    Memory mem(shm_name_, 1024*1024);
+    Barrier barrier(mem, "tree_timeout", 3, Barrier::Mode::Tree);
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(barrier.wait_for(TestTiming::MEDIUM_TIMEOUT));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, TestTiming::MEDIUM_TIMEOUT);
+    EXPECT_EQ(barrier.arrived(), 0);
+
+    // The withdrawn arrival must not count toward the next cycle
+    std::atomic<int> passed{0};
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 2; ++i) {
+        threads.emplace_back([&]() {
+            barrier.wait();
+            passed.fetch_add(1);
+        });
+    }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (barrier.arrived() < 2 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(barrier.arrived(), 2);
+    EXPECT_EQ(passed.load(), 0);
+
+    EXPECT_TRUE(barrier.wait_for(TestTiming::LONG_TIMEOUT));
+    for (auto& t : threads) {
+        t.join();
+    }
+    EXPECT_EQ(passed.load(), 2);
+    EXPECT_EQ(barrier.generation(), 1);
+}
+
+TEST_F(BarrierTest, CrossProcessTreeBarrier) {
+    Memory mem(shm_name_, 1024*1024);
+    const int num_processes = Barrier::TREE_THRESHOLD + 4;
+    const int rounds = 50;
+    Barrier barrier(mem, "tree_procs", num_processes, Barrier::Mode::Auto);
+    Array<int> slots(mem, "slots", num_processes);
+    ASSERT_EQ(barrier.mode(), Barrier::Mode::Tree);
+
+    std::vector<pid_t> children;
+    for (int p = 0; p < num_processes; ++p) {
+        pid_t pid = fork();
+        ASSERT_NE(pid, -1);
+        if (pid == 0) {
+            Memory child_mem(shm_name_);
+            Barrier child_barrier(child_mem, "tree_procs");
+            Array<int> child_slots(child_mem, "slots");
+            for (int r = 1; r <= rounds; ++r) {
+                child_slots[p] = r;
+                child_barrier.wait();
+                // Every process wrote this round before anyone got here
+                for (int q = 0; q < num_processes; ++q) {
+                    if (child_slots[q] < r) {
+                        _exit(1);
+                    }
+                }
+                child_barrier.wait();
+            }
+            _exit(0);
+        }
+        children.push_back(pid);
+    }
+
+    for (pid_t pid : children) {
+        int status;
+        waitpid(pid, &status, 0);
+        EXPECT_EQ(WEXITSTATUS(status), 0);
+    }
+    EXPECT_EQ(barrier.generation(), rounds * 2);
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+#include <zeroipc/memory.h>
+#include <zeroipc/biased_rwlock.h>
+#include <zeroipc/array.h>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "test_config.h"
+
+using namespace zeroipc::test;
+
+class BiasedRWLockTest : public SharedMemoryTestBase {
+};
+
+TEST_F(BiasedRWLockTest, ReadersUseSlotsWhileBiased) {
+    zeroipc::Memory mem(shm_name_, 1024 * 1024);
+    zeroipc::BiasedRWLock lock(mem, "block", 8);
+
+    EXPECT_EQ(lock.slots(), 8u);
+    EXPECT_TRUE(lock.reader_biased());
+
+    auto a = lock.reader_lock();
+    auto b = lock.reader_lock();
+    EXPECT_LT(a, 8u);
+    EXPECT_LT(b, 8u);
+    lock.reader_unlock(b);
+    lock.reader_unlock(a);
+
+    auto t = lock.try_reader_lock();
+    ASSERT_TRUE(t.has_value());
+    EXPECT_NE(*t, zeroipc::BiasedRWLock::SLOW_PATH);
+    lock.reader_unlock(*t);
+}
+
+TEST_F(BiasedRWLockTest, WriterRevokesBias) {
+    zeroipc::Memory mem(shm_name_, 1024 * 1024);
+    zeroipc::BiasedRWLock lock(mem, "block", 4);
+
+    lock.writer_lock();
+    EXPECT_FALSE(lock.reader_biased());
+    EXPECT_FALSE(lock.try_reader_lock().has_value());
+    lock.writer_unlock();
+
+    // Readers fall back to the RWLock until the inhibit period is over,
+    // then a reader restores the bias
+    bool restored = false;
+    for (int i = 0; i < 1000 && !restored; ++i) {
+        zeroipc::BiasedRWLock::ReadGuard guard(lock);
+        restored = lock.reader_biased();
+        if (!restored) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_TRUE(restored);
+}
+
+TEST_F(BiasedRWLockTest, WriterWaitsForSlotReaders) {
+    zeroipc::Memory mem(shm_name_, 1024 * 1024);
+    zeroipc::BiasedRWLock lock(mem, "block", 4);
+
+    auto token = lock.reader_lock();
+    ASSERT_NE(token, zeroipc::BiasedRWLock::SLOW_PATH);
+
+    std::atomic<bool> written{false};
+    std::thread writer([&]() {
+        zeroipc::BiasedRWLock::WriteGuard guard(lock);
+        written = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(written.load());
+
+    lock.reader_unlock(token);
+    writer.join();
+    EXPECT_TRUE(written.load());
+}
+
+TEST_F(BiasedRWLockTest, SlotCountFixedAtCreation) {
+    zeroipc::Memory mem(shm_name_, 1024 * 1024);
+    zeroipc::BiasedRWLock created(mem, "block", 16);
+
+    zeroipc::BiasedRWLock opened(mem, "block");
+    EXPECT_EQ(opened.slots(), 16u);
+    EXPECT_NO_THROW(zeroipc::BiasedRWLock(mem, "block", 16));
+    EXPECT_THROW(zeroipc::BiasedRWLock(mem, "block", 8), std::runtime_error);
+    EXPECT_THROW(zeroipc::BiasedRWLock(mem, "other", 100000), std::invalid_argument);
+    EXPECT_EQ(mem.table()->find("other_rw"), nullptr);
+
+    // Too long for the "_rw" entry: rejected before anything is registered
+    std::string long_name(zeroipc::BiasedRWLock::MAX_NAME + 1, 'b');
+    size_t entries = mem.table()->entry_count();
+    EXPECT_THROW(zeroipc::BiasedRWLock(mem, long_name), std::invalid_argument);
+    EXPECT_EQ(mem.table()->entry_count(), entries);
+
+    zeroipc::BiasedRWLock sized(mem, "default");
+    EXPECT_GE(sized.slots(), 1u);
+}
+
+// Writers keep an invariant pair equal; readers on both paths check it
+TEST_F(BiasedRWLockTest, MutualExclusionStress) {
+    zeroipc::Memory mem(shm_name_, 1024 * 1024);
+    zeroipc::BiasedRWLock lock(mem, "block", 4);
+    zeroipc::Array<uint64_t> data(mem, "block_data", 2);
+    data[0] = 0;
+    data[1] = 0;
+
+    std::atomic<bool> stop{false};
+    std::atomic<int> violations{0};
+
+    std::vector<std::thread> threads;
+    for (int r = 0; r < 4; ++r) {
+        threads.emplace_back([&]() {
+            while (!stop.load(std::memory_order_relaxed)) {
+                zeroipc::BiasedRWLock::ReadGuard guard(lock);
+                if (data[0] != data[1]) violations.fetch_add(1);
+            }
+        });
+    }
+    for (int w = 0; w < 2; ++w) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < 2000; ++i) {
+                zeroipc::BiasedRWLock::WriteGuard guard(lock);
+                uint64_t v = data[0] + 1;
+                data[0] = v;
+                std::this_thread::yield();
+                data[1] = v;
+            }
+            stop.store(true);
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    EXPECT_EQ(violations.load(), 0);
+    EXPECT_EQ(data[0], 4000u);
+}
+
+TEST_F(BiasedRWLockTest, CrossProcess) {
+    zeroipc::Memory mem(shm_name_, 1024 * 1024);
+    zeroipc::BiasedRWLock lock(mem, "block", 4);
+    zeroipc::Array<uint64_t> data(mem, "block_data", 2);
+    data[0] = 0;
+    data[1] = 0;
+
+    pid_t pid = fork();
+    ASSERT_NE(pid, -1);
+
+    if (pid == 0) {
+        zeroipc::Memory child_mem(shm_name_);
+        zeroipc::BiasedRWLock child_lock(child_mem, "block");
+        zeroipc::Array<uint64_t> child_data(child_mem, "block_data");
+
+        int bad = 0;
+        for (int i = 0; i < 2000; i++) {
+            zeroipc::BiasedRWLock::ReadGuard guard(child_lock);
+            if (child_data[0] != child_data[1]) bad++;
+        }
+        exit(bad == 0 ? 0 : 1);
+    }
+
+    for (int i = 0; i < 200; i++) {
+        zeroipc::BiasedRWLock::WriteGuard guard(lock);
+        data[0]++;
+        std::this_thread::yield();
+        data[1]++;
+    }
+
+    int status;
+    waitpid(pid, &status, 0);
+    EXPECT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+    EXPECT_EQ(data[0], 200u);
+}
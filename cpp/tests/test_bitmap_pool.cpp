@@ -0,0 +1,229 @@
+#include <gtest/gtest.h>
+#include <zeroipc/memory.h>
+#include <zeroipc/bitmap_pool.h>
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "test_config.h"
+
+using namespace zeroipc;
+using namespace zeroipc::test;
+
+class BitmapPoolTest : public SharedMemoryTestBase {
+};
+
+TEST_F(BitmapPoolTest, AllocatesLowestFreeSlot) {
+    Memory mem(shm_name_, 1024*1024);
+    BitmapPool<double> pool(mem, "pool", 100);
+    EXPECT_EQ(pool.capacity(), 100u);
+
+    std::vector<double*> ptrs;
+    for (int i = 0; i < 100; i++) {
+        auto p = pool.allocate();
+        ASSERT_TRUE(p.has_value());
+        EXPECT_EQ(pool.index_of(*p), size_t(i));
+        ptrs.push_back(*p);
+    }
+    EXPECT_TRUE(pool.full());
+    EXPECT_FALSE(pool.allocate().has_value());  // Bits past 100 stay set
+
+    // After churn the next allocations still fill the lowest holes
+    pool.deallocate(ptrs[70]);
+    pool.deallocate(ptrs[3]);
+    pool.deallocate(ptrs[64]);
+    EXPECT_FALSE(pool.is_allocated(ptrs[3]));
+    EXPECT_EQ(pool.allocate(), ptrs[3]);
+    EXPECT_EQ(pool.allocate(), ptrs[64]);
+    EXPECT_EQ(pool.allocate(), ptrs[70]);
+    EXPECT_TRUE(pool.full());
+}
+
+TEST_F(BitmapPoolTest, HintSkipsFullWordsButSeesFrees) {
+    Memory mem(shm_name_, 1024*1024);
+    BitmapPool<int> pool(mem, "hint", 256);
+
+    std::vector<int*> ptrs;
+    for (int i = 0; i < 192; i++) {
+        ptrs.push_back(*pool.allocate());  // Words 0-2 now full
+    }
+
+    // A free below the hint pulls it back down
+    pool.deallocate(ptrs[10]);
+    EXPECT_EQ(pool.allocate(), ptrs[10]);
+    EXPECT_EQ(pool.index_of(*pool.allocate()), 192u);
+
+    // Runs also start from the hint, and see runs freed below it
+    pool.deallocate_run(ptrs[100], 8);
+    auto run = pool.allocate_run(5);
+    ASSERT_TRUE(run.has_value());
+    EXPECT_EQ(*run, ptrs[100]);
+    EXPECT_EQ(pool.allocate(), ptrs[105]);
+}
+
+TEST_F(BitmapPoolTest, ContiguousRuns) {
+    Memory mem(shm_name_, 1024*1024);
+    BitmapPool<int> pool(mem, "runs", 256);
+
+    auto a = pool.allocate_run(10);
+    ASSERT_TRUE(a.has_value());
+    EXPECT_EQ(pool.index_of(*a), 0u);
+
+    // Spans the word boundary at 64
+    auto b = pool.allocate_run(100);
+    ASSERT_TRUE(b.has_value());
+    EXPECT_EQ(pool.index_of(*b), 10u);
+    EXPECT_EQ(pool.allocated(), 110u);
+
+    // A hole of 10 at the start is too small for 11
+    pool.deallocate_run(*a, 10);
+    auto c = pool.allocate_run(11);
+    ASSERT_TRUE(c.has_value());
+    EXPECT_EQ(pool.index_of(*c), 110u);
+    auto d = pool.allocate_run(10);
+    ASSERT_TRUE(d.has_value());
+    EXPECT_EQ(pool.index_of(*d), 0u);
+
+    EXPECT_FALSE(pool.allocate_run(200).has_value());
+    EXPECT_FALSE(pool.allocate_run(0).has_value());
+    auto rest = pool.allocate_run(256 - 121);
+    ASSERT_TRUE(rest.has_value());
+    EXPECT_TRUE(pool.full());
+}
+
+TEST_F(BitmapPoolTest, RejectsForeignPointersAndDoubleFree) {
+    Memory mem(shm_name_, 1024*1024);
+    BitmapPool<int> pool(mem, "checks", 16);
+
+    int outside = 0;
+    EXPECT_THROW(pool.deallocate(&outside), std::invalid_argument);
+
+    auto p = pool.allocate();
+    ASSERT_TRUE(p.has_value());
+    pool.deallocate(*p);
+    EXPECT_THROW(pool.deallocate(*p), std::invalid_argument);
+    EXPECT_THROW(pool.deallocate_run(pool.at(8), 9), std::invalid_argument);
+}
+
+TEST_F(BitmapPoolTest, FailedFreeLeavesBitmapUntouched) {
+    Memory mem(shm_name_, 1024*1024);
+    BitmapPool<int> pool(mem, "untouched", 192);
+
+    // Slots 0..69 allocated (across the word boundary), 70..127 free,
+    // 128..139 allocated
+    auto a = pool.allocate_run(70);
+    ASSERT_TRUE(a.has_value());
+    auto gap = pool.allocate_run(58);
+    ASSERT_TRUE(gap.has_value());
+    auto b = pool.allocate_run(12);
+    ASSERT_TRUE(b.has_value());
+    pool.deallocate_run(*gap, 58);
+    ASSERT_EQ(pool.allocated(), 82u);
+
+    // A run covering allocated and free slots in several words is rejected
+    // before any bit is cleared
+    EXPECT_THROW(pool.deallocate_run(pool.at(60), 75), std::invalid_argument);
+    EXPECT_EQ(pool.allocated(), 82u);
+    for (size_t i = 0; i < 70; i++) {
+        EXPECT_TRUE(pool.is_allocated(pool.at(i))) << i;
+    }
+    for (size_t i = 128; i < 140; i++) {
+        EXPECT_TRUE(pool.is_allocated(pool.at(i))) << i;
+    }
+
+    pool.deallocate_run(*a, 70);
+    pool.deallocate_run(*b, 12);
+    EXPECT_TRUE(pool.empty());
+}
+
+TEST_F(BitmapPoolTest, OpenExisting) {
+    Memory mem(shm_name_, 1024*1024);
+    BitmapPool<int> creator(mem, "shared", 70);
+    auto p = creator.allocate_run(5);
+    ASSERT_TRUE(p.has_value());
+    **p = 42;
+
+    BitmapPool<int> opened(mem, "shared");
+    EXPECT_EQ(opened.capacity(), 70u);
+    EXPECT_EQ(opened.allocated(), 5u);
+    EXPECT_EQ(*opened.at(0), 42);
+    EXPECT_EQ(opened.index_of(*opened.allocate()), 5u);
+
+    EXPECT_THROW(BitmapPool<double>(mem, "shared"), std::runtime_error);
+    EXPECT_THROW(BitmapPool<int>(mem, "missing"), std::runtime_error);
+    EXPECT_THROW(BitmapPool<int>(mem, "empty", 0), std::invalid_argument);
+}
+
+TEST_F(BitmapPoolTest, ConcurrentAllocateNeverDuplicates) {
+    Memory mem(shm_name_, 4*1024*1024);
+    BitmapPool<int> pool(mem, "concurrent", 1000);
+
+    const int num_threads = 4;
+    std::vector<std::vector<int*>> held(num_threads);
+    std::atomic<bool> corrupted{false};
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < num_threads; t++) {
+        threads.emplace_back([&, t]() {
+            for (int r = 0; r < 5000; r++) {
+                if (r % 4 == 3) {
+                    if (auto run = pool.allocate_run(4)) {
+                        for (int i = 0; i < 4; i++) (*run)[i] = t;
+                        for (int i = 0; i < 4; i++) {
+                            if ((*run)[i] != t) corrupted = true;
+                        }
+                        pool.deallocate_run(*run, 4);
+                    }
+                } else if (held[t].size() < 200) {
+                    if (auto p = pool.allocate()) {
+                        **p = t;
+                        held[t].push_back(*p);
+                    }
+                } else {
+                    for (int* p : held[t]) {
+                        if (*p != t) corrupted = true;
+                        pool.deallocate(p);
+                    }
+                    held[t].clear();
+                }
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    EXPECT_FALSE(corrupted.load());
+    std::set<int*> unique;
+    size_t total = 0;
+    for (auto& h : held) {
+        unique.insert(h.begin(), h.end());
+        total += h.size();
+    }
+    EXPECT_EQ(unique.size(), total);
+    EXPECT_EQ(pool.allocated(), total);
+}
+
+TEST_F(BitmapPoolTest, AcrossProcesses) {
+    Memory mem(shm_name_, 1024*1024);
+    BitmapPool<int> pool(mem, "xproc", 128);
+
+    pid_t pid = fork();
+    ASSERT_NE(pid, -1);
+    if (pid == 0) {
+        Memory child_mem(shm_name_);
+        BitmapPool<int> child_pool(child_mem, "xproc");
+        auto run = child_pool.allocate_run(50);
+        if (!run) exit(1);
+        for (int i = 0; i < 50; i++) (*run)[i] = i;
+        exit(0);
+    }
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+    ASSERT_EQ(WEXITSTATUS(status), 0);
+
+    EXPECT_EQ(pool.allocated(), 50u);
+    EXPECT_EQ(*pool.at(49), 49);
+    EXPECT_EQ(pool.index_of(*pool.allocate()), 50u);
+}
@@ -17,7 +17,8 @@ protected:
     void SetUp() override { Memory::unlink("/test_crash_safety"); }
     void TearDown() override { Memory::unlink("/test_crash_safety"); }
 
-    // Pointer to slot i's state, computed from the spec layout formula.
+    // Pointer to slot i's state, computed from the spec layout formula
+    // (compact header).
     static std::atomic<uint32_t>* state_ptr(Memory& mem, const char* name,
                                             size_t elem_size, size_t cap,
                                             size_t i) {
@@ -31,7 +32,7 @@ protected:
 
 TEST_F(CrashSafetyTest, PopBailsOutWhenSlotStuckInWriting) {
     Memory mem("/test_crash_safety", 1024 * 1024);
-    Stack<int> s(mem, "s", 8);
+    Stack<int> s(mem, "s", 8, StackLayout::Compact);
 
     ASSERT_TRUE(s.push(1));
     ASSERT_TRUE(s.push(2));
@@ -58,7 +59,7 @@ TEST_F(CrashSafetyTest, PopBailsOutWhenSlotStuckInWriting) {
 
 TEST_F(CrashSafetyTest, PushBailsOutWhenSlotStuckAboveTop) {
     Memory mem("/test_crash_safety", 1024 * 1024);
-    Stack<int> s(mem, "s", 8);
+    Stack<int> s(mem, "s", 8, StackLayout::Compact);
 
     ASSERT_TRUE(s.push(1));
     ASSERT_TRUE(s.push(2));
@@ -83,7 +84,7 @@ TEST_F(CrashSafetyTest, PushBailsOutWhenSlotStuckAboveTop) {
 
 TEST_F(CrashSafetyTest, TopBailsOutWhenSlotStuck) {
     Memory mem("/test_crash_safety", 1024 * 1024);
-    Stack<int> s(mem, "s", 8);
+    Stack<int> s(mem, "s", 8, StackLayout::Compact);
 
     ASSERT_TRUE(s.push(42));
 
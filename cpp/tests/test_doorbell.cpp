@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+#include <zeroipc/memory.h>
+#include <zeroipc/queue.h>
+#include <zeroipc/stream.h>
+#include <zeroipc/doorbell.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <thread>
+#include <vector>
+#include "test_config.h"
+
+using namespace zeroipc;
+using namespace zeroipc::test;
+
+class DoorbellTest : public SharedMemoryTestBase {
+protected:
+    static bool readable(const Doorbell& bell, int timeout_ms = 0) {
+        struct pollfd pfd = {bell.fd(), POLLIN, 0};
+        return ::poll(&pfd, 1, timeout_ms) == 1 && (pfd.revents & POLLIN);
+    }
+};
+
+TEST_F(DoorbellTest, RingsOncePerArmedTransition) {
+    Memory mem(shm_name_, 1024*1024);
+    Queue<int> queue(mem, "bell_queue", 64);
+    Doorbell bell = Doorbell::create();
+    queue.attach_doorbell(&bell);
+
+    EXPECT_FALSE(readable(bell));
+    for (int i = 0; i < 10; i++) {
+        ASSERT_TRUE(queue.push(i));
+    }
+    ASSERT_TRUE(readable(bell));
+
+    // A burst of pushes coalesces into a single ring
+    uint64_t count = 0;
+    ASSERT_EQ(::read(bell.fd(), &count, sizeof(count)), ssize_t(sizeof(count)));
+    EXPECT_EQ(count, 1u);
+
+    // Not re-armed yet: more pushes stay silent
+    ASSERT_TRUE(queue.push(10));
+    EXPECT_FALSE(readable(bell));
+
+    queue.rearm_doorbell();
+    int drained = 0;
+    while (queue.pop()) {
+        drained++;
+    }
+    EXPECT_EQ(drained, 11);
+    EXPECT_FALSE(readable(bell));
+
+    ASSERT_TRUE(queue.push(11));
+    EXPECT_TRUE(readable(bell));
+}
+
+TEST_F(DoorbellTest, EpollAcrossManyQueues) {
+    Memory mem(shm_name_, 4*1024*1024);
+    const int num_queues = 32;
+
+    std::vector<std::unique_ptr<Queue<int>>> queues;
+    std::vector<Doorbell> bells;
+    bells.reserve(num_queues);  // queues hold pointers to the bells
+    int ep = ::epoll_create1(EPOLL_CLOEXEC);
+    ASSERT_GE(ep, 0);
+    for (int i = 0; i < num_queues; i++) {
+        queues.push_back(std::make_unique<Queue<int>>(mem, "q" + std::to_string(i), 16));
+        bells.push_back(Doorbell::create());
+        queues.back()->attach_doorbell(&bells.back());
+    }
+    for (int i = 0; i < num_queues; i++) {
+        struct epoll_event ev = {};
+        ev.events = EPOLLIN;
+        ev.data.u32 = i;
+        ASSERT_EQ(::epoll_ctl(ep, EPOLL_CTL_ADD, bells[i].fd(), &ev), 0);
+    }
+
+    ASSERT_TRUE(queues[3]->push(300));
+    ASSERT_TRUE(queues[17]->push(1700));
+    ASSERT_TRUE(queues[17]->push(1701));
+
+    struct epoll_event events[num_queues];
+    int n = ::epoll_wait(ep, events, num_queues, 1000);
+    ASSERT_EQ(n, 2);
+
+    int sum = 0;
+    for (int e = 0; e < n; e++) {
+        int i = events[e].data.u32;
+        bells[i].drain();
+        queues[i]->rearm_doorbell();
+        while (auto v = queues[i]->pop()) {
+            sum += *v;
+        }
+    }
+    EXPECT_EQ(sum, 300 + 1700 + 1701);
+    EXPECT_EQ(::epoll_wait(ep, events, num_queues, 0), 0);
+    ::close(ep);
+}
+
+TEST_F(DoorbellTest, NoLostRingUnderConcurrency) {
+    Memory mem(shm_name_, 1024*1024);
+    Queue<int> queue(mem, "race_queue", 1024);
+    Doorbell bell = Doorbell::create();
+    queue.attach_doorbell(&bell);
+
+    const int items = 20000;
+    std::thread producer([&] {
+        for (int i = 0; i < items; i++) {
+            queue.push_wait(i);
+        }
+    });
+
+    // Consumer only pops after the fd fires: a lost ring would hang here
+    int received = 0;
+    while (received < items) {
+        ASSERT_TRUE(readable(bell, 5000)) << "doorbell never rang, got " << received;
+        bell.drain();
+        queue.rearm_doorbell();
+        while (queue.pop()) {
+            received++;
+        }
+    }
+    producer.join();
+    EXPECT_EQ(received, items);
+}
+
+TEST_F(DoorbellTest, NamedFifoTransport) {
+    std::string path = "/tmp/zeroipc_bell_" + std::to_string(::getpid());
+    Memory mem(shm_name_, 1024*1024);
+    Queue<int> queue(mem, "fifo_queue", 8);
+
+    Doorbell producer_bell = Doorbell::fifo(path);
+    Doorbell consumer_bell = Doorbell::fifo(path);
+    queue.attach_doorbell(&producer_bell);
+
+    ASSERT_TRUE(queue.push(1));
+    ASSERT_TRUE(queue.push(2));
+    EXPECT_TRUE(readable(consumer_bell));
+    consumer_bell.drain();
+    EXPECT_FALSE(readable(consumer_bell));
+    ::unlink(path.c_str());
+}
+
+TEST_F(DoorbellTest, FdPassingAcrossProcesses) {
+    Memory mem(shm_name_, 1024*1024);
+    Queue<int> queue(mem, "passed_queue", 8);
+    Doorbell bell = Doorbell::create();
+
+    int sv[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, sv), 0);
+
+    pid_t pid = fork();
+    ASSERT_NE(pid, -1);
+    if (pid == 0) {
+        ::close(sv[0]);
+        Memory child_mem(shm_name_);
+        Queue<int> child_queue(child_mem, "passed_queue");
+        Doorbell child_bell = Doorbell::receive(sv[1]);
+        child_queue.attach_doorbell(&child_bell);
+        child_queue.push_wait(99);
+        exit(0);
+    }
+
+    ::close(sv[1]);
+    bell.send(sv[0]);
+    EXPECT_TRUE(readable(bell, 5000));
+    EXPECT_EQ(queue.pop(), 99);
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+    ::close(sv[0]);
+}
+
+TEST_F(DoorbellTest, StreamRingsOnEmit) {
+    Memory mem(shm_name_, 1024*1024);
+    Stream<int> stream(mem, "bell_stream", 64);
+    Doorbell bell = Doorbell::create();
+    stream.attach_doorbell(&bell);
+
+    ASSERT_TRUE(stream.emit(5));
+    ASSERT_TRUE(stream.emit(6));
+    ASSERT_TRUE(readable(bell));
+    bell.drain();
+
+    stream.rearm_doorbell();
+    EXPECT_EQ(stream.next(), 5);
+    EXPECT_EQ(stream.next(), 6);
+    EXPECT_FALSE(readable(bell));
+}
@@ -184,8 +184,8 @@ TEST_F(EdgeCaseTest, ArrayBoundsChecking) {
 // ========== MEMORY EDGE CASES ==========
 
 TEST_F(EdgeCaseTest, MemoryMinimumSize) {
-    // Minimum size to hold table (3104 bytes for 64 entries) plus a small structure
-    size_t min_size = 3200; // Table needs 3104 bytes now with 64-bit fields
+    // Minimum size to hold table (3616 bytes for 64 entries) plus a small structure
+    size_t min_size = 3712; // Table needs 3616 bytes now with per-entry state
     Memory mem("/test_edge", min_size);
     
     // Should be able to create at least one small structure
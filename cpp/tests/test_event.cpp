@@ -2,6 +2,7 @@
 #include <zeroipc/memory.h>
 #include <zeroipc/event.h>
 #include <thread>
+#include <string>
 #include <vector>
 #include <atomic>
 #include <chrono>
@@ -207,6 +208,32 @@ TEST_F(EventTest, OpenExisting) {
     }
 }
 
+TEST_F(EventTest, NameLengthLimits) {
+    zeroipc::Memory mem(shm_name_, 1024 * 1024);
+
+    // Too long for "_sem": rejected before anything is registered
+    std::string too_long(zeroipc::Event::MAX_NAME + 1, 'x');
+    uint32_t entries = mem.table()->entry_count();
+    EXPECT_THROW(zeroipc::Event(mem, too_long), std::invalid_argument);
+    EXPECT_EQ(mem.table()->entry_count(), entries);
+
+    // The longest names work, without a watch list, every time they are used
+    std::string longest(zeroipc::Event::MAX_NAME, 'y');
+    {
+        zeroipc::Event event(mem, longest, zeroipc::EventMode::ManualReset);
+        EXPECT_EQ(event.watch_list(), nullptr);
+        event.signal();
+    }
+    zeroipc::Event reopened(mem, longest);
+    EXPECT_TRUE(reopened.is_signaled());
+    EXPECT_EQ(reopened.watch_list(), nullptr);
+
+    std::string watched(zeroipc::Event::MAX_WATCHED_NAME, 'z');
+    zeroipc::Event event(mem, watched);
+    EXPECT_NE(event.watch_list(), nullptr);
+    EXPECT_NE(mem.table()->find(watched + "_watch"), nullptr);
+}
+
 TEST_F(EventTest, Pulse) {
     zeroipc::Memory mem(shm_name_, 1024 * 1024);
     zeroipc::Event event(mem, "test_event", zeroipc::EventMode::ManualReset);
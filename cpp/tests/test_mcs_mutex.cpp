@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+#include <zeroipc/memory.h>
+#include <zeroipc/mcs_mutex.h>
+#include <zeroipc/array.h>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "test_config.h"
+
+using namespace zeroipc::test;
+
+class MCSMutexTest : public SharedMemoryTestBase {
+};
+
+TEST_F(MCSMutexTest, LockTryLockUnlock) {
+    zeroipc::Memory mem(shm_name_, 1024 * 1024);
+    zeroipc::MCSMutex mtx(mem, "mcs", 16);
+
+    EXPECT_EQ(mtx.nodes(), 16u);
+    EXPECT_FALSE(mtx.is_locked());
+
+    mtx.lock();
+    EXPECT_TRUE(mtx.is_locked());
+    EXPECT_FALSE(mtx.try_lock());
+    mtx.unlock();
+
+    EXPECT_TRUE(mtx.try_lock());
+    mtx.unlock();
+    EXPECT_FALSE(mtx.is_locked());
+
+    {
+        std::lock_guard<zeroipc::MCSMutex> guard(mtx);
+        EXPECT_TRUE(mtx.is_locked());
+    }
+    EXPECT_FALSE(mtx.is_locked());
+}
+
+TEST_F(MCSMutexTest, OpenExisting) {
+    zeroipc::Memory mem(shm_name_, 1024 * 1024);
+    zeroipc::MCSMutex a(mem, "mcs", 8);
+    zeroipc::MCSMutex b(mem, "mcs");
+
+    EXPECT_EQ(b.nodes(), 8u);
+    a.lock();
+    EXPECT_FALSE(b.try_lock());
+    a.unlock();
+    EXPECT_TRUE(b.try_lock());
+    b.unlock();
+
+    EXPECT_THROW(zeroipc::MCSMutex(mem, "mcs", 4), std::runtime_error);
+    EXPECT_THROW(zeroipc::MCSMutex(mem, "other", zeroipc::MCSMutex::MAX_NODES + 1),
+                 std::invalid_argument);
+}
+
+TEST_F(MCSMutexTest, MutualExclusion) {
+    zeroipc::Memory mem(shm_name_, 1024 * 1024);
+    zeroipc::MCSMutex mtx(mem, "mcs");
+    zeroipc::Array<int> counter(mem, "counter", 1);
+    counter[0] = 0;
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < TestTiming::MEDIUM_THREADS; i++) {
+        threads.emplace_back([&]() {
+            for (int j = 0; j < TestTiming::MEDIUM_ITERATIONS; j++) {
+                mtx.lock();
+                counter[0]++;
+                mtx.unlock();
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    EXPECT_EQ(counter[0], TestTiming::MEDIUM_THREADS * TestTiming::MEDIUM_ITERATIONS);
+    EXPECT_FALSE(mtx.is_locked());
+}
+
+TEST_F(MCSMutexTest, MoreThreadsThanNodes) {
+    zeroipc::Memory mem(shm_name_, 1024 * 1024);
+    zeroipc::MCSMutex mtx(mem, "mcs", 2);
+    zeroipc::Array<int> counter(mem, "counter", 1);
+    counter[0] = 0;
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < TestTiming::MEDIUM_THREADS; i++) {
+        threads.emplace_back([&]() {
+            for (int j = 0; j < TestTiming::FAST_ITERATIONS; j++) {
+                std::lock_guard<zeroipc::MCSMutex> guard(mtx);
+                counter[0]++;
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    EXPECT_EQ(counter[0], TestTiming::MEDIUM_THREADS * TestTiming::FAST_ITERATIONS);
+}
+
+TEST_F(MCSMutexTest, HandOffIsFifo) {
+    zeroipc::Memory mem(shm_name_, 1024 * 1024);
+    zeroipc::MCSMutex mtx(mem, "mcs");
+
+    constexpr int WAITERS = 4;
+    std::vector<int> order;
+    std::vector<std::thread> threads;
+
+    mtx.lock();
+    for (int i = 0; i < WAITERS; i++) {
+        threads.emplace_back([&, i]() {
+            mtx.lock();
+            order.push_back(i);
+            mtx.unlock();
+        });
+        // Let waiter i queue up (and park) before the next one starts
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    mtx.unlock();
+
+    for (auto& t : threads) {
+        t.join();
+    }
+    EXPECT_EQ(order, (std::vector<int>{0, 1, 2, 3}));
+}
+
+TEST_F(MCSMutexTest, CrossProcessMutualExclusion) {
+    zeroipc::Memory mem(shm_name_, 1024 * 1024);
+    zeroipc::MCSMutex mtx(mem, "mcs");
+    zeroipc::Array<int> counter(mem, "counter", 1);
+    counter[0] = 0;
+
+    constexpr int PROCESSES = 4;
+    constexpr int ITERATIONS = 2000;
+
+    std::vector<pid_t> children;
+    for (int p = 0; p < PROCESSES; p++) {
+        pid_t pid = fork();
+        ASSERT_NE(pid, -1);
+        if (pid == 0) {
+            zeroipc::Memory child_mem(shm_name_);
+            zeroipc::MCSMutex child_mtx(child_mem, "mcs");
+            zeroipc::Array<int> child_counter(child_mem, "counter");
+            for (int i = 0; i < ITERATIONS; i++) {
+                child_mtx.lock();
+                child_counter[0] = child_counter[0] + 1;
+                child_mtx.unlock();
+            }
+            exit(0);
+        }
+        children.push_back(pid);
+    }
+
+    for (pid_t pid : children) {
+        int status;
+        waitpid(pid, &status, 0);
+        EXPECT_EQ(WEXITSTATUS(status), 0);
+    }
+    EXPECT_EQ(counter[0], PROCESSES * ITERATIONS);
+    EXPECT_FALSE(mtx.is_locked());
+}
@@ -284,11 +284,8 @@ TEST_F(MemoryBoundaryTest, RapidAllocationDeallocation) {
 TEST_F(MemoryBoundaryTest, AlignmentBoundaries) {
     Memory mem("/test_boundary", 10 * 1024 * 1024);
 
-    // The library guarantees 8-byte section alignment. Element types whose
-    // alignment is <= 8 are placed on natural boundaries; over-aligned types
-    // (alignof > 8, e.g. alignas(16)/alignas(64)) are rejected at compile time
-    // by the static_assert(alignof(T) <= MAX_ELEM_ALIGN) in each container, so
-    // they cannot be instantiated here.
+    // Sections are at least 8-aligned, so element types whose alignment is
+    // <= 8 are placed on natural boundaries with the v2 layout.
     struct Aligned8 {
         alignas(8) char data[8];
     };
@@ -306,6 +303,73 @@ TEST_F(MemoryBoundaryTest, AlignmentBoundaries) {
     EXPECT_EQ(reinterpret_cast<uintptr_t>(&arrd[37]) % alignof(double), 0);
 }
 
+TEST_F(MemoryBoundaryTest, OverAlignedElements) {
+    Memory mem("/test_boundary", 10 * 1024 * 1024);
+
+    struct alignas(64) Line {
+        uint64_t value;
+    };
+    struct alignas(4096) Page {
+        char bytes[4096];
+    };
+
+    Array<Line> lines(mem, "lines", 10);
+    Array<Page> pages(mem, "pages", 2);
+    Queue<Line> queue(mem, "line_queue", 8);
+    Stack<Line> stack(mem, "line_stack", 8);
+
+    for (size_t i = 0; i < lines.capacity(); ++i) {
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(&lines[i]) % 64, 0);
+    }
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(&pages[0]) % 4096, 0);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(&pages[1]) % 4096, 0);
+
+    // The alignment is recorded in the table entry
+    EXPECT_EQ(mem.table()->find("lines")->section_align(), 64);
+    EXPECT_EQ(mem.table()->find("pages")->section_align(), 4096);
+    EXPECT_EQ(mem.table()->find("line_queue")->section_align(), 64);
+
+    ASSERT_TRUE(queue.push(Line{42}));
+    auto popped = queue.pop();
+    ASSERT_TRUE(popped.has_value());
+    EXPECT_EQ(popped->value, 42);
+
+    ASSERT_TRUE(stack.push(Line{7}));
+    Stack<Line> reopened(mem, "line_stack");
+    EXPECT_EQ(reopened.pop()->value, 7);
+
+    // Opening with a type of different alignment but the same size is caught
+    struct Plain {
+        uint64_t value;
+        char pad[56];
+    };
+    static_assert(sizeof(Plain) == sizeof(Line));
+    EXPECT_THROW((Queue<Plain>(mem, "line_queue")), std::runtime_error);
+    EXPECT_THROW((Array<Plain>(mem, "lines")), std::runtime_error);
+}
+
+TEST_F(MemoryBoundaryTest, StructureBasesOnOwnCacheLine) {
+    Memory mem("/test_boundary", 1024 * 1024);
+
+    // Small adjacent structures must not share a cache line
+    Array<uint32_t> a(mem, "small_a", 1);
+    Array<uint32_t> b(mem, "small_b", 1);
+    Queue<uint32_t> q(mem, "small_q", 1);
+
+    auto* ea = mem.table()->find("small_a");
+    auto* eb = mem.table()->find("small_b");
+    auto* eq = mem.table()->find("small_q");
+    EXPECT_EQ(ea->offset % CACHE_LINE_SIZE, 0);
+    EXPECT_EQ(eb->offset % CACHE_LINE_SIZE, 0);
+    EXPECT_EQ(eq->offset % CACHE_LINE_SIZE, 0);
+    EXPECT_NE(ea->offset / CACHE_LINE_SIZE, eb->offset / CACHE_LINE_SIZE);
+    EXPECT_EQ(ea->section_align(), MIN_SECTION_ALIGN);
+
+    // Invalid alignments are rejected
+    EXPECT_THROW(mem.allocate("bad_align", 64, 24), std::invalid_argument);
+    EXPECT_THROW(mem.allocate("huge_align", 64, 8192), std::invalid_argument);
+}
+
 // ========== CONCURRENT BOUNDARY TESTS ==========
 
 TEST_F(MemoryBoundaryTest, ConcurrentNearCapacity) {
@@ -398,7 +462,7 @@ namespace {
 template<typename T>
 void expect_queue_section_layout(Memory& mem, const std::string& name,
                                  size_t cap) {
-    Queue<T> q(mem, name, cap);
+    Queue<T> q(mem, name, cap, QueueLayout::Split);
 
     // The queue rounds the requested capacity up to a power of two
     // (wrap-safety); the layout is computed from the actual capacity.
@@ -411,7 +475,10 @@ void expect_queue_section_layout(Memory& mem, const std::string& name,
 
     // Spec formula, independent of the implementation's internal pointers
     const size_t side_off = 16 + align_up(sizeof(T) * actual_cap, 8);
-    EXPECT_EQ(size, side_off + actual_cap * sizeof(uint32_t))
+    // C++ creators append the 24-byte wait/doorbell words and the 64-byte
+    // WaitSet watch list, 8-aligned
+    const size_t wait_off = align_up(side_off + actual_cap * sizeof(uint32_t), 8);
+    EXPECT_EQ(size, wait_off + 88)
         << "table entry size wrong for elem_size " << sizeof(T);
 
     // Vyukov invariant: seq[i] == i immediately after creation. Finding
@@ -428,13 +495,15 @@ void expect_queue_section_layout(Memory& mem, const std::string& name,
 template<typename T>
 void expect_stack_section_layout(Memory& mem, const std::string& name,
                                  size_t cap) {
-    Stack<T> s(mem, name, cap);
+    Stack<T> s(mem, name, cap, StackLayout::Compact);
 
     size_t offset = 0, size = 0;
     ASSERT_TRUE(mem.find(name, offset, size));
 
     const size_t side_off = 16 + align_up(sizeof(T) * cap, 8);
-    EXPECT_EQ(size, side_off + cap * sizeof(uint32_t))
+    // C++ creators append the cache-line-aligned elimination slots
+    EXPECT_EQ(size, align_up(side_off + cap * sizeof(uint32_t), CACHE_LINE_SIZE)
+                    + Stack<T>::ELIM_SLOTS * CACHE_LINE_SIZE)
         << "table entry size wrong for elem_size " << sizeof(T);
 
     ASSERT_TRUE(s.push(static_cast<T>(1)));
@@ -252,3 +252,101 @@ TEST_F(MonitorTest, SpuriousWakeupHandling) {
     // Should have checked multiple times (handling spurious wakeups)
     EXPECT_GE(checks.load(), 10);
 }
+
+TEST_F(MonitorTest, NotifyAllRequeuesEveryWaiter) {
+    zeroipc::Memory mem(shm_name_, 1024 * 1024);
+    zeroipc::Monitor mon(mem, "test_mon");
+    zeroipc::Array<int> state(mem, "state", 2);  // [go, inside]
+    state[0] = 0;
+    state[1] = 0;
+
+    constexpr int WAITERS = 8;
+    std::atomic<int> woken{0};
+    std::atomic<bool> overlap{false};
+
+    std::vector<std::thread> waiters;
+    for (int i = 0; i < WAITERS; i++) {
+        waiters.emplace_back([&]() {
+            mon.lock();
+            mon.wait([&]() { return state[0] == 1; });
+            // Every waiter must come back holding the lock, alone
+            if (++state[1] != 1) overlap = true;
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            --state[1];
+            woken++;
+            mon.unlock();
+        });
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    mon.lock();
+    state[0] = 1;
+    mon.notify_all();
+    mon.unlock();
+
+    for (auto& t : waiters) {
+        t.join();
+    }
+    EXPECT_EQ(woken.load(), WAITERS);
+    EXPECT_FALSE(overlap.load());
+}
+
+TEST_F(MonitorTest, NotifyAllWithoutLockHeld) {
+    zeroipc::Memory mem(shm_name_, 1024 * 1024);
+    zeroipc::Monitor mon(mem, "test_mon");
+    std::atomic<int> go{0};
+    std::atomic<int> woken{0};
+
+    std::vector<std::thread> waiters;
+    for (int i = 0; i < 4; i++) {
+        waiters.emplace_back([&]() {
+            mon.lock();
+            mon.wait([&]() { return go.load() == 1; });
+            woken++;
+            mon.unlock();
+        });
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    go = 1;
+    mon.notify_all();
+
+    for (auto& t : waiters) {
+        t.join();
+    }
+    EXPECT_EQ(woken.load(), 4);
+}
+
+TEST_F(MonitorTest, PingPongLosesNoWakeups) {
+    zeroipc::Memory mem(shm_name_, 1024 * 1024);
+    zeroipc::Monitor mon(mem, "test_mon");
+    zeroipc::Array<int> turn(mem, "turn", 1);
+    turn[0] = 0;
+
+    constexpr int ROUNDS = 2000;
+
+    // Two threads take strict turns; a lost notify would hang one of them
+    auto player = [&](int me) {
+        for (int i = 0; i < ROUNDS; i++) {
+            mon.lock();
+            mon.wait([&]() { return turn[0] == me; });
+            turn[0] = 1 - me;
+            mon.notify_one();
+            mon.unlock();
+        }
+    };
+
+    std::thread a(player, 0);
+    std::thread b(player, 1);
+    a.join();
+    b.join();
+    EXPECT_EQ(turn[0], 0);
+}
+
+TEST_F(MonitorTest, RejectsForeignEntry) {
+    zeroipc::Memory mem(shm_name_, 1024 * 1024);
+    mem.allocate("test_mon", 1);  // e.g. the old 1-byte marker layout
+
+    EXPECT_THROW(zeroipc::Monitor(mem, "test_mon"), std::runtime_error);
+}
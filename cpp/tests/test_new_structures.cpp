@@ -158,6 +158,33 @@ TEST_F(NewStructuresTest, PoolConstruct) {
     EXPECT_EQ(pool.allocated(), 0);
 }
 
+TEST_F(NewStructuresTest, PoolBatchedAllocate) {
+    Memory mem(shm_name_, 1024 * 1024);
+    Pool<int> pool(mem, "batch_pool", 10);
+
+    int* ptrs[16];
+    EXPECT_EQ(pool.allocate_n(ptrs, 6), 6);
+    EXPECT_EQ(pool.allocate_n(ptrs + 6, 10), 4);  // Only 4 left
+    EXPECT_TRUE(pool.full());
+    EXPECT_EQ(pool.allocate_n(ptrs, 1), 0);
+
+    for (int i = 0; i < 10; i++) {
+        *ptrs[i] = i;
+        for (int j = 0; j < i; j++) {
+            ASSERT_NE(ptrs[i], ptrs[j]);
+        }
+    }
+
+    pool.deallocate_n(ptrs, 7);
+    EXPECT_EQ(pool.allocated(), 3);
+    pool.deallocate(ptrs[7]);
+    pool.deallocate_n(ptrs + 8, 2);
+    EXPECT_TRUE(pool.empty());
+
+    // The spliced chains are intact: every node comes back out
+    EXPECT_EQ(pool.allocate_n(ptrs, 16), 10);
+}
+
 // Ring Buffer Tests
 TEST_F(NewStructuresTest, RingBasicOperations) {
     Memory mem(shm_name_, 1024 * 1024);
@@ -323,6 +350,37 @@ TEST_F(NewStructuresTest, PoolConcurrentAllocate) {
     EXPECT_EQ(pool.allocated(), 0);
 }
 
+TEST_F(NewStructuresTest, PoolConcurrentBatches) {
+    Memory mem(shm_name_, 10 * 1024 * 1024);
+    Pool<int> pool(mem, "batch_concurrent_pool", 64);
+
+    const int num_threads = 4;
+    std::atomic<bool> corrupted{false};
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&, t]() {
+            int* ptrs[8];
+            for (int r = 0; r < 5000; ++r) {
+                size_t n = pool.allocate_n(ptrs, 1 + (r + t) % 8);
+                for (size_t i = 0; i < n; ++i) *ptrs[i] = t;
+                for (size_t i = 0; i < n; ++i) {
+                    if (*ptrs[i] != t) corrupted = true;  // Handed out twice
+                }
+                pool.deallocate_n(ptrs, n);
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    EXPECT_FALSE(corrupted.load());
+    EXPECT_TRUE(pool.empty());
+    int* ptrs[64];
+    EXPECT_EQ(pool.allocate_n(ptrs, 64), 64);
+}
+
 // Race condition regression tests
 
 // Test: concurrent insert + find should never read uninitialized key/value
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include <zeroipc/memory.h>
+#include <zeroipc/pool.h>
+#include <zeroipc/pool_cache.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "test_config.h"
+
+using namespace zeroipc;
+using namespace zeroipc::test;
+
+class PoolCacheTest : public SharedMemoryTestBase {
+};
+
+TEST_F(PoolCacheTest, RefillsAndFlushesInBatches) {
+    Memory mem(shm_name_, 1024*1024);
+    Pool<int> pool(mem, "pool", 100);
+    {
+        PoolCache<int> cache(pool, 8);
+
+        auto p = cache.allocate();
+        ASSERT_TRUE(p.has_value());
+        EXPECT_EQ(pool.allocated(), 4u);  // Refilled half a magazine
+        EXPECT_EQ(cache.cached(), 3u);
+
+        std::vector<int*> held{*p};
+        for (int i = 0; i < 19; i++) {
+            held.push_back(*cache.allocate());
+        }
+        for (int* ptr : held) {
+            cache.deallocate(ptr);
+        }
+        EXPECT_LE(cache.cached(), 8u);
+        EXPECT_EQ(pool.allocated(), cache.cached());
+    }
+    EXPECT_TRUE(pool.empty());  // Destructor flushed
+}
+
+TEST_F(PoolCacheTest, ExhaustsPoolThroughCache) {
+    Memory mem(shm_name_, 1024*1024);
+    Pool<int> pool(mem, "small", 10);
+    PoolCache<int> cache(pool, 4);
+
+    std::vector<int*> held;
+    while (auto p = cache.allocate()) {
+        held.push_back(*p);
+    }
+    EXPECT_EQ(held.size(), 10u);
+    EXPECT_TRUE(pool.full());
+
+    for (int* ptr : held) {
+        cache.deallocate(ptr);
+    }
+    cache.flush();
+    EXPECT_TRUE(pool.empty());
+}
+
+TEST_F(PoolCacheTest, ConcurrentCachesShareOnePool) {
+    Memory mem(shm_name_, 4*1024*1024);
+    Pool<int> pool(mem, "shared", 1024);
+
+    const int num_threads = 4;
+    std::atomic<bool> corrupted{false};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; t++) {
+        threads.emplace_back([&, t]() {
+            PoolCache<int> cache(pool, 32);
+            std::vector<int*> held;
+            for (int r = 0; r < 20000; r++) {
+                if (held.size() < 50 && (r % 3 != 2)) {
+                    if (auto p = cache.allocate()) {
+                        **p = t;
+                        held.push_back(*p);
+                    }
+                } else if (!held.empty()) {
+                    if (*held.back() != t) corrupted = true;
+                    cache.deallocate(held.back());
+                    held.pop_back();
+                }
+            }
+            for (int* ptr : held) {
+                cache.deallocate(ptr);
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    EXPECT_FALSE(corrupted.load());
+    EXPECT_TRUE(pool.empty());
+}
+
+TEST_F(PoolCacheTest, OwnerRecordsOnlyWhenTracked) {
+    Memory mem(shm_name_, 1024*1024);
+    Pool<int> plain(mem, "plain", 16);
+    Pool<int> tracked(mem, "tracked", 16, PoolLayout::PaddedHead, true);
+    EXPECT_FALSE(plain.tracks_owners());
+    EXPECT_TRUE(tracked.tracks_owners());
+    EXPECT_TRUE(Pool<int>(mem, "tracked").tracks_owners());
+    EXPECT_FALSE(Pool<int>(mem, "plain").tracks_owners());
+
+    // A live owner's magazine is left alone
+    PoolCache<int> cache(tracked, 8);
+    ASSERT_TRUE(cache.allocate().has_value());
+    EXPECT_EQ(tracked.reclaim_dead(), 0u);
+    EXPECT_EQ(tracked.allocated(), 4u);
+}
+
+TEST_F(PoolCacheTest, ReclaimsCrashedProcessMagazine) {
+    Memory mem(shm_name_, 1024*1024);
+    Pool<int> pool(mem, "crash", 64, PoolLayout::PaddedHead, true);
+
+    pid_t pid = fork();
+    ASSERT_NE(pid, -1);
+    if (pid == 0) {
+        Memory child_mem(shm_name_);
+        Pool<int> child_pool(child_mem, "crash");
+        auto* cache = new PoolCache<int>(child_pool, 16);  // Never flushed
+        auto p = cache->allocate();  // Held by the "application"
+        auto q = cache->allocate();
+        if (!p || !q) _exit(1);
+        cache->deallocate(*q);
+        _exit(0);  // Crash: 7 nodes cached, 1 in use
+    }
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+    ASSERT_EQ(WEXITSTATUS(status), 0);
+    EXPECT_EQ(pool.allocated(), 8u);
+
+    EXPECT_EQ(pool.reclaim_dead(), 7u);
+    EXPECT_EQ(pool.allocated(), 1u);  // The node handed out stays allocated
+    EXPECT_EQ(pool.reclaim_dead(), 0u);
+}
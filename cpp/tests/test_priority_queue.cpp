@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+#include <zeroipc/memory.h>
+#include <zeroipc/priority_queue.h>
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "test_config.h"
+
+using namespace zeroipc;
+using namespace zeroipc::test;
+
+class PriorityQueueTest : public SharedMemoryTestBase {
+};
+
+TEST_F(PriorityQueueTest, SingleShardPopsInKeyOrder) {
+    Memory mem(shm_name_, 1024*1024);
+    PriorityQueue<int> pq(mem, "jobs", 256);
+
+    EXPECT_TRUE(pq.empty());
+    EXPECT_FALSE(pq.pop_min().has_value());
+    EXPECT_FALSE(pq.top_key().has_value());
+
+    std::mt19937 rng(42);
+    std::vector<uint64_t> keys;
+    for (int i = 0; i < 200; i++) {
+        keys.push_back(rng() % 1000);
+        ASSERT_TRUE(pq.push(keys.back(), i));
+    }
+    EXPECT_EQ(pq.size(), 200u);
+    std::sort(keys.begin(), keys.end());
+    EXPECT_EQ(pq.top_key(), keys.front());
+
+    for (uint64_t expected : keys) {
+        auto item = pq.pop_min();
+        ASSERT_TRUE(item.has_value());
+        EXPECT_EQ(item->key, expected);
+    }
+    EXPECT_TRUE(pq.empty());
+}
+
+TEST_F(PriorityQueueTest, ShardedIsExactWhenQuiescent) {
+    Memory mem(shm_name_, 1024*1024);
+    PriorityQueue<int, double> pq(mem, "deadlines", 512, 8);
+    EXPECT_EQ(pq.shards(), 8u);
+    EXPECT_EQ(pq.capacity(), 512u);
+
+    for (int i = 0; i < 300; i++) {
+        ASSERT_TRUE(pq.push((i * 7919) % 300 + 0.5, i));
+    }
+    double last = -1;
+    for (int i = 0; i < 300; i++) {
+        auto item = pq.pop_min();
+        ASSERT_TRUE(item.has_value());
+        EXPECT_GT(item->key, last);
+        last = item->key;
+    }
+    EXPECT_FALSE(pq.pop_min().has_value());
+}
+
+TEST_F(PriorityQueueTest, PopBulkReturnsSortedBatch) {
+    Memory mem(shm_name_, 1024*1024);
+    PriorityQueue<int> pq(mem, "bulk", 256, 4);
+
+    for (int i = 99; i >= 0; i--) {
+        ASSERT_TRUE(pq.push(i, i * 10));
+    }
+    PriorityQueue<int>::Item out[64];
+    size_t n = pq.pop_bulk(out, 64);
+    ASSERT_EQ(n, 64u);
+    for (size_t i = 0; i < n; i++) {
+        EXPECT_EQ(out[i].key, i);
+        EXPECT_EQ(out[i].value, int(i) * 10);
+    }
+    EXPECT_EQ(pq.pop_bulk(out, 64), 36u);
+    EXPECT_EQ(pq.pop_bulk(out, 64), 0u);
+}
+
+TEST_F(PriorityQueueTest, FullShardsSpillThenFail) {
+    Memory mem(shm_name_, 1024*1024);
+    PriorityQueue<int> pq(mem, "small", 8, 4);  // 4 shards x 2 items
+
+    for (int i = 0; i < 8; i++) {
+        ASSERT_TRUE(pq.push(i, i)) << "push " << i << " should spill to a free shard";
+    }
+    EXPECT_FALSE(pq.push(8, 8));
+
+    int count = 0;
+    while (pq.pop_relaxed()) {
+        count++;
+    }
+    EXPECT_EQ(count, 8);
+}
+
+TEST_F(PriorityQueueTest, OpenExisting) {
+    Memory mem(shm_name_, 1024*1024);
+    PriorityQueue<double, uint32_t> creator(mem, "shared", 64, 2);
+    ASSERT_TRUE(creator.push(5, 2.5));
+    ASSERT_TRUE(creator.push(1, 1.5));
+
+    PriorityQueue<double, uint32_t> opened(mem, "shared");
+    EXPECT_EQ(opened.shards(), 2u);
+    auto item = opened.pop_min();
+    ASSERT_TRUE(item.has_value());
+    EXPECT_EQ(item->key, 1u);
+    EXPECT_EQ(item->value, 1.5);
+
+    using WrongKey = PriorityQueue<double, uint64_t>;
+    EXPECT_THROW(WrongKey(mem, "shared"), std::runtime_error);
+    EXPECT_THROW(WrongKey(mem, "missing"), std::runtime_error);
+    EXPECT_THROW(WrongKey(mem, "bad", 8, 0), std::invalid_argument);
+}
+
+TEST_F(PriorityQueueTest, ConcurrentProducersConsumers) {
+    Memory mem(shm_name_, 4*1024*1024);
+    PriorityQueue<int> pq(mem, "mpmc", 4096, 8);
+
+    const int producers = 4;
+    const int consumers = 4;
+    const int per_producer = 5000;
+    const long expected = long(producers) * per_producer;
+
+    std::atomic<long> consumed{0};
+    std::atomic<long> sum{0};
+    std::vector<std::thread> threads;
+
+    for (int p = 0; p < producers; p++) {
+        threads.emplace_back([&, p] {
+            for (int i = 1; i <= per_producer; i++) {
+                while (!pq.push(uint64_t(i) * producers + p, i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (int c = 0; c < consumers; c++) {
+        threads.emplace_back([&, c] {
+            PriorityQueue<int>::Item batch[16];
+            while (consumed.load() < expected) {
+                size_t n = 0;
+                if (c % 2 == 0) {
+                    n = pq.pop_bulk(batch, 16);
+                } else if (auto item = pq.pop_relaxed()) {
+                    batch[0] = *item;
+                    n = 1;
+                }
+                for (size_t i = 0; i < n; i++) {
+                    sum += batch[i].value;
+                }
+                consumed += n;
+                if (n == 0) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    EXPECT_EQ(consumed.load(), expected);
+    EXPECT_EQ(sum.load(), long(producers) * per_producer * (per_producer + 1) / 2);
+    EXPECT_TRUE(pq.empty());
+}
+
+TEST_F(PriorityQueueTest, AcrossProcesses) {
+    Memory mem(shm_name_, 1024*1024);
+    PriorityQueue<int> pq(mem, "xproc", 128, 2);
+
+    pid_t pid = fork();
+    ASSERT_NE(pid, -1);
+    if (pid == 0) {
+        Memory child_mem(shm_name_);
+        PriorityQueue<int> child_pq(child_mem, "xproc");
+        for (int i = 50; i > 0; i--) {
+            if (!child_pq.push(i, -i)) {
+                exit(1);
+            }
+        }
+        exit(0);
+    }
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+    ASSERT_EQ(WEXITSTATUS(status), 0);
+
+    for (int i = 1; i <= 50; i++) {
+        auto item = pq.pop_min();
+        ASSERT_TRUE(item.has_value());
+        EXPECT_EQ(item->key, uint64_t(i));
+        EXPECT_EQ(item->value, -i);
+    }
+}
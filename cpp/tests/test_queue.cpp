@@ -4,6 +4,9 @@
 #include <thread>
 #include <vector>
 #include <atomic>
+#include <chrono>
+#include <sys/wait.h>
+#include <unistd.h>
 #include "test_config.h"
 
 using namespace zeroipc;
@@ -88,7 +91,7 @@ TEST_F(QueueTest, CapacityRoundsUpToPowerOfTwo) {
 TEST_F(QueueTest, WraparoundAt2To32) {
     Memory mem(shm_name_, 1024*1024);
     constexpr uint32_t CAP = 8;
-    Queue<uint32_t> queue(mem, "wrap32_queue", CAP);
+    Queue<uint32_t> queue(mem, "wrap32_queue", CAP, QueueLayout::Split);  // Compact header
     ASSERT_EQ(queue.capacity(), CAP);
 
     size_t offset = 0, size = 0;
@@ -258,4 +261,241 @@ TEST_F(QueueTest, MultipleProducersConsumers) {
     EXPECT_EQ(total_produced.load(), num_producers * items_per_producer);
     EXPECT_EQ(total_consumed.load(), num_producers * items_per_producer);
     EXPECT_TRUE(queue.empty());
-}
\ No newline at end of file
+}
+
+TEST_F(QueueTest, InterleavedLayoutsKeepSeqBesideData) {
+    Memory mem(shm_name_, 1024*1024);
+    Queue<int> inter(mem, "inter", 8, QueueLayout::Interleaved);
+    Queue<int> padded(mem, "padded", 8, QueueLayout::InterleavedPadded);
+
+    // Slot = {int, seq}: 8 bytes interleaved, one cache line padded
+    using Q = Queue<int>;
+    auto g = Q::geometry(8, static_cast<uint32_t>(QueueLayout::Interleaved));
+    EXPECT_EQ(g.data_stride, 8u);
+    EXPECT_EQ(g.seq_off, g.data_off + 4);
+    auto gp = Q::geometry(8, static_cast<uint32_t>(QueueLayout::InterleavedPadded));
+    EXPECT_EQ(gp.data_off, CACHE_LINE_SIZE);
+    EXPECT_EQ(gp.data_stride, CACHE_LINE_SIZE);
+
+    size_t offset = 0, size = 0;
+    ASSERT_TRUE(mem.find("padded", offset, size));
+    auto* header = mem.ptr_at<Q::Header>(offset);
+    EXPECT_EQ(header->elem_size,
+              sizeof(int) | static_cast<uint32_t>(QueueLayout::InterleavedPadded));
+
+    for (int i = 0; i < 8; i++) {
+        ASSERT_TRUE(inter.push(i));
+        ASSERT_TRUE(padded.push(i * 10));
+    }
+    EXPECT_FALSE(inter.push(8));
+
+    // A second handle learns the layout from the header
+    Queue<int> inter2(mem, "inter");
+    Queue<int> padded2(mem, "padded");
+    for (int i = 0; i < 8; i++) {
+        EXPECT_EQ(inter2.pop(), i);
+        EXPECT_EQ(padded2.pop(), i * 10);
+    }
+    EXPECT_TRUE(inter.empty());
+    EXPECT_TRUE(padded.empty());
+
+    EXPECT_THROW(Queue<short>(mem, "inter"), std::runtime_error);
+}
+
+TEST_F(QueueTest, InterleavedMultipleProducersConsumers) {
+    Memory mem(shm_name_, 10*1024*1024);
+    Queue<int64_t> queue(mem, "inter_mpmc", 256, QueueLayout::InterleavedPadded);
+
+    const int producers = 4;
+    const int per_producer = 5000;
+    const int64_t expected = int64_t(producers) * per_producer;
+    std::atomic<int64_t> consumed{0};
+    std::atomic<int64_t> sum{0};
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; p++) {
+        threads.emplace_back([&] {
+            for (int i = 1; i <= per_producer; i++) {
+                queue.push_wait(i);
+            }
+        });
+    }
+    for (int c = 0; c < 2; c++) {
+        threads.emplace_back([&] {
+            while (consumed.load() < expected) {
+                if (auto v = queue.pop_for(std::chrono::milliseconds(1))) {
+                    sum += *v;
+                    consumed++;
+                }
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    EXPECT_EQ(consumed.load(), expected);
+    EXPECT_EQ(sum.load(), int64_t(producers) * per_producer * (per_producer + 1) / 2);
+}
+
+TEST_F(QueueTest, PaddedHeaderByDefault) {
+    Memory mem(shm_name_, 1024*1024);
+    Queue<int> queue(mem, "default_q", 8);
+    ASSERT_TRUE(queue.push(3));
+
+    size_t offset = 0, size = 0;
+    ASSERT_TRUE(mem.find("default_q", offset, size));
+    auto* header = mem.ptr_at<Queue<int>::Header>(offset);
+    EXPECT_EQ(header->elem_size,
+              sizeof(int) | static_cast<uint32_t>(QueueLayout::PaddedHeader));
+    auto* tail = mem.ptr_at<std::atomic<uint32_t>>(offset + QUEUE_PADDED_TAIL_OFFSET);
+    EXPECT_EQ(tail->load(), 1u);
+
+    Queue<int> reopened(mem, "default_q");
+    EXPECT_EQ(reopened.pop(), 3);
+}
+
+TEST_F(QueueTest, PaddedHeaderPutsCountersOnTheirOwnLines) {
+    Memory mem(shm_name_, 10*1024*1024);
+    Queue<int64_t> queue(mem, "hdr_mpmc", 256, QueueLayout::Split | QueueLayout::PaddedHeader);
+
+    using Q = Queue<int64_t>;
+    const uint32_t flags = static_cast<uint32_t>(QueueLayout::PaddedHeader);
+    EXPECT_EQ(Q::geometry(256, flags).data_off, QUEUE_PADDED_HEADER_SIZE);
+    auto gi = Q::geometry(8, flags | static_cast<uint32_t>(QueueLayout::InterleavedPadded));
+    EXPECT_EQ(gi.data_off, QUEUE_PADDED_HEADER_SIZE);
+    EXPECT_EQ(gi.data_stride, CACHE_LINE_SIZE);
+
+    ASSERT_TRUE(queue.push(7));
+    size_t offset = 0, size = 0;
+    ASSERT_TRUE(mem.find("hdr_mpmc", offset, size));
+    auto* header = mem.ptr_at<Q::Header>(offset);
+    auto* tail = mem.ptr_at<std::atomic<uint32_t>>(offset + QUEUE_PADDED_TAIL_OFFSET);
+    EXPECT_EQ(tail->load(), 1u);
+    EXPECT_EQ(header->tail.load(), 0u);
+    EXPECT_EQ(queue.pop(), 7);
+
+    const int producers = 4;
+    const int per_producer = 5000;
+    const int64_t expected = int64_t(producers) * per_producer;
+    std::atomic<int64_t> consumed{0};
+    std::atomic<int64_t> sum{0};
+
+    // A second handle decodes the flag and shares the same counters
+    Queue<int64_t> other(mem, "hdr_mpmc");
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; p++) {
+        threads.emplace_back([&] {
+            for (int i = 1; i <= per_producer; i++) {
+                queue.push_wait(i);
+            }
+        });
+    }
+    for (int c = 0; c < 2; c++) {
+        threads.emplace_back([&] {
+            while (consumed.load() < expected) {
+                if (auto v = other.pop_for(std::chrono::milliseconds(1))) {
+                    sum += *v;
+                    consumed++;
+                }
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    EXPECT_EQ(consumed.load(), expected);
+    EXPECT_EQ(sum.load(), int64_t(producers) * per_producer * (per_producer + 1) / 2);
+    EXPECT_TRUE(other.empty());
+}
+
+TEST_F(QueueTest, PopForTimesOutWhenEmpty) {
+    Memory mem(shm_name_, 1024*1024);
+    Queue<int> queue(mem, "timeout_queue", 4);
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(queue.pop_for(std::chrono::milliseconds(30)).has_value());
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(30));
+
+    for (int i = 0; i < 4; i++) {
+        ASSERT_TRUE(queue.push(i));
+    }
+    EXPECT_FALSE(queue.push_for(99, std::chrono::milliseconds(10)));
+    EXPECT_EQ(queue.pop_for(std::chrono::milliseconds(10)), 0);
+}
+
+TEST_F(QueueTest, BlockingProducerConsumer) {
+    Memory mem(shm_name_, 1024*1024);
+    Queue<int> queue(mem, "blocking_queue", 2);
+
+    const int num_threads = 3;
+    const int items = 2000;
+    std::atomic<long> sum{0};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; t++) {
+        threads.emplace_back([&, t] {
+            for (int i = 1; i <= items; i++) {
+                queue.push_wait(i);
+            }
+        });
+        threads.emplace_back([&] {
+            for (int i = 0; i < items; i++) {
+                sum += queue.pop_wait();
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+
+    EXPECT_EQ(sum.load(), long(num_threads) * items * (items + 1) / 2);
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST_F(QueueTest, PopWaitWokenThroughOtherHandle) {
+    Memory mem(shm_name_, 1024*1024);
+    Queue<int> consumer_side(mem, "wake_queue", 8);
+    Queue<int> producer_side(mem, "wake_queue");
+
+    std::thread producer([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        ASSERT_TRUE(producer_side.push(42));
+    });
+    auto val = consumer_side.pop_for(std::chrono::seconds(5));
+    producer.join();
+    EXPECT_EQ(val, 42);
+}
+
+TEST_F(QueueTest, StopPredicateEndsWait) {
+    Memory mem(shm_name_, 1024*1024);
+    Queue<int> queue(mem, "stop_queue", 4);
+    std::atomic<bool> stop{false};
+
+    std::thread stopper([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        stop = true;
+        queue.notify_all();
+    });
+    auto start = std::chrono::steady_clock::now();
+    auto val = queue.pop_for(std::chrono::seconds(5), [&] { return stop.load(); });
+    stopper.join();
+    EXPECT_FALSE(val.has_value());
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+}
+
+TEST_F(QueueTest, PopWaitAcrossProcesses) {
+    Memory mem(shm_name_, 1024*1024);
+    Queue<int> queue(mem, "proc_queue", 8);
+
+    pid_t pid = fork();
+    ASSERT_NE(pid, -1);
+    if (pid == 0) {
+        Memory child_mem(shm_name_);
+        Queue<int> child_queue(child_mem, "proc_queue");
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        child_queue.push_wait(7);
+        _exit(0);
+    }
+
+    auto val = queue.pop_for(std::chrono::seconds(5));
+    int status = 0;
+    waitpid(pid, &status, 0);
+    EXPECT_EQ(val, 7);
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+}
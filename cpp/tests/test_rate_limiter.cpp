@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include <zeroipc/memory.h>
+#include <zeroipc/rate_limiter.h>
+#include <zeroipc/array.h>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "test_config.h"
+
+using namespace zeroipc::test;
+using namespace std::chrono_literals;
+
+class RateLimiterTest : public SharedMemoryTestBase {
+};
+
+TEST_F(RateLimiterTest, CreateAndOpen) {
+    zeroipc::Memory mem(shm_name_, 1024 * 1024);
+    zeroipc::RateLimiter limiter(mem, "limiter", 250.0, 20);
+
+    EXPECT_NEAR(limiter.rate(), 250.0, 1e-6);
+    EXPECT_EQ(limiter.burst(), 20u);
+    EXPECT_EQ(limiter.available(), 20u);
+
+    zeroipc::RateLimiter opened(mem, "limiter");
+    EXPECT_EQ(opened.burst(), 20u);
+    EXPECT_TRUE(opened.try_acquire(5));
+    EXPECT_EQ(limiter.available(), 15u);
+
+    EXPECT_THROW(zeroipc::RateLimiter(mem, "missing"), std::runtime_error);
+    EXPECT_THROW(zeroipc::RateLimiter(mem, "bad", 0.0, 1), std::invalid_argument);
+    EXPECT_THROW(zeroipc::RateLimiter(mem, "bad", -1.0, 1), std::invalid_argument);
+    EXPECT_THROW(zeroipc::RateLimiter(mem, "bad", 10.0, 0), std::invalid_argument);
+    EXPECT_THROW(zeroipc::RateLimiter(mem, "bad", 1e-9, 1000), std::invalid_argument);
+}
+
+TEST_F(RateLimiterTest, BurstThenEmpty) {
+    zeroipc::Memory mem(shm_name_, 1024 * 1024);
+    zeroipc::RateLimiter limiter(mem, "limiter", 1.0, 5);
+
+    for (int i = 0; i < 5; i++) {
+        EXPECT_TRUE(limiter.try_acquire());
+    }
+    EXPECT_FALSE(limiter.try_acquire());
+    EXPECT_EQ(limiter.available(), 0u);
+
+    auto wait = limiter.wait_time();
+    EXPECT_GT(wait, 900ms);
+    EXPECT_LE(wait, 1000ms);
+    EXPECT_GT(limiter.wait_time(3), 2900ms);
+
+    // More than the bucket holds can never be granted
+    EXPECT_FALSE(limiter.try_acquire(6));
+    EXPECT_EQ(limiter.wait_time(6), std::chrono::nanoseconds::max());
+}
+
+TEST_F(RateLimiterTest, MultiTokenAcquire) {
+    zeroipc::Memory mem(shm_name_, 1024 * 1024);
+    zeroipc::RateLimiter limiter(mem, "limiter", 1.0, 10);
+
+    EXPECT_EQ(limiter.wait_time(4), 0ns);
+    EXPECT_TRUE(limiter.try_acquire(4));
+    EXPECT_TRUE(limiter.try_acquire(4));
+    EXPECT_FALSE(limiter.try_acquire(4));  // Only 2 left, takes nothing
+    EXPECT_EQ(limiter.available(), 2u);
+    EXPECT_TRUE(limiter.try_acquire(2));
+    EXPECT_TRUE(limiter.try_acquire(0));
+}
+
+TEST_F(RateLimiterTest, RefillsFromTheClock) {
+    zeroipc::Memory mem(shm_name_, 1024 * 1024);
+    zeroipc::RateLimiter limiter(mem, "limiter", 100.0, 10);
+
+    EXPECT_TRUE(limiter.try_acquire(10));
+    EXPECT_FALSE(limiter.try_acquire());
+
+    std::this_thread::sleep_for(limiter.wait_time(5));
+    EXPECT_GE(limiter.available(), 5u);
+    EXPECT_TRUE(limiter.try_acquire(5));
+
+    // Never refills past the burst
+    std::this_thread::sleep_for(200ms);
+    EXPECT_EQ(limiter.available(), 10u);
+}
+
+TEST_F(RateLimiterTest, ConcurrentCallersStayWithinRate) {
+    zeroipc::Memory mem(shm_name_, 1024 * 1024);
+    constexpr double RATE = 10000.0;
+    constexpr uint64_t BURST = 100;
+    zeroipc::RateLimiter limiter(mem, "limiter", RATE, BURST);
+
+    std::atomic<uint64_t> granted{0};
+    std::atomic<bool> stop{false};
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < TestTiming::MEDIUM_THREADS; i++) {
+        threads.emplace_back([&]() {
+            while (!stop.load(std::memory_order_relaxed)) {
+                if (limiter.try_acquire()) {
+                    granted.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+    std::this_thread::sleep_for(200ms);
+    stop = true;
+    for (auto& t : threads) {
+        t.join();
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Never more than the burst plus what accrued, and callers spinning the
+    // whole time should get nearly all of it
+    EXPECT_LE(granted.load(), BURST + static_cast<uint64_t>(RATE * elapsed) + 1);
+    EXPECT_GE(granted.load(), BURST + static_cast<uint64_t>(RATE * 0.2 * 0.9));
+}
+
+TEST_F(RateLimiterTest, CrossProcessCallersShareTheBucket) {
+    zeroipc::Memory mem(shm_name_, 1024 * 1024);
+    constexpr double RATE = 5000.0;
+    constexpr uint64_t BURST = 50;
+    zeroipc::RateLimiter limiter(mem, "limiter", RATE, BURST);
+    zeroipc::Array<uint64_t> granted(mem, "granted", 1);
+    granted[0] = 0;
+
+    constexpr int PROCESSES = 4;
+    auto start = std::chrono::steady_clock::now();
+    auto stop_at = start + 200ms;
+
+    std::vector<pid_t> children;
+    for (int p = 0; p < PROCESSES; p++) {
+        pid_t pid = fork();
+        ASSERT_NE(pid, -1);
+        if (pid == 0) {
+            zeroipc::Memory child_mem(shm_name_);
+            zeroipc::RateLimiter child_limiter(child_mem, "limiter");
+            zeroipc::Array<uint64_t> child_granted(child_mem, "granted");
+            std::atomic_ref<uint64_t> count(child_granted[0]);
+            while (std::chrono::steady_clock::now() < stop_at) {
+                if (child_limiter.try_acquire()) {
+                    count.fetch_add(1);
+                }
+            }
+            _exit(0);
+        }
+        children.push_back(pid);
+    }
+
+    for (pid_t pid : children) {
+        int status;
+        waitpid(pid, &status, 0);
+        EXPECT_EQ(WEXITSTATUS(status), 0);
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    EXPECT_LE(granted[0], BURST + static_cast<uint64_t>(RATE * elapsed) + 1);
+    EXPECT_GE(granted[0], BURST + static_cast<uint64_t>(RATE * 0.2 * 0.9));
+}
@@ -332,3 +332,83 @@ TEST_F(RWLockTest, ReaderWriterMutualExclusionStress) {
     EXPECT_EQ(violations.load(), 0)
         << "a reader observed a writer's half-completed update";
 }
+
+// A writer waiting on active readers turns new readers away, so a steady
+// stream of readers cannot starve it
+TEST_F(RWLockTest, WaitingWriterBlocksNewReaders) {
+    zeroipc::Memory mem(shm_name_, 1024 * 1024);
+    zeroipc::RWLock rwlock(mem, "test_rwlock");
+
+    rwlock.reader_lock();
+
+    std::atomic<bool> writer_done{false};
+    std::thread writer([&]() {
+        rwlock.writer_lock();
+        writer_done = true;
+        rwlock.writer_unlock();
+    });
+
+    // Wait for the writer to announce itself
+    bool turned_away = false;
+    for (int i = 0; i < 2000 && !turned_away; ++i) {
+        if (rwlock.try_reader_lock()) {
+            rwlock.reader_unlock();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        } else {
+            turned_away = true;
+        }
+    }
+    EXPECT_TRUE(turned_away);
+    EXPECT_FALSE(writer_done.load());
+
+    rwlock.reader_unlock();
+    writer.join();
+    EXPECT_TRUE(writer_done.load());
+
+    EXPECT_TRUE(rwlock.try_reader_lock());
+    rwlock.reader_unlock();
+}
+
+// Waiters that gave up spinning and parked on the futex are woken by unlock
+TEST_F(RWLockTest, ParkedWaitersWakeOnUnlock) {
+    zeroipc::Memory mem(shm_name_, 1024 * 1024);
+    zeroipc::RWLock rwlock(mem, "test_rwlock");
+
+    rwlock.writer_lock();
+
+    std::atomic<int> readers_in{0};
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i) {
+        readers.emplace_back([&]() {
+            zeroipc::SharedLock guard(rwlock);
+            readers_in.fetch_add(1);
+        });
+    }
+
+    // Long enough for every reader to exhaust its spins and park
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(readers_in.load(), 0);
+
+    rwlock.writer_unlock();
+    for (auto& t : readers) t.join();
+    EXPECT_EQ(readers_in.load(), 4);
+
+    // The lock is free again
+    EXPECT_TRUE(rwlock.try_writer_lock());
+    rwlock.writer_unlock();
+}
+
+// The state is a single 8-byte table entry under the lock's name
+TEST_F(RWLockTest, SingleWordLayout) {
+    zeroipc::Memory mem(shm_name_, 1024 * 1024);
+    zeroipc::RWLock rwlock(mem, "test_rwlock");
+
+    auto* entry = mem.table()->find("test_rwlock");
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->size, sizeof(zeroipc::RWLockState));
+    EXPECT_EQ(mem.table()->find("test_rwlock_rmtx"), nullptr);
+
+    // An entry of another size is not a RWLock
+    mem.allocate("not_a_lock", 1);
+    EXPECT_THROW(zeroipc::RWLock(mem, "not_a_lock"), std::runtime_error);
+}
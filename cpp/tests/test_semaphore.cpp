@@ -4,7 +4,11 @@
 #include <thread>
 #include <vector>
 #include <chrono>
+#include <algorithm>
+#include <mutex>
+#include <sys/wait.h>
 #include <unistd.h>
+#include <zeroipc/array.h>
 #include "test_config.h"
 
 using namespace zeroipc;
@@ -328,6 +332,276 @@ TEST_F(SemaphoreTest, UnboundedSemaphore) {
     EXPECT_EQ(sem.count(), 0);
 }
 
+// Multi-permit tests
+
+TEST_F(SemaphoreTest, MultiPermitAcquireRelease) {
+    Memory mem(shm_name_, 1024 * 1024);
+    Semaphore sem(mem, "test", 10, 10);
+
+    sem.acquire(4);
+    EXPECT_EQ(sem.count(), 6);
+    EXPECT_FALSE(sem.try_acquire(7));
+    EXPECT_EQ(sem.count(), 6);
+    EXPECT_TRUE(sem.try_acquire(6));
+    EXPECT_EQ(sem.count(), 0);
+    EXPECT_FALSE(sem.acquire_for(TestTiming::SHORT_TIMEOUT, 2));
+
+    sem.release(10);
+    EXPECT_EQ(sem.count(), 10);
+    EXPECT_THROW(sem.release(1), std::overflow_error);
+    EXPECT_EQ(sem.count(), 10);
+
+    EXPECT_THROW(sem.acquire(0), std::invalid_argument);
+    EXPECT_THROW(sem.acquire(11), std::invalid_argument);
+    EXPECT_THROW((void)sem.try_acquire(-1), std::invalid_argument);
+    EXPECT_THROW(sem.release(0), std::invalid_argument);
+
+    {
+        SemaphoreGuard guard(sem, 3);
+        EXPECT_EQ(sem.count(), 7);
+    }
+    EXPECT_EQ(sem.count(), 10);
+}
+
+TEST_F(SemaphoreTest, AcquireManyWaitsForAllPermits) {
+    Memory mem(shm_name_, 1024 * 1024);
+    Semaphore sem(mem, "test", 0);
+
+    std::atomic<bool> acquired{false};
+    std::thread waiter([&]() {
+        sem.acquire(3);
+        acquired = true;
+    });
+
+    sem.release(1);
+    sem.release(1);
+    std::this_thread::sleep_for(TestTiming::MEDIUM_TIMEOUT);
+    EXPECT_FALSE(acquired.load());
+    EXPECT_EQ(sem.count(), 2);
+
+    // The waiter is asleep by now; the last permit must wake it promptly
+    auto start = std::chrono::steady_clock::now();
+    sem.release(1);
+    waiter.join();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 50ms);
+    EXPECT_TRUE(acquired.load());
+    EXPECT_EQ(sem.count(), 0);
+    EXPECT_EQ(sem.waiting(), 0);
+}
+
+TEST_F(SemaphoreTest, WokenWaiterPassesUnusablePermitsOn) {
+    Memory mem(shm_name_, 1024 * 1024);
+    Semaphore sem(mem, "pass_on", 0);
+
+    std::atomic<bool> big_done{false};
+    std::atomic<bool> small_done{false};
+    std::thread big([&]() {
+        sem.acquire(2);
+        big_done = true;
+    });
+    std::this_thread::sleep_for(20ms);
+    std::thread small([&]() {
+        sem.acquire(1);
+        small_done = true;
+    });
+    std::this_thread::sleep_for(20ms);
+
+    // release(1) wakes one sleeper, the first asleep; it cannot use a
+    // single permit and must hand the wake-up to the small request well
+    // before that one's 100ms sleep would run out
+    auto start = std::chrono::steady_clock::now();
+    sem.release(1);
+    while (!small_done.load() && std::chrono::steady_clock::now() - start < 1s) {
+        std::this_thread::sleep_for(1ms);
+    }
+    EXPECT_TRUE(small_done.load());
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 50ms);
+    EXPECT_FALSE(big_done.load());
+
+    sem.release(2);
+    big.join();
+    small.join();
+    EXPECT_EQ(sem.count(), 0);
+}
+
+// FIFO order tests
+
+TEST_F(SemaphoreTest, FifoServesInArrivalOrder) {
+    Memory mem(shm_name_, 1024 * 1024);
+    Semaphore sem(mem, "fifo", 0, 0, Semaphore::Order::Fifo);
+    EXPECT_EQ(sem.order(), Semaphore::Order::Fifo);
+
+    Semaphore opened(mem, "fifo");
+    EXPECT_EQ(opened.order(), Semaphore::Order::Fifo);
+
+    constexpr int WAITERS = 4;
+    std::mutex order_mutex;
+    std::vector<int> order;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < WAITERS; i++) {
+        threads.emplace_back([&, i]() {
+            sem.acquire();
+            std::lock_guard<std::mutex> lock(order_mutex);
+            order.push_back(i);
+        });
+        // Let waiter i queue up before the next one starts
+        std::this_thread::sleep_for(20ms);
+    }
+    EXPECT_EQ(sem.waiting(), WAITERS);
+
+    // One permit at a time, so only the head of the queue can take it
+    for (int i = 0; i < WAITERS; i++) {
+        opened.release();
+        while (true) {
+            std::lock_guard<std::mutex> lock(order_mutex);
+            if (order.size() == static_cast<size_t>(i + 1)) {
+                break;
+            }
+        }
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    EXPECT_EQ(order, (std::vector<int>{0, 1, 2, 3}));
+    EXPECT_FALSE(sem.try_acquire());
+}
+
+TEST_F(SemaphoreTest, FifoLargeRequestIsNotStarved) {
+    Memory mem(shm_name_, 1024 * 1024);
+    Semaphore sem(mem, "fifo", 0, 0, Semaphore::Order::Fifo);
+
+    std::atomic<bool> big_done{false};
+    std::atomic<bool> small_done{false};
+    std::thread big([&]() {
+        sem.acquire(3);
+        big_done = true;
+    });
+    std::this_thread::sleep_for(20ms);
+    std::thread small([&]() {
+        sem.acquire(1);
+        small_done = true;
+    });
+    std::this_thread::sleep_for(20ms);
+
+    // One permit would satisfy the small request, but it is queued behind
+    sem.release(2);
+    std::this_thread::sleep_for(TestTiming::MEDIUM_TIMEOUT);
+    EXPECT_FALSE(big_done.load());
+    EXPECT_FALSE(small_done.load());
+    EXPECT_FALSE(sem.try_acquire());
+
+    sem.release(1);
+    big.join();
+    EXPECT_TRUE(big_done.load());
+    sem.release(1);
+    small.join();
+    EXPECT_EQ(sem.count(), 0);
+}
+
+TEST_F(SemaphoreTest, FifoTimedOutWaiterIsSkipped) {
+    Memory mem(shm_name_, 1024 * 1024);
+    Semaphore sem(mem, "fifo", 0, 0, Semaphore::Order::Fifo);
+
+    std::thread head([&]() { sem.acquire(2); });
+    std::this_thread::sleep_for(20ms);
+
+    // Queued behind the head, gives up before its turn comes
+    EXPECT_FALSE(sem.acquire_for(TestTiming::MEDIUM_TIMEOUT));
+
+    std::atomic<bool> tail_done{false};
+    std::thread tail([&]() {
+        sem.acquire();
+        tail_done = true;
+    });
+    std::this_thread::sleep_for(20ms);
+
+    sem.release(2);
+    head.join();
+    sem.release(1);
+    tail.join();
+    EXPECT_TRUE(tail_done.load());
+    EXPECT_EQ(sem.count(), 0);
+    EXPECT_EQ(sem.waiting(), 0);
+}
+
+TEST_F(SemaphoreTest, FifoFullQueueTimesOutOnDeadline) {
+    Memory mem(shm_name_, 1024 * 1024);
+    Semaphore sem(mem, "fifo", 0, 0, Semaphore::Order::Fifo);
+
+    std::thread head([&]() { sem.acquire(2); });
+    std::this_thread::sleep_for(20ms);
+
+    // Fill every other slot with tickets that give up before being served
+    std::vector<std::thread> quitters;
+    for (int i = 1; i < Semaphore::QUEUE_SLOTS; ++i) {
+        quitters.emplace_back([&]() { EXPECT_FALSE(sem.acquire_for(TestTiming::MEDIUM_TIMEOUT)); });
+    }
+    for (auto& t : quitters) {
+        t.join();
+    }
+
+    // The queue is full of abandoned tickets: no ticket is free to share a
+    // slot with one of them, and waiting for room respects the deadline
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(sem.acquire_for(TestTiming::SHORT_TIMEOUT));
+    EXPECT_LT(std::chrono::steady_clock::now() - start, TestTiming::SHORT_TIMEOUT + 200ms);
+
+    sem.release(2);
+    head.join();
+
+    // Serving the head skips every abandoned ticket
+    std::thread tail([&]() { sem.acquire(); });
+    sem.release(1);
+    tail.join();
+    EXPECT_EQ(sem.count(), 0);
+    EXPECT_EQ(sem.waiting(), 0);
+}
+
+TEST_F(SemaphoreTest, CrossProcessFifoBatches) {
+    Memory mem(shm_name_, 1024 * 1024);
+    // Two batches of 2 never fit in 3 permits at once
+    Semaphore sem(mem, "fifo", 3, 3, Semaphore::Order::Fifo);
+    Array<int32_t> stats(mem, "stats", 2);  // in use, most seen in use
+    stats[0] = 0;
+    stats[1] = 0;
+
+    constexpr int PROCESSES = 4;
+    constexpr int ITERATIONS = 300;
+
+    std::vector<pid_t> children;
+    for (int p = 0; p < PROCESSES; p++) {
+        pid_t pid = fork();
+        ASSERT_NE(pid, -1);
+        if (pid == 0) {
+            Memory child_mem(shm_name_);
+            Semaphore child_sem(child_mem, "fifo");
+            Array<int32_t> child_stats(child_mem, "stats");
+            std::atomic_ref<int32_t> in_use(child_stats[0]);
+            std::atomic_ref<int32_t> peak(child_stats[1]);
+            for (int i = 0; i < ITERATIONS; i++) {
+                child_sem.acquire(2);
+                int32_t now = in_use.fetch_add(2) + 2;
+                int32_t seen = peak.load();
+                while (now > seen && !peak.compare_exchange_weak(seen, now)) {
+                }
+                in_use.fetch_sub(2);
+                child_sem.release(2);
+            }
+            _exit(0);
+        }
+        children.push_back(pid);
+    }
+
+    for (pid_t pid : children) {
+        int status;
+        waitpid(pid, &status, 0);
+        EXPECT_EQ(WEXITSTATUS(status), 0);
+    }
+    EXPECT_EQ(stats[1], 2);
+    EXPECT_EQ(sem.count(), 3);
+    EXPECT_EQ(sem.waiting(), 0);
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include <zeroipc/memory.h>
+#include <zeroipc/seqlock.h>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "test_config.h"
+
+using namespace zeroipc::test;
+
+namespace {
+
+// A 40-byte status record whose fields must always agree
+struct Telemetry {
+    uint64_t tick;
+    double position[3];
+    uint64_t check;  // tick * 3
+};
+
+Telemetry make_telemetry(uint64_t tick) {
+    double p = static_cast<double>(tick);
+    return Telemetry{tick, {p, p * 2, p * 3}, tick * 3};
+}
+
+bool consistent(const Telemetry& t) {
+    double p = static_cast<double>(t.tick);
+    return t.check == t.tick * 3 && t.position[0] == p &&
+           t.position[1] == p * 2 && t.position[2] == p * 3;
+}
+
+} // namespace
+
+class SeqLockTest : public SharedMemoryTestBase {
+};
+
+TEST_F(SeqLockTest, StoreLoadAndSequence) {
+    zeroipc::Memory mem(shm_name_, 1024 * 1024);
+    zeroipc::SeqLock<Telemetry> lock(mem, "telemetry", make_telemetry(1));
+
+    EXPECT_EQ(lock.sequence(), 0u);
+    EXPECT_EQ(lock.load().tick, 1u);
+
+    lock.store(make_telemetry(7));
+    EXPECT_EQ(lock.sequence(), 2u);
+    Telemetry t{};
+    ASSERT_TRUE(lock.try_load(t));
+    EXPECT_EQ(t.tick, 7u);
+    EXPECT_TRUE(consistent(t));
+
+    auto next = lock.update([](Telemetry cur) { return make_telemetry(cur.tick + 1); });
+    EXPECT_EQ(next.tick, 8u);
+    EXPECT_EQ(lock.sequence(), 4u);
+}
+
+TEST_F(SeqLockTest, OpenExisting) {
+    zeroipc::Memory mem(shm_name_, 1024 * 1024);
+    {
+        zeroipc::SeqLock<Telemetry> lock(mem, "telemetry", make_telemetry(5));
+    }
+    zeroipc::SeqLock<Telemetry> opened(mem, "telemetry");
+    EXPECT_EQ(opened.load().tick, 5u);
+
+    EXPECT_THROW(zeroipc::SeqLock<uint32_t>(mem, "telemetry"), std::runtime_error);
+    EXPECT_THROW(zeroipc::SeqLock<Telemetry>(mem, "missing"), std::runtime_error);
+}
+
+TEST_F(SeqLockTest, ReadersNeverSeeTornValues) {
+    zeroipc::Memory mem(shm_name_, 1024 * 1024);
+    zeroipc::SeqLock<Telemetry> lock(mem, "telemetry", make_telemetry(0));
+
+    std::atomic<bool> stop{false};
+    std::atomic<int> torn{0};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&]() {
+            uint64_t last = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                Telemetry t = lock.load();
+                if (!consistent(t) || t.tick < last) torn.fetch_add(1);
+                last = t.tick;
+            }
+        });
+    }
+
+    for (uint64_t i = 1; i <= 100000; ++i) {
+        lock.store(make_telemetry(i));
+    }
+    stop = true;
+    for (auto& t : readers) t.join();
+
+    EXPECT_EQ(torn.load(), 0);
+    EXPECT_EQ(lock.sequence(), 200000u);
+}
+
+TEST_F(SeqLockTest, ConcurrentWritersSerialize) {
+    zeroipc::Memory mem(shm_name_, 1024 * 1024);
+    zeroipc::SeqLock<uint64_t> lock(mem, "counter", 0);
+
+    std::vector<std::thread> writers;
+    for (int w = 0; w < 4; ++w) {
+        writers.emplace_back([&]() {
+            for (int i = 0; i < 1000; ++i) {
+                lock.update([](uint64_t v) { return v + 1; });
+            }
+        });
+    }
+    for (auto& t : writers) t.join();
+
+    EXPECT_EQ(lock.load(), 4000u);
+}
+
+TEST_F(SeqLockTest, DeadWriterMakesLoadFail) {
+    zeroipc::Memory mem(shm_name_, 1024 * 1024);
+    zeroipc::SeqLock<uint64_t> lock(mem, "counter", 0);
+
+    // Simulate a writer that died mid-store
+    auto* header = mem.ptr_at<zeroipc::SeqLock<uint64_t>::Header>(
+        mem.table()->find("counter")->offset);
+    header->seq.store(1);
+
+    uint64_t out = 0;
+    EXPECT_FALSE(lock.try_load(out));
+    EXPECT_THROW((void)lock.load(), std::runtime_error);
+}
+
+TEST_F(SeqLockTest, CrossProcess) {
+    zeroipc::Memory mem(shm_name_, 1024 * 1024);
+    zeroipc::SeqLock<Telemetry> lock(mem, "telemetry", make_telemetry(0));
+
+    pid_t pid = fork();
+    ASSERT_NE(pid, -1);
+
+    if (pid == 0) {
+        zeroipc::Memory child_mem(shm_name_);
+        zeroipc::SeqLock<Telemetry> child(child_mem, "telemetry");
+        int bad = 0;
+        uint64_t tick = 0;
+        while (tick < 20000) {
+            Telemetry t = child.load();
+            if (!consistent(t)) bad++;
+            tick = t.tick;
+        }
+        exit(bad == 0 ? 0 : 1);
+    }
+
+    for (uint64_t i = 1; i <= 20000; ++i) {
+        lock.store(make_telemetry(i));
+    }
+
+    int status;
+    waitpid(pid, &status, 0);
+    EXPECT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+}
@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include <zeroipc/memory.h>
+#include <zeroipc/sharded_queue.h>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <set>
+#include "test_config.h"
+
+using namespace zeroipc;
+using namespace zeroipc::test;
+
+class ShardedQueueTest : public SharedMemoryTestBase {
+};
+
+TEST_F(ShardedQueueTest, CreateAndBasicOps) {
+    Memory mem(shm_name_, 1024*1024);
+    ShardedQueue<int> queue(mem, "sq", 100, 4);
+
+    EXPECT_EQ(queue.lanes(), 4u);
+    EXPECT_EQ(queue.lane_capacity(), 32u);  // ceil(100 / 4) rounded up
+    EXPECT_EQ(queue.capacity(), 128u);
+    EXPECT_TRUE(queue.empty());
+
+    for (int i = 0; i < 10; i++) {
+        ASSERT_TRUE(queue.push(i));
+    }
+    EXPECT_EQ(queue.size(), 10u);
+
+    // One thread's values stay in order (per-lane FIFO)
+    for (int i = 0; i < 10; i++) {
+        EXPECT_EQ(queue.pop(), i);
+    }
+    EXPECT_FALSE(queue.pop().has_value());
+}
+
+TEST_F(ShardedQueueTest, LanesOnOwnCacheLines) {
+    Memory mem(shm_name_, 1024*1024);
+    ShardedQueue<char> queue(mem, "lines", 8, 3);
+
+    size_t offset = 0, size = 0;
+    ASSERT_TRUE(mem.find("lines", offset, size));
+    EXPECT_EQ(offset % CACHE_LINE_SIZE, 0u);
+    // Each lane: head line + tail line + data/seq rounded to a line
+    EXPECT_EQ(size, 64u + 3 * (128u + 64u));
+}
+
+TEST_F(ShardedQueueTest, FullLanesSpillThenFail) {
+    Memory mem(shm_name_, 1024*1024);
+    ShardedQueue<int> queue(mem, "spill", 8, 4);  // 4 lanes x 2 slots
+
+    for (int i = 0; i < 8; i++) {
+        ASSERT_TRUE(queue.push(i)) << "push " << i << " should spill to a free lane";
+    }
+    EXPECT_FALSE(queue.push(8));
+
+    std::multiset<int> seen;
+    int out[16];
+    size_t n = queue.pop_bulk(out, 16);
+    seen.insert(out, out + n);
+    EXPECT_EQ(n, 8u);
+    EXPECT_EQ(seen, (std::multiset<int>{0, 1, 2, 3, 4, 5, 6, 7}));
+}
+
+TEST_F(ShardedQueueTest, PushToKeepsKeyOrder) {
+    Memory mem(shm_name_, 1024*1024);
+    ShardedQueue<int> queue(mem, "keyed", 64, 4);
+
+    for (int i = 0; i < 8; i++) {
+        ASSERT_TRUE(queue.push_to(2, 100 + i));
+        ASSERT_TRUE(queue.push_to(3, 200 + i));
+    }
+    std::vector<int> key2, key3;
+    while (auto v = queue.pop()) {
+        (*v < 200 ? key2 : key3).push_back(*v);
+    }
+    ASSERT_EQ(key2.size(), 8u);
+    ASSERT_EQ(key3.size(), 8u);
+    EXPECT_TRUE(std::is_sorted(key2.begin(), key2.end()));
+    EXPECT_TRUE(std::is_sorted(key3.begin(), key3.end()));
+}
+
+TEST_F(ShardedQueueTest, OpenExisting) {
+    Memory mem(shm_name_, 1024*1024);
+    ShardedQueue<double> creator(mem, "shared", 64, 8);
+    ASSERT_TRUE(creator.push_to(5, 2.5));
+
+    ShardedQueue<double> opened(mem, "shared");
+    EXPECT_EQ(opened.lanes(), 8u);
+    EXPECT_EQ(opened.capacity(), 64u);
+    EXPECT_EQ(opened.pop(), 2.5);
+
+    EXPECT_THROW(ShardedQueue<int>(mem, "shared"), std::runtime_error);
+    EXPECT_THROW(ShardedQueue<int>(mem, "missing"), std::runtime_error);
+    EXPECT_THROW(ShardedQueue<int>(mem, "bad", 8, 0), std::invalid_argument);
+}
+
+TEST_F(ShardedQueueTest, ManyProducersManyConsumers) {
+    Memory mem(shm_name_, 4*1024*1024);
+    ShardedQueue<int> queue(mem, "mpmc", 1024, 8);
+
+    const int producers = 8;
+    const int consumers = 4;
+    const int per_producer = 5000;
+    const long expected = long(producers) * per_producer;
+
+    std::atomic<long> consumed{0};
+    std::atomic<long> sum{0};
+    std::vector<std::thread> threads;
+
+    for (int p = 0; p < producers; p++) {
+        threads.emplace_back([&] {
+            for (int i = 1; i <= per_producer; i++) {
+                while (!queue.push(i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (int c = 0; c < consumers; c++) {
+        threads.emplace_back([&] {
+            int batch[32];
+            while (consumed.load() < expected) {
+                size_t n = queue.pop_bulk(batch, 32);
+                for (size_t i = 0; i < n; i++) {
+                    sum += batch[i];
+                }
+                consumed += n;
+                if (n == 0) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    EXPECT_EQ(consumed.load(), expected);
+    EXPECT_EQ(sum.load(), long(producers) * per_producer * (per_producer + 1) / 2);
+    EXPECT_TRUE(queue.empty());
+}
@@ -145,6 +145,94 @@ TEST_F(SignalTest, WaitForChangeTimeout) {
     EXPECT_FALSE(changed);
 }
 
+TEST_F(SignalTest, SetWakesParkedWaiterPromptly) {
+    zeroipc::Memory mem(shm_name_, 1024 * 1024);
+    zeroipc::Signal<int> sig(mem, "test_signal", 0);
+
+    std::atomic<int64_t> woke_ns{0};
+    uint64_t version = sig.version();
+    std::thread waiter([&]() {
+        EXPECT_TRUE(sig.wait_for_change(version, std::chrono::seconds(5)));
+        woke_ns = std::chrono::steady_clock::now().time_since_epoch().count();
+    });
+
+    // Long enough for the waiter to be parked in the futex
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    auto set_at = std::chrono::steady_clock::now().time_since_epoch().count();
+    sig.set(1);
+    waiter.join();
+
+    // A futex wake, not the end of a PARK_SLICE sleep
+    EXPECT_LT(woke_ns - set_at, 50'000'000);
+}
+
+TEST_F(SignalTest, SetWakesAllWaiters) {
+    zeroipc::Memory mem(shm_name_, 1024 * 1024);
+    zeroipc::Signal<int> sig(mem, "test_signal", 0);
+
+    uint64_t version = sig.version();
+    std::atomic<int> changed{0};
+    std::vector<std::thread> waiters;
+    for (int i = 0; i < 4; i++) {
+        waiters.emplace_back([&]() {
+            if (sig.wait_for_change(version, std::chrono::seconds(5))) {
+                changed++;
+            }
+        });
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    sig.update([](int v) { return v + 1; });
+    for (auto& t : waiters) {
+        t.join();
+    }
+
+    EXPECT_EQ(changed.load(), 4);
+}
+
+TEST_F(SignalTest, CrossProcessWaitForChange) {
+    zeroipc::Memory mem(shm_name_, 1024 * 1024);
+    zeroipc::Signal<int> ping(mem, "ping", 0);
+    zeroipc::Signal<int> pong(mem, "pong", 0);
+
+    constexpr int ROUNDS = 200;
+
+    pid_t pid = fork();
+    ASSERT_NE(pid, -1);
+
+    if (pid == 0) {
+        // Child - echoes every ping back as a pong
+        zeroipc::Memory child_mem(shm_name_);
+        zeroipc::Signal<int> child_ping(child_mem, "ping", zeroipc::Signal<int>::OpenExisting{});
+        zeroipc::Signal<int> child_pong(child_mem, "pong", zeroipc::Signal<int>::OpenExisting{});
+
+        uint64_t seen = 0;
+        for (int i = 1; i <= ROUNDS; i++) {
+            if (!child_ping.wait_for_change(seen, std::chrono::seconds(5))) {
+                exit(1);
+            }
+            seen = child_ping.version();
+            child_pong.set(child_ping.get());
+        }
+        exit(0);
+    }
+
+    // Parent - each round waits for the echo before sending the next ping
+    uint64_t seen = 0;
+    bool ok = true;
+    for (int i = 1; i <= ROUNDS && ok; i++) {
+        ping.set(i);
+        ok = pong.wait_for_change(seen, std::chrono::seconds(5));
+        seen = pong.version();
+        EXPECT_EQ(pong.get(), i);
+    }
+    EXPECT_TRUE(ok);
+
+    int status;
+    waitpid(pid, &status, 0);
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+}
+
 TEST_F(SignalTest, OpenExisting) {
     {
         zeroipc::Memory mem(shm_name_, 1024 * 1024);
@@ -0,0 +1,217 @@
+#include <gtest/gtest.h>
+#include <zeroipc/memory.h>
+#include <zeroipc/queue.h>
+#include <zeroipc/slab_allocator.h>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "test_config.h"
+
+using namespace zeroipc;
+using namespace zeroipc::test;
+
+class SlabAllocatorTest : public SharedMemoryTestBase {
+};
+
+using Handle = SlabAllocator::Handle;
+
+TEST_F(SlabAllocatorTest, SizeClasses) {
+    EXPECT_EQ(SlabAllocator::size_class(0), 0u);
+    EXPECT_EQ(SlabAllocator::size_class(64), 0u);
+    EXPECT_EQ(SlabAllocator::size_class(65), 1u);
+    EXPECT_EQ(SlabAllocator::size_class(4096), 6u);
+    EXPECT_EQ(SlabAllocator::size_class(65536), 10u);
+    EXPECT_EQ(SlabAllocator::class_size(10), 65536u);
+    EXPECT_THROW(SlabAllocator::size_class(65537), std::invalid_argument);
+}
+
+TEST_F(SlabAllocatorTest, AllocatesDistinctWritableBlocks) {
+    Memory mem(shm_name_, 8*1024*1024);
+    SlabAllocator slab(mem, "blobs", 8);
+
+    std::vector<std::pair<Handle, size_t>> blocks;
+    for (size_t size : {1, 64, 100, 1000, 5000, 40000, 65536}) {
+        Handle h = slab.allocate(size);
+        ASSERT_NE(h, SlabAllocator::NULL_HANDLE);
+        EXPECT_GE(slab.block_size(h), size);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(slab.get(h)) % 64, 0u);
+        std::memset(slab.get(h), int(size & 0xFF), size);
+        blocks.emplace_back(h, size);
+    }
+    for (auto [h, size] : blocks) {
+        const auto* bytes = slab.as<unsigned char>(h);
+        EXPECT_EQ(bytes[0], size & 0xFF);
+        EXPECT_EQ(bytes[size - 1], size & 0xFF);
+    }
+    EXPECT_EQ(slab.free_slabs(), 3u);  // 5 distinct classes took one slab each
+
+    for (auto [h, size] : blocks) {
+        slab.deallocate(h);
+    }
+    EXPECT_EQ(slab.free_slabs(), 8u);
+}
+
+TEST_F(SlabAllocatorTest, EmptySlabsMoveBetweenClasses) {
+    Memory mem(shm_name_, 4*1024*1024);
+    SlabAllocator slab(mem, "recycle", 2);
+
+    // Fill both slabs with 64 KB blocks (4 per slab)
+    std::vector<Handle> big;
+    for (int i = 0; i < 8; i++) {
+        big.push_back(slab.allocate(65536));
+        ASSERT_NE(big.back(), SlabAllocator::NULL_HANDLE);
+    }
+    EXPECT_EQ(slab.allocate(65536), SlabAllocator::NULL_HANDLE);
+    EXPECT_EQ(slab.allocate(64), SlabAllocator::NULL_HANDLE);
+
+    // Emptying one slab lets the small class take it over
+    for (int i = 0; i < 4; i++) {
+        slab.deallocate(big[i]);
+    }
+    EXPECT_EQ(slab.free_slabs(), 1u);
+    std::vector<Handle> small;
+    for (int i = 0; i < 4096; i++) {
+        small.push_back(slab.allocate(64));
+        ASSERT_NE(small.back(), SlabAllocator::NULL_HANDLE);
+    }
+    EXPECT_EQ(slab.allocate(64), SlabAllocator::NULL_HANDLE);
+    EXPECT_EQ(slab.stats(0).slabs, 1u);
+    EXPECT_EQ(slab.stats(10).slabs, 1u);
+}
+
+TEST_F(SlabAllocatorTest, ReportsFragmentation) {
+    Memory mem(shm_name_, 4*1024*1024);
+    SlabAllocator slab(mem, "frag", 4);
+
+    std::vector<Handle> handles;
+    for (int i = 0; i < 1024; i++) {
+        handles.push_back(slab.allocate(256));  // Class 2, 1024 per slab
+    }
+    auto st = slab.stats(2);
+    EXPECT_EQ(st.block_size, 256u);
+    EXPECT_EQ(st.slabs, 1u);
+    EXPECT_EQ(st.blocks, 1024u);
+    EXPECT_EQ(st.used, 1024u);
+    EXPECT_DOUBLE_EQ(st.fragmentation(), 0.0);
+
+    // Free every other block: the slab stays owned but half empty
+    for (int i = 0; i < 1024; i += 2) {
+        slab.deallocate(handles[i]);
+    }
+    st = slab.stats(2);
+    EXPECT_EQ(st.used, 512u);
+    EXPECT_DOUBLE_EQ(st.fragmentation(), 0.5);
+
+    // Freed blocks are reused before anything new is carved
+    Handle again = slab.allocate(200);
+    EXPECT_EQ(again, handles[1022]);
+    EXPECT_EQ(slab.stats(2).slabs, 1u);
+    EXPECT_DOUBLE_EQ(slab.stats(5).fragmentation(), 0.0);
+
+    // A fresh slab's uncarved tail is not fragmentation
+    Handle first = slab.allocate(2048);  // Class 5, 128 per slab
+    st = slab.stats(5);
+    EXPECT_EQ(st.blocks, 128u);
+    EXPECT_EQ(st.carved, 1u);
+    EXPECT_DOUBLE_EQ(st.fragmentation(), 0.0);
+    Handle second = slab.allocate(2048);
+    slab.deallocate(first);
+    EXPECT_DOUBLE_EQ(slab.stats(5).fragmentation(), 0.5);
+    slab.deallocate(second);
+    EXPECT_EQ(slab.stats(5).carved, 0u);
+}
+
+TEST_F(SlabAllocatorTest, OpenExistingAndValidation) {
+    Memory mem(shm_name_, 4*1024*1024);
+    SlabAllocator creator(mem, "shared", 2);
+    Handle h = creator.allocate(500);
+    std::strcpy(creator.as<char>(h), "hello");
+
+    SlabAllocator opened(mem, "shared");
+    EXPECT_EQ(opened.slabs(), 2u);
+    EXPECT_STREQ(opened.as<char>(h), "hello");
+    EXPECT_EQ(opened.block_size(h), 512u);
+    opened.deallocate(h);
+    EXPECT_EQ(creator.free_slabs(), 2u);
+
+    EXPECT_THROW(opened.deallocate(h + 8), std::invalid_argument);
+    EXPECT_THROW(opened.deallocate(64), std::invalid_argument);
+    EXPECT_THROW(SlabAllocator(mem, "missing"), std::runtime_error);
+    EXPECT_THROW(SlabAllocator(mem, "a_name_that_is_much_too_long", 1), std::invalid_argument);
+    EXPECT_THROW(SlabAllocator(mem, "zero", 0), std::invalid_argument);
+}
+
+TEST_F(SlabAllocatorTest, ConcurrentMixedSizes) {
+    Memory mem(shm_name_, 8*1024*1024);
+    SlabAllocator slab(mem, "mixed", 24);
+
+    const int num_threads = 4;
+    std::atomic<bool> corrupted{false};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; t++) {
+        threads.emplace_back([&, t]() {
+            std::vector<std::pair<Handle, size_t>> held;
+            for (int r = 0; r < 4000; r++) {
+                if (held.size() < 32 && r % 3 != 2) {
+                    size_t size = 64u << ((r * 7 + t) % 8);
+                    Handle h = slab.allocate(size);
+                    if (h != SlabAllocator::NULL_HANDLE) {
+                        std::memset(slab.get(h), t + 1, size);
+                        held.emplace_back(h, size);
+                    }
+                } else if (!held.empty()) {
+                    auto [h, size] = held.back();
+                    const auto* bytes = slab.as<unsigned char>(h);
+                    if (bytes[0] != t + 1 || bytes[size - 1] != t + 1) corrupted = true;
+                    slab.deallocate(h);
+                    held.pop_back();
+                }
+            }
+            for (auto [h, size] : held) {
+                slab.deallocate(h);
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    EXPECT_FALSE(corrupted.load());
+    EXPECT_EQ(slab.free_slabs(), 24u);
+}
+
+TEST_F(SlabAllocatorTest, HandlesThroughQueueAcrossProcesses) {
+    Memory mem(shm_name_, 4*1024*1024);
+    SlabAllocator slab(mem, "msgs", 8);
+    Queue<Handle> queue(mem, "handles", 16);
+
+    pid_t pid = fork();
+    ASSERT_NE(pid, -1);
+    if (pid == 0) {
+        Memory child_mem(shm_name_);
+        SlabAllocator child_slab(child_mem, "msgs");
+        Queue<Handle> child_queue(child_mem, "handles");
+        for (int i = 1; i <= 10; i++) {
+            Handle h = child_slab.allocate(i * 1000);
+            if (h == SlabAllocator::NULL_HANDLE) exit(1);
+            std::memset(child_slab.get(h), i, i * 1000);
+            if (!child_queue.push(h)) exit(2);
+        }
+        exit(0);
+    }
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+    ASSERT_EQ(WEXITSTATUS(status), 0);
+
+    for (int i = 1; i <= 10; i++) {
+        auto h = queue.pop();
+        ASSERT_TRUE(h.has_value());
+        const auto* bytes = slab.as<unsigned char>(*h);
+        EXPECT_EQ(bytes[0], i);
+        EXPECT_EQ(bytes[i * 1000 - 1], i);
+        slab.deallocate(*h);
+    }
+    EXPECT_EQ(slab.free_slabs(), 8u);
+}
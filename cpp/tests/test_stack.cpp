@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <cstring>
 #include <zeroipc/memory.h>
 #include <zeroipc/stack.h>
 #include <thread>
@@ -147,4 +148,159 @@ TEST_F(StackTest, ConcurrentPushPop) {
     }
     EXPECT_EQ(count, num_threads * items_per_thread / 2);
     EXPECT_TRUE(stack.empty());
-}
\ No newline at end of file
+}
+
+TEST_F(StackTest, EliminationSlotsOnOwnCacheLines) {
+    Memory mem(shm_name_, 1024*1024);
+    Stack<char> stack(mem, "elim_stack", 10, StackLayout::Compact);
+
+    size_t offset = 0, size = 0;
+    ASSERT_TRUE(mem.find("elim_stack", offset, size));
+    // [16 header][10 data, pad to 8][40 states] = 72, then 8 lines of slots
+    EXPECT_EQ(size, 128u + Stack<char>::ELIM_SLOTS * CACHE_LINE_SIZE);
+    EXPECT_EQ(Stack<char>::ELIM_STRIDE, CACHE_LINE_SIZE);
+
+    const char* slots = static_cast<const char*>(mem.base()) + offset + 128;
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(slots) % CACHE_LINE_SIZE, 0u);
+    for (size_t i = 0; i < Stack<char>::ELIM_SLOTS; i++) {
+        uint32_t state;
+        std::memcpy(&state, slots + i * CACHE_LINE_SIZE, sizeof(state));
+        EXPECT_EQ(state, Stack<char>::ELIM_FREE);
+    }
+
+    ASSERT_TRUE(stack.push('x'));
+    Stack<char> reopened(mem, "elim_stack");
+    EXPECT_EQ(reopened.pop(), 'x');
+}
+
+TEST_F(StackTest, PaddedTopByDefault) {
+    Memory mem(shm_name_, 1024*1024);
+    Stack<int32_t> stack(mem, "padded_stack", 10);
+
+    size_t offset = 0, size = 0;
+    ASSERT_TRUE(mem.find("padded_stack", offset, size));
+    const char* base = static_cast<const char*>(mem.base()) + offset;
+    uint32_t elem_size;
+    std::memcpy(&elem_size, base + 8, sizeof(elem_size));
+    EXPECT_EQ(elem_size, sizeof(int32_t) | STACK_LAYOUT_PADDED_TOP);
+
+    // top lives on its own line; data starts on the line after it
+    ASSERT_TRUE(stack.push(7));
+    ASSERT_TRUE(stack.push(8));
+    int32_t top;
+    std::memcpy(&top, base + STACK_PADDED_TOP_OFFSET, sizeof(top));
+    EXPECT_EQ(top, 1);
+    int32_t first;
+    std::memcpy(&first, base + STACK_PADDED_HEADER_SIZE, sizeof(first));
+    EXPECT_EQ(first, 7);
+
+    Stack<int32_t> reopened(mem, "padded_stack");
+    EXPECT_EQ(reopened.pop(), 8);
+    EXPECT_EQ(stack.pop(), 7);
+    EXPECT_TRUE(reopened.empty());
+}
+
+TEST_F(StackTest, EliminationCanBeDisabled) {
+    Memory mem(shm_name_, 1024*1024);
+    Stack<char> stack(mem, "plain_stack", 10, StackLayout::Compact, false);
+
+    size_t offset = 0, size = 0;
+    ASSERT_TRUE(mem.find("plain_stack", offset, size));
+    EXPECT_EQ(size, 16u + 16u + 40u);  // No exchange slots
+
+    ASSERT_TRUE(stack.push('x'));
+    Stack<char> reopened(mem, "plain_stack");
+    EXPECT_EQ(reopened.pop(), 'x');
+    EXPECT_TRUE(stack.empty());
+}
+
+TEST_F(StackTest, SymmetricPushPopLosesNothing) {
+    Memory mem(shm_name_, 10*1024*1024);
+    Stack<int> stack(mem, "symmetric_stack", 64);
+
+    const int num_threads = 8;
+    const int pairs_per_thread = 20000;
+    std::atomic<long> pushed_sum{0};
+    std::atomic<long> popped_sum{0};
+    std::vector<std::thread> threads;
+
+    // Every thread alternates push and pop, the free-list recycling pattern
+    for (int t = 0; t < num_threads; t++) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < pairs_per_thread; i++) {
+                int value = t * pairs_per_thread + i;
+                if (stack.push(value)) {
+                    pushed_sum += value;
+                }
+                if (auto v = stack.pop()) {
+                    popped_sum += *v;
+                }
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    while (auto v = stack.pop()) {
+        popped_sum += *v;
+    }
+    EXPECT_EQ(pushed_sum.load(), popped_sum.load());
+    EXPECT_TRUE(stack.empty());
+}
+
+TEST_F(StackTest, BatchedPushPop) {
+    Memory mem(shm_name_, 1024*1024);
+    Stack<int> stack(mem, "batch_stack", 10);
+
+    int in[12];
+    for (int i = 0; i < 12; i++) in[i] = i;
+    EXPECT_EQ(stack.push_n(in, 4), 4u);
+    EXPECT_EQ(stack.push_n(in + 4, 8), 6u);  // Clipped to the free space
+    EXPECT_TRUE(stack.full());
+    EXPECT_EQ(stack.push_n(in, 1), 0u);
+
+    int out[12];
+    ASSERT_EQ(stack.pop_n(out, 3), 3u);
+    EXPECT_EQ(out[0], 9);
+    EXPECT_EQ(out[2], 7);
+    EXPECT_EQ(stack.pop(), 6);
+    ASSERT_EQ(stack.pop_n(out, 12), 6u);
+    for (int i = 0; i < 6; i++) {
+        EXPECT_EQ(out[i], 5 - i);
+    }
+    EXPECT_EQ(stack.pop_n(out, 4), 0u);
+}
+
+TEST_F(StackTest, ConcurrentBatchesLoseNothing) {
+    Memory mem(shm_name_, 10*1024*1024);
+    Stack<int> stack(mem, "batch_concurrent", 256);
+
+    const int num_threads = 4;
+    const int rounds = 5000;
+    std::atomic<long> pushed_sum{0};
+    std::atomic<long> popped_sum{0};
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < num_threads; t++) {
+        threads.emplace_back([&, t]() {
+            int in[8], out[8];
+            for (int r = 0; r < rounds; r++) {
+                size_t batch = 1 + (r + t) % 8;
+                for (size_t i = 0; i < batch; i++) {
+                    in[i] = t * rounds * 8 + r * 8 + int(i);
+                }
+                size_t n = stack.push_n(in, batch);
+                for (size_t i = 0; i < n; i++) pushed_sum += in[i];
+                n = stack.pop_n(out, batch);
+                for (size_t i = 0; i < n; i++) popped_sum += out[i];
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    int out[8];
+    size_t n;
+    while ((n = stack.pop_n(out, 8)) > 0) {
+        for (size_t i = 0; i < n; i++) popped_sum += out[i];
+    }
+    EXPECT_EQ(pushed_sum.load(), popped_sum.load());
+}
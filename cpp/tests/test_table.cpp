@@ -2,6 +2,10 @@
 #include <zeroipc/table.h>
 #include <vector>
 #include <cstring>
+#include <thread>
+#include <atomic>
+#include <string>
+#include <algorithm>
 
 using namespace zeroipc;
 
@@ -169,6 +173,111 @@ TEST_F(TableTest, AlignmentWorks) {
     EXPECT_EQ(aligned64 % 64, 0);
 }
 
+TEST_F(TableTest, ConcurrentRegistration) {
+    Table table(buffer.data(), 64, buffer.size(), true);
+    
+    constexpr int num_threads = 8;
+    constexpr int names_per_thread = 7;
+    std::atomic<int> contended_wins{0};
+    std::atomic<bool> start{false};
+    
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&, t]() {
+            while (!start.load()) std::this_thread::yield();
+            for (int i = 0; i < names_per_thread; ++i) {
+                std::string name = "t" + std::to_string(t) + "_" + std::to_string(i);
+                uint64_t offset = table.allocate(64);
+                EXPECT_TRUE(table.add(name, offset, 64));
+            }
+            // Every thread races to register the same name; exactly one wins
+            try {
+                if (table.add("contended", table.allocate(64), 64)) {
+                    contended_wins++;
+                }
+            } catch (const std::invalid_argument&) {
+            }
+        });
+    }
+    start.store(true);
+    for (auto& th : threads) th.join();
+    
+    EXPECT_EQ(contended_wins.load(), 1);
+    EXPECT_EQ(table.entry_count(), num_threads * names_per_thread + 1);
+    EXPECT_NE(table.find("contended"), nullptr);
+    
+    // Every published allocation is distinct and non-overlapping
+    std::vector<std::pair<uint64_t, uint64_t>> ranges;
+    for (int t = 0; t < num_threads; ++t) {
+        for (int i = 0; i < names_per_thread; ++i) {
+            auto* e = table.find("t" + std::to_string(t) + "_" + std::to_string(i));
+            ASSERT_NE(e, nullptr);
+            ranges.emplace_back(e->offset, e->offset + e->size);
+        }
+    }
+    std::sort(ranges.begin(), ranges.end());
+    for (size_t i = 1; i < ranges.size(); ++i) {
+        EXPECT_LE(ranges[i - 1].second, ranges[i].first);
+    }
+}
+
+TEST_F(TableTest, StalledRegistrarCannotPublishLate) {
+    Table table(buffer.data(), 64, buffer.size(), true);
+
+    // A registrar reserves slot 0 and stalls before claiming it
+    auto* header = reinterpret_cast<Table::Header*>(buffer.data());
+    auto* entries = reinterpret_cast<Table::Entry*>(buffer.data() + sizeof(Table::Header));
+    header->entry_count.fetch_add(1);
+
+    // Another registrar gives up waiting on it and marks it DEAD
+    EXPECT_TRUE(table.add("shared", table.allocate(64), 64));
+    EXPECT_EQ(entries[0].state.load(), Table::ENTRY_DEAD);
+    EXPECT_EQ(table.entry_count(), 1);
+
+    // When the stalled registrar resumes, its PENDING -> CLAIMED CAS fails,
+    // so it can never publish "shared" a second time
+    uint32_t pending = Table::ENTRY_PENDING;
+    EXPECT_FALSE(entries[0].state.compare_exchange_strong(pending, Table::ENTRY_CLAIMED));
+    EXPECT_EQ(table.find("shared"), &entries[1]);
+}
+
+TEST_F(TableTest, StalledRegistrarRetriesInFreshSlot) {
+    Table table(buffer.data(), 64, buffer.size(), true);
+
+    // Slot 0 was given up on while its registrar stalled before claiming
+    auto* entries = reinterpret_cast<Table::Entry*>(buffer.data() + sizeof(Table::Header));
+    entries[0].state.store(Table::ENTRY_DEAD);
+
+    // The claim on slot 0 fails, so the registration moves to slot 1
+    auto offset = table.allocate_entry("late", 64);
+    ASSERT_TRUE(offset.has_value());
+    EXPECT_EQ(table.find("late"), &entries[1]);
+    EXPECT_EQ(entries[1].offset, *offset);
+}
+
+TEST_F(TableTest, LostRegistrationTakesNoSpace) {
+    Table table(buffer.data(), 64, buffer.size(), true);
+
+    // Another registrar holds a live claim on "shared" in slot 0
+    auto* header = reinterpret_cast<Table::Header*>(buffer.data());
+    auto* entries = reinterpret_cast<Table::Entry*>(buffer.data() + sizeof(Table::Header));
+    header->entry_count.fetch_add(1);
+    std::strcpy(entries[0].name, "shared");
+    entries[0].state.store(Table::ENTRY_CLAIMED);
+
+    uint64_t before = table.next_offset();
+    EXPECT_THROW((void)table.allocate_entry("shared", 64), std::invalid_argument);
+    EXPECT_EQ(table.next_offset(), before);
+    EXPECT_EQ(entries[1].state.load(), Table::ENTRY_DEAD);
+
+    // A full table takes no space either
+    Table small(buffer.data(), 1, buffer.size(), true);
+    ASSERT_TRUE(small.allocate_entry("only", 64).has_value());
+    before = small.next_offset();
+    EXPECT_FALSE(small.allocate_entry("more", 64).has_value());
+    EXPECT_EQ(small.next_offset(), before);
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
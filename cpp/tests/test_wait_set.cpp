@@ -0,0 +1,329 @@
+#include <gtest/gtest.h>
+#include <zeroipc/memory.h>
+#include <zeroipc/wait_set.h>
+#include <zeroipc/event.h>
+#include <zeroipc/queue.h>
+#include <zeroipc/channel.h>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "test_config.h"
+
+using namespace zeroipc::test;
+using namespace std::chrono_literals;
+
+class WaitSetTest : public SharedMemoryTestBase {
+};
+
+TEST_F(WaitSetTest, WakesOnAnyEvent) {
+    zeroipc::Memory mem(shm_name_, 1024 * 1024);
+    zeroipc::Event first(mem, "first", zeroipc::EventMode::ManualReset);
+    zeroipc::Event second(mem, "second", zeroipc::EventMode::AutoReset);
+    zeroipc::WaitSet ws(mem, "ws");
+
+    EXPECT_EQ(ws.add(first), 0u);
+    EXPECT_EQ(ws.add(second), 1u);
+    EXPECT_EQ(ws.size(), 2u);
+    EXPECT_FALSE(ws.wait_for(TestTiming::SHORT_TIMEOUT).has_value());
+
+    std::thread signaler([&]() {
+        std::this_thread::sleep_for(TestTiming::SHORT_TIMEOUT);
+        second.signal();
+    });
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(ws.wait(), 1u);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, TestTiming::SHORT_TIMEOUT / 2);
+    signaler.join();
+
+    // Ready until consumed; the lowest ready index wins
+    EXPECT_EQ(ws.wait_for(0ms), 1u);
+    first.signal();
+    EXPECT_EQ(ws.wait(), 0u);
+    first.reset();
+    EXPECT_TRUE(second.wait_for(0ms));
+    EXPECT_FALSE(ws.wait_for(0ms).has_value());
+}
+
+TEST_F(WaitSetTest, QueueReadableAndWritable) {
+    zeroipc::Memory mem(shm_name_, 1024 * 1024);
+    zeroipc::Queue<int> queue(mem, "queue", 2);
+    zeroipc::WaitSet ws(mem, "ws");
+
+    size_t readable = ws.add_readable(queue);
+    EXPECT_FALSE(ws.wait_for(0ms).has_value());
+
+    std::thread producer([&]() {
+        std::this_thread::sleep_for(TestTiming::THREAD_SYNC_DELAY);
+        ASSERT_TRUE(queue.push(7));
+    });
+    EXPECT_EQ(ws.wait(), readable);
+    producer.join();
+    EXPECT_EQ(queue.pop(), 7);
+
+    zeroipc::WaitSet space(mem, "space");
+    size_t writable = space.add_writable(queue);
+    ASSERT_TRUE(queue.push(1));
+    ASSERT_TRUE(queue.push(2));
+    EXPECT_FALSE(space.wait_for(0ms).has_value());
+
+    std::thread consumer([&]() {
+        std::this_thread::sleep_for(TestTiming::THREAD_SYNC_DELAY);
+        EXPECT_EQ(queue.pop(), 1);
+    });
+    EXPECT_EQ(space.wait(), writable);
+    consumer.join();
+}
+
+TEST_F(WaitSetTest, ManyProducersOneConsumer) {
+    zeroipc::Memory mem(shm_name_, 4 * 1024 * 1024);
+    constexpr int QUEUES = 4;
+    constexpr int PER_QUEUE = 500;
+
+    std::vector<std::unique_ptr<zeroipc::Queue<int>>> queues;
+    zeroipc::WaitSet ws(mem, "ws");
+    for (int q = 0; q < QUEUES; q++) {
+        queues.push_back(std::make_unique<zeroipc::Queue<int>>(
+            mem, "queue" + std::to_string(q), 16));
+        ws.add_readable(*queues.back());
+    }
+
+    std::vector<std::thread> producers;
+    for (int q = 0; q < QUEUES; q++) {
+        producers.emplace_back([&, q]() {
+            for (int i = 0; i < PER_QUEUE; i++) {
+                queues[q]->push_wait(i);
+            }
+        });
+    }
+
+    // Every element of every queue arrives, in order per queue
+    std::vector<int> next(QUEUES, 0);
+    int received = 0;
+    while (received < QUEUES * PER_QUEUE) {
+        auto ready = ws.wait_for(TestTiming::LONG_TIMEOUT);
+        ASSERT_TRUE(ready.has_value());
+        while (auto v = queues[*ready]->pop()) {
+            EXPECT_EQ(*v, next[*ready]++);
+            received++;
+        }
+    }
+    for (auto& t : producers) {
+        t.join();
+    }
+}
+
+TEST_F(WaitSetTest, FullWatchListFallsBackToPolling) {
+    zeroipc::Memory mem(shm_name_, 1024 * 1024);
+    zeroipc::Queue<int> queue(mem, "queue", 4);
+
+    std::vector<std::unique_ptr<zeroipc::WaitSet>> others;
+    for (size_t i = 0; i < zeroipc::detail::WatchList::SLOTS; i++) {
+        others.push_back(std::make_unique<zeroipc::WaitSet>(mem, "other" + std::to_string(i)));
+        others.back()->add_readable(queue);
+    }
+
+    zeroipc::WaitSet ws(mem, "ws");
+    ws.add_readable(queue);
+    std::thread producer([&]() {
+        std::this_thread::sleep_for(TestTiming::THREAD_SYNC_DELAY);
+        ASSERT_TRUE(queue.push(1));
+    });
+    EXPECT_EQ(ws.wait_for(TestTiming::LONG_TIMEOUT), 0u);
+    producer.join();
+
+    // Dropping a WaitSet frees its slot
+    others.pop_back();
+    EXPECT_EQ(queue.watch_list()->watchers.load(), zeroipc::detail::WatchList::SLOTS - 1);
+}
+
+TEST_F(WaitSetTest, RejectsObjectsInAnotherSegment) {
+    zeroipc::Memory mem(shm_name_, 1024 * 1024);
+    std::string other_name = shm_name_ + "_other";
+    zeroipc::Memory::unlink(other_name);
+    {
+        zeroipc::Memory other(other_name, 1024 * 1024);
+        zeroipc::Queue<int> queue(other, "queue", 4);
+        zeroipc::WaitSet ws(mem, "ws");
+        EXPECT_THROW(ws.add_readable(queue), std::invalid_argument);
+        EXPECT_EQ(ws.size(), 0u);
+    }
+    zeroipc::Memory::unlink(other_name);
+}
+
+TEST_F(WaitSetTest, SelectReceivesFromReadyChannel) {
+    zeroipc::Memory mem(shm_name_, 1024 * 1024);
+    zeroipc::Channel<int> ints(mem, "ints", size_t(4));
+    zeroipc::Channel<double> doubles(mem, "doubles", size_t(4));
+    zeroipc::WaitSet ws(mem, "ws");
+
+    std::thread sender([&]() {
+        std::this_thread::sleep_for(TestTiming::THREAD_SYNC_DELAY);
+        ASSERT_TRUE(doubles.send(2.5));
+    });
+
+    double got = 0;
+    size_t fired = zeroipc::select(ws,
+        ints.on_recv([](int) { FAIL() << "nothing was sent on ints"; }),
+        doubles.on_recv([&](double d) { got = d; }),
+        zeroipc::timeout(TestTiming::LONG_TIMEOUT, [] { FAIL() << "timed out"; }));
+    sender.join();
+
+    EXPECT_EQ(fired, 1u);
+    EXPECT_EQ(got, 2.5);
+    // Registrations last only for the call
+    EXPECT_EQ(ints.watch_list()->watchers.load(), 0u);
+    EXPECT_EQ(doubles.watch_list()->watchers.load(), 0u);
+}
+
+TEST_F(WaitSetTest, SelectTimeoutAndSend) {
+    zeroipc::Memory mem(shm_name_, 1024 * 1024);
+    zeroipc::Channel<int> ch(mem, "ch", size_t(2));
+    zeroipc::WaitSet ws(mem, "ws");
+
+    bool sent = false;
+    EXPECT_EQ(zeroipc::select(ws, ch.on_send(1, [&] { sent = true; })), 0u);
+    EXPECT_TRUE(sent);
+    ASSERT_TRUE(ch.send(2));
+
+    // Full: only the timeout can fire
+    bool timed_out = false;
+    auto start = std::chrono::steady_clock::now();
+    size_t fired = zeroipc::select(ws,
+        ch.on_send(2, [] { FAIL() << "channel is full"; }),
+        zeroipc::timeout(TestTiming::SHORT_TIMEOUT, [&] { timed_out = true; }));
+    EXPECT_EQ(fired, 1u);
+    EXPECT_TRUE(timed_out);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, TestTiming::SHORT_TIMEOUT);
+
+    // Space opens up while selecting
+    std::thread receiver([&]() {
+        std::this_thread::sleep_for(TestTiming::THREAD_SYNC_DELAY);
+        EXPECT_EQ(ch.recv(), 1);
+    });
+    sent = false;
+    fired = zeroipc::select(ws,
+        ch.on_send(3, [&] { sent = true; }),
+        zeroipc::timeout(TestTiming::LONG_TIMEOUT, [] { FAIL() << "timed out"; }));
+    receiver.join();
+    EXPECT_EQ(fired, 0u);
+    EXPECT_TRUE(sent);
+    EXPECT_EQ(ch.recv(), 2);
+    EXPECT_EQ(ch.recv(), 3);
+}
+
+TEST_F(WaitSetTest, SelectSeesClose) {
+    zeroipc::Memory mem(shm_name_, 1024 * 1024);
+    zeroipc::Channel<int> ch(mem, "ch", size_t(4));
+    zeroipc::WaitSet ws(mem, "ws");
+    ASSERT_TRUE(ch.send(5));
+
+    std::thread closer([&]() {
+        std::this_thread::sleep_for(TestTiming::THREAD_SYNC_DELAY);
+        ch.close();
+    });
+
+    // Buffered values drain first, then a closed channel reports nullopt
+    std::vector<std::optional<int>> got;
+    for (int i = 0; i < 2; i++) {
+        zeroipc::select(ws,
+            ch.on_recv([&](std::optional<int> v) { got.push_back(v); }),
+            zeroipc::timeout(TestTiming::LONG_TIMEOUT, [] { FAIL() << "timed out"; }));
+    }
+    closer.join();
+    ASSERT_EQ(got.size(), 2u);
+    EXPECT_EQ(got[0], 5);
+    EXPECT_FALSE(got[1].has_value());
+}
+
+TEST_F(WaitSetTest, SelectIsFairAcrossReadyChannels) {
+    zeroipc::Memory mem(shm_name_, 1024 * 1024);
+    zeroipc::Channel<int> a(mem, "a", size_t(64));
+    zeroipc::Channel<int> b(mem, "b", size_t(64));
+    zeroipc::WaitSet ws(mem, "ws");
+    for (int i = 0; i < 64; i++) {
+        ASSERT_TRUE(a.send(i));
+        ASSERT_TRUE(b.send(i));
+    }
+
+    int from_a = 0, from_b = 0;
+    for (int i = 0; i < 64; i++) {
+        zeroipc::select(ws,
+            a.on_recv([&](int) { from_a++; }),
+            b.on_recv([&](int) { from_b++; }));
+    }
+    EXPECT_EQ(from_a, 32);
+    EXPECT_EQ(from_b, 32);
+}
+
+TEST_F(WaitSetTest, SelectOnUnbufferedChannel) {
+    zeroipc::Memory mem(shm_name_, 1024 * 1024);
+    zeroipc::Channel<int> ch(mem, "sync");
+    zeroipc::WaitSet ws(mem, "ws");
+
+    std::thread sender([&]() {
+        std::this_thread::sleep_for(TestTiming::THREAD_SYNC_DELAY);
+        EXPECT_TRUE(ch.send(9));
+    });
+    int got = 0;
+    EXPECT_EQ(zeroipc::select(ws,
+        ch.on_recv([&](int v) { got = v; }),
+        zeroipc::timeout(TestTiming::LONG_TIMEOUT, [] { FAIL() << "timed out"; })), 0u);
+    sender.join();
+    EXPECT_EQ(got, 9);
+
+    std::thread receiver([&]() {
+        std::this_thread::sleep_for(TestTiming::THREAD_SYNC_DELAY);
+        EXPECT_EQ(ch.recv(), 10);
+    });
+    EXPECT_EQ(zeroipc::select(ws,
+        ch.on_send(10, [] {}),
+        zeroipc::timeout(TestTiming::LONG_TIMEOUT, [] { FAIL() << "timed out"; })), 0u);
+    receiver.join();
+}
+
+TEST_F(WaitSetTest, CrossProcessWake) {
+    zeroipc::Memory mem(shm_name_, 1024 * 1024);
+    zeroipc::Queue<int> queue(mem, "queue", 8);
+    zeroipc::Event done(mem, "done", zeroipc::EventMode::ManualReset);
+    zeroipc::WaitSet ws(mem, "ws");
+    size_t data = ws.add_readable(queue);
+    size_t finished = ws.add(done);
+
+    pid_t pid = fork();
+    ASSERT_NE(pid, -1);
+    if (pid == 0) {
+        zeroipc::Memory child_mem(shm_name_);
+        zeroipc::Queue<int> child_queue(child_mem, "queue");
+        zeroipc::Event child_done(child_mem, "done");
+        for (int i = 0; i < 3; i++) {
+            std::this_thread::sleep_for(TestTiming::THREAD_SYNC_DELAY);
+            child_queue.push_wait(i);
+        }
+        std::this_thread::sleep_for(TestTiming::THREAD_SYNC_DELAY);
+        child_done.signal();
+        _exit(0);
+    }
+
+    std::vector<int> got;
+    for (;;) {
+        auto ready = ws.wait_for(TestTiming::LONG_TIMEOUT);
+        ASSERT_TRUE(ready.has_value());
+        if (*ready == data) {
+            while (auto v = queue.pop()) {
+                got.push_back(*v);
+            }
+        } else {
+            EXPECT_EQ(*ready, finished);
+            break;
+        }
+    }
+    int status;
+    waitpid(pid, &status, 0);
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+    EXPECT_EQ(got, (std::vector<int>{0, 1, 2}));
+}
@@ -35,7 +35,7 @@
 // Matches SPECIFICATION.md exactly
 struct TableHeader {
     uint32_t magic;         // 0x5A49504D ('ZIPM')
-    uint32_t version;       // Format version (currently 1)
+    uint32_t version;       // Format version (currently 3)
     uint32_t entry_count;   // Number of active entries
     uint32_t reserved;      // Padding/reserved
     uint64_t memory_size;   // Total memory size
@@ -46,8 +46,12 @@ struct TableEntry {
     char name[32];
     uint64_t offset;
     uint64_t size;
+    uint32_t state;         // 2 = published (see SPECIFICATION.md)
+    uint32_t alignment;     // Section alignment (0 = 8)
 };
 
+constexpr uint32_t ENTRY_PUBLISHED = 2;
+
 // Structure headers for detection
 struct ArrayHeader {
     uint64_t capacity;
@@ -190,6 +194,9 @@ public:
         std::cout << std::string(verbose ? 75 : 60, '-') << "\n";
 
         for (uint32_t i = 0; i < header_->entry_count; i++) {
+            if (entries_[i].state != ENTRY_PUBLISHED) {
+                continue;  // Registration in progress or abandoned
+            }
             std::cout << std::left << std::setw(4) << i
                       << std::setw(32) << entries_[i].name
                       << "0x" << std::hex << std::setw(10) << entries_[i].offset << std::dec
@@ -214,6 +221,7 @@ public:
                   << " (" << entry->offset << " bytes)\n";
         std::cout << "Size: " << formatSize(entry->size)
                   << " (" << entry->size << " bytes)\n";
+        std::cout << "Alignment: " << (entry->alignment ? entry->alignment : 8) << " bytes\n";
 
         std::string type = detectStructureType(*entry);
         std::cout << "Type: " << type << "\n\n";
@@ -260,10 +268,15 @@ public:
         }
         else if (type == "Stack") {
             const StackHeader* hdr = reinterpret_cast<const StackHeader*>(data);
-            std::cout << "Top: " << hdr->top << "\n";
+            int32_t top = hdr->top;
+            if (hdr->elem_size & zeroipc::STACK_LAYOUT_PADDED_TOP) {
+                std::memcpy(&top, data + zeroipc::STACK_PADDED_TOP_OFFSET, sizeof(top));
+            }
+            std::cout << "Top: " << top << "\n";
             std::cout << "Capacity: " << hdr->capacity << " elements\n";
-            std::cout << "Current Items: " << (hdr->top + 1) << "\n";
-            std::cout << "Element Size: " << hdr->elem_size << " bytes\n";
+            std::cout << "Current Items: " << (top + 1) << "\n";
+            std::cout << "Element Size: " << (hdr->elem_size & zeroipc::STACK_ELEM_SIZE_MASK)
+                      << " bytes\n";
         }
     }
 
@@ -334,7 +347,8 @@ private:
 
     TableEntry* findEntry(const std::string& name) {
         for (uint32_t i = 0; i < header_->entry_count; i++) {
-            if (strcmp(entries_[i].name, name.c_str()) == 0) {
+            if (entries_[i].state == ENTRY_PUBLISHED &&
+                strcmp(entries_[i].name, name.c_str()) == 0) {
                 return &entries_[i];
             }
         }
@@ -13,15 +13,17 @@ const ArrayHeaderSize = 8
 // Array is a fixed-size array in shared memory.
 // The element type must be a fixed-size type (numeric types).
 //
-// Binary layout:
+// Binary layout (A is the section alignment from the table entry, 8 for
+// arrays created here):
 //   - capacity: uint64 (8 bytes)
-//   - data: capacity * sizeof(T) bytes
+//   - data: capacity * sizeof(T) bytes (at alignUp(8, A))
 type Array[T Numeric] struct {
 	memory   *Memory
 	name     string
 	offset   int
 	capacity int
 	elemSize int
+	dataOff  int // data array, relative to offset
 }
 
 // Numeric constrains Array elements to numeric types that are binary-compatible.
@@ -50,7 +52,8 @@ func NewArray[T Numeric](memory *Memory, name string, capacity int) (*Array[T],
 	}
 
 	// Allocate space
-	totalSize := ArrayHeaderSize + capacity*elemSize
+	dataOff := alignUp(ArrayHeaderSize, MinSectionAlign)
+	totalSize := dataOff + capacity*elemSize
 	offset, err := memory.Allocate(name, totalSize)
 	if err != nil {
 		return nil, fmt.Errorf("failed to allocate: %w", err)
@@ -60,7 +63,7 @@ func NewArray[T Numeric](memory *Memory, name string, capacity int) (*Array[T],
 	binary.LittleEndian.PutUint64(memory.Data()[offset:offset+8], uint64(capacity))
 
 	// Zero-initialize data
-	dataStart := offset + ArrayHeaderSize
+	dataStart := offset + dataOff
 	dataEnd := dataStart + capacity*elemSize
 	for i := dataStart; i < dataEnd; i++ {
 		memory.Data()[i] = 0
@@ -72,6 +75,7 @@ func NewArray[T Numeric](memory *Memory, name string, capacity int) (*Array[T],
 		offset:   offset,
 		capacity: capacity,
 		elemSize: elemSize,
+		dataOff:  dataOff,
 	}, nil
 }
 
@@ -89,8 +93,9 @@ func OpenArray[T Numeric](memory *Memory, name string) (*Array[T], error) {
 	offset := int(entry.Offset)
 	capacity := binary.LittleEndian.Uint64(memory.Data()[offset : offset+8])
 
-	// Validate size
-	expectedSize := ArrayHeaderSize + int(capacity)*elemSize
+	// Validate size (sections follow the alignment recorded by the creator)
+	dataOff := alignUp(ArrayHeaderSize, entry.SectionAlign())
+	expectedSize := dataOff + int(capacity)*elemSize
 	if int(entry.Size) != expectedSize {
 		return nil, fmt.Errorf("size mismatch: expected %d, got %d (wrong element type?)",
 			expectedSize, entry.Size)
@@ -102,6 +107,7 @@ func OpenArray[T Numeric](memory *Memory, name string) (*Array[T], error) {
 		offset:   offset,
 		capacity: int(capacity),
 		elemSize: elemSize,
+		dataOff:  dataOff,
 	}, nil
 }
 
@@ -111,7 +117,7 @@ func (a *Array[T]) Get(index int) T {
 		panic(fmt.Sprintf("index %d out of bounds (capacity=%d)", index, a.capacity))
 	}
 
-	dataOffset := a.offset + ArrayHeaderSize + index*a.elemSize
+	dataOffset := a.offset + a.dataOff + index*a.elemSize
 	return *(*T)(unsafe.Pointer(&a.memory.Data()[dataOffset]))
 }
 
@@ -121,7 +127,7 @@ func (a *Array[T]) Set(index int, value T) {
 		panic(fmt.Sprintf("index %d out of bounds (capacity=%d)", index, a.capacity))
 	}
 
-	dataOffset := a.offset + ArrayHeaderSize + index*a.elemSize
+	dataOffset := a.offset + a.dataOff + index*a.elemSize
 	*(*T)(unsafe.Pointer(&a.memory.Data()[dataOffset])) = value
 }
 
@@ -39,7 +39,7 @@ func TestStackCrashedPeerBoundedSpin(t *testing.T) {
 	if entry == nil {
 		t.Fatalf("table entry not found")
 	}
-	sideOff := StackHeaderSize + align8(4*8)
+	sideOff := StackHeaderSize + alignUp(4*8, MinSectionAlign)
 	stateAt := func(i int) *uint32 {
 		return (*uint32)(unsafe.Pointer(&mem.Data()[int(entry.Offset)+sideOff+i*4]))
 	}
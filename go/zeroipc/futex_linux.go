@@ -0,0 +1,32 @@
+//go:build linux
+
+package zeroipc
+
+import (
+	"math"
+	"time"
+	"unsafe"
+
+	"golang.org/x/sys/unix"
+)
+
+// futex(2) operations; process-shared, so no FUTEX_PRIVATE_FLAG
+const (
+	futexWaitOp = 0
+	futexWakeOp = 1
+)
+
+// futexWait sleeps while *addr == expected, for at most timeout. It may
+// return early; callers re-check their condition. Wakers may live in other
+// processes (C, C++, Python).
+func futexWait(addr *uint32, expected uint32, timeout time.Duration) {
+	ts := unix.NsecToTimespec(int64(timeout))
+	_, _, _ = unix.Syscall6(unix.SYS_FUTEX, uintptr(unsafe.Pointer(addr)),
+		futexWaitOp, uintptr(expected), uintptr(unsafe.Pointer(&ts)), 0, 0)
+}
+
+// futexWakeAll wakes every waiter sleeping on addr.
+func futexWakeAll(addr *uint32) {
+	_, _, _ = unix.Syscall6(unix.SYS_FUTEX, uintptr(unsafe.Pointer(addr)),
+		futexWakeOp, uintptr(math.MaxInt32), 0, 0, 0)
+}
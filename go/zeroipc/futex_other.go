@@ -0,0 +1,17 @@
+//go:build !linux
+
+package zeroipc
+
+import (
+	"sync/atomic"
+	"time"
+)
+
+// futexWait polls briefly in place of a futex so waiters still make progress.
+func futexWait(addr *uint32, expected uint32, timeout time.Duration) {
+	if atomic.LoadUint32(addr) == expected {
+		time.Sleep(min(timeout, 100*time.Microsecond))
+	}
+}
+
+func futexWakeAll(addr *uint32) {}
@@ -15,7 +15,7 @@ import (
 )
 
 // specAlign8 is the spec formula, written independently of the
-// implementation's align8 so a drift in either shows up.
+// implementation's alignUp so a drift in either shows up.
 func specAlign8(n int) int { return (n + 7) &^ 7 }
 
 func checkQueueLayout[T Numeric](t *testing.T, mem *Memory, name string, capacity int) {
@@ -125,3 +125,245 @@ func TestSectionAlignmentLayout(t *testing.T) {
 	checkStackLayout[uint32](t, mem, "s_u32", 5)
 	checkStackLayout[float64](t, mem, "s_f64", 5)
 }
+
+// A queue written by another language with 64-byte section alignment (e.g.
+// C++ Queue<T> with an alignas(64) T) puts data at 64 and the sequence array
+// at the next 64-byte boundary after the data. Opening it must honor the
+// recorded alignment.
+func TestOverAlignedQueueOpen(t *testing.T) {
+	name := fmt.Sprintf("/test_layout_a64_%d", os.Getpid())
+	mem, err := NewMemory(name, 1024*1024, 64)
+	if err != nil {
+		t.Fatalf("NewMemory failed: %v", err)
+	}
+	defer func() {
+		mem.Close()
+		mem.Unlink()
+	}()
+
+	const align, capacity = 64, 4
+	dataOff := align          // alignUp(16, 64)
+	seqOff := dataOff + align // 32 bytes of data, padded to 64
+	offset, err := mem.AllocateAligned("q_a64", seqOff+capacity*4, align)
+	if err != nil {
+		t.Fatalf("AllocateAligned failed: %v", err)
+	}
+	if offset%align != 0 {
+		t.Fatalf("offset %d not %d-aligned", offset, align)
+	}
+	if got := mem.Find("q_a64").SectionAlign(); got != align {
+		t.Fatalf("recorded alignment = %d, want %d", got, align)
+	}
+
+	data := mem.Data()
+	binary.LittleEndian.PutUint32(data[offset+8:], capacity)
+	binary.LittleEndian.PutUint32(data[offset+12:], 8)
+	for i := 0; i < capacity; i++ {
+		binary.LittleEndian.PutUint32(data[offset+seqOff+i*4:], uint32(i))
+	}
+
+	q, err := OpenQueue[uint64](mem, "q_a64")
+	if err != nil {
+		t.Fatalf("OpenQueue failed: %v", err)
+	}
+	if !q.Push(0xABCD) {
+		t.Fatal("push failed")
+	}
+	if got := binary.LittleEndian.Uint64(data[offset+dataOff:]); got != 0xABCD {
+		t.Errorf("data at spec offset = %#x, want 0xABCD", got)
+	}
+	if got := binary.LittleEndian.Uint32(data[offset+seqOff:]); got != 1 {
+		t.Errorf("seq[0] at spec offset = %d, want 1", got)
+	}
+	if v, ok := q.Pop(); !ok || v != 0xABCD {
+		t.Errorf("pop = %#x, %v", v, ok)
+	}
+
+	// Bases are cache-line aligned; bad alignments are rejected
+	if _, err := NewArray[uint8](mem, "small", 1); err != nil {
+		t.Fatalf("NewArray failed: %v", err)
+	}
+	if off := int(mem.Find("small").Offset); off%CacheLineSize != 0 {
+		t.Errorf("array base %d not cache-line aligned", off)
+	}
+	if _, err := mem.AllocateAligned("bad", 64, 24); err == nil {
+		t.Error("alignment 24 accepted")
+	}
+	if _, err := mem.AllocateAligned("huge", 64, 8192); err == nil {
+		t.Error("alignment 8192 accepted")
+	}
+}
+
+// Interleaved queues store each slot as {element, seq}; the layout is
+// recorded in the high byte of elem_size so OpenQueue picks it up.
+func TestInterleavedQueueLayout(t *testing.T) {
+	name := fmt.Sprintf("/test_layout_inter_%d", os.Getpid())
+	mem, err := NewMemory(name, 1024*1024, 64)
+	if err != nil {
+		t.Fatalf("NewMemory failed: %v", err)
+	}
+	defer func() {
+		mem.Close()
+		mem.Unlink()
+	}()
+
+	q, err := NewQueueWithLayout[uint32](mem, "q_pad", 4, QueueInterleavedPadded)
+	if err != nil {
+		t.Fatalf("NewQueueWithLayout failed: %v", err)
+	}
+	entry := mem.Find("q_pad")
+	offset := int(entry.Offset)
+	if want := uint64(CacheLineSize + 4*CacheLineSize); entry.Size != want {
+		t.Errorf("size = %d, want %d", entry.Size, want)
+	}
+	data := mem.Data()
+	if got := binary.LittleEndian.Uint32(data[offset+12:]); got != 4|uint32(QueueInterleavedPadded) {
+		t.Errorf("elem_size field = %#x", got)
+	}
+
+	if !q.Push(0xBEEF) {
+		t.Fatal("push failed")
+	}
+	slot0 := offset + CacheLineSize
+	if got := binary.LittleEndian.Uint32(data[slot0:]); got != 0xBEEF {
+		t.Errorf("slot 0 data = %#x, want 0xBEEF", got)
+	}
+	if got := binary.LittleEndian.Uint32(data[slot0+4:]); got != 1 {
+		t.Errorf("slot 0 seq = %d, want 1", got)
+	}
+	if got := binary.LittleEndian.Uint32(data[slot0+CacheLineSize+4:]); got != 1 {
+		t.Errorf("slot 1 seq = %d, want 1 (untouched)", got)
+	}
+
+	opened, err := OpenQueue[uint32](mem, "q_pad")
+	if err != nil {
+		t.Fatalf("OpenQueue failed: %v", err)
+	}
+	if v, ok := opened.Pop(); !ok || v != 0xBEEF {
+		t.Errorf("pop = %#x, %v", v, ok)
+	}
+	if _, err := OpenQueue[uint16](mem, "q_pad"); err == nil {
+		t.Error("element size mismatch accepted")
+	}
+
+	// Unpadded: an 8-byte element and its seq share a 16-byte slot
+	q8, err := NewQueueWithLayout[uint64](mem, "q_inter", 8, QueueInterleaved)
+	if err != nil {
+		t.Fatalf("NewQueueWithLayout failed: %v", err)
+	}
+	if want := uint64(QueueHeaderSize + 8*16); mem.Find("q_inter").Size != want {
+		t.Errorf("size = %d, want %d", mem.Find("q_inter").Size, want)
+	}
+	for i := uint64(0); i < 8; i++ {
+		if !q8.Push(i) {
+			t.Fatalf("push %d failed", i)
+		}
+	}
+	if q8.Push(8) {
+		t.Error("push into full queue succeeded")
+	}
+	for i := uint64(0); i < 8; i++ {
+		if v, ok := q8.Pop(); !ok || v != i {
+			t.Errorf("pop = %d, %v; want %d", v, ok, i)
+		}
+	}
+}
+
+// QueuePaddedHeader moves head and tail to offsets 64 and 128 and starts
+// the slots at 192; the header's own counters stay zero.
+func TestQueuePaddedHeader(t *testing.T) {
+	name := fmt.Sprintf("/test_layout_hdr_%d", os.Getpid())
+	mem, err := NewMemory(name, 1024*1024, 64)
+	if err != nil {
+		t.Fatalf("NewMemory failed: %v", err)
+	}
+	defer func() {
+		mem.Close()
+		mem.Unlink()
+	}()
+
+	q, err := NewQueueWithLayout[uint32](mem, "q_hdr", 4, QueueSplit|QueuePaddedHeader)
+	if err != nil {
+		t.Fatalf("NewQueueWithLayout failed: %v", err)
+	}
+	entry := mem.Find("q_hdr")
+	offset := int(entry.Offset)
+	if want := uint64(192 + 4*4 + 4*4); entry.Size != want {
+		t.Errorf("size = %d, want %d", entry.Size, want)
+	}
+	if !q.Push(0xBEEF) {
+		t.Fatal("push failed")
+	}
+	data := mem.Data()
+	if got := binary.LittleEndian.Uint32(data[offset+128:]); got != 1 {
+		t.Errorf("tail = %d, want 1", got)
+	}
+	if got := binary.LittleEndian.Uint32(data[offset+4:]); got != 0 {
+		t.Errorf("header tail = %d, want 0", got)
+	}
+	if got := binary.LittleEndian.Uint32(data[offset+192:]); got != 0xBEEF {
+		t.Errorf("slot 0 = %#x, want 0xBEEF", got)
+	}
+
+	opened, err := OpenQueue[uint32](mem, "q_hdr")
+	if err != nil {
+		t.Fatalf("OpenQueue failed: %v", err)
+	}
+	if v, ok := opened.Pop(); !ok || v != 0xBEEF {
+		t.Errorf("pop = %#x, %v", v, ok)
+	}
+	if got := binary.LittleEndian.Uint32(data[offset+64:]); got != 1 {
+		t.Errorf("head = %d, want 1", got)
+	}
+}
+
+// StackPaddedTop moves top to offset 64 and starts the data at 128; the
+// header's own top stays -1.
+func TestStackPaddedTop(t *testing.T) {
+	name := fmt.Sprintf("/test_layout_stop_%d", os.Getpid())
+	mem, err := NewMemory(name, 1024*1024, 64)
+	if err != nil {
+		t.Fatalf("NewMemory failed: %v", err)
+	}
+	defer func() {
+		mem.Close()
+		mem.Unlink()
+	}()
+
+	if _, err := NewStackWithLayout[uint32](mem, "s_bad", 4, StackLayout(0x01000000)); err == nil {
+		t.Error("unknown layout accepted")
+	}
+	s, err := NewStackWithLayout[uint32](mem, "s_pad", 4, StackPaddedTop)
+	if err != nil {
+		t.Fatalf("NewStackWithLayout failed: %v", err)
+	}
+	entry := mem.Find("s_pad")
+	offset := int(entry.Offset)
+	if want := uint64(128 + 4*4 + 4*4); entry.Size != want {
+		t.Errorf("size = %d, want %d", entry.Size, want)
+	}
+	if !s.Push(0xBEEF) {
+		t.Fatal("push failed")
+	}
+	data := mem.Data()
+	if got := int32(binary.LittleEndian.Uint32(data[offset+64:])); got != 0 {
+		t.Errorf("top = %d, want 0", got)
+	}
+	if got := int32(binary.LittleEndian.Uint32(data[offset:])); got != -1 {
+		t.Errorf("header top = %d, want -1", got)
+	}
+	if got := binary.LittleEndian.Uint32(data[offset+128:]); got != 0xBEEF {
+		t.Errorf("slot 0 = %#x, want 0xBEEF", got)
+	}
+
+	opened, err := OpenStack[uint32](mem, "s_pad")
+	if err != nil {
+		t.Fatalf("OpenStack failed: %v", err)
+	}
+	if v, ok := opened.Pop(); !ok || v != 0xBEEF {
+		t.Errorf("pop = %#x, %v", v, ok)
+	}
+	if !s.Empty() {
+		t.Error("stack not empty after pop")
+	}
+}
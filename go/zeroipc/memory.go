@@ -125,13 +125,19 @@ func (m *Memory) IsOwner() bool {
 	return m.owner
 }
 
-// Allocate reserves space in shared memory and adds an entry to the table.
+// Allocate reserves space in shared memory and adds an entry to the table,
+// using the default section alignment.
 func (m *Memory) Allocate(name string, size int) (int, error) {
-	offset := m.table.Allocate(size, 8)
-	if err := m.table.Add(name, uint64(offset), uint64(size)); err != nil {
-		return 0, err
-	}
-	return offset, nil
+	return m.AllocateAligned(name, size, MinSectionAlign)
+}
+
+// AllocateAligned reserves space with the given section alignment (a power
+// of two up to MaxAllocAlign) and records it in the table entry. The base is
+// always placed on its own cache line, or on alignment if larger.
+func (m *Memory) AllocateAligned(name string, size int, alignment int) (int, error) {
+	// The name is claimed before any space is taken, so a failed
+	// registration leaves next_offset alone
+	return m.table.AllocateEntry(name, size, alignment)
 }
 
 // Find looks up an entry in the table.
@@ -1,7 +1,9 @@
 package zeroipc
 
 import (
+	"fmt"
 	"os"
+	"sync"
 	"testing"
 )
 
@@ -51,6 +53,121 @@ func TestMemoryCreateAndOpen(t *testing.T) {
 	}
 }
 
+func TestTableConcurrentRegistration(t *testing.T) {
+	name := "/test_go_table_concurrent"
+	UnlinkName(name)
+
+	mem, err := NewMemory(name, 1024*1024, 128)
+	if err != nil {
+		t.Fatalf("NewMemory failed: %v", err)
+	}
+	defer mem.Close()
+	defer mem.Unlink()
+
+	const workers = 8
+	const perWorker = 12
+	table := mem.Table()
+
+	var wg sync.WaitGroup
+	var winners sync.Map
+	for w := 0; w < workers; w++ {
+		wg.Add(1)
+		go func(w int) {
+			defer wg.Done()
+			for i := 0; i < perWorker; i++ {
+				off := table.Allocate(64, 8)
+				if err := table.Add(fmt.Sprintf("w%d_%d", w, i), uint64(off), 64); err != nil {
+					t.Errorf("Add failed: %v", err)
+				}
+			}
+			off := table.Allocate(64, 8)
+			if table.Add("contended", uint64(off), 64) == nil {
+				winners.Store(w, true)
+			}
+		}(w)
+	}
+	wg.Wait()
+
+	wins := 0
+	winners.Range(func(_, _ any) bool { wins++; return true })
+	if wins != 1 {
+		t.Errorf("Expected exactly one winner for contended name, got %d", wins)
+	}
+	if got := table.EntryCount(); got != workers*perWorker+1 {
+		t.Errorf("Expected %d entries, got %d", workers*perWorker+1, got)
+	}
+
+	// Published allocations must not overlap
+	seen := make(map[uint64]bool)
+	for _, e := range table.Entries() {
+		if seen[e.Offset] {
+			t.Errorf("Offset %d handed out twice", e.Offset)
+		}
+		seen[e.Offset] = true
+	}
+}
+
+func TestTableLostRegistrationTakesNoSpace(t *testing.T) {
+	name := "/test_go_table_lost"
+	UnlinkName(name)
+
+	mem, err := NewMemory(name, 1024*1024, 2)
+	if err != nil {
+		t.Fatalf("NewMemory failed: %v", err)
+	}
+	defer mem.Close()
+	defer mem.Unlink()
+	table := mem.Table()
+
+	// Another registrar holds a live claim on "shared" in slot 0
+	*table.entryCountPtr() = 1
+	copy(table.Entry(0).Name[:], "shared")
+	table.Entry(0).State = EntryClaimed
+
+	before := table.NextOffset()
+	if _, err := mem.Allocate("shared", 64); err == nil {
+		t.Fatal("Expected losing registration to fail")
+	}
+	if table.NextOffset() != before {
+		t.Errorf("Losing registration took space: %d -> %d", before, table.NextOffset())
+	}
+	if table.Entry(1).State != EntryDead {
+		t.Errorf("Losing slot state = %d, want dead", table.Entry(1).State)
+	}
+
+	// The table is now full; that takes no space either
+	if _, err := mem.Allocate("more", 64); err == nil {
+		t.Fatal("Expected full table to fail")
+	}
+	if table.NextOffset() != before {
+		t.Errorf("Full-table registration took space")
+	}
+}
+
+func TestTableStalledRegistrationRetries(t *testing.T) {
+	name := "/test_go_table_stalled"
+	UnlinkName(name)
+
+	mem, err := NewMemory(name, 1024*1024, 4)
+	if err != nil {
+		t.Fatalf("NewMemory failed: %v", err)
+	}
+	defer mem.Close()
+	defer mem.Unlink()
+	table := mem.Table()
+
+	// Slot 0 was given up on while its registrar stalled before claiming
+	table.Entry(0).State = EntryDead
+
+	offset, err := mem.Allocate("late", 64)
+	if err != nil {
+		t.Fatalf("Allocate failed: %v", err)
+	}
+	if e := table.Find("late"); e != table.Entry(1) || e.Offset != uint64(offset) {
+		t.Errorf("Expected registration to move to slot 1")
+	}
+}
+
 func TestArrayCreateAndAccess(t *testing.T) {
 	name := "/test_go_array"
 	size := 1024 * 1024
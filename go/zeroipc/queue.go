@@ -12,6 +12,62 @@ import (
 // Layout: head(4) + tail(4) + capacity(4) + elem_size(4) = 16 bytes
 const QueueHeaderSize = 16
 
+// QueueLayout selects how a queue's slots are laid out. It is recorded in
+// the high byte of the header's elem_size field, so every reader decodes it.
+type QueueLayout uint32
+
+const (
+	// QueueSplit keeps the data array and the sequence array apart.
+	QueueSplit QueueLayout = 0
+	// QueueInterleaved stores each slot as {element, seq} so a push or pop
+	// usually touches one cache line.
+	QueueInterleaved QueueLayout = 0x01000000
+	// QueueInterleavedPadded also pads every slot to whole cache lines.
+	QueueInterleavedPadded QueueLayout = 0x03000000
+	// QueuePaddedHeader can be or-ed into any layout. It moves head and
+	// tail onto cache lines of their own (offsets 64 and 128; the header's
+	// fields stay 0) and starts the slots after them, so producers and
+	// consumers stop false-sharing the counters.
+	QueuePaddedHeader QueueLayout = 0x04000000
+
+	queueLayoutPadded = 0x02000000
+	queueElemSizeMask = 0x00FFFFFF
+
+	queuePaddedHeadOffset = CacheLineSize
+	queuePaddedTailOffset = 2 * CacheLineSize
+	queuePaddedHeaderSize = 3 * CacheLineSize
+)
+
+// validQueueLayout reports whether layout is a known slot layout, with or
+// without QueuePaddedHeader.
+func validQueueLayout(layout QueueLayout) bool {
+	layout &^= QueuePaddedHeader
+	return layout == QueueSplit || layout == QueueInterleaved || layout == QueueInterleavedPadded
+}
+
+// queueGeometry returns where slot i lives for a layout: the element at
+// dataOff + i*dataStride, the sequence number at seqOff + i*seqStride, and
+// the end of the last slot (all relative to the header).
+func queueGeometry(layout QueueLayout, capacity, elemSize, align int) (dataOff, dataStride, seqOff, seqStride, end int) {
+	headerSize := QueueHeaderSize
+	if layout&QueuePaddedHeader != 0 {
+		headerSize = queuePaddedHeaderSize
+	}
+	if layout&QueueInterleaved == 0 {
+		dataOff = alignUp(headerSize, align)
+		seqOff = dataOff + alignUp(capacity*elemSize, align)
+		return dataOff, elemSize, seqOff, 4, seqOff + capacity*4
+	}
+	slotAlign := align
+	if layout&queueLayoutPadded != 0 {
+		slotAlign = max(align, CacheLineSize)
+	}
+	seqInSlot := alignUp(elemSize, 4)
+	stride := alignUp(seqInSlot+4, slotAlign)
+	dataOff = alignUp(headerSize, slotAlign)
+	return dataOff, stride, dataOff + seqInSlot, stride, dataOff + stride*capacity
+}
+
 // nextPowerOfTwo rounds n up to the next power of two. Queue capacities must
 // be powers of two so the Vyukov slot mapping (counter % capacity) stays
 // correct across the 2^32 counter wraparound.
@@ -26,23 +82,38 @@ func nextPowerOfTwo(n int) int {
 // Queue is a lock-free MPMC (multi-producer multi-consumer) circular buffer
 // using the Vyukov bounded queue algorithm with per-slot sequence numbers.
 //
-// Binary layout (matching C++, format v2):
+// Binary layout (matching C++; A is the section alignment from the table
+// entry, 8 for queues created here):
 //   - head: uint32 (atomic, offset 0)
 //   - tail: uint32 (atomic, offset 4)
 //   - capacity: uint32 (offset 8) - always a power of two
-//   - elem_size: uint32 (offset 12)
-//   - data: capacity * elem_size bytes (offset 16)
-//   - sequence: capacity * 4 bytes (at align8(16 + elem_size*capacity)) - per-slot sequence numbers
+//   - elem_size: uint32 (offset 12) - low 24 bits; the high byte is the QueueLayout
+//   - data: capacity * elem_size bytes (at alignUp(16, A))
+//   - sequence: capacity * 4 bytes (at alignUp(data + elem_size*capacity, A)) - per-slot sequence numbers
+//
+// Interleaved layouts instead store slot i as [element][pad to 4][seq:u32]
+// padded to the slot alignment (A, or a cache line when padded).
 type Queue[T Numeric] struct {
-	memory   *Memory
-	name     string
-	offset   int
-	capacity uint32
-	elemSize uint32
+	memory     *Memory
+	name       string
+	offset     int
+	capacity   uint32
+	elemSize   uint32
+	dataOff    int // slot 0's element, relative to offset
+	dataStride int
+	seqOff     int // slot 0's sequence number, relative to offset
+	seqStride  int
+	headOff    int // head counter, relative to offset
+	tailOff    int
 }
 
 // NewQueue creates a new queue in shared memory.
 func NewQueue[T Numeric](memory *Memory, name string, capacity int) (*Queue[T], error) {
+	return NewQueueWithLayout[T](memory, name, capacity, QueueSplit)
+}
+
+// NewQueueWithLayout creates a new queue with the given slot layout.
+func NewQueueWithLayout[T Numeric](memory *Memory, name string, capacity int, layout QueueLayout) (*Queue[T], error) {
 	if len(name) >= NameSize {
 		return nil, errors.New("name too long (max 31 characters)")
 	}
@@ -58,13 +129,16 @@ func NewQueue[T Numeric](memory *Memory, name string, capacity int) (*Queue[T],
 	var zero T
 	elemSize := int(unsafe.Sizeof(zero))
 
+	if !validQueueLayout(layout) {
+		return nil, fmt.Errorf("unknown queue layout %#x", uint32(layout))
+	}
+
 	// Check if already exists
 	if entry := memory.Find(name); entry != nil {
 		return nil, fmt.Errorf("queue '%s' already exists", name)
 	}
 
-	// Layout: [Header(16)][data: T*capacity][pad][sequence: uint32*capacity]
-	totalSize := QueueHeaderSize + align8(capacity*elemSize) + capacity*4
+	dataOff, dataStride, seqOff, seqStride, totalSize := queueGeometry(layout, capacity, elemSize, MinSectionAlign)
 	offset, err := memory.Allocate(name, totalSize)
 	if err != nil {
 		return nil, fmt.Errorf("failed to allocate: %w", err)
@@ -73,34 +147,48 @@ func NewQueue[T Numeric](memory *Memory, name string, capacity int) (*Queue[T],
 	data := memory.Data()
 
 	// Write header
-	binary.LittleEndian.PutUint32(data[offset:], 0)                   // head
-	binary.LittleEndian.PutUint32(data[offset+4:], 0)                 // tail
-	binary.LittleEndian.PutUint32(data[offset+8:], uint32(capacity))  // capacity
-	binary.LittleEndian.PutUint32(data[offset+12:], uint32(elemSize)) // elem_size
-
-	// Zero-initialize data area
-	dataStart := offset + QueueHeaderSize
-	dataEnd := dataStart + capacity*elemSize
-	for i := dataStart; i < dataEnd; i++ {
+	binary.LittleEndian.PutUint32(data[offset:], 0)                                  // head
+	binary.LittleEndian.PutUint32(data[offset+4:], 0)                                // tail
+	binary.LittleEndian.PutUint32(data[offset+8:], uint32(capacity))                 // capacity
+	binary.LittleEndian.PutUint32(data[offset+12:], uint32(elemSize)|uint32(layout)) // elem_size
+
+	headOff, tailOff := queueCounterOffsets(layout)
+	binary.LittleEndian.PutUint32(data[offset+headOff:], 0)
+	binary.LittleEndian.PutUint32(data[offset+tailOff:], 0)
+
+	// Zero-initialize the slots
+	for i := offset + dataOff; i < offset+totalSize; i++ {
 		data[i] = 0
 	}
 
-	// Initialize per-slot sequence numbers: sequence[i] = i (8-aligned start)
-	seqStart := dataStart + align8(capacity*elemSize)
+	// Initialize per-slot sequence numbers: sequence[i] = i
 	for i := 0; i < capacity; i++ {
-		seqOffset := seqStart + i*4
-		binary.LittleEndian.PutUint32(data[seqOffset:], uint32(i))
+		binary.LittleEndian.PutUint32(data[offset+seqOff+i*seqStride:], uint32(i))
 	}
 
 	return &Queue[T]{
-		memory:   memory,
-		name:     name,
-		offset:   offset,
-		capacity: uint32(capacity),
-		elemSize: uint32(elemSize),
+		memory:     memory,
+		name:       name,
+		offset:     offset,
+		capacity:   uint32(capacity),
+		elemSize:   uint32(elemSize),
+		dataOff:    dataOff,
+		dataStride: dataStride,
+		seqOff:     seqOff,
+		seqStride:  seqStride,
+		headOff:    headOff,
+		tailOff:    tailOff,
 	}, nil
 }
 
+// queueCounterOffsets returns where head and tail live for a layout.
+func queueCounterOffsets(layout QueueLayout) (headOff, tailOff int) {
+	if layout&QueuePaddedHeader != 0 {
+		return queuePaddedHeadOffset, queuePaddedTailOffset
+	}
+	return 0, 4
+}
+
 // OpenQueue opens an existing queue in shared memory.
 func OpenQueue[T Numeric](memory *Memory, name string) (*Queue[T], error) {
 	entry := memory.Find(name)
@@ -117,6 +205,8 @@ func OpenQueue[T Numeric](memory *Memory, name string) (*Queue[T], error) {
 	// Read header
 	capacity := binary.LittleEndian.Uint32(data[offset+8:])
 	storedElemSize := binary.LittleEndian.Uint32(data[offset+12:])
+	layout := QueueLayout(storedElemSize &^ queueElemSizeMask)
+	storedElemSize &= queueElemSizeMask
 
 	if int(storedElemSize) != elemSize {
 		return nil, fmt.Errorf("element size mismatch: stored %d, expected %d", storedElemSize, elemSize)
@@ -128,29 +218,45 @@ func OpenQueue[T Numeric](memory *Memory, name string) (*Queue[T], error) {
 		return nil, fmt.Errorf("queue capacity %d is not a power of two (created by an old implementation?)", capacity)
 	}
 
+	if !validQueueLayout(layout) {
+		return nil, fmt.Errorf("unknown queue layout %#x", uint32(layout))
+	}
+
+	// Sections follow the alignment recorded by the creator
+	dataOff, dataStride, seqOff, seqStride, end := queueGeometry(layout, int(capacity), elemSize, entry.SectionAlign())
+	if end > int(entry.Size) {
+		return nil, fmt.Errorf("queue '%s' is smaller than its header describes", name)
+	}
+	headOff, tailOff := queueCounterOffsets(layout)
+
 	return &Queue[T]{
-		memory:   memory,
-		name:     name,
-		offset:   offset,
-		capacity: capacity,
-		elemSize: uint32(elemSize),
+		memory:     memory,
+		name:       name,
+		offset:     offset,
+		capacity:   capacity,
+		elemSize:   uint32(elemSize),
+		dataOff:    dataOff,
+		dataStride: dataStride,
+		seqOff:     seqOff,
+		seqStride:  seqStride,
+		headOff:    headOff,
+		tailOff:    tailOff,
 	}, nil
 }
 
 // headPtr returns a pointer to the atomic head counter.
 func (q *Queue[T]) headPtr() *uint32 {
-	return (*uint32)(unsafe.Pointer(&q.memory.Data()[q.offset]))
+	return (*uint32)(unsafe.Pointer(&q.memory.Data()[q.offset+q.headOff]))
 }
 
 // tailPtr returns a pointer to the atomic tail counter.
 func (q *Queue[T]) tailPtr() *uint32 {
-	return (*uint32)(unsafe.Pointer(&q.memory.Data()[q.offset+4]))
+	return (*uint32)(unsafe.Pointer(&q.memory.Data()[q.offset+q.tailOff]))
 }
 
 // seqPtr returns a pointer to the sequence number for slot i.
-// Sequence array lives after the data array.
 func (q *Queue[T]) seqPtr(slot uint32) *uint32 {
-	seqOffset := q.offset + QueueHeaderSize + align8(int(q.capacity)*int(q.elemSize)) + int(slot)*4
+	seqOffset := q.offset + q.seqOff + int(slot)*q.seqStride
 	return (*uint32)(unsafe.Pointer(&q.memory.Data()[seqOffset]))
 }
 
@@ -170,7 +276,7 @@ func (q *Queue[T]) Push(value T) bool {
 			// Slot is ready for writing; try to claim it
 			if atomic.CompareAndSwapUint32(tailPtr, tail, tail+1) {
 				// We own this slot — write the data
-				dataOffset := q.offset + QueueHeaderSize + int(slot)*int(q.elemSize)
+				dataOffset := q.offset + q.dataOff + int(slot)*q.dataStride
 				*(*T)(unsafe.Pointer(&q.memory.Data()[dataOffset])) = value
 				// Publish: set sequence to tail+1 so consumers can see it
 				atomic.StoreUint32(q.seqPtr(slot), tail+1)
@@ -202,7 +308,7 @@ func (q *Queue[T]) Pop() (T, bool) {
 			// Slot contains data; try to claim it
 			if atomic.CompareAndSwapUint32(headPtr, head, head+1) {
 				// We own this slot — read the data
-				dataOffset := q.offset + QueueHeaderSize + int(slot)*int(q.elemSize)
+				dataOffset := q.offset + q.dataOff + int(slot)*q.dataStride
 				value := *(*T)(unsafe.Pointer(&q.memory.Data()[dataOffset]))
 				// Release: set sequence to head+capacity so producers can reuse
 				atomic.StoreUint32(q.seqPtr(slot), head+cap)
@@ -24,7 +24,7 @@ const SemaphoreHeaderSize = 16
 //   - count: int32 (atomic, offset 0) - current count
 //   - waiting: int32 (atomic, offset 4) - number of waiting processes
 //   - max_count: int32 (offset 8) - maximum count (0 = unbounded)
-//   - _padding: int32 (offset 12) - alignment padding
+//   - queue_slots: int32 (offset 12) - 0; C++ FIFO semaphores use a larger layout
 type Semaphore struct {
 	memory   *Memory
 	name     string
@@ -194,6 +194,7 @@ func (s *Semaphore) AcquireTimeout(timeout time.Duration) bool {
 // Release releases one permit back to the semaphore.
 // Returns an error if max_count would be exceeded.
 // Uses a CAS loop to atomically check and increment, preventing TOCTOU races.
+// Wakes waiters (C++ ones sleep on the count's futex word) if any are waiting.
 func (s *Semaphore) Release() error {
 	for {
 		current := atomic.LoadInt32(s.countPtr())
@@ -201,10 +202,14 @@ func (s *Semaphore) Release() error {
 			return errors.New("semaphore count would exceed maximum")
 		}
 		if atomic.CompareAndSwapInt32(s.countPtr(), current, current+1) {
-			return nil
+			break
 		}
 		// CAS failed, retry
 	}
+	if atomic.LoadInt32(s.waitingPtr()) != 0 {
+		futexWakeAll((*uint32)(unsafe.Pointer(s.countPtr())))
+	}
+	return nil
 }
 
 // Count returns the current semaphore count.
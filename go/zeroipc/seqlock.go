@@ -0,0 +1,214 @@
+package zeroipc
+
+import (
+	"encoding/binary"
+	"errors"
+	"fmt"
+	"runtime"
+	"sync/atomic"
+	"time"
+	"unsafe"
+)
+
+// SeqLockHeaderSize is the size of the seqlock header in bytes.
+// Layout: seq(8) + elem_size(4) + waiters(4) = 16 bytes
+const SeqLockHeaderSize = 16
+
+const (
+	seqLockSpinAttempts = 64
+	seqLockReadAttempts = 1 << 20
+
+	// Longest single futex sleep in WaitForChange, so writers that cannot
+	// wake (Python without the FFI library) are still noticed
+	seqLockParkSlice = 100 * time.Millisecond
+)
+
+// ErrSeqLockStuck is returned by Load when no clean copy of the value could
+// be taken, which means a writer died in the middle of a store.
+var ErrSeqLockStuck = errors.New("seqlock value is stuck mid-write")
+
+// SeqLock holds one value of T that is read far more often than written.
+//
+// A writer makes the sequence odd, copies the value in and makes it even
+// again; readers copy the value out between two loads of the sequence and
+// retry if they differ or were odd. Readers never block the writer and
+// never write shared memory. Concurrent writers are serialized by a CAS on
+// the sequence, but one writer at a time is intended.
+//
+// WaitForChange parks on the low half of the sequence with a futex and
+// counts itself in waiters; a store wakes all parked waiters, in any
+// process, when that count is non-zero.
+//
+// T must be a fixed-size type without pointers (numbers, arrays and
+// structs of them) with the same layout as the C/C++ value.
+//
+// Binary layout (matching C++; A is the section alignment from the table
+// entry, 8 for seqlocks created here):
+//   - seq: uint64 (atomic, offset 0) - even: stable, odd: write in progress
+//   - elem_size: uint32 (offset 8)
+//   - waiters: uint32 (atomic, offset 12) - threads parked in WaitForChange
+//   - value: elem_size bytes (at alignUp(16, A))
+type SeqLock[T any] struct {
+	memory   *Memory
+	name     string
+	offset   int
+	valueOff int // value, relative to offset
+}
+
+// NewSeqLock creates a new seqlock in shared memory holding initial.
+func NewSeqLock[T any](memory *Memory, name string, initial T) (*SeqLock[T], error) {
+	if len(name) >= NameSize {
+		return nil, errors.New("name too long (max 31 characters)")
+	}
+
+	if entry := memory.Find(name); entry != nil {
+		return nil, fmt.Errorf("seqlock '%s' already exists", name)
+	}
+
+	elemSize := int(unsafe.Sizeof(initial))
+	align := max(MinSectionAlign, int(unsafe.Alignof(initial)))
+	valueOff := alignUp(SeqLockHeaderSize, align)
+	offset, err := memory.AllocateAligned(name, valueOff+elemSize, align)
+	if err != nil {
+		return nil, fmt.Errorf("failed to allocate: %w", err)
+	}
+
+	data := memory.Data()
+	binary.LittleEndian.PutUint64(data[offset:], 0)                  // seq
+	binary.LittleEndian.PutUint32(data[offset+8:], uint32(elemSize)) // elem_size
+	binary.LittleEndian.PutUint32(data[offset+12:], 0)               // waiters
+
+	s := &SeqLock[T]{memory: memory, name: name, offset: offset, valueOff: valueOff}
+	*s.valuePtr() = initial
+	return s, nil
+}
+
+// OpenSeqLock opens an existing seqlock in shared memory.
+func OpenSeqLock[T any](memory *Memory, name string) (*SeqLock[T], error) {
+	entry := memory.Find(name)
+	if entry == nil {
+		return nil, fmt.Errorf("seqlock '%s' not found", name)
+	}
+
+	var zero T
+	elemSize := int(unsafe.Sizeof(zero))
+	offset := int(entry.Offset)
+	valueOff := alignUp(SeqLockHeaderSize, entry.SectionAlign())
+
+	stored := int(binary.LittleEndian.Uint32(memory.Data()[offset+8:]))
+	if stored != elemSize || int(entry.Size) < valueOff+elemSize {
+		return nil, fmt.Errorf("elem_size mismatch: expected %d, got %d (wrong value type?)",
+			elemSize, stored)
+	}
+
+	return &SeqLock[T]{memory: memory, name: name, offset: offset, valueOff: valueOff}, nil
+}
+
+func (s *SeqLock[T]) seqPtr() *uint64 {
+	return (*uint64)(s.memory.At(s.offset))
+}
+
+// seqWord is the low half of seq (little-endian), which waiters park on.
+func (s *SeqLock[T]) seqWord() *uint32 {
+	return (*uint32)(s.memory.At(s.offset))
+}
+
+func (s *SeqLock[T]) waitersPtr() *uint32 {
+	return (*uint32)(s.memory.At(s.offset + 12))
+}
+
+func (s *SeqLock[T]) valuePtr() *T {
+	return (*T)(s.memory.At(s.offset + s.valueOff))
+}
+
+// Load returns the value as of the last completed store.
+func (s *SeqLock[T]) Load() (T, error) {
+	seq := s.seqPtr()
+	for attempt := 0; attempt < seqLockReadAttempts; attempt++ {
+		before := atomic.LoadUint64(seq)
+		if before&1 == 0 {
+			value := *s.valuePtr()
+			if atomic.LoadUint64(seq) == before {
+				return value, nil
+			}
+		}
+		if attempt >= seqLockSpinAttempts {
+			runtime.Gosched()
+		}
+	}
+	var zero T
+	return zero, ErrSeqLockStuck
+}
+
+// Store replaces the value.
+func (s *SeqLock[T]) Store(value T) {
+	s.beginWrite()
+	*s.valuePtr() = value
+	s.endWrite()
+}
+
+// Update replaces the value with fn(current) and returns the new value.
+// The read-modify-write is atomic with respect to other writers.
+func (s *SeqLock[T]) Update(fn func(T) T) T {
+	s.beginWrite()
+	next := fn(*s.valuePtr())
+	*s.valuePtr() = next
+	s.endWrite()
+	return next
+}
+
+// Sequence returns twice the number of completed stores (odd while a store
+// is in progress).
+func (s *SeqLock[T]) Sequence() uint64 {
+	return atomic.LoadUint64(s.seqPtr())
+}
+
+// WaitForChange blocks until a store completes after the one that produced
+// seen (a value returned by Sequence), or until timeout passes. It reports
+// whether the value changed.
+func (s *SeqLock[T]) WaitForChange(seen uint64, timeout time.Duration) bool {
+	deadline := time.Now().Add(timeout)
+	seq := s.seqPtr()
+	for {
+		cur := atomic.LoadUint64(seq)
+		if cur&^1 != seen&^1 {
+			return true
+		}
+		left := time.Until(deadline)
+		if left <= 0 {
+			return false
+		}
+		// Either the writer sees us counted, or the futex sees its new
+		// sequence and does not sleep
+		atomic.AddUint32(s.waitersPtr(), 1)
+		if atomic.LoadUint64(seq) == cur {
+			futexWait(s.seqWord(), uint32(cur), min(left, seqLockParkSlice))
+		}
+		atomic.AddUint32(s.waitersPtr(), ^uint32(0))
+	}
+}
+
+// Name returns the seqlock name.
+func (s *SeqLock[T]) Name() string {
+	return s.name
+}
+
+func (s *SeqLock[T]) endWrite() {
+	atomic.AddUint64(s.seqPtr(), 1) // Even again
+	if atomic.LoadUint32(s.waitersPtr()) != 0 {
+		futexWakeAll(s.seqWord())
+	}
+}
+
+func (s *SeqLock[T]) beginWrite() {
+	seq := s.seqPtr()
+	for spins := 0; ; spins++ {
+		cur := atomic.LoadUint64(seq)
+		if cur&1 == 0 && atomic.CompareAndSwapUint64(seq, cur, cur+1) {
+			return
+		}
+		if spins >= seqLockSpinAttempts {
+			runtime.Gosched()
+		}
+	}
+}
@@ -13,10 +13,32 @@ import (
 // Layout: top(4) + capacity(4) + elem_size(4) + reserved(4) = 16 bytes
 const StackHeaderSize = 16
 
-// align8 rounds n up to the next multiple of 8 (8-byte section alignment,
-// format v2). Atomic side-arrays start on an 8-byte boundary so their atomics
-// are always naturally aligned regardless of element size.
-func align8(n int) int { return (n + 7) &^ 7 }
+// StackLayout selects where a stack keeps its top counter. It is recorded in
+// the high byte of the header's elem_size field, so every reader decodes it.
+type StackLayout uint32
+
+const (
+	// StackCompact keeps top in the 16-byte header.
+	StackCompact StackLayout = 0
+	// StackPaddedTop moves top onto a cache line of its own (offset 64; the
+	// header's top stays -1), away from the read-mostly capacity and
+	// elem_size, and starts the data after a 128-byte header. C++ creates
+	// stacks with this layout by default.
+	StackPaddedTop StackLayout = 0x04000000
+
+	stackElemSizeMask = 0x00FFFFFF
+
+	stackPaddedTopOffset  = CacheLineSize
+	stackPaddedHeaderSize = 2 * CacheLineSize
+)
+
+// stackGeometry returns the top counter and data offsets for a layout.
+func stackGeometry(layout StackLayout, align int) (topOff, dataOff int) {
+	if layout&StackPaddedTop != 0 {
+		return stackPaddedTopOffset, alignUp(stackPaddedHeaderSize, align)
+	}
+	return 0, alignUp(StackHeaderSize, align)
+}
 
 // Per-slot states for the 4-state CAS protocol (matching C++):
 //
@@ -41,23 +63,35 @@ const maxSpins = 10000
 
 // Stack is a lock-free LIFO stack in shared memory.
 //
-// Binary layout (matching C++, format v2):
+// Binary layout (matching C++; A is the section alignment from the table
+// entry, 8 for stacks created here):
 //   - top: int32 (atomic, offset 0) - index of top element, -1 when empty
 //   - capacity: uint32 (offset 4)
-//   - elem_size: uint32 (offset 8)
+//   - elem_size: uint32 (offset 8) - low 24 bits; the high byte is the StackLayout
 //   - reserved: uint32 (offset 12) - pads header to 16 bytes
-//   - data: capacity * elem_size bytes (offset 16)
-//   - state: capacity * 4 bytes (at align8(16 + elem_size*capacity)) - per-slot atomic state
+//   - data: capacity * elem_size bytes (at alignUp(16, A))
+//
+// With StackPaddedTop, top lives at offset 64 and data starts at
+// alignUp(128, A).
+//   - state: capacity * 4 bytes (at alignUp(data + elem_size*capacity, A)) - per-slot atomic state
 type Stack[T Numeric] struct {
 	memory   *Memory
 	name     string
 	offset   int
 	capacity uint32
 	elemSize uint32
+	topOff   int // top counter, relative to offset
+	dataOff  int // data array, relative to offset
+	stateOff int // state array, relative to offset
 }
 
 // NewStack creates a new stack in shared memory.
 func NewStack[T Numeric](memory *Memory, name string, capacity int) (*Stack[T], error) {
+	return NewStackWithLayout[T](memory, name, capacity, StackCompact)
+}
+
+// NewStackWithLayout creates a new stack with the given header layout.
+func NewStackWithLayout[T Numeric](memory *Memory, name string, capacity int, layout StackLayout) (*Stack[T], error) {
 	if len(name) >= NameSize {
 		return nil, errors.New("name too long (max 31 characters)")
 	}
@@ -69,13 +103,19 @@ func NewStack[T Numeric](memory *Memory, name string, capacity int) (*Stack[T],
 	var zero T
 	elemSize := int(unsafe.Sizeof(zero))
 
+	if layout&^StackPaddedTop != 0 {
+		return nil, fmt.Errorf("unknown stack layout %#x", uint32(layout))
+	}
+
 	// Check if already exists
 	if entry := memory.Find(name); entry != nil {
 		return nil, fmt.Errorf("stack '%s' already exists", name)
 	}
 
-	// Layout: [Header(16)][data: T*capacity][pad][state: uint32*capacity]
-	totalSize := StackHeaderSize + align8(capacity*elemSize) + capacity*4
+	// Layout: [Header][data: T*capacity][pad][state: uint32*capacity]
+	topOff, dataOff := stackGeometry(layout, MinSectionAlign)
+	stateOff := dataOff + alignUp(capacity*elemSize, MinSectionAlign)
+	totalSize := stateOff + capacity*4
 	offset, err := memory.Allocate(name, totalSize)
 	if err != nil {
 		return nil, fmt.Errorf("failed to allocate: %w", err)
@@ -84,17 +124,18 @@ func NewStack[T Numeric](memory *Memory, name string, capacity int) (*Stack[T],
 	data := memory.Data()
 
 	// Write header (top = -1 means empty)
-	binary.LittleEndian.PutUint32(data[offset:], 0xFFFFFFFF)         // top = -1
-	binary.LittleEndian.PutUint32(data[offset+4:], uint32(capacity)) // capacity
-	binary.LittleEndian.PutUint32(data[offset+8:], uint32(elemSize)) // elem_size
-	binary.LittleEndian.PutUint32(data[offset+12:], 0)               // reserved
+	binary.LittleEndian.PutUint32(data[offset:], 0xFFFFFFFF)                        // top = -1
+	binary.LittleEndian.PutUint32(data[offset+4:], uint32(capacity))                // capacity
+	binary.LittleEndian.PutUint32(data[offset+8:], uint32(elemSize)|uint32(layout)) // elem_size
+	binary.LittleEndian.PutUint32(data[offset+12:], 0)                              // reserved
 
 	// Zero-initialize data, padding, and state areas (state[i] = EMPTY = 0)
 	start := offset + StackHeaderSize
-	end := start + align8(capacity*elemSize) + capacity*4
+	end := offset + totalSize
 	for i := start; i < end; i++ {
 		data[i] = 0
 	}
+	binary.LittleEndian.PutUint32(data[offset+topOff:], 0xFFFFFFFF)
 
 	return &Stack[T]{
 		memory:   memory,
@@ -102,6 +143,9 @@ func NewStack[T Numeric](memory *Memory, name string, capacity int) (*Stack[T],
 		offset:   offset,
 		capacity: uint32(capacity),
 		elemSize: uint32(elemSize),
+		topOff:   topOff,
+		dataOff:  dataOff,
+		stateOff: stateOff,
 	}, nil
 }
 
@@ -120,11 +164,20 @@ func OpenStack[T Numeric](memory *Memory, name string) (*Stack[T], error) {
 
 	// Read header
 	capacity := binary.LittleEndian.Uint32(data[offset+4:])
-	storedElemSize := binary.LittleEndian.Uint32(data[offset+8:])
+	rawElemSize := binary.LittleEndian.Uint32(data[offset+8:])
+	storedElemSize := rawElemSize & stackElemSizeMask
+	layout := StackLayout(rawElemSize &^ stackElemSizeMask)
 
 	if int(storedElemSize) != elemSize {
 		return nil, fmt.Errorf("element size mismatch: stored %d, expected %d", storedElemSize, elemSize)
 	}
+	if layout&^StackPaddedTop != 0 {
+		return nil, fmt.Errorf("unknown stack layout %#x", uint32(layout))
+	}
+
+	// Sections follow the alignment recorded by the creator
+	align := entry.SectionAlign()
+	topOff, dataOff := stackGeometry(layout, align)
 
 	return &Stack[T]{
 		memory:   memory,
@@ -132,18 +185,21 @@ func OpenStack[T Numeric](memory *Memory, name string) (*Stack[T], error) {
 		offset:   offset,
 		capacity: capacity,
 		elemSize: uint32(elemSize),
+		topOff:   topOff,
+		dataOff:  dataOff,
+		stateOff: dataOff + alignUp(int(capacity)*elemSize, align),
 	}, nil
 }
 
 // topPtr returns a pointer to the atomic top counter.
 func (s *Stack[T]) topPtr() *int32 {
-	return (*int32)(unsafe.Pointer(&s.memory.Data()[s.offset]))
+	return (*int32)(unsafe.Pointer(&s.memory.Data()[s.offset+s.topOff]))
 }
 
 // slotStatePtr returns a pointer to the atomic state for slot i.
 // State array lives after the data array.
 func (s *Stack[T]) slotStatePtr(i int32) *uint32 {
-	stateOffset := s.offset + StackHeaderSize + align8(int(s.capacity)*int(s.elemSize)) + int(i)*4
+	stateOffset := s.offset + s.stateOff + int(i)*4
 	return (*uint32)(unsafe.Pointer(&s.memory.Data()[stateOffset]))
 }
 
@@ -185,7 +241,7 @@ func (s *Stack[T]) Push(value T) bool {
 	}
 
 	// Step 3: Write data (we have exclusive ownership)
-	dataOffset := s.offset + StackHeaderSize + int(newTop)*int(s.elemSize)
+	dataOffset := s.offset + s.dataOff + int(newTop)*int(s.elemSize)
 	*(*T)(unsafe.Pointer(&s.memory.Data()[dataOffset])) = value
 
 	// Step 4: Publish: WRITING -> READY
@@ -233,7 +289,7 @@ func (s *Stack[T]) Pop() (T, bool) {
 	}
 
 	// Step 3: Read data (we have exclusive ownership)
-	dataOffset := s.offset + StackHeaderSize + int(currentTop)*int(s.elemSize)
+	dataOffset := s.offset + s.dataOff + int(currentTop)*int(s.elemSize)
 	value := *(*T)(unsafe.Pointer(&s.memory.Data()[dataOffset]))
 
 	// Step 4: Release: READING -> EMPTY
@@ -264,7 +320,7 @@ func (s *Stack[T]) Top() (T, bool) {
 
 		statePtr := s.slotStatePtr(currentTop)
 		if atomic.CompareAndSwapUint32(statePtr, slotReady, slotReading) {
-			dataOffset := s.offset + StackHeaderSize + int(currentTop)*int(s.elemSize)
+			dataOffset := s.offset + s.dataOff + int(currentTop)*int(s.elemSize)
 			value := *(*T)(unsafe.Pointer(&s.memory.Data()[dataOffset]))
 			atomic.StoreUint32(statePtr, slotReady)
 			return value, true
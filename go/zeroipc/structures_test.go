@@ -5,6 +5,7 @@ import (
 	"sync/atomic"
 	"testing"
 	"time"
+	"unsafe"
 )
 
 func TestQueueBasic(t *testing.T) {
@@ -376,6 +377,43 @@ func TestSemaphoreConcurrentRelease(t *testing.T) {
 	}
 }
 
+func TestSemaphoreReleaseWakesFutexWaiter(t *testing.T) {
+	name := "/test_go_sem_wake"
+	size := 1024 * 1024
+
+	UnlinkName(name)
+
+	mem, err := NewMemory(name, size, 64)
+	if err != nil {
+		t.Fatalf("NewMemory failed: %v", err)
+	}
+	defer mem.Close()
+	defer mem.Unlink()
+
+	sem, err := NewSemaphore(mem, "test_sem_wake", 0, 0)
+	if err != nil {
+		t.Fatalf("NewSemaphore failed: %v", err)
+	}
+
+	// Sleep on the count the way a C++ acquirer does
+	atomic.AddInt32(sem.waitingPtr(), 1)
+	woke := make(chan time.Duration)
+	go func() {
+		start := time.Now()
+		futexWait((*uint32)(unsafe.Pointer(sem.countPtr())), 0, 5*time.Second)
+		woke <- time.Since(start)
+	}()
+
+	time.Sleep(50 * time.Millisecond)
+	if err := sem.Release(); err != nil {
+		t.Fatalf("Release failed: %v", err)
+	}
+	if slept := <-woke; slept > 2*time.Second {
+		t.Errorf("Release did not wake the futex waiter (slept %v)", slept)
+	}
+	atomic.AddInt32(sem.waitingPtr(), -1)
+}
+
 func TestMutexBasic(t *testing.T) {
 	name := "/test_go_mutex"
 	size := 1024 * 1024
@@ -600,3 +638,154 @@ func TestOnceConcurrent(t *testing.T) {
 		t.Error("Once should be called after concurrent Do()")
 	}
 }
+
+type seqLockTelemetry struct {
+	Tick     uint64
+	Position [3]float64
+	Check    uint64 // Tick * 3
+}
+
+func TestSeqLockBasic(t *testing.T) {
+	name := "/test_go_seqlock"
+	size := 1024 * 1024
+
+	UnlinkName(name)
+
+	mem, err := NewMemory(name, size, 64)
+	if err != nil {
+		t.Fatalf("NewMemory failed: %v", err)
+	}
+	defer mem.Close()
+	defer mem.Unlink()
+
+	lock, err := NewSeqLock(mem, "telemetry", seqLockTelemetry{Tick: 1, Check: 3})
+	if err != nil {
+		t.Fatalf("NewSeqLock failed: %v", err)
+	}
+
+	v, err := lock.Load()
+	if err != nil || v.Tick != 1 {
+		t.Errorf("Load = %+v, %v; expected tick 1", v, err)
+	}
+
+	lock.Store(seqLockTelemetry{Tick: 2, Check: 6})
+	if lock.Sequence() != 2 {
+		t.Errorf("Sequence = %d, expected 2", lock.Sequence())
+	}
+
+	opened, err := OpenSeqLock[seqLockTelemetry](mem, "telemetry")
+	if err != nil {
+		t.Fatalf("OpenSeqLock failed: %v", err)
+	}
+	next := opened.Update(func(cur seqLockTelemetry) seqLockTelemetry {
+		cur.Tick++
+		cur.Check = cur.Tick * 3
+		return cur
+	})
+	if next.Tick != 3 || lock.Sequence() != 4 {
+		t.Errorf("Update = %+v, sequence %d", next, lock.Sequence())
+	}
+
+	if _, err := OpenSeqLock[uint32](mem, "telemetry"); err == nil {
+		t.Error("OpenSeqLock with the wrong type should fail")
+	}
+}
+
+func TestSeqLockConcurrentReaders(t *testing.T) {
+	name := "/test_go_seqlock_conc"
+	size := 1024 * 1024
+
+	UnlinkName(name)
+
+	mem, err := NewMemory(name, size, 64)
+	if err != nil {
+		t.Fatalf("NewMemory failed: %v", err)
+	}
+	defer mem.Close()
+	defer mem.Unlink()
+
+	lock, err := NewSeqLock(mem, "telemetry", seqLockTelemetry{})
+	if err != nil {
+		t.Fatalf("NewSeqLock failed: %v", err)
+	}
+
+	const writes = 50000
+	var torn atomic.Int32
+	var wg sync.WaitGroup
+	for r := 0; r < 3; r++ {
+		wg.Add(1)
+		go func() {
+			defer wg.Done()
+			for {
+				v, err := lock.Load()
+				if err != nil {
+					torn.Add(1)
+					return
+				}
+				p := float64(v.Tick)
+				if v.Check != v.Tick*3 || v.Position != [3]float64{p, p * 2, p * 3} {
+					torn.Add(1)
+				}
+				if v.Tick == writes {
+					return
+				}
+			}
+		}()
+	}
+
+	for i := uint64(1); i <= writes; i++ {
+		p := float64(i)
+		lock.Store(seqLockTelemetry{Tick: i, Position: [3]float64{p, p * 2, p * 3}, Check: i * 3})
+	}
+	wg.Wait()
+
+	if torn.Load() != 0 {
+		t.Errorf("%d torn reads", torn.Load())
+	}
+}
+
+func TestSeqLockWaitForChange(t *testing.T) {
+	name := "/test_go_seqlock_wait"
+	size := 1024 * 1024
+
+	UnlinkName(name)
+
+	mem, err := NewMemory(name, size, 64)
+	if err != nil {
+		t.Fatalf("NewMemory failed: %v", err)
+	}
+	defer mem.Close()
+	defer mem.Unlink()
+
+	lock, err := NewSeqLock(mem, "signal", int64(0))
+	if err != nil {
+		t.Fatalf("NewSeqLock failed: %v", err)
+	}
+
+	seen := lock.Sequence()
+	if lock.WaitForChange(seen, 10*time.Millisecond) {
+		t.Error("WaitForChange reported a change with no store")
+	}
+
+	woke := make(chan time.Time)
+	go func() {
+		if lock.WaitForChange(seen, 5*time.Second) {
+			woke <- time.Now()
+		} else {
+			close(woke)
+		}
+	}()
+
+	time.Sleep(20 * time.Millisecond)
+	storedAt := time.Now()
+	lock.Store(1)
+
+	at, ok := <-woke
+	if !ok {
+		t.Fatal("waiter timed out")
+	}
+	// Woken by the store, not by the end of a park slice
+	if at.Sub(storedAt) > 50*time.Millisecond {
+		t.Errorf("waiter woke %v after the store", at.Sub(storedAt))
+	}
+}
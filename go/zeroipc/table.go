@@ -4,6 +4,8 @@ import (
 	"encoding/binary"
 	"errors"
 	"fmt"
+	"runtime"
+	"sync/atomic"
 	"unsafe"
 )
 
@@ -12,27 +14,52 @@ const (
 	TableMagic uint32 = 0x5A49504D
 
 	// TableVersion is the current format version
-	// v2: 8-byte section alignment (see SPECIFICATION.md)
-	TableVersion uint32 = 2
+	// v3: per-entry publish state (see SPECIFICATION.md)
+	TableVersion uint32 = 3
 
 	// HeaderSize is the size of the table header in bytes
 	HeaderSize = 32
 
 	// EntrySize is the size of each table entry in bytes
-	EntrySize = 48
+	EntrySize = 56
 
 	// NameSize is the maximum length of entry names (including null terminator)
 	NameSize = 32
+
+	// MinSectionAlign is the minimum section alignment, and what an entry
+	// alignment of 0 means.
+	MinSectionAlign = 8
+
+	// MaxAllocAlign is the largest alignment a single allocation may request.
+	MaxAllocAlign = 4096
+
+	// CacheLineSize is the minimum base alignment of every structure, so the
+	// header atomics of neighbouring structures never share a cache line.
+	CacheLineSize = 64
 )
 
+// Entry states. Registration moves a reserved slot PENDING -> CLAIMED ->
+// PUBLISHED, or CLAIMED -> DEAD when a concurrent registrar in a lower slot
+// claimed the same name first. Readers only see PUBLISHED entries.
+const (
+	EntryPending   uint32 = 0
+	EntryClaimed   uint32 = 1
+	EntryPublished uint32 = 2
+	EntryDead      uint32 = 3
+)
+
+// tableMaxSpins bounds waiting for a lower slot to leave PENDING. A registrar
+// that crashed between reserving and claiming its slot never leaves PENDING.
+const tableMaxSpins = 10000
+
 // Header is the table header stored at the beginning of shared memory.
 // Binary layout (32 bytes):
 //   - magic: uint32 (offset 0)
 //   - version: uint32 (offset 4)
-//   - entry_count: uint32 (offset 8)
-//   - reserved: uint32 (offset 12)
+//   - entry_count: uint32 (offset 8, atomic; reserved slots)
+//   - max_entries: uint32 (offset 12)
 //   - memory_size: uint64 (offset 16)
-//   - next_offset: uint64 (offset 24)
+//   - next_offset: uint64 (offset 24, atomic)
 type Header struct {
 	Magic      uint32
 	Version    uint32
@@ -43,16 +70,39 @@ type Header struct {
 }
 
 // Entry is a table entry describing a named structure.
-// Binary layout (48 bytes):
+// Binary layout (56 bytes):
 //   - name: [32]byte (offset 0)
 //   - offset: uint64 (offset 32)
 //   - size: uint64 (offset 40)
+//   - state: uint32 (offset 48, atomic)
+//   - alignment: uint32 (offset 52) - section alignment, 0 means 8
 type Entry struct {
-	Name   [32]byte
-	Offset uint64
-	Size   uint64
+	Name      [32]byte
+	Offset    uint64
+	Size      uint64
+	State     uint32
+	Alignment uint32
+}
+
+// SectionAlign returns the entry's section alignment in bytes.
+func (e *Entry) SectionAlign() int {
+	if e.Alignment == 0 {
+		return MinSectionAlign
+	}
+	return int(e.Alignment)
+}
+
+// checkAlignment validates a requested alignment.
+func checkAlignment(alignment int) error {
+	if alignment <= 0 || alignment&(alignment-1) != 0 || alignment > MaxAllocAlign {
+		return fmt.Errorf("alignment %d must be a power of two no larger than %d", alignment, MaxAllocAlign)
+	}
+	return nil
 }
 
+// alignUp rounds n up to the next multiple of a (a power of two).
+func alignUp(n, a int) int { return (n + a - 1) &^ (a - 1) }
+
 // NameString returns the name as a Go string (null-terminated).
 func (e *Entry) NameString() string {
 	for i, b := range e.Name {
@@ -97,14 +147,14 @@ func (t *Table) initialize() {
 	h.MemorySize = uint64(t.memorySize)
 	h.NextOffset = uint64(CalculateTableSize(t.maxEntries))
 
-	t.writeHeader(h)
-
-	// Zero out entries
+	// Zero out entries (every state becomes EntryPending)
 	entriesStart := HeaderSize
 	entriesEnd := entriesStart + t.maxEntries*EntrySize
 	for i := entriesStart; i < entriesEnd; i++ {
 		t.data[i] = 0
 	}
+
+	t.writeHeader(h)
 }
 
 func (t *Table) validate() {
@@ -131,13 +181,32 @@ func (t *Table) Header() *Header {
 	return &Header{
 		Magic:      binary.LittleEndian.Uint32(t.data[0:4]),
 		Version:    binary.LittleEndian.Uint32(t.data[4:8]),
-		EntryCount: binary.LittleEndian.Uint32(t.data[8:12]),
+		EntryCount: atomic.LoadUint32(t.entryCountPtr()),
 		MaxEntries: binary.LittleEndian.Uint32(t.data[12:16]),
 		MemorySize: binary.LittleEndian.Uint64(t.data[16:24]),
-		NextOffset: binary.LittleEndian.Uint64(t.data[24:32]),
+		NextOffset: atomic.LoadUint64(t.nextOffsetPtr()),
 	}
 }
 
+// entryCountPtr returns a pointer to the atomic reserved-slot counter.
+func (t *Table) entryCountPtr() *uint32 {
+	return (*uint32)(unsafe.Pointer(&t.data[8]))
+}
+
+// nextOffsetPtr returns a pointer to the atomic next allocation offset.
+func (t *Table) nextOffsetPtr() *uint64 {
+	return (*uint64)(unsafe.Pointer(&t.data[24]))
+}
+
+// slotCount returns the number of reserved slots, clamped to maxEntries.
+func (t *Table) slotCount() int {
+	count := int(atomic.LoadUint32(t.entryCountPtr()))
+	if count > t.maxEntries {
+		return t.maxEntries
+	}
+	return count
+}
+
 func (t *Table) writeHeader(h *Header) {
 	binary.LittleEndian.PutUint32(t.data[0:4], h.Magic)
 	binary.LittleEndian.PutUint32(t.data[4:8], h.Version)
@@ -156,77 +225,175 @@ func (t *Table) Entry(index int) *Entry {
 	return (*Entry)(unsafe.Pointer(&t.data[offset]))
 }
 
-// Find looks up an entry by name.
+// Find looks up a published entry by name.
 func (t *Table) Find(name string) *Entry {
-	h := t.Header()
-	for i := 0; i < int(h.EntryCount); i++ {
+	count := t.slotCount()
+	for i := 0; i < count; i++ {
 		e := t.Entry(i)
-		if e.NameString() == name {
+		if atomic.LoadUint32(&e.State) == EntryPublished && e.NameString() == name {
 			return e
 		}
 	}
 	return nil
 }
 
-// Add adds a new entry to the table.
+// Add adds a new entry with the default section alignment.
 func (t *Table) Add(name string, offset uint64, size uint64) error {
-	if len(name) >= NameSize {
-		return errors.New("name too long (max 31 characters)")
+	return t.AddAligned(name, offset, size, MinSectionAlign)
+}
+
+// AddAligned adds a new entry to the table, recording the structure's
+// section alignment so every reader computes the same layout. It is
+// lock-free and safe to call from several processes at once: the slot is
+// reserved with a CAS on entry_count, and when two registrars race for the
+// same name the lower slot wins.
+func (t *Table) AddAligned(name string, offset uint64, size uint64, alignment int) error {
+	if err := checkEntry(name, alignment); err != nil {
+		return err
 	}
 
-	h := t.Header()
-	if int(h.EntryCount) >= t.maxEntries {
-		return errors.New("table full")
+	e, err := t.claim(name)
+	if err != nil {
+		return err
 	}
+	t.publish(e, offset, size, alignment)
+	return nil
+}
 
-	if t.Find(name) != nil {
-		return errors.New("name already exists")
+// AllocateEntry claims name, then bump-allocates size bytes for it and
+// publishes the entry. Space is only taken once the name is ours, so a
+// registration that loses a same-name race or finds the table full
+// consumes none. The base is aligned to max(alignment, CacheLineSize).
+func (t *Table) AllocateEntry(name string, size int, alignment int) (int, error) {
+	if err := checkEntry(name, alignment); err != nil {
+		return 0, err
 	}
 
-	// Get the entry slot
-	e := t.Entry(int(h.EntryCount))
+	e, err := t.claim(name)
+	if err != nil {
+		return 0, err
+	}
 
-	// Clear and set name
-	for i := range e.Name {
-		e.Name[i] = 0
+	offset, ok := t.tryAllocate(size, max(alignment, CacheLineSize))
+	if !ok {
+		atomic.StoreUint32(&e.State, EntryDead)
+		return 0, fmt.Errorf("allocation of %d bytes would exceed memory size %d",
+			size, t.memorySize)
 	}
-	copy(e.Name[:], name)
+	t.publish(e, uint64(offset), uint64(size), alignment)
+	return offset, nil
+}
 
-	// Set offset and size
-	entryOffset := HeaderSize + int(h.EntryCount)*EntrySize
-	binary.LittleEndian.PutUint64(t.data[entryOffset+32:entryOffset+40], offset)
-	binary.LittleEndian.PutUint64(t.data[entryOffset+40:entryOffset+48], size)
+func checkEntry(name string, alignment int) error {
+	if len(name) >= NameSize {
+		return errors.New("name too long (max 31 characters)")
+	}
+	return checkAlignment(alignment)
+}
 
-	// Increment entry count
-	h.EntryCount++
-	binary.LittleEndian.PutUint32(t.data[8:12], h.EntryCount)
+// claim reserves a slot and claims name in it. The returned entry is
+// CLAIMED; its offset and size are filled in by publish.
+func (t *Table) claim(name string) (*Entry, error) {
+	for {
+		if t.Find(name) != nil {
+			return nil, errors.New("name already exists")
+		}
 
-	return nil
+		// Reserve a slot (CAS so entry_count never exceeds maxEntries)
+		var index uint32
+		for {
+			index = atomic.LoadUint32(t.entryCountPtr())
+			if int(index) >= t.maxEntries {
+				return nil, errors.New("table full")
+			}
+			if atomic.CompareAndSwapUint32(t.entryCountPtr(), index, index+1) {
+				break
+			}
+		}
+
+		// The slot is exclusively ours; write the name and claim it
+		e := t.Entry(int(index))
+		for i := range e.Name {
+			e.Name[i] = 0
+		}
+		copy(e.Name[:], name)
+		if !atomic.CompareAndSwapUint32(&e.State, EntryPending, EntryClaimed) {
+			// We stalled so long that a registrar above gave up on the
+			// slot; it is dead, so start over in a fresh one
+			continue
+		}
+
+		// Same-name race: the lowest claimed slot wins
+		if t.lowerSlotClaims(name, int(index)) {
+			atomic.StoreUint32(&e.State, EntryDead)
+			return nil, errors.New("name already exists")
+		}
+		return e, nil
+	}
 }
 
-// Allocate reserves space for a new structure.
-func (t *Table) Allocate(size int, alignment int) int {
-	h := t.Header()
+// publish fills in a claimed entry and makes it visible to readers.
+func (t *Table) publish(e *Entry, offset uint64, size uint64, alignment int) {
+	e.Offset = offset
+	e.Size = size
+	e.Alignment = uint32(alignment)
+	atomic.StoreUint32(&e.State, EntryPublished)
+}
 
-	// Align the offset
-	aligned := (int(h.NextOffset) + alignment - 1) &^ (alignment - 1)
-	result := aligned
+// lowerSlotClaims reports whether a slot below index holds a live claim on
+// name. Lower PENDING slots are waited on (bounded by tableMaxSpins) since
+// their registrars may be racing for the same name, then marked DEAD so a
+// stalled registrar cannot publish later.
+func (t *Table) lowerSlotClaims(name string, index int) bool {
+	for i := 0; i < index; i++ {
+		e := t.Entry(i)
+		state := atomic.LoadUint32(&e.State)
+		for spins := 0; state == EntryPending && spins < tableMaxSpins; spins++ {
+			runtime.Gosched()
+			state = atomic.LoadUint32(&e.State)
+		}
+		if state == EntryPending && !atomic.CompareAndSwapUint32(&e.State, EntryPending, EntryDead) {
+			state = atomic.LoadUint32(&e.State)
+		}
+		if (state == EntryClaimed || state == EntryPublished) && e.NameString() == name {
+			return true
+		}
+	}
+	return false
+}
 
-	// Check bounds
-	if aligned+size > t.memorySize {
-		panic(fmt.Sprintf("allocation of %d bytes at offset %d would exceed memory size %d",
-			size, aligned, t.memorySize))
+// Allocate reserves space for a new structure (lock-free bump allocation).
+func (t *Table) Allocate(size int, alignment int) int {
+	offset, ok := t.tryAllocate(size, alignment)
+	if !ok {
+		panic(fmt.Sprintf("allocation of %d bytes would exceed memory size %d",
+			size, t.memorySize))
 	}
+	return offset
+}
+
+// tryAllocate bumps next_offset, reporting false if size bytes do not fit.
+func (t *Table) tryAllocate(size int, alignment int) (int, bool) {
+	for {
+		current := atomic.LoadUint64(t.nextOffsetPtr())
 
-	// Update next offset
-	binary.LittleEndian.PutUint64(t.data[24:32], uint64(aligned+size))
+		// Align the offset
+		aligned := (int(current) + alignment - 1) &^ (alignment - 1)
+
+		// Check bounds
+		if aligned+size > t.memorySize {
+			return 0, false
+		}
 
-	return result
+		if atomic.CompareAndSwapUint64(t.nextOffsetPtr(), current, uint64(aligned+size)) {
+			return aligned, true
+		}
+	}
 }
 
-// EntryCount returns the number of entries in the table.
+// EntryCount returns the number of published entries in the table.
 func (t *Table) EntryCount() int {
-	return int(t.Header().EntryCount)
+	return len(t.Entries())
 }
 
 // MaxEntries returns the maximum number of entries this table can hold.
@@ -239,12 +406,15 @@ func (t *Table) NextOffset() uint64 {
 	return t.Header().NextOffset
 }
 
-// Entries returns a slice of all entries.
+// Entries returns a slice of all published entries.
 func (t *Table) Entries() []*Entry {
-	count := t.EntryCount()
-	entries := make([]*Entry, count)
+	count := t.slotCount()
+	entries := make([]*Entry, 0, count)
 	for i := 0; i < count; i++ {
-		entries[i] = t.Entry(i)
+		e := t.Entry(i)
+		if atomic.LoadUint32(&e.State) == EntryPublished {
+			entries = append(entries, e)
+		}
 	}
 	return entries
 }
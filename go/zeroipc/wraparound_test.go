@@ -43,7 +43,7 @@ func TestQueueWraparoundAt2To32(t *testing.T) {
 	head := (*uint32)(unsafe.Pointer(&data[base]))
 	tail := (*uint32)(unsafe.Pointer(&data[base+4]))
 	seqAt := func(i uint32) *uint32 {
-		return (*uint32)(unsafe.Pointer(&data[base+QueueHeaderSize+align8(4*cap)+int(i)*4]))
+		return (*uint32)(unsafe.Pointer(&data[base+QueueHeaderSize+alignUp(4*cap, MinSectionAlign)+int(i)*4]))
 	}
 
 	// Position both counters 4 increments before the wrap.
@@ -27,15 +27,8 @@ def main():
     print(f"Table contains {mem.table.entry_count()} entries:")
     
     # List all entries
-    for i in range(mem.table.entry_count()):
-        # Manual iteration through entries
-        entry_offset = mem.table.HEADER_SIZE + i * mem.table.ENTRY_SIZE
-        import struct
-        name_bytes, offset, size = struct.unpack_from(
-            mem.table.ENTRY_FORMAT, mem.mmap, entry_offset
-        )
-        name = name_bytes.rstrip(b'\x00').decode('utf-8')
-        print(f"  - {name}: offset={offset}, size={size}")
+    for entry in mem.table.entries():
+        print(f"  - {entry.name}: offset={entry.offset}, size={entry.size}")
     
     if numpy_available:
         print("\nReading with NumPy:")
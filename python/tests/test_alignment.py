@@ -17,6 +17,9 @@ import numpy as np
 import pytest
 
 from zeroipc import Memory, Queue, Stack
+from zeroipc.queue import (LAYOUT_INTERLEAVED, LAYOUT_INTERLEAVED_PADDED,
+                           LAYOUT_PADDED_HEADER, LAYOUT_SPLIT)
+from zeroipc.stack import LAYOUT_PADDED_TOP
 
 HEADER_SIZE = 16
 SLOT_EMPTY = 0
@@ -98,3 +101,119 @@ def test_stack_side_array_at_8_byte_boundary(mem, dtype):
 
     assert stack.pop() is not None
     assert state_at(1) == SLOT_EMPTY, "popped slot not recycled at spec offset"
+
+
+def test_structure_bases_on_own_cache_line(mem):
+    Queue(mem, "q_a", capacity=4, dtype=np.int8)
+    Stack(mem, "s_a", capacity=3, dtype=np.int8)
+
+    for name in ("q_a", "s_a"):
+        entry = mem.table.find(name)
+        assert entry.offset % 64 == 0, f"{name} base shares a cache line"
+        assert entry.section_align == 8
+
+    with pytest.raises(ValueError):
+        mem.allocate("bad_a", 64, alignment=24)
+    with pytest.raises(ValueError):
+        mem.allocate("bad_b", 64, alignment=8192)
+
+
+def test_over_aligned_queue_open(mem):
+    # A queue created with section alignment 64 (what C++ Queue<T> records
+    # for an alignas(64) T) puts data at 64 and the sequence array at the
+    # next 64-byte boundary after the data. Opening must honor the entry.
+    align, capacity = 64, 4
+    data_off = align
+    seq_off = data_off + align  # 32 bytes of data, padded to 64
+    offset = mem.allocate("q_a64", seq_off + capacity * 4, alignment=align)
+    assert mem.table.find("q_a64").section_align == align
+
+    struct.pack_into("<IIII", mem.data, offset, 0, 0, capacity, 8)
+    for i in range(capacity):
+        struct.pack_into("<I", mem.data, offset + seq_off + i * 4, i)
+
+    queue = Queue(mem, "q_a64", dtype=np.uint64)
+    assert queue.push(0xDEADBEEF)
+
+    assert struct.unpack_from("<Q", mem.data, offset + data_off)[0] == 0xDEADBEEF
+    assert struct.unpack_from("<I", mem.data, offset + seq_off)[0] == 1
+
+    assert queue.pop() == 0xDEADBEEF
+
+
+@pytest.mark.parametrize("layout,stride,data_off", [
+    (LAYOUT_INTERLEAVED, 8, 16),
+    (LAYOUT_INTERLEAVED_PADDED, 64, 64),
+    (LAYOUT_INTERLEAVED | LAYOUT_PADDED_HEADER, 8, 192),
+])
+def test_interleaved_queue_layout(mem, layout, stride, data_off):
+    """Interleaved slots hold {element, seq}; the layout flag rides in the
+    high byte of elem_size and a second handle decodes it on open."""
+    q = Queue(mem, "inter", capacity=4, dtype=np.uint32, layout=layout)
+    entry = mem.table.find("inter")
+    assert entry.size == data_off + 4 * stride
+    (stored,) = struct.unpack_from('I', mem.data, entry.offset + 12)
+    assert stored == 4 | layout
+
+    assert q.push(0xBEEF)
+    assert q.push(0xCAFE)
+    slot1 = entry.offset + data_off + stride
+    assert struct.unpack_from('II', mem.data, slot1) == (0xCAFE, 2)
+
+    opened = Queue(mem, "inter", dtype=np.uint32)
+    assert opened.layout == layout
+    assert opened.pop() == 0xBEEF
+    assert opened.pop() == 0xCAFE
+    assert opened.pop() is None
+
+
+def test_padded_header_queue_counters(mem):
+    """With the padded header, head and tail sit at +64 and +128 and the
+    header's own fields stay 0."""
+    q = Queue(mem, "hdr", capacity=4, dtype=np.uint32,
+              layout=LAYOUT_SPLIT | LAYOUT_PADDED_HEADER)
+    entry = mem.table.find("hdr")
+    assert entry.size == 192 + 4 * 4 + 4 * 4
+
+    assert q.push(5)
+    assert q.push(6)
+    assert struct.unpack_from('II', mem.data, entry.offset) == (0, 0)
+    assert struct.unpack_from('I', mem.data, entry.offset + 128)[0] == 2
+    assert struct.unpack_from('I', mem.data, entry.offset + 192)[0] == 5
+
+    opened = Queue(mem, "hdr", dtype=np.uint32)
+    assert opened.size() == 2
+    assert opened.pop() == 5
+    assert struct.unpack_from('I', mem.data, entry.offset + 64)[0] == 1
+
+
+def test_padded_top_stack(mem):
+    """With the padded top, top sits at +64, the data starts at +128 and
+    the header's own top stays -1."""
+    s = Stack(mem, "ptop", capacity=4, dtype=np.uint32, layout=LAYOUT_PADDED_TOP)
+    entry = mem.table.find("ptop")
+    assert entry.size == 128 + 4 * 4 + 4 * 4
+    assert struct.unpack_from('I', mem.data, entry.offset + 8)[0] == 4 | LAYOUT_PADDED_TOP
+
+    assert s.push(5)
+    assert s.push(6)
+    assert struct.unpack_from('i', mem.data, entry.offset)[0] == -1
+    assert struct.unpack_from('i', mem.data, entry.offset + 64)[0] == 1
+    assert struct.unpack_from('II', mem.data, entry.offset + 128) == (5, 6)
+    assert struct.unpack_from('II', mem.data, entry.offset + 128 + 16) == (SLOT_READY, SLOT_READY)
+
+    opened = Stack(mem, "ptop", dtype=np.uint32)
+    assert opened.layout == LAYOUT_PADDED_TOP
+    assert opened.size() == 2
+    assert opened.pop() == 6
+    assert opened.top() == 5
+    assert s.size() == 1
+
+
+def test_unknown_stack_layout_rejected(mem):
+    with pytest.raises(ValueError):
+        Stack(mem, "bad", capacity=4, dtype=np.uint32, layout=0x01000000)
+    Stack(mem, "ok", capacity=4, dtype=np.uint32)
+    struct.pack_into('I', mem.data, mem.table.find("ok").offset + 8, 4 | 0x01000000)
+    with pytest.raises(ValueError):
+        Stack(mem, "ok", dtype=np.uint32)
@@ -6,11 +6,12 @@ and multi-process MPMC scenarios that are the reason the FFI exists.
 
 import multiprocessing
 import os
+import threading
 import time
 import pytest
 import numpy as np
 
-from zeroipc import Memory, Queue, Stack
+from zeroipc import Memory, Queue, Stack, RWLock, Monitor
 from zeroipc import _cffi
 
 
@@ -149,6 +150,105 @@ class TestStackFFI:
             assert s.pop() == i
 
 
+    def test_batched_push_pop(self, shm):
+        s = Stack(shm, "s_batch", capacity=10, dtype=np.int32)
+        values = np.arange(12, dtype=np.int32).tobytes()
+        assert _cffi.stack_push_n(shm, s.offset, values, 4, s._align) == 10
+        assert s.full()
+
+        raw = _cffi.stack_pop_n(shm, s.offset, 4, 4, s._align)
+        assert list(np.frombuffer(raw, dtype=np.int32)) == [9, 8, 7, 6]
+        assert s.pop() == 5
+        raw = _cffi.stack_pop_n(shm, s.offset, 20, 4, s._align)
+        assert list(np.frombuffer(raw, dtype=np.int32)) == [4, 3, 2, 1, 0]
+        assert _cffi.stack_pop_n(shm, s.offset, 4, 4, s._align) == b""
+
+
+
+class TestRWLockFFI:
+    """RWLock word protocol through the C FFI (shared with C++)."""
+
+    def _word(self, shm, lock):
+        return int(np.frombuffer(shm.data, dtype=np.uint32, count=1, offset=lock.offset)[0])
+
+    def test_word_bits(self, shm):
+        lock = RWLock(shm, "rw_bits")
+        assert lock.try_reader_lock()
+        assert lock.try_reader_lock()
+        assert self._word(shm, lock) == 2
+        assert not lock.try_writer_lock()
+        lock.reader_unlock()
+        lock.reader_unlock()
+
+        assert lock.try_writer_lock()
+        assert self._word(shm, lock) == RWLock.WRITER
+        assert not lock.try_reader_lock()
+        lock.writer_unlock()
+        assert self._word(shm, lock) == 0
+
+    def test_timed_out_writer_lets_readers_back_in(self, shm):
+        lock = RWLock(shm, "rw_timeout")
+        lock.reader_lock()
+        assert not lock.writer_lock(timeout=0.05)
+        # The waiting bit it set while blocked is gone again
+        assert self._word(shm, lock) == 1
+        assert lock.try_reader_lock()
+        lock.reader_unlock()
+        lock.reader_unlock()
+
+
+class TestMonitorFFI:
+    """Monitor futex protocol through the C FFI (shared with C++)."""
+
+    def _state(self, shm, mon):
+        return np.frombuffer(shm.data, dtype=np.uint32, count=4, offset=mon.offset)
+
+    def test_lock_word(self, shm):
+        mon = Monitor(shm, "mon_word")
+        state = self._state(shm, mon)
+        assert mon.try_lock()
+        assert state[0] == Monitor.LOCKED
+        assert not mon.try_lock()
+        assert not mon.lock(timeout=0.01)
+        mon.unlock()
+        assert state[0] == Monitor.UNLOCKED
+
+    def test_wait_reports_timeout_and_relocks(self, shm):
+        mon = Monitor(shm, "mon_timeout")
+        state = self._state(shm, mon)
+        mon.lock()
+        assert not mon.wait(timeout=0.02)
+        assert state[0] != Monitor.UNLOCKED
+        assert state[2] == 0
+        mon.unlock()
+
+    def test_notify_all_hands_the_lock_to_every_waiter(self, shm):
+        mon = Monitor(shm, "mon_all")
+        state = self._state(shm, mon)
+        woken = []
+
+        def waiter(i):
+            with mon:
+                assert mon.wait(timeout=5.0)
+                woken.append(i)
+
+        threads = [threading.Thread(target=waiter, args=(i,)) for i in range(4)]
+        for t in threads:
+            t.start()
+        deadline = time.monotonic() + 5.0
+        while state[2] < 4 and time.monotonic() < deadline:
+            time.sleep(0.001)
+
+        with mon:
+            mon.notify_all()
+        for t in threads:
+            t.join(timeout=5.0)
+
+        assert sorted(woken) == [0, 1, 2, 3]
+        assert state[0] == Monitor.UNLOCKED
+        assert state[2] == 0
+
+
 # --- Multi-process MPMC tests (the reason the FFI exists) ---
 
 def _producer(shm_name, count, start_val):
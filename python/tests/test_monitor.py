@@ -528,3 +528,43 @@ class TestMonitorEdgeCases:
 
         finally:
             Memory.unlink(shm_name)
+
+
+class TestMonitorLayout:
+    """The monitor shares the C++ layout: one 16-byte MonitorState at name."""
+
+    def test_single_state_entry(self):
+        shm_name = f"/test_mon_layout_{os.getpid()}"
+
+        try:
+            memory = Memory(shm_name, size=1024*1024)
+            mon = Monitor(memory, "mon")
+
+            entry = memory.table.find("mon")
+            assert entry.size == 16
+            assert entry.offset % 64 == 0
+            assert memory.table.find("mon_mtx") is None
+            assert memory.table.find("mon_cond") is None
+
+            with mon:
+                state = np.frombuffer(memory.data, dtype=np.uint32, count=4,
+                                      offset=entry.offset)
+                assert state[0] == Monitor.LOCKED
+                mon.notify_one()
+                assert state[1] == 1
+
+        finally:
+            Memory.unlink(shm_name)
+
+    def test_rejects_other_layouts(self):
+        shm_name = f"/test_mon_legacy_{os.getpid()}"
+
+        try:
+            memory = Memory(shm_name, size=1024*1024)
+            # The old Python layout kept a 1-byte marker at name
+            memory.allocate("legacy", 1)
+            with pytest.raises(RuntimeError):
+                Monitor(memory, "legacy")
+
+        finally:
+            Memory.unlink(shm_name)
@@ -3,13 +3,14 @@ Test suite for lock-free memory pool in shared memory.
 """
 
 import os
+import struct
 import threading
 import time
 import pytest
 import numpy as np
 
 from zeroipc import Memory
-from zeroipc.pool import Pool
+from zeroipc.pool import Pool, LAYOUT_PADDED_HEAD
 
 
 class TestPoolBasic:
@@ -449,4 +450,50 @@ class TestPoolStatistics:
             assert stats['allocated_blocks'] == 0
 
         finally:
-            Memory.unlink(shm_name)
\ No newline at end of file
+            Memory.unlink(shm_name)
+
+
+class TestPoolLayout:
+    """Header layout tests."""
+
+    def test_padded_head(self):
+        """free_head and allocated sit at +64 and +72, nodes start at +128."""
+        shm_name = f"/test_pool_padded_{os.getpid()}"
+
+        try:
+            memory = Memory(shm_name, size=1024*1024)
+            pool = Pool(memory, "padded_pool", capacity=4, dtype=np.uint32,
+                        layout=LAYOUT_PADDED_HEAD)
+            entry = memory.table.find("padded_pool")
+            assert entry.size == 128 + 4 * 8
+            assert struct.unpack_from('<I', memory.data, entry.offset + 20)[0] == \
+                4 | LAYOUT_PADDED_HEAD
+
+            a = pool.allocate()
+            b = pool.allocate()
+            assert (a, b) == (0, 1)
+            pool.set(a, 0xBEEF)
+            assert struct.unpack_from('<I', memory.data, entry.offset + 128)[0] == 0xBEEF
+            assert struct.unpack_from('<I', memory.data, entry.offset + 72)[0] == 2
+            assert struct.unpack_from('<QI', memory.data, entry.offset) == (0, 0)
+            assert struct.unpack_from('<Q', memory.data, entry.offset + 64)[0] & 0xFFFFFFFF == 2
+
+            opened = Pool(memory, "padded_pool")
+            assert opened.layout == LAYOUT_PADDED_HEAD
+            assert opened.allocated_count() == 2
+            assert opened.deallocate(b)
+            assert pool.allocated_count() == 1
+            assert pool.allocate() == b
+
+        finally:
+            Memory.unlink(shm_name)
+
+    def test_unknown_layout_rejected(self):
+        shm_name = f"/test_pool_badlayout_{os.getpid()}"
+
+        try:
+            memory = Memory(shm_name, size=1024*1024)
+            with pytest.raises(ValueError):
+                Pool(memory, "bad", capacity=4, dtype=np.uint32, layout=0x01000000)
+        finally:
+            Memory.unlink(shm_name)
@@ -505,3 +505,40 @@ class TestRWLockEdgeCases:
 
         finally:
             Memory.unlink(shm_name)
+
+
+class TestRWLockLayout:
+    """The lock shares the C++ RWLock layout: one 8-byte entry at name."""
+
+    def test_single_word_entry(self):
+        shm_name = f"/test_rwlock_layout_{os.getpid()}"
+
+        try:
+            memory = Memory(shm_name, size=1024*1024)
+            rwlock = RWLock(memory, "rw")
+
+            entry = memory.table.find("rw")
+            assert entry.size == 8
+            assert entry.offset % 64 == 0
+            assert memory.table.find("rw_state") is None
+
+            with rwlock.writer():
+                word = int(np.frombuffer(memory.data, dtype=np.uint32, count=1,
+                                         offset=entry.offset)[0])
+                assert word == RWLock.WRITER
+
+        finally:
+            Memory.unlink(shm_name)
+
+    def test_rejects_other_layouts(self):
+        shm_name = f"/test_rwlock_legacy_{os.getpid()}"
+
+        try:
+            memory = Memory(shm_name, size=1024*1024)
+            # The old Python layout kept a 1-byte marker at name
+            memory.allocate("legacy", 1)
+            with pytest.raises(RuntimeError):
+                RWLock(memory, "legacy")
+
+        finally:
+            Memory.unlink(shm_name)
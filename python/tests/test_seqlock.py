@@ -0,0 +1,157 @@
+"""Tests for SeqLock implementation."""
+
+import multiprocessing
+import os
+import threading
+
+import numpy as np
+import pytest
+
+from zeroipc import Memory, SeqLock, Signal
+
+# A 40-byte status record matching the C/C++/Go tests
+TELEMETRY = np.dtype([('tick', '<u8'), ('position', '<f8', 3), ('check', '<u8')])
+
+
+def telemetry(tick):
+    p = float(tick)
+    return (tick, (p, p * 2, p * 3), tick * 3)
+
+
+def consistent(value):
+    p = float(value['tick'])
+    return (value['check'] == value['tick'] * 3 and
+            tuple(value['position']) == (p, p * 2, p * 3))
+
+
+@pytest.fixture
+def shm():
+    name = f"/test_seqlock_{os.getpid()}"
+    mem = Memory(name, 1024 * 1024)
+    yield mem
+    mem.close()
+    Memory.unlink(name)
+
+
+def reader_worker(shm_name, last_tick, result):
+    mem = Memory(shm_name)
+    lock = SeqLock(mem, "telemetry", dtype=TELEMETRY, create_if_missing=False)
+    bad = 0
+    tick = 0
+    while tick < last_tick:
+        value = lock.load()
+        if not consistent(value):
+            bad += 1
+        tick = int(value['tick'])
+    result.value = bad
+
+
+def echo_worker(shm_name, rounds):
+    mem = Memory(shm_name)
+    ping = Signal(mem, "ping", dtype=np.int32, create_if_missing=False)
+    pong = Signal(mem, "pong", dtype=np.int32, create_if_missing=False)
+    seen = 0
+    for _ in range(rounds):
+        if not ping.wait_for_change(seen, timeout=5.0):
+            os._exit(1)
+        seen = ping.version
+        pong.set(ping.get())
+    mem.close()
+
+
+class TestSeqLock:
+
+    def test_store_load_sequence(self, shm):
+        lock = SeqLock(shm, "telemetry", dtype=TELEMETRY, initial_value=telemetry(1))
+        assert lock.sequence == 0
+        assert lock.load()['tick'] == 1
+
+        lock.store(telemetry(7))
+        assert lock.sequence == 2
+        assert consistent(lock.load())
+
+        new = lock.update(lambda cur: telemetry(int(cur['tick']) + 1))
+        assert new[0] == 8
+        assert lock.load()['tick'] == 8
+        assert lock.sequence == 4
+
+    def test_layout(self, shm):
+        SeqLock(shm, "counter", dtype=np.uint64, initial_value=5)
+        entry = shm.table.find("counter")
+        assert entry.size == 16 + 8  # Header + value
+
+    def test_open_existing(self, shm):
+        SeqLock(shm, "telemetry", dtype=TELEMETRY, initial_value=telemetry(3))
+        opened = SeqLock(shm, "telemetry", dtype=TELEMETRY, create_if_missing=False)
+        assert opened.load()['tick'] == 3
+
+        with pytest.raises(RuntimeError):
+            SeqLock(shm, "telemetry", dtype=np.uint32)
+        with pytest.raises(RuntimeError):
+            SeqLock(shm, "missing", dtype=np.uint32, create_if_missing=False)
+
+    def test_concurrent_updates(self, shm):
+        lock = SeqLock(shm, "counter", dtype=np.uint64, initial_value=0)
+
+        def worker():
+            for _ in range(200):
+                lock.update(lambda v: v + 1)
+
+        threads = [threading.Thread(target=worker) for _ in range(4)]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        assert lock.load() == 800
+
+    def test_cross_process_reads_are_whole(self, shm):
+        lock = SeqLock(shm, "telemetry", dtype=TELEMETRY, initial_value=telemetry(0))
+        result = multiprocessing.Value('i', -1)
+        last_tick = 2000
+
+        p = multiprocessing.Process(target=reader_worker,
+                                    args=(shm.name, last_tick, result))
+        p.start()
+        for i in range(1, last_tick + 1):
+            lock.store(telemetry(i))
+        p.join(timeout=30)
+
+        assert p.exitcode == 0
+        assert result.value == 0
+
+    def test_signal_shares_layout(self, shm):
+        sig = Signal(shm, "sig", dtype=np.int32, initial_value=1)
+        sig.set(2)
+        lock = SeqLock(shm, "sig", dtype=np.int32, create_if_missing=False)
+        assert lock.load() == 2
+        assert lock.sequence == 2 * sig.version
+
+    def test_wait_for_change(self, shm):
+        lock = SeqLock(shm, "value", dtype=np.int64)
+        seen = lock.sequence
+        assert not lock.wait_for_change(seen, timeout=0.01)
+
+        woke = []
+        waiter = threading.Thread(
+            target=lambda: woke.append(lock.wait_for_change(seen, timeout=5.0)))
+        waiter.start()
+        lock.store(1)
+        waiter.join(timeout=10)
+        assert woke == [True]
+        assert lock.wait_for_change(seen, timeout=0)
+
+    def test_signal_wait_for_change_cross_process(self, shm):
+        ping = Signal(shm, "ping", dtype=np.int32, initial_value=0)
+        pong = Signal(shm, "pong", dtype=np.int32, initial_value=0)
+        rounds = 50
+
+        p = multiprocessing.Process(target=echo_worker, args=(shm.name, rounds))
+        p.start()
+        seen = 0
+        for i in range(1, rounds + 1):
+            ping.set(i)
+            assert pong.wait_for_change(seen, timeout=5.0)
+            seen = pong.version
+            assert pong.get() == i
+        p.join(timeout=30)
+        assert p.exitcode == 0
@@ -4,6 +4,7 @@ import pytest
 import numpy as np
 import threading
 import random
+import struct
 import time
 from concurrent.futures import ThreadPoolExecutor
 from zeroipc import Memory, Array, Queue, Stack
@@ -335,6 +336,41 @@ class TestTableStress:
         for i, arr in enumerate(arrays):
             arr[0] = i * 10
             assert arr[0] == i * 10
+
+    def test_lost_registration_takes_no_space(self):
+        """A registration that loses its name race or finds the table full
+        leaves next_offset alone."""
+        from zeroipc.table import ENTRY_CLAIMED, ENTRY_DEAD
+        mem = Memory("/test_table_stress", size=1024*1024, table_size=2)
+        table = mem.table
+
+        # Another registrar holds a live claim on "shared" in slot 0
+        table._set_entry_count(1)
+        struct.pack_into('32s', table.buffer, table.HEADER_SIZE, b"shared")
+        table._set_state(0, ENTRY_CLAIMED)
+
+        before = table.next_offset()
+        with pytest.raises(ValueError):
+            mem.allocate("shared", 64)
+        assert table.next_offset() == before
+        assert table._state(1) == ENTRY_DEAD
+
+        # The table is now full
+        with pytest.raises(RuntimeError):
+            mem.allocate("more", 64)
+        assert table.next_offset() == before
+
+    def test_stalled_registration_retries(self):
+        """A slot given up on while its registrar stalled is skipped."""
+        from zeroipc.table import ENTRY_DEAD
+        mem = Memory("/test_table_stress", size=1024*1024, table_size=4)
+        table = mem.table
+        table._set_state(0, ENTRY_DEAD)
+
+        offset = mem.allocate("late", 64)
+        assert table._state(0) == ENTRY_DEAD
+        assert table.entries()[0].offset == offset
+        assert table._slot_count() == 2
     
     # ========== CROSS-TYPE TABLE TESTS ==========
     
@@ -43,6 +43,7 @@ try:
     from .monitor import Monitor
     from .rwlock import RWLock
     from .signal import Signal
+    from .seqlock import SeqLock
     from .barrier import Barrier
     from .latch import Latch
 
@@ -61,7 +62,7 @@ try:
         "Stream", "create_number_stream", "create_random_stream",
         "Channel", "ChannelClosed", "Select", "make_channel", "make_unbuffered_channel", "make_buffered_channel",
         # Synchronization primitives
-        "Semaphore", "Mutex", "Once", "Event", "EventMode", "Monitor", "RWLock", "Signal", "Barrier", "Latch",
+        "Semaphore", "Mutex", "Once", "Event", "EventMode", "Monitor", "RWLock", "Signal", "SeqLock", "Barrier", "Latch",
         # Atomic operations
         "AtomicInt", "AtomicInt64", "atomic_thread_fence", "spin_wait",
         "MEMORY_ORDER_RELAXED", "MEMORY_ORDER_ACQUIRE", "MEMORY_ORDER_RELEASE", "MEMORY_ORDER_ACQ_REL", "MEMORY_ORDER_SEQ_CST"
@@ -1,5 +1,5 @@
 """
-C FFI backend for atomic queue/stack operations.
+C FFI backend for atomic queue/stack/seqlock/rwlock/monitor and table registration operations.
 
 Loads libzeroipc_ffi.so at import time. If not found, AVAILABLE is False
 and callers fall back to pure-Python struct.pack_into (SPSC-only).
@@ -17,6 +17,8 @@ OK = 0
 EMPTY_OR_FULL = -1
 MISMATCH = -2
 INVALID = -3
+EXISTS = -4
+NOSPACE = -5
 
 
 def _check_rc(rc, op="operation"):
@@ -57,21 +59,52 @@ def _setup_functions():
     c_size_t = ctypes.c_size_t
     c_uint32 = ctypes.c_uint32
     c_int = ctypes.c_int
+    c_uint64 = ctypes.c_uint64
+    c_char_p = ctypes.c_char_p
 
     # Queue
     for fn_name, argtypes, restype in [
-        ("zeroipc_raw_queue_push", [c_void_p, c_size_t, c_void_p, c_uint32], c_int),
-        ("zeroipc_raw_queue_pop", [c_void_p, c_size_t, c_void_p, c_uint32], c_int),
+        ("zeroipc_raw_queue_push", [c_void_p, c_size_t, c_void_p, c_uint32, c_uint32], c_int),
+        ("zeroipc_raw_queue_pop", [c_void_p, c_size_t, c_void_p, c_uint32, c_uint32], c_int),
         ("zeroipc_raw_queue_size", [c_void_p, c_size_t], c_uint32),
         ("zeroipc_raw_queue_empty", [c_void_p, c_size_t], c_int),
         ("zeroipc_raw_queue_full", [c_void_p, c_size_t], c_int),
         # Stack
-        ("zeroipc_raw_stack_push", [c_void_p, c_size_t, c_void_p, c_uint32], c_int),
-        ("zeroipc_raw_stack_pop", [c_void_p, c_size_t, c_void_p, c_uint32], c_int),
-        ("zeroipc_raw_stack_top", [c_void_p, c_size_t, c_void_p, c_uint32], c_int),
+        ("zeroipc_raw_stack_push", [c_void_p, c_size_t, c_void_p, c_uint32, c_uint32], c_int),
+        ("zeroipc_raw_stack_pop", [c_void_p, c_size_t, c_void_p, c_uint32, c_uint32], c_int),
+        ("zeroipc_raw_stack_push_n", [c_void_p, c_size_t, c_void_p, c_uint32, c_uint32, c_uint32], c_int),
+        ("zeroipc_raw_stack_pop_n", [c_void_p, c_size_t, c_void_p, c_uint32, c_uint32, c_uint32], c_int),
+        ("zeroipc_raw_stack_top", [c_void_p, c_size_t, c_void_p, c_uint32, c_uint32], c_int),
         ("zeroipc_raw_stack_size", [c_void_p, c_size_t], c_uint32),
         ("zeroipc_raw_stack_empty", [c_void_p, c_size_t], c_int),
         ("zeroipc_raw_stack_full", [c_void_p, c_size_t], c_int),
+        # SeqLock
+        ("zeroipc_raw_seqlock_read", [c_void_p, c_size_t, c_void_p, c_uint32, c_uint32], c_int),
+        ("zeroipc_raw_seqlock_write", [c_void_p, c_size_t, c_void_p, c_uint32, c_uint32], c_int),
+        ("zeroipc_raw_seqlock_write_begin", [c_void_p, c_size_t], None),
+        ("zeroipc_raw_seqlock_write_end", [c_void_p, c_size_t], None),
+        ("zeroipc_raw_seqlock_sequence", [c_void_p, c_size_t], c_uint64),
+        ("zeroipc_raw_seqlock_wait", [c_void_p, c_size_t, c_uint64, ctypes.c_int64], c_int),
+        # Semaphore
+        ("zeroipc_raw_semaphore_release", [c_void_p, c_size_t, ctypes.c_int32], c_int),
+        # RWLock
+        ("zeroipc_raw_rwlock_try_read_lock", [c_void_p, c_size_t], c_int),
+        ("zeroipc_raw_rwlock_read_lock", [c_void_p, c_size_t, ctypes.c_int64], c_int),
+        ("zeroipc_raw_rwlock_read_unlock", [c_void_p, c_size_t], None),
+        ("zeroipc_raw_rwlock_try_write_lock", [c_void_p, c_size_t], c_int),
+        ("zeroipc_raw_rwlock_write_lock", [c_void_p, c_size_t, ctypes.c_int64], c_int),
+        ("zeroipc_raw_rwlock_write_unlock", [c_void_p, c_size_t], None),
+        # Monitor
+        ("zeroipc_raw_monitor_try_lock", [c_void_p, c_size_t], c_int),
+        ("zeroipc_raw_monitor_lock", [c_void_p, c_size_t, ctypes.c_int64], c_int),
+        ("zeroipc_raw_monitor_unlock", [c_void_p, c_size_t], None),
+        ("zeroipc_raw_monitor_wait", [c_void_p, c_size_t, ctypes.c_int64], c_int),
+        ("zeroipc_raw_monitor_notify_one", [c_void_p, c_size_t], None),
+        ("zeroipc_raw_monitor_notify_all", [c_void_p, c_size_t], None),
+        # Table
+        ("zeroipc_raw_table_allocate", [c_void_p, c_uint64, c_uint64, ctypes.POINTER(c_uint64)], c_int),
+        ("zeroipc_raw_table_add", [c_void_p, c_uint32, c_char_p, c_uint64, c_uint64, c_uint32], c_int),
+        ("zeroipc_raw_table_allocate_entry", [c_void_p, c_uint32, c_char_p, c_uint64, c_uint32, ctypes.POINTER(c_uint64)], c_int),
     ]:
         fn = getattr(_lib, fn_name)
         fn.argtypes = argtypes
@@ -103,18 +136,18 @@ def _base_ptr(memory):
 
 # --- Queue operations ---
 
-def queue_push(memory, offset, value_bytes, elem_size):
+def queue_push(memory, offset, value_bytes, elem_size, align=8):
     base = _base_ptr(memory)
     buf = (ctypes.c_char * elem_size).from_buffer_copy(value_bytes)
-    rc = _lib.zeroipc_raw_queue_push(base, offset, buf, elem_size)
+    rc = _lib.zeroipc_raw_queue_push(base, offset, buf, elem_size, align)
     _check_rc(rc, "queue_push")
     return rc
 
 
-def queue_pop(memory, offset, elem_size):
+def queue_pop(memory, offset, elem_size, align=8):
     base = _base_ptr(memory)
     buf = (ctypes.c_char * elem_size)()
-    rc = _lib.zeroipc_raw_queue_pop(base, offset, buf, elem_size)
+    rc = _lib.zeroipc_raw_queue_pop(base, offset, buf, elem_size, align)
     _check_rc(rc, "queue_pop")
     return rc, bytes(buf) if rc == OK else None
 
@@ -133,26 +166,44 @@ def queue_full(memory, offset):
 
 # --- Stack operations ---
 
-def stack_push(memory, offset, value_bytes, elem_size):
+def stack_push(memory, offset, value_bytes, elem_size, align=8):
     base = _base_ptr(memory)
     buf = (ctypes.c_char * elem_size).from_buffer_copy(value_bytes)
-    rc = _lib.zeroipc_raw_stack_push(base, offset, buf, elem_size)
+    rc = _lib.zeroipc_raw_stack_push(base, offset, buf, elem_size, align)
     _check_rc(rc, "stack_push")
     return rc
 
 
-def stack_pop(memory, offset, elem_size):
+def stack_pop(memory, offset, elem_size, align=8):
     base = _base_ptr(memory)
     buf = (ctypes.c_char * elem_size)()
-    rc = _lib.zeroipc_raw_stack_pop(base, offset, buf, elem_size)
+    rc = _lib.zeroipc_raw_stack_pop(base, offset, buf, elem_size, align)
     _check_rc(rc, "stack_pop")
     return rc, bytes(buf) if rc == OK else None
 
 
-def stack_top(memory, offset, elem_size):
+def stack_push_n(memory, offset, values_bytes, elem_size, align=8):
+    """Push len(values_bytes) // elem_size packed values; returns the count."""
+    base = _base_ptr(memory)
+    count = len(values_bytes) // elem_size
+    rc = _lib.zeroipc_raw_stack_push_n(base, offset, values_bytes, count, elem_size, align)
+    _check_rc(rc, "stack_push_n")
+    return rc
+
+
+def stack_pop_n(memory, offset, count, elem_size, align=8):
+    """Pop up to count values; returns their packed bytes, most recent first."""
+    base = _base_ptr(memory)
+    buf = (ctypes.c_char * max(count * elem_size, 1))()
+    rc = _lib.zeroipc_raw_stack_pop_n(base, offset, buf, count, elem_size, align)
+    _check_rc(rc, "stack_pop_n")
+    return bytes(buf[:rc * elem_size])
+
+
+def stack_top(memory, offset, elem_size, align=8):
     base = _base_ptr(memory)
     buf = (ctypes.c_char * elem_size)()
-    rc = _lib.zeroipc_raw_stack_top(base, offset, buf, elem_size)
+    rc = _lib.zeroipc_raw_stack_top(base, offset, buf, elem_size, align)
     _check_rc(rc, "stack_top")
     return rc, bytes(buf) if rc == OK else None
 
@@ -167,3 +218,125 @@ def stack_empty(memory, offset):
 
 def stack_full(memory, offset):
     return bool(_lib.zeroipc_raw_stack_full(_base_ptr(memory), offset))
+
+
+# --- SeqLock operations ---
+
+def seqlock_read(memory, offset, elem_size, align=8):
+    base = _base_ptr(memory)
+    buf = (ctypes.c_char * elem_size)()
+    rc = _lib.zeroipc_raw_seqlock_read(base, offset, buf, elem_size, align)
+    _check_rc(rc, "seqlock_read")
+    return rc, bytes(buf) if rc == OK else None
+
+
+def seqlock_write(memory, offset, value_bytes, elem_size, align=8):
+    base = _base_ptr(memory)
+    buf = (ctypes.c_char * elem_size).from_buffer_copy(value_bytes)
+    rc = _lib.zeroipc_raw_seqlock_write(base, offset, buf, elem_size, align)
+    _check_rc(rc, "seqlock_write")
+    return rc
+
+
+def seqlock_write_begin(memory, offset):
+    _lib.zeroipc_raw_seqlock_write_begin(_base_ptr(memory), offset)
+
+
+def seqlock_write_end(memory, offset):
+    _lib.zeroipc_raw_seqlock_write_end(_base_ptr(memory), offset)
+
+
+def seqlock_sequence(memory, offset):
+    return _lib.zeroipc_raw_seqlock_sequence(_base_ptr(memory), offset)
+
+
+def seqlock_wait(memory, offset, seen, timeout_ns):
+    """Futex-wait for a write after sequence `seen`; True if one completed."""
+    return _lib.zeroipc_raw_seqlock_wait(_base_ptr(memory), offset, seen, timeout_ns) == OK
+
+
+# --- Semaphore operations ---
+
+def semaphore_release(memory, offset, permits=1):
+    """Add permits and wake waiters; FULL if max_count would be exceeded."""
+    return _lib.zeroipc_raw_semaphore_release(_base_ptr(memory), offset, permits)
+
+
+# --- RWLock operations (timeout_ns < 0 waits forever) ---
+
+def rwlock_try_read_lock(memory, offset):
+    return _lib.zeroipc_raw_rwlock_try_read_lock(_base_ptr(memory), offset) == OK
+
+
+def rwlock_read_lock(memory, offset, timeout_ns=-1):
+    return _lib.zeroipc_raw_rwlock_read_lock(_base_ptr(memory), offset, timeout_ns) == OK
+
+
+def rwlock_read_unlock(memory, offset):
+    _lib.zeroipc_raw_rwlock_read_unlock(_base_ptr(memory), offset)
+
+
+def rwlock_try_write_lock(memory, offset):
+    return _lib.zeroipc_raw_rwlock_try_write_lock(_base_ptr(memory), offset) == OK
+
+
+def rwlock_write_lock(memory, offset, timeout_ns=-1):
+    return _lib.zeroipc_raw_rwlock_write_lock(_base_ptr(memory), offset, timeout_ns) == OK
+
+
+def rwlock_write_unlock(memory, offset):
+    _lib.zeroipc_raw_rwlock_write_unlock(_base_ptr(memory), offset)
+
+
+# --- Monitor operations (timeout_ns < 0 waits forever) ---
+
+def monitor_try_lock(memory, offset):
+    return _lib.zeroipc_raw_monitor_try_lock(_base_ptr(memory), offset) == OK
+
+
+def monitor_lock(memory, offset, timeout_ns=-1):
+    return _lib.zeroipc_raw_monitor_lock(_base_ptr(memory), offset, timeout_ns) == OK
+
+
+def monitor_unlock(memory, offset):
+    _lib.zeroipc_raw_monitor_unlock(_base_ptr(memory), offset)
+
+
+def monitor_wait(memory, offset, timeout_ns=-1):
+    """Release the lock, wait for a notify and relock; True if notified."""
+    return _lib.zeroipc_raw_monitor_wait(_base_ptr(memory), offset, timeout_ns) == OK
+
+
+def monitor_notify_one(memory, offset):
+    _lib.zeroipc_raw_monitor_notify_one(_base_ptr(memory), offset)
+
+
+def monitor_notify_all(memory, offset):
+    _lib.zeroipc_raw_monitor_notify_all(_base_ptr(memory), offset)
+
+
+# --- Table operations (buffer is a writable memoryview of the segment) ---
+
+def _buffer_ptr(buffer):
+    """Get a ctypes void pointer to the start of a writable buffer."""
+    return ctypes.c_void_p(ctypes.addressof(ctypes.c_char.from_buffer(buffer)))
+
+
+def table_allocate(buffer, size, alignment):
+    out = ctypes.c_uint64()
+    rc = _lib.zeroipc_raw_table_allocate(_buffer_ptr(buffer), size, alignment,
+                                         ctypes.byref(out))
+    return rc, out.value
+
+
+def table_add(buffer, max_entries, name_bytes, offset, size, alignment=8):
+    return _lib.zeroipc_raw_table_add(_buffer_ptr(buffer), max_entries,
+                                      name_bytes, offset, size, alignment)
+
+
+def table_allocate_entry(buffer, max_entries, name_bytes, size, alignment=8):
+    out = ctypes.c_uint64()
+    rc = _lib.zeroipc_raw_table_allocate_entry(_buffer_ptr(buffer), max_entries,
+                                               name_bytes, size, alignment,
+                                               ctypes.byref(out))
+    return rc, out.value
@@ -50,6 +50,8 @@ class Array:
         if entry:
             # Open existing array
             self.offset = entry.offset
+            # Data starts on the section alignment recorded by the creator
+            data_start = (self.HEADER_SIZE + entry.section_align - 1) & ~(entry.section_align - 1)
             
             # Read capacity from header
             capacity_bytes = memory.mmap[self.offset:self.offset + self.HEADER_SIZE]
@@ -73,11 +75,8 @@ class Array:
             
             # Allocate space
             total_size = self.HEADER_SIZE + capacity * self.dtype.itemsize
-            self.offset = memory.table.allocate(total_size)
-            
-            # Add to table
-            if not memory.table.add(name, self.offset, total_size):
-                raise RuntimeError("Failed to add array to table (table full?)")
+            self.offset = memory.allocate(name, total_size)
+            data_start = self.HEADER_SIZE
             
             # Write header
             struct.pack_into(
@@ -90,7 +89,7 @@ class Array:
             memory.mmap[data_offset:data_offset + data_size] = bytes(data_size)
         
         # Create NumPy array view of the data
-        data_offset = self.offset + self.HEADER_SIZE
+        data_offset = self.offset + data_start
         self.array = np.frombuffer(
             memory.mmap,
             dtype=self.dtype,
@@ -120,9 +120,7 @@ class Channel:
 
         if sync_entry is None and not open_existing:
             sync_size = 16
-            sync_offset = memory.table.allocate(sync_size)
-            if not memory.table.add(sync_name, sync_offset, sync_size):
-                raise RuntimeError("Failed to add channel synchronization state")
+            sync_offset = memory.allocate(sync_name, sync_size)
 
             self.sync_buffer = memory.at(sync_offset)
             # Initialize: no one waiting, not closed, store logical capacity
@@ -112,10 +112,7 @@ class Future:
         total_size = 16 + self.value_size + 256
 
         # Allocate space
-        self.offset = self.memory.table.allocate(total_size)
-
-        if not self.memory.table.add(self.name, self.offset, total_size):
-            raise RuntimeError("Failed to add Future to table")
+        self.offset = self.memory.allocate(self.name, total_size)
 
         # Get memory view
         self.buffer = self.memory.at(self.offset)
@@ -104,10 +104,7 @@ class Lazy:
         total_size = header_size
 
         # Allocate space
-        self.offset = self.memory.table.allocate(total_size)
-
-        if not self.memory.table.add(self.name, self.offset, total_size):
-            raise RuntimeError("Failed to add Lazy to table")
+        self.offset = self.memory.allocate(self.name, total_size)
 
         # Get memory view
         self.buffer = self.memory.at(self.offset)
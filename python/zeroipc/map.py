@@ -106,10 +106,7 @@ class Map(Generic[K, V]):
         total_size = header_size + self.entry_size * self.capacity
 
         # Allocate space
-        self.offset = self.memory.table.allocate(total_size)
-
-        if not self.memory.table.add(self.name, self.offset, total_size):
-            raise RuntimeError("Failed to add map to table")
+        self.offset = self.memory.allocate(self.name, total_size)
 
         # Get memory view
         self.buffer = self.memory.at(self.offset)
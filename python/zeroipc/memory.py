@@ -100,16 +100,17 @@ class Memory:
         Args:
             name: Structure name
             size: Size in bytes
-            alignment: Alignment requirement (default 8)
+            alignment: Section alignment inside the structure (default 8,
+                at most 4096); recorded in the table entry
 
         Returns:
             Offset where structure was allocated
         """
-        # Use table's allocate for proper alignment
-        aligned_offset = self.table.allocate(size, alignment)
-
-        # Add entry to table
-        if not self.table.add(name, aligned_offset, size):
+        # Claim the name before taking space (so a failed registration
+        # consumes none); the base gets its own cache line so the hot header
+        # atomics of neighbouring structures never share one
+        aligned_offset = self.table.allocate_entry(name, size, alignment)
+        if aligned_offset is None:
             raise RuntimeError(f"Failed to add '{name}' to table (table full?)")
 
         return aligned_offset
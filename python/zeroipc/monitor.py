@@ -1,4 +1,13 @@
-"""Monitor for condition variable synchronization across processes."""
+"""Monitor for condition variable synchronization across processes.
+
+Binary layout matches C++ (see SPECIFICATION.md).
+
+When libzeroipc_ffi.so is available, every operation runs the C++ futex
+protocol via ctypes, so Python processes share a monitor with C++ ones.
+Otherwise the state is updated with struct.pack_into under an
+interpreter-wide lock and waiters poll, which is only safe while every
+user of the monitor is a thread of this interpreter.
+"""
 
 import struct
 import time
@@ -6,8 +15,11 @@ import threading
 from typing import Callable, Optional
 
 from .memory import Memory
-from .mutex import Mutex
-from .semaphore import Semaphore
+from .table import CACHE_LINE_SIZE
+from . import _cffi
+
+# Serializes read-modify-writes of monitor state when there is no FFI
+_fallback_lock = threading.Lock()
 
 
 class Monitor:
@@ -25,10 +37,12 @@ class Monitor:
     - notify_all() to wake all waiters
     - Predicate-based waiting (handles spurious wakeups)
 
-    Binary layout:
-    - Mutex (via Semaphore)
-    - Semaphore for condition signaling
-    - Atomic counter for waiting threads (4 bytes)
+    Binary layout (16 bytes at `name`, cache-line aligned):
+    - 4 bytes: lock word (futex): 0 unlocked, 1 locked, 2 locked and
+      threads may be sleeping on it
+    - 4 bytes: condition sequence (futex), bumped by every notify
+    - 4 bytes: number of threads in wait()
+    - 4 bytes: reserved
 
     Example:
         >>> mem = Memory("/sync", 1024 * 1024)
@@ -53,8 +67,16 @@ class Monitor:
         >>> mon.unlock()
     """
 
-    COUNTER_FORMAT = 'I'  # Single uint32 for waiting count
-    COUNTER_SIZE = struct.calcsize(COUNTER_FORMAT)
+    UNLOCKED = 0
+    LOCKED = 1
+    CONTENDED = 2
+
+    STATE_FORMAT = '<IIII'  # lock, seq, waiters, reserved
+    STATE_SIZE = struct.calcsize(STATE_FORMAT)
+
+    _LOCK = 0
+    _SEQ = 4
+    _WAITERS = 8
 
     def __init__(self, memory: Memory, name: str, create_if_missing: bool = True):
         """
@@ -66,67 +88,56 @@ class Monitor:
             create_if_missing: If True, creates new monitor; if False, opens existing
 
         Raises:
-            RuntimeError: If monitor not found when create_if_missing=False
+            RuntimeError: If monitor not found when create_if_missing=False,
+                or the entry is not a Monitor of this layout
         """
         self.memory = memory
         self.name = name
 
-        mutex_name = name + "_mtx"
-        cond_name = name + "_cond"
-        counter_name = name + "_count"
-
-        # Try to find existing monitor
         entry = memory.table.find(name)
 
         if entry is None:
             if not create_if_missing:
                 raise RuntimeError(f"Monitor '{name}' not found")
 
-            # Create new monitor components
-            self._mutex = Mutex(memory, mutex_name, create_if_missing=True)
-            self._cond_sem = Semaphore(memory, cond_name, initial_count=0, max_count=0)
-
-            # Create waiting counter
-            self.counter_offset = memory.allocate(counter_name, self.COUNTER_SIZE)
-            counter_data = struct.pack(self.COUNTER_FORMAT, 0)
-            memory.data[self.counter_offset:self.counter_offset + self.COUNTER_SIZE] = counter_data
-
-            # Add marker entry
-            memory.allocate(name, 1)
+            self.offset = memory.allocate(name, self.STATE_SIZE, CACHE_LINE_SIZE)
+            struct.pack_into(self.STATE_FORMAT, memory.data, self.offset, 0, 0, 0, 0)
 
         else:
-            # Open existing monitor
-            self._mutex = Mutex(memory, mutex_name, create_if_missing=False)
-            self._cond_sem = Semaphore(memory, cond_name, initial_count=None)
-
-            counter_entry = memory.table.find(counter_name)
-            if not counter_entry:
-                raise RuntimeError(f"Monitor counter '{counter_name}' not found")
-
-            self.counter_offset = counter_entry.offset
-
-        # Lock for atomic counter operations
-        self._lock = threading.Lock()
-
-    def _load_waiting_count(self) -> int:
-        """Atomically load waiting count."""
-        return struct.unpack_from('<I', self.memory.data, self.counter_offset)[0]
-
-    def _store_waiting_count(self, value: int):
-        """Atomically store waiting count."""
-        struct.pack_into('<I', self.memory.data, self.counter_offset, value)
-
-    def _increment_waiting(self):
-        """Atomically increment waiting counter."""
-        with self._lock:
-            current = self._load_waiting_count()
-            self._store_waiting_count(current + 1)
+            if entry.size != self.STATE_SIZE:
+                raise RuntimeError(f"Monitor state size mismatch: {name}")
+            self.offset = entry.offset
+
+    def _load(self, field: int) -> int:
+        return struct.unpack_from('<I', self.memory.data, self.offset + field)[0]
+
+    def _store(self, field: int, value: int):
+        struct.pack_into('<I', self.memory.data, self.offset + field, value & 0xFFFFFFFF)
+
+    def _add(self, field: int, delta: int) -> int:
+        """Without FFI: add delta to a field; returns the new value."""
+        with _fallback_lock:
+            value = (self._load(field) + delta) & 0xFFFFFFFF
+            self._store(field, value)
+            return value
+
+    def _try_lock_fallback(self) -> bool:
+        with _fallback_lock:
+            if self._load(self._LOCK) != self.UNLOCKED:
+                return False
+            self._store(self._LOCK, self.LOCKED)
+            return True
 
-    def _decrement_waiting(self):
-        """Atomically decrement waiting counter."""
-        with self._lock:
-            current = self._load_waiting_count()
-            self._store_waiting_count(current - 1)
+    def _lock_fallback(self, deadline: Optional[float]) -> bool:
+        backoff = 0.0001  # 0.1ms
+        max_backoff = 0.001  # 1ms
+        while not self._try_lock_fallback():
+            if deadline is not None and time.monotonic() >= deadline:
+                return False
+            time.sleep(backoff)
+            if backoff < max_backoff:
+                backoff *= 2
+        return True
 
     def lock(self, timeout: Optional[float] = None) -> bool:
         """
@@ -140,11 +151,19 @@ class Monitor:
         Returns:
             True if lock acquired, False if timeout
         """
-        return self._mutex.lock(timeout=timeout)
+        if _cffi.AVAILABLE:
+            timeout_ns = -1 if timeout is None else max(0, int(timeout * 1e9))
+            return _cffi.monitor_lock(self.memory, self.offset, timeout_ns)
+        deadline = None if timeout is None else time.monotonic() + timeout
+        return self._lock_fallback(deadline)
 
     def unlock(self):
         """Unlock the monitor's mutex."""
-        self._mutex.unlock()
+        if _cffi.AVAILABLE:
+            _cffi.monitor_unlock(self.memory, self.offset)
+            return
+        with _fallback_lock:
+            self._store(self._LOCK, self.UNLOCKED)
 
     def try_lock(self) -> bool:
         """
@@ -153,7 +172,9 @@ class Monitor:
         Returns:
             True if lock acquired, false otherwise
         """
-        return self._mutex.try_lock()
+        if _cffi.AVAILABLE:
+            return _cffi.monitor_try_lock(self.memory, self.offset)
+        return self._try_lock_fallback()
 
     def wait(self, predicate: Optional[Callable[[], bool]] = None,
              timeout: Optional[float] = None) -> bool:
@@ -188,13 +209,13 @@ class Monitor:
             return self._wait_impl(timeout)
         else:
             # Predicate-based wait (handles spurious wakeups)
-            start_time = time.time() if timeout is not None else None
+            start_time = time.monotonic() if timeout is not None else None
 
             while not predicate():
                 # Calculate remaining timeout
                 remaining = None
                 if timeout is not None:
-                    elapsed = time.time() - start_time
+                    elapsed = time.monotonic() - start_time
                     if elapsed >= timeout:
                         return False  # Timeout
                     remaining = timeout - elapsed
@@ -213,24 +234,29 @@ class Monitor:
         Returns:
             True if woken, False if timeout
         """
-        # Increment waiting counter
-        self._increment_waiting()
+        if _cffi.AVAILABLE:
+            timeout_ns = -1 if timeout is None else max(0, int(timeout * 1e9))
+            return _cffi.monitor_wait(self.memory, self.offset, timeout_ns)
 
-        try:
-            # Release lock and wait on condition semaphore
-            self._mutex.unlock()
-
-            # Wait for signal
-            result = self._cond_sem.acquire(timeout=timeout)
-
-            # Reacquire lock
-            self._mutex.lock()
-
-            return result
+        # Read the sequence before unlocking so a notify in between is seen
+        seen = self._load(self._SEQ)
+        self._add(self._WAITERS, 1)
+        self.unlock()
 
-        finally:
-            # Decrement waiting counter
-            self._decrement_waiting()
+        deadline = None if timeout is None else time.monotonic() + timeout
+        backoff = 0.0001  # 0.1ms
+        max_backoff = 0.001  # 1ms
+        while self._load(self._SEQ) == seen:
+            if deadline is not None and time.monotonic() >= deadline:
+                break
+            time.sleep(backoff)
+            if backoff < max_backoff:
+                backoff *= 2
+        notified = self._load(self._SEQ) != seen
+
+        self._add(self._WAITERS, -1)
+        self._lock_fallback(None)
+        return notified
 
     def notify_one(self):
         """
@@ -241,12 +267,11 @@ class Monitor:
 
         NOTE: Should be called while holding the lock for proper semantics.
         """
-        # Only release when a waiter is registered, matching the C++
-        # implementation. Releasing unconditionally accumulates permits in
-        # the unbounded semaphore, making a later bare wait() (no
-        # predicate) return spuriously.
-        if self._load_waiting_count() > 0:
-            self._cond_sem.release()
+        if _cffi.AVAILABLE:
+            _cffi.monitor_notify_one(self.memory, self.offset)
+            return
+        # Pollers cannot be woken one at a time; all see the new sequence
+        self._add(self._SEQ, 1)
 
     def notify_all(self):
         """
@@ -256,14 +281,15 @@ class Monitor:
 
         NOTE: Should be called while holding the lock for proper semantics.
         """
-        count = self._load_waiting_count()
-        for _ in range(count):
-            self._cond_sem.release()
+        if _cffi.AVAILABLE:
+            _cffi.monitor_notify_all(self.memory, self.offset)
+            return
+        self._add(self._SEQ, 1)
 
     @property
     def waiting_count(self) -> int:
         """Get number of threads/processes currently waiting."""
-        return self._load_waiting_count()
+        return self._load(self._WAITERS)
 
     def __enter__(self):
         """Context manager entry: lock the monitor."""
@@ -4,6 +4,13 @@ Lock-free memory pool implementation for shared memory.
 This module provides a memory pool data structure that allows allocation
 and deallocation of fixed-size objects in shared memory using lock-free
 operations with a free list.
+
+The high byte of the header's elem_size records the header layout.
+LAYOUT_PADDED_HEAD moves the free-list head and the allocated count to a
+cache line of their own (offsets 64 and 72; the header's copies stay 0) and
+starts the nodes after a 128-byte header, so allocating threads do not
+false-share them with the read-mostly capacity and elem_size. C++ creates
+this layout by default.
 """
 
 import struct
@@ -12,9 +19,21 @@ import numpy as np
 
 from .memory import Memory
 from .atomic import AtomicInt, AtomicInt64
+from .table import CACHE_LINE_SIZE
 
 T = TypeVar('T')
 
+# Header layouts (high byte of the header's elem_size field)
+LAYOUT_COMPACT = 0
+LAYOUT_PADDED_HEAD = 0x04000000
+_ELEM_SIZE_MASK = 0x00FFFFFF
+
+# With LAYOUT_PADDED_HEAD: where free_head and allocated live, and the
+# header's size
+_PADDED_HEAD_OFFSET = CACHE_LINE_SIZE
+_PADDED_ALLOCATED_OFFSET = CACHE_LINE_SIZE + 8
+_PADDED_HEADER_SIZE = 2 * CACHE_LINE_SIZE
+
 
 class Pool:
     """
@@ -52,7 +71,8 @@ class Pool:
                  capacity: Optional[int] = None,
                  dtype: Optional[Union[np.dtype, str, type]] = None,
                  block_size: Optional[int] = None,
-                 block_count: Optional[int] = None):
+                 block_count: Optional[int] = None,
+                 layout: int = LAYOUT_COMPACT):
         """
         Create or open a memory pool.
 
@@ -63,6 +83,8 @@ class Pool:
             dtype: Element data type (for backward compatibility)
             block_size: Size of each block in bytes (new API)
             block_count: Number of blocks (new API)
+            layout: Header layout for creation (LAYOUT_COMPACT or
+                LAYOUT_PADDED_HEAD); opening reads it from the header
 
         Raises:
             ValueError: If required parameters are missing
@@ -83,6 +105,10 @@ class Pool:
             self._open_existing_init(entry)
         else:
             # Creating new pool - validate parameters
+            if layout & ~LAYOUT_PADDED_HEAD:
+                raise ValueError(f"unknown pool layout {layout:#x}")
+            self._bind_layout(layout)
+
             # Handle both API styles
             if block_size is not None and block_count is not None:
                 # New API: block-based
@@ -126,40 +152,29 @@ class Pool:
             # Create new pool
             self._create_new()
 
+    def _bind_layout(self, layout: int):
+        """Place free_head, allocated and the nodes for a header layout."""
+        self.layout = layout
+        if layout & LAYOUT_PADDED_HEAD:
+            self._head_off = _PADDED_HEAD_OFFSET
+            self._allocated_off = _PADDED_ALLOCATED_OFFSET
+            self._data_off = _PADDED_HEADER_SIZE
+        else:
+            self._head_off = 0
+            self._allocated_off = 8
+            self._data_off = self.HEADER_SIZE
+
     def _create_new(self):
         """Create a new pool in shared memory."""
-        # Header: free_head(8) + allocated(4) + padding(4) + capacity(4) + elem_size(4) = 24
-        header_size = self.HEADER_SIZE
-        total_size = header_size + self.node_size * self.capacity
+        total_size = self._data_off + self.node_size * self.capacity
 
         # Allocate space
-        self.offset = self.memory.table.allocate(total_size)
-
-        if not self.memory.table.add(self.name, self.offset, total_size):
-            raise RuntimeError("Failed to add pool to table")
+        self.offset = self.memory.allocate(self.name, total_size)
 
         # Get memory view
         self.buffer = self.memory.at(self.offset)
 
-        # Initialize header with tagged pointer (generation=0, index=0)
-        tagged_head = self._pack_tagged(0, 0)
-        struct.pack_into('<QIIII', self.buffer, 0,
-                        tagged_head,  # free_head as tagged pointer (uint64)
-                        0,            # allocated count
-                        0,            # padding
-                        self.capacity,
-                        self.elem_size)
-
-        # Initialize free list - all nodes are free
-        for i in range(self.capacity - 1):
-            node_offset = header_size + i * self.node_size
-            next_index = i + 1
-            # Write next index at the end of each node
-            struct.pack_into('<I', self.buffer, node_offset + self.next_offset, next_index)
-
-        # Last node points to NULL_INDEX
-        last_node_offset = header_size + (self.capacity - 1) * self.node_size
-        struct.pack_into('<I', self.buffer, last_node_offset + self.next_offset, self.NULL_INDEX)
+        self.reset()
 
     def _open_existing_init(self, entry):
         """Open an existing pool from shared memory."""
@@ -167,7 +182,12 @@ class Pool:
         self.buffer = self.memory.at(self.offset)
 
         # Read header: uint64 free_head + uint32 allocated + uint32 padding + uint32 capacity + uint32 elem_size
-        tagged_head, allocated, padding, capacity, elem_size = struct.unpack_from('<QIIII', self.buffer, 0)
+        tagged_head, allocated, padding, capacity, stored = struct.unpack_from('<QIIII', self.buffer, 0)
+        layout = stored & ~_ELEM_SIZE_MASK
+        elem_size = stored & _ELEM_SIZE_MASK
+        if layout & ~LAYOUT_PADDED_HEAD:
+            raise ValueError(f"unknown pool layout {layout:#x}")
+        self._bind_layout(layout)
 
         # Initialize fields from header
         self.capacity = capacity
@@ -183,7 +203,7 @@ class Pool:
 
     def _get_node_offset(self, index: int) -> int:
         """Get byte offset of node at given index."""
-        return self.HEADER_SIZE + index * self.node_size
+        return self._data_off + index * self.node_size
 
     def _read_node_next(self, index: int) -> int:
         """Read next index from node."""
@@ -224,7 +244,7 @@ class Pool:
             Index of allocated object, or None if pool is full
         """
         # Try to get a free node using tagged pointer (uint64)
-        free_head_atomic = AtomicInt64(self.buffer, 0)
+        free_head_atomic = AtomicInt64(self.buffer, self._head_off)
 
         while True:
             old_head = free_head_atomic.load()
@@ -243,7 +263,7 @@ class Pool:
             # Try to update the free head (tagged CAS prevents ABA)
             if free_head_atomic.compare_exchange_weak(old_head, new_head):
                 # Successfully allocated, increment allocated count
-                allocated_atomic = AtomicInt(self.buffer, 8)  # offset 8 after uint64 free_head
+                allocated_atomic = AtomicInt(self.buffer, self._allocated_off)
                 allocated_atomic.fetch_add(1)
                 return free_index
 
@@ -263,7 +283,7 @@ class Pool:
             return False
 
         # Add the node back to the free list using tagged pointer (uint64)
-        free_head_atomic = AtomicInt64(self.buffer, 0)
+        free_head_atomic = AtomicInt64(self.buffer, self._head_off)
 
         while True:
             old_head = free_head_atomic.load()
@@ -279,7 +299,7 @@ class Pool:
             # Try to make this node the new head (tagged CAS prevents ABA)
             if free_head_atomic.compare_exchange_weak(old_head, new_head):
                 # Successfully deallocated, decrement allocated count
-                allocated_atomic = AtomicInt(self.buffer, 8)  # offset 8 after uint64 free_head
+                allocated_atomic = AtomicInt(self.buffer, self._allocated_off)
                 current_allocated = allocated_atomic.load()
                 while current_allocated > 0:
                     if allocated_atomic.compare_exchange_weak(current_allocated, current_allocated - 1):
@@ -320,7 +340,7 @@ class Pool:
 
     def allocated_count(self) -> int:
         """Get number of currently allocated objects."""
-        return struct.unpack_from('<I', self.buffer, 8)[0]
+        return struct.unpack_from('<I', self.buffer, self._allocated_off)[0]
 
     def available_count(self) -> int:
         """Get number of available (free) objects."""
@@ -382,14 +402,16 @@ class Pool:
         # Reset header with tagged pointer (generation=0, index=0)
         tagged_head = self._pack_tagged(0, 0)
         struct.pack_into('<QIIII', self.buffer, 0,
-                        tagged_head,  # free_head as tagged pointer (uint64)
+                        0,            # free_head as tagged pointer (uint64)
                         0,            # allocated count
                         0,            # padding
                         self.capacity,
-                        self.elem_size)
+                        self.elem_size | self.layout)
+        struct.pack_into('<Q', self.buffer, self._head_off, tagged_head)
+        struct.pack_into('<I', self.buffer, self._allocated_off, 0)
 
         # Rebuild free list - all nodes are free
-        header_size = self.HEADER_SIZE
+        header_size = self._data_off
         for i in range(self.capacity - 1):
             node_offset = header_size + i * self.node_size
             next_index = i + 1
@@ -5,9 +5,23 @@ matching the C++/Go/C format for cross-language interoperability.
 
 Binary layout (format v2):
   [head:u32][tail:u32][capacity:u32][elem_size:u32]  (16 bytes header)
+  [pad to section alignment A]
   [data[0]][data[1]]...[data[cap-1]]                 (elem_size * capacity bytes)
-  [pad to 8-byte boundary]
-  [seq[0]:u32][seq[1]:u32]...[seq[cap-1]:u32]        (4 * capacity bytes, 8-aligned)
+  [pad to section alignment A]
+  [seq[0]:u32][seq[1]:u32]...[seq[cap-1]:u32]        (4 * capacity bytes)
+
+A is the alignment recorded in the table entry: 8 for queues created here,
+larger for C++ queues of over-aligned element types.
+
+The high byte of elem_size records the slot layout. The interleaved layouts
+store slot i as [data[i]][pad to 4][seq[i]:u32][pad to the slot alignment]
+(A, or at least a cache line for LAYOUT_INTERLEAVED_PADDED), so one push or
+pop touches one cache line instead of two.
+
+LAYOUT_PADDED_HEADER can be or-ed into any layout: head and tail then live
+at offsets 64 and 128 (the header's own fields stay 0) and the slots start
+after them at 192, so producers and consumers do not false-share the
+counters.
 
 When libzeroipc_ffi.so is available, push/pop use C11 atomics via ctypes
 for true cross-process MPMC safety. Otherwise falls back to struct.pack_into
@@ -20,6 +34,7 @@ from typing import Optional, TypeVar, Generic, Type
 import numpy as np
 
 from .memory import Memory
+from .table import MIN_SECTION_ALIGN, CACHE_LINE_SIZE
 from . import _cffi
 
 T = TypeVar('T')
@@ -28,10 +43,47 @@ T = TypeVar('T')
 _SEQ_FORMAT = 'I'
 _SEQ_SIZE = struct.calcsize(_SEQ_FORMAT)
 
+# Slot layouts (high byte of the header's elem_size field)
+LAYOUT_SPLIT = 0
+LAYOUT_INTERLEAVED = 0x01000000
+LAYOUT_INTERLEAVED_PADDED = 0x03000000
+LAYOUT_PADDED_HEADER = 0x04000000
+_LAYOUT_PADDED = 0x02000000
+_ELEM_SIZE_MASK = 0x00FFFFFF
+_LAYOUTS = (LAYOUT_SPLIT, LAYOUT_INTERLEAVED, LAYOUT_INTERLEAVED_PADDED)
+
+# With LAYOUT_PADDED_HEADER: where head and tail live, and the header's size
+_PADDED_HEAD_OFFSET = CACHE_LINE_SIZE
+_PADDED_TAIL_OFFSET = 2 * CACHE_LINE_SIZE
+_PADDED_HEADER_SIZE = 3 * CACHE_LINE_SIZE
+
 
-def _align8(n: int) -> int:
-    """Round n up to the next multiple of 8 (8-byte section alignment, format v2)."""
-    return (n + 7) & ~7
+def _valid_layout(layout: int) -> bool:
+    return (layout & ~LAYOUT_PADDED_HEADER) in _LAYOUTS
+
+
+def _align_up(n: int, alignment: int) -> int:
+    """Round n up to the section alignment (a power of two)."""
+    return (n + alignment - 1) & ~(alignment - 1)
+
+
+def _geometry(layout: int, capacity: int, elem_size: int, alignment: int):
+    """Slot placement for a layout, relative to the header.
+
+    Returns (data_off, data_stride, seq_off, seq_stride, end): slot i's
+    element is at data_off + i * data_stride, its sequence number at
+    seq_off + i * seq_stride.
+    """
+    header_size = _PADDED_HEADER_SIZE if layout & LAYOUT_PADDED_HEADER else Queue.HEADER_SIZE
+    if not layout & LAYOUT_INTERLEAVED:
+        data_off = _align_up(header_size, alignment)
+        seq_off = data_off + _align_up(elem_size * capacity, alignment)
+        return data_off, elem_size, seq_off, _SEQ_SIZE, seq_off + _SEQ_SIZE * capacity
+    slot_align = max(alignment, CACHE_LINE_SIZE) if layout & _LAYOUT_PADDED else alignment
+    seq_in_slot = _align_up(elem_size, _SEQ_SIZE)
+    stride = _align_up(seq_in_slot + _SEQ_SIZE, slot_align)
+    data_off = _align_up(header_size, slot_align)
+    return data_off, stride, data_off + seq_in_slot, stride, data_off + stride * capacity
 
 
 class Queue(Generic[T]):
@@ -50,7 +102,8 @@ class Queue(Generic[T]):
 
     def __init__(self, memory: Memory, name: str,
                  capacity: Optional[int] = None,
-                 dtype: Optional[Type] = None):
+                 dtype: Optional[Type] = None,
+                 layout: int = LAYOUT_SPLIT):
         """Create or open a queue.
 
         Args:
@@ -58,6 +111,8 @@ class Queue(Generic[T]):
             name: Queue identifier
             capacity: Number of elements (required for creation)
             dtype: Element type (required)
+            layout: Slot layout for creation (LAYOUT_*, optionally
+                | LAYOUT_PADDED_HEADER); opening reads it from the header
         """
         self.memory = memory
         self.name = name
@@ -78,6 +133,8 @@ class Queue(Generic[T]):
                 raise ValueError("capacity required to create new queue")
             if capacity < 1:
                 raise ValueError("capacity must be at least 1")
+            if not _valid_layout(layout):
+                raise ValueError(f"unknown queue layout {layout:#x}")
 
             # The Vyukov slot mapping (counter % capacity on monotonically
             # increasing uint32 counters) is only correct across the 2^32
@@ -87,10 +144,9 @@ class Queue(Generic[T]):
             capacity = 1 << (capacity - 1).bit_length()
 
             self.capacity = capacity
-            # Layout: [Header(16)][data: T*capacity][pad][seq: uint32*capacity]
-            total_size = (self.HEADER_SIZE
-                          + _align8(self.elem_size * capacity)
-                          + _SEQ_SIZE * capacity)
+            self.layout = layout
+            self._align = MIN_SECTION_ALIGN
+            total_size = _geometry(layout, capacity, self.elem_size, self._align)[4]
 
             # Allocate in shared memory
             self.offset = memory.allocate(name, total_size)
@@ -100,19 +156,16 @@ class Queue(Generic[T]):
                                     0,  # head
                                     0,  # tail
                                     capacity,
-                                    self.elem_size)
+                                    self.elem_size | layout)
             memory.data[self.offset:self.offset + self.HEADER_SIZE] = header_data
 
-            # Initialize per-slot sequence numbers: seq[i] = i (8-aligned start)
-            seq_base = self.offset + self.HEADER_SIZE + _align8(self.elem_size * capacity)
-            for i in range(capacity):
-                off = seq_base + i * _SEQ_SIZE
-                struct.pack_into(_SEQ_FORMAT, memory.data, off, i)
-
         else:
             # Open existing queue. The stored capacity is authoritative (it
             # may have been rounded up at creation).
             self.offset = entry.offset
+            # Sections follow the alignment recorded by the creator (a C++
+            # over-aligned element type moves data and the side array)
+            self._align = entry.section_align
             self.capacity = self._read_capacity()
 
             # Wrap-safety requires a power-of-two capacity (see creation
@@ -123,26 +176,48 @@ class Queue(Generic[T]):
                     "(created by an old implementation?)")
 
             # Verify element size matches
-            stored_elem_size = self._read_elem_size()
+            stored = self._read_elem_size()
+            self.layout = stored & ~_ELEM_SIZE_MASK
+            stored_elem_size = stored & _ELEM_SIZE_MASK
             if stored_elem_size != self.elem_size:
                 raise ValueError(f"Element size mismatch: expected {self.elem_size}, "
                                 f"found {stored_elem_size}")
-
-        # Create numpy array view of data
-        data_offset = self.offset + self.HEADER_SIZE
-        self.data = np.frombuffer(
-            self.memory.data,
+            if not _valid_layout(self.layout):
+                raise ValueError(f"unknown queue layout {self.layout:#x}")
+            if _geometry(self.layout, self.capacity, self.elem_size,
+                         self._align)[4] > entry.size:
+                raise ValueError("Queue is smaller than its header describes")
+
+        data_off, data_stride, seq_off, self._seq_stride, _ = _geometry(
+            self.layout, self.capacity, self.elem_size, self._align)
+
+        # Create numpy array view of the slots' elements
+        self.data = np.ndarray(
+            shape=(self.capacity,),
             dtype=self.dtype,
-            count=self.capacity,
-            offset=data_offset
+            buffer=self.memory.data,
+            offset=self.offset + data_off,
+            strides=(data_stride,)
         )
 
-        # Base offset for the sequence array (8-aligned)
-        self._seq_base = self.offset + self.HEADER_SIZE + _align8(self.elem_size * self.capacity)
+        # Slot 0's sequence number
+        self._seq_base = self.offset + seq_off
+
+        if entry is None:
+            # Initialize per-slot sequence numbers: seq[i] = i
+            for i in range(self.capacity):
+                self._write_seq(i, i)
 
         # Offsets for head/tail in shared memory
-        self._head_off = self.offset
-        self._tail_off = self.offset + 4
+        if self.layout & LAYOUT_PADDED_HEADER:
+            self._head_off = self.offset + _PADDED_HEAD_OFFSET
+            self._tail_off = self.offset + _PADDED_TAIL_OFFSET
+        else:
+            self._head_off = self.offset
+            self._tail_off = self.offset + 4
+        if entry is None:
+            self._write_head(0)
+            self._write_tail(0)
 
         # Lock for thread safety within a single process.
         # Cross-process safety relies on SPSC discipline (one producer
@@ -175,12 +250,12 @@ class Queue(Generic[T]):
 
     def _read_seq(self, slot: int) -> int:
         """Read sequence number for a slot."""
-        off = self._seq_base + slot * _SEQ_SIZE
+        off = self._seq_base + slot * self._seq_stride
         return struct.unpack_from(_SEQ_FORMAT, self.memory.data, off)[0]
 
     def _write_seq(self, slot: int, value: int):
         """Write sequence number for a slot."""
-        off = self._seq_base + slot * _SEQ_SIZE
+        off = self._seq_base + slot * self._seq_stride
         struct.pack_into(_SEQ_FORMAT, self.memory.data, off, value & 0xFFFFFFFF)
 
     @staticmethod
@@ -200,7 +275,8 @@ class Queue(Generic[T]):
         if _cffi.AVAILABLE:
             value_bytes = self.dtype.type(value).tobytes()
             return _cffi.queue_push(self.memory, self.offset,
-                                    value_bytes, self.elem_size) == _cffi.OK
+                                    value_bytes, self.elem_size,
+                                    self._align) == _cffi.OK
 
         with self._lock:
             tail = self._read_tail()
@@ -218,7 +294,8 @@ class Queue(Generic[T]):
     def pop(self) -> Optional[T]:
         """Pop value from queue. Returns value or None if empty."""
         if _cffi.AVAILABLE:
-            rc, raw = _cffi.queue_pop(self.memory, self.offset, self.elem_size)
+            rc, raw = _cffi.queue_pop(self.memory, self.offset,
+                                      self.elem_size, self._align)
             if rc != _cffi.OK:
                 return None
             return np.frombuffer(raw, dtype=self.dtype)[0].copy()
@@ -81,10 +81,7 @@ class Ring:
         total_size = header_size + self.byte_capacity
 
         # Allocate space
-        self.offset = self.memory.table.allocate(total_size)
-
-        if not self.memory.table.add(self.name, self.offset, total_size):
-            raise RuntimeError("Failed to add ring buffer to table")
+        self.offset = self.memory.allocate(self.name, total_size)
 
         # Get memory view
         self.buffer = self.memory.at(self.offset)
@@ -1,4 +1,13 @@
-"""Read-Write Lock for shared memory."""
+"""Read-Write Lock for shared memory.
+
+Binary layout matches C++/C (see SPECIFICATION.md).
+
+When libzeroipc_ffi.so is available, every operation runs the C++ word
+protocol with C11 atomics and futexes via ctypes, so Python processes share
+a lock with C++ ones. Otherwise the word is updated with struct.pack_into
+under an interpreter-wide lock, which is only safe while every user of the
+lock is a thread of this interpreter.
+"""
 
 import struct
 import time
@@ -6,7 +15,11 @@ import threading
 from typing import Optional
 
 from .memory import Memory
-from .mutex import Mutex
+from .table import CACHE_LINE_SIZE
+from . import _cffi
+
+# Serializes read-modify-writes of lock words when there is no FFI
+_fallback_lock = threading.Lock()
 
 
 class RWLock:
@@ -19,17 +32,19 @@ class RWLock:
     Features:
     - Multiple readers can hold lock simultaneously
     - Writer gets exclusive access (no readers, no other writers)
+    - Writer preference: a waiting writer blocks new readers
     - RAII-compatible with context managers
 
     Performance characteristics:
-    - reader_lock(): Fast when no writers (just atomic increment)
+    - reader_lock(): One atomic add when no writer holds or waits
     - writer_lock(): Waits for all readers to finish
 
-    Binary layout:
-    - 4 bytes: active readers count
-    - 4 bytes: writer active flag
-    - Mutex for reader coordination
-    - Mutex for writer exclusion
+    Binary layout (8 bytes at `name`, cache-line aligned):
+    - 4 bytes: lock word (futex)
+      - bits 0-29: active readers count
+      - bit 30:    writer waiting (new readers hold off)
+      - bit 31:    writer active
+    - 4 bytes: number of threads parked on the lock word
 
     Example:
         >>> mem = Memory("/data", 1024 * 1024)
@@ -54,7 +69,11 @@ class RWLock:
         >>>     data[0] = 99
     """
 
-    STATE_FORMAT = 'ii'  # readers, writer_active
+    WRITER = 1 << 31
+    WRITER_WAITING = 1 << 30
+    READERS_MASK = WRITER_WAITING - 1
+
+    STATE_FORMAT = '<II'  # word, parked
     STATE_SIZE = struct.calcsize(STATE_FORMAT)
 
     def __init__(self, memory: Memory, name: str, create_if_missing: bool = True):
@@ -67,107 +86,76 @@ class RWLock:
             create_if_missing: If True, creates new lock; if False, opens existing
 
         Raises:
-            RuntimeError: If lock not found when create_if_missing=False
+            RuntimeError: If lock not found when create_if_missing=False, or
+                the entry is not a single-word RWLock
         """
         self.memory = memory
         self.name = name
 
-        state_name = name + "_state"
-        reader_mtx_name = name + "_rmtx"
-        writer_mtx_name = name + "_wmtx"
-
-        # Try to find existing RWLock
         entry = memory.table.find(name)
 
         if entry is None:
             if not create_if_missing:
                 raise RuntimeError(f"RWLock '{name}' not found")
 
-            # Create new RWLock state
-            self.state_offset = memory.allocate(state_name, self.STATE_SIZE)
-
-            # Initialize state (readers=0, writer_active=0)
-            state_data = struct.pack(self.STATE_FORMAT, 0, 0)
-            memory.data[self.state_offset:self.state_offset + self.STATE_SIZE] = state_data
-
-            # Create mutexes
-            self._reader_mutex = Mutex(memory, reader_mtx_name, create_if_missing=True)
-            self._writer_mutex = Mutex(memory, writer_mtx_name, create_if_missing=True)
-
-            # Add marker entry
-            memory.allocate(name, 1)
+            self.offset = memory.allocate(name, self.STATE_SIZE, CACHE_LINE_SIZE)
+            struct.pack_into(self.STATE_FORMAT, memory.data, self.offset, 0, 0)
 
         else:
-            # Open existing RWLock
-            state_entry = memory.table.find(state_name)
-            if not state_entry:
-                raise RuntimeError(f"RWLock state '{state_name}' not found")
-
-            self.state_offset = state_entry.offset
-
-            if state_entry.size != self.STATE_SIZE:
-                raise RuntimeError(f"Invalid RWLock state size: {state_entry.size}")
-
-            # Open existing mutexes
-            self._reader_mutex = Mutex(memory, reader_mtx_name, create_if_missing=False)
-            self._writer_mutex = Mutex(memory, writer_mtx_name, create_if_missing=False)
-
-        # Offsets for atomic operations
-        self._readers_offset = self.state_offset
-        self._writer_active_offset = self.state_offset + 4
-
-        # Lock for atomic operations
-        self._lock = threading.Lock()
-
-    def _load_readers(self) -> int:
-        """Atomically load readers count."""
-        return struct.unpack_from('<i', self.memory.data, self._readers_offset)[0]
-
-    def _store_readers(self, value: int):
-        """Atomically store readers count."""
-        struct.pack_into('<i', self.memory.data, self._readers_offset, value)
-
-    def _load_writer_active(self) -> int:
-        """Atomically load writer active flag."""
-        return struct.unpack_from('<i', self.memory.data, self._writer_active_offset)[0]
-
-    def _store_writer_active(self, value: int):
-        """Atomically store writer active flag."""
-        struct.pack_into('<i', self.memory.data, self._writer_active_offset, value)
+            if entry.size != self.STATE_SIZE:
+                raise RuntimeError(f"RWLock state size mismatch: {name}")
+            self.offset = entry.offset
+
+    def _load_word(self) -> int:
+        return struct.unpack_from('<I', self.memory.data, self.offset)[0]
+
+    def _store_word(self, value: int):
+        struct.pack_into('<I', self.memory.data, self.offset, value)
+
+    def _update_word(self, next_word) -> bool:
+        """Without FFI: apply next_word(word) if it returns a value."""
+        with _fallback_lock:
+            want = next_word(self._load_word())
+            if want is None:
+                return False
+            self._store_word(want)
+            return True
+
+    def _wait_fallback(self, next_word):
+        backoff = 0.0001  # 0.1ms
+        max_backoff = 0.001  # 1ms
+        while not self._update_word(next_word):
+            time.sleep(backoff)
+            if backoff < max_backoff:
+                backoff *= 2
 
-    def _increment_readers(self):
-        """Atomically increment readers count."""
-        with self._lock:
-            current = self._load_readers()
-            self._store_readers(current + 1)
+    def _readable(self, s: int) -> Optional[int]:
+        if s & (self.WRITER | self.WRITER_WAITING):
+            return None
+        return s + 1
 
-    def _decrement_readers(self):
-        """Atomically decrement readers count."""
-        with self._lock:
-            current = self._load_readers()
-            self._store_readers(current - 1)
+    def _writable(self, s: int) -> Optional[int]:
+        if s & ~self.WRITER_WAITING:
+            return None
+        return self.WRITER
 
     def reader_lock(self):
         """
         Acquire read lock (shared access).
 
         Multiple threads can hold read locks simultaneously.
-        Blocks if a writer currently holds the lock.
+        Blocks while a writer holds the lock or is waiting for it.
         """
-        # Acquire reader mutex
-        self._reader_mutex.lock()
+        if _cffi.AVAILABLE:
+            _cffi.rwlock_read_lock(self.memory, self.offset)
+            return
+        self._wait_fallback(self._readable)
 
-        # Wait for any active writer to finish
-        while self._load_writer_active() != 0:
-            self._reader_mutex.unlock()
-            time.sleep(0.0001)  # Yield to other threads
-            self._reader_mutex.lock()
-
-        # Increment readers count
-        self._increment_readers()
-
-        # Release reader mutex
-        self._reader_mutex.unlock()
+    def try_reader_lock(self) -> bool:
+        """Acquire read lock without blocking; True if acquired."""
+        if _cffi.AVAILABLE:
+            return _cffi.rwlock_try_read_lock(self.memory, self.offset)
+        return self._update_word(self._readable)
 
     def reader_unlock(self):
         """
@@ -175,21 +163,18 @@ class RWLock:
 
         Must be called by the same thread that acquired the read lock.
         """
-        # Acquire reader mutex
-        self._reader_mutex.lock()
-
-        # Decrement readers count
-        self._decrement_readers()
-
-        # Release reader mutex
-        self._reader_mutex.unlock()
+        if _cffi.AVAILABLE:
+            _cffi.rwlock_read_unlock(self.memory, self.offset)
+            return
+        self._update_word(lambda s: s - 1)
 
     def writer_lock(self, timeout: Optional[float] = None) -> bool:
         """
         Acquire write lock (exclusive access).
 
         Only one thread can hold the write lock at a time.
-        Blocks until all readers have released their locks.
+        Blocks until all readers have released their locks; new readers
+        hold off while it waits.
 
         Args:
             timeout: Maximum time to wait in seconds (None for infinite)
@@ -197,43 +182,40 @@ class RWLock:
         Returns:
             True if lock acquired, False if timeout
         """
-        # Acquire writer mutex (blocks other writers)
-        if not self._writer_mutex.lock(timeout=timeout):
-            return False
-
-        # Mark writer as active UNDER the reader mutex. Readers check
-        # writer_active and increment readers while holding the reader
-        # mutex; setting the flag under the same mutex closes the race
-        # where a reader passes its writer check while the writer
-        # simultaneously passes its readers check, letting a reader and
-        # a writer hold the lock at once.
-        if not self._reader_mutex.lock(timeout=timeout):
-            self._writer_mutex.unlock()
-            return False
-        self._store_writer_active(1)
-        self._reader_mutex.unlock()
-
-        # Wait for all readers to finish
-        start_time = time.time() if timeout is not None else None
+        if _cffi.AVAILABLE:
+            timeout_ns = -1 if timeout is None else max(0, int(timeout * 1e9))
+            return _cffi.rwlock_write_lock(self.memory, self.offset, timeout_ns)
+
+        deadline = None if timeout is None else time.monotonic() + timeout
+        announced = False
         backoff = 0.0001  # 0.1ms
         max_backoff = 0.001  # 1ms
-
-        while self._load_readers() > 0:
-            # Check timeout
-            if timeout is not None:
-                elapsed = time.time() - start_time
-                if elapsed >= timeout:
-                    # Timeout - release writer mutex and fail
-                    self._store_writer_active(0)
-                    self._writer_mutex.unlock()
-                    return False
-
-            # Spin-wait with backoff
+        while True:
+            # Take the lock once it is free; otherwise announce ourselves so
+            # no new readers get in
+            with _fallback_lock:
+                s = self._load_word()
+                if not s & ~self.WRITER_WAITING:
+                    self._store_word(self.WRITER)
+                    return True
+                if not s & self.WRITER_WAITING:
+                    self._store_word(s | self.WRITER_WAITING)
+                    announced = True
+            if deadline is not None and time.monotonic() >= deadline:
+                # Stop holding readers off; other waiting writers set the
+                # bit again
+                if announced:
+                    self._update_word(lambda s: s & ~self.WRITER_WAITING)
+                return False
             time.sleep(backoff)
             if backoff < max_backoff:
                 backoff *= 2
 
-        return True
+    def try_writer_lock(self) -> bool:
+        """Acquire write lock without blocking; True if acquired."""
+        if _cffi.AVAILABLE:
+            return _cffi.rwlock_try_write_lock(self.memory, self.offset)
+        return self._update_word(self._writable)
 
     def writer_unlock(self):
         """
@@ -241,21 +223,20 @@ class RWLock:
 
         Must be called by the same thread that acquired the write lock.
         """
-        # Mark writer as inactive
-        self._store_writer_active(0)
-
-        # Release writer mutex
-        self._writer_mutex.unlock()
+        if _cffi.AVAILABLE:
+            _cffi.rwlock_write_unlock(self.memory, self.offset)
+            return
+        self._update_word(lambda s: s & ~self.WRITER)
 
     @property
     def readers(self) -> int:
         """Get current number of active readers."""
-        return self._load_readers()
+        return self._load_word() & self.READERS_MASK
 
     @property
     def writer_active(self) -> bool:
         """Check if a writer is currently active."""
-        return self._load_writer_active() == 1
+        return bool(self._load_word() & self.WRITER)
 
     def reader(self):
         """
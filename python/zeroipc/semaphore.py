@@ -5,6 +5,7 @@ import time
 import threading
 from typing import Optional
 
+from . import _cffi
 from .memory import Memory
 
 
@@ -25,7 +26,7 @@ class Semaphore:
     Thread-safe and process-safe.
     """
 
-    HEADER_FORMAT = 'iiii'  # count, waiting, max_count, padding
+    HEADER_FORMAT = 'iiii'  # count, waiting, max_count, queue_slots (0)
     HEADER_SIZE = struct.calcsize(HEADER_FORMAT)
 
     def __init__(self, memory: Memory, name: str,
@@ -212,11 +213,18 @@ class Semaphore:
         Release one permit back to the semaphore.
 
         Increments the count, potentially waking a waiting process.
-        Uses CAS loop to atomically check max_count and increment.
+        Uses CAS loop to atomically check max_count and increment. With the
+        FFI library this also wakes C++ waiters asleep on the count;
+        without it they notice within their 100ms sleep slice.
 
         Raises:
             OverflowError: If max_count would be exceeded
         """
+        if _cffi.AVAILABLE:
+            if _cffi.semaphore_release(self.memory, self.offset) != _cffi.OK:
+                raise OverflowError("Semaphore count would exceed maximum")
+            return
+
         # Atomically check and increment to prevent TOCTOU race
         while True:
             current = self._load_count()
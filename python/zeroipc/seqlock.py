@@ -0,0 +1,252 @@
+"""Sequence lock for single-writer, many-reader values in shared memory.
+
+Binary layout matches C++/C/Go (see SPECIFICATION.md).
+
+When libzeroipc_ffi.so is available, reads and writes use C11 atomics via
+ctypes, so Python processes can take part alongside C/C++/Go writers and
+readers. Otherwise reads are still safe against any writer, but writes fall
+back to struct.pack_into and are only safe with a single writing process.
+"""
+
+import struct
+import threading
+import time
+from typing import Any, Callable, Optional
+
+import numpy as np
+
+from .memory import Memory
+from .table import MIN_SECTION_ALIGN
+from . import _cffi
+
+# Bounds on read retries (matching C++/C/Go): after _SPIN_ATTEMPTS we start
+# yielding; after _READ_ATTEMPTS the writer is presumed dead mid-write.
+_SPIN_ATTEMPTS = 64
+_READ_ATTEMPTS = 1 << 20
+
+# Longest single blocking FFI wait, so Ctrl-C is still seen between waits
+_WAIT_SLICE = 1.0
+
+
+def _align_up(n: int, alignment: int) -> int:
+    """Round n up to the section alignment (a power of two)."""
+    return (n + alignment - 1) & ~(alignment - 1)
+
+
+class SeqLock:
+    """
+    Sequence lock holding one value of a fixed-size dtype.
+
+    A writer makes the sequence odd, copies the value in and makes it even
+    again; readers copy the value out between two loads of the sequence and
+    retry if they differ or were odd. Readers never block the writer and
+    never write shared memory.
+
+    Binary layout:
+    - 8 bytes: sequence (even: stable, odd: write in progress)
+    - 4 bytes: elem_size
+    - 4 bytes: waiters (threads parked in wait_for_change)
+    - N bytes: value (at the section alignment, 16 for the default 8)
+
+    Example:
+        >>> telemetry = np.dtype([('tick', '<u8'), ('position', '<f8', 3)])
+        >>> state = SeqLock(mem, "state", dtype=telemetry, initial_value=(0, (0, 0, 0)))
+        >>> state.store((1, (1.0, 2.0, 3.0)))
+        >>> state.load()['tick']
+        1
+    """
+
+    HEADER_FORMAT = '<QI4x'  # seq, elem_size, waiters
+    HEADER_SIZE = struct.calcsize(HEADER_FORMAT)  # 16
+
+    def __init__(self, memory: Memory, name: str, *,
+                 dtype: np.dtype,
+                 initial_value: Any = None,
+                 create_if_missing: bool = True):
+        """
+        Create or open a SeqLock.
+
+        Args:
+            memory: Memory instance
+            name: SeqLock identifier
+            dtype: NumPy dtype of the value (structured dtypes for records)
+            initial_value: Initial value (only used when creating; default zero)
+            create_if_missing: If True, creates new seqlock; if False, opens existing
+
+        Raises:
+            RuntimeError: If not found when create_if_missing=False, or the
+                stored element size differs from dtype's
+        """
+        self.memory = memory
+        self.name = name
+        self.dtype = np.dtype(dtype)
+        self.elem_size = self.dtype.itemsize
+
+        entry = memory.table.find(name)
+
+        if entry is None:
+            if not create_if_missing:
+                raise RuntimeError(f"SeqLock '{name}' not found")
+
+            self._align = max(MIN_SECTION_ALIGN, self.dtype.alignment)
+            value_offset = _align_up(self.HEADER_SIZE, self._align)
+            self.offset = memory.allocate(name, value_offset + self.elem_size, self._align)
+            self._value_offset = self.offset + value_offset
+
+            struct.pack_into(self.HEADER_FORMAT, memory.data, self.offset, 0, self.elem_size)
+            if initial_value is None:
+                raw = bytes(self.elem_size)
+            else:
+                raw = self._to_bytes(initial_value)
+            memory.data[self._value_offset:self._value_offset + self.elem_size] = raw
+
+        else:
+            self.offset = entry.offset
+            self._align = entry.section_align
+            self._value_offset = self.offset + _align_up(self.HEADER_SIZE, self._align)
+
+            stored = struct.unpack_from('<I', memory.data, self.offset + 8)[0]
+            if stored != self.elem_size or \
+                    entry.size < self._value_offset - self.offset + self.elem_size:
+                raise RuntimeError(
+                    f"SeqLock element size mismatch: expected {self.elem_size}, got {stored}"
+                )
+
+        # Serializes writers within this interpreter when there is no FFI
+        self._lock = threading.Lock()
+
+    def _to_bytes(self, value: Any) -> bytes:
+        return np.array([value], dtype=self.dtype).tobytes()
+
+    def _from_bytes(self, raw: bytes) -> Any:
+        return np.frombuffer(raw, dtype=self.dtype)[0].copy()
+
+    def _load_seq(self) -> int:
+        return struct.unpack_from('<Q', self.memory.data, self.offset)[0]
+
+    def _store_seq(self, value: int):
+        struct.pack_into('<Q', self.memory.data, self.offset, value)
+
+    def _read_raw(self) -> bytes:
+        return bytes(self.memory.data[self._value_offset:self._value_offset + self.elem_size])
+
+    def _write_raw(self, raw: bytes):
+        self.memory.data[self._value_offset:self._value_offset + self.elem_size] = raw
+
+    def try_load(self) -> Optional[Any]:
+        """
+        Copy out the value as of the last completed write.
+
+        Returns:
+            The value, or None if no clean copy was possible (a writer died
+            mid-write)
+        """
+        if _cffi.AVAILABLE:
+            rc, raw = _cffi.seqlock_read(self.memory, self.offset, self.elem_size, self._align)
+            return self._from_bytes(raw) if rc == _cffi.OK else None
+
+        for attempt in range(_READ_ATTEMPTS):
+            before = self._load_seq()
+            if before & 1 == 0:
+                raw = self._read_raw()
+                if self._load_seq() == before:
+                    return self._from_bytes(raw)
+            if attempt >= _SPIN_ATTEMPTS:
+                time.sleep(0)
+        return None
+
+    def load(self) -> Any:
+        """
+        Get the current value.
+
+        Raises:
+            RuntimeError: If the value is stuck mid-write
+        """
+        value = self.try_load()
+        if value is None:
+            raise RuntimeError(f"SeqLock '{self.name}' value is stuck mid-write")
+        return value
+
+    def store(self, value: Any):
+        """Replace the value."""
+        raw = self._to_bytes(value)
+        if _cffi.AVAILABLE:
+            _cffi.seqlock_write(self.memory, self.offset, raw, self.elem_size, self._align)
+            return
+
+        with self._lock:
+            seq = self._load_seq()
+            self._store_seq(seq + 1)
+            self._write_raw(raw)
+            self._store_seq(seq + 2)
+
+    def update(self, func: Callable[[Any], Any]) -> Any:
+        """
+        Replace the value with func(current), atomically with respect to
+        other writers, and return the new value.
+        """
+        if _cffi.AVAILABLE:
+            _cffi.seqlock_write_begin(self.memory, self.offset)
+            try:
+                new_value = func(self._from_bytes(self._read_raw()))
+                self._write_raw(self._to_bytes(new_value))
+            finally:
+                _cffi.seqlock_write_end(self.memory, self.offset)
+            return new_value
+
+        with self._lock:
+            seq = self._load_seq()
+            self._store_seq(seq + 1)
+            try:
+                new_value = func(self._from_bytes(self._read_raw()))
+                self._write_raw(self._to_bytes(new_value))
+            finally:
+                self._store_seq(seq + 2)
+            return new_value
+
+    @property
+    def sequence(self) -> int:
+        """Twice the number of completed writes (odd while one is in progress)."""
+        if _cffi.AVAILABLE:
+            return _cffi.seqlock_sequence(self.memory, self.offset)
+        return self._load_seq()
+
+    def wait_for_change(self, seen: int, timeout: Optional[float] = None) -> bool:
+        """
+        Wait until a write completes after the one that produced `seen` (a
+        value of `sequence`).
+
+        With the FFI library this sleeps on a futex that writers in any
+        language wake; otherwise it polls with backoff.
+
+        Args:
+            seen: Sequence number to wait for change from
+            timeout: Maximum time to wait in seconds (None for infinite)
+
+        Returns:
+            True if changed, False if timeout
+        """
+        deadline = None if timeout is None else time.monotonic() + timeout
+
+        if _cffi.AVAILABLE:
+            while True:
+                left = _WAIT_SLICE if deadline is None else \
+                    min(_WAIT_SLICE, deadline - time.monotonic())
+                if _cffi.seqlock_wait(self.memory, self.offset, seen,
+                                      max(0, int(left * 1e9))):
+                    return True
+                if deadline is not None and time.monotonic() >= deadline:
+                    return False
+
+        backoff = 0.0001  # 0.1ms
+        max_backoff = 0.001  # 1ms
+        while self.sequence & ~1 == seen & ~1:
+            if deadline is not None and time.monotonic() >= deadline:
+                return False
+            time.sleep(backoff)
+            if backoff < max_backoff:
+                backoff *= 2
+        return True
+
+    def __repr__(self):
+        return f"SeqLock(name='{self.name}', dtype={self.dtype}, sequence={self.sequence})"
@@ -2,6 +2,12 @@
 
 Uses 4-state CAS protocol binary layout matching C++/Go/C format.
 
+The high byte of the header's elem_size records the header layout.
+LAYOUT_PADDED_TOP moves top to offset 64 (the header's own top stays -1)
+and starts the data after a 128-byte header, so pushers and poppers do not
+false-share top with the read-mostly fields. C++ creates this layout by
+default.
+
 When libzeroipc_ffi.so is available, push/pop use C11 atomics via ctypes
 for true cross-process MPMC safety. Otherwise falls back to struct.pack_into
 (SPSC-only across processes, MPMC within a single interpreter via threading.Lock).
@@ -14,6 +20,7 @@ from typing import Optional, TypeVar, Generic, Type
 import numpy as np
 
 from .memory import Memory
+from .table import MIN_SECTION_ALIGN, CACHE_LINE_SIZE
 from . import _cffi
 
 T = TypeVar('T')
@@ -34,10 +41,19 @@ _STATE_SIZE = struct.calcsize(_STATE_FORMAT)
 # top best-effort instead of hanging.
 _MAX_SPINS = 10000
 
+# Header layouts (high byte of the header's elem_size field)
+LAYOUT_COMPACT = 0
+LAYOUT_PADDED_TOP = 0x04000000
+_ELEM_SIZE_MASK = 0x00FFFFFF
+
+# With LAYOUT_PADDED_TOP: where top lives, and the header's size
+_PADDED_TOP_OFFSET = CACHE_LINE_SIZE
+_PADDED_HEADER_SIZE = 2 * CACHE_LINE_SIZE
 
-def _align8(n: int) -> int:
-    """Round n up to the next multiple of 8 (8-byte section alignment, format v2)."""
-    return (n + 7) & ~7
+
+def _align_up(n: int, alignment: int) -> int:
+    """Round n up to the section alignment (a power of two)."""
+    return (n + alignment - 1) & ~(alignment - 1)
 
 
 class Stack(Generic[T]):
@@ -58,7 +74,8 @@ class Stack(Generic[T]):
 
     def __init__(self, memory: Memory, name: str,
                  capacity: Optional[int] = None,
-                 dtype: Optional[Type] = None):
+                 dtype: Optional[Type] = None,
+                 layout: int = LAYOUT_COMPACT):
         """Create or open a stack.
 
         Args:
@@ -66,6 +83,8 @@ class Stack(Generic[T]):
             name: Stack identifier
             capacity: Number of elements (required for creation)
             dtype: Element type (required)
+            layout: Header layout for creation (LAYOUT_COMPACT or
+                LAYOUT_PADDED_TOP); opening reads it from the header
         """
         self.memory = memory
         self.name = name
@@ -84,25 +103,30 @@ class Stack(Generic[T]):
             # Create new stack
             if capacity is None:
                 raise ValueError("capacity required to create new stack")
+            if layout & ~LAYOUT_PADDED_TOP:
+                raise ValueError(f"unknown stack layout {layout:#x}")
 
             self.capacity = capacity
-            # Layout: [Header(16)][data: T*capacity][pad][state: uint32*capacity]
-            total_size = (self.HEADER_SIZE
-                          + _align8(self.elem_size * capacity)
+            self.layout = layout
+            # Layout: [Header][data: T*capacity][pad][state: uint32*capacity]
+            total_size = (self._data_offset(MIN_SECTION_ALIGN)
+                          + _align_up(self.elem_size * capacity, MIN_SECTION_ALIGN)
                           + _STATE_SIZE * capacity)
 
             # Allocate in shared memory
             self.offset = memory.allocate(name, total_size)
+            self._align = MIN_SECTION_ALIGN
 
             # Initialize header (top=-1 means empty)
             header_data = struct.pack(self.HEADER_FORMAT,
                                     -1,  # top (empty)
                                     capacity,
-                                    self.elem_size)
+                                    self.elem_size | layout)
             memory.data[self.offset:self.offset + self.HEADER_SIZE] = header_data
 
             # Initialize all ready flags to 0 (state array starts 8-aligned)
-            ready_base = self.offset + self.HEADER_SIZE + _align8(self.elem_size * capacity)
+            ready_base = (self.offset + self._data_offset(MIN_SECTION_ALIGN)
+                          + _align_up(self.elem_size * capacity, MIN_SECTION_ALIGN))
             for i in range(capacity):
                 off = ready_base + i * _STATE_SIZE
                 struct.pack_into(_STATE_FORMAT, memory.data, off, 0)
@@ -110,16 +134,31 @@ class Stack(Generic[T]):
         else:
             # Open existing stack
             self.offset = entry.offset
+            # Sections follow the alignment recorded by the creator (a C++
+            # over-aligned element type moves data and the side array)
+            self._align = entry.section_align
             self.capacity = capacity if capacity else self._read_capacity()
 
             # Verify element size matches
-            stored_elem_size = self._read_elem_size()
+            stored = self._read_elem_size()
+            self.layout = stored & ~_ELEM_SIZE_MASK
+            stored_elem_size = stored & _ELEM_SIZE_MASK
             if stored_elem_size != self.elem_size:
                 raise ValueError(f"Element size mismatch: expected {self.elem_size}, "
                                 f"found {stored_elem_size}")
+            if self.layout & ~LAYOUT_PADDED_TOP:
+                raise ValueError(f"unknown stack layout {self.layout:#x}")
+
+        # Offset of top in shared memory
+        if self.layout & LAYOUT_PADDED_TOP:
+            self._top_off = self.offset + _PADDED_TOP_OFFSET
+        else:
+            self._top_off = self.offset
+        if entry is None:
+            self._write_top(-1)
 
         # Create numpy array view of data
-        data_offset = self.offset + self.HEADER_SIZE
+        data_offset = self.offset + self._data_offset(self._align)
         self.data = np.frombuffer(
             self.memory.data,
             dtype=self.dtype,
@@ -127,21 +166,26 @@ class Stack(Generic[T]):
             offset=data_offset
         )
 
-        # Base offset for the ready flags array in shared memory (8-aligned)
-        self._ready_base = self.offset + self.HEADER_SIZE + _align8(self.elem_size * self.capacity)
+        # Base offset for the ready flags array in shared memory (section-aligned)
+        self._ready_base = data_offset + _align_up(self.elem_size * self.capacity,
+                                               self._align)
 
         # Lock for atomic operations
         self._lock = threading.Lock()
 
-    def _read_header(self):
-        """Read header values."""
-        header_bytes = self.memory.data[self.offset:self.offset + self.HEADER_SIZE]
-        return struct.unpack(self.HEADER_FORMAT, header_bytes)
+    def _data_offset(self, alignment: int) -> int:
+        """Offset of the data array from the header for this layout."""
+        header_size = (_PADDED_HEADER_SIZE if self.layout & LAYOUT_PADDED_TOP
+                       else self.HEADER_SIZE)
+        return _align_up(header_size, alignment)
+
+    def _read_top(self) -> int:
+        """Read top (signed)."""
+        return struct.unpack_from('i', self.memory.data, self._top_off)[0]
 
-    def _write_header(self, top: int, capacity: int, elem_size: int):
-        """Write header values."""
-        header_data = struct.pack(self.HEADER_FORMAT, top, capacity, elem_size)
-        self.memory.data[self.offset:self.offset + self.HEADER_SIZE] = header_data
+    def _write_top(self, top: int):
+        """Write top (signed)."""
+        struct.pack_into('i', self.memory.data, self._top_off, top)
 
     def _read_capacity(self) -> int:
         """Read capacity from header."""
@@ -166,15 +210,16 @@ class Stack(Generic[T]):
         if _cffi.AVAILABLE:
             value_bytes = self.dtype.type(value).tobytes()
             return _cffi.stack_push(self.memory, self.offset,
-                                    value_bytes, self.elem_size) == _cffi.OK
+                                    value_bytes, self.elem_size,
+                                    self._align) == _cffi.OK
 
         with self._lock:
-            top, capacity, elem_size = self._read_header()
-            if top >= capacity - 1:
+            top = self._read_top()
+            if top >= self.capacity - 1:
                 return False
 
             new_top = top + 1
-            self._write_header(new_top, capacity, elem_size)
+            self._write_top(new_top)
 
             # Bounded wait: a peer in another process that crashed
             # mid-operation can leave the slot permanently claimed. Undo the
@@ -184,7 +229,7 @@ class Stack(Generic[T]):
                     break
                 time.sleep(0)
             else:
-                self._write_header(top, capacity, elem_size)
+                self._write_top(top)
                 return False
             self._write_ready(new_top, _SLOT_WRITING)
             self.data[new_top] = value
@@ -194,17 +239,18 @@ class Stack(Generic[T]):
     def pop(self) -> Optional[T]:
         """Pop value from stack. Returns value or None if empty."""
         if _cffi.AVAILABLE:
-            rc, raw = _cffi.stack_pop(self.memory, self.offset, self.elem_size)
+            rc, raw = _cffi.stack_pop(self.memory, self.offset,
+                                      self.elem_size, self._align)
             if rc != _cffi.OK:
                 return None
             return np.frombuffer(raw, dtype=self.dtype)[0].copy()
 
         with self._lock:
-            top, capacity, elem_size = self._read_header()
+            top = self._read_top()
             if top < 0:
                 return None
 
-            self._write_header(top - 1, capacity, elem_size)
+            self._write_top(top - 1)
 
             # Bounded wait: a pusher in another process that crashed
             # mid-write leaves the slot stuck in WRITING forever. Undo the
@@ -214,7 +260,7 @@ class Stack(Generic[T]):
                     break
                 time.sleep(0)
             else:
-                self._write_header(top, capacity, elem_size)
+                self._write_top(top)
                 return None
             self._write_ready(top, _SLOT_READING)
             value = self.data[top].copy()
@@ -230,7 +276,8 @@ class Stack(Generic[T]):
         an authoritative emptiness check; use size() for that.
         """
         if _cffi.AVAILABLE:
-            rc, raw = _cffi.stack_top(self.memory, self.offset, self.elem_size)
+            rc, raw = _cffi.stack_top(self.memory, self.offset,
+                                      self.elem_size, self._align)
             if rc != _cffi.OK:
                 return None
             return np.frombuffer(raw, dtype=self.dtype)[0].copy()
@@ -240,7 +287,7 @@ class Stack(Generic[T]):
         # slot. Hold the lock for the same within-interpreter mutual exclusion
         # push/pop use.
         with self._lock:
-            top_idx, _, _ = self._read_header()
+            top_idx = self._read_top()
             if top_idx < 0:
                 return None
 
@@ -250,7 +297,7 @@ class Stack(Generic[T]):
                     value = self.data[top_idx].copy()
                     self._write_ready(top_idx, _SLOT_READY)
                     return value
-                current_top, _, _ = self._read_header()
+                current_top = self._read_top()
                 if current_top != top_idx:
                     return None
                 time.sleep(0)
@@ -260,21 +307,20 @@ class Stack(Generic[T]):
         """Check if stack is empty."""
         if _cffi.AVAILABLE:
             return _cffi.stack_empty(self.memory, self.offset)
-        top, _, _ = self._read_header()
+        top = self._read_top()
         return top < 0
 
     def full(self) -> bool:
         """Check if stack is full."""
         if _cffi.AVAILABLE:
             return _cffi.stack_full(self.memory, self.offset)
-        top, capacity, _ = self._read_header()
-        return top >= capacity - 1
+        return self._read_top() >= self.capacity - 1
 
     def size(self) -> int:
         """Get current number of elements."""
         if _cffi.AVAILABLE:
             return _cffi.stack_size(self.memory, self.offset)
-        top, _, _ = self._read_header()
+        top = self._read_top()
         return 0 if top < 0 else top + 1
 
     def __len__(self) -> int:
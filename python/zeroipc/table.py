@@ -2,12 +2,31 @@
 Runtime-configurable table for managing named structures in shared memory.
 """
 
+import os
 import struct
-from typing import Optional, NamedTuple
+from typing import List, Optional, NamedTuple
+
+from . import _cffi
 
 # Constants matching C++ implementation
 TABLE_MAGIC = 0x5A49504D  # 'ZIPM'
-TABLE_VERSION = 2  # v2: 8-byte section alignment (see SPECIFICATION.md)
+TABLE_VERSION = 3  # v3: per-entry publish state (see SPECIFICATION.md)
+
+# Entry states: PENDING -> CLAIMED -> PUBLISHED, or CLAIMED -> DEAD when a
+# concurrent registrar in a lower slot claimed the same name first.
+ENTRY_PENDING = 0
+ENTRY_CLAIMED = 1
+ENTRY_PUBLISHED = 2
+ENTRY_DEAD = 3
+
+# Section alignment: recorded per entry, 0 in older files means the minimum.
+# Structure bases are placed on their own cache line.
+MIN_SECTION_ALIGN = 8
+MAX_ALLOC_ALIGN = 4096
+CACHE_LINE_SIZE = 64
+
+# Bound on waiting for a lower slot to leave PENDING (crashed registrar).
+MAX_SPINS = 10000
 
 
 class TableEntry(NamedTuple):
@@ -15,6 +34,12 @@ class TableEntry(NamedTuple):
     name: str
     offset: int
     size: int
+    alignment: int = 0
+
+    @property
+    def section_align(self) -> int:
+        """Alignment of the sections inside the structure (0 means 8)."""
+        return self.alignment or MIN_SECTION_ALIGN
 
 
 class Table:
@@ -23,12 +48,18 @@ class Table:
     
     The table is stored at the beginning of shared memory and tracks
     all allocated structures by name, offset, and size.
+
+    Registration follows the lock-free protocol of SPECIFICATION.md (CAS on
+    next_offset and entry_count, per-entry publish state). With the C FFI
+    backend loaded it is safe across processes; the pure-Python fallback
+    follows the same protocol without atomic instructions (single writer).
     """
     
     HEADER_FORMAT = '<IIIIQQ'  # magic, version, entry_count, max_entries, memory_size, next_offset
     HEADER_SIZE = struct.calcsize(HEADER_FORMAT)
-    ENTRY_FORMAT = '<32sQQ'  # name[32], offset, size (64-bit)
+    ENTRY_FORMAT = '<32sQQII'  # name[32], offset, size (64-bit), state, alignment
     ENTRY_SIZE = struct.calcsize(ENTRY_FORMAT)
+    STATE_OFFSET = 48  # offset of the state word within an entry
     
     def __init__(self, buffer: memoryview, max_entries: int, create: bool = False, memory_size: int = 0):
         """
@@ -99,23 +130,30 @@ class Table:
         if len(name) > 31:
             raise ValueError("Name too long (max 31 characters)")
         
-        entry_count = self.entry_count()
-        entry_offset = self.HEADER_SIZE
+        for entry in self.entries():
+            if entry.name == name:
+                return entry
         
-        for i in range(entry_count):
-            name_bytes, offset, size = struct.unpack_from(
+        return None
+
+    def entries(self) -> List[TableEntry]:
+        """Return all published entries, in slot order."""
+        result = []
+        entry_offset = self.HEADER_SIZE
+
+        for _ in range(self._slot_count()):
+            name_bytes, offset, size, state, alignment = struct.unpack_from(
                 self.ENTRY_FORMAT, self.buffer, entry_offset
             )
-            entry_name = name_bytes.rstrip(b'\x00').decode('utf-8')
-            
-            if entry_name == name:
-                return TableEntry(entry_name, offset, size)
-            
+            if state == ENTRY_PUBLISHED:
+                entry_name = name_bytes.rstrip(b'\x00').decode('utf-8')
+                result.append(TableEntry(entry_name, offset, size, alignment))
             entry_offset += self.ENTRY_SIZE
-        
-        return None
+
+        return result
     
-    def add(self, name: str, offset: int, size: int) -> bool:
+    def add(self, name: str, offset: int, size: int,
+            alignment: int = MIN_SECTION_ALIGN) -> bool:
         """
         Add a new entry to the table.
         
@@ -123,32 +161,109 @@ class Table:
             name: Entry name
             offset: Offset in shared memory
             size: Size in bytes
+            alignment: Section alignment recorded in the entry (default 8)
             
         Returns:
             True if successful, False if table is full
         """
         if len(name) > 31:
             raise ValueError("Name too long (max 31 characters)")
-        
-        current_count = self.entry_count()
-        if current_count >= self.max_entries:
+        self._check_alignment(alignment)
+
+        if _cffi.AVAILABLE:
+            rc = _cffi.table_add(self.buffer, self.max_entries,
+                                 name.encode('utf-8'), offset, size,
+                                 alignment)
+            if rc == _cffi.EXISTS:
+                raise ValueError(f"Name already exists: {name}")
+            return rc == _cffi.OK
+
+        index = self._claim(name)
+        if index is None:
             return False
-        
-        if self.find(name) is not None:
-            raise ValueError(f"Name already exists: {name}")
-        
-        # Add new entry
-        entry_offset = self.HEADER_SIZE + current_count * self.ENTRY_SIZE
-        name_bytes = name.encode('utf-8').ljust(32, b'\x00')
-        struct.pack_into(
-            self.ENTRY_FORMAT, self.buffer, entry_offset,
-            name_bytes, offset, size
-        )
-        
-        # Update entry count
-        self._set_entry_count(current_count + 1)
-        
+        self._publish(index, offset, size, alignment)
         return True
+
+    def allocate_entry(self, name: str, size: int,
+                       alignment: int = MIN_SECTION_ALIGN) -> Optional[int]:
+        """
+        Claim a name, then allocate its space and publish the entry.
+
+        Space is only taken once the name is ours, so a registration that
+        loses a same-name race or finds the table full consumes none. The
+        base is aligned to max(alignment, CACHE_LINE_SIZE).
+
+        Args:
+            name: Entry name
+            size: Size in bytes
+            alignment: Section alignment recorded in the entry (default 8)
+
+        Returns:
+            Offset of the new structure, or None if the table is full
+        """
+        if len(name) > 31:
+            raise ValueError("Name too long (max 31 characters)")
+        self._check_alignment(alignment)
+        if size < 0 or size > self.memory_size:
+            raise RuntimeError("Allocation would exceed memory bounds")
+
+        if _cffi.AVAILABLE:
+            rc, offset = _cffi.table_allocate_entry(
+                self.buffer, self.max_entries, name.encode('utf-8'), size,
+                alignment)
+            if rc == _cffi.EXISTS:
+                raise ValueError(f"Name already exists: {name}")
+            if rc == _cffi.NOSPACE:
+                raise RuntimeError("Allocation would exceed memory bounds")
+            return offset if rc == _cffi.OK else None
+
+        index = self._claim(name)
+        if index is None:
+            return None
+        try:
+            offset = self.allocate(size, max(alignment, CACHE_LINE_SIZE))
+        except RuntimeError:
+            self._set_state(index, ENTRY_DEAD)
+            raise
+        self._publish(index, offset, size, alignment)
+        return offset
+
+    def _claim(self, name: str) -> Optional[int]:
+        """Reserve a slot and claim name in it; None if the table is full."""
+        name_bytes = name.encode('utf-8').ljust(32, b'\x00')
+        while True:
+            if self.find(name) is not None:
+                raise ValueError(f"Name already exists: {name}")
+
+            # Reserve the next slot
+            index = self._slot_count()
+            if index >= self.max_entries:
+                return None
+            self._set_entry_count(index + 1)
+
+            # Write the name and claim it, unless a registrar above gave up
+            # on the slot while we stalled; then start over in a fresh one
+            if self._state(index) != ENTRY_PENDING:
+                continue
+            struct.pack_into('32s', self.buffer,
+                             self.HEADER_SIZE + index * self.ENTRY_SIZE,
+                             name_bytes)
+            self._set_state(index, ENTRY_CLAIMED)
+            break
+
+        # Same-name race: the lowest claimed slot wins
+        if self._lower_slot_claims(name_bytes, index):
+            self._set_state(index, ENTRY_DEAD)
+            raise ValueError(f"Name already exists: {name}")
+        return index
+
+    def _publish(self, index: int, offset: int, size: int, alignment: int):
+        """Fill in a claimed slot, then make it visible to readers."""
+        entry_offset = self.HEADER_SIZE + index * self.ENTRY_SIZE
+        struct.pack_into('<QQ', self.buffer, entry_offset + 32, offset, size)
+        struct.pack_into('<I', self.buffer, entry_offset + self.STATE_OFFSET + 4,
+                         alignment)
+        self._set_state(index, ENTRY_PUBLISHED)
     
     def allocate(self, size: int, alignment: int = 8) -> int:
         """
@@ -156,11 +271,23 @@ class Table:
         
         Args:
             size: Size in bytes to allocate
-            alignment: Alignment requirement (default 8)
+            alignment: Alignment requirement (default 8, at most 4096)
             
         Returns:
             Offset of allocated space
         """
+        self._check_alignment(alignment)
+
+        # Reject before the FFI call: ctypes silently truncates to uint64
+        if size < 0 or size > self.memory_size:
+            raise RuntimeError("Allocation would exceed memory bounds")
+
+        if _cffi.AVAILABLE:
+            rc, aligned = _cffi.table_allocate(self.buffer, size, alignment)
+            if rc != _cffi.OK:
+                raise RuntimeError("Allocation would exceed memory bounds")
+            return aligned
+
         next_offset = self.next_offset()
 
         # Align the offset
@@ -179,18 +306,54 @@ class Table:
 
         return aligned
     
+    @staticmethod
+    def _check_alignment(alignment: int):
+        if (alignment <= 0 or alignment & (alignment - 1)
+                or alignment > MAX_ALLOC_ALIGN):
+            raise ValueError(
+                f"Alignment must be a power of two <= {MAX_ALLOC_ALIGN}: {alignment}")
+
     def entry_count(self) -> int:
-        """Get the number of entries in the table"""
-        return struct.unpack_from('<I', self.buffer, 8)[0]
+        """Get the number of published entries in the table"""
+        return len(self.entries())
 
     def next_offset(self) -> int:
         """Get the next allocation offset"""
         return struct.unpack_from('<Q', self.buffer, 24)[0]
 
+    def _slot_count(self) -> int:
+        """Get the number of reserved slots (clamped to max_entries)"""
+        return min(struct.unpack_from('<I', self.buffer, 8)[0], self.max_entries)
+
     def _set_entry_count(self, count: int):
-        """Set the entry count"""
+        """Set the reserved slot count"""
         struct.pack_into('<I', self.buffer, 8, count)
 
+    def _state(self, index: int) -> int:
+        entry_offset = self.HEADER_SIZE + index * self.ENTRY_SIZE
+        return struct.unpack_from('<I', self.buffer, entry_offset + self.STATE_OFFSET)[0]
+
+    def _set_state(self, index: int, state: int):
+        entry_offset = self.HEADER_SIZE + index * self.ENTRY_SIZE
+        struct.pack_into('<I', self.buffer, entry_offset + self.STATE_OFFSET, state)
+
+    def _lower_slot_claims(self, name_bytes: bytes, index: int) -> bool:
+        """True if a slot below index holds a live claim on name_bytes."""
+        for i in range(index):
+            state = self._state(i)
+            spins = 0
+            while state == ENTRY_PENDING and spins < MAX_SPINS:
+                os.sched_yield()
+                state = self._state(i)
+                spins += 1
+            if state == ENTRY_PENDING:
+                self._set_state(i, ENTRY_DEAD)
+            if state in (ENTRY_CLAIMED, ENTRY_PUBLISHED):
+                entry_offset = self.HEADER_SIZE + i * self.ENTRY_SIZE
+                if bytes(self.buffer[entry_offset:entry_offset + 32]) == name_bytes:
+                    return True
+        return False
+
     def _set_next_offset(self, offset: int):
         """Set the next allocation offset"""
         struct.pack_into('<Q', self.buffer, 24, offset)